@@ -14,7 +14,9 @@
 
 #include "LSXMesh.h"
 #include "../Misc/LSXMisc.h"
+#include "TriangleCache/LSCOverdrawOptimizer.h"
 #include "TriangleCache/LSCTriangleCacheOptimizer.h"
+#include "TriangleCache/LSCVertexFetchOptimizer.h"
 #include "TriangleStrips/LSCTriangleStripper.h"
 #include <map>
 
@@ -327,19 +329,61 @@ namespace lsx {
 			}
 		}
 
+		// The 16-bit ranges of the parts of a material can overlap, so give each part its own copy of the vertices it
+		//	uses.  Each part can then be optimized on its own: the triangles are put in cache-friendly order, clusters
+		//	of them are reordered to reduce overdraw, and then the vertices are put in the order in which the
+		//	triangles use them so that vertex fetches walk forward through memory.
+		LSX_VERTEX_BUFFER vbPartVertices;
+		CVectorPoD<LSUINT32, LSUINT32> vLocal, vUsed;
+		if ( !vLocal.Resize( m_vbVertexBuffer.Length() ) ) { return false; }
+		for ( LSUINT32 I = 0; I < vLocal.Length(); ++I ) {
+			vLocal[I] = LSE_MAXU32;
+		}
 		LSUINT32 ui32MaxIndexBufferLen = 0;
 		for ( LSUINT32 I = 0; I < m_mpaIndexBuffers.Length(); ++I ) {
 			LSX_MESH_PART & mpThis = m_mpaIndexBuffers[I];
 			mpThis.maPrimType = LSD_MA_TRIANGLE_LIST;
+
+			LSUINT32 ui32NewBase = vbPartVertices.Length();
+			vUsed.ResetNoDealloc();
+			for ( LSUINT32 J = 0; J < mpThis.ibIndexBuffer.Length(); ++J ) {
+				LSUINT32 ui32Global = mpThis.ibIndexBuffer[J] + mpThis.ui32Base;
+				if ( vLocal[ui32Global] == LSE_MAXU32 ) {
+					vLocal[ui32Global] = vUsed.Length();
+					if ( !vUsed.Push( ui32Global ) ) { return false; }
+					if ( !vbPartVertices.Push( m_vbVertexBuffer[ui32Global] ) ) { return false; }
+				}
+				mpThis.ibIndexBuffer[J] = vLocal[ui32Global];
+			}
+			for ( LSUINT32 J = 0; J < vUsed.Length(); ++J ) {
+				vLocal[vUsed[J]] = LSE_MAXU32;
+			}
+			mpThis.ui32Base = ui32NewBase;
+
 			if ( mpThis.ibIndexBuffer.Length() ) {
+				LSX_RAW_VERTEX * prvVerts = &vbPartVertices[ui32NewBase];
+				LSUINT32 ui32Verts = vUsed.Length();
 				CMesh::LSX_INDEX_BUFFER ibOut;
 				if ( ibOut.Resize( mpThis.ibIndexBuffer.Length() ) ) {
 					CTriangleCacheOptimizer tcoOptimizer;
-					if ( tcoOptimizer.Optimize( &mpThis.ibIndexBuffer[0], mpThis.ibIndexBuffer.Length(), &ibOut[0] ) ) {
+					// Disconnected pieces of large parts are optimized on all threads of the job system.
+					if ( tcoOptimizer.Optimize( &mpThis.ibIndexBuffer[0], mpThis.ibIndexBuffer.Length(), &ibOut[0], 0 ) ) {
+						CStd::MemCpy( &mpThis.ibIndexBuffer[0], &ibOut[0], sizeof( ibOut[0] ) * ibOut.Length() );
+					}
+
+					// Reorder clusters of the cache-optimized triangles to reduce overdraw.
+					COverdrawOptimizer odoOptimizer;
+					if ( odoOptimizer.Optimize( &mpThis.ibIndexBuffer[0], mpThis.ibIndexBuffer.Length(),
+						&prvVerts[0].vPosition.x, sizeof( LSX_RAW_VERTEX ),
+						ui32Verts, &ibOut[0] ) ) {
 						CStd::MemCpy( &mpThis.ibIndexBuffer[0], &ibOut[0], sizeof( ibOut[0] ) * ibOut.Length() );
 					}
 				}
 
+				// Last, since it follows the final triangle order.
+				CVertexFetchOptimizer::Optimize( &mpThis.ibIndexBuffer[0], mpThis.ibIndexBuffer.Length(),
+					prvVerts, ui32Verts, sizeof( LSX_RAW_VERTEX ) );
+
 
 				LSUINT32 ui32Faces = mpThis.ibIndexBuffer.Length() / 3;
 				CTriangleStripper tsStripper;
@@ -362,6 +406,8 @@ namespace lsx {
 			//	ui32MaxIndexBufferLen = CStd::Max( ui32MaxIndexBufferLen, mpThis.
 			//}
 		}
+		m_vbVertexBuffer.Reset();
+		if ( vbPartVertices.Length() && !m_vbVertexBuffer.Append( &vbPartVertices[0], vbPartVertices.Length() ) ) { return false; }
 
 
 		::printf( "Loaded mesh \"%s\".\r\n", m_pfmMesh->GetName() );
@@ -37,6 +37,18 @@ using namespace ::lsh;
 using namespace ::lstl;
 
 namespace lsc {
+
+	// == Enumerations.
+	/**
+	 * Results of a call to an incremental decoder.
+	 */
+	enum LSC_DECODE_STATUS {
+		LSC_DS_NEED_INPUT,													/**< All of the input was used.  Call again with more. */
+		LSC_DS_OUTPUT_FULL,													/**< The output is full.  Call again with more room. */
+		LSC_DS_DONE,														/**< The end of the stream was reached. */
+		LSC_DS_ERROR,														/**< The stream is invalid. */
+	};
+
 }	// namespace lsc
 
 #endif	// __LSC_COMPRESSIONLIB_H__
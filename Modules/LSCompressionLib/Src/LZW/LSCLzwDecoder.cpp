@@ -23,7 +23,17 @@
 namespace lsc {
 
 	// == Various constructors.
-	LSE_CALLCTOR CLzwDecoder::CLzwDecoder() {
+	LSE_CALLCTOR CLzwDecoder::CLzwDecoder() :
+		m_ui64Bits( 0ULL ),
+		m_ui32TotalBits( 0 ),
+		m_ui32StartingSize( 0 ),
+		m_ui32MaxBits( 0 ),
+		m_ui32Old( LSE_MAXU32 ),
+		m_ui32Char( LSE_MAXU32 ),
+		m_ui32Pending( 0 ),
+		m_bExtraChar( false ),
+		m_ui8ExtraChar( 0 ),
+		m_dsStatus( LSC_DS_ERROR ) {
 	}
 
 	// == Functions.
@@ -151,6 +161,118 @@ namespace lsc {
 
 		return ui32BitsToRead;
 	}
+
+	/**
+	 * Prepares to decode a stream incrementally with DecodeStream().
+	 *
+	 * \param _ui32DictionaryStartingSize Starting size of the dictionary.
+	 * \param _ui32MaxBits Maximum bits possible in the dictionary.
+	 */
+	void LSE_CALL CLzwDecoder::BeginStream( uint32_t _ui32DictionaryStartingSize, uint32_t _ui32MaxBits ) {
+		// The dictionary cannot be fewer than 2 characters.
+		m_ui32StartingSize = CStd::Max<uint32_t>( _ui32DictionaryStartingSize, 2 );
+		m_ui32MaxBits = _ui32MaxBits;
+		m_lddDict.InitializeDictionary( m_ui32StartingSize, m_ui32MaxBits );
+		m_ui64Bits = 0ULL;
+		m_ui32TotalBits = 0;
+		m_ui32Old = m_ui32Char = LSE_MAXU32;
+		m_ui32Pending = 0;
+		m_bExtraChar = false;
+		m_dsStatus = LSC_DS_NEED_INPUT;
+	}
+
+	/**
+	 * Decodes as much as possible of the given input into the given output.  All state is kept between calls, so
+	 *	input can be passed in chunks of any size and output can be drained between calls.  BeginStream() must be
+	 *	called first.
+	 *
+	 * \param _pui8In The next bytes of the compressed stream.
+	 * \param _uiptrInLen Number of bytes to which _pui8In points.
+	 * \param _uiptrInUsed Holds the number of bytes of input used.  Unused input must be passed again.
+	 * \param _pui8Out Buffer to receive decoded bytes.
+	 * \param _uiptrOutLen Size of the buffer to which _pui8Out points.
+	 * \param _uiptrOutWritten Holds the number of bytes written to _pui8Out.
+	 * \return Returns LSC_DS_NEED_INPUT when all input has been used, LSC_DS_OUTPUT_FULL when the output is full,
+	 *	LSC_DS_DONE when the end-of-input code is read, or LSC_DS_ERROR if the stream is invalid.  A stream that
+	 *	has no end-of-input code is complete when all of it has been passed and LSC_DS_NEED_INPUT is returned.
+	 */
+	LSC_DECODE_STATUS LSE_CALL CLzwDecoder::DecodeStream( const uint8_t * _pui8In, uintptr_t _uiptrInLen, uintptr_t &_uiptrInUsed,
+		uint8_t * _pui8Out, uintptr_t _uiptrOutLen, uintptr_t &_uiptrOutWritten ) {
+		const uint8_t * pui8In = _pui8In;
+		const uint8_t * pui8InEnd = _pui8In + _uiptrInLen;
+		uint8_t * pui8Out = _pui8Out;
+		uint8_t * pui8OutEnd = _pui8Out + _uiptrOutLen;
+
+		while ( m_dsStatus == LSC_DS_NEED_INPUT ) {
+			// Finish writing the last code.
+			while ( m_ui32Pending && pui8Out < pui8OutEnd ) {
+				(*pui8Out++) = static_cast<uint8_t>(m_sString.CStr()[--m_ui32Pending]);
+			}
+			if ( m_bExtraChar && !m_ui32Pending && pui8Out < pui8OutEnd ) {
+				(*pui8Out++) = m_ui8ExtraChar;
+				m_bExtraChar = false;
+			}
+			if ( m_ui32Pending || m_bExtraChar ) {
+				_uiptrInUsed = static_cast<uintptr_t>(pui8In - _pui8In);
+				_uiptrOutWritten = static_cast<uintptr_t>(pui8Out - _pui8Out);
+				return LSC_DS_OUTPUT_FULL;
+			}
+
+			// Get the next code.  Codes are stored least-significant bit first.
+			uint32_t ui32BitsToRead = m_lddDict.GetBitsNeeded();
+			while ( m_ui32TotalBits < ui32BitsToRead && pui8In < pui8InEnd ) {
+				m_ui64Bits |= static_cast<uint64_t>(*pui8In++) << m_ui32TotalBits;
+				m_ui32TotalBits += 8;
+			}
+			if ( m_ui32TotalBits < ui32BitsToRead ) { break; }
+			uint32_t ui32Value = static_cast<uint32_t>(m_ui64Bits & ((1ULL << ui32BitsToRead) - 1ULL));
+			m_ui64Bits >>= ui32BitsToRead;
+			m_ui32TotalBits -= ui32BitsToRead;
+
+			if ( m_lddDict.IsEndOfInputCode( static_cast<CLzwDecodingDict::LSN_LZW_CODE>(ui32Value) ) ) {
+				m_dsStatus = LSC_DS_DONE;
+				break;
+			}
+			else if ( m_lddDict.IsClearCode( static_cast<CLzwDecodingDict::LSN_LZW_CODE>(ui32Value) ) ) {
+				m_lddDict.InitializeDictionary( m_ui32StartingSize, m_ui32MaxBits );
+				m_ui32Old = LSE_MAXU32;
+				continue;
+			}
+
+			if ( ui32Value >= m_lddDict.GetTotal() ) {
+				// Code not found in the dictionary.  It must be the next code to be added, which is the previous
+				//	string followed by its own first character.
+				if ( m_ui32Old == LSE_MAXU32 || ui32Value != m_lddDict.GetTotal() ||
+					!m_lddDict.GetString( static_cast<CLzwDecodingDict::LSN_LZW_CODE>(m_ui32Old), m_sString ) ) {
+					m_dsStatus = LSC_DS_ERROR;
+					break;
+				}
+				m_bExtraChar = true;
+				m_ui8ExtraChar = static_cast<uint8_t>(m_ui32Char);
+			}
+			else if ( !m_lddDict.GetString( static_cast<CLzwDecodingDict::LSN_LZW_CODE>(ui32Value), m_sString ) ) {
+				m_dsStatus = LSC_DS_ERROR;
+				break;
+			}
+			m_ui32Pending = m_sString.Length();
+
+			m_ui32Char = static_cast<uint32_t>(m_sString.CStr()[m_sString.Length()-1]);
+			if ( m_ui32Old != LSE_MAXU32 ) {
+				if ( m_lddDict.GetTotal() == 0 ) {
+					m_lddDict.InitializeDictionary( m_ui32StartingSize, m_ui32MaxBits );
+				}
+				if ( !m_lddDict.AddCode( static_cast<CLzwDecodingDict::LSN_LZW_CODE>(m_ui32Old), static_cast<uint8_t>(m_ui32Char) ) ) {
+					m_dsStatus = LSC_DS_ERROR;
+					break;
+				}
+			}
+			m_ui32Old = ui32Value;
+		}
+
+		_uiptrInUsed = static_cast<uintptr_t>(pui8In - _pui8In);
+		_uiptrOutWritten = static_cast<uintptr_t>(pui8Out - _pui8Out);
+		return m_dsStatus;
+	}
 }	// namespace lsc
 
 #pragma warning( pop )
@@ -60,6 +60,32 @@ namespace lsc {
 			uint32_t _ui32DictionaryStartingSize, uint32_t _ui32MaxBits,
 			lsstd::CStream &_sStream, LSBOOL _bResetDictionary = false );
 
+		/**
+		 * Prepares to decode a stream incrementally with DecodeStream().
+		 *
+		 * \param _ui32DictionaryStartingSize Starting size of the dictionary.
+		 * \param _ui32MaxBits Maximum bits possible in the dictionary.
+		 */
+		void LSE_CALL							BeginStream( uint32_t _ui32DictionaryStartingSize, uint32_t _ui32MaxBits );
+
+		/**
+		 * Decodes as much as possible of the given input into the given output.  All state is kept between calls, so
+		 *	input can be passed in chunks of any size and output can be drained between calls.  BeginStream() must be
+		 *	called first.
+		 *
+		 * \param _pui8In The next bytes of the compressed stream.
+		 * \param _uiptrInLen Number of bytes to which _pui8In points.
+		 * \param _uiptrInUsed Holds the number of bytes of input used.  Unused input must be passed again.
+		 * \param _pui8Out Buffer to receive decoded bytes.
+		 * \param _uiptrOutLen Size of the buffer to which _pui8Out points.
+		 * \param _uiptrOutWritten Holds the number of bytes written to _pui8Out.
+		 * \return Returns LSC_DS_NEED_INPUT when all input has been used, LSC_DS_OUTPUT_FULL when the output is full,
+		 *	LSC_DS_DONE when the end-of-input code is read, or LSC_DS_ERROR if the stream is invalid.  A stream that
+		 *	has no end-of-input code is complete when all of it has been passed and LSC_DS_NEED_INPUT is returned.
+		 */
+		LSC_DECODE_STATUS LSE_CALL				DecodeStream( const uint8_t * _pui8In, uintptr_t _uiptrInLen, uintptr_t &_uiptrInUsed,
+			uint8_t * _pui8Out, uintptr_t _uiptrOutLen, uintptr_t &_uiptrOutWritten );
+
 
 	protected :
 		// == Members.
@@ -68,6 +94,61 @@ namespace lsc {
 		 */
 		CLzwDecodingDict						m_lddDict;
 
+		/**
+		 * Bits buffered by DecodeStream().
+		 */
+		uint64_t								m_ui64Bits;
+
+		/**
+		 * Number of bits buffered by DecodeStream().
+		 */
+		uint32_t								m_ui32TotalBits;
+
+		/**
+		 * Starting size of the dictionary for DecodeStream().
+		 */
+		uint32_t								m_ui32StartingSize;
+
+		/**
+		 * Maximum bits in the dictionary for DecodeStream().
+		 */
+		uint32_t								m_ui32MaxBits;
+
+		/**
+		 * The previous code, or LSE_MAXU32 if there is none.
+		 */
+		uint32_t								m_ui32Old;
+
+		/**
+		 * The first character of the previous code's string.
+		 */
+		uint32_t								m_ui32Char;
+
+		/**
+		 * The string being written, in reverse order.
+		 */
+		CString									m_sString;
+
+		/**
+		 * Number of characters of m_sString still to be written.
+		 */
+		uint32_t								m_ui32Pending;
+
+		/**
+		 * If true, m_ui8ExtraChar is written after m_sString.
+		 */
+		LSBOOL									m_bExtraChar;
+
+		/**
+		 * The character to write after m_sString.
+		 */
+		uint8_t									m_ui8ExtraChar;
+
+		/**
+		 * Set once DecodeStream() reaches the end of the stream or an error.
+		 */
+		LSC_DECODE_STATUS						m_dsStatus;
+
 	};
 
 
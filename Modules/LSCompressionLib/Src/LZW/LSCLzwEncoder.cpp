@@ -89,11 +89,12 @@ namespace lsc {
 		while ( ui64Index < _ui64Size ) {
 			uint32_t ui32Char = _pui8Bytes[ui64Index++];
 			uint32_t ui32EntryIndex = m_ledDict.GetEntryIndex( ui32String, ui32Char );
+			uint32_t ui32Code = m_ledDict.GetCode( ui32EntryIndex );
 			// Does this combination exist?
-			if ( m_ledDict.GetEntry( ui32EntryIndex ).ui32Code != CLzwEncodingDict::LSN_LZW_INVALID_CODE ) {
+			if ( ui32Code != CLzwEncodingDict::LSN_LZW_INVALID_CODE ) {
 				// It exists so extend the code in an attempt to find the longest code that does not
 				//	exist in the dictionary.
-				ui32String = m_ledDict.GetEntry( ui32EntryIndex ).ui32Code;
+				ui32String = ui32Code;
 			}
 			else {
 				// It does not exist so write the code to the stream.
@@ -63,6 +63,14 @@ namespace lsc {
 			LSN_LZW_FORCE_DWORD					= 0x7FFFFFFFUL,
 		};
 
+		/**
+		 * Packing of codes and generations in dictionary entries.
+		 */
+		enum {
+			LSN_LZW_GENERATION_SHIFT			= 24,
+			LSN_LZW_CODE_MASK					= (1 << LSN_LZW_GENERATION_SHIFT) - 1,
+		};
+
 
 		// == Types.
 		/**
@@ -70,19 +78,15 @@ namespace lsc {
 		 */
 		typedef struct LSN_LZW_DICT_ENTRY {
 			/**
-			 * The code for this entry.
+			 * The base code and character of this entry, packed as (base code << 8) | character.
 			 */
-			uint32_t							ui32Code;
-			
-			/**
-			 * The code on which this is based.
-			 */
-			uint32_t							ui32BaseCode;
-			
+			uint32_t							ui32Key;
+
 			/**
-			 * The character appended to the base code which creates this entry.
+			 * The code for this entry in the low 24 bits and the generation in which it was added in the upper 8.
+			 *	Entries from earlier generations are unused.
 			 */
-			uint8_t								ui8Char;
+			uint32_t							ui32CodeAndGeneration;
 		} * LPLSN_LZW_DICT_ENTRY, * const LPCLSN_LZW_DICT_ENTRY;
 
 
@@ -114,18 +118,18 @@ namespace lsc {
 		 *	index is where it should be added to the dictionary.
 		 *
 		 * \param _ui32Code The code of the entry to find.
-		 * \param _ui32Char The allocator to use by this class.
-		 * \return Returns false if allocation of the dictionary failed, or true otherwise.
+		 * \param _ui32Char The character by which the entry extends the code.
+		 * \return Returns the index of the entry or of the unused slot where it should be added.
 		 */
-		uint32_t LSE_CALL						GetEntryIndex( uint32_t _ui32Code, uint32_t _ui32Char ) const;
+		LSE_INLINE uint32_t LSE_CALL			GetEntryIndex( uint32_t _ui32Code, uint32_t _ui32Char ) const;
 
 		/**
-		 * Gets an entry by index for read only.  The entry is not guaranteed to contain a valid code.
+		 * Gets the code of the entry at a given index.
 		 *
-		 * \param _ui32Index Index of the entry to retrieve.
-		 * \return Returns a constant reference to the entry at the given index.
+		 * \param _ui32Index Index of the entry, returned by a previous call to GetEntryIndex().
+		 * \return Returns the code of the entry or LSN_LZW_INVALID_CODE if the index is unused.
 		 */
-		const LSN_LZW_DICT_ENTRY & LSE_CALL		GetEntry( uint32_t _ui32Index ) const;
+		LSE_INLINE uint32_t LSE_CALL			GetCode( uint32_t _ui32Index ) const;
 		
 		/**
 		 * Adds an entry at a given index.  The index must have been returned by a previous call to
@@ -138,7 +142,7 @@ namespace lsc {
 		 *	given in _ui32Char.
 		 * \param _ui32Char The character by which the new code extends the base code.
 		 */
-		void LSE_CALL							AddEntry( uint32_t _ui32Index, uint32_t _ui32BaseCode, uint32_t _ui32Char );
+		LSE_INLINE void LSE_CALL				AddEntry( uint32_t _ui32Index, uint32_t _ui32BaseCode, uint32_t _ui32Char );
 
 		/**
 		 * Gets the size of the dictionary.
@@ -193,10 +197,21 @@ namespace lsc {
 		CAllocator								m_caAllocator;
 		
 		/**
-		 * Allocated size of the dictionary.
+		 * Allocated size of the dictionary.  Always a power of 2.
 		 */
 		uint32_t								m_ui32AllocatedDictSize;
 
+		/**
+		 * Shift applied to a hashed key to get its index in the dictionary.
+		 */
+		uint32_t								m_ui32HashShift;
+
+		/**
+		 * The current generation, shifted into place.  Entries from any other generation are unused, so the
+		 *	dictionary is cleared by incrementing this rather than by touching every entry.
+		 */
+		uint32_t								m_ui32Generation;
+
 		/**
 		 * Maximum bits in the dictionary entries.
 		 */
@@ -223,12 +238,74 @@ namespace lsc {
 		uint32_t								m_ui32RootCodes;
 
 		/**
-		 * The dictionary.
+		 * The dictionary, an open-addressed hash table keyed on base code and character.  Root codes are implicit
+		 *	and not stored.
 		 */
 		LPLSN_LZW_DICT_ENTRY					m_lpldeDictionary;
 		
 	};
 
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Gets the index of an entry in the dictionary.  If the entry does not exist, the returned
+	 *	index is where it should be added to the dictionary.
+	 *
+	 * \param _ui32Code The code of the entry to find.
+	 * \param _ui32Char The character by which the entry extends the code.
+	 * \return Returns the index of the entry or of the unused slot where it should be added.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CLzwEncodingDict::GetEntryIndex( uint32_t _ui32Code, uint32_t _ui32Char ) const {
+		assert( m_lpldeDictionary );	// Of course a dictionary must have been made.
+		uint32_t ui32Key = (_ui32Code << 8) | _ui32Char;
+		uint32_t ui32Mask = m_ui32AllocatedDictSize - 1;
+		// The table is never more than half full, so linear probing stays short.
+		for ( uint32_t ui32Index = (ui32Key * 0x9E3779B1U) >> m_ui32HashShift; ; ui32Index = (ui32Index + 1) & ui32Mask ) {
+			const LSN_LZW_DICT_ENTRY & ldeEntry = m_lpldeDictionary[ui32Index];
+			if ( (ldeEntry.ui32CodeAndGeneration & ~LSN_LZW_CODE_MASK) != m_ui32Generation || ldeEntry.ui32Key == ui32Key ) {
+				return ui32Index;
+			}
+		}
+	}
+
+	/**
+	 * Gets the code of the entry at a given index.
+	 *
+	 * \param _ui32Index Index of the entry, returned by a previous call to GetEntryIndex().
+	 * \return Returns the code of the entry or LSN_LZW_INVALID_CODE if the index is unused.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CLzwEncodingDict::GetCode( uint32_t _ui32Index ) const {
+		assert( _ui32Index < m_ui32AllocatedDictSize );
+		const LSN_LZW_DICT_ENTRY & ldeEntry = m_lpldeDictionary[_ui32Index];
+		return (ldeEntry.ui32CodeAndGeneration & ~LSN_LZW_CODE_MASK) == m_ui32Generation ?
+			(ldeEntry.ui32CodeAndGeneration & LSN_LZW_CODE_MASK) : static_cast<uint32_t>(LSN_LZW_INVALID_CODE);
+	}
+
+	/**
+	 * Adds an entry at a given index.  The index must have been returned by a previous call to
+	 *	GetEntryIndex() and must be unused.
+	 *
+	 * \param _ui32Index Index, returned by a previous call to GetEntryIndex(), where the code is to be
+	 *	added.
+	 * \param _ui32BaseCode The base code of the new code to be added.  The base code is the code of an
+	 *	existing entry off which this entry is based.  This entry extends the base code by one character,
+	 *	given in _ui32Char.
+	 * \param _ui32Char The character by which the new code extends the base code.
+	 */
+	LSE_INLINE void LSE_CALL CLzwEncodingDict::AddEntry( uint32_t _ui32Index, uint32_t _ui32BaseCode, uint32_t _ui32Char ) {
+		assert( (m_lpldeDictionary[_ui32Index].ui32CodeAndGeneration & ~LSN_LZW_CODE_MASK) != m_ui32Generation );
+
+		if ( m_ui32DictSize == static_cast<uint32_t>(1 << m_ui16MinBits) ) {
+			++m_ui16MinBits;
+		}
+
+		m_lpldeDictionary[_ui32Index].ui32Key = (_ui32BaseCode << 8) | _ui32Char;
+		m_lpldeDictionary[_ui32Index].ui32CodeAndGeneration = m_ui32Generation | m_ui32DictSize++;
+	}
+
 }	// namespace lsc
 
 #endif	// __LSC_LZWENCODINGDICT_H__
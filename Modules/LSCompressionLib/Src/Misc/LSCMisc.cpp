@@ -20,10 +20,16 @@
 #include "../LZW/LSCLzwDecoder.h"
 #include "../LZW/LSCLzwEncoder.h"
 #include "Helpers/LSMHelpers.h"
+#include "JobSystem/LSHJobSystem.h"
 #include "Matrix/LSMMatrix4x4.h"
+#include "Simd/LSSTDSimdStd.h"
 #include "Streams/LSSTDExternalByteStream.h"
 #include "String/LSTLString.h"
 
+#ifdef LSSTD_SIMD_SSE2
+#include <emmintrin.h>
+#endif	// #ifdef LSSTD_SIMD_SSE2
+
 
 namespace lsc {
 
@@ -97,6 +103,402 @@ namespace lsc {
 		}
 	}
 
+	/**
+	 * Quantizes the components of an attribute to the given number of bits relative to the bounds of the
+	 *	attribute over all of the vertices.  Used for positions (3 components) and texture coordinates (2
+	 *	components).  Each component is spread over its own range, so the error along each axis is at most
+	 *	half of one step of that axis.
+	 *
+	 * \param _pfIn The first component of the first vertex.
+	 * \param _ui32Stride Bytes between vertices in _pfIn.
+	 * \param _ui32Total Number of vertices.
+	 * \param _ui32Components Number of components per vertex, from 1 to 4.
+	 * \param _ui32Bits Bits per component, from 1 to 16.  8, 10, and 16 are typical for positions.
+	 * \param _pui16Out Holds the quantized components, _ui32Components per vertex.  Must be able to hold
+	 *	_ui32Total * _ui32Components values.
+	 * \param _qrRange Holds the range needed to decode the values.
+	 * \param _aeError Holds the error of the quantization.
+	 * \return Returns false if _ui32Components or _ui32Bits is out of range.
+	 */
+	LSBOOL LSE_CALL CMisc::QuantizeAttribute( const float * _pfIn, uint32_t _ui32Stride, uint32_t _ui32Total,
+		uint32_t _ui32Components, uint32_t _ui32Bits,
+		uint16_t * _pui16Out, LSC_QUANTIZATION_RANGE &_qrRange, LSC_ATTRIBUTE_ERROR &_aeError ) {
+		_aeError.dMax = _aeError.dRms = 0.0;
+		if ( _ui32Components < 1 || _ui32Components > 4 || _ui32Bits < 1 || _ui32Bits > 16 ) { return false; }
+		const uint8_t * pui8In = reinterpret_cast<const uint8_t *>(_pfIn);
+		uint32_t ui32Max = (1UL << _ui32Bits) - 1UL;
+
+		// Find the bounds.
+		float fMax[4];
+		for ( uint32_t C = 0; C < 4; ++C ) {
+			_qrRange.fMin[C] = fMax[C] = 0.0f;
+			_qrRange.fScale[C] = 0.0f;
+		}
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			const float * pfThis = reinterpret_cast<const float *>(pui8In + static_cast<uintptr_t>(I) * _ui32Stride);
+			for ( uint32_t C = 0; C < _ui32Components; ++C ) {
+				if ( !I || pfThis[C] < _qrRange.fMin[C] ) { _qrRange.fMin[C] = pfThis[C]; }
+				if ( !I || pfThis[C] > fMax[C] ) { fMax[C] = pfThis[C]; }
+			}
+		}
+		for ( uint32_t C = 0; C < _ui32Components; ++C ) {
+			_qrRange.fScale[C] = (fMax[C] - _qrRange.fMin[C]) / static_cast<float>(ui32Max);
+		}
+
+		// Quantize and measure the error exactly as the values will be decoded.
+		double dSum = 0.0;
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			const float * pfThis = reinterpret_cast<const float *>(pui8In + static_cast<uintptr_t>(I) * _ui32Stride);
+			for ( uint32_t C = 0; C < _ui32Components; ++C ) {
+				uint32_t ui32Q = 0;
+				if ( _qrRange.fScale[C] > 0.0f ) {
+					double dQ = ::floor( static_cast<double>(pfThis[C] - _qrRange.fMin[C]) / _qrRange.fScale[C] + 0.5 );
+					ui32Q = static_cast<uint32_t>(CStd::Clamp( dQ, 0.0, static_cast<double>(ui32Max) ));
+				}
+				(*_pui16Out++) = static_cast<uint16_t>(ui32Q);
+
+				float fDecoded = _qrRange.fMin[C] + static_cast<float>(ui32Q) * _qrRange.fScale[C];
+				double dError = ::fabs( static_cast<double>(fDecoded) - static_cast<double>(pfThis[C]) );
+				_aeError.dMax = CStd::Max( _aeError.dMax, dError );
+				dSum += dError * dError;
+			}
+		}
+		if ( _ui32Total ) {
+			_aeError.dRms = ::sqrt( dSum / (static_cast<double>(_ui32Total) * _ui32Components) );
+		}
+		return true;
+	}
+
+	/**
+	 * Decodes components created by QuantizeAttribute().
+	 *
+	 * \param _pui16In The quantized components.
+	 * \param _ui32Total Number of vertices.
+	 * \param _ui32Components Number of components per vertex, from 1 to 4.
+	 * \param _qrRange The range returned by QuantizeAttribute().
+	 * \param _pfOut Holds the first component of the first decoded vertex.
+	 * \param _ui32Stride Bytes between vertices in _pfOut.  Decoding is fastest when the output is packed
+	 *	(_ui32Components * sizeof( float )).
+	 */
+	void LSE_CALL CMisc::DequantizeAttribute( const uint16_t * _pui16In, uint32_t _ui32Total,
+		uint32_t _ui32Components, const LSC_QUANTIZATION_RANGE &_qrRange,
+		float * _pfOut, uint32_t _ui32Stride ) {
+		uint32_t I = 0;
+#ifdef LSSTD_SIMD_SSE2
+		if ( _ui32Stride == _ui32Components * sizeof( float ) ) {
+			// Packed output is one flat run of values.  Lane J of the Kth group of 4 values belongs to component
+			//	(K * 4 + J) % _ui32Components, which repeats after 3 groups for 3 components and after 1 otherwise.
+			uint32_t ui32Groups = _ui32Components == 3 ? 3 : 1;
+			__m128 mMin[3], mScale[3];
+			for ( uint32_t K = 0; K < ui32Groups; ++K ) {
+				float fMin[4], fScale[4];
+				for ( uint32_t J = 0; J < 4; ++J ) {
+					fMin[J] = _qrRange.fMin[(K*4+J)%_ui32Components];
+					fScale[J] = _qrRange.fScale[(K*4+J)%_ui32Components];
+				}
+				mMin[K] = _mm_loadu_ps( fMin );
+				mScale[K] = _mm_loadu_ps( fScale );
+			}
+
+			const __m128i mZero = _mm_setzero_si128();
+			uint32_t ui32Values = _ui32Total * _ui32Components;
+			uint32_t V = 0;
+			for ( uint32_t K = 0; V + 4 <= ui32Values; V += 4 ) {
+				__m128i mQ = _mm_unpacklo_epi16( _mm_loadl_epi64( reinterpret_cast<const __m128i *>(_pui16In + V) ), mZero );
+				_mm_storeu_ps( _pfOut + V, _mm_add_ps( mMin[K], _mm_mul_ps( _mm_cvtepi32_ps( mQ ), mScale[K] ) ) );
+				if ( ++K == ui32Groups ) { K = 0; }
+			}
+			// Finish the vertices that are not yet complete.
+			I = V / _ui32Components;
+		}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		uint8_t * pui8Out = reinterpret_cast<uint8_t *>(_pfOut);
+		for ( ; I < _ui32Total; ++I ) {
+			const uint16_t * pui16This = _pui16In + static_cast<uintptr_t>(I) * _ui32Components;
+			float * pfThis = reinterpret_cast<float *>(pui8Out + static_cast<uintptr_t>(I) * _ui32Stride);
+			for ( uint32_t C = 0; C < _ui32Components; ++C ) {
+				pfThis[C] = _qrRange.fMin[C] + static_cast<float>(pui16This[C]) * _qrRange.fScale[C];
+			}
+		}
+	}
+
+	/**
+	 * Encodes unit vectors such as normals and tangents with 2 components each by projecting them onto an
+	 *	octahedron which is then unfolded onto a square.  Unlike CompressNormals(), the error is spread evenly
+	 *	over the sphere.  Each vector is rounded to whichever of its 4 nearest grid points decodes closest to it.
+	 *
+	 * \param _pfIn The X component of the first vector.  Vectors need not be unit-length.
+	 * \param _ui32Stride Bytes between vectors in _pfIn.
+	 * \param _ui32Total Number of vectors.
+	 * \param _ui32Bits Bits per component, from 2 to 16.
+	 * \param _pui16Out Holds the encoded vectors, 2 values per vector.
+	 * \param _aeError Holds the angular error of the encoding in degrees.
+	 * \return Returns false if _ui32Bits is out of range.
+	 */
+	LSBOOL LSE_CALL CMisc::EncodeOctahedral( const float * _pfIn, uint32_t _ui32Stride, uint32_t _ui32Total,
+		uint32_t _ui32Bits,
+		uint16_t * _pui16Out, LSC_ATTRIBUTE_ERROR &_aeError ) {
+		_aeError.dMax = _aeError.dRms = 0.0;
+		if ( _ui32Bits < 2 || _ui32Bits > 16 ) { return false; }
+		const uint8_t * pui8In = reinterpret_cast<const uint8_t *>(_pfIn);
+		// Values are signed around a bias so that 0 and +/-1 are exact, which keeps axis-aligned vectors exact.
+		uint32_t ui32Bias = (1UL << (_ui32Bits - 1)) - 1UL;
+		float fBias = static_cast<float>(ui32Bias);
+		float fInvBias = 1.0f / fBias;
+
+		double dSum = 0.0;
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			const float * pfThis = reinterpret_cast<const float *>(pui8In + static_cast<uintptr_t>(I) * _ui32Stride);
+			double dX = pfThis[0], dY = pfThis[1], dZ = pfThis[2];
+			double dLen = ::sqrt( dX * dX + dY * dY + dZ * dZ );
+			if ( dLen ) {
+				dX /= dLen;
+				dY /= dLen;
+				dZ /= dLen;
+			}
+			else { dZ = 1.0; }
+
+			// Project onto the octahedron and fold the lower half over the upper half.
+			double dL1 = ::fabs( dX ) + ::fabs( dY ) + ::fabs( dZ );
+			double dU = dX / dL1, dV = dY / dL1;
+			if ( dZ < 0.0 ) {
+				double dTemp = (1.0 - ::fabs( dV )) * (dU >= 0.0 ? 1.0 : -1.0);
+				dV = (1.0 - ::fabs( dU )) * (dV >= 0.0 ? 1.0 : -1.0);
+				dU = dTemp;
+			}
+			dU = CStd::Clamp( (dU + 1.0) * fBias, 0.0, 2.0 * fBias );
+			dV = CStd::Clamp( (dV + 1.0) * fBias, 0.0, 2.0 * fBias );
+
+			// Try the 4 surrounding grid points.
+			uint32_t ui32U = static_cast<uint32_t>(dU), ui32V = static_cast<uint32_t>(dV);
+			uint32_t ui32BestU = ui32U, ui32BestV = ui32V;
+			double dBest = -2.0;
+			for ( uint32_t J = 0; J < 4; ++J ) {
+				uint32_t ui32TryU = CStd::Min( ui32U + (J & 1), ui32Bias * 2 );
+				uint32_t ui32TryV = CStd::Min( ui32V + (J >> 1), ui32Bias * 2 );
+				float fDecoded[3];
+				OctahedralToVector( ui32TryU, ui32TryV, fBias, fInvBias, fDecoded );
+				double dDot = fDecoded[0] * dX + fDecoded[1] * dY + fDecoded[2] * dZ;
+				if ( dDot > dBest ) {
+					dBest = dDot;
+					ui32BestU = ui32TryU;
+					ui32BestV = ui32TryV;
+				}
+			}
+			(*_pui16Out++) = static_cast<uint16_t>(ui32BestU);
+			(*_pui16Out++) = static_cast<uint16_t>(ui32BestV);
+
+			double dError = ::acos( CStd::Clamp( dBest, -1.0, 1.0 ) ) * (180.0 / LSM_PI_DOUBLE);
+			_aeError.dMax = CStd::Max( _aeError.dMax, dError );
+			dSum += dError * dError;
+		}
+		if ( _ui32Total ) {
+			_aeError.dRms = ::sqrt( dSum / _ui32Total );
+		}
+		return true;
+	}
+
+	/**
+	 * Decodes unit vectors created by EncodeOctahedral().
+	 *
+	 * \param _pui16In The encoded vectors.
+	 * \param _ui32Total Number of vectors.
+	 * \param _ui32Bits Bits per component used to encode the vectors.
+	 * \param _pfOut Holds the X component of the first decoded vector.
+	 * \param _ui32Stride Bytes between vectors in _pfOut.
+	 */
+	void LSE_CALL CMisc::DecodeOctahedral( const uint16_t * _pui16In, uint32_t _ui32Total,
+		uint32_t _ui32Bits,
+		float * _pfOut, uint32_t _ui32Stride ) {
+		float fBias = static_cast<float>((1UL << (_ui32Bits - 1)) - 1UL);
+		float fInvBias = 1.0f / fBias;
+		uint8_t * pui8Out = reinterpret_cast<uint8_t *>(_pfOut);
+		uint32_t I = 0;
+#ifdef LSSTD_SIMD_SSE2
+		// 4 vectors at a time.
+		const __m128i mZero = _mm_setzero_si128();
+		const __m128 mBias = _mm_set1_ps( fBias );
+		const __m128 mInvBias = _mm_set1_ps( fInvBias );
+		const __m128 mOne = _mm_set1_ps( 1.0f );
+		const __m128 mSign = _mm_set1_ps( -0.0f );
+		for ( ; I + 4 <= _ui32Total; I += 4 ) {
+			__m128i mQ = _mm_loadu_si128( reinterpret_cast<const __m128i *>(_pui16In + static_cast<uintptr_t>(I) * 2) );
+			__m128 mLo = _mm_cvtepi32_ps( _mm_unpacklo_epi16( mQ, mZero ) );
+			__m128 mHi = _mm_cvtepi32_ps( _mm_unpackhi_epi16( mQ, mZero ) );
+			__m128 mX = _mm_mul_ps( _mm_sub_ps( _mm_shuffle_ps( mLo, mHi, _MM_SHUFFLE( 2, 0, 2, 0 ) ), mBias ), mInvBias );
+			__m128 mY = _mm_mul_ps( _mm_sub_ps( _mm_shuffle_ps( mLo, mHi, _MM_SHUFFLE( 3, 1, 3, 1 ) ), mBias ), mInvBias );
+			__m128 mZ = _mm_sub_ps( _mm_sub_ps( mOne, _mm_andnot_ps( mSign, mX ) ), _mm_andnot_ps( mSign, mY ) );
+			// Unfold the lower half: move X and Y towards 0 by max( -Z, 0 ).
+			__m128 mT = _mm_max_ps( _mm_xor_ps( mZ, mSign ), _mm_setzero_ps() );
+			mX = _mm_sub_ps( mX, _mm_or_ps( mT, _mm_and_ps( mX, mSign ) ) );
+			mY = _mm_sub_ps( mY, _mm_or_ps( mT, _mm_and_ps( mY, mSign ) ) );
+			__m128 mLen = _mm_div_ps( mOne, _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( mX, mX ), _mm_mul_ps( mY, mY ) ), _mm_mul_ps( mZ, mZ ) ) ) );
+			mX = _mm_mul_ps( mX, mLen );
+			mY = _mm_mul_ps( mY, mLen );
+			mZ = _mm_mul_ps( mZ, mLen );
+
+			__m128 mW = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS( mX, mY, mZ, mW );
+			const __m128 * pmRows[4] = { &mX, &mY, &mZ, &mW };
+			for ( uint32_t J = 0; J < 4; ++J ) {
+				float * pfThis = reinterpret_cast<float *>(pui8Out + static_cast<uintptr_t>(I + J) * _ui32Stride);
+				_mm_storel_pi( reinterpret_cast<__m64 *>(pfThis), (*pmRows[J]) );
+				_mm_store_ss( pfThis + 2, _mm_movehl_ps( (*pmRows[J]), (*pmRows[J]) ) );
+			}
+		}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		for ( ; I < _ui32Total; ++I ) {
+			OctahedralToVector( _pui16In[I*2], _pui16In[I*2+1], fBias, fInvBias,
+				reinterpret_cast<float *>(pui8Out + static_cast<uintptr_t>(I) * _ui32Stride) );
+		}
+	}
+
+	/**
+	 * Renormalizes skin weights and quantizes them to 8 bits such that the weights of each vertex always add
+	 *	up to exactly 255.  Rounding errors are given to the largest weight.  A vertex whose weights add up to 0
+	 *	keeps all of its weights at 0.
+	 *
+	 * \param _pfIn The first weight of the first vertex.
+	 * \param _ui32Stride Bytes between vertices in _pfIn.
+	 * \param _ui32Total Number of vertices.
+	 * \param _ui32Weights Number of weights per vertex, from 1 to 8.
+	 * \param _pui8Out Holds the quantized weights, _ui32Weights per vertex.
+	 * \param _aeError Holds the error of the quantization relative to the renormalized weights.
+	 * \return Returns false if _ui32Weights is out of range.
+	 */
+	LSBOOL LSE_CALL CMisc::QuantizeWeights( const float * _pfIn, uint32_t _ui32Stride, uint32_t _ui32Total,
+		uint32_t _ui32Weights,
+		uint8_t * _pui8Out, LSC_ATTRIBUTE_ERROR &_aeError ) {
+		_aeError.dMax = _aeError.dRms = 0.0;
+		if ( _ui32Weights < 1 || _ui32Weights > 8 ) { return false; }
+		const uint8_t * pui8In = reinterpret_cast<const uint8_t *>(_pfIn);
+
+		double dSum = 0.0;
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			const float * pfThis = reinterpret_cast<const float *>(pui8In + static_cast<uintptr_t>(I) * _ui32Stride);
+			uint8_t * pui8This = _pui8Out + static_cast<uintptr_t>(I) * _ui32Weights;
+			// Negative weights are not valid and are treated as 0.
+			double dWeights[8];
+			double dTotal = 0.0;
+			for ( uint32_t J = 0; J < _ui32Weights; ++J ) {
+				dWeights[J] = CStd::Max( static_cast<double>(pfThis[J]), 0.0 );
+				dTotal += dWeights[J];
+			}
+			if ( dTotal <= 0.0 ) {
+				CStd::MemSet( pui8This, 0, _ui32Weights );
+				continue;
+			}
+
+			int32_t i32Left = 255;
+			uint32_t ui32Largest = 0;
+			for ( uint32_t J = 0; J < _ui32Weights; ++J ) {
+				dWeights[J] /= dTotal;
+				pui8This[J] = static_cast<uint8_t>(::floor( dWeights[J] * 255.0 + 0.5 ));
+				i32Left -= pui8This[J];
+				if ( pui8This[J] > pui8This[ui32Largest] ) { ui32Largest = J; }
+			}
+			// The largest weight is at least 255 / _ui32Weights, so it can always absorb the rounding error.
+			pui8This[ui32Largest] = static_cast<uint8_t>(pui8This[ui32Largest] + i32Left);
+
+			for ( uint32_t J = 0; J < _ui32Weights; ++J ) {
+				double dError = ::fabs( pui8This[J] / 255.0 - dWeights[J] );
+				_aeError.dMax = CStd::Max( _aeError.dMax, dError );
+				dSum += dError * dError;
+			}
+		}
+		if ( _ui32Total ) {
+			_aeError.dRms = ::sqrt( dSum / (static_cast<double>(_ui32Total) * _ui32Weights) );
+		}
+		return true;
+	}
+
+	/**
+	 * Filters quantized attribute data so that the LZW coder can compress it better.  Each component is replaced
+	 *	by its difference from the same component of the previous vertex (zig-zag encoded so that small negative
+	 *	differences become small positive numbers), and the low and high bytes of each component are then
+	 *	written to separate planes.  Neighboring vertices tend to be close to each other, so most of the high
+	 *	bytes become 0, and attributes quantized to 8 bits or less leave an entire plane of 0's.
+	 *
+	 * \param _pui16In The quantized components.
+	 * \param _ui32Total Number of vertices.
+	 * \param _ui32Components Number of components per vertex.
+	 * \param _pui8Out Holds the filtered bytes.  Must be able to hold _ui32Total * _ui32Components * 2 bytes.
+	 */
+	void LSE_CALL CMisc::FilterDelta( const uint16_t * _pui16In, uint32_t _ui32Total,
+		uint32_t _ui32Components,
+		uint8_t * _pui8Out ) {
+		for ( uint32_t C = 0; C < _ui32Components; ++C ) {
+			// Plane C * 2 holds the low bytes and plane C * 2 + 1 holds the high bytes.
+			uint8_t * pui8Low = _pui8Out + static_cast<uintptr_t>(C * 2) * _ui32Total;
+			uint8_t * pui8High = pui8Low + _ui32Total;
+			uint16_t ui16Prev = 0;
+			for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+				uint16_t ui16This = _pui16In[static_cast<uintptr_t>(I)*_ui32Components+C];
+				int32_t i32Delta = static_cast<int16_t>(ui16This - ui16Prev);
+				ui16Prev = ui16This;
+				uint16_t ui16Zig = static_cast<uint16_t>((static_cast<uint32_t>(i32Delta) << 1) ^ static_cast<uint32_t>(i32Delta >> 15));
+				pui8Low[I] = static_cast<uint8_t>(ui16Zig);
+				pui8High[I] = static_cast<uint8_t>(ui16Zig >> 8);
+			}
+		}
+	}
+
+	/**
+	 * Reverses FilterDelta().
+	 *
+	 * \param _pui8In The filtered bytes.
+	 * \param _ui32Total Number of vertices.
+	 * \param _ui32Components Number of components per vertex.
+	 * \param _pui16Out Holds the quantized components.
+	 */
+	void LSE_CALL CMisc::UnfilterDelta( const uint8_t * _pui8In, uint32_t _ui32Total,
+		uint32_t _ui32Components,
+		uint16_t * _pui16Out ) {
+		for ( uint32_t C = 0; C < _ui32Components; ++C ) {
+			const uint8_t * pui8Low = _pui8In + static_cast<uintptr_t>(C * 2) * _ui32Total;
+			const uint8_t * pui8High = pui8Low + _ui32Total;
+			uint16_t * pui16Out = _pui16Out + C;
+			uint16_t ui16Prev = 0;
+			uint32_t I = 0;
+#ifdef LSSTD_SIMD_SSE2
+			// 8 values at a time: interleave the planes, undo the zig-zag, and take the running sum in log2( 8 ) steps.
+			const __m128i mOne = _mm_set1_epi16( 1 );
+			__m128i mPrev = _mm_setzero_si128();
+			for ( ; I + 8 <= _ui32Total; I += 8 ) {
+				__m128i mZig = _mm_unpacklo_epi8( _mm_loadl_epi64( reinterpret_cast<const __m128i *>(pui8Low + I) ),
+					_mm_loadl_epi64( reinterpret_cast<const __m128i *>(pui8High + I) ) );
+				__m128i mDelta = _mm_xor_si128( _mm_srli_epi16( mZig, 1 ),
+					_mm_sub_epi16( _mm_setzero_si128(), _mm_and_si128( mZig, mOne ) ) );
+				mDelta = _mm_add_epi16( mDelta, _mm_slli_si128( mDelta, 2 ) );
+				mDelta = _mm_add_epi16( mDelta, _mm_slli_si128( mDelta, 4 ) );
+				mDelta = _mm_add_epi16( mDelta, _mm_slli_si128( mDelta, 8 ) );
+				mDelta = _mm_add_epi16( mDelta, mPrev );
+				// Broadcast the last value for the next 8.
+				mPrev = _mm_shufflehi_epi16( mDelta, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+				mPrev = _mm_unpackhi_epi64( mPrev, mPrev );
+
+				if ( _ui32Components == 1 ) {
+					_mm_storeu_si128( reinterpret_cast<__m128i *>(pui16Out + I), mDelta );
+				}
+				else {
+					uint16_t ui16Values[8];
+					_mm_storeu_si128( reinterpret_cast<__m128i *>(ui16Values), mDelta );
+					uint16_t * pui16This = pui16Out + static_cast<uintptr_t>(I) * _ui32Components;
+					for ( uint32_t J = 0; J < 8; ++J ) {
+						pui16This[J*_ui32Components] = ui16Values[J];
+					}
+				}
+			}
+			ui16Prev = static_cast<uint16_t>(_mm_cvtsi128_si32( mPrev ));
+#endif	// #ifdef LSSTD_SIMD_SSE2
+			for ( ; I < _ui32Total; ++I ) {
+				uint16_t ui16Zig = static_cast<uint16_t>(pui8Low[I] | (pui8High[I] << 8));
+				ui16Prev = static_cast<uint16_t>(ui16Prev + ((ui16Zig >> 1) ^ (0U - (ui16Zig & 1U))));
+				pui16Out[static_cast<uintptr_t>(I)*_ui32Components] = ui16Prev;
+			}
+		}
+	}
+
 	/**
 	 * Compress data at a given bit depth.
 	 *
@@ -118,7 +520,8 @@ namespace lsc {
 	}
 
 	/**
-	 * Find the best compression size and return the compressed bytes and the bit-count.
+	 * Find the best compression size and return the compressed bytes and the bit-count.  Large inputs are compressed
+	 *	at each bit depth in parallel.
 	 *
 	 * \param _pui8Input The input data to compress.
 	 * \param _ui32Length Length of the input data to compress.
@@ -129,20 +532,51 @@ namespace lsc {
 	LSBOOL LSE_CALL CMisc::CompressBest( const uint8_t * _pui8Input, uint32_t _ui32Length, uint32_t &_ui32Bits, lsc::CBitStream &_bsStream ) {
 		// Find the best compression level.
 		_ui32Bits = 0;
-		uint32_t ui32LowSize = LSE_MAXU32;
-		for ( uint32_t I = 9; I <= 14; ++I ) {
-			if ( m_ui32CompressLevel == CMisc::LSC_CL_MEDIUM && I != 12 ) { continue; }
-			lsc::CBitStream bsTemp;
-			bsTemp.PreAlloc( _ui32Length );
-			if ( !Compress( _pui8Input, _ui32Length, I, bsTemp, ui32LowSize ) ) { return false; }
-
-			if ( _ui32Bits == 0 || bsTemp.GetLengthInBytes() < _bsStream.GetLengthInBytes() ) {
-				_bsStream.Reset();
-				if ( _bsStream.WriteBytes( bsTemp.GetRawBytes(), bsTemp.GetLengthInBytes() ) != bsTemp.GetLengthInBytes() ) {
-					return false;
+		uint32_t ui32MinBits = 9, ui32MaxBits = 14;
+		if ( m_ui32CompressLevel == CMisc::LSC_CL_MEDIUM ) { ui32MinBits = ui32MaxBits = 12; }
+		const uint32_t ui32Total = ui32MaxBits - ui32MinBits + 1;
+
+		// Below this size, spreading the bit depths over the job system costs more than compressing serially.  Serial
+		//	compression can also stop early on bit depths that have already lost, so it is also used when the job system
+		//	is not running.
+		static const uint32_t ui32ThreadedSize = 64 * 1024;
+		if ( ui32Total > 1 && _ui32Length >= ui32ThreadedSize && CJobSystem::TotalThreads() > 1 ) {
+			lsc::CBitStream bsTemp[6];
+			LSC_COMPRESS_JOB_DATA cjdData;
+			cjdData.pui8Input = _pui8Input;
+			cjdData.ui32Length = _ui32Length;
+			cjdData.ui32MinBits = ui32MinBits;
+			cjdData.pbsStreams = bsTemp;
+			CAtomic::AtomicStore( cjdData.aFailed, 0 );
+			CJobSystem::ParallelFor( ui32Total, CompressRange, &cjdData );
+			if ( CAtomic::AtomicLoad( cjdData.aFailed ) ) { return false; }
+
+			// Ties go to the lowest bit depth, as in the serial search.
+			uint32_t ui32Best = 0;
+			for ( uint32_t I = 1; I < ui32Total; ++I ) {
+				if ( bsTemp[I].GetLengthInBytes() < bsTemp[ui32Best].GetLengthInBytes() ) { ui32Best = I; }
+			}
+			_bsStream.Reset();
+			if ( _bsStream.WriteBytes( bsTemp[ui32Best].GetRawBytes(), bsTemp[ui32Best].GetLengthInBytes() ) != bsTemp[ui32Best].GetLengthInBytes() ) {
+				return false;
+			}
+			_ui32Bits = ui32MinBits + ui32Best;
+		}
+		else {
+			uint32_t ui32LowSize = LSE_MAXU32;
+			for ( uint32_t I = ui32MinBits; I <= ui32MaxBits; ++I ) {
+				lsc::CBitStream bsTemp;
+				bsTemp.PreAlloc( _ui32Length );
+				if ( !Compress( _pui8Input, _ui32Length, I, bsTemp, ui32LowSize ) ) { return false; }
+
+				if ( _ui32Bits == 0 || bsTemp.GetLengthInBytes() < _bsStream.GetLengthInBytes() ) {
+					_bsStream.Reset();
+					if ( _bsStream.WriteBytes( bsTemp.GetRawBytes(), bsTemp.GetLengthInBytes() ) != bsTemp.GetLengthInBytes() ) {
+						return false;
+					}
+					_ui32Bits = I;
+					ui32LowSize = bsTemp.GetLengthInBytes();
 				}
-				_ui32Bits = I;
-				ui32LowSize = bsTemp.GetLengthInBytes();
 			}
 		}
 
@@ -202,7 +636,7 @@ namespace lsc {
 
 	/**
 	 * Decompress from packed data of any kind to a buffer.  If the expanded size is known beforehand, call Allocate() on the buffer to improve
-	 *	the performance of this call.
+	 *	the performance of this call.  The compressed bytes are read and expanded a chunk at a time rather than all at once.
 	 *
 	 * \param _isStream Stream containing the bytes to expand.
 	 * \param _bBuffer Holds the expanded data.
@@ -214,38 +648,56 @@ namespace lsc {
 
 		uint32_t ui32Size;
 		if ( _isStream.ReadBytes( reinterpret_cast<uint8_t *>(&ui32Size), sizeof( ui32Size ) ) != sizeof( ui32Size ) ) { return false; }
+		if ( !ui32Size ) { return true; }
 
-		uint8_t * pui8Buffer = LSENEW uint8_t[ui32Size];
-		if ( !pui8Buffer ) { return false; }
-
-		if ( _isStream.ReadBytes( pui8Buffer, ui32Size ) != ui32Size ) {
-			LSEDELETE [] pui8Buffer;
-			return false;
-		}
-
-
+		uint32_t ui32Start = _bBuffer.Length();
 		if ( ui8CompressionBits == 0 ) {
 			// No compression.
-			LSBOOL bRet = _bBuffer.Append( pui8Buffer,
-				ui32Size );
-			LSEDELETE [] pui8Buffer;
-			return bRet;
+			if ( !_bBuffer.ResizeUninitialized( ui32Start + ui32Size ) ) { return false; }
+			if ( _isStream.ReadBytes( &_bBuffer[ui32Start], ui32Size ) != ui32Size ) {
+				_bBuffer.ResizeUninitialized( ui32Start );
+				return false;
+			}
+			return true;
 		}
-		// Must be decompressed.
+
+		// Must be decompressed.  The compressed bytes are read and decoded a chunk at a time, straight into the buffer.
+		uint32_t ui32ChunkSize = CStd::Min<uint32_t>( ui32Size, 64 * 1024 );
+		uint8_t * pui8Chunk = LSENEW uint8_t[ui32ChunkSize];
+		if ( !pui8Chunk ) { return false; }
+
 		CLzwDecoder ldDecoder;
-		lsc::CBitStream bsDest;
-		bsDest.PreAlloc( ui32Size << 1 );	// Average compression amount is 40%, so using a buffer double the needed size
-											//	should be good.  And if this fails, just continue.
-		lsc::CBitStream bsBits;
-		bsBits.Borrow( pui8Buffer, ui32Size );
-		if ( ldDecoder.Decode( bsBits, 256, ui8CompressionBits, bsDest ) == 0 ) {
-			LSEDELETE [] pui8Buffer;
-			return false;
+		ldDecoder.BeginStream( 256, ui8CompressionBits );
+		uint32_t ui32Left = ui32Size, ui32ChunkPos = 0, ui32ChunkLen = 0;
+		uint32_t ui32Out = ui32Start;
+		// Average compression amount is 40%, so using a buffer double the needed size should be good.
+		LSBOOL bRet = _bBuffer.ResizeUninitialized( ui32Start + CStd::Min<uint32_t>( ui32Size, (LSE_MAXU32 - ui32Start) >> 1 ) * 2 );
+		while ( bRet ) {
+			if ( ui32ChunkPos == ui32ChunkLen && ui32Left ) {
+				ui32ChunkLen = CStd::Min( ui32Left, ui32ChunkSize );
+				if ( _isStream.ReadBytes( pui8Chunk, ui32ChunkLen ) != ui32ChunkLen ) { bRet = false; break; }
+				ui32Left -= ui32ChunkLen;
+				ui32ChunkPos = 0;
+			}
+			uintptr_t uiptrUsed, uiptrWritten;
+			LSC_DECODE_STATUS dsStatus = ldDecoder.DecodeStream( pui8Chunk + ui32ChunkPos, ui32ChunkLen - ui32ChunkPos, uiptrUsed,
+				&_bBuffer[0] + ui32Out, _bBuffer.Length() - ui32Out, uiptrWritten );
+			ui32ChunkPos += static_cast<uint32_t>(uiptrUsed);
+			ui32Out += static_cast<uint32_t>(uiptrWritten);
+			if ( dsStatus == LSC_DS_DONE ) { break; }
+			if ( dsStatus == LSC_DS_ERROR ) { bRet = false; break; }
+			if ( dsStatus == LSC_DS_OUTPUT_FULL ) {
+				uint32_t ui32Grow = CStd::Min<uint32_t>( CStd::Max<uint32_t>( ui32Out - ui32Start, 64 * 1024 ), LSE_MAXU32 - ui32Out );
+				bRet = ui32Grow && _bBuffer.ResizeUninitialized( ui32Out + ui32Grow );
+			}
+			else if ( !ui32Left ) {
+				// All of the input was used without an end-of-input code.
+				break;
+			}
 		}
-
-		LSEDELETE [] pui8Buffer;
-		return _bBuffer.Append( bsDest.GetRawBytes(),
-			bsDest.GetLengthInBytes() );
+		LSEDELETE [] pui8Chunk;
+		_bBuffer.ResizeUninitialized( bRet ? ui32Out : ui32Start );
+		return bRet;
 	}
 
 	/**
@@ -475,4 +927,45 @@ namespace lsc {
 		return static_cast<int32_t>(i32Value << (32 - static_cast<int32_t>(_ui32Bits))) >> (32 - static_cast<int32_t>(_ui32Bits));
 	}
 
+	/**
+	 * Decodes one vector encoded by EncodeOctahedral() with the scalar path.  The SIMD path in
+	 *	DecodeOctahedral() performs the same operations in the same order.
+	 *
+	 * \param _ui32X The first encoded component.
+	 * \param _ui32Y The second encoded component.
+	 * \param _fBias The encoded value that decodes to 0.
+	 * \param _fInvBias 1 / _fBias.
+	 * \param _pfOut Holds the 3 decoded components.
+	 */
+	void LSE_CALL CMisc::OctahedralToVector( uint32_t _ui32X, uint32_t _ui32Y, float _fBias, float _fInvBias,
+		float * _pfOut ) {
+		float fX = (static_cast<float>(_ui32X) - _fBias) * _fInvBias;
+		float fY = (static_cast<float>(_ui32Y) - _fBias) * _fInvBias;
+		float fZ = (1.0f - ::fabsf( fX )) - ::fabsf( fY );
+		float fT = CStd::Max( -fZ, 0.0f );
+		fX = fX >= 0.0f ? fX - fT : fX + fT;
+		fY = fY >= 0.0f ? fY - fT : fY + fT;
+		float fLen = 1.0f / ::sqrtf( (fX * fX + fY * fY) + fZ * fZ );
+		_pfOut[0] = fX * fLen;
+		_pfOut[1] = fY * fLen;
+		_pfOut[2] = fZ * fLen;
+	}
+
+	/**
+	 * Job function for compressing at a range of bit depths.
+	 *
+	 * \param _ui32Begin Index of the first bit depth to try, relative to LSC_COMPRESS_JOB_DATA::ui32MinBits.
+	 * \param _ui32End Index of the bit depth after the last to try.
+	 * \param _pvParm Pointer to an LSC_COMPRESS_JOB_DATA structure.
+	 */
+	void LSE_CALL CMisc::CompressRange( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm ) {
+		LPLSC_COMPRESS_JOB_DATA lpcjdData = static_cast<LPLSC_COMPRESS_JOB_DATA>(_pvParm);
+		for ( uint32_t I = _ui32Begin; I < _ui32End; ++I ) {
+			lpcjdData->pbsStreams[I].PreAlloc( lpcjdData->ui32Length );
+			if ( !Compress( lpcjdData->pui8Input, lpcjdData->ui32Length, lpcjdData->ui32MinBits + I, lpcjdData->pbsStreams[I] ) ) {
+				CAtomic::AtomicStore( lpcjdData->aFailed, 1 );
+			}
+		}
+	}
+
 }	// namespace lsc
@@ -61,6 +61,28 @@ namespace lsc {
 		 */
 		typedef CVectorPoD<uint8_t, uint32_t, 1048576UL>LSC_BUFFER;
 
+		/**
+		 * The range of a quantized attribute.  Component C of a vertex decodes to fMin[C] + Q * fScale[C], where Q
+		 *	is the stored integer.
+		 */
+		typedef struct LSC_QUANTIZATION_RANGE {
+			/** The smallest value of each component. */
+			float										fMin[4];
+			/** The size of one quantization step for each component. */
+			float										fScale[4];
+		} * LPLSC_QUANTIZATION_RANGE, * const LPCLSC_QUANTIZATION_RANGE;
+
+		/**
+		 * How far the decoded values of an attribute are from the originals.  Range-quantized attributes report
+		 *	errors in their own units, octahedral vectors in degrees, and weights as fractions of 1.
+		 */
+		typedef struct LSC_ATTRIBUTE_ERROR {
+			/** The largest error. */
+			double										dMax;
+			/** The root-mean-square error. */
+			double										dRms;
+		} * LPLSC_ATTRIBUTE_ERROR, * const LPCLSC_ATTRIBUTE_ERROR;
+
 
 		// == Functions
 		/**
@@ -97,6 +119,117 @@ namespace lsc {
 			const lsc::CBitStream &_bsSigns, uint32_t _ui32Total,
 			CVector3 * _pvOut );
 
+		/**
+		 * Quantizes the components of an attribute to the given number of bits relative to the bounds of the
+		 *	attribute over all of the vertices.  Used for positions (3 components) and texture coordinates (2
+		 *	components).  Each component is spread over its own range, so the error along each axis is at most
+		 *	half of one step of that axis.
+		 *
+		 * \param _pfIn The first component of the first vertex.
+		 * \param _ui32Stride Bytes between vertices in _pfIn.
+		 * \param _ui32Total Number of vertices.
+		 * \param _ui32Components Number of components per vertex, from 1 to 4.
+		 * \param _ui32Bits Bits per component, from 1 to 16.  8, 10, and 16 are typical for positions.
+		 * \param _pui16Out Holds the quantized components, _ui32Components per vertex.  Must be able to hold
+		 *	_ui32Total * _ui32Components values.
+		 * \param _qrRange Holds the range needed to decode the values.
+		 * \param _aeError Holds the error of the quantization.
+		 * \return Returns false if _ui32Components or _ui32Bits is out of range.
+		 */
+		static LSBOOL LSE_CALL							QuantizeAttribute( const float * _pfIn, uint32_t _ui32Stride, uint32_t _ui32Total,
+			uint32_t _ui32Components, uint32_t _ui32Bits,
+			uint16_t * _pui16Out, LSC_QUANTIZATION_RANGE &_qrRange, LSC_ATTRIBUTE_ERROR &_aeError );
+
+		/**
+		 * Decodes components created by QuantizeAttribute().
+		 *
+		 * \param _pui16In The quantized components.
+		 * \param _ui32Total Number of vertices.
+		 * \param _ui32Components Number of components per vertex, from 1 to 4.
+		 * \param _qrRange The range returned by QuantizeAttribute().
+		 * \param _pfOut Holds the first component of the first decoded vertex.
+		 * \param _ui32Stride Bytes between vertices in _pfOut.  Decoding is fastest when the output is packed
+		 *	(_ui32Components * sizeof( float )).
+		 */
+		static void LSE_CALL							DequantizeAttribute( const uint16_t * _pui16In, uint32_t _ui32Total,
+			uint32_t _ui32Components, const LSC_QUANTIZATION_RANGE &_qrRange,
+			float * _pfOut, uint32_t _ui32Stride );
+
+		/**
+		 * Encodes unit vectors such as normals and tangents with 2 components each by projecting them onto an
+		 *	octahedron which is then unfolded onto a square.  Unlike CompressNormals(), the error is spread evenly
+		 *	over the sphere.  Each vector is rounded to whichever of its 4 nearest grid points decodes closest to it.
+		 *
+		 * \param _pfIn The X component of the first vector.  Vectors need not be unit-length.
+		 * \param _ui32Stride Bytes between vectors in _pfIn.
+		 * \param _ui32Total Number of vectors.
+		 * \param _ui32Bits Bits per component, from 2 to 16.
+		 * \param _pui16Out Holds the encoded vectors, 2 values per vector.
+		 * \param _aeError Holds the angular error of the encoding in degrees.
+		 * \return Returns false if _ui32Bits is out of range.
+		 */
+		static LSBOOL LSE_CALL							EncodeOctahedral( const float * _pfIn, uint32_t _ui32Stride, uint32_t _ui32Total,
+			uint32_t _ui32Bits,
+			uint16_t * _pui16Out, LSC_ATTRIBUTE_ERROR &_aeError );
+
+		/**
+		 * Decodes unit vectors created by EncodeOctahedral().
+		 *
+		 * \param _pui16In The encoded vectors.
+		 * \param _ui32Total Number of vectors.
+		 * \param _ui32Bits Bits per component used to encode the vectors.
+		 * \param _pfOut Holds the X component of the first decoded vector.
+		 * \param _ui32Stride Bytes between vectors in _pfOut.
+		 */
+		static void LSE_CALL							DecodeOctahedral( const uint16_t * _pui16In, uint32_t _ui32Total,
+			uint32_t _ui32Bits,
+			float * _pfOut, uint32_t _ui32Stride );
+
+		/**
+		 * Renormalizes skin weights and quantizes them to 8 bits such that the weights of each vertex always add
+		 *	up to exactly 255.  Rounding errors are given to the largest weight.  A vertex whose weights add up to 0
+		 *	keeps all of its weights at 0.
+		 *
+		 * \param _pfIn The first weight of the first vertex.
+		 * \param _ui32Stride Bytes between vertices in _pfIn.
+		 * \param _ui32Total Number of vertices.
+		 * \param _ui32Weights Number of weights per vertex, from 1 to 8.
+		 * \param _pui8Out Holds the quantized weights, _ui32Weights per vertex.
+		 * \param _aeError Holds the error of the quantization relative to the renormalized weights.
+		 * \return Returns false if _ui32Weights is out of range.
+		 */
+		static LSBOOL LSE_CALL							QuantizeWeights( const float * _pfIn, uint32_t _ui32Stride, uint32_t _ui32Total,
+			uint32_t _ui32Weights,
+			uint8_t * _pui8Out, LSC_ATTRIBUTE_ERROR &_aeError );
+
+		/**
+		 * Filters quantized attribute data so that the LZW coder can compress it better.  Each component is replaced
+		 *	by its difference from the same component of the previous vertex (zig-zag encoded so that small negative
+		 *	differences become small positive numbers), and the low and high bytes of each component are then
+		 *	written to separate planes.  Neighboring vertices tend to be close to each other, so most of the high
+		 *	bytes become 0, and attributes quantized to 8 bits or less leave an entire plane of 0's.
+		 *
+		 * \param _pui16In The quantized components.
+		 * \param _ui32Total Number of vertices.
+		 * \param _ui32Components Number of components per vertex.
+		 * \param _pui8Out Holds the filtered bytes.  Must be able to hold _ui32Total * _ui32Components * 2 bytes.
+		 */
+		static void LSE_CALL							FilterDelta( const uint16_t * _pui16In, uint32_t _ui32Total,
+			uint32_t _ui32Components,
+			uint8_t * _pui8Out );
+
+		/**
+		 * Reverses FilterDelta().
+		 *
+		 * \param _pui8In The filtered bytes.
+		 * \param _ui32Total Number of vertices.
+		 * \param _ui32Components Number of components per vertex.
+		 * \param _pui16Out Holds the quantized components.
+		 */
+		static void LSE_CALL							UnfilterDelta( const uint8_t * _pui8In, uint32_t _ui32Total,
+			uint32_t _ui32Components,
+			uint16_t * _pui16Out );
+
 		/**
 		 * Compress data at a given bit depth.
 		 *
@@ -110,7 +243,8 @@ namespace lsc {
 		static LSBOOL LSE_CALL							Compress( const uint8_t * _pui8Input, uint32_t _ui32Length, uint32_t _ui32Bits, lsc::CBitStream &_bsStream, uint32_t _ui32MaxSize = LSE_MAXU32 );
 
 		/**
-		 * Find the best compression size and return the compressed bytes and the bit-count.
+		 * Find the best compression size and return the compressed bytes and the bit-count.  Large inputs are compressed
+		 *	at each bit depth in parallel.
 		 *
 		 * \param _pui8Input The input data to compress.
 		 * \param _ui32Length Length of the input data to compress.
@@ -143,7 +277,7 @@ namespace lsc {
 
 		/**
 		 * Decompress from packed data of any kind to a buffer.  If the expanded size is known beforehand, call Allocate() on the buffer to improve
-		 *	the performance of this call.
+		 *	the performance of this call.  The compressed bytes are read and expanded a chunk at a time rather than all at once.
 		 *
 		 * \param _isStream Stream containing the bytes to expand.
 		 * \param _bBuffer Holds the expanded data.
@@ -247,6 +381,24 @@ namespace lsc {
 
 
 	protected :
+		// == Types.
+		/**
+		 * Data passed to the jobs compressing at each bit depth.
+		 */
+		typedef struct LSC_COMPRESS_JOB_DATA {
+			/** The input data to compress. */
+			const uint8_t *								pui8Input;
+			/** Length of the input data to compress. */
+			uint32_t									ui32Length;
+			/** The maximum bit depth of the first stream. */
+			uint32_t									ui32MinBits;
+			/** The compressed data, one stream per bit depth. */
+			lsc::CBitStream *							pbsStreams;
+			/** Set to 1 if any bit depth fails. */
+			CAtomic::ATOM								aFailed;
+		} * LPLSC_COMPRESS_JOB_DATA, * const LPCLSC_COMPRESS_JOB_DATA;
+
+
 		// == Members.
 		/**
 		 * Compression level.
@@ -271,6 +423,28 @@ namespace lsc {
 		 * \return Returns the signed value.
 		 */
 		static int32_t LSE_CALL							GetSignedValue( const lsc::CBitStream &_bsStream, uint32_t _ui32Bits );
+
+		/**
+		 * Decodes one vector encoded by EncodeOctahedral() with the scalar path.  The SIMD path in
+		 *	DecodeOctahedral() performs the same operations in the same order.
+		 *
+		 * \param _ui32X The first encoded component.
+		 * \param _ui32Y The second encoded component.
+		 * \param _fBias The encoded value that decodes to 0.
+		 * \param _fInvBias 1 / _fBias.
+		 * \param _pfOut Holds the 3 decoded components.
+		 */
+		static void LSE_CALL							OctahedralToVector( uint32_t _ui32X, uint32_t _ui32Y, float _fBias, float _fInvBias,
+			float * _pfOut );
+
+		/**
+		 * Job function for compressing at a range of bit depths.
+		 *
+		 * \param _ui32Begin Index of the first bit depth to try, relative to LSC_COMPRESS_JOB_DATA::ui32MinBits.
+		 * \param _ui32End Index of the bit depth after the last to try.
+		 * \param _pvParm Pointer to an LSC_COMPRESS_JOB_DATA structure.
+		 */
+		static void LSE_CALL							CompressRange( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm );
 	};
 
 
@@ -0,0 +1,120 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Measures how well a triangle-list index buffer uses the post-transform vertex cache and how
+ *	efficiently its vertices are fetched from memory.
+ */
+
+#include "LSCMeshAnalyzer.h"
+#include "Vector/LSTLVectorPoD.h"
+
+
+namespace lsc {
+
+	// == Functions.
+	/**
+	 * Simulates a FIFO post-transform vertex cache over a triangle list.
+	 *
+	 * \param _pui32Indices The index buffer.
+	 * \param _ui32Total Total indices in the index buffer.
+	 * \param _ui32Vertices Total vertices in the vertex buffer.  Every index must be below this.
+	 * \param _ui32CacheSize Number of vertices in the simulated cache.
+	 * \param _vcsStats Holds the returned statistics.
+	 * \return Returns true if there was enough memory to perform the operation.
+	 */
+	LSBOOL LSE_CALL CMeshAnalyzer::AnalyzeVertexCache( const uint32_t * _pui32Indices, uint32_t _ui32Total,
+		uint32_t _ui32Vertices, uint32_t _ui32CacheSize, LSC_VERTEX_CACHE_STATS &_vcsStats ) {
+		_vcsStats.ui32Transformed = 0;
+		_vcsStats.dAcmr = _vcsStats.dAtvr = 0.0;
+
+		// A vertex is in the cache if it missed within the last _ui32CacheSize misses.  Starting the clock past the
+		//	cache size makes every time stamp of 0 a miss.
+		CVectorPoD<uint32_t, uint32_t> vTimeStamps;
+		if ( !_ui32Vertices || !vTimeStamps.Resize( _ui32Vertices ) ) { return _ui32Total == 0; }
+		CStd::MemSet( &vTimeStamps[0], 0, sizeof( uint32_t ) * vTimeStamps.Length() );
+		uint32_t ui32Time = _ui32CacheSize + 1;
+		uint32_t ui32Unique = 0;
+
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			uint32_t ui32V = _pui32Indices[I];
+			assert( ui32V < _ui32Vertices );
+			if ( ui32Time - vTimeStamps[ui32V] > _ui32CacheSize ) {
+				if ( !vTimeStamps[ui32V] ) { ++ui32Unique; }
+				vTimeStamps[ui32V] = ui32Time++;
+				++_vcsStats.ui32Transformed;
+			}
+		}
+
+		if ( _ui32Total >= 3 ) {
+			_vcsStats.dAcmr = static_cast<double>(_vcsStats.ui32Transformed) / static_cast<double>(_ui32Total / 3);
+		}
+		if ( ui32Unique ) {
+			_vcsStats.dAtvr = static_cast<double>(_vcsStats.ui32Transformed) / static_cast<double>(ui32Unique);
+		}
+		return true;
+	}
+
+	/**
+	 * Simulates fetching the vertices of a triangle list through a small FIFO cache of memory lines.
+	 *
+	 * \param _pui32Indices The index buffer.
+	 * \param _ui32Total Total indices in the index buffer.
+	 * \param _ui32Vertices Total vertices in the vertex buffer.  Every index must be below this.
+	 * \param _ui32VertexSize Size of each vertex in bytes.
+	 * \param _vfsStats Holds the returned statistics.
+	 * \param _ui32LineSize Size of a memory line in bytes.
+	 * \param _ui32Lines Number of lines in the simulated cache.
+	 * \return Returns true if there was enough memory to perform the operation.
+	 */
+	LSBOOL LSE_CALL CMeshAnalyzer::AnalyzeVertexFetch( const uint32_t * _pui32Indices, uint32_t _ui32Total,
+		uint32_t _ui32Vertices, uint32_t _ui32VertexSize, LSC_VERTEX_FETCH_STATS &_vfsStats,
+		uint32_t _ui32LineSize, uint32_t _ui32Lines ) {
+		_vfsStats.ui64BytesFetched = 0;
+		_vfsStats.dOverfetch = 0.0;
+		if ( !_ui32LineSize || !_ui32VertexSize || !_ui32Vertices ) { return _ui32Total == 0; }
+
+		uint64_t ui64TotalLines = (static_cast<uint64_t>(_ui32Vertices) * _ui32VertexSize + _ui32LineSize - 1) / _ui32LineSize;
+		if ( ui64TotalLines > LSE_MAXU32 ) { return false; }
+		CVectorPoD<uint32_t, uint32_t> vTimeStamps;
+		if ( !vTimeStamps.Resize( static_cast<uint32_t>(ui64TotalLines) ) ) { return false; }
+		CStd::MemSet( &vTimeStamps[0], 0, sizeof( uint32_t ) * vTimeStamps.Length() );
+		CVectorPoD<uint8_t, uint32_t> vUsed;
+		if ( !vUsed.Resize( _ui32Vertices ) ) { return false; }
+		CStd::MemSet( &vUsed[0], 0, vUsed.Length() );
+		uint32_t ui32Time = _ui32Lines + 1;
+		uint32_t ui32Unique = 0;
+
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			uint32_t ui32V = _pui32Indices[I];
+			assert( ui32V < _ui32Vertices );
+			if ( !vUsed[ui32V] ) {
+				vUsed[ui32V] = 1;
+				++ui32Unique;
+			}
+
+			uint64_t ui64Start = static_cast<uint64_t>(ui32V) * _ui32VertexSize;
+			uint32_t ui32FirstLine = static_cast<uint32_t>(ui64Start / _ui32LineSize);
+			uint32_t ui32LastLine = static_cast<uint32_t>((ui64Start + _ui32VertexSize - 1) / _ui32LineSize);
+			for ( uint32_t J = ui32FirstLine; J <= ui32LastLine; ++J ) {
+				if ( ui32Time - vTimeStamps[J] > _ui32Lines ) {
+					vTimeStamps[J] = ui32Time++;
+					_vfsStats.ui64BytesFetched += _ui32LineSize;
+				}
+			}
+		}
+
+		if ( ui32Unique ) {
+			_vfsStats.dOverfetch = static_cast<double>(_vfsStats.ui64BytesFetched) / (static_cast<double>(ui32Unique) * _ui32VertexSize);
+		}
+		return true;
+	}
+
+}	// namespace lsc
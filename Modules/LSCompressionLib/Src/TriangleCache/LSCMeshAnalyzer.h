@@ -0,0 +1,91 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Measures how well a triangle-list index buffer uses the post-transform vertex cache and how
+ *	efficiently its vertices are fetched from memory.
+ */
+
+
+#ifndef __LSC_MESHANALYZER_H__
+#define __LSC_MESHANALYZER_H__
+
+#include "../LSCCompressionLib.h"
+
+namespace lsc {
+
+	/**
+	 * Class CMeshAnalyzer
+	 * \brief Measures the vertex-cache and vertex-fetch efficiency of an index buffer.
+	 *
+	 * Description: Measures how well a triangle-list index buffer uses the post-transform vertex cache and how
+	 *	efficiently its vertices are fetched from memory.
+	 */
+	class CMeshAnalyzer {
+	public :
+		// == Types.
+		/** Post-transform vertex-cache statistics. */
+		typedef struct LSC_VERTEX_CACHE_STATS {
+			/** Number of vertices transformed (cache misses). */
+			uint32_t							ui32Transformed;
+
+			/** Average cache-miss ratio: vertices transformed per triangle.  3.0 is the worst case and 0.5 is
+			 *	about the best possible on a large regular grid. */
+			double								dAcmr;
+
+			/** Average transformed-vertex ratio: vertices transformed per unique vertex referenced.  1.0 is
+			 *	ideal. */
+			double								dAtvr;
+		} * LPLSC_VERTEX_CACHE_STATS, * const LPCLSC_VERTEX_CACHE_STATS;
+
+		/** Vertex-fetch statistics. */
+		typedef struct LSC_VERTEX_FETCH_STATS {
+			/** Number of bytes read from memory. */
+			uint64_t							ui64BytesFetched;
+
+			/** Bytes read divided by the size of the unique vertices referenced.  1.0 is ideal. */
+			double								dOverfetch;
+		} * LPLSC_VERTEX_FETCH_STATS, * const LPCLSC_VERTEX_FETCH_STATS;
+
+
+		// == Functions.
+		/**
+		 * Simulates a FIFO post-transform vertex cache over a triangle list.
+		 *
+		 * \param _pui32Indices The index buffer.
+		 * \param _ui32Total Total indices in the index buffer.
+		 * \param _ui32Vertices Total vertices in the vertex buffer.  Every index must be below this.
+		 * \param _ui32CacheSize Number of vertices in the simulated cache.
+		 * \param _vcsStats Holds the returned statistics.
+		 * \return Returns true if there was enough memory to perform the operation.
+		 */
+		static LSBOOL LSE_CALL					AnalyzeVertexCache( const uint32_t * _pui32Indices, uint32_t _ui32Total,
+			uint32_t _ui32Vertices, uint32_t _ui32CacheSize, LSC_VERTEX_CACHE_STATS &_vcsStats );
+
+		/**
+		 * Simulates fetching the vertices of a triangle list through a small FIFO cache of memory lines.
+		 *
+		 * \param _pui32Indices The index buffer.
+		 * \param _ui32Total Total indices in the index buffer.
+		 * \param _ui32Vertices Total vertices in the vertex buffer.  Every index must be below this.
+		 * \param _ui32VertexSize Size of each vertex in bytes.
+		 * \param _vfsStats Holds the returned statistics.
+		 * \param _ui32LineSize Size of a memory line in bytes.
+		 * \param _ui32Lines Number of lines in the simulated cache.
+		 * \return Returns true if there was enough memory to perform the operation.
+		 */
+		static LSBOOL LSE_CALL					AnalyzeVertexFetch( const uint32_t * _pui32Indices, uint32_t _ui32Total,
+			uint32_t _ui32Vertices, uint32_t _ui32VertexSize, LSC_VERTEX_FETCH_STATS &_vfsStats,
+			uint32_t _ui32LineSize = 64, uint32_t _ui32Lines = 64 );
+	};
+
+}	// namespace lsc
+
+#endif	// __LSC_MESHANALYZER_H__
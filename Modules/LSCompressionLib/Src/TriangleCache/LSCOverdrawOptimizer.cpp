@@ -0,0 +1,205 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reorders the triangles of a cache-optimized index buffer to reduce overdraw.  The index buffer
+ *	is split into clusters at points where the vertex cache is flushed anyway, and the clusters are then sorted
+ *	so that those facing outward from the middle of the mesh, and which are therefore likely to occlude the rest
+ *	from any viewpoint, are drawn first.
+ */
+
+#include "LSCOverdrawOptimizer.h"
+#include "Search/LSSTDSearch.h"
+#include "Vector/LSTLVectorPoD.h"
+#include <cmath>
+
+
+namespace lsc {
+
+	// == Various constructors.
+	LSE_CALLCTOR COverdrawOptimizer::COverdrawOptimizer() {
+	}
+
+	// == Functions.
+	/**
+	 * Reorders the triangles of an index buffer to reduce overdraw.  The input should already have been
+	 *	optimized for the vertex cache (for example by CTriangleCacheOptimizer), since the order of triangles
+	 *	within each cluster is kept.  Front faces are assumed to wind counter-clockwise.
+	 *
+	 * \param _pui32Input Input index buffer.
+	 * \param _ui32Total Number of indices in the input index buffer.
+	 * \param _pfPositions Pointer to the X, Y, and Z of the first vertex position.
+	 * \param _ui32Stride Distance in bytes between vertex positions.
+	 * \param _ui32Vertices Number of vertices.  Every index must be below this.
+	 * \param _pui32Output Output index buffer.  Must be able to hold _ui32Total indices and must not
+	 *	overlap the input.
+	 * \param _fThreshold A cluster is split once its own vertex-cache miss rate, starting from an empty
+	 *	cache, falls to this multiple of the miss rate of the original order.  Higher values give smaller
+	 *	clusters and less overdraw at the cost of more cache misses.
+	 * \param _ui32Cache Size of the vertex cache to simulate.
+	 * \return Returns true if there were no memory failures and every index is in range.
+	 */
+	LSBOOL LSE_CALL COverdrawOptimizer::Optimize( const uint32_t * _pui32Input, uint32_t _ui32Total,
+		const float * _pfPositions, uint32_t _ui32Stride, uint32_t _ui32Vertices,
+		uint32_t * _pui32Output, float _fThreshold, uint32_t _ui32Cache ) {
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			if ( _pui32Input[I] >= _ui32Vertices ) { return false; }
+		}
+		uint32_t ui32Tris = _ui32Total / 3;
+		if ( ui32Tris <= 1 ) {
+			for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+				_pui32Output[I] = _pui32Input[I];
+			}
+			return true;
+		}
+
+		// Simulate the cache to find the cache misses of each triangle.  Triangles on which all 3 vertices miss
+		//	mark points at which the cache has been flushed, so the order may change there for free.
+		CVectorPoD<uint32_t, uint32_t> vTimeStamps;
+		if ( !vTimeStamps.Resize( _ui32Vertices ) ) { return false; }
+		CStd::MemSet( &vTimeStamps[0], 0, sizeof( uint32_t ) * vTimeStamps.Length() );
+		CVectorPoD<uint8_t, uint32_t> vMisses;
+		if ( !vMisses.Resize( ui32Tris ) ) { return false; }
+		uint32_t ui32Time = _ui32Cache + 1;
+		for ( uint32_t I = 0; I < ui32Tris; ++I ) {
+			uint8_t ui8Misses = 0;
+			for ( uint32_t J = 0; J < 3; ++J ) {
+				uint32_t ui32V = _pui32Input[I*3+J];
+				if ( ui32Time - vTimeStamps[ui32V] > _ui32Cache ) {
+					vTimeStamps[ui32V] = ui32Time++;
+					++ui8Misses;
+				}
+			}
+			vMisses[I] = ui8Misses;
+		}
+
+		// Split each of those clusters further wherever its miss rate, simulated from an empty cache, has
+		//	fallen close enough to the miss rate of the whole cluster that starting over costs little.
+		CVectorPoD<LSC_CLUSTER, uint32_t> vClusters;
+		vClusters.Allocate( ui32Tris >> 4 );
+		for ( uint32_t ui32Start = 0; ui32Start < ui32Tris; ) {
+			uint32_t ui32End = ui32Start + 1;
+			uint32_t ui32HardMisses = vMisses[ui32Start];
+			while ( ui32End < ui32Tris && vMisses[ui32End] != 3 ) {
+				ui32HardMisses += vMisses[ui32End++];
+			}
+			double dLimit = static_cast<double>(ui32HardMisses) / (ui32End - ui32Start) * _fThreshold;
+
+			ui32Time += _ui32Cache + 1;
+			uint32_t ui32SoftStart = ui32Start;
+			uint32_t ui32SoftMisses = 0;
+			for ( uint32_t I = ui32Start; I < ui32End; ++I ) {
+				for ( uint32_t J = 0; J < 3; ++J ) {
+					uint32_t ui32V = _pui32Input[I*3+J];
+					if ( ui32Time - vTimeStamps[ui32V] > _ui32Cache ) {
+						vTimeStamps[ui32V] = ui32Time++;
+						++ui32SoftMisses;
+					}
+				}
+				if ( I + 1 == ui32End || static_cast<double>(ui32SoftMisses) / (I + 1 - ui32SoftStart) <= dLimit ) {
+					LSC_CLUSTER cCluster = { ui32SoftStart, I + 1 - ui32SoftStart, 0.0 };
+					if ( !vClusters.Push( cCluster ) ) { return false; }
+					ui32SoftStart = I + 1;
+					ui32SoftMisses = 0;
+					ui32Time += _ui32Cache + 1;
+				}
+			}
+			ui32Start = ui32End;
+		}
+
+		// Sort key is the distance of each cluster's area-weighted centroid from the centroid of the mesh along
+		//	the cluster's average normal.  Clusters with high values face outward and tend to occlude the others
+		//	from whichever side the mesh is viewed.  dot( C - M, N ) is gathered as dot( C, N ) - dot( M, N ).
+		const uint8_t * pui8Positions = reinterpret_cast<const uint8_t *>(_pfPositions);
+		double dMeshCenter[3] = { 0.0, 0.0, 0.0 };
+		double dMeshArea = 0.0;
+		CVectorPoD<double, uint32_t> vNormals;
+		if ( !vNormals.Resize( vClusters.Length() * 3 ) ) { return false; }
+		for ( uint32_t I = 0; I < vClusters.Length(); ++I ) {
+			double dCenter[3] = { 0.0, 0.0, 0.0 };
+			double dNormal[3] = { 0.0, 0.0, 0.0 };
+			double dArea = 0.0;
+			uint32_t ui32End = vClusters[I].ui32Start + vClusters[I].ui32Total;
+			for ( uint32_t T = vClusters[I].ui32Start; T < ui32End; ++T ) {
+				const float * pfA = reinterpret_cast<const float *>(pui8Positions + static_cast<uintptr_t>(_pui32Input[T*3+0]) * _ui32Stride);
+				const float * pfB = reinterpret_cast<const float *>(pui8Positions + static_cast<uintptr_t>(_pui32Input[T*3+1]) * _ui32Stride);
+				const float * pfC = reinterpret_cast<const float *>(pui8Positions + static_cast<uintptr_t>(_pui32Input[T*3+2]) * _ui32Stride);
+				double dAb[3] = { static_cast<double>(pfB[0]) - pfA[0], static_cast<double>(pfB[1]) - pfA[1], static_cast<double>(pfB[2]) - pfA[2] };
+				double dAc[3] = { static_cast<double>(pfC[0]) - pfA[0], static_cast<double>(pfC[1]) - pfA[1], static_cast<double>(pfC[2]) - pfA[2] };
+				double dCross[3] = {
+					dAb[1] * dAc[2] - dAb[2] * dAc[1],
+					dAb[2] * dAc[0] - dAb[0] * dAc[2],
+					dAb[0] * dAc[1] - dAb[1] * dAc[0],
+				};
+				// Twice the area, which is fine since only the ratios matter.
+				double dTriArea = ::sqrt( dCross[0] * dCross[0] + dCross[1] * dCross[1] + dCross[2] * dCross[2] );
+				for ( uint32_t J = 0; J < 3; ++J ) {
+					dCenter[J] += (static_cast<double>(pfA[J]) + pfB[J] + pfC[J]) * dTriArea;
+					dNormal[J] += dCross[J];
+				}
+				dArea += dTriArea;
+			}
+			for ( uint32_t J = 0; J < 3; ++J ) {
+				dMeshCenter[J] += dCenter[J];
+			}
+			dMeshArea += dArea;
+
+			double dLen = ::sqrt( dNormal[0] * dNormal[0] + dNormal[1] * dNormal[1] + dNormal[2] * dNormal[2] );
+			double dKey = 0.0;
+			for ( uint32_t J = 0; J < 3; ++J ) {
+				double dN = dLen ? dNormal[J] / dLen : 0.0;
+				vNormals[I*3+J] = dN;
+				if ( dArea ) { dKey += dCenter[J] / (dArea * 3.0) * dN; }
+			}
+			vClusters[I].dSortKey = dKey;
+		}
+		if ( dMeshArea ) {
+			for ( uint32_t J = 0; J < 3; ++J ) {
+				dMeshCenter[J] /= dMeshArea * 3.0;
+			}
+		}
+		for ( uint32_t I = 0; I < vClusters.Length(); ++I ) {
+			vClusters[I].dSortKey -= dMeshCenter[0] * vNormals[I*3+0] + dMeshCenter[1] * vNormals[I*3+1] + dMeshCenter[2] * vNormals[I*3+2];
+		}
+
+		// A stable sort keeps clusters with equal keys in their cache-friendly order.
+		CSearch::MergeSort( &vClusters[0], vClusters.Length(), sizeof( LSC_CLUSTER ), CompareClusters, NULL );
+
+		uint32_t ui32Out = 0;
+		for ( uint32_t I = 0; I < vClusters.Length(); ++I ) {
+			const uint32_t * pui32Src = &_pui32Input[vClusters[I].ui32Start*3];
+			for ( uint32_t J = vClusters[I].ui32Total * 3; J--; ) {
+				_pui32Output[ui32Out++] = (*pui32Src++);
+			}
+		}
+		// Keep any trailing indices that do not form a whole triangle.
+		for ( ; ui32Out < _ui32Total; ++ui32Out ) {
+			_pui32Output[ui32Out] = _pui32Input[ui32Out];
+		}
+		return true;
+	}
+
+	/**
+	 * Compares two clusters so that they sort by descending sort key.
+	 *
+	 * \param _pvContext Unused.
+	 * \param _pvLeft The left cluster.
+	 * \param _pvRight The right cluster.
+	 * \return Returns the comparison between the clusters.
+	 */
+	int32_t LSE_CCALL COverdrawOptimizer::CompareClusters( void * /*_pvContext*/, const void * _pvLeft, const void * _pvRight ) {
+		const LSC_CLUSTER * pcLeft = static_cast<const LSC_CLUSTER *>(_pvLeft);
+		const LSC_CLUSTER * pcRight = static_cast<const LSC_CLUSTER *>(_pvRight);
+		if ( pcLeft->dSortKey > pcRight->dSortKey ) { return -1; }
+		if ( pcLeft->dSortKey < pcRight->dSortKey ) { return 1; }
+		return 0;
+	}
+
+}	// namespace lsc
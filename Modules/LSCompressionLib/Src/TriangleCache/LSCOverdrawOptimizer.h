@@ -0,0 +1,94 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reorders the triangles of a cache-optimized index buffer to reduce overdraw.  The index buffer
+ *	is split into clusters at points where the vertex cache is flushed anyway, and the clusters are then sorted
+ *	so that those facing outward from the middle of the mesh, and which are therefore likely to occlude the rest
+ *	from any viewpoint, are drawn first.
+ */
+
+
+#ifndef __LSC_OVERDRAWOPTIMIZER_H__
+#define __LSC_OVERDRAWOPTIMIZER_H__
+
+#include "../LSCCompressionLib.h"
+
+namespace lsc {
+
+	/**
+	 * Class COverdrawOptimizer
+	 * \brief Reorders the triangles of a cache-optimized index buffer to reduce overdraw.
+	 *
+	 * Description: Reorders the triangles of a cache-optimized index buffer to reduce overdraw.  The index buffer
+	 *	is split into clusters at points where the vertex cache is flushed anyway, and the clusters are then sorted
+	 *	so that those facing outward from the middle of the mesh, and which are therefore likely to occlude the rest
+	 *	from any viewpoint, are drawn first.
+	 */
+	class COverdrawOptimizer {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR							COverdrawOptimizer();
+
+
+		// == Functions.
+		/**
+		 * Reorders the triangles of an index buffer to reduce overdraw.  The input should already have been
+		 *	optimized for the vertex cache (for example by CTriangleCacheOptimizer), since the order of triangles
+		 *	within each cluster is kept.  Front faces are assumed to wind counter-clockwise.
+		 *
+		 * \param _pui32Input Input index buffer.
+		 * \param _ui32Total Number of indices in the input index buffer.
+		 * \param _pfPositions Pointer to the X, Y, and Z of the first vertex position.
+		 * \param _ui32Stride Distance in bytes between vertex positions.
+		 * \param _ui32Vertices Number of vertices.  Every index must be below this.
+		 * \param _pui32Output Output index buffer.  Must be able to hold _ui32Total indices and must not
+		 *	overlap the input.
+		 * \param _fThreshold A cluster is split once its own vertex-cache miss rate, starting from an empty
+		 *	cache, falls to this multiple of the miss rate of the original order.  Higher values give smaller
+		 *	clusters and less overdraw at the cost of more cache misses.
+		 * \param _ui32Cache Size of the vertex cache to simulate.
+		 * \return Returns true if there were no memory failures and every index is in range.
+		 */
+		LSBOOL LSE_CALL							Optimize( const uint32_t * _pui32Input, uint32_t _ui32Total,
+			const float * _pfPositions, uint32_t _ui32Stride, uint32_t _ui32Vertices,
+			uint32_t * _pui32Output, float _fThreshold = 1.05f, uint32_t _ui32Cache = 16 );
+
+
+	protected :
+		// == Types.
+		/** A run of triangles that is moved as a unit. */
+		typedef struct LSC_CLUSTER {
+			/** Index of the first triangle in the cluster. */
+			uint32_t							ui32Start;
+
+			/** Number of triangles in the cluster. */
+			uint32_t							ui32Total;
+
+			/** How far the cluster faces away from the middle of the mesh.  Higher values are drawn first. */
+			double								dSortKey;
+		} * LPLSC_CLUSTER, * const LPCLSC_CLUSTER;
+
+
+		// == Functions.
+		/**
+		 * Compares two clusters so that they sort by descending sort key.
+		 *
+		 * \param _pvContext Unused.
+		 * \param _pvLeft The left cluster.
+		 * \param _pvRight The right cluster.
+		 * \return Returns the comparison between the clusters.
+		 */
+		static int32_t LSE_CCALL				CompareClusters( void * _pvContext, const void * _pvLeft, const void * _pvRight );
+	};
+
+}	// namespace lsc
+
+#endif	// __LSC_OVERDRAWOPTIMIZER_H__
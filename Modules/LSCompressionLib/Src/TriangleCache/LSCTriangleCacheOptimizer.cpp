@@ -13,13 +13,29 @@
  */
 
 #include "LSCTriangleCacheOptimizer.h"
-#include "LSCVertexTriangleAdjacency.h"
+#include "JobSystem/LSHJobSystem.h"
 
 
 namespace lsc {
 
 	// == Various constructors.
 	LSE_CALLCTOR CTriangleCacheOptimizer::CTriangleCacheOptimizer() {
+		// Scores from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".  The last 3 vertices used score
+		//	the same since the next triangle cannot help reusing them, and the rest fall off with age.  Vertices
+		//	with few live triangles left score higher so that they get finished off rather than left stranded.
+		for ( uint32_t I = 0; I < LSC_CACHE_SIZE; ++I ) {
+			if ( I < 3 ) {
+				m_fCacheScores[I] = 0.75f;
+			}
+			else {
+				LSREAL fScaled = LSREAL( 1.0 ) - LSREAL( I - 3 ) / LSREAL( LSC_CACHE_SIZE - 3 );
+				m_fCacheScores[I] = static_cast<float>(CMathLib::Pow( fScaled, LSREAL( 1.5 ) ));
+			}
+		}
+		m_fValenceScores[0] = 0.0f;
+		for ( uint32_t I = 1; I < LSC_MAX_VALENCE; ++I ) {
+			m_fValenceScores[I] = static_cast<float>(LSREAL( 2.0 ) * CMathLib::Pow( LSREAL( I ), LSREAL( -0.5 ) ));
+		}
 	}
 
 	// == Functions.
@@ -29,148 +45,314 @@ namespace lsc {
 	 * \param _pui32Input Input vertex buffer.
 	 * \param _ui32Total Number of indices in the input vertex.
 	 * \param _pui32Output Output vertex buffer.  Must be able to hold _ui32Total indices.
+	 * \param _ui32Threads If not 1, the mesh is split into groups of connected triangles that are optimized
+	 *	separately on up to this many threads of the job system.  0 uses every thread of the job system.
 	 * \return Returns true if there were no memory failures during the optimization.
 	 */
-	LSBOOL LSE_CALL CTriangleCacheOptimizer::Optimize( const uint32_t * _pui32Input, uint32_t _ui32Total, uint32_t * _pui32Output ) {
-		const uint32_t ui32Cache = 12;						// k.
-		CVertexTriangleAdjacency vtaAdjacency;				// A.
-		if ( !vtaAdjacency.BuildList( _pui32Input, _ui32Total ) ) { return false; }
-		CLiveTriangleList ltlLiveList;						// L.
-		if ( !ltlLiveList.CreateLiveTriangleCountList( &vtaAdjacency ) ) { return false; }
-
-		// Time stamp.
-		uint32_t ui32TimeStamp = ui32Cache + 1;				// s.
-		CVectorPoD<uint32_t, uint32_t> vTimeStamps;			// C.
-		if ( !vTimeStamps.Resize( vtaAdjacency.List().Length() ) ) { return false; }
-		for ( uint32_t I = vTimeStamps.Length(); I--; ) {
-			vTimeStamps[I] = 0;
+	LSBOOL LSE_CALL CTriangleCacheOptimizer::Optimize( const uint32_t * _pui32Input, uint32_t _ui32Total, uint32_t * _pui32Output,
+		uint32_t _ui32Threads ) const {
+		// Keep any trailing indices that do not form a whole triangle.
+		uint32_t ui32Whole = _ui32Total - _ui32Total % 3;
+		for ( uint32_t I = ui32Whole; I < _ui32Total; ++I ) {
+			_pui32Output[I] = _pui32Input[I];
 		}
 
-		// Dead-end stack.
-		CVectorPoD<uint32_t, uint32_t> vDeadEndStack;		// D.
-		vDeadEndStack.Allocate( _ui32Total );
-
-		// Emitted triangles.
-		CVectorPoD<uint8_t, uint32_t> vEmittedTriangles;	// E.
-		if ( !vEmittedTriangles.Resize( _ui32Total / 3 ) ) { return false; }
-		for ( uint32_t I = vEmittedTriangles.Length(); I--; ) {
-			vEmittedTriangles[I] = 0;
+		// Without the job system the groups would all be optimized on this thread, which only costs the splitting.
+		uint32_t ui32JobThreads = CJobSystem::TotalThreads();
+		if ( !_ui32Threads || _ui32Threads > ui32JobThreads ) { _ui32Threads = ui32JobThreads; }
+		// Below this many triangles, splitting the mesh costs more than it saves.
+		static const uint32_t ui32ThreadedTris = 32 * 1024;
+		if ( _ui32Threads > 1 && ui32Whole / 3 >= ui32ThreadedTris ) {
+			return OptimizeThreaded( _pui32Input, ui32Whole, _pui32Output, _ui32Threads );
 		}
+		return OptimizeSerial( _pui32Input, ui32Whole, _pui32Output );
+	}
 
+	/**
+	 * Optimizes an index buffer on the calling thread.
+	 *
+	 * \param _pui32Input Input vertex buffer.
+	 * \param _ui32Total Number of indices in the input vertex.
+	 * \param _pui32Output Output vertex buffer.  Must be able to hold _ui32Total indices.
+	 * \return Returns true if there were no memory failures during the optimization.
+	 */
+	LSBOOL LSE_CALL CTriangleCacheOptimizer::OptimizeSerial( const uint32_t * _pui32Input, uint32_t _ui32Total, uint32_t * _pui32Output ) const {
+		uint32_t ui32Tris = _ui32Total / 3;
+		if ( !ui32Tris ) { return true; }
 
-		// Current index.
-		uint32_t ui32Cursor = 1;							// i.
+		// The live triangles of each vertex are kept at the front of its adjacency list, so the list length
+		//	doubles as the live-triangle count.
+		CVertexTriangleAdjacency vtaAdjacency;
+		if ( !vtaAdjacency.BuildList( _pui32Input, ui32Tris * 3 ) ) { return false; }
+		CVectorPoD<CVertexTriangleAdjacency::LSC_VERTEX_ADJACENCY, uint32_t> & vAdj = vtaAdjacency.List();
+		uint32_t ui32Verts = vAdj.Length();
 
-		// Fan.
-		uint32_t ui32Fan = 0;								// f.
+		CVectorPoD<uint8_t, uint32_t> vCachePos;
+		CVectorPoD<float, uint32_t> vVertScores;
+		CVectorPoD<float, uint32_t> vTriScores;
+		CVectorPoD<uint8_t, uint32_t> vEmitted;
+		CVectorPoD<uint32_t, uint32_t> vDeadEndStack;
+		if ( !vCachePos.Resize( ui32Verts ) || !vVertScores.Resize( ui32Verts ) ||
+			!vTriScores.Resize( ui32Tris ) || !vEmitted.Resize( ui32Tris ) ||
+			!vDeadEndStack.Allocate( ui32Tris * 3 ) ) { return false; }
 
-		uint32_t ui32Out = 0;
+		for ( uint32_t I = 0; I < ui32Verts; ++I ) {
+			vCachePos[I] = LSC_CACHE_SIZE;
+			vVertScores[I] = VertexScore( LSC_CACHE_SIZE, vAdj[I].ui32Total );
+		}
+		uint32_t ui32Best = 0;
+		for ( uint32_t I = 0; I < ui32Tris; ++I ) {
+			vEmitted[I] = 0;
+			vTriScores[I] = vVertScores[_pui32Input[I*3]] + vVertScores[_pui32Input[I*3+1]] + vVertScores[_pui32Input[I*3+2]];
+			if ( vTriScores[I] > vTriScores[ui32Best] ) { ui32Best = I; }
+		}
 
-		CSet<uint32_t> sCandidates;							// N.
-
-		sCandidates.AllocateAtLeast( _ui32Total >> 3 );
-		while ( ui32Fan != LSE_MAXU32 ) {
-			sCandidates.ResetNoDealloc();
-
-			// For each adjacent triangle on this vertex.
-			for ( uint32_t I = 0; I < vtaAdjacency.List()[ui32Fan].ui32Total; ++I ) {
-				uint32_t ui32T = vtaAdjacency.List()[ui32Fan].pui32Tris[I];
-				// If the triangle has not been emitted.
-				if ( !vEmittedTriangles[ui32T] ) {
-					// For each vertex on the triangle.
-					for ( uint32_t J = 0; J < 3; ++J ) {
-						uint32_t ui32V = _pui32Input[ui32T*3+J];
-						// Output the vertex.
-						_pui32Output[ui32Out++] = ui32V;
-						// Add to the dead-end stack.
-						if ( !vDeadEndStack.Push( ui32V ) ) { return false; }
-						// Add to the candidiates stack.
-						if ( !sCandidates.Insert( ui32V ) ) { return false; }
-						// Decrease live triangle count.
-						assert( ltlLiveList.List()[ui32V] != 0 );
-						--ltlLiveList.List()[ui32V];
-
-						if ( ui32TimeStamp - vTimeStamps[ui32V] > ui32Cache ) {
-							vTimeStamps[ui32V] = ui32TimeStamp;
-							++ui32TimeStamp;
+		uint32_t ui32Cache[LSC_CACHE_SIZE+3];
+		uint32_t ui32CacheLen = 0;
+		uint32_t ui32Cursor = 0;
+		uint32_t ui32Out = 0;
+		while ( true ) {
+			if ( ui32Best == LSE_MAXU32 ) {
+				// Nothing in the cache has live triangles.  Go back to the most recently used vertex that does, and
+				//	failing that, to the first triangle not yet emitted.
+				while ( vDeadEndStack.Length() ) {
+					uint32_t ui32D = vDeadEndStack[vDeadEndStack.Length()-1];
+					vDeadEndStack.PopNoDealloc();
+					if ( vAdj[ui32D].ui32Total ) {
+						ui32Best = vAdj[ui32D].pui32Tris[0];
+						for ( uint32_t I = 1; I < vAdj[ui32D].ui32Total; ++I ) {
+							if ( vTriScores[vAdj[ui32D].pui32Tris[I]] > vTriScores[ui32Best] ) { ui32Best = vAdj[ui32D].pui32Tris[I]; }
 						}
+						break;
 					}
+				}
+				if ( ui32Best == LSE_MAXU32 ) {
+					while ( ui32Cursor < ui32Tris && vEmitted[ui32Cursor] ) { ++ui32Cursor; }
+					if ( ui32Cursor == ui32Tris ) { break; }
+					ui32Best = ui32Cursor;
+				}
+			}
 
-					vEmittedTriangles[ui32T] = 1;
+			// Emit the triangle and take it off the live lists of its vertices.
+			const uint32_t * pui32Tri = &_pui32Input[ui32Best*3];
+			uint32_t ui32NewCache[LSC_CACHE_SIZE+3];
+			uint32_t ui32NewLen = 0;
+			for ( uint32_t J = 0; J < 3; ++J ) {
+				uint32_t ui32V = pui32Tri[J];
+				_pui32Output[ui32Out++] = ui32V;
+				CVertexTriangleAdjacency::LSC_VERTEX_ADJACENCY & vaThis = vAdj[ui32V];
+				for ( uint32_t K = 0; K < vaThis.ui32Total; ++K ) {
+					if ( vaThis.pui32Tris[K] == ui32Best ) {
+						vaThis.pui32Tris[K] = vaThis.pui32Tris[--vaThis.ui32Total];
+						vaThis.pui32Tris[vaThis.ui32Total] = ui32Best;
+						break;
+					}
 				}
+				if ( vCachePos[ui32V] != 0xFF ) {
+					// 0xFF marks vertices already placed in the new cache.
+					vCachePos[ui32V] = 0xFF;
+					ui32NewCache[ui32NewLen++] = ui32V;
+				}
+				if ( !vDeadEndStack.Push( ui32V ) ) { return false; }
 			}
+			vEmitted[ui32Best] = 1;
 
-			ui32Fan = GetNextVertex( ui32Cursor, ui32Cache,
-				sCandidates, vTimeStamps, ui32TimeStamp, ltlLiveList, vDeadEndStack );
-		}
+			// The triangle's vertices move to the front of the cache and everything else shifts back.
+			for ( uint32_t I = 0; I < ui32CacheLen; ++I ) {
+				if ( vCachePos[ui32Cache[I]] != 0xFF ) {
+					ui32NewCache[ui32NewLen++] = ui32Cache[I];
+				}
+			}
 
-		assert( ui32Out == _ui32Total );
+			// Rescore every vertex that moved, including those pushed out.
+			for ( uint32_t I = 0; I < ui32NewLen; ++I ) {
+				uint32_t ui32V = ui32NewCache[I];
+				uint32_t ui32Pos = CStd::Min<uint32_t>( I, LSC_CACHE_SIZE );
+				vCachePos[ui32V] = static_cast<uint8_t>(ui32Pos);
+				float fScore = VertexScore( ui32Pos, vAdj[ui32V].ui32Total );
+				float fDelta = fScore - vVertScores[ui32V];
+				vVertScores[ui32V] = fScore;
+				const CVertexTriangleAdjacency::LSC_VERTEX_ADJACENCY & vaThis = vAdj[ui32V];
+				for ( uint32_t K = 0; K < vaThis.ui32Total; ++K ) {
+					vTriScores[vaThis.pui32Tris[K]] += fDelta;
+				}
+			}
+			ui32CacheLen = CStd::Min<uint32_t>( ui32NewLen, LSC_CACHE_SIZE );
+
+			// The next triangle is the best live one that uses a vertex still in the cache.
+			ui32Best = LSE_MAXU32;
+			float fBest = -1.0f;
+			for ( uint32_t I = 0; I < ui32CacheLen; ++I ) {
+				uint32_t ui32V = ui32NewCache[I];
+				ui32Cache[I] = ui32V;
+				const CVertexTriangleAdjacency::LSC_VERTEX_ADJACENCY & vaThis = vAdj[ui32V];
+				for ( uint32_t K = 0; K < vaThis.ui32Total; ++K ) {
+					uint32_t ui32T = vaThis.pui32Tris[K];
+					if ( vTriScores[ui32T] > fBest ) {
+						fBest = vTriScores[ui32T];
+						ui32Best = ui32T;
+					}
+				}
+			}
+		}
 
+		assert( ui32Out == ui32Tris * 3 );
 		return true;
 	}
 
 	/**
-	 * Gets the next vertex index from which to begin the next iteration of the main loop.
+	 * Splits the triangles into groups that share no vertices and optimizes the groups in parallel on the job system.
 	 *
-	 * \param _ui32Cursor Cursor position.
-	 * \param _ui32Cache Cache size.
-	 * \param _sCandidates Candidiates.
-	 * \param _vTimeStamps Timestamps.
-	 * \param _ui32TimeStamp Current timestamp counter.
-	 * \param _ltlLiveList List of live triangles.
-	 * \param _vDeadEndStack The dead-end stack.
-	 * \return Returns the index of the next best starting point for cache usage or LSE_MAXU32.
+	 * \param _pui32Input Input vertex buffer.
+	 * \param _ui32Total Number of indices in the input vertex.  Must be a multiple of 3.
+	 * \param _pui32Output Output vertex buffer.  Must be able to hold _ui32Total indices.
+	 * \param _ui32Threads Number of groups to make.
+	 * \return Returns true if there were no memory failures during the optimization.
 	 */
-	uint32_t LSE_CALL CTriangleCacheOptimizer::GetNextVertex( uint32_t &_ui32Cursor, const uint32_t _ui32Cache,
-		const CSet<uint32_t> &_sCandidates,
-		const CVectorPoD<uint32_t, uint32_t> &_vTimeStamps,
-		const uint32_t _ui32TimeStamp, const CLiveTriangleList &_ltlLiveList, CVectorPoD<uint32_t, uint32_t> &_vDeadEndStack ) {
-		uint32_t ui32N = LSE_MAXU32, ui32P = LSE_MAXU32, ui32M = LSE_MAXU32;
-
-		for ( uint32_t I = 0; I < _sCandidates.Length(); ++I ) {
-			uint32_t ui32V = _sCandidates.GetByIndex( I );
-			// Must have live triangles.
-			if ( _ltlLiveList.List()[ui32V] ) {
-				ui32P = 0;
-				uint32_t ui32ThisTime = _ui32TimeStamp - _vTimeStamps[ui32V];
-				if ( ui32ThisTime + (_ltlLiveList.List()[ui32V] << 1) <= _ui32Cache ) {
-					ui32P = ui32ThisTime;
-				}
-				if ( ui32P > ui32M || ui32M == LSE_MAXU32 ) {
-					ui32M = ui32P;
-					ui32N = ui32V;
-				}
+	LSBOOL LSE_CALL CTriangleCacheOptimizer::OptimizeThreaded( const uint32_t * _pui32Input, uint32_t _ui32Total, uint32_t * _pui32Output,
+		uint32_t _ui32Threads ) const {
+		uint32_t ui32Tris = _ui32Total / 3;
+		uint32_t ui32Verts = 0;
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			ui32Verts = CStd::Max( ui32Verts, _pui32Input[I] + 1 );
+		}
+
+		// Find the connected pieces of the mesh with a union-find over the vertices.
+		CVectorPoD<uint32_t, uint32_t> vParents;
+		if ( !vParents.Resize( ui32Verts ) ) { return false; }
+		for ( uint32_t I = 0; I < ui32Verts; ++I ) {
+			vParents[I] = I;
+		}
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			uint32_t ui32A = _pui32Input[I-I%3];
+			uint32_t ui32B = _pui32Input[I];
+			while ( vParents[ui32A] != ui32A ) { ui32A = vParents[ui32A] = vParents[vParents[ui32A]]; }
+			while ( vParents[ui32B] != ui32B ) { ui32B = vParents[ui32B] = vParents[vParents[ui32B]]; }
+			if ( ui32A < ui32B ) { vParents[ui32B] = ui32A; }
+			else { vParents[ui32A] = ui32B; }
+		}
+
+		// Number the pieces in the order in which they first appear and count their triangles.  vParents then
+		//	holds the piece of each root.
+		CVectorPoD<uint32_t, uint32_t> vTriPiece;
+		CVectorPoD<uint32_t, uint32_t> vPieceTris;
+		if ( !vTriPiece.Resize( ui32Tris ) ) { return false; }
+		CVectorPoD<uint32_t, uint32_t> vRootPiece;
+		if ( !vRootPiece.Resize( ui32Verts ) ) { return false; }
+		for ( uint32_t I = 0; I < ui32Verts; ++I ) {
+			vRootPiece[I] = LSE_MAXU32;
+		}
+		for ( uint32_t I = 0; I < ui32Tris; ++I ) {
+			uint32_t ui32Root = _pui32Input[I*3];
+			while ( vParents[ui32Root] != ui32Root ) { ui32Root = vParents[ui32Root] = vParents[vParents[ui32Root]]; }
+			if ( vRootPiece[ui32Root] == LSE_MAXU32 ) {
+				vRootPiece[ui32Root] = vPieceTris.Length();
+				if ( !vPieceTris.Push( 0 ) ) { return false; }
 			}
+			vTriPiece[I] = vRootPiece[ui32Root];
+			++vPieceTris[vTriPiece[I]];
+		}
+		if ( vPieceTris.Length() == 1 ) {
+			return OptimizeSerial( _pui32Input, _ui32Total, _pui32Output );
 		}
 
-		if ( ui32N == LSE_MAXU32 ) {
-			ui32N = SkipDeadEnd( _ltlLiveList, _vDeadEndStack, _ui32Cursor );
+		// Gather consecutive pieces into groups of about equal size, one per job thread.  Since the pieces are
+		//	independent, so are the groups.
+		uint32_t ui32Target = (ui32Tris + _ui32Threads - 1) / _ui32Threads;
+		CVectorPoD<uint32_t, uint32_t> vGroupStarts;		// In triangles.
+		if ( !vGroupStarts.Push( 0 ) ) { return false; }
+		uint32_t ui32Sum = 0;
+		for ( uint32_t I = 0; I < vPieceTris.Length(); ++I ) {
+			if ( ui32Sum - vGroupStarts[vGroupStarts.Length()-1] >= ui32Target ) {
+				if ( !vGroupStarts.Push( ui32Sum ) ) { return false; }
+			}
+			ui32Sum += vPieceTris[I];
+			vPieceTris[I] = vGroupStarts.Length() - 1;		// Now the group of the piece.
 		}
-		return ui32N;
+		uint32_t ui32Groups = vGroupStarts.Length();
+		if ( !vGroupStarts.Push( ui32Tris ) ) { return false; }
+
+		// List the triangles of each group in their original order, and give each vertex an index local to its
+		//	group.
+		CVectorPoD<uint32_t, uint32_t> vGroupTris, vNextTri, vLocal, vGlobal, vGroupVerts;
+		if ( !vGroupTris.Resize( ui32Tris ) || !vNextTri.Resize( ui32Groups ) ||
+			!vLocal.Resize( ui32Verts ) || !vGlobal.Resize( ui32Verts ) || !vGroupVerts.Resize( ui32Groups + 1 ) ) { return false; }
+		for ( uint32_t I = 0; I <= ui32Groups; ++I ) {
+			vGroupVerts[I] = 0;
+		}
+		for ( uint32_t I = 0; I < ui32Groups; ++I ) {
+			vNextTri[I] = vGroupStarts[I];
+		}
+		for ( uint32_t I = 0; I < ui32Verts; ++I ) {
+			vLocal[I] = LSE_MAXU32;
+		}
+		for ( uint32_t I = 0; I < ui32Tris; ++I ) {
+			uint32_t ui32Group = vPieceTris[vTriPiece[I]];
+			vGroupTris[vNextTri[ui32Group]++] = I;
+			for ( uint32_t J = 0; J < 3; ++J ) {
+				uint32_t ui32V = _pui32Input[I*3+J];
+				if ( vLocal[ui32V] == LSE_MAXU32 ) { vLocal[ui32V] = vGroupVerts[ui32Group]++; }
+			}
+		}
+		// Turn the per-group vertex counts into offsets into vGlobal.
+		uint32_t ui32Offset = 0;
+		for ( uint32_t I = 0; I <= ui32Groups; ++I ) {
+			uint32_t ui32Count = vGroupVerts[I];
+			vGroupVerts[I] = ui32Offset;
+			ui32Offset += ui32Count;
+		}
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			uint32_t ui32V = _pui32Input[I];
+			vGlobal[vGroupVerts[vPieceTris[vTriPiece[I/3]]]+vLocal[ui32V]] = ui32V;
+		}
+
+		LSC_OPTIMIZE_JOB_DATA ojdData;
+		ojdData.ptcoOptimizer = this;
+		ojdData.pui32Input = _pui32Input;
+		ojdData.pui32Tris = &vGroupTris[0];
+		ojdData.pui32GroupStarts = &vGroupStarts[0];
+		ojdData.pui32Local = &vLocal[0];
+		ojdData.pui32Global = &vGlobal[0];
+		ojdData.pui32GroupVerts = &vGroupVerts[0];
+		ojdData.pui32Output = _pui32Output;
+		CAtomic::AtomicStore( ojdData.aFailed, 0 );
+		CJobSystem::ParallelFor( ui32Groups, OptimizeRange, &ojdData );
+		return !CAtomic::AtomicLoad( ojdData.aFailed );
 	}
 
 	/**
-	 * Finds a new non-local starting point after consuming all the vertices in cache.
+	 * Job function for optimizing a range of groups of connected triangles.
 	 *
-	 * \param _ltlLiveList List of live triangles.
-	 * \param _vDeadEndStack The dead-end stack.
-	 * \param _ui32Cursor Cursor position.
-	 * \return Returns the best new starting point or LSE_MAXU32.
+	 * \param _ui32Begin The first group to optimize.
+	 * \param _ui32End The group after the last to optimize.
+	 * \param _pvParm Pointer to an LSC_OPTIMIZE_JOB_DATA structure.
 	 */
-	uint32_t LSE_CALL CTriangleCacheOptimizer::SkipDeadEnd( const CLiveTriangleList &_ltlLiveList, CVectorPoD<uint32_t, uint32_t> &_vDeadEndStack,
-		uint32_t &_ui32Cursor ) {
-		while ( _vDeadEndStack.Length() ) {
-			uint32_t ui32D = _vDeadEndStack[_vDeadEndStack.Length()-1];
-			_vDeadEndStack.PopNoDealloc();
-			// If there are live triangles, just return.
-			if ( _ltlLiveList.List()[ui32D] ) { return ui32D; }
-		}
-
-		while ( _ui32Cursor < _ltlLiveList.List().Length() ) {
-			if ( _ltlLiveList.List()[_ui32Cursor] ) { return _ui32Cursor; }
-			++_ui32Cursor;
+	void LSE_CALL CTriangleCacheOptimizer::OptimizeRange( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm ) {
+		LPLSC_OPTIMIZE_JOB_DATA lpojdData = static_cast<LPLSC_OPTIMIZE_JOB_DATA>(_pvParm);
+		CVectorPoD<uint32_t, uint32_t> vIn, vOut;
+		for ( uint32_t G = _ui32Begin; G < _ui32End; ++G ) {
+			uint32_t ui32First = lpojdData->pui32GroupStarts[G];
+			uint32_t ui32Tris = lpojdData->pui32GroupStarts[G+1] - ui32First;
+			if ( !vIn.Resize( ui32Tris * 3 ) || !vOut.Resize( ui32Tris * 3 ) ) {
+				CAtomic::AtomicStore( lpojdData->aFailed, 1 );
+				return;
+			}
+			for ( uint32_t I = 0; I < ui32Tris; ++I ) {
+				const uint32_t * pui32Tri = &lpojdData->pui32Input[lpojdData->pui32Tris[ui32First+I]*3];
+				for ( uint32_t J = 0; J < 3; ++J ) {
+					vIn[I*3+J] = lpojdData->pui32Local[pui32Tri[J]];
+				}
+			}
+			if ( !lpojdData->ptcoOptimizer->OptimizeSerial( &vIn[0], vIn.Length(), &vOut[0] ) ) {
+				CAtomic::AtomicStore( lpojdData->aFailed, 1 );
+				return;
+			}
+			const uint32_t * pui32Global = &lpojdData->pui32Global[lpojdData->pui32GroupVerts[G]];
+			uint32_t * pui32Output = &lpojdData->pui32Output[ui32First*3];
+			for ( uint32_t I = 0; I < vOut.Length(); ++I ) {
+				pui32Output[I] = pui32Global[vOut[I]];
+			}
 		}
-		return LSE_MAXU32;
 	}
 
 }	// namespace lsc
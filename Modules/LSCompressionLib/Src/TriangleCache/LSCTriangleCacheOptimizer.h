@@ -17,8 +17,7 @@
 #define __LSC_TRIANGLECACHEOPTIMIZER_H__
 
 #include "../LSCCompressionLib.h"
-#include "LSCLiveTriangleList.h"
-#include "Set/LSTLSet.h"
+#include "LSCVertexTriangleAdjacency.h"
 
 namespace lsc {
 
@@ -34,6 +33,14 @@ namespace lsc {
 		LSE_CALLCTOR							CTriangleCacheOptimizer();
 
 
+		// == Enumerations.
+		/** Sizes used by the scoring. */
+		enum LSC_CACHE_SIZES {
+			LSC_CACHE_SIZE						= 32,									/**< Size of the simulated LRU cache. */
+			LSC_MAX_VALENCE						= 32,									/**< Live-triangle counts at or above this all score the same. */
+		};
+
+
 		// == Functions.
 		/**
 		 * Optimizes the input vertex buffer for best cache usage.
@@ -41,50 +48,115 @@ namespace lsc {
 		 * \param _pui32Input Input vertex buffer.
 		 * \param _ui32Total Number of indices in the input vertex.
 		 * \param _pui32Output Output vertex buffer.  Must be able to hold _ui32Total indices.
+		 * \param _ui32Threads If not 1, the mesh is split into groups of connected triangles that are optimized
+		 *	separately on up to this many threads of the job system.  0 uses every thread of the job system.
 		 * \return Returns true if there were no memory failures during the optimization.
 		 */
-		LSBOOL LSE_CALL							Optimize( const uint32_t * _pui32Input, uint32_t _ui32Total, uint32_t * _pui32Output );
+		LSBOOL LSE_CALL							Optimize( const uint32_t * _pui32Input, uint32_t _ui32Total, uint32_t * _pui32Output,
+			uint32_t _ui32Threads = 1 ) const;
 
 
 	protected :
+		// == Types.
+		/** Data passed to the jobs that optimize groups of connected triangles. */
+		typedef struct LSC_OPTIMIZE_JOB_DATA {
+			/** The optimizer. */
+			const CTriangleCacheOptimizer *		ptcoOptimizer;
+
+			/** The full input index buffer. */
+			const uint32_t *					pui32Input;
+
+			/** The triangles of all groups, each group's in their original order. */
+			const uint32_t *					pui32Tris;
+
+			/** The first triangle in pui32Tris of each group, followed by the total number of triangles. */
+			const uint32_t *					pui32GroupStarts;
+
+			/** The group-local index of each vertex, shared by all groups. */
+			const uint32_t *					pui32Local;
+
+			/** The vertices of all groups, each group's by their group-local indices. */
+			const uint32_t *					pui32Global;
+
+			/** The first vertex in pui32Global of each group. */
+			const uint32_t *					pui32GroupVerts;
+
+			/** The output index buffer. */
+			uint32_t *							pui32Output;
+
+			/** Set to 1 if any group fails. */
+			CAtomic::ATOM						aFailed;
+		} * LPLSC_OPTIMIZE_JOB_DATA, * const LPCLSC_OPTIMIZE_JOB_DATA;
+
+
 		// == Members.
+		/** Score of a vertex by its position in the cache. */
+		float									m_fCacheScores[LSC_CACHE_SIZE];
+
+		/** Score of a vertex by how many live triangles use it. */
+		float									m_fValenceScores[LSC_MAX_VALENCE];
 
 
 		// == Functions.
 		/**
-		 * Gets the next vertex index from which to begin the next iteration of the main loop.
+		 * Optimizes an index buffer on the calling thread.
 		 *
-		 * \param _ui32Cursor Cursor position.
-		 * \param _ui32Cache Cache size.
-		 * \param _sCandidates Candidiates.
-		 * \param _vTimeStamps Timestamps.
-		 * \param _ui32TimeStamp Current timestamp counter.
-		 * \param _ltlLiveList List of live triangles.
-		 * \param _vDeadEndStack The dead-end stack.
-		 * \return Returns the index of the next best starting point for cache usage or LSE_MAXU32.
+		 * \param _pui32Input Input vertex buffer.
+		 * \param _ui32Total Number of indices in the input vertex.
+		 * \param _pui32Output Output vertex buffer.  Must be able to hold _ui32Total indices.
+		 * \return Returns true if there were no memory failures during the optimization.
+		 */
+		LSBOOL LSE_CALL							OptimizeSerial( const uint32_t * _pui32Input, uint32_t _ui32Total, uint32_t * _pui32Output ) const;
+
+		/**
+		 * Splits the triangles into groups that share no vertices and optimizes the groups in parallel on the job system.
+		 *
+		 * \param _pui32Input Input vertex buffer.
+		 * \param _ui32Total Number of indices in the input vertex.  Must be a multiple of 3.
+		 * \param _pui32Output Output vertex buffer.  Must be able to hold _ui32Total indices.
+		 * \param _ui32Threads Number of groups to make.
+		 * \return Returns true if there were no memory failures during the optimization.
 		 */
-		uint32_t LSE_CALL						GetNextVertex( uint32_t &_ui32Cursor, const uint32_t _ui32Cache,
-			const CSet<uint32_t> &_sCandidates,
-			const CVectorPoD<uint32_t, uint32_t> &_vTimeStamps,
-			const uint32_t _ui32TimeStamp, const CLiveTriangleList &_ltlLiveList, CVectorPoD<uint32_t, uint32_t> &_vDeadEndStack );
+		LSBOOL LSE_CALL							OptimizeThreaded( const uint32_t * _pui32Input, uint32_t _ui32Total, uint32_t * _pui32Output,
+			uint32_t _ui32Threads ) const;
 
 		/**
-		 * Finds a new non-local starting point after consuming all the vertices in cache.
+		 * Gets the score of a vertex.
 		 *
-		 * \param _ltlLiveList List of live triangles.
-		 * \param _vDeadEndStack The dead-end stack.
-		 * \param _ui32Cursor Cursor position.
-		 * \return Returns the best new starting point or LSE_MAXU32.
+		 * \param _ui32CachePos Position of the vertex in the cache, or LSC_CACHE_SIZE if not in the cache.
+		 * \param _ui32Live Number of live triangles using the vertex.
+		 * \return Returns the score of the vertex.
 		 */
-		uint32_t LSE_CALL						SkipDeadEnd( const CLiveTriangleList &_ltlLiveList, CVectorPoD<uint32_t, uint32_t> &_vDeadEndStack,
-			uint32_t &_ui32Cursor );
+		LSE_INLINE float LSE_CALL				VertexScore( uint32_t _ui32CachePos, uint32_t _ui32Live ) const;
+
+		/**
+		 * Job function for optimizing a range of groups of connected triangles.
+		 *
+		 * \param _ui32Begin The first group to optimize.
+		 * \param _ui32End The group after the last to optimize.
+		 * \param _pvParm Pointer to an LSC_OPTIMIZE_JOB_DATA structure.
+		 */
+		static void LSE_CALL					OptimizeRange( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm );
 	};
 
 
 	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 	// DEFINITIONS
 	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-	
+	// == Functions.
+	/**
+	 * Gets the score of a vertex.
+	 *
+	 * \param _ui32CachePos Position of the vertex in the cache, or LSC_CACHE_SIZE if not in the cache.
+	 * \param _ui32Live Number of live triangles using the vertex.
+	 * \return Returns the score of the vertex.
+	 */
+	LSE_INLINE float LSE_CALL CTriangleCacheOptimizer::VertexScore( uint32_t _ui32CachePos, uint32_t _ui32Live ) const {
+		if ( !_ui32Live ) { return 0.0f; }
+		float fScore = m_fValenceScores[CStd::Min<uint32_t>( _ui32Live, LSC_MAX_VALENCE - 1 )];
+		if ( _ui32CachePos < LSC_CACHE_SIZE ) { fScore += m_fCacheScores[_ui32CachePos]; }
+		return fScore;
+	}
 
 }	// namespace lsc
 
@@ -0,0 +1,118 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reorders a vertex buffer so that vertices appear in the order in which an index buffer first
+ *	uses them.  Once the index buffer has been optimized for the post-transform cache, this makes vertex fetches
+ *	walk forward through memory, so each memory line fetched tends to serve several vertices in a row.
+ */
+
+#include "LSCVertexFetchOptimizer.h"
+#include "Vector/LSTLVectorPoD.h"
+
+
+namespace lsc {
+
+	// == Functions.
+	/**
+	 * Creates a table mapping each vertex to its new position.  Vertices are numbered in the order in which
+	 *	the index buffer first uses them, followed by any unused vertices in their original order.
+	 *
+	 * \param _pui32Indices The index buffer.
+	 * \param _ui32Total Total indices in the index buffer.
+	 * \param _ui32Vertices Total vertices in the vertex buffer.
+	 * \param _pui32Remap Holds the new position of each vertex.  Must be able to hold _ui32Vertices values.
+	 * \return Returns the number of vertices used by the index buffer, or LSE_MAXU32 if an index is out of range.
+	 */
+	uint32_t LSE_CALL CVertexFetchOptimizer::CreateRemap( const uint32_t * _pui32Indices, uint32_t _ui32Total,
+		uint32_t _ui32Vertices, uint32_t * _pui32Remap ) {
+		for ( uint32_t I = _ui32Vertices; I--; ) {
+			_pui32Remap[I] = LSE_MAXU32;
+		}
+
+		uint32_t ui32Next = 0;
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			uint32_t ui32V = _pui32Indices[I];
+			if ( ui32V >= _ui32Vertices ) { return LSE_MAXU32; }
+			if ( _pui32Remap[ui32V] == LSE_MAXU32 ) {
+				_pui32Remap[ui32V] = ui32Next++;
+			}
+		}
+
+		// Keep unused vertices at the end so that nothing is lost.
+		uint32_t ui32Used = ui32Next;
+		for ( uint32_t I = 0; I < _ui32Vertices; ++I ) {
+			if ( _pui32Remap[I] == LSE_MAXU32 ) {
+				_pui32Remap[I] = ui32Next++;
+			}
+		}
+		return ui32Used;
+	}
+
+	/**
+	 * Applies a remap table created by CreateRemap() to an index buffer in place.
+	 *
+	 * \param _pui32Indices The index buffer.
+	 * \param _ui32Total Total indices in the index buffer.
+	 * \param _pui32Remap The remap table.
+	 */
+	void LSE_CALL CVertexFetchOptimizer::RemapIndices( uint32_t * _pui32Indices, uint32_t _ui32Total,
+		const uint32_t * _pui32Remap ) {
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			_pui32Indices[I] = _pui32Remap[_pui32Indices[I]];
+		}
+	}
+
+	/**
+	 * Applies a remap table created by CreateRemap() to a vertex buffer.
+	 *
+	 * \param _pvSrc The source vertices.
+	 * \param _ui32Vertices Total vertices in the vertex buffer.
+	 * \param _ui32Stride Size of each vertex in bytes.
+	 * \param _pui32Remap The remap table.
+	 * \param _pvDst Holds the reordered vertices.  Must not overlap _pvSrc.
+	 */
+	void LSE_CALL CVertexFetchOptimizer::RemapVertices( const void * _pvSrc, uint32_t _ui32Vertices, uint32_t _ui32Stride,
+		const uint32_t * _pui32Remap, void * _pvDst ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		for ( uint32_t I = 0; I < _ui32Vertices; ++I ) {
+			CStd::MemCpy( pui8Dst + static_cast<uintptr_t>(_pui32Remap[I]) * _ui32Stride, pui8Src, _ui32Stride );
+			pui8Src += _ui32Stride;
+		}
+	}
+
+	/**
+	 * Reorders a vertex buffer in place for the given index buffer and updates the index buffer to match.
+	 *
+	 * \param _pui32Indices The index buffer.
+	 * \param _ui32Total Total indices in the index buffer.
+	 * \param _pvVertices The vertex buffer.
+	 * \param _ui32Vertices Total vertices in the vertex buffer.
+	 * \param _ui32Stride Size of each vertex in bytes.
+	 * \return Returns true if there was enough memory to perform the operation and every index is in range.
+	 */
+	LSBOOL LSE_CALL CVertexFetchOptimizer::Optimize( uint32_t * _pui32Indices, uint32_t _ui32Total,
+		void * _pvVertices, uint32_t _ui32Vertices, uint32_t _ui32Stride ) {
+		if ( !_ui32Vertices || !_ui32Stride ) { return _ui32Total == 0; }
+		CVectorPoD<uint32_t, uint32_t> vRemap;
+		if ( !vRemap.Resize( _ui32Vertices ) ) { return false; }
+		if ( CreateRemap( _pui32Indices, _ui32Total, _ui32Vertices, &vRemap[0] ) == LSE_MAXU32 ) { return false; }
+
+		CVectorPoD<uint8_t, uint32_t> vTemp;
+		uint64_t ui64Size = static_cast<uint64_t>(_ui32Vertices) * _ui32Stride;
+		if ( ui64Size > LSE_MAXU32 || !vTemp.Resize( static_cast<uint32_t>(ui64Size) ) ) { return false; }
+		CStd::MemCpy( &vTemp[0], _pvVertices, static_cast<uintptr_t>(ui64Size) );
+		RemapVertices( &vTemp[0], _ui32Vertices, _ui32Stride, &vRemap[0], _pvVertices );
+		RemapIndices( _pui32Indices, _ui32Total, &vRemap[0] );
+		return true;
+	}
+
+}	// namespace lsc
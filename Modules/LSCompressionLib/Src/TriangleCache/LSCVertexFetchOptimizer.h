@@ -0,0 +1,87 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reorders a vertex buffer so that vertices appear in the order in which an index buffer first
+ *	uses them.  Once the index buffer has been optimized for the post-transform cache, this makes vertex fetches
+ *	walk forward through memory, so each memory line fetched tends to serve several vertices in a row.
+ */
+
+
+#ifndef __LSC_VERTEXFETCHOPTIMIZER_H__
+#define __LSC_VERTEXFETCHOPTIMIZER_H__
+
+#include "../LSCCompressionLib.h"
+
+namespace lsc {
+
+	/**
+	 * Class CVertexFetchOptimizer
+	 * \brief Reorders a vertex buffer for vertex-fetch locality.
+	 *
+	 * Description: Reorders a vertex buffer so that vertices appear in the order in which an index buffer first
+	 *	uses them.  Once the index buffer has been optimized for the post-transform cache, this makes vertex fetches
+	 *	walk forward through memory, so each memory line fetched tends to serve several vertices in a row.
+	 */
+	class CVertexFetchOptimizer {
+	public :
+		// == Functions.
+		/**
+		 * Creates a table mapping each vertex to its new position.  Vertices are numbered in the order in which
+		 *	the index buffer first uses them, followed by any unused vertices in their original order.
+		 *
+		 * \param _pui32Indices The index buffer.
+		 * \param _ui32Total Total indices in the index buffer.
+		 * \param _ui32Vertices Total vertices in the vertex buffer.
+		 * \param _pui32Remap Holds the new position of each vertex.  Must be able to hold _ui32Vertices values.
+		 * \return Returns the number of vertices used by the index buffer, or LSE_MAXU32 if an index is out of range.
+		 */
+		static uint32_t LSE_CALL				CreateRemap( const uint32_t * _pui32Indices, uint32_t _ui32Total,
+			uint32_t _ui32Vertices, uint32_t * _pui32Remap );
+
+		/**
+		 * Applies a remap table created by CreateRemap() to an index buffer in place.
+		 *
+		 * \param _pui32Indices The index buffer.
+		 * \param _ui32Total Total indices in the index buffer.
+		 * \param _pui32Remap The remap table.
+		 */
+		static void LSE_CALL					RemapIndices( uint32_t * _pui32Indices, uint32_t _ui32Total,
+			const uint32_t * _pui32Remap );
+
+		/**
+		 * Applies a remap table created by CreateRemap() to a vertex buffer.
+		 *
+		 * \param _pvSrc The source vertices.
+		 * \param _ui32Vertices Total vertices in the vertex buffer.
+		 * \param _ui32Stride Size of each vertex in bytes.
+		 * \param _pui32Remap The remap table.
+		 * \param _pvDst Holds the reordered vertices.  Must not overlap _pvSrc.
+		 */
+		static void LSE_CALL					RemapVertices( const void * _pvSrc, uint32_t _ui32Vertices, uint32_t _ui32Stride,
+			const uint32_t * _pui32Remap, void * _pvDst );
+
+		/**
+		 * Reorders a vertex buffer in place for the given index buffer and updates the index buffer to match.
+		 *
+		 * \param _pui32Indices The index buffer.
+		 * \param _ui32Total Total indices in the index buffer.
+		 * \param _pvVertices The vertex buffer.
+		 * \param _ui32Vertices Total vertices in the vertex buffer.
+		 * \param _ui32Stride Size of each vertex in bytes.
+		 * \return Returns true if there was enough memory to perform the operation and every index is in range.
+		 */
+		static LSBOOL LSE_CALL					Optimize( uint32_t * _pui32Indices, uint32_t _ui32Total,
+			void * _pvVertices, uint32_t _ui32Vertices, uint32_t _ui32Stride );
+	};
+
+}	// namespace lsc
+
+#endif	// __LSC_VERTEXFETCHOPTIMIZER_H__
@@ -36,14 +36,27 @@ namespace lsc {
 		if ( !m_vVerts.Resize( CountVertices( _pui32Indices, _ui32Total ) ) ) { return false; }
 		if ( !m_vVerts.Length() ) { return true; }
 
-		// Count how many total connections there are.
-		uint32_t ui32Connections = _ui32Total;//CountConnections( _pui32Indices, _ui32Total );
-		if ( !m_vPool.Resize( ui32Connections ) ) { return false; }
+		// Every index is one connection.  Degenerates count as multiple connections; later in the algorithm a
+		//	single degenerate triangle will subtract the correct number of counts to make everything work correctly.
+		if ( !m_vPool.Resize( _ui32Total ) ) { return false; }
 
-		uint32_t ui32AllocIndex = 0;
-		// Make connections.
+		// Count the connections to each vertex, then give each vertex its slice of the pool and fill them all in
+		//	one more pass over the index buffer.
+		for ( uint32_t I = m_vVerts.Length(); I--; ) {
+			m_vVerts[I].ui32Total = 0;
+		}
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			++m_vVerts[_pui32Indices[I]].ui32Total;
+		}
+		uint32_t * pui32Alloc = m_vPool.Length() ? &m_vPool[0] : NULL;
 		for ( uint32_t I = 0; I < m_vVerts.Length(); ++I ) {
-			ConnectTriangles( I, ui32AllocIndex, _pui32Indices, _ui32Total );
+			m_vVerts[I].pui32Tris = pui32Alloc;
+			pui32Alloc += m_vVerts[I].ui32Total;
+			m_vVerts[I].ui32Total = 0;
+		}
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			LSC_VERTEX_ADJACENCY & vaThis = m_vVerts[_pui32Indices[I]];
+			vaThis.pui32Tris[vaThis.ui32Total++] = I / 3;
 		}
 
 		return true;
@@ -66,74 +79,4 @@ namespace lsc {
 		return ui32Total + 1;
 	}
 
-	/**
-	 * Counts the total triangles connected to a single vertex.
-	 *
-	 * \param _ui32Vert The vertex index.
-	 * \param _pui32Indices The index buffer.
-	 * \param _ui32Total Total indices in the index buffer.
-	 * \return Returns the total number of triangles in the index buffer that are connected to the given vertex.
-	 */
-	uint32_t LSE_CALL CVertexTriangleAdjacency::CountConnections( uint32_t _ui32Vert, const uint32_t * _pui32Indices, uint32_t _ui32Total ) {
-		uint32_t ui32Total = 0;
-		for ( uint32_t I = 0; I < _ui32Total; I += 3 ) {
-			// Important note: Count degenerates as multiple connections.  Later in the algorithm a single degenerate triangle
-			//	will subtract the correct number of counts to make everything work correctly.
-			if ( _pui32Indices[I] == _ui32Vert ) {
-				++ui32Total;
-			}
-			if ( _pui32Indices[I+1] == _ui32Vert ) {
-				++ui32Total;
-			}
-			if ( _pui32Indices[I+2] == _ui32Vert ) {
-				++ui32Total;
-			}
-		}
-		return ui32Total;
-	}
-
-	/**
-	 * Counts the total connections to triangles for all vertices.
-	 *
-	 * \param _pui32Indices The index buffer.
-	 * \param _ui32Total Total indices in the index buffer.
-	 * \return Returns the total connections for all vertices.
-	 */
-	uint32_t LSE_CALL CVertexTriangleAdjacency::CountConnections( const uint32_t * _pui32Indices, uint32_t _ui32Total ) {
-		uint32_t ui32Total = 0;
-		for ( uint32_t I = m_vVerts.Length(); I--; ) {
-			ui32Total += CountConnections( I, _pui32Indices, _ui32Total );
-		}
-		return ui32Total;
-	}
-
-	/**
-	 * Connects triangles to a vertex.
-	 *
-	 * \param _ui32Vert The vertex to which to connect adjacent triangles.
-	 * \param _ui32Alloc Allocation index.
-	 * \param _pui32Indices The index buffer.
-	 * \param _ui32Total Total indices in the index buffer.
-	 */
-	void LSE_CALL CVertexTriangleAdjacency::ConnectTriangles( uint32_t _ui32Vert, uint32_t &_ui32Alloc, const uint32_t * _pui32Indices, uint32_t _ui32Total ) {
-		uint32_t * pui32Buffer = &m_vPool[_ui32Alloc];
-		m_vVerts[_ui32Vert].pui32Tris = pui32Buffer;
-		uint32_t ui32Total = 0;
-		for ( uint32_t I = 0; I < _ui32Total; I += 3 ) {
-			// Important note: Count degenerates as multiple connections.  Later in the algorithm a single degenerate triangle
-			//	will subtract the correct number of counts to make everything work correctly.
-			if ( _pui32Indices[I] == _ui32Vert ) {
-				pui32Buffer[ui32Total++] = I / 3;
-			}
-			if ( _pui32Indices[I+1] == _ui32Vert ) {
-				pui32Buffer[ui32Total++] = I / 3;
-			}
-			if ( _pui32Indices[I+2] == _ui32Vert ) {
-				pui32Buffer[ui32Total++] = I / 3;
-			}
-		}
-		m_vVerts[_ui32Vert].ui32Total = ui32Total;
-		_ui32Alloc += ui32Total;
-	}
-
 }	// namespace lsc
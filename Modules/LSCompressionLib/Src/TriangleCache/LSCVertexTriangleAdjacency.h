@@ -87,35 +87,6 @@ namespace lsc {
 		 */
 		uint32_t LSE_CALL						CountVertices( const uint32_t * _pui32Indices, uint32_t _ui32Total );
 
-		/**
-		 * Counts the total triangles connected to a single vertex.
-		 *
-		 * \param _ui32Vert The vertex index.
-		 * \param _pui32Indices The index buffer.
-		 * \param _ui32Total Total indices in the index buffer.
-		 * \return Returns the total number of triangles in the index buffer that are connected to the given vertex.
-		 */
-		uint32_t LSE_CALL						CountConnections( uint32_t _ui32Vert, const uint32_t * _pui32Indices, uint32_t _ui32Total );
-
-		/**
-		 * Counts the total connections to triangles for all vertices.
-		 *
-		 * \param _pui32Indices The index buffer.
-		 * \param _ui32Total Total indices in the index buffer.
-		 * \return Returns the total connections for all vertices.
-		 */
-		uint32_t LSE_CALL						CountConnections( const uint32_t * _pui32Indices, uint32_t _ui32Total );
-
-		/**
-		 * Connects triangles to a vertex.
-		 *
-		 * \param _ui32Vert The vertex to which to connect adjacent triangles.
-		 * \param _ui32Alloc Allocation index.
-		 * \param _pui32Indices The index buffer.
-		 * \param _ui32Total Total indices in the index buffer.
-		 */
-		void LSE_CALL							ConnectTriangles( uint32_t _ui32Vert, uint32_t &_ui32Alloc, const uint32_t * _pui32Indices, uint32_t _ui32Total );
-
 	};
 
 
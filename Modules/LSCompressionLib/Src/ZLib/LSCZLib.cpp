@@ -10,7 +10,7 @@
  *
  *
  * Description: A primitive and light-weight implementation of a zlib inflation routine.  This class cannot
- *	be used to compress/deflate data.
+ *	be used to compress/deflate data; use CZLibEncoder for that.
  */
 
 #include "LSCZLib.h"
@@ -33,10 +33,44 @@ namespace lsc {
 	 */
 	CCriticalSection CZLib::m_scCrit;
 
+	/**
+	 * Base length for each length code.
+	 */
+	const uint16_t CZLib::m_ui16LenBase[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+	};
+
+	/**
+	 * Length extra bits for each length code.
+	 */
+	const uint8_t CZLib::m_ui8LenExtra[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+	};
+
+	/**
+	 * Base distance for each distance code.
+	 */
+	const uint16_t CZLib::m_ui16DistBase[30] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+	};
+
+	/**
+	 * Distance extra bits for each distance code.
+	 */
+	const uint8_t CZLib::m_ui8DistExtra[30] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+	};
+
 	// == Various constructors.
 	LSE_CALLCTOR CZLib::CZLib() :
-		m_ui32BufferedBits( 0 ),
-		m_ui32TotalBitsBuffered( 0 ) {
+		m_ui64BufferedBits( 0 ),
+		m_ui32TotalBitsBuffered( 0 ),
+		m_ui32Overrun( 0 ),
+		m_pui8In( NULL ),
+		m_pui8InEnd( NULL ),
+		m_pzbOut( NULL ),
+		m_ui32OutPos( 0 ) {
 	}
 
 	// == Functions.
@@ -51,295 +85,450 @@ namespace lsc {
 	 */
 	LSBOOL LSE_CALL CZLib::DecodeZLib( const uint8_t * _pui8Buffer, uintptr_t _uiptrLen,
 		LSBOOL _bSkipHeaders, LSC_ZLIB_BUFFER &_zbOut ) {
-		CExternalByteStream ebsStream( _pui8Buffer, _uiptrLen );
-		if ( !_bSkipHeaders ) {
-			if ( !CheckHeader( ebsStream ) ) { return false; }
-		}
-
-		uint32_t ui32Final;
-		do {
-			if ( !Receive( ebsStream, 1, ui32Final ) ) { return false; }
+		m_pui8In = _pui8Buffer;
+		m_pui8InEnd = _pui8Buffer + _uiptrLen;
+		m_ui64BufferedBits = 0;
+		m_ui32TotalBitsBuffered = 0;
+		m_ui32Overrun = 0;
+		m_pzbOut = &_zbOut;
+		m_ui32OutPos = _zbOut.Length();
+
+		LSBOOL bRet = _bSkipHeaders || CheckHeader();
+		uint32_t ui32Final = 0;
+		while ( bRet && !ui32Final ) {
 			uint32_t ui32Type;
-			if ( !Receive( ebsStream, 2, ui32Type ) ) { return false; }
+			bRet = Receive( 1, ui32Final ) && Receive( 2, ui32Type );
+			if ( !bRet ) { break; }
 			if ( ui32Type == 0 ) {
-				if ( !ParseUncompressed( ebsStream, _zbOut ) ) { return false; }
+				bRet = ParseUncompressed();
 			}
 			else if ( ui32Type == 3 ) {
-				return false;
+				bRet = false;
 			}
 			else {
 				if ( ui32Type == 1 ) {
 					SetDefaults();
-					if ( !BuildHuffman( m_hLength, m_ui8DefaultLengths, LSE_ELEMENTS( m_ui8DefaultLengths ) ) ) { return false; }
-					if ( !BuildHuffman( m_hDistance, m_ui8DefaultDistances, LSE_ELEMENTS( m_ui8DefaultDistances ) ) ) { return false; }
+					bRet = BuildTable( m_ui8DefaultLengths, LSE_ELEMENTS( m_ui8DefaultLengths ), LSC_TK_LITLEN,
+						LSC_LITLEN_BITS, m_ui32LitLen, LSE_ELEMENTS( m_ui32LitLen ) ) &&
+						BuildTable( m_ui8DefaultDistances, LSE_ELEMENTS( m_ui8DefaultDistances ), LSC_TK_DIST,
+						LSC_DIST_BITS, m_ui32Dist, LSE_ELEMENTS( m_ui32Dist ) );
 				}
 				else {
-					if ( !ComputeHuffmanCodes( ebsStream ) ) { return false; }
+					bRet = ComputeHuffmanCodes();
 				}
-
-				if ( !ParseHuffmanBlock( ebsStream, _zbOut ) ) { return false; }
+				bRet = bRet && ParseHuffmanBlock();
 			}
+		}
 
-		} while ( !ui32Final );
-
-		return true;
+		// The buffer is kept ahead of the output; trim it to what was written.
+		_zbOut.ResizeUninitialized( m_ui32OutPos );
+		m_pzbOut = NULL;
+		return bRet;
 	}
 
 	/**
-	 * Fill our bit buffer.
+	 * Calculates or continues an Adler-32 checksum, as used by zlib streams.
 	 *
-	 * \param _ebsStream The stream from which to take bits.
-	 * \return Returns false if the stream runs out of bits.
+	 * \param _pui8Data The data for which to calculate the checksum.
+	 * \param _uiptrLen Length of the data.
+	 * \param _ui32Adler The checksum of the data preceding _pui8Data, or 1 to start a new checksum.
+	 * \return Returns the Adler-32 checksum.
 	 */
-	LSBOOL LSE_CALL CZLib::FillBits( const CExternalByteStream &_ebsStream ) {
-		do {
-			uint8_t ui8This;
-			if ( !ReadUi8( _ebsStream, ui8This ) ) { return false; }
-			m_ui32BufferedBits |= static_cast<uint32_t>(ui8This) << m_ui32TotalBitsBuffered;
+	uint32_t LSE_CALL CZLib::Adler32( const uint8_t * _pui8Data, uintptr_t _uiptrLen, uint32_t _ui32Adler ) {
+		uint32_t ui32A = _ui32Adler & 0xFFFF;
+		uint32_t ui32B = _ui32Adler >> 16;
+		while ( _uiptrLen ) {
+			// 5552 is the most bytes that can be summed before B can overflow 32 bits.
+			uint32_t ui32Run = static_cast<uint32_t>(CStd::Min<uintptr_t>( _uiptrLen, 5552 ));
+			_uiptrLen -= ui32Run;
+			for ( ; ui32Run >= 8; ui32Run -= 8, _pui8Data += 8 ) {
+				ui32A += _pui8Data[0]; ui32B += ui32A;
+				ui32A += _pui8Data[1]; ui32B += ui32A;
+				ui32A += _pui8Data[2]; ui32B += ui32A;
+				ui32A += _pui8Data[3]; ui32B += ui32A;
+				ui32A += _pui8Data[4]; ui32B += ui32A;
+				ui32A += _pui8Data[5]; ui32B += ui32A;
+				ui32A += _pui8Data[6]; ui32B += ui32A;
+				ui32A += _pui8Data[7]; ui32B += ui32A;
+			}
+			while ( ui32Run-- ) {
+				ui32A += (*_pui8Data++);
+				ui32B += ui32A;
+			}
+			ui32A %= 65521;
+			ui32B %= 65521;
+		}
+		return (ui32B << 16) | ui32A;
+	}
+
+	/**
+	 * Fill our bit buffer, one byte at a time.  Past the end of the input, 0 bytes are buffered and counted in
+	 *	m_ui32Overrun; Truncated() reports whether any of them have been consumed.
+	 */
+	void LSE_CALL CZLib::FillBits() {
+		while ( m_ui32TotalBitsBuffered <= 56 ) {
+			if ( m_pui8In < m_pui8InEnd ) {
+				m_ui64BufferedBits |= static_cast<uint64_t>(*m_pui8In++) << m_ui32TotalBitsBuffered;
+			}
+			else {
+				++m_ui32Overrun;
+			}
 			m_ui32TotalBitsBuffered += 8;
-		} while ( m_ui32TotalBitsBuffered <= 24UL );
-		return true;
+		}
 	}
 
 	/**
 	 * Read X number of bits.
 	 *
-	 * \param _ebsStream The stream from which to take bits.
-	 * \param _ui32Total The number of bits to read.
+	 * \param _ui32Total The number of bits to read, at most 32.
 	 * \param _ui32Return Holds the returned value.
 	 * \return Returns true if all bits were read.
 	 */
-	LSBOOL LSE_CALL CZLib::Receive( const CExternalByteStream &_ebsStream, uint32_t _ui32Total, uint32_t &_ui32Return ) {
+	LSBOOL LSE_CALL CZLib::Receive( uint32_t _ui32Total, uint32_t &_ui32Return ) {
 		if ( m_ui32TotalBitsBuffered < _ui32Total ) {
-			if ( !FillBits( _ebsStream ) ) { return false; }
+			FillBits();
 		}
-		_ui32Return = m_ui32BufferedBits & ((1 << _ui32Total) - 1);
-		m_ui32BufferedBits >>= _ui32Total;
+		_ui32Return = static_cast<uint32_t>(m_ui64BufferedBits & ((1ULL << _ui32Total) - 1ULL));
+		m_ui64BufferedBits >>= _ui32Total;
 		m_ui32TotalBitsBuffered -= _ui32Total;
-		return true;
+		return !Truncated();
 	}
 
 	/**
-	 * Computes the Huffman codes.
+	 * Reads the code lengths of a dynamic-Huffman block and builds its tables.
 	 *
-	 * \param _ebsStream The stream.
 	 * \return Returns false if the stream is not formatted properly.
 	 */
-	LSBOOL LSE_CALL CZLib::ComputeHuffmanCodes( const CExternalByteStream &_ebsStream ) {
-		static uint8_t ui8LenDeZigZag[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
-
-		LSC_HUFFMAN hCodeLen;
+	LSBOOL LSE_CALL CZLib::ComputeHuffmanCodes() {
+		static const uint8_t ui8LenDeZigZag[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
 
-		uint8_t ui8LenCodes[286+32+137];
-		uint8_t ui8CodeLenSizes[19];
+		uint32_t ui32ClTable[LSC_CL_ENOUGH];
+		uint8_t ui8LenCodes[288+32];
+		uint8_t ui8CodeLenSizes[19] = { 0 };
 
 		uint32_t ui32Lit, ui32Clen, ui32Dist;
-		if ( !Receive( _ebsStream, 5, ui32Lit ) ) { return false; }
+		if ( !Receive( 5, ui32Lit ) ) { return false; }
 		ui32Lit += 257UL;
-		if ( !Receive( _ebsStream, 5, ui32Dist ) ) { return false; }
+		if ( !Receive( 5, ui32Dist ) ) { return false; }
 		ui32Dist += 1;
-		if ( !Receive( _ebsStream, 4, ui32Clen ) ) { return false; }
+		if ( !Receive( 4, ui32Clen ) ) { return false; }
 		ui32Clen += 4;
 
-		CStd::MemSet( ui8CodeLenSizes, 0, sizeof( ui8CodeLenSizes ) );
-
 		for ( uint32_t I = 0; I < ui32Clen; ++I ) {
 			uint32_t ui32S;
-			if ( !Receive( _ebsStream, 3, ui32S ) ) { return false; }
+			if ( !Receive( 3, ui32S ) ) { return false; }
 			ui8CodeLenSizes[ui8LenDeZigZag[I]] = static_cast<uint8_t>(ui32S);
 		}
-
-		if ( !BuildHuffman( hCodeLen, ui8CodeLenSizes, LSE_ELEMENTS( ui8CodeLenSizes ) ) ) { return false; }
-		uint32_t ui32N = 0;
-
-
-		while ( ui32N < ui32Lit + ui32Dist ) {
-			int32_t i32Code = DecodeHuffman( _ebsStream, hCodeLen );
-			if ( !(i32Code >= 0 && i32Code < 19) ) { return false; }
-			if ( i32Code < 16 ) {
-				ui8LenCodes[ui32N++] = static_cast<uint8_t>(i32Code);
+		if ( !BuildTable( ui8CodeLenSizes, LSE_ELEMENTS( ui8CodeLenSizes ), LSC_TK_CODE_LENGTH,
+			LSC_CL_BITS, ui32ClTable, LSE_ELEMENTS( ui32ClTable ) ) ) { return false; }
+
+		uint32_t ui32Total = ui32Lit + ui32Dist;
+		for ( uint32_t ui32N = 0; ui32N < ui32Total; ) {
+			// Code-length codes are at most 7 bits, so the table has no subtables.
+			if ( m_ui32TotalBitsBuffered < LSC_CL_BITS ) { FillBits(); }
+			uint32_t ui32Entry = ui32ClTable[m_ui64BufferedBits&((1<<LSC_CL_BITS)-1)];
+			if ( ui32Entry & LSC_TE_INVALID ) { return false; }
+			m_ui64BufferedBits >>= ui32Entry & LSC_TE_BITS_MASK;
+			m_ui32TotalBitsBuffered -= ui32Entry & LSC_TE_BITS_MASK;
+			if ( Truncated() ) { return false; }
+
+			uint32_t ui32Code = ui32Entry >> LSC_TE_VALUE_SHIFT;
+			if ( ui32Code < 16 ) {
+				ui8LenCodes[ui32N++] = static_cast<uint8_t>(ui32Code);
+				continue;
 			}
-			else if ( i32Code == 16 ) {
-				if ( !Receive( _ebsStream, 2, reinterpret_cast<uint32_t &>(i32Code) ) ) { return false; }
-				i32Code += 3;
-				CStd::MemSet( &ui8LenCodes[ui32N], ui8LenCodes[ui32N-1], static_cast<uint32_t>(i32Code) );
-				ui32N += static_cast<uint32_t>(i32Code);
+			uint32_t ui32Repeat;
+			uint8_t ui8Value = 0;
+			if ( ui32Code == 16 ) {
+				if ( !ui32N ) { return false; }
+				if ( !Receive( 2, ui32Repeat ) ) { return false; }
+				ui32Repeat += 3;
+				ui8Value = ui8LenCodes[ui32N-1];
 			}
-			else if ( i32Code == 17 ) {
-				if ( !Receive( _ebsStream, 3, reinterpret_cast<uint32_t &>(i32Code) ) ) { return false; }
-				i32Code += 3;
-				CStd::MemSet( &ui8LenCodes[ui32N], 0, static_cast<uint32_t>(i32Code) );
-				ui32N += static_cast<uint32_t>(i32Code);
+			else if ( ui32Code == 17 ) {
+				if ( !Receive( 3, ui32Repeat ) ) { return false; }
+				ui32Repeat += 3;
 			}
 			else {
-				if ( i32Code != 18 ) { return false; }
-				if ( !Receive( _ebsStream, 7, reinterpret_cast<uint32_t &>(i32Code) ) ) { return false; }
-				i32Code += 11;
-				CStd::MemSet( &ui8LenCodes[ui32N], 0, static_cast<uint32_t>(i32Code) );
-				ui32N += static_cast<uint32_t>(i32Code);
+				if ( !Receive( 7, ui32Repeat ) ) { return false; }
+				ui32Repeat += 11;
 			}
+			if ( ui32N + ui32Repeat > ui32Total ) { return false; }
+			CStd::MemSet( &ui8LenCodes[ui32N], ui8Value, ui32Repeat );
+			ui32N += ui32Repeat;
 		}
 
-
-		if ( ui32N != ui32Lit + ui32Dist ) { return false; }
-		if ( !BuildHuffman( m_hLength, ui8LenCodes, ui32Lit ) ) { return false; }
-		if ( !BuildHuffman( m_hDistance, ui8LenCodes + ui32Lit, ui32Dist ) ) { return false; }
-
-		return true;
+		return BuildTable( ui8LenCodes, ui32Lit, LSC_TK_LITLEN, LSC_LITLEN_BITS, m_ui32LitLen, LSE_ELEMENTS( m_ui32LitLen ) ) &&
+			BuildTable( ui8LenCodes + ui32Lit, ui32Dist, LSC_TK_DIST, LSC_DIST_BITS, m_ui32Dist, LSE_ELEMENTS( m_ui32Dist ) );
 	}
 
 	/**
-	 * Builds Huffman codes.
+	 * Builds a decoding table from code lengths.  Codes up to _ui32RootBits long are decoded with a single
+	 *	lookup; longer codes go through a second-level table.
 	 *
-	 * \param _hHuffman The target Huffman buffer.
-	 * \param _pui8Codes Litst of codes.
-	 * \param _ui32Total Length of the list of codes.
-	 * \return Returns false if the stream is not formatted properly.
+	 * \param _pui8Codes List of code lengths.
+	 * \param _ui32Total Length of the list of code lengths.
+	 * \param _tkKind The kind of table, which determines what each symbol decodes to.
+	 * \param _ui32RootBits Bits indexing the root table.
+	 * \param _pui32Table The table to build.
+	 * \param _ui32TableSize Number of entries in _pui32Table.
+	 * \return Returns false if the code lengths are over-subscribed or the table is too small.
 	 */
-	LSBOOL LSE_CALL CZLib::BuildHuffman( LSC_HUFFMAN &_hHuffman,
-		const uint8_t * _pui8Codes, uint32_t _ui32Total ) {
-		int32_t i32Sizes[17] = { 0 }, i32NextCode[16];
-		CStd::MemSet( _hHuffman.ui16Fast, 0xFF, sizeof( _hHuffman.ui16Fast ) );
+	LSBOOL LSE_CALL CZLib::BuildTable( const uint8_t * _pui8Codes, uint32_t _ui32Total, LSC_TABLE_KIND _tkKind,
+		uint32_t _ui32RootBits, uint32_t * _pui32Table, uint32_t _ui32TableSize ) {
+		uint32_t ui32Count[LSC_MAX_CODE_BITS+1] = { 0 };
 		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
-			++i32Sizes[_pui8Codes[I]];
+			++ui32Count[_pui8Codes[I]];
+		}
+		ui32Count[0] = 0;
+
+		// Incomplete codes are allowed (a single distance code is common); over-subscribed codes are not.
+		int32_t i32Left = 1;
+		uint32_t ui32MaxLen = 0;
+		for ( uint32_t I = 1; I <= LSC_MAX_CODE_BITS; ++I ) {
+			i32Left = (i32Left << 1) - static_cast<int32_t>(ui32Count[I]);
+			if ( i32Left < 0 ) { return false; }
+			if ( ui32Count[I] ) { ui32MaxLen = I; }
 		}
 
-		i32Sizes[0] = 0;
-
-		for ( uint32_t I = 16; I-- > 1; ) {
-			if ( !(static_cast<uint32_t>(i32Sizes[I]) <= (1U << I)) ) { return false; }
+		// Sort the symbols by code length, which puts them in the order of their canonical codes.
+		uint32_t ui32Offsets[LSC_MAX_CODE_BITS+1];
+		ui32Offsets[1] = 0;
+		for ( uint32_t I = 1; I < LSC_MAX_CODE_BITS; ++I ) {
+			ui32Offsets[I+1] = ui32Offsets[I] + ui32Count[I];
+		}
+		uint16_t ui16Sorted[288];
+		uint32_t ui32Codes = 0;
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			if ( _pui8Codes[I] ) {
+				ui16Sorted[ui32Offsets[_pui8Codes[I]]++] = static_cast<uint16_t>(I);
+				++ui32Codes;
+			}
 		}
 
-		int32_t i32Code = 0, i32K = 0;
-		for ( uint32_t I = 1; I < 16; ++I ) {
-			i32NextCode[I] = i32Code;
-			_hHuffman.ui16FirstCode[I] = static_cast<uint16_t>(i32Code);
-			_hHuffman.ui16FirstSymbol[I] = static_cast<uint16_t>(i32K);
-			i32Code += i32Sizes[I];
-			if ( i32Code - 1 >= static_cast<int32_t>(1 << I) ) { return false; }
-
-			_hHuffman.i32MaxCode[I] = i32Code << (16 - I);
-			i32Code <<= 1;
-			i32K += i32Sizes[I];
+		uint32_t ui32NextCode[LSC_MAX_CODE_BITS+1];
+		uint32_t ui32Code = 0;
+		for ( uint32_t I = 1; I <= LSC_MAX_CODE_BITS; ++I ) {
+			ui32Code = (ui32Code + ui32Count[I-1]) << 1;
+			ui32NextCode[I] = ui32Code;
 		}
 
+		uint32_t ui32RootSize = 1U << _ui32RootBits;
+		if ( ui32RootSize > _ui32TableSize ) { return false; }
+		for ( uint32_t I = 0; I < ui32RootSize; ++I ) {
+			_pui32Table[I] = LSC_TE_INVALID;
+		}
 
-		_hHuffman.i32MaxCode[16] = 0x10000;
-		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
-			int32_t i32S = _pui8Codes[I];
-			if ( i32S ) {
-				int32_t i32ThisCode = i32NextCode[i32S] - _hHuffman.ui16FirstCode[i32S] + _hHuffman.ui16FirstSymbol[i32S];
-				_hHuffman.ui8Size[i32ThisCode] = static_cast<uint8_t>(i32S);
-				_hHuffman.ui16Values[i32ThisCode] = static_cast<uint16_t>(I);
-
-				if ( i32S < LSC_FAST_BITS ) {
-					uint32_t ui32K = ReverseBits( static_cast<uint16_t>(i32NextCode[i32S]), static_cast<uint32_t>(i32S) );
-					while ( ui32K < (1 << LSC_FAST_BITS) ) {
-						_hHuffman.ui16Fast[ui32K] = static_cast<uint16_t>(i32ThisCode);
-						ui32K += (1 << i32S);
+		uint32_t ui32Used = ui32RootSize;
+		uint32_t ui32SubPrefix = ~0U, ui32SubOffset = 0, ui32SubBits = 0;
+		for ( uint32_t I = 0; I < ui32Codes; ++I ) {
+			uint32_t ui32Symbol = ui16Sorted[I];
+			uint32_t ui32Len = _pui8Codes[ui32Symbol];
+			// Codes are read least-significant bit first, so tables are indexed by the reversed code.
+			uint32_t ui32Reversed = CStd::BitSwap16( static_cast<uint16_t>(ui32NextCode[ui32Len]++) ) >> (16 - ui32Len);
+			uint32_t ui32Entry = SymbolEntry( _tkKind, ui32Symbol );
+			if ( ui32Len <= _ui32RootBits ) {
+				ui32Entry |= ui32Len;
+				for ( uint32_t J = ui32Reversed; J < ui32RootSize; J += 1U << ui32Len ) {
+					_pui32Table[J] = ui32Entry;
+				}
+			}
+			else {
+				uint32_t ui32Prefix = ui32Reversed & (ui32RootSize - 1);
+				if ( ui32Prefix != ui32SubPrefix ) {
+					// Start a subtable large enough for all of the remaining codes with this prefix.
+					ui32SubBits = ui32Len - _ui32RootBits;
+					int32_t i32Room = 1 << ui32SubBits;
+					while ( ui32SubBits + _ui32RootBits < ui32MaxLen ) {
+						i32Room -= static_cast<int32_t>(ui32Count[ui32SubBits+_ui32RootBits]);
+						if ( i32Room <= 0 ) { break; }
+						++ui32SubBits;
+						i32Room <<= 1;
+					}
+					if ( ui32Used + (1U << ui32SubBits) > _ui32TableSize ) { return false; }
+					ui32SubOffset = ui32Used;
+					ui32Used += 1U << ui32SubBits;
+					ui32SubPrefix = ui32Prefix;
+					for ( uint32_t J = 0; J < (1U << ui32SubBits); ++J ) {
+						_pui32Table[ui32SubOffset+J] = LSC_TE_INVALID;
 					}
+					_pui32Table[ui32Prefix] = LSC_TE_SUBTABLE | (ui32SubOffset << LSC_TE_VALUE_SHIFT) |
+						(ui32SubBits << LSC_TE_EXTRA_SHIFT) | _ui32RootBits;
+				}
+				ui32Entry |= ui32Len - _ui32RootBits;
+				for ( uint32_t J = ui32Reversed >> _ui32RootBits; J < (1U << ui32SubBits); J += 1U << (ui32Len - _ui32RootBits) ) {
+					_pui32Table[ui32SubOffset+J] = ui32Entry;
 				}
-				++i32NextCode[i32S];
 			}
+			// Subtable sizes are based on the codes not yet placed.
+			--ui32Count[ui32Len];
 		}
-
 		return true;
 	}
 
 	/**
-	 * Decode a Huffman buffer.
+	 * Gets the table entry for a symbol, not including the number of bits to consume.
 	 *
-	 * \param _ebsStream The stream.
-	 * \param _hHuffman The Huffman buffer.
-	 * \return Returns the next code or -1 on error.
+	 * \param _tkKind The kind of table.
+	 * \param _ui32Symbol The symbol.
+	 * \return Returns the table entry for the symbol.
 	 */
-	int32_t LSE_CALL CZLib::DecodeHuffman( const CExternalByteStream &_ebsStream, LSC_HUFFMAN &_hHuffman ) {
-		if ( m_ui32TotalBitsBuffered < 16 ) {
-			if ( !FillBits( _ebsStream ) ) { return -1; }
-		}
-
-
-		int32_t i32B = _hHuffman.ui16Fast[m_ui32BufferedBits&LSC_MASK];
-		if ( i32B < 0xFFFF ) {
-			int32_t i32Size = _hHuffman.ui8Size[i32B];
-			m_ui32BufferedBits >>= i32Size;
-			m_ui32TotalBitsBuffered -= static_cast<uint32_t>(i32Size);
-			return _hHuffman.ui16Values[i32B];
-		}
-
-
-		// Not resolved by the fast table.
-		uint16_t ui16K = ReverseBits( static_cast<uint16_t>(m_ui32BufferedBits), 16 );
-		uint32_t I;
-		for ( I = LSC_FAST_BITS; ; ++I ) {
-			if ( ui16K < _hHuffman.i32MaxCode[I] ) { break; }
+	uint32_t LSE_CALL CZLib::SymbolEntry( LSC_TABLE_KIND _tkKind, uint32_t _ui32Symbol ) {
+		switch ( _tkKind ) {
+			case LSC_TK_LITLEN : {
+				if ( _ui32Symbol < 256 ) { return LSC_TE_LITERAL | (_ui32Symbol << LSC_TE_VALUE_SHIFT); }
+				if ( _ui32Symbol == 256 ) { return LSC_TE_END; }
+				_ui32Symbol -= 257;
+				if ( _ui32Symbol >= LSE_ELEMENTS( m_ui16LenBase ) ) { return LSC_TE_INVALID; }
+				return (static_cast<uint32_t>(m_ui16LenBase[_ui32Symbol]) << LSC_TE_VALUE_SHIFT) |
+					(static_cast<uint32_t>(m_ui8LenExtra[_ui32Symbol]) << LSC_TE_EXTRA_SHIFT);
+			}
+			case LSC_TK_DIST : {
+				if ( _ui32Symbol >= LSE_ELEMENTS( m_ui16DistBase ) ) { return LSC_TE_INVALID; }
+				return (static_cast<uint32_t>(m_ui16DistBase[_ui32Symbol]) << LSC_TE_VALUE_SHIFT) |
+					(static_cast<uint32_t>(m_ui8DistExtra[_ui32Symbol]) << LSC_TE_EXTRA_SHIFT);
+			}
+			default : {
+				return _ui32Symbol << LSC_TE_VALUE_SHIFT;
+			}
 		}
-
-		if ( I == 16 ) { return -1; }
-
-		i32B = (ui16K >> (16 - I)) - _hHuffman.ui16FirstCode[I] + _hHuffman.ui16FirstSymbol[I];
-		if ( _hHuffman.ui8Size[i32B] != I ) { return -1; }
-
-		m_ui32BufferedBits >>= I;
-		m_ui32TotalBitsBuffered -= I;
-		return _hHuffman.ui16Values[i32B];
 	}
 
 	/**
-	 * Parse a Huffman block.
+	 * Parse a Huffman block using the current tables.
 	 *
-	 * \param _ebsStream The stream.
-	 * \param _zbOut The output.
 	 * \return Returns true if the Huffman block is valid.
 	 */
-	LSBOOL LSE_CALL CZLib::ParseHuffmanBlock( const CExternalByteStream &_ebsStream, LSC_ZLIB_BUFFER &_zbOut ) {
-		static const int32_t i32LenBase[31] = {
-			3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258, 0, 0
-		};
-
-		static const int32_t i32LenExtra[31] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0, 0, 0 };
-
-		static const uint32_t ui32DistBase[32] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 
-			257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577, 0, 0 };
-
-		static const uint32_t ui32DistExtra[32] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
-
-
+	LSBOOL LSE_CALL CZLib::ParseHuffmanBlock() {
+		const uint32_t * pui32LitLen = m_ui32LitLen;
+		const uint32_t * pui32Dist = m_ui32Dist;
 		for ( ; ; ) {
-			int32_t i32Z = DecodeHuffman( _ebsStream, m_hLength );
-			if ( i32Z < 0 ) { return false; }
-			if ( i32Z < 256 ) {
-				// Add the code to the output.
-				if ( !_zbOut.Push( static_cast<uint8_t>(i32Z) ) ) { return false; }
-			}
-			else {
-				// Repeat some part of the previous output.
-				if ( i32Z == 256 ) { return true; }
-				i32Z -= 257;
-				if ( i32Z >= LSE_ELEMENTS( i32LenBase ) ) { return false; }
-				int32_t i32Len = i32LenBase[i32Z];
-
-
-				uint32_t ui32Temp;
-				if ( i32LenExtra[i32Z] ) {
-					if ( !Receive( _ebsStream, static_cast<uint32_t>(i32LenExtra[i32Z]), ui32Temp ) ) { return false; }
-					i32Len += ui32Temp;
+			// Always leave room for a whole match, so that the slow path below never needs to check either.
+			if ( !Reserve( LSC_FAST_OUT ) ) { return false; }
+			uint8_t * pui8Base = &(*m_pzbOut)[0];
+			uint8_t * pui8Out = pui8Base + m_ui32OutPos;
+			const uint8_t * pui8OutFastEnd = pui8Base + m_pzbOut->Length() - LSC_FAST_OUT;
+
+			// The fast loop.  A single fill covers a whole length/distance pair (at most 15 + 5 + 15 + 13 bits), and
+			//	matches are copied 8 bytes at a time, possibly writing up to 7 bytes past their ends.
+			while ( pui8Out <= pui8OutFastEnd && m_pui8InEnd - m_pui8In >= LSC_FAST_IN ) {
+				FillBitsFast();
+				uint32_t ui32Entry = pui32LitLen[m_ui64BufferedBits&((1<<LSC_LITLEN_BITS)-1)];
+				if ( ui32Entry & LSC_TE_SUBTABLE ) {
+					m_ui64BufferedBits >>= LSC_LITLEN_BITS;
+					m_ui32TotalBitsBuffered -= LSC_LITLEN_BITS;
+					ui32Entry = pui32LitLen[(ui32Entry>>LSC_TE_VALUE_SHIFT)+
+						(m_ui64BufferedBits&((1U<<((ui32Entry>>LSC_TE_EXTRA_SHIFT)&LSC_TE_EXTRA_MASK))-1))];
 				}
-				i32Z = DecodeHuffman( _ebsStream, m_hDistance );
-				if ( i32Z < 0 || i32Z >= LSE_ELEMENTS( ui32DistBase ) ) { return false; }
-
-
-				uint32_t ui32Dist = ui32DistBase[i32Z];
-				if ( ui32DistExtra[i32Z] ) {
-					if ( !Receive( _ebsStream, ui32DistExtra[i32Z], ui32Temp ) ) { return false; }
-					ui32Dist += ui32Temp;
+				m_ui64BufferedBits >>= ui32Entry & LSC_TE_BITS_MASK;
+				m_ui32TotalBitsBuffered -= ui32Entry & LSC_TE_BITS_MASK;
+				if ( ui32Entry & LSC_TE_LITERAL ) {
+					(*pui8Out++) = static_cast<uint8_t>(ui32Entry >> LSC_TE_VALUE_SHIFT);
+					// At least 41 bits remain, enough for another literal.
+					ui32Entry = pui32LitLen[m_ui64BufferedBits&((1<<LSC_LITLEN_BITS)-1)];
+					if ( ui32Entry & LSC_TE_LITERAL ) {
+						m_ui64BufferedBits >>= ui32Entry & LSC_TE_BITS_MASK;
+						m_ui32TotalBitsBuffered -= ui32Entry & LSC_TE_BITS_MASK;
+						(*pui8Out++) = static_cast<uint8_t>(ui32Entry >> LSC_TE_VALUE_SHIFT);
+					}
+					continue;
+				}
+				if ( ui32Entry & (LSC_TE_END | LSC_TE_INVALID) ) {
+					m_ui32OutPos = static_cast<uint32_t>(pui8Out - pui8Base);
+					return !(ui32Entry & LSC_TE_INVALID);
 				}
 
-				if ( _zbOut.Length() < ui32Dist ) { return false; }
-
-				while ( i32Len-- ) {
-					if ( !_zbOut.Push( _zbOut[_zbOut.Length()-ui32Dist] ) ) { return false; }
+				uint32_t ui32Extra = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+				uint32_t ui32Len = (ui32Entry >> LSC_TE_VALUE_SHIFT) + static_cast<uint32_t>(m_ui64BufferedBits & ((1U << ui32Extra) - 1));
+				m_ui64BufferedBits >>= ui32Extra;
+				m_ui32TotalBitsBuffered -= ui32Extra;
+
+				ui32Entry = pui32Dist[m_ui64BufferedBits&((1<<LSC_DIST_BITS)-1)];
+				if ( ui32Entry & LSC_TE_SUBTABLE ) {
+					m_ui64BufferedBits >>= LSC_DIST_BITS;
+					m_ui32TotalBitsBuffered -= LSC_DIST_BITS;
+					ui32Entry = pui32Dist[(ui32Entry>>LSC_TE_VALUE_SHIFT)+
+						(m_ui64BufferedBits&((1U<<((ui32Entry>>LSC_TE_EXTRA_SHIFT)&LSC_TE_EXTRA_MASK))-1))];
+				}
+				if ( ui32Entry & LSC_TE_INVALID ) { return false; }
+				m_ui64BufferedBits >>= ui32Entry & LSC_TE_BITS_MASK;
+				m_ui32TotalBitsBuffered -= ui32Entry & LSC_TE_BITS_MASK;
+				ui32Extra = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+				uint32_t ui32Dist = (ui32Entry >> LSC_TE_VALUE_SHIFT) + static_cast<uint32_t>(m_ui64BufferedBits & ((1U << ui32Extra) - 1));
+				m_ui64BufferedBits >>= ui32Extra;
+				m_ui32TotalBitsBuffered -= ui32Extra;
+				if ( static_cast<uintptr_t>(pui8Out - pui8Base) < ui32Dist ) { return false; }
+
+				uint8_t * pui8Dst = pui8Out;
+				const uint8_t * pui8Src = pui8Out - ui32Dist;
+				pui8Out += ui32Len;
+				if ( ui32Dist >= 8 ) {
+					// Each 8-byte read is of bytes already written, even when the match overlaps itself.
+					do {
+						Copy8( pui8Dst, pui8Src );
+						pui8Dst += 8;
+						pui8Src += 8;
+					} while ( pui8Dst < pui8Out );
 				}
+				else if ( ui32Dist == 1 ) {
+					uint8_t ui8Val = (*pui8Src);
+					do {
+						for ( uint32_t I = 0; I < 8; ++I ) {
+							pui8Dst[I] = ui8Val;
+						}
+						pui8Dst += 8;
+					} while ( pui8Dst < pui8Out );
+				}
+				else {
+					while ( pui8Dst < pui8Out ) {
+						(*pui8Dst++) = (*pui8Src++);
+					}
+				}
+			}
+			m_ui32OutPos = static_cast<uint32_t>(pui8Out - pui8Base);
+			// Out of room for the fast loop; grow the output and try again.
+			if ( pui8Out > pui8OutFastEnd ) { continue; }
+
+			// The slow path near the end of the input: one symbol, filling a byte at a time.
+			FillBits();
+			uint32_t ui32Entry = pui32LitLen[m_ui64BufferedBits&((1<<LSC_LITLEN_BITS)-1)];
+			if ( ui32Entry & LSC_TE_SUBTABLE ) {
+				m_ui64BufferedBits >>= LSC_LITLEN_BITS;
+				m_ui32TotalBitsBuffered -= LSC_LITLEN_BITS;
+				ui32Entry = pui32LitLen[(ui32Entry>>LSC_TE_VALUE_SHIFT)+
+					(m_ui64BufferedBits&((1U<<((ui32Entry>>LSC_TE_EXTRA_SHIFT)&LSC_TE_EXTRA_MASK))-1))];
+			}
+			m_ui64BufferedBits >>= ui32Entry & LSC_TE_BITS_MASK;
+			m_ui32TotalBitsBuffered -= ui32Entry & LSC_TE_BITS_MASK;
+			if ( Truncated() || (ui32Entry & LSC_TE_INVALID) ) { return false; }
+			if ( ui32Entry & LSC_TE_LITERAL ) {
+				pui8Base[m_ui32OutPos++] = static_cast<uint8_t>(ui32Entry >> LSC_TE_VALUE_SHIFT);
+				continue;
+			}
+			if ( ui32Entry & LSC_TE_END ) { return true; }
+
+			uint32_t ui32Extra = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+			uint32_t ui32Len = (ui32Entry >> LSC_TE_VALUE_SHIFT) + static_cast<uint32_t>(m_ui64BufferedBits & ((1U << ui32Extra) - 1));
+			m_ui64BufferedBits >>= ui32Extra;
+			m_ui32TotalBitsBuffered -= ui32Extra;
+
+			ui32Entry = pui32Dist[m_ui64BufferedBits&((1<<LSC_DIST_BITS)-1)];
+			if ( ui32Entry & LSC_TE_SUBTABLE ) {
+				m_ui64BufferedBits >>= LSC_DIST_BITS;
+				m_ui32TotalBitsBuffered -= LSC_DIST_BITS;
+				ui32Entry = pui32Dist[(ui32Entry>>LSC_TE_VALUE_SHIFT)+
+					(m_ui64BufferedBits&((1U<<((ui32Entry>>LSC_TE_EXTRA_SHIFT)&LSC_TE_EXTRA_MASK))-1))];
+			}
+			if ( ui32Entry & LSC_TE_INVALID ) { return false; }
+			m_ui64BufferedBits >>= ui32Entry & LSC_TE_BITS_MASK;
+			m_ui32TotalBitsBuffered -= ui32Entry & LSC_TE_BITS_MASK;
+			ui32Extra = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+			uint32_t ui32Dist = (ui32Entry >> LSC_TE_VALUE_SHIFT) + static_cast<uint32_t>(m_ui64BufferedBits & ((1U << ui32Extra) - 1));
+			m_ui64BufferedBits >>= ui32Extra;
+			m_ui32TotalBitsBuffered -= ui32Extra;
+			if ( Truncated() || m_ui32OutPos < ui32Dist ) { return false; }
+			for ( uint32_t I = 0; I < ui32Len; ++I, ++m_ui32OutPos ) {
+				pui8Base[m_ui32OutPos] = pui8Base[m_ui32OutPos-ui32Dist];
 			}
 		}
 	}
@@ -347,69 +536,58 @@ namespace lsc {
 	/**
 	 * Parse and uncompressed block.
 	 *
-	 * \param _ebsStream The stream.
-	 * \param _zbOut The output.
-	 * \return Returns true if the Huffman block is valid.
+	 * \return Returns true if the block is valid.
 	 */
-	LSBOOL LSE_CALL CZLib::ParseUncompressed( const CExternalByteStream &_ebsStream, LSC_ZLIB_BUFFER &_zbOut ) {
-		if ( m_ui32TotalBitsBuffered & 7 ) {
-			// Discard some bits.  Moves the input to the next byte boundary.
-			uint32_t ui32Temp;
-			if ( !Receive( _ebsStream, m_ui32TotalBitsBuffered & 7, ui32Temp ) ) { return false; }
-		}
-
-		uint32_t ui32K = 0;
-		uint8_t ui8Header[4];
-		// Start the header with any remaining bits in the buffer.
-		while ( m_ui32TotalBitsBuffered ) {
-			ui8Header[ui32K++] = static_cast<uint8_t>(m_ui32BufferedBits & 0xFF);
-			m_ui32TotalBitsBuffered -= 8;
-			m_ui32BufferedBits >>= 8;
-		}
-
-
-		// Fill the rest of the header with data from the stream.
-		while ( ui32K < 4 ) {
-			if ( !ReadUi8( _ebsStream, ui8Header[ui32K++] ) ) { return false; }
-		}
-
-		uint32_t ui32Len = ui8Header[1] * 256 + ui8Header[0];
-		uint32_t ui32LenN = ui8Header[3] * 256 + ui8Header[2];
-		if ( ui32LenN != (ui32Len & 0xFFFFUL) ) { return false; }
-		// Copy from the current position of the input buffer.
-		uint32_t ui32End = _zbOut.Length();
-		if ( !_zbOut.ResizeOver( ui32End + ui32Len ) ) { return false; }
-		return _ebsStream.ReadBytes( &_zbOut[ui32End], ui32Len ) != 0;
+	LSBOOL LSE_CALL CZLib::ParseUncompressed() {
+		// Discard some bits.  Moves the input to the next byte boundary.
+		uint32_t ui32Temp;
+		if ( !Receive( m_ui32TotalBitsBuffered & 7, ui32Temp ) ) { return false; }
+
+		uint32_t ui32Len, ui32LenN;
+		if ( !Receive( 16, ui32Len ) || !Receive( 16, ui32LenN ) ) { return false; }
+		if ( ui32LenN != (ui32Len ^ 0xFFFFUL) ) { return false; }
+
+		// Return the whole bytes still in the bit buffer to the input and copy straight from the input.
+		m_pui8In -= (m_ui32TotalBitsBuffered >> 3) - m_ui32Overrun;
+		m_ui64BufferedBits = 0;
+		m_ui32TotalBitsBuffered = 0;
+		m_ui32Overrun = 0;
+		if ( static_cast<uintptr_t>(m_pui8InEnd - m_pui8In) < ui32Len ) { return false; }
+		if ( !ui32Len ) { return true; }
+		if ( !Reserve( ui32Len ) ) { return false; }
+		CStd::MemCpy( &(*m_pzbOut)[m_ui32OutPos], m_pui8In, ui32Len );
+		m_pui8In += ui32Len;
+		m_ui32OutPos += ui32Len;
+		return true;
 	}
 
 	/**
-	 * Check the ZLib header.
+	 * Makes room in the output for at least the given number of bytes past m_ui32OutPos.
 	 *
-	 * \param _ebsStream The stream containing the ZLib-compressed buffer.
-	 * \return Returns true if the header is valid.
+	 * \param _ui32Bytes The number of bytes to be written.
+	 * \return Returns false if there is not enough memory.
 	 */
-	LSBOOL LSE_CALL CZLib::CheckHeader( const CExternalByteStream &_ebsStream ) {
-		uint8_t ui8CmF;
-		if ( !ReadUi8( _ebsStream, ui8CmF ) ) { return false; }
-		uint8_t ui8Cm = ui8CmF & 0xF;
-
-		uint8_t ui8Flag;
-		if ( !ReadUi8( _ebsStream, ui8Flag ) ) { return false; }
-		if ( (ui8CmF * 256 + ui8Flag) % 31 != 0 ) { return false; }
-		if ( ui8Flag & 32 ) { return false; }
-		if ( ui8Cm != 8 ) { return false; }
-		return true;
+	LSBOOL LSE_CALL CZLib::Reserve( uint32_t _ui32Bytes ) {
+		uint64_t ui64Need = static_cast<uint64_t>(m_ui32OutPos) + _ui32Bytes;
+		if ( ui64Need <= m_pzbOut->Length() ) { return true; }
+		if ( ui64Need > 0xFFFFFFFFULL ) { return false; }
+		// The buffer grows linearly on its own; double it instead.
+		uint64_t ui64New = CStd::Max<uint64_t>( ui64Need, static_cast<uint64_t>(m_pzbOut->Length()) * 2 );
+		return m_pzbOut->ResizeUninitialized( static_cast<uint32_t>(CStd::Min<uint64_t>( ui64New, 0xFFFFFFFFULL )) );
 	}
 
 	/**
-	 * Reads a single 8-bit value from the given stream.
+	 * Check the ZLib header.
 	 *
-	 * \param _ebsStream The stream from which to read an 8-bit value.
-	 * \param _ui8Dst Destination for the read value.
-	 * \return Returns true if the value was read from the stream.
+	 * \return Returns true if the header is valid.
 	 */
-	LSBOOL LSE_CALL CZLib::ReadUi8( const CExternalByteStream &_ebsStream, uint8_t &_ui8Dst ) {
-		return _ebsStream.ReadBytes( reinterpret_cast<uint8_t *>(&_ui8Dst), sizeof( _ui8Dst ) ) != 0;
+	LSBOOL LSE_CALL CZLib::CheckHeader() {
+		uint32_t ui32CmF, ui32Flag;
+		if ( !Receive( 8, ui32CmF ) || !Receive( 8, ui32Flag ) ) { return false; }
+		if ( (ui32CmF * 256 + ui32Flag) % 31 != 0 ) { return false; }
+		if ( ui32Flag & 32 ) { return false; }
+		if ( (ui32CmF & 0xF) != 8 ) { return false; }
+		return true;
 	}
 
 	/**
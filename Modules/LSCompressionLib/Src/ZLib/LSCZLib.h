@@ -10,7 +10,7 @@
  *
  *
  * Description: A primitive and light-weight implementation of a zlib inflation routine.  This class cannot
- *	be used to compress/deflate data.
+ *	be used to compress/deflate data; use CZLibEncoder for that.
  */
 
 
@@ -19,7 +19,6 @@
 
 #include "../LSCCompressionLib.h"
 #include "../BitStream/LSCBitStream.h"
-#include "Streams/LSSTDExternalByteStream.h"
 #include "Vector/LSTLVectorPoD.h"
 
 namespace lsc {
@@ -29,7 +28,7 @@ namespace lsc {
 	 * \brief A primitive and light-weight implementation of a zlib inflation routine.
 	 *
 	 * Description: A primitive and light-weight implementation of a zlib inflation routine.  This class cannot
-	 *	be used to compress/deflate data.
+	 *	be used to compress/deflate data; use CZLibEncoder for that.
 	 */
 	class CZLib {
 	public :
@@ -57,74 +56,106 @@ namespace lsc {
 		LSBOOL LSE_CALL					DecodeZLib( const uint8_t * _pui8Buffer, uintptr_t _uiptrLen,
 			LSBOOL _bSkipHeaders, LSC_ZLIB_BUFFER &_zbOut );
 
+		/**
+		 * Calculates or continues an Adler-32 checksum, as used by zlib streams.
+		 *
+		 * \param _pui8Data The data for which to calculate the checksum.
+		 * \param _uiptrLen Length of the data.
+		 * \param _ui32Adler The checksum of the data preceding _pui8Data, or 1 to start a new checksum.
+		 * \return Returns the Adler-32 checksum.
+		 */
+		static uint32_t LSE_CALL		Adler32( const uint8_t * _pui8Data, uintptr_t _uiptrLen, uint32_t _ui32Adler = 1 );
+
 
 	protected :
 		// == Enumerations.
 		/**
-		 * Huffman metrics.
+		 * Table metrics.  The "enough" sizes are the largest the tables can be for any valid set of code lengths
+		 *	given the root-table sizes (computed with zlib's examples/enough.c).
 		 */
 		enum {
-			LSC_FAST_BITS				= 9,
-			LSC_MASK					= (1 << LSC_FAST_BITS) - 1,
+			LSC_LITLEN_BITS				= 10,
+			LSC_LITLEN_ENOUGH			= 1334,
+			LSC_DIST_BITS				= 8,
+			LSC_DIST_ENOUGH				= 402,
+			LSC_CL_BITS					= 7,
+			LSC_CL_ENOUGH				= 128,
+			LSC_MAX_CODE_BITS			= 15,
+			LSC_FAST_IN					= 8,					/**< Input bytes needed to stay in the fast loop. */
+			LSC_FAST_OUT				= 258 + 8,				/**< Output room needed to stay in the fast loop. */
 		};
 
+		/**
+		 * Table entries.  Bits 0-4 are the number of bits to consume, bits 8-11 the number of extra bits (or the
+		 *	bits indexing a subtable), bits 12-15 flags, and bits 16-31 the literal, base length, base distance or
+		 *	subtable offset.
+		 */
+		enum LSC_TABLE_ENTRY {
+			LSC_TE_BITS_MASK			= 0x1F,
+			LSC_TE_EXTRA_SHIFT			= 8,
+			LSC_TE_EXTRA_MASK			= 0xF,
+			LSC_TE_END					= (1 << 12),
+			LSC_TE_SUBTABLE				= (1 << 13),
+			LSC_TE_LITERAL				= (1 << 14),
+			LSC_TE_INVALID				= (1 << 15),
+			LSC_TE_VALUE_SHIFT			= 16,
+		};
 
-		// == Types.
 		/**
-		 * Huffman table.
+		 * Kinds of tables.
 		 */
-		typedef struct LSC_HUFFMAN {
-			/**
-			 * Max codes.
-			 */
-			int32_t						i32MaxCode[17];
+		enum LSC_TABLE_KIND {
+			LSC_TK_LITLEN,
+			LSC_TK_DIST,
+			LSC_TK_CODE_LENGTH,
+		};
 
-			/**
-			 * Fast data.
-			 */
-			uint16_t					ui16Fast[1<<LSC_FAST_BITS];
 
-			/**
-			 * First code.
-			 */
-			uint16_t					ui16FirstCode[16];
+		// == Members.
+		/**
+		 * Buffered bits.  Bits above m_ui32TotalBitsBuffered are either 0 or the next bits of the input.
+		 */
+		uint64_t						m_ui64BufferedBits;
 
-			/**
-			 * First symbol.
-			 */
-			uint16_t					ui16FirstSymbol[16];
+		/**
+		 * Total bits buffered.
+		 */
+		uint32_t						m_ui32TotalBitsBuffered;
 
-			/**
-			 * Values.
-			 */
-			uint16_t					ui16Values[288];
+		/**
+		 * Number of 0 bytes buffered after the end of the input.
+		 */
+		uint32_t						m_ui32Overrun;
 
-			/**
-			 * Sizes.
-			 */
-			uint8_t						ui8Size[288];
-		} * LPLSC_HUFFMAN, * const LPCLSC_HUFFMAN;
+		/**
+		 * The next input byte.
+		 */
+		const uint8_t *					m_pui8In;
 
-		// == Members.
 		/**
-		 * Buffered bits.
+		 * The end of the input.
 		 */
-		uint32_t						m_ui32BufferedBits;
+		const uint8_t *					m_pui8InEnd;
 
 		/**
-		 * Total bits buffered.
+		 * The output buffer.
 		 */
-		uint32_t						m_ui32TotalBitsBuffered;
+		LSC_ZLIB_BUFFER *				m_pzbOut;
 
 		/**
-		 * Length Huffman buffer.
+		 * Number of bytes written to the output buffer.  The buffer may be longer.
 		 */
-		LSC_HUFFMAN						m_hLength;
+		uint32_t						m_ui32OutPos;
 
 		/**
-		 * Distance Huffman buffer.
+		 * Literal/length decoding table.
 		 */
-		LSC_HUFFMAN						m_hDistance;
+		uint32_t						m_ui32LitLen[LSC_LITLEN_ENOUGH];
+
+		/**
+		 * Distance decoding table.
+		 */
+		uint32_t						m_ui32Dist[LSC_DIST_ENOUGH];
 
 		/**
 		 * Default lengths.
@@ -141,98 +172,131 @@ namespace lsc {
 		 */
 		static CCriticalSection			m_scCrit;
 
+		/**
+		 * Base length for each length code.
+		 */
+		static const uint16_t			m_ui16LenBase[29];
+
+		/**
+		 * Length extra bits for each length code.
+		 */
+		static const uint8_t			m_ui8LenExtra[29];
+
+		/**
+		 * Base distance for each distance code.
+		 */
+		static const uint16_t			m_ui16DistBase[30];
+
+		/**
+		 * Distance extra bits for each distance code.
+		 */
+		static const uint8_t			m_ui8DistExtra[30];
+
 
 		// == Functions.
 		/**
-		 * Fill our bit buffer.
+		 * Fill our bit buffer, one byte at a time.  Past the end of the input, 0 bytes are buffered and counted in
+		 *	m_ui32Overrun; Truncated() reports whether any of them have been consumed.
+		 */
+		void LSE_CALL					FillBits();
+
+		/**
+		 * Fills the bit buffer with a single 8-byte read.  At least LSC_FAST_IN bytes of input must remain.
+		 */
+		LSE_INLINE void LSE_CALL		FillBitsFast();
+
+		/**
+		 * Have bits past the end of the input been consumed?
 		 *
-		 * \param _ebsStream The stream from which to take bits.
-		 * \return Returns false if the stream runs out of bits.
+		 * \return Returns true if the input was too short.
 		 */
-		LSBOOL LSE_CALL					FillBits( const CExternalByteStream &_ebsStream );
+		LSE_INLINE LSBOOL LSE_CALL		Truncated() const;
 
 		/**
 		 * Read X number of bits.
 		 *
-		 * \param _ebsStream The stream from which to take bits.
-		 * \param _ui32Total The number of bits to read.
+		 * \param _ui32Total The number of bits to read, at most 32.
 		 * \param _ui32Return Holds the returned value.
 		 * \return Returns true if all bits were read.
 		 */
-		LSBOOL LSE_CALL					Receive( const CExternalByteStream &_ebsStream, uint32_t _ui32Total, uint32_t &_ui32Return );
+		LSBOOL LSE_CALL					Receive( uint32_t _ui32Total, uint32_t &_ui32Return );
 
 		/**
-		 * Computes the Huffman codes.
+		 * Reads the code lengths of a dynamic-Huffman block and builds its tables.
 		 *
-		 * \param _ebsStream The stream.
 		 * \return Returns false if the stream is not formatted properly.
 		 */
-		LSBOOL LSE_CALL					ComputeHuffmanCodes( const CExternalByteStream &_ebsStream );
+		LSBOOL LSE_CALL					ComputeHuffmanCodes();
 
 		/**
-		 * Builds Huffman codes.
+		 * Builds a decoding table from code lengths.  Codes up to _ui32RootBits long are decoded with a single
+		 *	lookup; longer codes go through a second-level table.
 		 *
-		 * \param _hHuffman The target Huffman buffer.
-		 * \param _pui8Codes Litst of codes.
-		 * \param _ui32Total Length of the list of codes.
-		 * \return Returns false if the stream is not formatted properly.
+		 * \param _pui8Codes List of code lengths.
+		 * \param _ui32Total Length of the list of code lengths.
+		 * \param _tkKind The kind of table, which determines what each symbol decodes to.
+		 * \param _ui32RootBits Bits indexing the root table.
+		 * \param _pui32Table The table to build.
+		 * \param _ui32TableSize Number of entries in _pui32Table.
+		 * \return Returns false if the code lengths are over-subscribed or the table is too small.
 		 */
-		LSBOOL LSE_CALL					BuildHuffman( LSC_HUFFMAN &_hHuffman,
-			const uint8_t * _pui8Codes, uint32_t _ui32Total );
+		static LSBOOL LSE_CALL			BuildTable( const uint8_t * _pui8Codes, uint32_t _ui32Total, LSC_TABLE_KIND _tkKind,
+			uint32_t _ui32RootBits, uint32_t * _pui32Table, uint32_t _ui32TableSize );
 
 		/**
-		 * Decode a Huffman buffer.
+		 * Gets the table entry for a symbol, not including the number of bits to consume.
 		 *
-		 * \param _ebsStream The stream.
-		 * \param _hHuffman The Huffman buffer.
-		 * \return Returns the next code or -1 on error.
+		 * \param _tkKind The kind of table.
+		 * \param _ui32Symbol The symbol.
+		 * \return Returns the table entry for the symbol.
 		 */
-		int32_t LSE_CALL				DecodeHuffman( const CExternalByteStream &_ebsStream, LSC_HUFFMAN &_hHuffman );
+		static uint32_t LSE_CALL		SymbolEntry( LSC_TABLE_KIND _tkKind, uint32_t _ui32Symbol );
 
 		/**
-		 * Parse a Huffman block.
+		 * Parse a Huffman block using the current tables.
 		 *
-		 * \param _ebsStream The stream.
-		 * \param _zbOut The output.
 		 * \return Returns true if the Huffman block is valid.
 		 */
-		LSBOOL LSE_CALL					ParseHuffmanBlock( const CExternalByteStream &_ebsStream, LSC_ZLIB_BUFFER &_zbOut );
+		LSBOOL LSE_CALL					ParseHuffmanBlock();
 
 		/**
 		 * Parse and uncompressed block.
 		 *
-		 * \param _ebsStream The stream.
-		 * \param _zbOut The output.
-		 * \return Returns true if the Huffman block is valid.
+		 * \return Returns true if the block is valid.
 		 */
-		LSBOOL LSE_CALL					ParseUncompressed( const CExternalByteStream &_ebsStream, LSC_ZLIB_BUFFER &_zbOut );
+		LSBOOL LSE_CALL					ParseUncompressed();
+
+		/**
+		 * Makes room in the output for at least the given number of bytes past m_ui32OutPos.
+		 *
+		 * \param _ui32Bytes The number of bytes to be written.
+		 * \return Returns false if there is not enough memory.
+		 */
+		LSBOOL LSE_CALL					Reserve( uint32_t _ui32Bytes );
 
 		/**
 		 * Check the ZLib header.
 		 *
-		 * \param _ebsStream The stream containing the ZLib-compressed buffer.
 		 * \return Returns true if the header is valid.
 		 */
-		static LSBOOL LSE_CALL			CheckHeader( const CExternalByteStream &_ebsStream );
+		LSBOOL LSE_CALL					CheckHeader();
 
 		/**
-		 * Reads a single 8-bit value from the given stream.
+		 * Reads 8 bytes as a little-endian 64-bit value.
 		 *
-		 * \param _ebsStream The stream from which to read an 8-bit value.
-		 * \param _ui8Dst Destination for the read value.
-		 * \return Returns true if the value was read from the stream.
+		 * \param _pui8Src The bytes to read.
+		 * \return Returns the 8 bytes as a little-endian value.
 		 */
-		static LSBOOL LSE_CALL			ReadUi8( const CExternalByteStream &_ebsStream, uint8_t &_ui8Dst );
+		static LSE_INLINE uint64_t LSE_CALL
+										Load64( const uint8_t * _pui8Src );
 
 		/**
-		 * Reverse bits and shift off some.  The reverse is assumed to be on a 16-bit value.
+		 * Copies 8 bytes.  The source is read fully before the destination is written.
 		 *
-		 * \param _ui16ReverseMe The value to reverse.
-		 * \param _ui32Shift The number of bits to keep from the reversed value.
-		 * \return Returns the 16-bit reverse and shift of the given value.
+		 * \param _pui8Dst The destination.
+		 * \param _pui8Src The source.
 		 */
-		static LSE_INLINE uint16_t LSE_CALL
-										ReverseBits( uint16_t _ui16ReverseMe, uint32_t _ui32Shift );
+		static LSE_INLINE void LSE_CALL	Copy8( uint8_t * _pui8Dst, const uint8_t * _pui8Src );
 
 		/**
 		 * Apply default sizes and distances.
@@ -246,15 +310,50 @@ namespace lsc {
 	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 	// == Functions.
 	/**
-	 * Reverse bits and shift off some.  The reverse is assumed to be on a 16-bit value.
+	 * Fills the bit buffer with a single 8-byte read.  At least LSC_FAST_IN bytes of input must remain.
+	 */
+	LSE_INLINE void LSE_CALL CZLib::FillBitsFast() {
+		m_ui64BufferedBits |= Load64( m_pui8In ) << m_ui32TotalBitsBuffered;
+		// Only whole bytes are counted; the rest of the last byte read is loaded again by the next fill.
+		m_pui8In += (63 - m_ui32TotalBitsBuffered) >> 3;
+		m_ui32TotalBitsBuffered |= 56;
+	}
+
+	/**
+	 * Have bits past the end of the input been consumed?
+	 *
+	 * \return Returns true if the input was too short.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CZLib::Truncated() const {
+		return (m_ui32Overrun << 3) > m_ui32TotalBitsBuffered;
+	}
+
+	/**
+	 * Reads 8 bytes as a little-endian 64-bit value.
+	 *
+	 * \param _pui8Src The bytes to read.
+	 * \return Returns the 8 bytes as a little-endian value.
+	 */
+	LSE_INLINE uint64_t LSE_CALL CZLib::Load64( const uint8_t * _pui8Src ) {
+		// Compilers turn this into a single unaligned load on little-endian machines.
+		return static_cast<uint64_t>(_pui8Src[0]) | (static_cast<uint64_t>(_pui8Src[1]) << 8) |
+			(static_cast<uint64_t>(_pui8Src[2]) << 16) | (static_cast<uint64_t>(_pui8Src[3]) << 24) |
+			(static_cast<uint64_t>(_pui8Src[4]) << 32) | (static_cast<uint64_t>(_pui8Src[5]) << 40) |
+			(static_cast<uint64_t>(_pui8Src[6]) << 48) | (static_cast<uint64_t>(_pui8Src[7]) << 56);
+	}
+
+	/**
+	 * Copies 8 bytes.  The source is read fully before the destination is written.
 	 *
-	 * \param _ui16ReverseMe The value to reverse.
-	 * \param _ui32Shift The number of bits to keep from the reversed value.
-	 * \return Returns the 16-bit reverse and shift of the given value.
+	 * \param _pui8Dst The destination.
+	 * \param _pui8Src The source.
 	 */
-	 LSE_INLINE uint16_t LSE_CALL CZLib::ReverseBits( uint16_t _ui16ReverseMe, uint32_t _ui32Shift ) {
-		 return static_cast<uint16_t>(CStd::BitSwap16( _ui16ReverseMe ) >> (16 - _ui32Shift));
-	 }
+	LSE_INLINE void LSE_CALL CZLib::Copy8( uint8_t * _pui8Dst, const uint8_t * _pui8Src ) {
+		uint64_t ui64Val = Load64( _pui8Src );
+		for ( uint32_t I = 0; I < 8; ++I ) {
+			_pui8Dst[I] = static_cast<uint8_t>(ui64Val >> (I * 8));
+		}
+	}
 
 }	// namespace lsc
 
@@ -0,0 +1,868 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A deflate encoder producing raw deflate, zlib or gzip streams.  Levels 1-3 use greedy matching,
+ *	levels 4-9 use lazy matching with longer hash chains, and level 0 stores the data.  Blocks are split where the
+ *	statistics of the data change, and each block is written with whichever of the stored, fixed-Huffman or
+ *	dynamic-Huffman encodings is smallest.  The output is decoded by CZLib.
+ */
+
+#include "LSCZLibEncoder.h"
+#include "Crc/LSSTDCrc.h"
+#include "Search/LSSTDSearch.h"
+
+
+namespace lsc {
+
+	/**
+	 * Matching parameters for each level.  The matching parameters are those of zlib.
+	 */
+	const CZLibEncoder::LSC_LEVEL CZLibEncoder::m_lLevels[10] = {
+		//	Good	Lazy	Nice	Chain	Split	Lazy?
+		{	0,		0,		0,		0,		4096,	false },
+		{	4,		4,		8,		4,		16384,	false },
+		{	4,		5,		16,		8,		16384,	false },
+		{	4,		6,		32,		32,		8192,	false },
+		{	4,		4,		16,		16,		4096,	true },
+		{	8,		16,		32,		32,		4096,	true },
+		{	8,		16,		128,	128,	4096,	true },
+		{	8,		32,		128,	256,	4096,	true },
+		{	32,		128,	258,	1024,	4096,	true },
+		{	32,		258,	258,	4096,	4096,	true },
+	};
+
+	/**
+	 * Length extra bits for each length code.
+	 */
+	const uint8_t CZLibEncoder::m_ui8LenExtra[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+	};
+
+	/**
+	 * Base length for each length code.
+	 */
+	const uint16_t CZLibEncoder::m_ui16LenBase[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+	};
+
+	/**
+	 * Distance extra bits for each distance code.
+	 */
+	const uint8_t CZLibEncoder::m_ui8DistExtra[LSC_DIST_CODES] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+	};
+
+	/**
+	 * Base distance for each distance code.
+	 */
+	const uint16_t CZLibEncoder::m_ui16DistBase[LSC_DIST_CODES] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+	};
+
+	/**
+	 * Order in which code-length code lengths are sent.
+	 */
+	const uint8_t CZLibEncoder::m_ui8ClOrder[LSC_CL_CODES] = {
+		16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+	};
+
+	// == Various constructors.
+	LSE_CALLCTOR CZLibEncoder::CZLibEncoder() :
+		m_pzbOut( NULL ),
+		m_ui32OutPos( 0 ),
+		m_ui64Bits( 0 ),
+		m_ui32BitCount( 0 ),
+		m_pui32Head( NULL ),
+		m_pui32Prev( NULL ),
+		m_pui32Symbols( NULL ),
+		m_ui32SplitInterval( 0 ),
+		m_ui32Symbols( 0 ),
+		m_ui32ChunkStart( 0 ),
+		m_ui32BlockStart( 0 ),
+		m_ui32ChunkPos( 0 ),
+		m_ui32Consumed( 0 ) {
+		for ( uint32_t I = 0; I < LSE_ELEMENTS( m_ui16LenBase ); ++I ) {
+			for ( uint32_t J = 0; J < (1U << m_ui8LenExtra[I]); ++J ) {
+				m_ui8LenCode[m_ui16LenBase[I]-LSC_MIN_MATCH+J] = static_cast<uint8_t>(I);
+			}
+		}
+		// Code 27 would also cover length 258, which has its own code.
+		m_ui8LenCode[LSC_MAX_MATCH-LSC_MIN_MATCH] = 28;
+
+		for ( uint32_t I = 0; I < LSC_DIST_CODES; ++I ) {
+			uint32_t ui32Base = m_ui16DistBase[I] - 1U;
+			if ( I < 16 ) {
+				for ( uint32_t J = 0; J < (1U << m_ui8DistExtra[I]); ++J ) {
+					m_ui8DistCode[ui32Base+J] = static_cast<uint8_t>(I);
+				}
+			}
+			else {
+				for ( uint32_t J = 0; J < (1U << (m_ui8DistExtra[I] - 7)); ++J ) {
+					m_ui8DistCode[256+(ui32Base>>7)+J] = static_cast<uint8_t>(I);
+				}
+			}
+		}
+
+		uint32_t I = 0;
+		for ( ; I <= 143; ++I ) { m_ui8FixedLitLens[I] = 8; }
+		for ( ; I <= 255; ++I ) { m_ui8FixedLitLens[I] = 9; }
+		for ( ; I <= 279; ++I ) { m_ui8FixedLitLens[I] = 7; }
+		for ( ; I < LSC_FIXED_LIT_CODES; ++I ) { m_ui8FixedLitLens[I] = 8; }
+		for ( I = 0; I < LSC_DIST_CODES; ++I ) { m_ui8FixedDistLens[I] = 5; }
+	}
+
+	// == Functions.
+	/**
+	 * Compresses a buffer, appending the stream to _zbOut.
+	 *
+	 * \param _pui8Buffer The data to compress.
+	 * \param _uiptrLen Length of the data to compress.
+	 * \param _ui32Level The compression level from 0 to 9.  Higher levels are clamped to 9.
+	 * \param _zfFormat The format of the stream to write.
+	 * \param _zbOut Holds the returned compressed data.
+	 * \return Returns false if there is not enough memory or the data is too large to be held by _zbOut.
+	 */
+	LSBOOL LSE_CALL CZLibEncoder::Encode( const uint8_t * _pui8Buffer, uintptr_t _uiptrLen,
+		uint32_t _ui32Level, LSC_ZLIB_FORMAT _zfFormat, CZLib::LSC_ZLIB_BUFFER &_zbOut ) {
+		// Positions are 32-bit, and the output could not hold more anyway.
+		if ( static_cast<uint64_t>(_uiptrLen) >= 0xFFFFFFFFULL ) { return false; }
+		uint32_t ui32Len = static_cast<uint32_t>(_uiptrLen);
+		_ui32Level = CStd::Min<uint32_t>( _ui32Level, LSC_ZL_BEST );
+
+		uint32_t ui32Original = _zbOut.Length();
+		m_pzbOut = &_zbOut;
+		m_ui32OutPos = ui32Original;
+		m_ui64Bits = 0;
+		m_ui32BitCount = 0;
+
+		LSBOOL bRet = Reserve( 16 );
+		if ( bRet ) {
+			switch ( _zfFormat ) {
+				case LSC_ZF_ZLIB : {
+					// Deflate with a 32-kilobyte window, and the level in the same 4 groups zlib uses.
+					uint32_t ui32Cmf = 0x78;
+					uint32_t ui32Flg = (_ui32Level < 2 ? 0 : (_ui32Level < 6 ? 1 : (_ui32Level == 6 ? 2 : 3))) << 6;
+					ui32Flg += 31 - ((ui32Cmf * 256 + ui32Flg) % 31);
+					PutBits( ui32Cmf, 8 );
+					PutBits( ui32Flg, 8 );
+					break;
+				}
+				case LSC_ZF_GZIP : {
+					// ID1, ID2, deflate, no flags, no time, extra flags, unknown OS.
+					PutBits( 0x1F, 8 );
+					PutBits( 0x8B, 8 );
+					PutBits( 8, 8 );
+					PutBits( 0, 8 );
+					PutBits( 0, 32 );
+					PutBits( _ui32Level == LSC_ZL_BEST ? 2 : (_ui32Level == LSC_ZL_FASTEST ? 4 : 0), 8 );
+					PutBits( 255, 8 );
+					break;
+				}
+				default : {}
+			}
+			bRet = Deflate( _pui8Buffer, ui32Len, _ui32Level );
+		}
+		if ( bRet ) {
+			bRet = Reserve( 16 );
+		}
+		if ( bRet ) {
+			AlignBits();
+			switch ( _zfFormat ) {
+				case LSC_ZF_ZLIB : {
+					uint32_t ui32Adler = CZLib::Adler32( _pui8Buffer, ui32Len );
+					PutBits( ui32Adler >> 24, 8 );
+					PutBits( (ui32Adler >> 16) & 0xFF, 8 );
+					PutBits( (ui32Adler >> 8) & 0xFF, 8 );
+					PutBits( ui32Adler & 0xFF, 8 );
+					break;
+				}
+				case LSC_ZF_GZIP : {
+					PutBits( CCrc::GetCrc( _pui8Buffer, ui32Len ), 32 );
+					PutBits( ui32Len, 32 );
+					break;
+				}
+				default : {}
+			}
+			AlignBits();
+		}
+
+		// Trim the unused reserve, or on failure remove anything written.
+		_zbOut.ResizeUninitialized( bRet ? m_ui32OutPos : ui32Original );
+		m_pzbOut = NULL;
+		return bRet;
+	}
+
+	/**
+	 * Compresses the data to deflate blocks.
+	 *
+	 * \param _pui8Buffer The data to compress.
+	 * \param _ui32Len Length of the data to compress.
+	 * \param _ui32Level The compression level from 0 to 9.
+	 * \return Returns false if there is not enough memory.
+	 */
+	LSBOOL LSE_CALL CZLibEncoder::Deflate( const uint8_t * _pui8Buffer, uint32_t _ui32Len, uint32_t _ui32Level ) {
+		if ( _ui32Level == LSC_ZL_STORE ) {
+			return WriteStored( _pui8Buffer, _ui32Len, true );
+		}
+
+		if ( !m_vHead.Resize( LSC_HASH_SIZE ) ) { return false; }
+		if ( !m_vPrev.Resize( LSC_WINDOW_SIZE ) ) { return false; }
+		if ( !m_vSymbols.Resize( LSC_MAX_BLOCK_SYMBOLS ) ) { return false; }
+		m_pui32Head = &m_vHead[0];
+		m_pui32Prev = &m_vPrev[0];
+		m_pui32Symbols = &m_vSymbols[0];
+		CStd::MemSet( m_pui32Head, 0xFF, LSC_HASH_SIZE * sizeof( uint32_t ) );
+
+		const LSC_LEVEL & lLevel = m_lLevels[_ui32Level];
+		m_ui32SplitInterval = lLevel.ui32SplitInterval;
+		m_ui32Symbols = m_ui32ChunkStart = 0;
+		m_ui32BlockStart = m_ui32ChunkPos = m_ui32Consumed = 0;
+		CStd::MemSet( &m_fBlock, 0, sizeof( m_fBlock ) );
+		CStd::MemSet( &m_fChunk, 0, sizeof( m_fChunk ) );
+
+		if ( lLevel.bLazy ) {
+			if ( !DeflateLazy( _pui8Buffer, _ui32Len, lLevel ) ) { return false; }
+		}
+		else {
+			if ( !DeflateGreedy( _pui8Buffer, _ui32Len, lLevel ) ) { return false; }
+		}
+		return CheckSplit( _pui8Buffer, true );
+	}
+
+	/**
+	 * Compresses the data with greedy matching.
+	 *
+	 * \param _pui8Buffer The data to compress.
+	 * \param _ui32Len Length of the data to compress.
+	 * \param _lLevel The matching parameters.
+	 * \return Returns false if there is not enough memory.
+	 */
+	LSBOOL LSE_CALL CZLibEncoder::DeflateGreedy( const uint8_t * _pui8Buffer, uint32_t _ui32Len, const LSC_LEVEL &_lLevel ) {
+		// Positions from which a match can start (at least LSC_MIN_MATCH bytes remain) are before this.
+		uint32_t ui32HashEnd = _ui32Len >= LSC_MIN_MATCH ? _ui32Len - (LSC_MIN_MATCH - 1) : 0;
+		uint32_t ui32Pos = 0;
+		while ( ui32Pos < _ui32Len ) {
+			uint32_t ui32MatchLen = 0, ui32Dist = 0;
+			if ( ui32Pos < ui32HashEnd ) {
+				uint32_t ui32Candidate = Insert( _pui8Buffer, ui32Pos );
+				if ( ui32Candidate != LSC_NO_POS ) {
+					ui32MatchLen = LongestMatch( _pui8Buffer, ui32Pos, ui32Candidate, _ui32Len - ui32Pos,
+						LSC_MIN_MATCH - 1, _lLevel.ui32Chain, _lLevel.ui32Nice, ui32Dist );
+				}
+			}
+
+			if ( ui32MatchLen >= LSC_MIN_MATCH ) {
+				AddMatch( ui32MatchLen, ui32Dist );
+				uint32_t ui32End = ui32Pos + ui32MatchLen;
+				// Adding every position of long matches costs more time than it gains.
+				if ( ui32MatchLen <= _lLevel.ui32Lazy ) {
+					uint32_t ui32Stop = CStd::Min( ui32End, ui32HashEnd );
+					while ( ++ui32Pos < ui32Stop ) {
+						Insert( _pui8Buffer, ui32Pos );
+					}
+				}
+				ui32Pos = ui32End;
+			}
+			else {
+				AddLiteral( _pui8Buffer[ui32Pos++] );
+			}
+
+			if ( m_ui32Symbols - m_ui32ChunkStart >= m_ui32SplitInterval ) {
+				if ( !CheckSplit( _pui8Buffer, false ) ) { return false; }
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Compresses the data with lazy matching.
+	 *
+	 * \param _pui8Buffer The data to compress.
+	 * \param _ui32Len Length of the data to compress.
+	 * \param _lLevel The matching parameters.
+	 * \return Returns false if there is not enough memory.
+	 */
+	LSBOOL LSE_CALL CZLibEncoder::DeflateLazy( const uint8_t * _pui8Buffer, uint32_t _ui32Len, const LSC_LEVEL &_lLevel ) {
+		// A 3-byte match this far back costs more than 3 literals.
+		static const uint32_t ui32TooFar = 4096;
+
+		uint32_t ui32HashEnd = _ui32Len >= LSC_MIN_MATCH ? _ui32Len - (LSC_MIN_MATCH - 1) : 0;
+		uint32_t ui32Pos = 0;
+		// The match found at the previous position, which is emitted unless this position has a longer one.
+		uint32_t ui32PrevLen = LSC_MIN_MATCH - 1, ui32PrevDist = 0;
+		// If true, the byte at the previous position has not been emitted.
+		LSBOOL bPending = false;
+		while ( ui32Pos < _ui32Len ) {
+			uint32_t ui32CurLen = LSC_MIN_MATCH - 1, ui32CurDist = 0;
+			if ( ui32Pos < ui32HashEnd ) {
+				uint32_t ui32Candidate = Insert( _pui8Buffer, ui32Pos );
+				if ( ui32Candidate != LSC_NO_POS && ui32PrevLen < _lLevel.ui32Lazy ) {
+					uint32_t ui32Chain = ui32PrevLen >= _lLevel.ui32Good ? (_lLevel.ui32Chain >> 2) : _lLevel.ui32Chain;
+					ui32CurLen = LongestMatch( _pui8Buffer, ui32Pos, ui32Candidate, _ui32Len - ui32Pos,
+						ui32PrevLen, ui32Chain, _lLevel.ui32Nice, ui32CurDist );
+					if ( ui32CurLen == LSC_MIN_MATCH && ui32CurDist > ui32TooFar ) {
+						ui32CurLen = LSC_MIN_MATCH - 1;
+					}
+				}
+			}
+
+			if ( ui32PrevLen >= LSC_MIN_MATCH && ui32CurLen <= ui32PrevLen ) {
+				// The previous position has the better match.
+				AddMatch( ui32PrevLen, ui32PrevDist );
+				uint32_t ui32End = ui32Pos - 1 + ui32PrevLen;
+				uint32_t ui32Stop = CStd::Min( ui32End, ui32HashEnd );
+				while ( ++ui32Pos < ui32Stop ) {
+					Insert( _pui8Buffer, ui32Pos );
+				}
+				ui32Pos = ui32End;
+				ui32PrevLen = LSC_MIN_MATCH - 1;
+				bPending = false;
+			}
+			else {
+				if ( bPending ) {
+					AddLiteral( _pui8Buffer[ui32Pos-1] );
+				}
+				bPending = true;
+				ui32PrevLen = ui32CurLen;
+				ui32PrevDist = ui32CurDist;
+				++ui32Pos;
+			}
+
+			if ( m_ui32Symbols - m_ui32ChunkStart >= m_ui32SplitInterval ) {
+				if ( !CheckSplit( _pui8Buffer, false ) ) { return false; }
+			}
+		}
+		if ( bPending ) {
+			AddLiteral( _pui8Buffer[ui32Pos-1] );
+		}
+		return true;
+	}
+
+	/**
+	 * Finds the longest match for the given position along its hash chain.
+	 *
+	 * \param _pui8Buffer The data being compressed.
+	 * \param _ui32Pos The position for which to find a match.
+	 * \param _ui32Candidate The first position on the hash chain.
+	 * \param _ui32Avail Number of bytes from _ui32Pos to the end of the data.
+	 * \param _ui32Best Only matches longer than this are considered.
+	 * \param _ui32Chain Maximum number of chain entries to check.
+	 * \param _ui32Nice Searching stops on finding a match at least this long.
+	 * \param _ui32Dist Holds the distance of the returned match if it is longer than _ui32Best.
+	 * \return Returns the length of the longest match, or _ui32Best if none is longer.
+	 */
+	uint32_t LSE_CALL CZLibEncoder::LongestMatch( const uint8_t * _pui8Buffer, uint32_t _ui32Pos, uint32_t _ui32Candidate,
+		uint32_t _ui32Avail, uint32_t _ui32Best, uint32_t _ui32Chain, uint32_t _ui32Nice, uint32_t &_ui32Dist ) const {
+		uint32_t ui32Max = CStd::Min<uint32_t>( _ui32Avail, LSC_MAX_MATCH );
+		if ( _ui32Best >= ui32Max ) { return _ui32Best; }
+		_ui32Nice = CStd::Min( _ui32Nice, ui32Max );
+		uint32_t ui32Limit = _ui32Pos > LSC_WINDOW_SIZE ? _ui32Pos - LSC_WINDOW_SIZE : 0;
+		const uint8_t * pui8Cur = _pui8Buffer + _ui32Pos;
+
+		while ( _ui32Candidate >= ui32Limit && _ui32Chain-- ) {
+			const uint8_t * pui8Match = _pui8Buffer + _ui32Candidate;
+			// Check the byte that would make the match longer than the best first; it rejects most candidates.
+			if ( pui8Match[_ui32Best] == pui8Cur[_ui32Best] && pui8Match[0] == pui8Cur[0] && pui8Match[1] == pui8Cur[1] ) {
+				uint32_t ui32Len = 2;
+				while ( ui32Len + 8 <= ui32Max ) {
+					uint64_t ui64Match = 0, ui64Cur = 0;
+					for ( uint32_t I = 0; I < 8; ++I ) {
+						ui64Match |= static_cast<uint64_t>(pui8Match[ui32Len+I]) << (I * 8);
+						ui64Cur |= static_cast<uint64_t>(pui8Cur[ui32Len+I]) << (I * 8);
+					}
+					if ( ui64Match != ui64Cur ) { break; }
+					ui32Len += 8;
+				}
+				while ( ui32Len < ui32Max && pui8Match[ui32Len] == pui8Cur[ui32Len] ) { ++ui32Len; }
+
+				if ( ui32Len > _ui32Best ) {
+					_ui32Best = ui32Len;
+					_ui32Dist = _ui32Pos - _ui32Candidate;
+					if ( ui32Len >= _ui32Nice ) { break; }
+				}
+			}
+
+			// Chains only go backwards.  Anything else is a slot reused by a later position (or LSC_NO_POS).
+			uint32_t ui32Next = m_pui32Prev[_ui32Candidate&LSC_WINDOW_MASK];
+			if ( ui32Next >= _ui32Candidate ) { break; }
+			_ui32Candidate = ui32Next;
+		}
+		return _ui32Best;
+	}
+
+	/**
+	 * Checks whether the symbols gathered since the last check should start a new block, ending the current
+	 *	block if so.  Ends the current block regardless if it is full or _bFinal is true.
+	 *
+	 * \param _pui8Buffer The data being compressed.
+	 * \param _bFinal If true, all input has been consumed and the final block is written.
+	 * \return Returns false if there is not enough memory.
+	 */
+	LSBOOL LSE_CALL CZLibEncoder::CheckSplit( const uint8_t * _pui8Buffer, LSBOOL _bFinal ) {
+		LSC_FREQ fMerged;
+		for ( uint32_t I = 0; I < LSC_LIT_CODES; ++I ) { fMerged.ui32Lit[I] = m_fBlock.ui32Lit[I] + m_fChunk.ui32Lit[I]; }
+		for ( uint32_t I = 0; I < LSC_DIST_CODES; ++I ) { fMerged.ui32Dist[I] = m_fBlock.ui32Dist[I] + m_fChunk.ui32Dist[I]; }
+
+		if ( m_ui32ChunkStart && m_ui32Symbols > m_ui32ChunkStart ) {
+			// Split if the block so far and the new symbols are smaller as separate blocks, each with its own codes.
+			uint64_t ui64Separate = BlockBits( m_fBlock, m_ui32ChunkPos - m_ui32BlockStart ) +
+				BlockBits( m_fChunk, m_ui32Consumed - m_ui32ChunkPos );
+			uint64_t ui64Merged = BlockBits( fMerged, m_ui32Consumed - m_ui32BlockStart );
+			if ( ui64Separate < ui64Merged ) {
+				if ( !WriteBlock( _pui8Buffer, m_ui32ChunkStart, m_ui32ChunkPos, m_fBlock, false ) ) { return false; }
+				fMerged = m_fChunk;
+			}
+		}
+		m_fBlock = fMerged;
+		CStd::MemSet( &m_fChunk, 0, sizeof( m_fChunk ) );
+		m_ui32ChunkStart = m_ui32Symbols;
+		m_ui32ChunkPos = m_ui32Consumed;
+
+		// End the block if another interval of symbols might not fit.
+		if ( _bFinal || m_ui32Symbols > LSC_MAX_BLOCK_SYMBOLS - m_ui32SplitInterval ) {
+			if ( !WriteBlock( _pui8Buffer, m_ui32Symbols, m_ui32Consumed, m_fBlock, _bFinal ) ) { return false; }
+			CStd::MemSet( &m_fBlock, 0, sizeof( m_fBlock ) );
+			m_ui32ChunkStart = 0;
+		}
+		return true;
+	}
+
+	/**
+	 * Writes the first symbols of the current block as a block and removes them.
+	 *
+	 * \param _pui8Buffer The data being compressed.
+	 * \param _ui32Symbols Number of symbols to write.
+	 * \param _ui32End Input position at which the written symbols end.
+	 * \param _fFreq Frequencies of the symbols to write.
+	 * \param _bFinal If true, the block is marked as the last.
+	 * \return Returns false if there is not enough memory.
+	 */
+	LSBOOL LSE_CALL CZLibEncoder::WriteBlock( const uint8_t * _pui8Buffer, uint32_t _ui32Symbols, uint32_t _ui32End,
+		const LSC_FREQ &_fFreq, LSBOOL _bFinal ) {
+		uint32_t ui32Bytes = _ui32End - m_ui32BlockStart;
+		LSC_DYNAMIC_HEADER dhHeader;
+		BuildDynamicHeader( _fFreq, dhHeader );
+		uint64_t ui64Dynamic = dhHeader.ui32Bits + SymbolBits( _fFreq, dhHeader.ui8LitLens, dhHeader.ui8DistLens );
+		uint64_t ui64Fixed = SymbolBits( _fFreq, m_ui8FixedLitLens, m_ui8FixedDistLens );
+		uint64_t ui64Stored = StoredBits( ui32Bytes );
+
+		if ( ui32Bytes && ui64Stored < ui64Dynamic + 3 && ui64Stored < ui64Fixed + 3 ) {
+			if ( !WriteStored( _pui8Buffer + m_ui32BlockStart, ui32Bytes, _bFinal ) ) { return false; }
+		}
+		else {
+			LSBOOL bDynamic = ui64Dynamic < ui64Fixed;
+			uint64_t ui64Bits = 3 + (bDynamic ? ui64Dynamic : ui64Fixed);
+			if ( !Reserve( static_cast<uint32_t>(ui64Bits >> 3) + 8 ) ) { return false; }
+
+			const uint8_t * pui8LitLens = bDynamic ? dhHeader.ui8LitLens : m_ui8FixedLitLens;
+			const uint8_t * pui8DistLens = bDynamic ? dhHeader.ui8DistLens : m_ui8FixedDistLens;
+			// Symbols 286 and 287 are never used, but the fixed code includes them, so they are needed to build the
+			//	codes of the 9-bit literals.
+			uint16_t ui16LitCodes[LSC_FIXED_LIT_CODES], ui16DistCodes[LSC_DIST_CODES];
+			BuildCodes( pui8LitLens, bDynamic ? LSC_LIT_CODES : LSC_FIXED_LIT_CODES, ui16LitCodes );
+			BuildCodes( pui8DistLens, LSC_DIST_CODES, ui16DistCodes );
+
+			PutBits( (_bFinal ? 1 : 0) | ((bDynamic ? 2 : 1) << 1), 3 );
+			if ( bDynamic ) {
+				PutBits( dhHeader.ui32Lit - 257, 5 );
+				PutBits( dhHeader.ui32Dist - 1, 5 );
+				PutBits( dhHeader.ui32Cl - 4, 4 );
+				for ( uint32_t I = 0; I < dhHeader.ui32Cl; ++I ) {
+					PutBits( dhHeader.ui8ClLens[m_ui8ClOrder[I]], 3 );
+				}
+				uint16_t ui16ClCodes[LSC_CL_CODES];
+				BuildCodes( dhHeader.ui8ClLens, LSC_CL_CODES, ui16ClCodes );
+				for ( uint32_t I = 0; I < dhHeader.ui32Rle; ++I ) {
+					uint32_t ui32Sym = dhHeader.ui16Rle[I] & 0x1F;
+					PutBits( ui16ClCodes[ui32Sym], dhHeader.ui8ClLens[ui32Sym] );
+					switch ( ui32Sym ) {
+						case 16 : { PutBits( dhHeader.ui16Rle[I] >> 5, 2 ); break; }
+						case 17 : { PutBits( dhHeader.ui16Rle[I] >> 5, 3 ); break; }
+						case 18 : { PutBits( dhHeader.ui16Rle[I] >> 5, 7 ); break; }
+					}
+				}
+			}
+
+			for ( uint32_t I = 0; I < _ui32Symbols; ++I ) {
+				uint32_t ui32Sym = m_pui32Symbols[I];
+				if ( !(ui32Sym & 0x80000000) ) {
+					PutBits( ui16LitCodes[ui32Sym], pui8LitLens[ui32Sym] );
+					continue;
+				}
+				uint32_t ui32Len = ui32Sym & 0xFF;
+				uint32_t ui32Code = m_ui8LenCode[ui32Len];
+				// The length code and its extra bits go out together (at most 15 + 5 bits).
+				PutBits( ui16LitCodes[257+ui32Code] | ((ui32Len + LSC_MIN_MATCH - m_ui16LenBase[ui32Code]) << pui8LitLens[257+ui32Code]),
+					pui8LitLens[257+ui32Code] + m_ui8LenExtra[ui32Code] );
+				uint32_t ui32Dist = (ui32Sym >> 8) & 0xFFFF;
+				ui32Code = DistCode( ui32Dist );
+				PutBits( ui16DistCodes[ui32Code] | ((ui32Dist + 1 - m_ui16DistBase[ui32Code]) << pui8DistLens[ui32Code]),
+					pui8DistLens[ui32Code] + m_ui8DistExtra[ui32Code] );
+			}
+			PutBits( ui16LitCodes[256], pui8LitLens[256] );
+		}
+
+		// Remove the written symbols.
+		CStd::MemMove( m_pui32Symbols, m_pui32Symbols + _ui32Symbols, (m_ui32Symbols - _ui32Symbols) * sizeof( uint32_t ) );
+		m_ui32Symbols -= _ui32Symbols;
+		m_ui32ChunkStart -= CStd::Min( m_ui32ChunkStart, _ui32Symbols );
+		m_ui32BlockStart = _ui32End;
+		return true;
+	}
+
+	/**
+	 * Writes data as stored blocks.
+	 *
+	 * \param _pui8Buffer The data to store.
+	 * \param _ui32Len Length of the data to store.
+	 * \param _bFinal If true, the last block is marked as the last.
+	 * \return Returns false if there is not enough memory.
+	 */
+	LSBOOL LSE_CALL CZLibEncoder::WriteStored( const uint8_t * _pui8Buffer, uint32_t _ui32Len, LSBOOL _bFinal ) {
+		if ( !_ui32Len ) {
+			// An empty fixed-Huffman block is smaller than an empty stored block.
+			if ( !Reserve( 8 ) ) { return false; }
+			PutBits( (_bFinal ? 1 : 0) | (1 << 1), 3 );
+			PutBits( 0, 7 );
+			return true;
+		}
+		while ( _ui32Len ) {
+			uint32_t ui32Chunk = CStd::Min<uint32_t>( _ui32Len, LSC_MAX_STORED );
+			_ui32Len -= ui32Chunk;
+			if ( !Reserve( ui32Chunk + 16 ) ) { return false; }
+			PutBits( (_bFinal && !_ui32Len) ? 1 : 0, 3 );
+			AlignBits();
+			PutBits( ui32Chunk | ((~ui32Chunk & 0xFFFF) << 16), 32 );
+			CStd::MemCpy( &(*m_pzbOut)[m_ui32OutPos], _pui8Buffer, ui32Chunk );
+			m_ui32OutPos += ui32Chunk;
+			_pui8Buffer += ui32Chunk;
+		}
+		return true;
+	}
+
+	/**
+	 * Gets the size in bits of the smallest encoding of a block.
+	 *
+	 * \param _fFreq Frequencies of the symbols in the block, not including the end-of-block code.
+	 * \param _ui32Bytes Number of input bytes covered by the block.
+	 * \return Returns the size in bits of the smallest encoding of the block.
+	 */
+	uint64_t LSE_CALL CZLibEncoder::BlockBits( const LSC_FREQ &_fFreq, uint32_t _ui32Bytes ) const {
+		LSC_DYNAMIC_HEADER dhHeader;
+		BuildDynamicHeader( _fFreq, dhHeader );
+		uint64_t ui64Bits = dhHeader.ui32Bits + SymbolBits( _fFreq, dhHeader.ui8LitLens, dhHeader.ui8DistLens );
+		ui64Bits = CStd::Min( ui64Bits, SymbolBits( _fFreq, m_ui8FixedLitLens, m_ui8FixedDistLens ) );
+		ui64Bits += 3;
+		if ( _ui32Bytes ) {
+			ui64Bits = CStd::Min( ui64Bits, StoredBits( _ui32Bytes ) );
+		}
+		return ui64Bits;
+	}
+
+	/**
+	 * Gets the size in bits of data written as stored blocks, including the block headers.
+	 *
+	 * \param _ui32Bytes Number of bytes to store.
+	 * \return Returns the size in bits of the stored blocks.
+	 */
+	uint64_t LSE_CALL CZLibEncoder::StoredBits( uint32_t _ui32Bytes ) {
+		// Each stored block has its 3 header bits, on average 4 bits of padding and a 32-bit length.
+		uint64_t ui64Blocks = (static_cast<uint64_t>(_ui32Bytes) + LSC_MAX_STORED - 1) / LSC_MAX_STORED;
+		return static_cast<uint64_t>(_ui32Bytes) * 8 + ui64Blocks * (3 + 4 + 32);
+	}
+
+	/**
+	 * Gets the size in bits of the symbols in a block given code lengths, including extra bits and the
+	 *	end-of-block code.
+	 *
+	 * \param _fFreq Frequencies of the symbols in the block, not including the end-of-block code.
+	 * \param _pui8LitLens Literal/length code lengths.
+	 * \param _pui8DistLens Distance code lengths.
+	 * \return Returns the size in bits of the symbols in the block.
+	 */
+	uint64_t LSE_CALL CZLibEncoder::SymbolBits( const LSC_FREQ &_fFreq, const uint8_t * _pui8LitLens, const uint8_t * _pui8DistLens ) {
+		uint64_t ui64Bits = _pui8LitLens[256];
+		for ( uint32_t I = 0; I < 256; ++I ) {
+			ui64Bits += static_cast<uint64_t>(_fFreq.ui32Lit[I]) * _pui8LitLens[I];
+		}
+		for ( uint32_t I = 257; I < LSC_LIT_CODES; ++I ) {
+			ui64Bits += static_cast<uint64_t>(_fFreq.ui32Lit[I]) * (_pui8LitLens[I] + m_ui8LenExtra[I-257]);
+		}
+		for ( uint32_t I = 0; I < LSC_DIST_CODES; ++I ) {
+			ui64Bits += static_cast<uint64_t>(_fFreq.ui32Dist[I]) * (_pui8DistLens[I] + m_ui8DistExtra[I]);
+		}
+		return ui64Bits;
+	}
+
+	/**
+	 * Builds the code lengths of a dynamic-Huffman block and the header describing them.
+	 *
+	 * \param _fFreq Frequencies of the symbols in the block, not including the end-of-block code.
+	 * \param _dhHeader Holds the returned code lengths and header.
+	 */
+	void LSE_CALL CZLibEncoder::BuildDynamicHeader( const LSC_FREQ &_fFreq, LSC_DYNAMIC_HEADER &_dhHeader ) {
+		uint32_t ui32Lit[LSC_LIT_CODES];
+		uint32_t ui32Dist[LSC_DIST_CODES];
+		CStd::MemCpy( ui32Lit, _fFreq.ui32Lit, sizeof( ui32Lit ) );
+		CStd::MemCpy( ui32Dist, _fFreq.ui32Dist, sizeof( ui32Dist ) );
+		ui32Lit[256] = 1;
+
+		// Some decoders reject trees with fewer than 2 codes, so (as zlib does) give every tree at least 2.
+		uint32_t ui32Used = 0;
+		for ( uint32_t I = 0; I < LSC_DIST_CODES; ++I ) { ui32Used += ui32Dist[I] ? 1 : 0; }
+		for ( uint32_t I = 0; ui32Used < 2; ++I ) {
+			if ( !ui32Dist[I] ) { ui32Dist[I] = 1; ++ui32Used; }
+		}
+		ui32Used = 0;
+		for ( uint32_t I = 0; I < LSC_LIT_CODES; ++I ) { ui32Used += ui32Lit[I] ? 1 : 0; }
+		for ( uint32_t I = 0; ui32Used < 2; ++I ) {
+			if ( !ui32Lit[I] ) { ui32Lit[I] = 1; ++ui32Used; }
+		}
+
+		BuildLengths( ui32Lit, LSC_LIT_CODES, LSC_MAX_BITS, _dhHeader.ui8LitLens );
+		BuildLengths( ui32Dist, LSC_DIST_CODES, LSC_MAX_BITS, _dhHeader.ui8DistLens );
+		for ( _dhHeader.ui32Lit = LSC_LIT_CODES; _dhHeader.ui32Lit > 257 && !_dhHeader.ui8LitLens[_dhHeader.ui32Lit-1]; --_dhHeader.ui32Lit ) {}
+		for ( _dhHeader.ui32Dist = LSC_DIST_CODES; _dhHeader.ui32Dist > 1 && !_dhHeader.ui8DistLens[_dhHeader.ui32Dist-1]; --_dhHeader.ui32Dist ) {}
+
+		// Run-length encode both sets of lengths together.  Runs may cross from one set to the other.
+		uint8_t ui8Lens[LSC_LIT_CODES+LSC_DIST_CODES];
+		uint32_t ui32Total = _dhHeader.ui32Lit + _dhHeader.ui32Dist;
+		CStd::MemCpy( ui8Lens, _dhHeader.ui8LitLens, _dhHeader.ui32Lit );
+		CStd::MemCpy( ui8Lens + _dhHeader.ui32Lit, _dhHeader.ui8DistLens, _dhHeader.ui32Dist );
+		uint32_t ui32ClFreq[LSC_CL_CODES] = { 0 };
+		_dhHeader.ui32Rle = 0;
+		for ( uint32_t I = 0; I < ui32Total; ) {
+			uint8_t ui8Len = ui8Lens[I];
+			uint32_t ui32Run = 1;
+			while ( I + ui32Run < ui32Total && ui8Lens[I+ui32Run] == ui8Len ) { ++ui32Run; }
+			I += ui32Run;
+			if ( !ui8Len ) {
+				while ( ui32Run >= 11 ) {
+					uint32_t ui32This = CStd::Min<uint32_t>( ui32Run, 138 );
+					_dhHeader.ui16Rle[_dhHeader.ui32Rle++] = static_cast<uint16_t>(18 | ((ui32This - 11) << 5));
+					++ui32ClFreq[18];
+					ui32Run -= ui32This;
+				}
+				if ( ui32Run >= 3 ) {
+					_dhHeader.ui16Rle[_dhHeader.ui32Rle++] = static_cast<uint16_t>(17 | ((ui32Run - 3) << 5));
+					++ui32ClFreq[17];
+					ui32Run = 0;
+				}
+			}
+			else if ( ui32Run >= 4 ) {
+				// One explicit length, then repeats of it.
+				_dhHeader.ui16Rle[_dhHeader.ui32Rle++] = ui8Len;
+				++ui32ClFreq[ui8Len];
+				--ui32Run;
+				while ( ui32Run >= 3 ) {
+					uint32_t ui32This = CStd::Min<uint32_t>( ui32Run, 6 );
+					_dhHeader.ui16Rle[_dhHeader.ui32Rle++] = static_cast<uint16_t>(16 | ((ui32This - 3) << 5));
+					++ui32ClFreq[16];
+					ui32Run -= ui32This;
+				}
+			}
+			while ( ui32Run ) {
+				_dhHeader.ui16Rle[_dhHeader.ui32Rle++] = ui8Len;
+				++ui32ClFreq[ui8Len];
+				--ui32Run;
+			}
+		}
+
+		ui32Used = 0;
+		for ( uint32_t I = 0; I < LSC_CL_CODES; ++I ) { ui32Used += ui32ClFreq[I] ? 1 : 0; }
+		for ( uint32_t I = 0; ui32Used < 2; ++I ) {
+			if ( !ui32ClFreq[I] ) { ui32ClFreq[I] = 1; ++ui32Used; }
+		}
+		BuildLengths( ui32ClFreq, LSC_CL_CODES, LSC_MAX_CL_BITS, _dhHeader.ui8ClLens );
+		for ( _dhHeader.ui32Cl = LSC_CL_CODES; _dhHeader.ui32Cl > 4 && !_dhHeader.ui8ClLens[m_ui8ClOrder[_dhHeader.ui32Cl-1]]; --_dhHeader.ui32Cl ) {}
+
+		_dhHeader.ui32Bits = 5 + 5 + 4 + 3 * _dhHeader.ui32Cl;
+		for ( uint32_t I = 0; I < _dhHeader.ui32Rle; ++I ) {
+			uint32_t ui32Sym = _dhHeader.ui16Rle[I] & 0x1F;
+			_dhHeader.ui32Bits += _dhHeader.ui8ClLens[ui32Sym];
+			switch ( ui32Sym ) {
+				case 16 : { _dhHeader.ui32Bits += 2; break; }
+				case 17 : { _dhHeader.ui32Bits += 3; break; }
+				case 18 : { _dhHeader.ui32Bits += 7; break; }
+			}
+		}
+	}
+
+	/**
+	 * Builds length-limited Huffman code lengths from symbol frequencies.  Symbols with no frequency get no code.
+	 *
+	 * \param _pui32Freq The symbol frequencies.
+	 * \param _ui32Total Number of symbols.
+	 * \param _ui32MaxBits Maximum code length.
+	 * \param _pui8Lens Holds the returned code lengths.
+	 */
+	void LSE_CALL CZLibEncoder::BuildLengths( const uint32_t * _pui32Freq, uint32_t _ui32Total, uint32_t _ui32MaxBits,
+		uint8_t * _pui8Lens ) {
+		// Sort the used symbols by frequency, keeping each symbol in the low 9 bits.
+		uint32_t ui32Keys[LSC_LIT_CODES];
+		int32_t i32N = 0;
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			_pui8Lens[I] = 0;
+			if ( _pui32Freq[I] ) {
+				ui32Keys[i32N++] = (_pui32Freq[I] << 9) | I;
+			}
+		}
+		if ( !i32N ) { return; }
+		if ( i32N == 1 ) {
+			_pui8Lens[ui32Keys[0]&0x1FF] = 1;
+			return;
+		}
+		CSearch::QSort( ui32Keys, static_cast<uintptr_t>(i32N), sizeof( uint32_t ), CompareUi32, NULL );
+
+		// Code lengths in place (Moffat and Katajainen).  Afterwards ui32A[I] is the length of the I-th least
+		//	frequent symbol.
+		uint32_t ui32A[LSC_LIT_CODES];
+		for ( int32_t I = 0; I < i32N; ++I ) { ui32A[I] = ui32Keys[I] >> 9; }
+		ui32A[0] += ui32A[1];
+		int32_t i32Root = 0, i32Leaf = 2, i32Next;
+		for ( i32Next = 1; i32Next < i32N - 1; ++i32Next ) {
+			if ( i32Leaf >= i32N || ui32A[i32Root] < ui32A[i32Leaf] ) {
+				ui32A[i32Next] = ui32A[i32Root];
+				ui32A[i32Root++] = static_cast<uint32_t>(i32Next);
+			}
+			else {
+				ui32A[i32Next] = ui32A[i32Leaf++];
+			}
+			if ( i32Leaf >= i32N || (i32Root < i32Next && ui32A[i32Root] < ui32A[i32Leaf]) ) {
+				ui32A[i32Next] += ui32A[i32Root];
+				ui32A[i32Root++] = static_cast<uint32_t>(i32Next);
+			}
+			else {
+				ui32A[i32Next] += ui32A[i32Leaf++];
+			}
+		}
+		ui32A[i32N-2] = 0;
+		for ( i32Next = i32N - 3; i32Next >= 0; --i32Next ) {
+			ui32A[i32Next] = ui32A[ui32A[i32Next]] + 1;
+		}
+		int32_t i32Avail = 1, i32Used = 0;
+		uint32_t ui32Depth = 0;
+		i32Root = i32N - 2;
+		i32Next = i32N - 1;
+		while ( i32Avail > 0 ) {
+			while ( i32Root >= 0 && ui32A[i32Root] == ui32Depth ) {
+				++i32Used;
+				--i32Root;
+			}
+			while ( i32Avail > i32Used ) {
+				ui32A[i32Next--] = ui32Depth;
+				--i32Avail;
+			}
+			i32Avail = 2 * i32Used;
+			++ui32Depth;
+			i32Used = 0;
+		}
+
+		// Limit the lengths: move overlong codes to the maximum, then lengthen shorter codes until the code is
+		//	no longer over-subscribed.
+		uint32_t ui32Count[LSC_LIT_CODES+1] = { 0 };
+		for ( int32_t I = 0; I < i32N; ++I ) {
+			++ui32Count[CStd::Min( ui32A[I], _ui32MaxBits )];
+		}
+		uint32_t ui32Kraft = 0;
+		for ( uint32_t I = _ui32MaxBits; I > 0; --I ) {
+			ui32Kraft += ui32Count[I] << (_ui32MaxBits - I);
+		}
+		while ( ui32Kraft > (1U << _ui32MaxBits) ) {
+			--ui32Count[_ui32MaxBits];
+			for ( uint32_t I = _ui32MaxBits - 1; I > 0; --I ) {
+				if ( ui32Count[I] ) {
+					--ui32Count[I];
+					ui32Count[I+1] += 2;
+					break;
+				}
+			}
+			--ui32Kraft;
+		}
+
+		// The least frequent symbols get the longest codes.
+		int32_t i32Index = 0;
+		for ( uint32_t ui32Len = _ui32MaxBits; ui32Len > 0; --ui32Len ) {
+			for ( uint32_t J = ui32Count[ui32Len]; J--; ) {
+				_pui8Lens[ui32Keys[i32Index++]&0x1FF] = static_cast<uint8_t>(ui32Len);
+			}
+		}
+	}
+
+	/**
+	 * Builds canonical Huffman codes from code lengths.  The codes are bit-reversed, ready to be written
+	 *	least-significant bit first.
+	 *
+	 * \param _pui8Lens The code lengths.
+	 * \param _ui32Total Number of codes.
+	 * \param _pui16Codes Holds the returned codes.
+	 */
+	void LSE_CALL CZLibEncoder::BuildCodes( const uint8_t * _pui8Lens, uint32_t _ui32Total, uint16_t * _pui16Codes ) {
+		uint32_t ui32Count[LSC_MAX_BITS+1] = { 0 };
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) { ++ui32Count[_pui8Lens[I]]; }
+		ui32Count[0] = 0;
+		uint32_t ui32Next[LSC_MAX_BITS+1];
+		uint32_t ui32Code = 0;
+		for ( uint32_t I = 1; I <= LSC_MAX_BITS; ++I ) {
+			ui32Code = (ui32Code + ui32Count[I-1]) << 1;
+			ui32Next[I] = ui32Code;
+		}
+		for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+			uint32_t ui32Len = _pui8Lens[I];
+			_pui16Codes[I] = ui32Len ?
+				static_cast<uint16_t>(CStd::BitSwap16( static_cast<uint16_t>(ui32Next[ui32Len]++) ) >> (16 - ui32Len)) :
+				0;
+		}
+	}
+
+	/**
+	 * Makes room in the output for at least the given number of bytes.
+	 *
+	 * \param _ui32Bytes The number of bytes to be written.
+	 * \return Returns false if there is not enough memory.
+	 */
+	LSBOOL LSE_CALL CZLibEncoder::Reserve( uint32_t _ui32Bytes ) {
+		// PutBits() writes 4 bytes at a time, so leave room for one more write.
+		uint64_t ui64Need = static_cast<uint64_t>(m_ui32OutPos) + _ui32Bytes + 8;
+		if ( ui64Need > 0xFFFFFFFFULL ) { return false; }
+		if ( m_pzbOut->Length() >= ui64Need ) { return true; }
+		return m_pzbOut->ResizeUninitialized( static_cast<uint32_t>(ui64Need) );
+	}
+
+	/**
+	 * Pads the output to a byte boundary and writes any bits still held.
+	 */
+	void LSE_CALL CZLibEncoder::AlignBits() {
+		uint8_t * pui8Dst = &(*m_pzbOut)[m_ui32OutPos];
+		for ( uint32_t I = 0; I < m_ui32BitCount; I += 8 ) {
+			(*pui8Dst++) = static_cast<uint8_t>(m_ui64Bits >> I);
+			++m_ui32OutPos;
+		}
+		m_ui64Bits = 0;
+		m_ui32BitCount = 0;
+	}
+
+	/**
+	 * Sorts ascending.  Used to sort symbols by frequency.
+	 *
+	 * \param _pvContext Unused.
+	 * \param _pvLeft The left value.
+	 * \param _pvRight The right value.
+	 * \return Returns the comparison of the 2 values.
+	 */
+	int32_t LSE_CCALL CZLibEncoder::CompareUi32( void * /*_pvContext*/, const void * _pvLeft, const void * _pvRight ) {
+		uint32_t ui32Left = (*static_cast<const uint32_t *>(_pvLeft));
+		uint32_t ui32Right = (*static_cast<const uint32_t *>(_pvRight));
+		return ui32Left < ui32Right ? -1 : (ui32Left > ui32Right ? 1 : 0);
+	}
+
+}	// namespace lsc
@@ -0,0 +1,649 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A deflate encoder producing raw deflate, zlib or gzip streams.  Levels 1-3 use greedy matching,
+ *	levels 4-9 use lazy matching with longer hash chains, and level 0 stores the data.  Blocks are split where the
+ *	statistics of the data change, and each block is written with whichever of the stored, fixed-Huffman or
+ *	dynamic-Huffman encodings is smallest.  The output is decoded by CZLib.
+ */
+
+
+#ifndef __LSC_ZLIBENCODER_H__
+#define __LSC_ZLIBENCODER_H__
+
+#include "../LSCCompressionLib.h"
+#include "LSCZLib.h"
+#include "Vector/LSTLVectorPoD.h"
+
+namespace lsc {
+
+	/**
+	 * Class CZLibEncoder
+	 * \brief A deflate encoder producing raw deflate, zlib or gzip streams.
+	 *
+	 * Description: A deflate encoder producing raw deflate, zlib or gzip streams.  Levels 1-3 use greedy matching,
+	 *	levels 4-9 use lazy matching with longer hash chains, and level 0 stores the data.  Blocks are split where the
+	 *	statistics of the data change, and each block is written with whichever of the stored, fixed-Huffman or
+	 *	dynamic-Huffman encodings is smallest.  The output is decoded by CZLib.
+	 */
+	class CZLibEncoder {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR					CZLibEncoder();
+
+
+		// == Enumerations.
+		/**
+		 * Stream formats.
+		 */
+		enum LSC_ZLIB_FORMAT {
+			LSC_ZF_DEFLATE,										/**< Raw deflate data with no header or checksum. */
+			LSC_ZF_ZLIB,										/**< A zlib stream (RFC 1950).  PNG uses this. */
+			LSC_ZF_GZIP,										/**< A gzip stream (RFC 1952). */
+		};
+
+		/**
+		 * Compression levels.  Any level from 0 to 9 may be used.
+		 */
+		enum LSC_ZLIB_LEVEL {
+			LSC_ZL_STORE				= 0,					/**< No compression. */
+			LSC_ZL_FASTEST				= 1,					/**< Fastest compression. */
+			LSC_ZL_DEFAULT				= 6,					/**< A balance between speed and size. */
+			LSC_ZL_BEST					= 9,					/**< Best compression. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Compresses a buffer, appending the stream to _zbOut.
+		 *
+		 * \param _pui8Buffer The data to compress.
+		 * \param _uiptrLen Length of the data to compress.
+		 * \param _ui32Level The compression level from 0 to 9.  Higher levels are clamped to 9.
+		 * \param _zfFormat The format of the stream to write.
+		 * \param _zbOut Holds the returned compressed data.
+		 * \return Returns false if there is not enough memory or the data is too large to be held by _zbOut.
+		 */
+		LSBOOL LSE_CALL					Encode( const uint8_t * _pui8Buffer, uintptr_t _uiptrLen,
+			uint32_t _ui32Level, LSC_ZLIB_FORMAT _zfFormat, CZLib::LSC_ZLIB_BUFFER &_zbOut );
+
+
+	protected :
+		// == Enumerations.
+		/**
+		 * Encoder metrics.
+		 */
+		enum {
+			LSC_WINDOW_BITS				= 15,
+			LSC_WINDOW_SIZE				= 1 << LSC_WINDOW_BITS,
+			LSC_WINDOW_MASK				= LSC_WINDOW_SIZE - 1,
+			LSC_HASH_BITS				= 15,
+			LSC_HASH_SIZE				= 1 << LSC_HASH_BITS,
+			LSC_MIN_MATCH				= 3,
+			LSC_MAX_MATCH				= 258,
+			LSC_LIT_CODES				= 286,
+			LSC_FIXED_LIT_CODES			= 288,					/**< The fixed code also assigns codes to the 2 unused literal/length symbols. */
+			LSC_DIST_CODES				= 30,
+			LSC_CL_CODES				= 19,
+			LSC_MAX_BITS				= 15,
+			LSC_MAX_CL_BITS				= 7,
+			LSC_MAX_STORED				= 0xFFFF,
+			LSC_MAX_BLOCK_SYMBOLS		= 1 << 16,				/**< A block is always ended after this many symbols. */
+			LSC_NO_POS					= 0xFFFFFFFF,
+		};
+
+
+		// == Types.
+		/**
+		 * Matching parameters for a compression level.
+		 */
+		typedef struct LSC_LEVEL {
+			/**
+			 * A match at least this long reduces the chain searched for a lazy match by 4.
+			 */
+			uint32_t					ui32Good;
+
+			/**
+			 * Lazy levels: no lazy match is attempted after a match at least this long.  Greedy levels: positions
+			 *	inside a match are added to the hash chains only if the match is no longer than this.
+			 */
+			uint32_t					ui32Lazy;
+
+			/**
+			 * Searching stops on finding a match at least this long.
+			 */
+			uint32_t					ui32Nice;
+
+			/**
+			 * Maximum number of hash-chain entries to check.
+			 */
+			uint32_t					ui32Chain;
+
+			/**
+			 * Number of symbols between checks for a block split.
+			 */
+			uint32_t					ui32SplitInterval;
+
+			/**
+			 * If true, matching is lazy.
+			 */
+			LSBOOL						bLazy;
+		} * LPLSC_LEVEL, * const LPCLSC_LEVEL;
+
+		/**
+		 * Symbol frequencies of a range of symbols.
+		 */
+		typedef struct LSC_FREQ {
+			/**
+			 * Literal/length frequencies.
+			 */
+			uint32_t					ui32Lit[LSC_LIT_CODES];
+
+			/**
+			 * Distance frequencies.
+			 */
+			uint32_t					ui32Dist[LSC_DIST_CODES];
+		} * LPLSC_FREQ, * const LPCLSC_FREQ;
+
+		/**
+		 * The code lengths of a dynamic-Huffman block and the run-length encoding used to send them.
+		 */
+		typedef struct LSC_DYNAMIC_HEADER {
+			/**
+			 * Literal/length code lengths.
+			 */
+			uint8_t						ui8LitLens[LSC_LIT_CODES];
+
+			/**
+			 * Distance code lengths.
+			 */
+			uint8_t						ui8DistLens[LSC_DIST_CODES];
+
+			/**
+			 * Code-length code lengths.
+			 */
+			uint8_t						ui8ClLens[LSC_CL_CODES];
+
+			/**
+			 * Run-length-encoded code lengths.  The low 5 bits are the code-length symbol and the rest are its extra bits.
+			 */
+			uint16_t					ui16Rle[LSC_LIT_CODES+LSC_DIST_CODES];
+
+			/**
+			 * Number of literal/length codes sent.
+			 */
+			uint32_t					ui32Lit;
+
+			/**
+			 * Number of distance codes sent.
+			 */
+			uint32_t					ui32Dist;
+
+			/**
+			 * Number of code-length code lengths sent.
+			 */
+			uint32_t					ui32Cl;
+
+			/**
+			 * Number of entries in ui16Rle.
+			 */
+			uint32_t					ui32Rle;
+
+			/**
+			 * Size of the header in bits, not including the 3 block-type bits.
+			 */
+			uint32_t					ui32Bits;
+		} * LPLSC_DYNAMIC_HEADER, * const LPCLSC_DYNAMIC_HEADER;
+
+
+		// == Members.
+		/**
+		 * The buffer being written.
+		 */
+		CZLib::LSC_ZLIB_BUFFER *		m_pzbOut;
+
+		/**
+		 * Write position in the buffer being written.
+		 */
+		uint32_t						m_ui32OutPos;
+
+		/**
+		 * Bits not yet written to the buffer.
+		 */
+		uint64_t						m_ui64Bits;
+
+		/**
+		 * Number of bits in m_ui64Bits.
+		 */
+		uint32_t						m_ui32BitCount;
+
+		/**
+		 * The most recent position for each hash.
+		 */
+		CVectorPoD<uint32_t, uint32_t>	m_vHead;
+
+		/**
+		 * The previous position with the same hash for each position in the window.
+		 */
+		CVectorPoD<uint32_t, uint32_t>	m_vPrev;
+
+		/**
+		 * Symbols of the current block.  Literals are stored as-is.  Matches have the high bit set, the distance
+		 *	minus 1 in bits 8-23 and the length minus 3 in bits 0-7.
+		 */
+		CVectorPoD<uint32_t, uint32_t>	m_vSymbols;
+
+		/**
+		 * Data of m_vHead.
+		 */
+		uint32_t *						m_pui32Head;
+
+		/**
+		 * Data of m_vPrev.
+		 */
+		uint32_t *						m_pui32Prev;
+
+		/**
+		 * Data of m_vSymbols.
+		 */
+		uint32_t *						m_pui32Symbols;
+
+		/**
+		 * Number of symbols between checks for a block split at the current level.
+		 */
+		uint32_t						m_ui32SplitInterval;
+
+		/**
+		 * Number of symbols in m_vSymbols.
+		 */
+		uint32_t						m_ui32Symbols;
+
+		/**
+		 * Index of the first symbol not yet considered for a block split.
+		 */
+		uint32_t						m_ui32ChunkStart;
+
+		/**
+		 * Input position at which the current block starts.
+		 */
+		uint32_t						m_ui32BlockStart;
+
+		/**
+		 * Input position at which the symbols not yet considered for a block split start.
+		 */
+		uint32_t						m_ui32ChunkPos;
+
+		/**
+		 * Number of input bytes covered by the emitted symbols.
+		 */
+		uint32_t						m_ui32Consumed;
+
+		/**
+		 * Frequencies of the symbols already considered for a block split.
+		 */
+		LSC_FREQ						m_fBlock;
+
+		/**
+		 * Frequencies of the symbols not yet considered for a block split.
+		 */
+		LSC_FREQ						m_fChunk;
+
+		/**
+		 * Length code (minus 257) of each match length minus 3.
+		 */
+		uint8_t							m_ui8LenCode[256];
+
+		/**
+		 * Distance code of each distance minus 1 below 256, followed by the distance code of each distance minus 1
+		 *	shifted right by 7.
+		 */
+		uint8_t							m_ui8DistCode[512];
+
+		/**
+		 * Fixed literal/length code lengths.
+		 */
+		uint8_t							m_ui8FixedLitLens[LSC_FIXED_LIT_CODES];
+
+		/**
+		 * Fixed distance code lengths.
+		 */
+		uint8_t							m_ui8FixedDistLens[LSC_DIST_CODES];
+
+		/**
+		 * Matching parameters for each level.
+		 */
+		static const LSC_LEVEL			m_lLevels[10];
+
+		/**
+		 * Length extra bits for each length code.
+		 */
+		static const uint8_t			m_ui8LenExtra[29];
+
+		/**
+		 * Base length for each length code.
+		 */
+		static const uint16_t			m_ui16LenBase[29];
+
+		/**
+		 * Distance extra bits for each distance code.
+		 */
+		static const uint8_t			m_ui8DistExtra[LSC_DIST_CODES];
+
+		/**
+		 * Base distance for each distance code.
+		 */
+		static const uint16_t			m_ui16DistBase[LSC_DIST_CODES];
+
+		/**
+		 * Order in which code-length code lengths are sent.
+		 */
+		static const uint8_t			m_ui8ClOrder[LSC_CL_CODES];
+
+
+		// == Functions.
+		/**
+		 * Compresses the data to deflate blocks.
+		 *
+		 * \param _pui8Buffer The data to compress.
+		 * \param _ui32Len Length of the data to compress.
+		 * \param _ui32Level The compression level from 0 to 9.
+		 * \return Returns false if there is not enough memory.
+		 */
+		LSBOOL LSE_CALL					Deflate( const uint8_t * _pui8Buffer, uint32_t _ui32Len, uint32_t _ui32Level );
+
+		/**
+		 * Compresses the data with greedy matching.
+		 *
+		 * \param _pui8Buffer The data to compress.
+		 * \param _ui32Len Length of the data to compress.
+		 * \param _lLevel The matching parameters.
+		 * \return Returns false if there is not enough memory.
+		 */
+		LSBOOL LSE_CALL					DeflateGreedy( const uint8_t * _pui8Buffer, uint32_t _ui32Len, const LSC_LEVEL &_lLevel );
+
+		/**
+		 * Compresses the data with lazy matching.
+		 *
+		 * \param _pui8Buffer The data to compress.
+		 * \param _ui32Len Length of the data to compress.
+		 * \param _lLevel The matching parameters.
+		 * \return Returns false if there is not enough memory.
+		 */
+		LSBOOL LSE_CALL					DeflateLazy( const uint8_t * _pui8Buffer, uint32_t _ui32Len, const LSC_LEVEL &_lLevel );
+
+		/**
+		 * Finds the longest match for the given position along its hash chain.
+		 *
+		 * \param _pui8Buffer The data being compressed.
+		 * \param _ui32Pos The position for which to find a match.
+		 * \param _ui32Candidate The first position on the hash chain.
+		 * \param _ui32Avail Number of bytes from _ui32Pos to the end of the data.
+		 * \param _ui32Best Only matches longer than this are considered.
+		 * \param _ui32Chain Maximum number of chain entries to check.
+		 * \param _ui32Nice Searching stops on finding a match at least this long.
+		 * \param _ui32Dist Holds the distance of the returned match if it is longer than _ui32Best.
+		 * \return Returns the length of the longest match, or _ui32Best if none is longer.
+		 */
+		uint32_t LSE_CALL				LongestMatch( const uint8_t * _pui8Buffer, uint32_t _ui32Pos, uint32_t _ui32Candidate,
+			uint32_t _ui32Avail, uint32_t _ui32Best, uint32_t _ui32Chain, uint32_t _ui32Nice, uint32_t &_ui32Dist ) const;
+
+		/**
+		 * Checks whether the symbols gathered since the last check should start a new block, ending the current
+		 *	block if so.  Ends the current block regardless if it is full or _bFinal is true.
+		 *
+		 * \param _pui8Buffer The data being compressed.
+		 * \param _bFinal If true, all input has been consumed and the final block is written.
+		 * \return Returns false if there is not enough memory.
+		 */
+		LSBOOL LSE_CALL					CheckSplit( const uint8_t * _pui8Buffer, LSBOOL _bFinal );
+
+		/**
+		 * Writes the first symbols of the current block as a block and removes them.
+		 *
+		 * \param _pui8Buffer The data being compressed.
+		 * \param _ui32Symbols Number of symbols to write.
+		 * \param _ui32End Input position at which the written symbols end.
+		 * \param _fFreq Frequencies of the symbols to write.
+		 * \param _bFinal If true, the block is marked as the last.
+		 * \return Returns false if there is not enough memory.
+		 */
+		LSBOOL LSE_CALL					WriteBlock( const uint8_t * _pui8Buffer, uint32_t _ui32Symbols, uint32_t _ui32End,
+			const LSC_FREQ &_fFreq, LSBOOL _bFinal );
+
+		/**
+		 * Writes data as stored blocks.
+		 *
+		 * \param _pui8Buffer The data to store.
+		 * \param _ui32Len Length of the data to store.
+		 * \param _bFinal If true, the last block is marked as the last.
+		 * \return Returns false if there is not enough memory.
+		 */
+		LSBOOL LSE_CALL					WriteStored( const uint8_t * _pui8Buffer, uint32_t _ui32Len, LSBOOL _bFinal );
+
+		/**
+		 * Gets the size in bits of the smallest encoding of a block.
+		 *
+		 * \param _fFreq Frequencies of the symbols in the block, not including the end-of-block code.
+		 * \param _ui32Bytes Number of input bytes covered by the block.
+		 * \return Returns the size in bits of the smallest encoding of the block.
+		 */
+		uint64_t LSE_CALL				BlockBits( const LSC_FREQ &_fFreq, uint32_t _ui32Bytes ) const;
+
+		/**
+		 * Gets the size in bits of data written as stored blocks, including the block headers.
+		 *
+		 * \param _ui32Bytes Number of bytes to store.
+		 * \return Returns the size in bits of the stored blocks.
+		 */
+		static uint64_t LSE_CALL		StoredBits( uint32_t _ui32Bytes );
+
+		/**
+		 * Gets the size in bits of the symbols in a block given code lengths, including extra bits and the
+		 *	end-of-block code.
+		 *
+		 * \param _fFreq Frequencies of the symbols in the block, not including the end-of-block code.
+		 * \param _pui8LitLens Literal/length code lengths.
+		 * \param _pui8DistLens Distance code lengths.
+		 * \return Returns the size in bits of the symbols in the block.
+		 */
+		static uint64_t LSE_CALL		SymbolBits( const LSC_FREQ &_fFreq, const uint8_t * _pui8LitLens, const uint8_t * _pui8DistLens );
+
+		/**
+		 * Builds the code lengths of a dynamic-Huffman block and the header describing them.
+		 *
+		 * \param _fFreq Frequencies of the symbols in the block, not including the end-of-block code.
+		 * \param _dhHeader Holds the returned code lengths and header.
+		 */
+		static void LSE_CALL			BuildDynamicHeader( const LSC_FREQ &_fFreq, LSC_DYNAMIC_HEADER &_dhHeader );
+
+		/**
+		 * Builds length-limited Huffman code lengths from symbol frequencies.  Symbols with no frequency get no code.
+		 *
+		 * \param _pui32Freq The symbol frequencies.
+		 * \param _ui32Total Number of symbols.
+		 * \param _ui32MaxBits Maximum code length.
+		 * \param _pui8Lens Holds the returned code lengths.
+		 */
+		static void LSE_CALL			BuildLengths( const uint32_t * _pui32Freq, uint32_t _ui32Total, uint32_t _ui32MaxBits,
+			uint8_t * _pui8Lens );
+
+		/**
+		 * Builds canonical Huffman codes from code lengths.  The codes are bit-reversed, ready to be written
+		 *	least-significant bit first.
+		 *
+		 * \param _pui8Lens The code lengths.
+		 * \param _ui32Total Number of codes.
+		 * \param _pui16Codes Holds the returned codes.
+		 */
+		static void LSE_CALL			BuildCodes( const uint8_t * _pui8Lens, uint32_t _ui32Total, uint16_t * _pui16Codes );
+
+		/**
+		 * Makes room in the output for at least the given number of bytes.
+		 *
+		 * \param _ui32Bytes The number of bytes to be written.
+		 * \return Returns false if there is not enough memory.
+		 */
+		LSBOOL LSE_CALL					Reserve( uint32_t _ui32Bytes );
+
+		/**
+		 * Writes bits to the output.  Room must have been made with Reserve().
+		 *
+		 * \param _ui32Bits The bits to write, least-significant bit first.
+		 * \param _ui32Total Number of bits to write, at most 32.
+		 */
+		LSE_INLINE void LSE_CALL		PutBits( uint32_t _ui32Bits, uint32_t _ui32Total );
+
+		/**
+		 * Pads the output to a byte boundary and writes any bits still held.
+		 */
+		void LSE_CALL					AlignBits();
+
+		/**
+		 * Adds a position to the hash chains.  At least 3 bytes must follow the position.
+		 *
+		 * \param _pui8Buffer The data being compressed.
+		 * \param _ui32Pos The position to add.
+		 * \return Returns the previous position with the same hash or LSC_NO_POS.
+		 */
+		LSE_INLINE uint32_t LSE_CALL	Insert( const uint8_t * _pui8Buffer, uint32_t _ui32Pos );
+
+		/**
+		 * Adds a literal to the current block.
+		 *
+		 * \param _ui8Literal The literal.
+		 */
+		LSE_INLINE void LSE_CALL		AddLiteral( uint8_t _ui8Literal );
+
+		/**
+		 * Adds a match to the current block.
+		 *
+		 * \param _ui32Len The length of the match.
+		 * \param _ui32Dist The distance of the match.
+		 */
+		LSE_INLINE void LSE_CALL		AddMatch( uint32_t _ui32Len, uint32_t _ui32Dist );
+
+		/**
+		 * Gets the distance code of a distance minus 1.
+		 *
+		 * \param _ui32Dist The distance minus 1.
+		 * \return Returns the distance code.
+		 */
+		LSE_INLINE uint32_t LSE_CALL	DistCode( uint32_t _ui32Dist ) const;
+
+		/**
+		 * Hashes the 3 bytes at the given address.
+		 *
+		 * \param _pui8Data The bytes to hash.
+		 * \return Returns the hash.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL
+										Hash( const uint8_t * _pui8Data );
+
+		/**
+		 * Sorts ascending.  Used to sort symbols by frequency.
+		 *
+		 * \param _pvContext Unused.
+		 * \param _pvLeft The left value.
+		 * \param _pvRight The right value.
+		 * \return Returns the comparison of the 2 values.
+		 */
+		static int32_t LSE_CCALL		CompareUi32( void * _pvContext, const void * _pvLeft, const void * _pvRight );
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Writes bits to the output.  Room must have been made with Reserve().
+	 *
+	 * \param _ui32Bits The bits to write, least-significant bit first.
+	 * \param _ui32Total Number of bits to write, at most 32.
+	 */
+	LSE_INLINE void LSE_CALL CZLibEncoder::PutBits( uint32_t _ui32Bits, uint32_t _ui32Total ) {
+		m_ui64Bits |= static_cast<uint64_t>(_ui32Bits) << m_ui32BitCount;
+		m_ui32BitCount += _ui32Total;
+		if ( m_ui32BitCount >= 32 ) {
+			uint8_t * pui8Dst = &(*m_pzbOut)[m_ui32OutPos];
+			pui8Dst[0] = static_cast<uint8_t>(m_ui64Bits);
+			pui8Dst[1] = static_cast<uint8_t>(m_ui64Bits >> 8);
+			pui8Dst[2] = static_cast<uint8_t>(m_ui64Bits >> 16);
+			pui8Dst[3] = static_cast<uint8_t>(m_ui64Bits >> 24);
+			m_ui32OutPos += 4;
+			m_ui64Bits >>= 32;
+			m_ui32BitCount -= 32;
+		}
+	}
+
+	/**
+	 * Adds a position to the hash chains.  At least 3 bytes must follow the position.
+	 *
+	 * \param _pui8Buffer The data being compressed.
+	 * \param _ui32Pos The position to add.
+	 * \return Returns the previous position with the same hash or LSC_NO_POS.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CZLibEncoder::Insert( const uint8_t * _pui8Buffer, uint32_t _ui32Pos ) {
+		uint32_t ui32Hash = Hash( _pui8Buffer + _ui32Pos );
+		uint32_t ui32Ret = m_pui32Head[ui32Hash];
+		m_pui32Prev[_ui32Pos&LSC_WINDOW_MASK] = ui32Ret;
+		m_pui32Head[ui32Hash] = _ui32Pos;
+		return ui32Ret;
+	}
+
+	/**
+	 * Adds a literal to the current block.
+	 *
+	 * \param _ui8Literal The literal.
+	 */
+	LSE_INLINE void LSE_CALL CZLibEncoder::AddLiteral( uint8_t _ui8Literal ) {
+		m_pui32Symbols[m_ui32Symbols++] = _ui8Literal;
+		++m_fChunk.ui32Lit[_ui8Literal];
+		++m_ui32Consumed;
+	}
+
+	/**
+	 * Adds a match to the current block.
+	 *
+	 * \param _ui32Len The length of the match.
+	 * \param _ui32Dist The distance of the match.
+	 */
+	LSE_INLINE void LSE_CALL CZLibEncoder::AddMatch( uint32_t _ui32Len, uint32_t _ui32Dist ) {
+		m_pui32Symbols[m_ui32Symbols++] = 0x80000000 | ((_ui32Dist - 1) << 8) | (_ui32Len - LSC_MIN_MATCH);
+		++m_fChunk.ui32Lit[257+m_ui8LenCode[_ui32Len-LSC_MIN_MATCH]];
+		++m_fChunk.ui32Dist[DistCode( _ui32Dist - 1 )];
+		m_ui32Consumed += _ui32Len;
+	}
+
+	/**
+	 * Gets the distance code of a distance minus 1.
+	 *
+	 * \param _ui32Dist The distance minus 1.
+	 * \return Returns the distance code.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CZLibEncoder::DistCode( uint32_t _ui32Dist ) const {
+		return _ui32Dist < 256 ? m_ui8DistCode[_ui32Dist] : m_ui8DistCode[256+(_ui32Dist>>7)];
+	}
+
+	/**
+	 * Hashes the 3 bytes at the given address.
+	 *
+	 * \param _pui8Data The bytes to hash.
+	 * \return Returns the hash.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CZLibEncoder::Hash( const uint8_t * _pui8Data ) {
+		uint32_t ui32Val = (static_cast<uint32_t>(_pui8Data[0]) << 16) | (static_cast<uint32_t>(_pui8Data[1]) << 8) | _pui8Data[2];
+		return (ui32Val * 0x9E3779B1U) >> (32 - LSC_HASH_BITS);
+	}
+
+}	// namespace lsc
+
+#endif	// __LSC_ZLIBENCODER_H__
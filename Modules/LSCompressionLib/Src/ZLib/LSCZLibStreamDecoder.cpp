@@ -0,0 +1,512 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: An incremental zlib/deflate decoder.  Input can be passed in chunks of any size as it arrives and
+ *	output is written to a window supplied by the caller on each call, so a stream can be decoded while it is still
+ *	being read and without holding either the whole input or the whole output in memory.
+ */
+
+#include "LSCZLibStreamDecoder.h"
+
+
+namespace lsc {
+
+	// == Various constructors.
+	LSE_CALLCTOR CZLibStreamDecoder::CZLibStreamDecoder() :
+		m_pui8Out( NULL ),
+		m_pui8OutStart( NULL ),
+		m_pui8OutEnd( NULL ) {
+		Reset();
+	}
+
+	// == Functions.
+	/**
+	 * Prepares to decode a new stream.
+	 *
+	 * \param _bSkipHeaders If true, the stream is raw deflate data with no zlib header or checksum.
+	 */
+	void LSE_CALL CZLibStreamDecoder::Reset( LSBOOL _bSkipHeaders ) {
+		m_sState = _bSkipHeaders ? LSC_S_BLOCK : LSC_S_HEADER;
+		m_bSkipHeaders = _bSkipHeaders;
+		m_ui32Final = 0;
+		m_ui32Length = m_ui32Distance = m_ui32Extra = 0;
+		m_ui32LitCodes = m_ui32DistCodes = m_ui32ClCodes = m_ui32Have = 0;
+		m_ui32Adler = 1;
+		m_ui64TotalOut = 0ULL;
+		m_ui64BufferedBits = 0ULL;
+		m_ui32TotalBitsBuffered = 0;
+		m_ui32Overrun = 0;
+	}
+
+	/**
+	 * Decodes as much as possible of the given input into the given output.  All state is kept between calls, so
+	 *	input can be passed in chunks of any size and output can be drained between calls.
+	 *
+	 * \param _pui8In The next bytes of the compressed stream.
+	 * \param _uiptrInLen Number of bytes to which _pui8In points.
+	 * \param _uiptrInUsed Holds the number of bytes of input used.  Unused input must be passed again.
+	 * \param _pui8Out Buffer to receive decoded bytes.
+	 * \param _uiptrOutLen Size of the buffer to which _pui8Out points.
+	 * \param _uiptrOutWritten Holds the number of bytes written to _pui8Out.  Bytes of _pui8Out past these may
+	 *	also have been overwritten.
+	 * \return Returns LSC_DS_NEED_INPUT when all input has been used, LSC_DS_OUTPUT_FULL when the output is full,
+	 *	LSC_DS_DONE at the end of the stream, or LSC_DS_ERROR if the stream is invalid.  Errors are sticky until
+	 *	Reset() is called.
+	 */
+	LSC_DECODE_STATUS LSE_CALL CZLibStreamDecoder::Decode( const uint8_t * _pui8In, uintptr_t _uiptrInLen, uintptr_t &_uiptrInUsed,
+		uint8_t * _pui8Out, uintptr_t _uiptrOutLen, uintptr_t &_uiptrOutWritten ) {
+		m_pui8In = _pui8In;
+		m_pui8InEnd = _pui8In + _uiptrInLen;
+		m_pui8Out = m_pui8OutStart = _pui8Out;
+		m_pui8OutEnd = _pui8Out + _uiptrOutLen;
+
+		LSC_DECODE_STATUS dsRet = Run();
+		UpdateAdler();
+
+		if ( dsRet == LSC_DS_DONE ) {
+			// Whole bytes still buffered belong to whatever follows the stream.  Return those that came from this call.
+			uintptr_t uiptrBack = CStd::Min<uintptr_t>( m_ui32TotalBitsBuffered >> 3, static_cast<uintptr_t>(m_pui8In - _pui8In) );
+			m_pui8In -= uiptrBack;
+			m_ui64BufferedBits = 0ULL;
+			m_ui32TotalBitsBuffered = 0;
+		}
+		_uiptrInUsed = static_cast<uintptr_t>(m_pui8In - _pui8In);
+		_uiptrOutWritten = static_cast<uintptr_t>(m_pui8Out - _pui8Out);
+		m_pui8In = m_pui8InEnd = NULL;
+		m_pui8Out = m_pui8OutStart = m_pui8OutEnd = NULL;
+		return dsRet;
+	}
+
+	/**
+	 * Looks up the next symbol in a table without consuming it, buffering input as needed.
+	 *
+	 * \param _pui32Table The table to use.
+	 * \param _ui32RootBits Bits indexing the root of the table.
+	 * \param _ui32Entry Holds the table entry of the symbol.
+	 * \param _ui32Bits Holds the number of bits in the symbol's code.
+	 * \return Returns false if the input ran out before the symbol could be decoded.
+	 */
+	LSBOOL LSE_CALL CZLibStreamDecoder::PeekSymbol( const uint32_t * _pui32Table, uint32_t _ui32RootBits,
+		uint32_t &_ui32Entry, uint32_t &_ui32Bits ) {
+		for ( ; ; ) {
+			// Bits not yet buffered read as 0, so an entry is only trusted once its whole code is buffered.  An invalid
+			//	entry is trusted once all of the bits that index it are buffered.
+			uint32_t ui32Entry = _pui32Table[m_ui64BufferedBits&((1U<<_ui32RootBits)-1)];
+			uint32_t ui32Bits = ui32Entry & LSC_TE_BITS_MASK;
+			if ( ui32Entry & LSC_TE_SUBTABLE ) {
+				uint32_t ui32SubBits = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+				ui32Entry = _pui32Table[(ui32Entry>>LSC_TE_VALUE_SHIFT)+
+					static_cast<uint32_t>((m_ui64BufferedBits>>_ui32RootBits)&((1U<<ui32SubBits)-1))];
+				ui32Bits = _ui32RootBits + ((ui32Entry & LSC_TE_INVALID) ? ui32SubBits : (ui32Entry & LSC_TE_BITS_MASK));
+			}
+			else if ( ui32Entry & LSC_TE_INVALID ) {
+				ui32Bits = _ui32RootBits;
+			}
+			if ( ui32Bits <= m_ui32TotalBitsBuffered ) {
+				_ui32Entry = ui32Entry;
+				_ui32Bits = ui32Bits;
+				return true;
+			}
+			if ( !Need( m_ui32TotalBitsBuffered + 8 ) ) { return false; }
+		}
+	}
+
+	/**
+	 * Runs the state machine until input or output runs out or the stream ends.
+	 *
+	 * \return Returns the status with which to return from Decode().
+	 */
+	LSC_DECODE_STATUS LSE_CALL CZLibStreamDecoder::Run() {
+		static const uint8_t ui8LenDeZigZag[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+		for ( ; ; ) {
+			switch ( m_sState ) {
+				case LSC_S_HEADER : {
+					if ( !Need( 16 ) ) { return LSC_DS_NEED_INPUT; }
+					if ( !CheckHeader() ) { m_sState = LSC_S_ERROR; break; }
+					m_sState = LSC_S_BLOCK;
+					break;
+				}
+				case LSC_S_BLOCK : {
+					if ( m_ui32Final ) {
+						m_sState = m_bSkipHeaders ? LSC_S_DONE : LSC_S_TRAILER;
+						break;
+					}
+					if ( !Need( 3 ) ) { return LSC_DS_NEED_INPUT; }
+					uint32_t ui32Type;
+					Receive( 1, m_ui32Final );
+					Receive( 2, ui32Type );
+					if ( ui32Type == 0 ) {
+						// Move to the next byte boundary.
+						Drop( m_ui32TotalBitsBuffered & 7 );
+						m_sState = LSC_S_STORED_LEN;
+					}
+					else if ( ui32Type == 1 ) {
+						SetDefaults();
+						if ( !BuildTable( m_ui8DefaultLengths, LSE_ELEMENTS( m_ui8DefaultLengths ), LSC_TK_LITLEN,
+							LSC_LITLEN_BITS, m_ui32LitLen, LSE_ELEMENTS( m_ui32LitLen ) ) ||
+							!BuildTable( m_ui8DefaultDistances, LSE_ELEMENTS( m_ui8DefaultDistances ), LSC_TK_DIST,
+							LSC_DIST_BITS, m_ui32Dist, LSE_ELEMENTS( m_ui32Dist ) ) ) {
+							m_sState = LSC_S_ERROR;
+							break;
+						}
+						m_sState = LSC_S_CODES;
+					}
+					else if ( ui32Type == 2 ) {
+						m_sState = LSC_S_TABLE_SIZES;
+					}
+					else {
+						m_sState = LSC_S_ERROR;
+					}
+					break;
+				}
+				case LSC_S_STORED_LEN : {
+					if ( !Need( 32 ) ) { return LSC_DS_NEED_INPUT; }
+					uint32_t ui32LenN;
+					Receive( 16, m_ui32Length );
+					Receive( 16, ui32LenN );
+					m_sState = ui32LenN == (m_ui32Length ^ 0xFFFFUL) ? LSC_S_STORED : LSC_S_ERROR;
+					break;
+				}
+				case LSC_S_STORED : {
+					// Bytes already in the bit buffer come first.
+					while ( m_ui32Length && m_ui32TotalBitsBuffered && m_pui8Out < m_pui8OutEnd ) {
+						Put( static_cast<uint8_t>(m_ui64BufferedBits) );
+						Drop( 8 );
+						--m_ui32Length;
+					}
+					if ( m_ui32Length && !m_ui32TotalBitsBuffered ) {
+						uint32_t ui32Copy = static_cast<uint32_t>(CStd::Min<uintptr_t>( CStd::Min<uintptr_t>( m_ui32Length,
+							static_cast<uintptr_t>(m_pui8InEnd - m_pui8In) ), static_cast<uintptr_t>(m_pui8OutEnd - m_pui8Out) ));
+						PutBytes( m_pui8In, ui32Copy );
+						m_pui8In += ui32Copy;
+						m_ui32Length -= ui32Copy;
+					}
+					if ( !m_ui32Length ) {
+						m_sState = LSC_S_BLOCK;
+						break;
+					}
+					return m_pui8Out == m_pui8OutEnd ? LSC_DS_OUTPUT_FULL : LSC_DS_NEED_INPUT;
+				}
+				case LSC_S_TABLE_SIZES : {
+					if ( !Need( 14 ) ) { return LSC_DS_NEED_INPUT; }
+					Receive( 5, m_ui32LitCodes );
+					m_ui32LitCodes += 257;
+					Receive( 5, m_ui32DistCodes );
+					m_ui32DistCodes += 1;
+					Receive( 4, m_ui32ClCodes );
+					m_ui32ClCodes += 4;
+					CStd::MemSet( m_ui8ClLengths, 0, sizeof( m_ui8ClLengths ) );
+					m_ui32Have = 0;
+					m_sState = LSC_S_CODE_LENGTH_LENS;
+					break;
+				}
+				case LSC_S_CODE_LENGTH_LENS : {
+					for ( ; m_ui32Have < m_ui32ClCodes; ++m_ui32Have ) {
+						if ( !Need( 3 ) ) { return LSC_DS_NEED_INPUT; }
+						uint32_t ui32S;
+						Receive( 3, ui32S );
+						m_ui8ClLengths[ui8LenDeZigZag[m_ui32Have]] = static_cast<uint8_t>(ui32S);
+					}
+					if ( !BuildTable( m_ui8ClLengths, LSE_ELEMENTS( m_ui8ClLengths ), LSC_TK_CODE_LENGTH,
+						LSC_CL_BITS, m_ui32ClTable, LSE_ELEMENTS( m_ui32ClTable ) ) ) {
+						m_sState = LSC_S_ERROR;
+						break;
+					}
+					m_ui32Have = 0;
+					m_sState = LSC_S_CODE_LENGTHS;
+					break;
+				}
+				case LSC_S_CODE_LENGTHS : {
+					uint32_t ui32Total = m_ui32LitCodes + m_ui32DistCodes;
+					while ( m_ui32Have < ui32Total ) {
+						// Code-length codes are at most 7 bits, so the table has no subtables.  A code and its repeat
+						//	count are consumed together.
+						uint32_t ui32Entry, ui32Bits;
+						if ( !PeekSymbol( m_ui32ClTable, LSC_CL_BITS, ui32Entry, ui32Bits ) ) { return LSC_DS_NEED_INPUT; }
+						if ( ui32Entry & LSC_TE_INVALID ) { m_sState = LSC_S_ERROR; break; }
+						uint32_t ui32Code = ui32Entry >> LSC_TE_VALUE_SHIFT;
+						if ( ui32Code < 16 ) {
+							Drop( ui32Bits );
+							m_ui8Lengths[m_ui32Have++] = static_cast<uint8_t>(ui32Code);
+							continue;
+						}
+						static const uint8_t ui8RepeatBits[3] = { 2, 3, 7 };
+						static const uint8_t ui8RepeatBase[3] = { 3, 3, 11 };
+						uint32_t ui32RepeatBits = ui8RepeatBits[ui32Code-16];
+						if ( !Need( ui32Bits + ui32RepeatBits ) ) { return LSC_DS_NEED_INPUT; }
+						Drop( ui32Bits );
+						uint32_t ui32Repeat;
+						Receive( ui32RepeatBits, ui32Repeat );
+						ui32Repeat += ui8RepeatBase[ui32Code-16];
+						uint8_t ui8Value = 0;
+						if ( ui32Code == 16 ) {
+							if ( !m_ui32Have ) { m_sState = LSC_S_ERROR; break; }
+							ui8Value = m_ui8Lengths[m_ui32Have-1];
+						}
+						if ( m_ui32Have + ui32Repeat > ui32Total ) { m_sState = LSC_S_ERROR; break; }
+						CStd::MemSet( &m_ui8Lengths[m_ui32Have], ui8Value, ui32Repeat );
+						m_ui32Have += ui32Repeat;
+					}
+					if ( m_sState == LSC_S_ERROR ) { break; }
+					if ( !BuildTable( m_ui8Lengths, m_ui32LitCodes, LSC_TK_LITLEN, LSC_LITLEN_BITS, m_ui32LitLen, LSE_ELEMENTS( m_ui32LitLen ) ) ||
+						!BuildTable( m_ui8Lengths + m_ui32LitCodes, m_ui32DistCodes, LSC_TK_DIST, LSC_DIST_BITS, m_ui32Dist, LSE_ELEMENTS( m_ui32Dist ) ) ) {
+						m_sState = LSC_S_ERROR;
+						break;
+					}
+					m_sState = LSC_S_CODES;
+					break;
+				}
+				case LSC_S_CODES : {
+					// Most symbols are handled by the fast loop.  Those near the end of the input or output are decoded
+					//	here one at a time.
+					DecodeFast();
+					if ( m_sState != LSC_S_CODES ) { break; }
+					Need( 56 );
+					uint32_t ui32Entry, ui32Bits;
+					if ( !PeekSymbol( m_ui32LitLen, LSC_LITLEN_BITS, ui32Entry, ui32Bits ) ) { return LSC_DS_NEED_INPUT; }
+					if ( ui32Entry & LSC_TE_LITERAL ) {
+						if ( m_pui8Out == m_pui8OutEnd ) { return LSC_DS_OUTPUT_FULL; }
+						Drop( ui32Bits );
+						Put( static_cast<uint8_t>(ui32Entry >> LSC_TE_VALUE_SHIFT) );
+					}
+					else if ( ui32Entry & LSC_TE_INVALID ) {
+						m_sState = LSC_S_ERROR;
+					}
+					else if ( ui32Entry & LSC_TE_END ) {
+						Drop( ui32Bits );
+						m_sState = LSC_S_BLOCK;
+					}
+					else {
+						Drop( ui32Bits );
+						m_ui32Length = ui32Entry >> LSC_TE_VALUE_SHIFT;
+						m_ui32Extra = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+						m_sState = LSC_S_LEN_EXTRA;
+					}
+					break;
+				}
+				case LSC_S_LEN_EXTRA : {
+					if ( !Need( m_ui32Extra ) ) { return LSC_DS_NEED_INPUT; }
+					uint32_t ui32Extra;
+					Receive( m_ui32Extra, ui32Extra );
+					m_ui32Length += ui32Extra;
+					m_sState = LSC_S_DIST;
+					break;
+				}
+				case LSC_S_DIST : {
+					uint32_t ui32Entry, ui32Bits;
+					if ( !PeekSymbol( m_ui32Dist, LSC_DIST_BITS, ui32Entry, ui32Bits ) ) { return LSC_DS_NEED_INPUT; }
+					if ( ui32Entry & LSC_TE_INVALID ) { m_sState = LSC_S_ERROR; break; }
+					Drop( ui32Bits );
+					m_ui32Distance = ui32Entry >> LSC_TE_VALUE_SHIFT;
+					m_ui32Extra = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+					m_sState = LSC_S_DIST_EXTRA;
+					break;
+				}
+				case LSC_S_DIST_EXTRA : {
+					if ( !Need( m_ui32Extra ) ) { return LSC_DS_NEED_INPUT; }
+					uint32_t ui32Extra;
+					Receive( m_ui32Extra, ui32Extra );
+					m_ui32Distance += ui32Extra;
+					if ( m_ui32Distance > m_ui64TotalOut ) { m_sState = LSC_S_ERROR; break; }
+					m_sState = LSC_S_COPY;
+					break;
+				}
+				case LSC_S_COPY : {
+					uint32_t ui32Copy = static_cast<uint32_t>(CStd::Min<uintptr_t>( m_ui32Length, static_cast<uintptr_t>(m_pui8OutEnd - m_pui8Out) ));
+					// The window is a power of 2 in size, so the source wraps with the same mask as the destination.
+					uint32_t ui32Src = static_cast<uint32_t>(m_ui64TotalOut) - m_ui32Distance;
+					for ( uint32_t I = 0; I < ui32Copy; ++I ) {
+						Put( m_ui8Window[(ui32Src+I)&LSC_WINDOW_MASK] );
+					}
+					m_ui32Length -= ui32Copy;
+					if ( m_ui32Length ) { return LSC_DS_OUTPUT_FULL; }
+					m_sState = LSC_S_CODES;
+					break;
+				}
+				case LSC_S_TRAILER : {
+					// The Adler-32 checksum is stored big-endian on the next byte boundary.
+					Drop( m_ui32TotalBitsBuffered & 7 );
+					if ( !Need( 32 ) ) { return LSC_DS_NEED_INPUT; }
+					uint32_t ui32Check = 0;
+					for ( uint32_t I = 0; I < 4; ++I ) {
+						uint32_t ui32Byte;
+						Receive( 8, ui32Byte );
+						ui32Check = (ui32Check << 8) | ui32Byte;
+					}
+					UpdateAdler();
+					m_sState = ui32Check == m_ui32Adler ? LSC_S_DONE : LSC_S_ERROR;
+					break;
+				}
+				case LSC_S_DONE : {
+					return LSC_DS_DONE;
+				}
+				default : {
+					return LSC_DS_ERROR;
+				}
+			}
+		}
+	}
+
+	/**
+	 * Decodes symbols while at least LSC_FAST_IN bytes of input and LSC_FAST_OUT bytes of output remain, enough for
+	 *	any symbol and its match.  Stops at the end of the block, setting m_sState to LSC_S_BLOCK, or at invalid data,
+	 *	setting it to LSC_S_ERROR.
+	 */
+	void LSE_CALL CZLibStreamDecoder::DecodeFast() {
+		// Everything is kept in locals; writes through the output pointer could otherwise alias the members.
+		uint64_t ui64Bits = m_ui64BufferedBits;
+		uint32_t ui32Count = m_ui32TotalBitsBuffered;
+		const uint8_t * pui8In = m_pui8In;
+		const uint8_t * pui8InEnd = m_pui8InEnd;
+		uint8_t * pui8Out = m_pui8Out;
+		uint8_t * pui8OutBegin = m_pui8Out;
+		const uint8_t * pui8OutEnd = m_pui8OutEnd;
+		// Output written by this call is contiguous and can be copied from directly.  Earlier output is in the window.
+		const uint8_t * pui8OutStart = m_pui8OutStart;
+		uint64_t ui64Before = m_ui64TotalOut - static_cast<uint64_t>(pui8OutBegin - pui8OutStart);
+		const uint8_t * pui8Window = m_ui8Window;
+		const uint32_t * pui32LitLen = m_ui32LitLen;
+		const uint32_t * pui32Dist = m_ui32Dist;
+		LSC_STATE sState = LSC_S_CODES;
+
+		while ( pui8InEnd - pui8In >= LSC_FAST_IN && pui8OutEnd - pui8Out >= LSC_FAST_OUT ) {
+			// Only whole bytes are buffered, so that bits above ui32Count are always 0.
+			while ( ui32Count <= 56 ) {
+				ui64Bits |= static_cast<uint64_t>(*pui8In++) << ui32Count;
+				ui32Count += 8;
+			}
+			uint32_t ui32Entry = pui32LitLen[ui64Bits&((1<<LSC_LITLEN_BITS)-1)];
+			if ( ui32Entry & LSC_TE_SUBTABLE ) {
+				ui64Bits >>= LSC_LITLEN_BITS;
+				ui32Count -= LSC_LITLEN_BITS;
+				ui32Entry = pui32LitLen[(ui32Entry>>LSC_TE_VALUE_SHIFT)+
+					static_cast<uint32_t>(ui64Bits&((1U<<((ui32Entry>>LSC_TE_EXTRA_SHIFT)&LSC_TE_EXTRA_MASK))-1))];
+			}
+			if ( ui32Entry & LSC_TE_INVALID ) {
+				sState = LSC_S_ERROR;
+				break;
+			}
+			ui64Bits >>= ui32Entry & LSC_TE_BITS_MASK;
+			ui32Count -= ui32Entry & LSC_TE_BITS_MASK;
+			if ( ui32Entry & LSC_TE_LITERAL ) {
+				(*pui8Out++) = static_cast<uint8_t>(ui32Entry >> LSC_TE_VALUE_SHIFT);
+				continue;
+			}
+			if ( ui32Entry & LSC_TE_END ) {
+				sState = LSC_S_BLOCK;
+				break;
+			}
+
+			uint32_t ui32Extra = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+			uint32_t ui32Len = (ui32Entry >> LSC_TE_VALUE_SHIFT) + static_cast<uint32_t>(ui64Bits & ((1U << ui32Extra) - 1));
+			ui64Bits >>= ui32Extra;
+			ui32Count -= ui32Extra;
+
+			ui32Entry = pui32Dist[ui64Bits&((1<<LSC_DIST_BITS)-1)];
+			if ( ui32Entry & LSC_TE_SUBTABLE ) {
+				ui64Bits >>= LSC_DIST_BITS;
+				ui32Count -= LSC_DIST_BITS;
+				ui32Entry = pui32Dist[(ui32Entry>>LSC_TE_VALUE_SHIFT)+
+					static_cast<uint32_t>(ui64Bits&((1U<<((ui32Entry>>LSC_TE_EXTRA_SHIFT)&LSC_TE_EXTRA_MASK))-1))];
+			}
+			ui64Bits >>= ui32Entry & LSC_TE_BITS_MASK;
+			ui32Count -= ui32Entry & LSC_TE_BITS_MASK;
+			ui32Extra = (ui32Entry >> LSC_TE_EXTRA_SHIFT) & LSC_TE_EXTRA_MASK;
+			uint32_t ui32Dist = (ui32Entry >> LSC_TE_VALUE_SHIFT) + static_cast<uint32_t>(ui64Bits & ((1U << ui32Extra) - 1));
+			ui64Bits >>= ui32Extra;
+			ui32Count -= ui32Extra;
+			uintptr_t uiptrDone = static_cast<uintptr_t>(pui8Out - pui8OutStart);
+			if ( (ui32Entry & LSC_TE_INVALID) || ui32Dist > ui64Before + uiptrDone ) {
+				sState = LSC_S_ERROR;
+				break;
+			}
+
+			uint32_t I = 0;
+			if ( ui32Dist > uiptrDone ) {
+				// The start of the match was written by an earlier call.  The window is not updated until the loop
+				//	ends, so it still holds exactly that output.
+				uint32_t ui32FromWindow = CStd::Min<uint32_t>( ui32Len, ui32Dist - static_cast<uint32_t>(uiptrDone) );
+				uint32_t ui32Src = static_cast<uint32_t>(ui64Before + uiptrDone) - ui32Dist;
+				for ( ; I < ui32FromWindow; ++I ) {
+					pui8Out[I] = pui8Window[(ui32Src+I)&LSC_WINDOW_MASK];
+				}
+			}
+			if ( I < ui32Len ) {
+				const uint8_t * pui8Src = pui8Out - ui32Dist;
+				if ( ui32Dist >= 8 ) {
+					// There is always room for the up-to 7 bytes this writes past the end of the match.
+					do {
+						Copy8( pui8Out + I, pui8Src + I );
+						I += 8;
+					} while ( I < ui32Len );
+				}
+				else {
+					for ( ; I < ui32Len; ++I ) {
+						pui8Out[I] = pui8Src[I];
+					}
+				}
+			}
+			pui8Out += ui32Len;
+		}
+
+		m_ui64BufferedBits = ui64Bits;
+		m_ui32TotalBitsBuffered = ui32Count;
+		m_pui8In = pui8In;
+		m_pui8Out = pui8Out;
+		m_sState = sState;
+		AddToWindow( pui8OutBegin, static_cast<uintptr_t>(pui8Out - pui8OutBegin) );
+	}
+
+	/**
+	 * Adds the output written since the last update to the checksum.
+	 */
+	void LSE_CALL CZLibStreamDecoder::UpdateAdler() {
+		if ( !m_bSkipHeaders ) {
+			m_ui32Adler = Adler32( m_pui8OutStart, static_cast<uintptr_t>(m_pui8Out - m_pui8OutStart), m_ui32Adler );
+		}
+		m_pui8OutStart = m_pui8Out;
+	}
+
+	/**
+	 * Copies stored bytes to the output and window.
+	 *
+	 * \param _pui8Src The bytes to copy.
+	 * \param _ui32Len The number of bytes to copy.  There must be room in the output.
+	 */
+	void LSE_CALL CZLibStreamDecoder::PutBytes( const uint8_t * _pui8Src, uint32_t _ui32Len ) {
+		if ( !_ui32Len ) { return; }
+		CStd::MemCpy( m_pui8Out, _pui8Src, _ui32Len );
+		m_pui8Out += _ui32Len;
+		AddToWindow( _pui8Src, _ui32Len );
+	}
+
+	/**
+	 * Adds bytes that have been written to the output to the window.
+	 *
+	 * \param _pui8Src The bytes to add.
+	 * \param _uiptrLen The number of bytes to add.
+	 */
+	void LSE_CALL CZLibStreamDecoder::AddToWindow( const uint8_t * _pui8Src, uintptr_t _uiptrLen ) {
+		// Only the last window's worth matters.
+		if ( _uiptrLen > LSC_WINDOW_SIZE ) {
+			m_ui64TotalOut += _uiptrLen - LSC_WINDOW_SIZE;
+			_pui8Src += _uiptrLen - LSC_WINDOW_SIZE;
+			_uiptrLen = LSC_WINDOW_SIZE;
+		}
+		uint32_t ui32Len = static_cast<uint32_t>(_uiptrLen);
+		uint32_t ui32Pos = static_cast<uint32_t>(m_ui64TotalOut) & LSC_WINDOW_MASK;
+		uint32_t ui32First = CStd::Min<uint32_t>( ui32Len, LSC_WINDOW_SIZE - ui32Pos );
+		CStd::MemCpy( &m_ui8Window[ui32Pos], _pui8Src, ui32First );
+		CStd::MemCpy( m_ui8Window, _pui8Src + ui32First, ui32Len - ui32First );
+		m_ui64TotalOut += ui32Len;
+	}
+
+}	// namespace lsc
@@ -0,0 +1,325 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: An incremental zlib/deflate decoder.  Input can be passed in chunks of any size as it arrives and
+ *	output is written to a window supplied by the caller on each call, so a stream can be decoded while it is still
+ *	being read and without holding either the whole input or the whole output in memory.
+ */
+
+
+#ifndef __LSC_ZLIBSTREAMDECODER_H__
+#define __LSC_ZLIBSTREAMDECODER_H__
+
+#include "../LSCCompressionLib.h"
+#include "LSCZLib.h"
+
+namespace lsc {
+
+	/**
+	 * Class CZLibStreamDecoder
+	 * \brief An incremental zlib/deflate decoder.
+	 *
+	 * Description: An incremental zlib/deflate decoder.  Input can be passed in chunks of any size as it arrives and
+	 *	output is written to a window supplied by the caller on each call, so a stream can be decoded while it is still
+	 *	being read and without holding either the whole input or the whole output in memory.
+	 */
+	class CZLibStreamDecoder : protected CZLib {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR					CZLibStreamDecoder();
+
+
+		// == Functions.
+		/**
+		 * Prepares to decode a new stream.
+		 *
+		 * \param _bSkipHeaders If true, the stream is raw deflate data with no zlib header or checksum.
+		 */
+		void LSE_CALL					Reset( LSBOOL _bSkipHeaders = false );
+
+		/**
+		 * Decodes as much as possible of the given input into the given output.  All state is kept between calls, so
+		 *	input can be passed in chunks of any size and output can be drained between calls.
+		 *
+		 * \param _pui8In The next bytes of the compressed stream.
+		 * \param _uiptrInLen Number of bytes to which _pui8In points.
+		 * \param _uiptrInUsed Holds the number of bytes of input used.  Unused input must be passed again.
+		 * \param _pui8Out Buffer to receive decoded bytes.
+		 * \param _uiptrOutLen Size of the buffer to which _pui8Out points.
+		 * \param _uiptrOutWritten Holds the number of bytes written to _pui8Out.  Bytes of _pui8Out past these may
+		 *	also have been overwritten.
+		 * \return Returns LSC_DS_NEED_INPUT when all input has been used, LSC_DS_OUTPUT_FULL when the output is full,
+		 *	LSC_DS_DONE at the end of the stream, or LSC_DS_ERROR if the stream is invalid.  Errors are sticky until
+		 *	Reset() is called.
+		 */
+		LSC_DECODE_STATUS LSE_CALL		Decode( const uint8_t * _pui8In, uintptr_t _uiptrInLen, uintptr_t &_uiptrInUsed,
+			uint8_t * _pui8Out, uintptr_t _uiptrOutLen, uintptr_t &_uiptrOutWritten );
+
+		/**
+		 * Gets the total number of bytes decoded since the last Reset().
+		 *
+		 * \return Returns the total number of bytes decoded since the last Reset().
+		 */
+		LSE_INLINE uint64_t LSE_CALL	TotalOut() const;
+
+
+	protected :
+		// == Enumerations.
+		/**
+		 * Window metrics.  Matches can reach back 32 kilobytes, possibly into output from earlier calls.
+		 */
+		enum {
+			LSC_WINDOW_SIZE				= 32768,
+			LSC_WINDOW_MASK				= LSC_WINDOW_SIZE - 1,
+		};
+
+		/**
+		 * Decoder states.
+		 */
+		enum LSC_STATE {
+			LSC_S_HEADER,
+			LSC_S_BLOCK,
+			LSC_S_STORED_LEN,
+			LSC_S_STORED,
+			LSC_S_TABLE_SIZES,
+			LSC_S_CODE_LENGTH_LENS,
+			LSC_S_CODE_LENGTHS,
+			LSC_S_CODES,
+			LSC_S_LEN_EXTRA,
+			LSC_S_DIST,
+			LSC_S_DIST_EXTRA,
+			LSC_S_COPY,
+			LSC_S_TRAILER,
+			LSC_S_DONE,
+			LSC_S_ERROR,
+		};
+
+
+		// == Members.
+		/**
+		 * The current state.
+		 */
+		LSC_STATE						m_sState;
+
+		/**
+		 * If true, there is no zlib header or checksum.
+		 */
+		LSBOOL							m_bSkipHeaders;
+
+		/**
+		 * Set when the final block has begun.
+		 */
+		uint32_t						m_ui32Final;
+
+		/**
+		 * Bytes left in a stored block, or the length of the current match.
+		 */
+		uint32_t						m_ui32Length;
+
+		/**
+		 * The distance of the current match.
+		 */
+		uint32_t						m_ui32Distance;
+
+		/**
+		 * Extra bits to read for the current length or distance.
+		 */
+		uint32_t						m_ui32Extra;
+
+		/**
+		 * Number of literal/length codes in the current dynamic block.
+		 */
+		uint32_t						m_ui32LitCodes;
+
+		/**
+		 * Number of distance codes in the current dynamic block.
+		 */
+		uint32_t						m_ui32DistCodes;
+
+		/**
+		 * Number of code-length code lengths in the current dynamic block.
+		 */
+		uint32_t						m_ui32ClCodes;
+
+		/**
+		 * Number of code lengths read so far.
+		 */
+		uint32_t						m_ui32Have;
+
+		/**
+		 * Code lengths of the current dynamic block.
+		 */
+		uint8_t							m_ui8Lengths[288+32];
+
+		/**
+		 * Code-length code lengths of the current dynamic block.
+		 */
+		uint8_t							m_ui8ClLengths[19];
+
+		/**
+		 * Code-length decoding table.
+		 */
+		uint32_t						m_ui32ClTable[LSC_CL_ENOUGH];
+
+		/**
+		 * The running Adler-32 checksum of the output.
+		 */
+		uint32_t						m_ui32Adler;
+
+		/**
+		 * Total bytes decoded.  The window position is the low bits of this.
+		 */
+		uint64_t						m_ui64TotalOut;
+
+		/**
+		 * The next output byte.
+		 */
+		uint8_t *						m_pui8Out;
+
+		/**
+		 * The first output byte not yet added to the checksum.
+		 */
+		uint8_t *						m_pui8OutStart;
+
+		/**
+		 * The end of the output.
+		 */
+		uint8_t *						m_pui8OutEnd;
+
+		/**
+		 * The last 32 kilobytes of output.
+		 */
+		uint8_t							m_ui8Window[LSC_WINDOW_SIZE];
+
+
+		// == Functions.
+		/**
+		 * Buffers input bytes until at least the given number of bits is buffered.
+		 *
+		 * \param _ui32Bits The number of bits needed, at most 56.
+		 * \return Returns false if the input ran out first.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL		Need( uint32_t _ui32Bits );
+
+		/**
+		 * Discards bits from the bit buffer.
+		 *
+		 * \param _ui32Bits The number of bits to discard.
+		 */
+		LSE_INLINE void LSE_CALL		Drop( uint32_t _ui32Bits );
+
+		/**
+		 * Writes a byte to the output and the window.  There must be room in the output.
+		 *
+		 * \param _ui8Byte The byte to write.
+		 */
+		LSE_INLINE void LSE_CALL		Put( uint8_t _ui8Byte );
+
+		/**
+		 * Looks up the next symbol in a table without consuming it, buffering input as needed.
+		 *
+		 * \param _pui32Table The table to use.
+		 * \param _ui32RootBits Bits indexing the root of the table.
+		 * \param _ui32Entry Holds the table entry of the symbol.
+		 * \param _ui32Bits Holds the number of bits in the symbol's code.
+		 * \return Returns false if the input ran out before the symbol could be decoded.
+		 */
+		LSBOOL LSE_CALL					PeekSymbol( const uint32_t * _pui32Table, uint32_t _ui32RootBits,
+			uint32_t &_ui32Entry, uint32_t &_ui32Bits );
+
+		/**
+		 * Decodes symbols while at least LSC_FAST_IN bytes of input and LSC_FAST_OUT bytes of output remain, enough for
+		 *	any symbol and its match.  Stops at the end of the block, setting m_sState to LSC_S_BLOCK, or at invalid data,
+		 *	setting it to LSC_S_ERROR.
+		 */
+		void LSE_CALL					DecodeFast();
+
+		/**
+		 * Runs the state machine until input or output runs out or the stream ends.
+		 *
+		 * \return Returns the status with which to return from Decode().
+		 */
+		LSC_DECODE_STATUS LSE_CALL		Run();
+
+		/**
+		 * Adds the output written since the last update to the checksum.
+		 */
+		void LSE_CALL					UpdateAdler();
+
+		/**
+		 * Copies stored bytes to the output and window.
+		 *
+		 * \param _pui8Src The bytes to copy.
+		 * \param _ui32Len The number of bytes to copy.  There must be room in the output.
+		 */
+		void LSE_CALL					PutBytes( const uint8_t * _pui8Src, uint32_t _ui32Len );
+
+		/**
+		 * Adds bytes that have been written to the output to the window.
+		 *
+		 * \param _pui8Src The bytes to add.
+		 * \param _uiptrLen The number of bytes to add.
+		 */
+		void LSE_CALL					AddToWindow( const uint8_t * _pui8Src, uintptr_t _uiptrLen );
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Gets the total number of bytes decoded since the last Reset().
+	 *
+	 * \return Returns the total number of bytes decoded since the last Reset().
+	 */
+	LSE_INLINE uint64_t LSE_CALL CZLibStreamDecoder::TotalOut() const {
+		return m_ui64TotalOut;
+	}
+
+	/**
+	 * Buffers input bytes until at least the given number of bits is buffered.
+	 *
+	 * \param _ui32Bits The number of bits needed, at most 56.
+	 * \return Returns false if the input ran out first.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CZLibStreamDecoder::Need( uint32_t _ui32Bits ) {
+		while ( m_ui32TotalBitsBuffered < _ui32Bits ) {
+			if ( m_pui8In == m_pui8InEnd ) { return false; }
+			m_ui64BufferedBits |= static_cast<uint64_t>(*m_pui8In++) << m_ui32TotalBitsBuffered;
+			m_ui32TotalBitsBuffered += 8;
+		}
+		return true;
+	}
+
+	/**
+	 * Discards bits from the bit buffer.
+	 *
+	 * \param _ui32Bits The number of bits to discard.
+	 */
+	LSE_INLINE void LSE_CALL CZLibStreamDecoder::Drop( uint32_t _ui32Bits ) {
+		m_ui64BufferedBits >>= _ui32Bits;
+		m_ui32TotalBitsBuffered -= _ui32Bits;
+	}
+
+	/**
+	 * Writes a byte to the output and the window.  There must be room in the output.
+	 *
+	 * \param _ui8Byte The byte to write.
+	 */
+	LSE_INLINE void LSE_CALL CZLibStreamDecoder::Put( uint8_t _ui8Byte ) {
+		(*m_pui8Out++) = _ui8Byte;
+		m_ui8Window[static_cast<uint32_t>(m_ui64TotalOut++)&LSC_WINDOW_MASK] = _ui8Byte;
+	}
+
+}	// namespace lsc
+
+#endif	// __LSC_ZLIBSTREAMDECODER_H__
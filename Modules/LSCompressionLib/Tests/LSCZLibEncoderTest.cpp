@@ -0,0 +1,169 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Round-trip test for CZLibEncoder.  Every byte value is encoded at every level in every format (so
+ *	that both the fixed and the dynamic Huffman codes are used for all literals), decoded with CZLib, and decoded
+ *	again with zlib's inflate() as a cross-check against a reference decoder.  Build it with LSCompressionLib and
+ *	its dependencies, plus zlib (the copy under LSImageLib/Src/FreeImage/Source/ZLib will do).  Returns 0 if all
+ *	tests pass.
+ */
+
+#include "LSCCompressionLib.h"
+#include "LSAMemLib.h"
+#include "ZLib/LSCZLib.h"
+#include "ZLib/LSCZLibEncoder.h"
+#include <cstdio>
+#include <cstring>
+#include <zlib.h>
+
+
+/**
+ * Decodes the output of the encoder with CZLib.
+ *
+ * \param _pui8Src The encoded data.
+ * \param _ui32SrcLen Length of the encoded data.
+ * \param _zfFormat Format of the encoded data.
+ * \param _zbOut Holds the decoded data.
+ * \return Returns true if the data was decoded.
+ */
+static LSBOOL LSE_CALL DecodeLsc( const uint8_t * _pui8Src, uint32_t _ui32SrcLen, lsc::CZLibEncoder::LSC_ZLIB_FORMAT _zfFormat,
+	lsc::CZLib::LSC_ZLIB_BUFFER &_zbOut ) {
+	// CZLib reads zlib streams, or raw deflate streams if told to skip the header.  The gzip header has no extra fields.
+	lsc::CZLib zlDecoder;
+	switch ( _zfFormat ) {
+		case lsc::CZLibEncoder::LSC_ZF_ZLIB : {
+			return zlDecoder.DecodeZLib( _pui8Src, _ui32SrcLen, false, _zbOut );
+		}
+		case lsc::CZLibEncoder::LSC_ZF_GZIP : {
+			if ( _ui32SrcLen < 10 ) { return false; }
+			return zlDecoder.DecodeZLib( _pui8Src + 10, _ui32SrcLen - 10, true, _zbOut );
+		}
+		default : {
+			return zlDecoder.DecodeZLib( _pui8Src, _ui32SrcLen, true, _zbOut );
+		}
+	}
+}
+
+/**
+ * Decodes the output of the encoder with zlib.
+ *
+ * \param _pui8Src The encoded data.
+ * \param _ui32SrcLen Length of the encoded data.
+ * \param _zfFormat Format of the encoded data.
+ * \param _pui8Dst Holds the decoded data.
+ * \param _ui32DstLen Size of the buffer to which _pui8Dst points.
+ * \param _ui32Decoded Holds the number of decoded bytes.
+ * \return Returns true if zlib decoded the whole stream without errors.
+ */
+static LSBOOL LSE_CALL DecodeZlib( const uint8_t * _pui8Src, uint32_t _ui32SrcLen, lsc::CZLibEncoder::LSC_ZLIB_FORMAT _zfFormat,
+	uint8_t * _pui8Dst, uint32_t _ui32DstLen, uint32_t &_ui32Decoded ) {
+	z_stream zsStream;
+	::memset( &zsStream, 0, sizeof( zsStream ) );
+	int iWindowBits = MAX_WBITS;
+	if ( _zfFormat == lsc::CZLibEncoder::LSC_ZF_DEFLATE ) { iWindowBits = -MAX_WBITS; }
+	else if ( _zfFormat == lsc::CZLibEncoder::LSC_ZF_GZIP ) { iWindowBits = MAX_WBITS + 16; }
+	if ( ::inflateInit2( &zsStream, iWindowBits ) != Z_OK ) { return false; }
+	zsStream.next_in = const_cast<Bytef *>(_pui8Src);
+	zsStream.avail_in = _ui32SrcLen;
+	zsStream.next_out = _pui8Dst;
+	zsStream.avail_out = _ui32DstLen;
+	int iRet = ::inflate( &zsStream, Z_FINISH );
+	_ui32Decoded = static_cast<uint32_t>(zsStream.total_out);
+	// The whole input must be consumed: trailing garbage would mean the stream ended early.
+	LSBOOL bRet = iRet == Z_STREAM_END && zsStream.avail_in == 0;
+	::inflateEnd( &zsStream );
+	return bRet;
+}
+
+/**
+ * Encodes a buffer at every level in every format and checks that both decoders give it back.
+ *
+ * \param _pcName Name of the test, for printing.
+ * \param _pui8Data The data to encode.
+ * \param _ui32Len Length of the data.
+ * \return Returns the number of failures.
+ */
+static uint32_t LSE_CALL RoundTrip( const char * _pcName, const uint8_t * _pui8Data, uint32_t _ui32Len ) {
+	static const char * pcFormats[] = { "deflate", "zlib", "gzip" };
+	static uint8_t ui8Inflated[0x10000];
+	uint32_t ui32Fails = 0;
+	for ( uint32_t ui32Level = 0; ui32Level <= 9; ++ui32Level ) {
+		for ( uint32_t F = lsc::CZLibEncoder::LSC_ZF_DEFLATE; F <= lsc::CZLibEncoder::LSC_ZF_GZIP; ++F ) {
+			lsc::CZLibEncoder::LSC_ZLIB_FORMAT zfFormat = static_cast<lsc::CZLibEncoder::LSC_ZLIB_FORMAT>(F);
+			lsc::CZLibEncoder zeEncoder;
+			lsc::CZLib::LSC_ZLIB_BUFFER zbEncoded, zbDecoded;
+			if ( !zeEncoder.Encode( _pui8Data, _ui32Len, ui32Level, zfFormat, zbEncoded ) ) {
+				::printf( "FAILED: %s, level %u, %s: Encode() failed.\r\n", _pcName, ui32Level, pcFormats[F] );
+				++ui32Fails;
+				continue;
+			}
+
+			if ( !DecodeLsc( &zbEncoded[0], zbEncoded.Length(), zfFormat, zbDecoded ) ||
+				zbDecoded.Length() != _ui32Len || (_ui32Len && std::memcmp( &zbDecoded[0], _pui8Data, _ui32Len ) != 0) ) {
+				::printf( "FAILED: %s, level %u, %s: CZLib did not decode the original data.\r\n", _pcName, ui32Level, pcFormats[F] );
+				++ui32Fails;
+			}
+
+			uint32_t ui32Inflated = 0;
+			if ( !DecodeZlib( &zbEncoded[0], zbEncoded.Length(), zfFormat, ui8Inflated, sizeof( ui8Inflated ), ui32Inflated ) ||
+				ui32Inflated != _ui32Len || (_ui32Len && std::memcmp( ui8Inflated, _pui8Data, _ui32Len ) != 0) ) {
+				::printf( "FAILED: %s, level %u, %s: zlib did not decode the original data.\r\n", _pcName, ui32Level, pcFormats[F] );
+				++ui32Fails;
+			}
+		}
+	}
+	return ui32Fails;
+}
+
+/**
+ * The main entrypoint for this program.
+ *
+ * \return Returns 0 if all tests pass, 1 otherwise.
+ */
+int LSE_CCALL main() {
+	lsa::CMemLib::Init( 0x100000, true );
+	uint32_t ui32Fails = 0;
+	{
+		char szName[32];
+		uint8_t ui8Data[0x1000];
+		// Each byte value on its own and followed by another, so that short inputs get the fixed code.
+		for ( uint32_t I = 0; I < 256; ++I ) {
+			ui8Data[0] = static_cast<uint8_t>(I);
+			ui8Data[1] = static_cast<uint8_t>(I ^ 0xEF);
+			::sprintf( szName, "{0x%.2X}", I );
+			ui32Fails += RoundTrip( szName, ui8Data, 1 );
+			::sprintf( szName, "{0x%.2X,0x%.2X}", ui8Data[0], ui8Data[1] );
+			ui32Fails += RoundTrip( szName, ui8Data, 2 );
+		}
+
+		// All byte values in order, then in an order with no repeats worth matching, then repeated so that matches
+		//	and literals mix.
+		for ( uint32_t I = 0; I < 256; ++I ) { ui8Data[I] = static_cast<uint8_t>(I); }
+		ui32Fails += RoundTrip( "0x00-0xFF", ui8Data, 256 );
+		for ( uint32_t I = 0; I < 256; ++I ) { ui8Data[I] = static_cast<uint8_t>(I * 167 + 13); }
+		ui32Fails += RoundTrip( "0x00-0xFF shuffled", ui8Data, 256 );
+		uint32_t ui32Seed = 1;
+		for ( uint32_t I = 256; I < sizeof( ui8Data ); ++I ) {
+			ui32Seed = ui32Seed * 1103515245 + 12345;
+			ui8Data[I] = (ui32Seed >> 28) ? ui8Data[I-256+((ui32Seed>>16)&0x3F)] : static_cast<uint8_t>(ui32Seed >> 20);
+		}
+		ui32Fails += RoundTrip( "mixed", ui8Data, sizeof( ui8Data ) );
+		ui32Fails += RoundTrip( "empty", ui8Data, 0 );
+	}
+	lsa::CMemLib::Destroy();
+
+	if ( ui32Fails ) {
+		::printf( "%u failures.\r\n", ui32Fails );
+		return 1;
+	}
+	::printf( "All tests passed.\r\n" );
+	return 0;
+}
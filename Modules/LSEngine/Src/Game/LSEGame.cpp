@@ -37,7 +37,8 @@ namespace lse {
 		m_bTicked( false ),
 		m_bPaused( false ),
 		m_bClosing( false ),
-		m_bCostantTimeTicked( false )
+		m_bCostantTimeTicked( false ),
+		m_faaFrameAllocator( m_faFrameArena )
 		/*m_ptmSrcTouchMan( NULL ),
 		m_pswWorld( NULL )*/
 		{
@@ -168,6 +169,9 @@ namespace lse {
 	 * Tick a single frame.  Not to be called by users.
 	 */
 	LSBOOL LSE_CALL CGame::Tick() {
+		// Data from 2 frames ago is no longer needed.
+		m_faFrameArena.NextFrame();
+
 		// Figure out how many logical ticks need to be made and make them.
 		m_tRenderTime.Update( !IsPaused() );
 
@@ -28,6 +28,7 @@
 #include "../Input/LSETouch.h"
 #include "../States/LSEStateFactory.h"
 #include "../States/LSEStateMachine.h"
+#include "Allocator/LSTLFrameArenaAllocator.h"
 #include "Gfx/LSGGfx.h"
 #include "Rand/LSMRand.h"
 #include "SoundCore/LSSSoundManagerEx.h"
@@ -158,6 +159,21 @@ namespace lse {
 		 */
 		CSoundManagerEx & LSE_CALL					SoundMan();
 
+		/**
+		 * Gets the scratch arena for data that only needs to live for the current and next frames.  The game advances
+		 *	it at the start of each Tick().
+		 *
+		 * \return Returns the frame arena.
+		 */
+		CFrameArena & LSE_CALL						FrameArena();
+
+		/**
+		 * Gets an allocator that lets containers allocate from the frame arena.
+		 *
+		 * \return Returns the frame-arena allocator.
+		 */
+		CFrameArenaAllocator & LSE_CALL				FrameAllocator();
+
 
 
 		// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -393,6 +409,12 @@ namespace lse {
 		/** Sound manager allocator. */
 		CAllocator									m_aSoundManAllocator;
 
+		/** Scratch RAM for the current and next frames. */
+		CFrameArena									m_faFrameArena;
+
+		/** Lets containers allocate from m_faFrameArena. */
+		CFrameArenaAllocator						m_faaFrameAllocator;
+
 
 		// == Functions.
 		/**
@@ -563,6 +585,25 @@ namespace lse {
 		return (*m_smeSoundMan);
 	}
 
+	/**
+	 * Gets the scratch arena for data that only needs to live for the current and next frames.  The game advances
+	 *	it at the start of each Tick().
+	 *
+	 * \return Returns the frame arena.
+	 */
+	LSE_INLINE CFrameArena & LSE_CALL CGame::FrameArena() {
+		return m_faFrameArena;
+	}
+
+	/**
+	 * Gets an allocator that lets containers allocate from the frame arena.
+	 *
+	 * \return Returns the frame-arena allocator.
+	 */
+	LSE_INLINE CFrameArenaAllocator & LSE_CALL CGame::FrameAllocator() {
+		return m_faaFrameAllocator;
+	}
+
 	/**
 	 * Are we capturing the mouse?
 	 *
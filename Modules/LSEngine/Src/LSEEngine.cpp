@@ -15,6 +15,7 @@
 
 #include "LSEEngine.h"
 #include "HighLevel/LSFFilesEx.h"
+#include "JobSystem/LSHJobSystem.h"
 //#include "Models/LSEModelInstance.h"
 //#include "Models/LSEDrawableModelInstance.h"
 //#include "Texture/LSECoreModelTexture.h"
@@ -44,6 +45,7 @@ namespace lse {
 	 */
 	void LSE_CALL CEngine::InitEngine( const CEngine::LSE_ENGINE_INIT &_eiParms ) {
 		CMemLib::Init( _eiParms.ui32HeapSize, _eiParms.bHeapIsGrowable != 0 );
+		CJobSystem::Init();
 		CMathLib::Init();
 		CFilesEx::InitFilesEx();
 		CGraphicsLib::InitGraphicsLib();
@@ -249,6 +251,7 @@ namespace lse {
 		CFilesEx::ShutDownFilesEx();
 		/*CCoreModelTexture::DelTextureSearchDirs();*/
 		CGraphicsLib::DestroyGraphicsLib();
+		CJobSystem::Destroy();
 		
 		// Can't destroy the memory manager on iOS devices because the OS was using it too.
 #ifndef LSE_IPHONE
@@ -0,0 +1,567 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reads files in the background so that loaders can overlap disk latency with decoding.  Batches of
+ *	(file, offset, size, destination) reads are queued by priority and serviced by io_uring on Linux, or by a small
+ *	pool of I/O threads everywhere else (and on Linux kernels that refuse io_uring).
+ * If the reader has not been initialized, reads are performed immediately on the submitting thread.
+ */
+
+#include "LSFAsyncReader.h"
+#include <new>
+
+#ifdef LSF_IO_URING
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif	// #ifdef LSF_IO_URING
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// TUNING
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+/** Default number of I/O threads for the thread-pool service.  Reads block rather than compute, so this does not
+ *	depend on the number of processors. */
+#define LSF_ASYNC_THREADS					4
+
+/** Maximum number of reads in flight at once on io_uring. */
+#define LSF_ASYNC_QUEUE_DEPTH				64
+
+/** Reads are split into chunks of this size so that cancellation is noticed within a large read. */
+#define LSF_ASYNC_CHUNK_SIZE				(1024 * 1024)
+
+namespace lsf {
+
+	// == Members.
+	/** The I/O threads, or the io_uring thread. */
+	LSH_THREAD * CAsyncReader::m_ptThreads = NULL;
+
+	/** Number of entries in m_ptThreads. */
+	uint32_t CAsyncReader::m_ui32Threads = 0;
+
+	/** Oldest queued read per priority. */
+	LSF_ASYNC_READ * CAsyncReader::m_parHead[LSF_AP_TOTAL] = { NULL };
+
+	/** Newest queued read per priority. */
+	LSF_ASYNC_READ * CAsyncReader::m_parTail[LSF_AP_TOTAL] = { NULL };
+
+	/** Guards the queues. */
+	CCriticalSection CAsyncReader::m_csQueue;
+
+	/** Idle I/O threads sleep on this. */
+	CEvent CAsyncReader::m_eWake;
+
+	/** Tells the I/O threads to exit. */
+	CAtomic::ATOM CAsyncReader::m_aStop = 0;
+
+	/** True if the service is running on io_uring. */
+	LSBOOL CAsyncReader::m_bIoUring = false;
+
+#ifdef LSF_IO_URING
+	/** The ring used by the io_uring service. */
+	CIoUring CAsyncReader::m_iuRing;
+#endif	// #ifdef LSF_IO_URING
+
+	// == Functions.
+	/**
+	 * Starts the I/O service.  CFilesEx::InitFilesEx() must have been called if reads will allocate their buffers
+	 *	from the default allocator.
+	 *
+	 * \param _ui32Threads The number of I/O threads for the thread-pool service.  If 0, LSF_ASYNC_THREADS is used.
+	 * \param _bAllowIoUring If true, io_uring is used where the kernel supports it.
+	 * \return Returns true if the service was started.  If false is returned, reads run on the submitting thread.
+	 */
+	LSBOOL LSE_CALL CAsyncReader::Init( uint32_t _ui32Threads, LSBOOL _bAllowIoUring ) {
+		Destroy();
+		CAtomic::AtomicStore( m_aStop, 0 );
+
+#ifdef LSF_IO_URING
+		// One thread drives the ring; the kernel does the waiting.
+		if ( _bAllowIoUring && m_iuRing.Init( LSF_ASYNC_QUEUE_DEPTH ) ) {
+			if ( m_iuRing.Supports( IORING_OP_OPENAT ) && m_iuRing.Supports( IORING_OP_READ ) ) {
+				m_ptThreads = new( std::nothrow ) LSH_THREAD[1];
+				if ( m_ptThreads ) {
+					if ( CThreadLib::CreateThread( IoUringThread, &m_iuRing, &m_ptThreads[0] ) ) {
+						CThreadLib::SetThreadName( m_ptThreads[0], "LSF io_uring" );
+						m_ui32Threads = 1;
+						m_bIoUring = true;
+						return true;
+					}
+					delete [] m_ptThreads;
+					m_ptThreads = NULL;
+				}
+			}
+			m_iuRing.Reset();
+		}
+#else
+		static_cast<void>(_bAllowIoUring);
+#endif	// #ifdef LSF_IO_URING
+
+		if ( !_ui32Threads ) { _ui32Threads = LSF_ASYNC_THREADS; }
+		m_ptThreads = new( std::nothrow ) LSH_THREAD[_ui32Threads];
+		if ( !m_ptThreads ) { return false; }
+		for ( uint32_t I = 0; I < _ui32Threads; ++I ) {
+			if ( !CThreadLib::CreateThread( PoolThread, NULL, &m_ptThreads[I] ) ) { break; }
+			CThreadLib::SetThreadName( m_ptThreads[I], "LSF I/O" );
+			m_ui32Threads = I + 1;
+		}
+		if ( !m_ui32Threads ) {
+			delete [] m_ptThreads;
+			m_ptThreads = NULL;
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Stops the I/O service.  Queued reads complete as LSF_AS_CANCELED and reads in progress are finished first.
+	 */
+	void LSE_CALL CAsyncReader::Destroy() {
+		if ( !m_ptThreads ) { return; }
+		CAtomic::AtomicStore( m_aStop, 1 );
+		// Each thread that wakes passes the signal on before exiting.
+		m_eWake.Trigger();
+		for ( uint32_t I = 0; I < m_ui32Threads; ++I ) {
+			CThreadLib::WaitForThread( m_ptThreads[I], NULL );
+			CThreadLib::CloseThread( m_ptThreads[I] );
+		}
+		delete [] m_ptThreads;
+		m_ptThreads = NULL;
+		m_ui32Threads = 0;
+#ifdef LSF_IO_URING
+		m_iuRing.Reset();
+#endif	// #ifdef LSF_IO_URING
+		m_bIoUring = false;
+
+		LSF_ASYNC_READ * parRead;
+		while ( (parRead = Pop()) != NULL ) {
+			Complete( (*parRead), LSF_AS_CANCELED, false );
+		}
+	}
+
+	/**
+	 * Is the service running on io_uring?
+	 *
+	 * \return Returns true if reads are serviced by io_uring rather than by I/O threads.
+	 */
+	LSBOOL LSE_CALL CAsyncReader::UsingIoUring() {
+		return m_bIoUring;
+	}
+
+	/**
+	 * Fills in a read with default values: normal priority, no callback, and no allocator.
+	 *
+	 * \param _arRead The read to fill in.
+	 * \param _pcPath UTF-8 path to the file.  Must stay valid until the read completes.
+	 * \param _ui64Offset Offset in the file at which to start reading.
+	 * \param _ui64Size Number of bytes to read, or LSF_ASYNC_READ_ALL.
+	 * \param _pui8Dest The destination buffer, or NULL to allocate one.
+	 */
+	void LSE_CALL CAsyncReader::InitRead( LSF_ASYNC_READ &_arRead, const char * _pcPath,
+		uint64_t _ui64Offset, uint64_t _ui64Size, uint8_t * _pui8Dest ) {
+		CStd::MemSet( &_arRead, 0, sizeof( _arRead ) );
+		_arRead.pcPath = _pcPath;
+		_arRead.ui64Offset = _ui64Offset;
+		_arRead.ui64Size = _ui64Size;
+		_arRead.pui8Dest = _pui8Dest;
+		_arRead.apPriority = LSF_AP_NORMAL;
+	}
+
+	/**
+	 * Queues reads.  The reads are added to their priority queues in order.
+	 *
+	 * \param _parReads The reads to queue.
+	 * \param _ui32Total The number of reads to which _parReads points.
+	 * \param _parbBatch Optional batch to track the reads.
+	 */
+	void LSE_CALL CAsyncReader::Submit( LSF_ASYNC_READ * _parReads, uint32_t _ui32Total, CAsyncReadBatch * _parbBatch ) {
+		if ( !_ui32Total ) { return; }
+		{
+			CCriticalSection::CLocker lLock( m_csQueue );
+			if ( _parbBatch ) {
+				CAtomic::AtomicStore( _parbBatch->m_aCount, CAtomic::AtomicLoad( _parbBatch->m_aCount ) + static_cast<CAtomic::ATOM_OP>(_ui32Total) );
+			}
+			for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+				LSF_ASYNC_READ & arRead = _parReads[I];
+				arRead.ui64Read = 0;
+				arRead.parbBatch = _parbBatch;
+				arRead.parNext = NULL;
+				CAtomic::AtomicStore( arRead.aCancel, 0 );
+				if ( !m_ptThreads ) {
+					CAtomic::AtomicStore( arRead.aStatus, LSF_AS_RUNNING );
+					continue;
+				}
+				if ( static_cast<uint32_t>(arRead.apPriority) >= LSF_AP_TOTAL ) { arRead.apPriority = LSF_AP_LOW; }
+				CAtomic::AtomicStore( arRead.aStatus, LSF_AS_QUEUED );
+				if ( m_parTail[arRead.apPriority] ) {
+					m_parTail[arRead.apPriority]->parNext = &arRead;
+				}
+				else {
+					m_parHead[arRead.apPriority] = &arRead;
+				}
+				m_parTail[arRead.apPriority] = &arRead;
+			}
+		}
+
+		if ( !m_ptThreads ) {
+			for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+				ReadBlocking( _parReads[I] );
+			}
+			return;
+		}
+		m_eWake.Trigger();
+	}
+
+	/**
+	 * Cancels a read.  A queued read is removed from its queue and completes as LSF_AS_CANCELED before this returns.
+	 *	A read in progress is asked to stop and completes as LSF_AS_CANCELED unless it finishes first.
+	 *
+	 * \param _arRead The read to cancel.
+	 * \return Returns true if the read had not yet completed.
+	 */
+	LSBOOL LSE_CALL CAsyncReader::Cancel( LSF_ASYNC_READ &_arRead ) {
+		{
+			CCriticalSection::CLocker lLock( m_csQueue );
+			switch ( Status( _arRead ) ) {
+				case LSF_AS_QUEUED : {
+					// Reads leave the queues only under m_csQueue, so it is still queued.
+					LSF_ASYNC_READ * parPrev = NULL;
+					LSF_ASYNC_READ * parThis = m_parHead[_arRead.apPriority];
+					while ( parThis != &_arRead ) {
+						parPrev = parThis;
+						parThis = parThis->parNext;
+					}
+					if ( parPrev ) {
+						parPrev->parNext = _arRead.parNext;
+					}
+					else {
+						m_parHead[_arRead.apPriority] = _arRead.parNext;
+					}
+					if ( m_parTail[_arRead.apPriority] == &_arRead ) {
+						m_parTail[_arRead.apPriority] = parPrev;
+					}
+					CAtomic::AtomicStore( _arRead.aStatus, LSF_AS_RUNNING );
+					break;
+				}
+				case LSF_AS_RUNNING : {
+					CAtomic::AtomicStore( _arRead.aCancel, 1 );
+					return true;
+				}
+				default : { return false; }
+			}
+		}
+		Complete( _arRead, LSF_AS_CANCELED, false );
+		return true;
+	}
+
+	/**
+	 * Waits for all reads tracked by the given batch to complete.
+	 *
+	 * \param _arbBatch The batch on which to wait.
+	 */
+	void LSE_CALL CAsyncReader::Wait( CAsyncReadBatch &_arbBatch ) {
+		while ( true ) {
+			{
+				// The completing thread triggers the event under m_csQueue, so once the count is seen to be 0 here it is
+				//	done with the batch and the caller may destroy it.
+				CCriticalSection::CLocker lLock( m_csQueue );
+				if ( _arbBatch.IsDone() ) { return; }
+			}
+			_arbBatch.m_eDone.WaitEvent();
+		}
+	}
+
+	/**
+	 * Removes the highest-priority queued read and marks it as running.
+	 *
+	 * \return Returns the read, or NULL if the queues are empty.
+	 */
+	LSF_ASYNC_READ * LSE_CALL CAsyncReader::Pop() {
+		CCriticalSection::CLocker lLock( m_csQueue );
+		for ( uint32_t I = 0; I < LSF_AP_TOTAL; ++I ) {
+			LSF_ASYNC_READ * parRead = m_parHead[I];
+			if ( !parRead ) { continue; }
+			m_parHead[I] = parRead->parNext;
+			if ( !m_parHead[I] ) { m_parTail[I] = NULL; }
+			CAtomic::AtomicStore( parRead->aStatus, LSF_AS_RUNNING );
+
+			// Wake another thread if there is more to do.
+			for ( ; I < LSF_AP_TOTAL; ++I ) {
+				if ( m_parHead[I] ) {
+					m_eWake.Trigger();
+					break;
+				}
+			}
+			return parRead;
+		}
+		return NULL;
+	}
+
+	/**
+	 * Allocates the destination buffer of a read if it has none.
+	 *
+	 * \param _arRead The read whose buffer is to be allocated.
+	 * \param _ui64Size The number of bytes needed.
+	 * \return Returns false if allocation failed.
+	 */
+	LSBOOL LSE_CALL CAsyncReader::Allocate( LSF_ASYNC_READ &_arRead, uint64_t _ui64Size ) {
+		if ( _arRead.pui8Dest || !_ui64Size ) { return true; }
+		if ( static_cast<uint64_t>(static_cast<uintptr_t>(_ui64Size)) != _ui64Size ) { return false; }
+		CStdAllocator * psaAllocator = _arRead.psaAllocator ? _arRead.psaAllocator : CFilesEx::m_psaAllocator;
+		if ( !psaAllocator ) { return false; }
+		_arRead.pui8Dest = static_cast<uint8_t *>(psaAllocator->Alloc( static_cast<uintptr_t>(_ui64Size) ));
+		return _arRead.pui8Dest != NULL;
+	}
+
+	/**
+	 * Finishes a read: frees its buffer if it failed and the buffer was allocated here, calls its callback, publishes
+	 *	its state, and updates its batch.
+	 *
+	 * \param _arRead The read to finish.
+	 * \param _asStatus The final state of the read.
+	 * \param _bAllocated True if the destination buffer was allocated by Allocate().
+	 */
+	void LSE_CALL CAsyncReader::Complete( LSF_ASYNC_READ &_arRead, LSF_ASYNC_STATUS _asStatus, LSBOOL _bAllocated ) {
+		if ( _asStatus != LSF_AS_DONE && _bAllocated && _arRead.pui8Dest ) {
+			CFilesEx::FreeFile( _arRead.pui8Dest, _arRead.psaAllocator );
+			_arRead.pui8Dest = NULL;
+		}
+		// Once the state is published the owner may release the read, so take what is needed from it first.
+		CAsyncReadBatch * parbBatch = _arRead.parbBatch;
+		if ( _arRead.pfCallback ) {
+			_arRead.pfCallback( _arRead, _asStatus );
+		}
+		CAtomic::AtomicStore( _arRead.aStatus, _asStatus );
+		if ( parbBatch ) {
+			CCriticalSection::CLocker lLock( m_csQueue );
+			if ( CAtomic::InterlockedDecrement( parbBatch->m_aCount ) == 0 ) {
+				parbBatch->m_eDone.Trigger();
+			}
+		}
+	}
+
+	/**
+	 * Performs a read with blocking calls.
+	 *
+	 * \param _arRead The read to perform.
+	 */
+	void LSE_CALL CAsyncReader::ReadBlocking( LSF_ASYNC_READ &_arRead ) {
+		LSF_FILE fFile = CFileLib::OpenFile( _arRead.pcPath, LSF_OF_READ, false );
+		if ( !fFile ) {
+			Complete( _arRead, LSF_AS_FAILED, false );
+			return;
+		}
+		uint64_t ui64FileSize = CFileLib::GetFileSize( fFile );
+		uint64_t ui64Size = _arRead.ui64Offset < ui64FileSize ? ui64FileSize - _arRead.ui64Offset : 0;
+		ui64Size = CStd::Min( ui64Size, _arRead.ui64Size );
+
+		LSBOOL bAllocated = !_arRead.pui8Dest;
+		if ( !Allocate( _arRead, ui64Size ) ) {
+			CFileLib::CloseFile( fFile );
+			Complete( _arRead, LSF_AS_FAILED, false );
+			return;
+		}
+		if ( ui64Size && !CFileLib::SetFilePointer( fFile, static_cast<int64_t>(_arRead.ui64Offset), LSF_S_BEGIN ) ) {
+			CFileLib::CloseFile( fFile );
+			Complete( _arRead, LSF_AS_FAILED, bAllocated );
+			return;
+		}
+		while ( _arRead.ui64Read < ui64Size ) {
+			if ( CAtomic::AtomicLoad( _arRead.aCancel ) ) {
+				CFileLib::CloseFile( fFile );
+				Complete( _arRead, LSF_AS_CANCELED, bAllocated );
+				return;
+			}
+			uintptr_t uiptrChunk = static_cast<uintptr_t>(CStd::Min<uint64_t>( ui64Size - _arRead.ui64Read, LSF_ASYNC_CHUNK_SIZE ));
+			if ( !CFileLib::ReadFile( fFile, _arRead.pui8Dest + _arRead.ui64Read, uiptrChunk ) ) {
+				CFileLib::CloseFile( fFile );
+				Complete( _arRead, LSF_AS_FAILED, bAllocated );
+				return;
+			}
+			_arRead.ui64Read += uiptrChunk;
+		}
+		CFileLib::CloseFile( fFile );
+		Complete( _arRead, LSF_AS_DONE, bAllocated );
+	}
+
+	/**
+	 * The thread function for the thread-pool service.
+	 *
+	 * \param _lpParameter Unused.
+	 * \return Returns 0.
+	 */
+	uint32_t LSH_CALL CAsyncReader::PoolThread( void * /*_lpParameter*/ ) {
+		while ( !CAtomic::AtomicLoad( m_aStop ) ) {
+			LSF_ASYNC_READ * parRead = Pop();
+			if ( parRead ) {
+				ReadBlocking( (*parRead) );
+				continue;
+			}
+			m_eWake.WaitEvent();
+		}
+		m_eWake.Trigger();
+		return 0;
+	}
+
+#ifdef LSF_IO_URING
+	/**
+	 * Submits the next read of a slot's file.
+	 *
+	 * \param _usSlot The slot.
+	 * \param _ui32Index The index of the slot, passed back with the completion.
+	 */
+	void LSE_CALL CAsyncReader::QueueRead( LSF_URING_SLOT &_usSlot, uint32_t _ui32Index ) {
+		// Each slot has at most one operation submitted and the ring has a submission entry per slot, so this cannot fail.
+		io_uring_sqe * psqeSqe = m_iuRing.GetSqe();
+		LSF_ASYNC_READ & arRead = (*_usSlot.parRead);
+		psqeSqe->opcode = IORING_OP_READ;
+		psqeSqe->fd = _usSlot.iFile;
+		psqeSqe->addr = reinterpret_cast<uintptr_t>(arRead.pui8Dest + arRead.ui64Read);
+		psqeSqe->len = static_cast<uint32_t>(CStd::Min<uint64_t>( _usSlot.ui64Size - arRead.ui64Read, 1 << 30 ));
+		psqeSqe->off = arRead.ui64Offset + arRead.ui64Read;
+		psqeSqe->user_data = _ui32Index;
+	}
+
+	/**
+	 * Advances a slot after its submitted operation completes.
+	 *
+	 * \param _usSlot The slot.
+	 * \param _ui32Index The index of the slot.
+	 * \param _i32Result The result of the operation.
+	 * \return Returns true if the read has completed and the slot is free.
+	 */
+	LSBOOL LSE_CALL CAsyncReader::Step( LSF_URING_SLOT &_usSlot, uint32_t _ui32Index, int32_t _i32Result ) {
+		LSF_ASYNC_READ & arRead = (*_usSlot.parRead);
+		LSF_ASYNC_STATUS asStatus;
+		if ( _usSlot.iFile < 0 ) {
+			// The open finished.
+			if ( _i32Result < 0 ) {
+				Complete( arRead, LSF_AS_FAILED, false );
+				return true;
+			}
+			_usSlot.iFile = _i32Result;
+			// fstat() on an open descriptor is cheap and never touches the disk for the size.
+			struct stat sStat;
+			if ( ::fstat( _usSlot.iFile, &sStat ) != 0 ) {
+				asStatus = LSF_AS_FAILED;
+			}
+			else {
+				uint64_t ui64FileSize = static_cast<uint64_t>(sStat.st_size);
+				_usSlot.ui64Size = arRead.ui64Offset < ui64FileSize ? ui64FileSize - arRead.ui64Offset : 0;
+				_usSlot.ui64Size = CStd::Min( _usSlot.ui64Size, arRead.ui64Size );
+				_usSlot.bAllocated = !arRead.pui8Dest;
+				if ( !Allocate( arRead, _usSlot.ui64Size ) ) {
+					_usSlot.bAllocated = false;
+					asStatus = LSF_AS_FAILED;
+				}
+				else if ( !_usSlot.ui64Size ) {
+					asStatus = LSF_AS_DONE;
+				}
+				else {
+					QueueRead( _usSlot, _ui32Index );
+					return false;
+				}
+			}
+		}
+		else if ( _i32Result == -EINTR || _i32Result == -EAGAIN ) {
+			QueueRead( _usSlot, _ui32Index );
+			return false;
+		}
+		else if ( _i32Result < 0 ) {
+			asStatus = LSF_AS_FAILED;
+		}
+		else {
+			arRead.ui64Read += static_cast<uint32_t>(_i32Result);
+			if ( _i32Result == 0 || arRead.ui64Read == _usSlot.ui64Size ) {
+				// Finished, or the file was truncated while being read.
+				asStatus = LSF_AS_DONE;
+			}
+			else if ( CAtomic::AtomicLoad( arRead.aCancel ) ) {
+				asStatus = LSF_AS_CANCELED;
+			}
+			else {
+				QueueRead( _usSlot, _ui32Index );
+				return false;
+			}
+		}
+		::close( _usSlot.iFile );
+		Complete( arRead, asStatus, _usSlot.bAllocated );
+		return true;
+	}
+#endif	// #ifdef LSF_IO_URING
+
+	/**
+	 * The thread function for the io_uring service.
+	 *
+	 * \param _lpParameter The CIoUring to use.
+	 * \return Returns 0.
+	 */
+	uint32_t LSH_CALL CAsyncReader::IoUringThread( void * _lpParameter ) {
+#ifdef LSF_IO_URING
+		CIoUring * piuRing = static_cast<CIoUring *>(_lpParameter);
+		LSF_URING_SLOT usSlots[LSF_ASYNC_QUEUE_DEPTH];
+		uint32_t ui32Free[LSF_ASYNC_QUEUE_DEPTH];
+		for ( uint32_t I = 0; I < LSF_ASYNC_QUEUE_DEPTH; ++I ) {
+			ui32Free[I] = LSF_ASYNC_QUEUE_DEPTH - 1 - I;
+		}
+		uint32_t ui32TotalFree = LSF_ASYNC_QUEUE_DEPTH;
+
+		while ( true ) {
+			// Start as many queued reads as there are free slots.  New reads submitted while the ring is waiting are picked
+			//	up after the next completion.
+			while ( ui32TotalFree && !CAtomic::AtomicLoad( m_aStop ) ) {
+				LSF_ASYNC_READ * parRead = Pop();
+				if ( !parRead ) { break; }
+				uint32_t ui32Index = ui32Free[--ui32TotalFree];
+				usSlots[ui32Index].parRead = parRead;
+				usSlots[ui32Index].iFile = -1;
+				usSlots[ui32Index].ui64Size = 0;
+				usSlots[ui32Index].bAllocated = false;
+
+				io_uring_sqe * psqeSqe = piuRing->GetSqe();
+				psqeSqe->opcode = IORING_OP_OPENAT;
+				psqeSqe->fd = AT_FDCWD;
+				psqeSqe->addr = reinterpret_cast<uintptr_t>(parRead->pcPath);
+				psqeSqe->open_flags = O_RDONLY | O_CLOEXEC;
+				psqeSqe->user_data = ui32Index;
+			}
+
+			if ( ui32TotalFree == LSF_ASYNC_QUEUE_DEPTH ) {
+				// Nothing in flight.
+				if ( CAtomic::AtomicLoad( m_aStop ) ) { break; }
+				m_eWake.WaitEvent();
+				continue;
+			}
+
+			if ( !piuRing->Submit( 1 ) ) {
+				// EAGAIN or EBUSY: the kernel is short of resources.  Reap what has completed and try again shortly.
+				CStd::Sleep( 1 );
+			}
+
+			io_uring_cqe * pcqeCqe;
+			while ( (pcqeCqe = piuRing->PeekCqe()) != NULL ) {
+				uint32_t ui32Index = static_cast<uint32_t>(pcqeCqe->user_data);
+				int32_t i32Result = pcqeCqe->res;
+				piuRing->SeenCqe();
+				if ( Step( usSlots[ui32Index], ui32Index, i32Result ) ) {
+					ui32Free[ui32TotalFree++] = ui32Index;
+				}
+			}
+		}
+#else
+		static_cast<void>(_lpParameter);
+#endif	// #ifdef LSF_IO_URING
+		m_eWake.Trigger();
+		return 0;
+	}
+
+}	// namespace lsf
@@ -0,0 +1,359 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reads files in the background so that loaders can overlap disk latency with decoding.  Batches of
+ *	(file, offset, size, destination) reads are queued by priority and serviced by io_uring on Linux, or by a small
+ *	pool of I/O threads everywhere else (and on Linux kernels that refuse io_uring).
+ * If the reader has not been initialized, reads are performed immediately on the submitting thread.
+ */
+
+
+#ifndef __LSF_ASYNCREADER_H__
+#define __LSF_ASYNCREADER_H__
+
+#include "../LSFFileLib.h"
+#include "../HighLevel/LSFFilesEx.h"
+#include "LSFIoUring.h"
+#include "Atomic/LSSTDAtomic.h"
+#include "CriticalSection/LSHCriticalSection.h"
+#include "Events/LSSTDEvent.h"
+
+/** Passed as the size of a read to read from the offset to the end of the file. */
+#define LSF_ASYNC_READ_ALL							LSE_MAXU64
+
+namespace lsf {
+
+	// == Enumerations.
+	/** Read priorities.  Queued reads are started highest priority first, and in submission order within a priority. */
+	enum LSF_ASYNC_PRIORITY {
+		LSF_AP_HIGH,								/**< Data something is blocked on right now. */
+		LSF_AP_NORMAL,								/**< Ordinary loads. */
+		LSF_AP_LOW,									/**< Prefetching and speculative streaming. */
+		LSF_AP_TOTAL,
+	};
+
+	/** The state of a read. */
+	enum LSF_ASYNC_STATUS {
+		LSF_AS_QUEUED,								/**< Waiting for an I/O slot. */
+		LSF_AS_RUNNING,								/**< Being read. */
+		LSF_AS_DONE,								/**< Finished successfully. */
+		LSF_AS_FAILED,								/**< The file could not be opened or read, or the buffer could not be allocated. */
+		LSF_AS_CANCELED,							/**< Canceled by CAsyncReader::Cancel() or CAsyncReader::Destroy(). */
+	};
+
+	// == Types.
+	struct LSF_ASYNC_READ;
+	class CAsyncReadBatch;
+
+	/** A completion callback.  Called on an I/O thread (or on the submitting thread if the reader is not running). */
+	typedef void (LSE_CALL * LSF_ASYNC_READ_PROC)( LSF_ASYNC_READ &_arRead, LSF_ASYNC_STATUS _asStatus );
+
+	/**
+	 * A single read.  Fill one in with CAsyncReader::InitRead() and then adjust the optional members.  The structure must
+	 *	stay valid until the read completes: until its batch is done or its callback has returned.
+	 */
+	typedef struct LSF_ASYNC_READ {
+		/** UTF-8 path to the file.  Must stay valid until the read completes. */
+		const char *								pcPath;
+
+		/** Offset in the file at which to start reading. */
+		uint64_t									ui64Offset;
+
+		/** Number of bytes to read, or LSF_ASYNC_READ_ALL. */
+		uint64_t									ui64Size;
+
+		/** The destination buffer.  If NULL, a buffer the size of the data is allocated from psaAllocator and returned
+		 *	here on success; release it with CFilesEx::FreeFile( pui8Dest, psaAllocator ). */
+		uint8_t *									pui8Dest;
+
+		/** The allocator used when pui8Dest is NULL.  If NULL, the allocator used by CFilesEx::LoadFileToMemory(). */
+		CStdAllocator *								psaAllocator;
+
+		/** The priority of the read. */
+		LSF_ASYNC_PRIORITY							apPriority;
+
+		/** Optional completion callback. */
+		LSF_ASYNC_READ_PROC							pfCallback;
+
+		/** User data for the callback. */
+		void *										pvParm;
+
+		/** Number of bytes read.  Less than ui64Size if the file ended first. */
+		uint64_t									ui64Read;
+
+		/** An LSF_ASYNC_STATUS value.  Read with CAsyncReader::Status(). */
+		CAtomic::ATOM								aStatus;
+
+		/** Set by CAsyncReader::Cancel() to stop a read that has started. */
+		CAtomic::ATOM								aCancel;
+
+		/** The batch tracking the read.  Used internally. */
+		CAsyncReadBatch *							parbBatch;
+
+		/** The next read in the queue.  Used internally. */
+		LSF_ASYNC_READ *							parNext;
+	} * LPLSF_ASYNC_READ, * const LPCLSF_ASYNC_READ;
+
+	/**
+	 * Class CAsyncReadBatch
+	 * \brief Counts unfinished reads.
+	 *
+	 * Description: Counts unfinished reads.  Pass the same batch to any number of CAsyncReader::Submit() calls and then
+	 *	call CAsyncReader::Wait() on it, or poll IsDone() between other work.  Only one thread may wait on a batch.
+	 */
+	class CAsyncReadBatch {
+		friend class								CAsyncReader;
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CAsyncReadBatch() {
+			m_aCount = 0;
+		}
+
+
+		// == Functions.
+		/**
+		 * Have all of the reads tracked by this batch completed?
+		 *
+		 * \return Returns true if all of the reads tracked by this batch have completed.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					IsDone() const {
+			return CAtomic::AtomicLoad( m_aCount ) == 0;
+		}
+
+
+	protected :
+		// == Members.
+		/** Number of reads that have not completed. */
+		CAtomic::ATOM								m_aCount;
+
+		/** Triggered when m_aCount reaches 0. */
+		CEvent										m_eDone;
+	};
+
+	/**
+	 * Class CAsyncReader
+	 * \brief Reads files in the background.
+	 *
+	 * Description: Reads files in the background so that loaders can overlap disk latency with decoding.  Batches of
+	 *	(file, offset, size, destination) reads are queued by priority and serviced by io_uring on Linux, or by a small
+	 *	pool of I/O threads everywhere else.
+	 */
+	class CAsyncReader {
+	public :
+		// == Functions.
+		/**
+		 * Starts the I/O service.  CFilesEx::InitFilesEx() must have been called if reads will allocate their buffers
+		 *	from the default allocator.
+		 *
+		 * \param _ui32Threads The number of I/O threads for the thread-pool service.  If 0, LSF_ASYNC_THREADS is used.
+		 * \param _bAllowIoUring If true, io_uring is used where the kernel supports it.
+		 * \return Returns true if the service was started.  If false is returned, reads run on the submitting thread.
+		 */
+		static LSBOOL LSE_CALL						Init( uint32_t _ui32Threads = 0, LSBOOL _bAllowIoUring = true );
+
+		/**
+		 * Stops the I/O service.  Queued reads complete as LSF_AS_CANCELED and reads in progress are finished first.
+		 */
+		static void LSE_CALL						Destroy();
+
+		/**
+		 * Is the service running on io_uring?
+		 *
+		 * \return Returns true if reads are serviced by io_uring rather than by I/O threads.
+		 */
+		static LSBOOL LSE_CALL						UsingIoUring();
+
+		/**
+		 * Fills in a read with default values: normal priority, no callback, and no allocator.
+		 *
+		 * \param _arRead The read to fill in.
+		 * \param _pcPath UTF-8 path to the file.  Must stay valid until the read completes.
+		 * \param _ui64Offset Offset in the file at which to start reading.
+		 * \param _ui64Size Number of bytes to read, or LSF_ASYNC_READ_ALL.
+		 * \param _pui8Dest The destination buffer, or NULL to allocate one.
+		 */
+		static void LSE_CALL						InitRead( LSF_ASYNC_READ &_arRead, const char * _pcPath,
+			uint64_t _ui64Offset = 0, uint64_t _ui64Size = LSF_ASYNC_READ_ALL, uint8_t * _pui8Dest = NULL );
+
+		/**
+		 * Queues reads.  The reads are added to their priority queues in order.
+		 *
+		 * \param _parReads The reads to queue.
+		 * \param _ui32Total The number of reads to which _parReads points.
+		 * \param _parbBatch Optional batch to track the reads.
+		 */
+		static void LSE_CALL						Submit( LSF_ASYNC_READ * _parReads, uint32_t _ui32Total, CAsyncReadBatch * _parbBatch );
+
+		/**
+		 * Cancels a read.  A queued read is removed from its queue and completes as LSF_AS_CANCELED before this returns.
+		 *	A read in progress is asked to stop and completes as LSF_AS_CANCELED unless it finishes first.
+		 *
+		 * \param _arRead The read to cancel.
+		 * \return Returns true if the read had not yet completed.
+		 */
+		static LSBOOL LSE_CALL						Cancel( LSF_ASYNC_READ &_arRead );
+
+		/**
+		 * Waits for all reads tracked by the given batch to complete.
+		 *
+		 * \param _arbBatch The batch on which to wait.
+		 */
+		static void LSE_CALL						Wait( CAsyncReadBatch &_arbBatch );
+
+		/**
+		 * Gets the state of a read.
+		 *
+		 * \param _arRead The read whose state is to be obtained.
+		 * \return Returns the state of the read.
+		 */
+		static LSE_INLINE LSF_ASYNC_STATUS LSE_CALL	Status( const LSF_ASYNC_READ &_arRead );
+
+
+	protected :
+		// == Types.
+#ifdef LSF_IO_URING
+		/** A read in flight on io_uring.  Each has at most one operation submitted at a time. */
+		typedef struct LSF_URING_SLOT {
+			/** The read. */
+			LSF_ASYNC_READ *						parRead;
+
+			/** The open file, or -1 while it is being opened. */
+			int										iFile;
+
+			/** The number of bytes to read. */
+			uint64_t								ui64Size;
+
+			/** True if the destination buffer was allocated by Allocate(). */
+			LSBOOL									bAllocated;
+		} * LPLSF_URING_SLOT, * const LPCLSF_URING_SLOT;
+#endif	// #ifdef LSF_IO_URING
+
+
+		// == Members.
+		/** The I/O threads, or the io_uring thread. */
+		static LSH_THREAD *							m_ptThreads;
+
+		/** Number of entries in m_ptThreads. */
+		static uint32_t								m_ui32Threads;
+
+		/** Oldest queued read per priority. */
+		static LSF_ASYNC_READ *						m_parHead[LSF_AP_TOTAL];
+
+		/** Newest queued read per priority. */
+		static LSF_ASYNC_READ *						m_parTail[LSF_AP_TOTAL];
+
+		/** Guards the queues. */
+		static CCriticalSection						m_csQueue;
+
+		/** Idle I/O threads sleep on this. */
+		static CEvent								m_eWake;
+
+		/** Tells the I/O threads to exit. */
+		static CAtomic::ATOM						m_aStop;
+
+		/** True if the service is running on io_uring. */
+		static LSBOOL								m_bIoUring;
+
+#ifdef LSF_IO_URING
+		/** The ring used by the io_uring service. */
+		static CIoUring								m_iuRing;
+#endif	// #ifdef LSF_IO_URING
+
+
+		// == Functions.
+		/**
+		 * Removes the highest-priority queued read and marks it as running.
+		 *
+		 * \return Returns the read, or NULL if the queues are empty.
+		 */
+		static LSF_ASYNC_READ * LSE_CALL			Pop();
+
+		/**
+		 * Allocates the destination buffer of a read if it has none.
+		 *
+		 * \param _arRead The read whose buffer is to be allocated.
+		 * \param _ui64Size The number of bytes needed.
+		 * \return Returns false if allocation failed.
+		 */
+		static LSBOOL LSE_CALL						Allocate( LSF_ASYNC_READ &_arRead, uint64_t _ui64Size );
+
+		/**
+		 * Finishes a read: frees its buffer if it failed and the buffer was allocated here, calls its callback, publishes
+		 *	its state, and updates its batch.
+		 *
+		 * \param _arRead The read to finish.
+		 * \param _asStatus The final state of the read.
+		 * \param _bAllocated True if the destination buffer was allocated by Allocate().
+		 */
+		static void LSE_CALL						Complete( LSF_ASYNC_READ &_arRead, LSF_ASYNC_STATUS _asStatus, LSBOOL _bAllocated );
+
+		/**
+		 * Performs a read with blocking calls.
+		 *
+		 * \param _arRead The read to perform.
+		 */
+		static void LSE_CALL						ReadBlocking( LSF_ASYNC_READ &_arRead );
+
+		/**
+		 * The thread function for the thread-pool service.
+		 *
+		 * \param _lpParameter Unused.
+		 * \return Returns 0.
+		 */
+		static uint32_t LSH_CALL					PoolThread( void * _lpParameter );
+
+#ifdef LSF_IO_URING
+		/**
+		 * Submits the next read of a slot's file.
+		 *
+		 * \param _usSlot The slot.
+		 * \param _ui32Index The index of the slot, passed back with the completion.
+		 */
+		static void LSE_CALL						QueueRead( LSF_URING_SLOT &_usSlot, uint32_t _ui32Index );
+
+		/**
+		 * Advances a slot after its submitted operation completes.
+		 *
+		 * \param _usSlot The slot.
+		 * \param _ui32Index The index of the slot.
+		 * \param _i32Result The result of the operation.
+		 * \return Returns true if the read has completed and the slot is free.
+		 */
+		static LSBOOL LSE_CALL						Step( LSF_URING_SLOT &_usSlot, uint32_t _ui32Index, int32_t _i32Result );
+#endif	// #ifdef LSF_IO_URING
+
+		/**
+		 * The thread function for the io_uring service.
+		 *
+		 * \param _lpParameter The CIoUring to use.
+		 * \return Returns 0.
+		 */
+		static uint32_t LSH_CALL					IoUringThread( void * _lpParameter );
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Gets the state of a read.
+	 *
+	 * \param _arRead The read whose state is to be obtained.
+	 * \return Returns the state of the read.
+	 */
+	LSE_INLINE LSF_ASYNC_STATUS LSE_CALL CAsyncReader::Status( const LSF_ASYNC_READ &_arRead ) {
+		return static_cast<LSF_ASYNC_STATUS>(CAtomic::AtomicLoad( _arRead.aStatus ));
+	}
+
+}	// namespace lsf
+
+#endif	// __LSF_ASYNCREADER_H__
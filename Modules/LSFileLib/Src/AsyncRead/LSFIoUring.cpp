@@ -0,0 +1,221 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A minimal wrapper around a Linux io_uring instance, talking to the kernel through the raw system calls
+ *	so that liburing is not needed.  Only what CAsyncReader needs is exposed.  LSF_IO_URING is defined when the
+ *	platform headers provide io_uring; the kernel may still refuse it at run time, in which case Init() fails.
+ */
+
+#include "LSFIoUring.h"
+
+#ifdef LSF_IO_URING
+
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace lsf {
+
+	// == Various constructors.
+	LSE_CALLCTOR CIoUring::CIoUring() :
+		m_iRing( -1 ),
+		m_pui8SqRing( NULL ),
+		m_uiptrSqRingSize( 0 ),
+		m_pui8CqRing( NULL ),
+		m_uiptrCqRingSize( 0 ),
+		m_psqeSqes( NULL ),
+		m_uiptrSqesSize( 0 ),
+		m_pui32SqHead( NULL ),
+		m_pui32SqTail( NULL ),
+		m_pui32SqArray( NULL ),
+		m_ui32SqMask( 0 ),
+		m_ui32SqEntries( 0 ),
+		m_ui32SqLocalTail( 0 ),
+		m_pui32CqHead( NULL ),
+		m_pui32CqTail( NULL ),
+		m_ui32CqMask( 0 ),
+		m_pcqeCqes( NULL ) {
+	}
+	LSE_CALLCTOR CIoUring::~CIoUring() {
+		Reset();
+	}
+
+	// == Functions.
+	/**
+	 * Creates the ring and maps its queues.
+	 *
+	 * \param _ui32Entries The number of submission-queue entries.  Rounded up to a power of 2 by the kernel.
+	 * \return Returns true if the ring was created.  Returns false if the kernel does not support io_uring or it
+	 *	has been disabled.
+	 */
+	LSBOOL LSE_CALL CIoUring::Init( uint32_t _ui32Entries ) {
+		Reset();
+		io_uring_params upParms;
+		CStd::MemSet( &upParms, 0, sizeof( upParms ) );
+		m_iRing = static_cast<int>(::syscall( __NR_io_uring_setup, _ui32Entries, &upParms ));
+		if ( m_iRing < 0 ) {
+			// ENOSYS on old kernels, EPERM where it has been disabled (io_uring_disabled or a seccomp filter).
+			m_iRing = -1;
+			return false;
+		}
+
+		m_uiptrSqRingSize = upParms.sq_off.array + upParms.sq_entries * sizeof( uint32_t );
+		m_uiptrCqRingSize = upParms.cq_off.cqes + upParms.cq_entries * sizeof( io_uring_cqe );
+		if ( upParms.features & IORING_FEAT_SINGLE_MMAP ) {
+			m_uiptrSqRingSize = m_uiptrCqRingSize = CStd::Max( m_uiptrSqRingSize, m_uiptrCqRingSize );
+		}
+
+		void * pvMap = ::mmap( NULL, m_uiptrSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			m_iRing, IORING_OFF_SQ_RING );
+		if ( pvMap == MAP_FAILED ) {
+			Reset();
+			return false;
+		}
+		m_pui8SqRing = static_cast<uint8_t *>(pvMap);
+
+		if ( upParms.features & IORING_FEAT_SINGLE_MMAP ) {
+			m_pui8CqRing = m_pui8SqRing;
+		}
+		else {
+			pvMap = ::mmap( NULL, m_uiptrCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+				m_iRing, IORING_OFF_CQ_RING );
+			if ( pvMap == MAP_FAILED ) {
+				Reset();
+				return false;
+			}
+			m_pui8CqRing = static_cast<uint8_t *>(pvMap);
+		}
+
+		m_uiptrSqesSize = upParms.sq_entries * sizeof( io_uring_sqe );
+		pvMap = ::mmap( NULL, m_uiptrSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			m_iRing, IORING_OFF_SQES );
+		if ( pvMap == MAP_FAILED ) {
+			Reset();
+			return false;
+		}
+		m_psqeSqes = static_cast<io_uring_sqe *>(pvMap);
+
+		m_pui32SqHead = reinterpret_cast<uint32_t *>(m_pui8SqRing + upParms.sq_off.head);
+		m_pui32SqTail = reinterpret_cast<uint32_t *>(m_pui8SqRing + upParms.sq_off.tail);
+		m_pui32SqArray = reinterpret_cast<uint32_t *>(m_pui8SqRing + upParms.sq_off.array);
+		m_ui32SqMask = *reinterpret_cast<uint32_t *>(m_pui8SqRing + upParms.sq_off.ring_mask);
+		m_ui32SqEntries = upParms.sq_entries;
+		m_ui32SqLocalTail = *m_pui32SqTail;
+
+		m_pui32CqHead = reinterpret_cast<uint32_t *>(m_pui8CqRing + upParms.cq_off.head);
+		m_pui32CqTail = reinterpret_cast<uint32_t *>(m_pui8CqRing + upParms.cq_off.tail);
+		m_ui32CqMask = *reinterpret_cast<uint32_t *>(m_pui8CqRing + upParms.cq_off.ring_mask);
+		m_pcqeCqes = reinterpret_cast<io_uring_cqe *>(m_pui8CqRing + upParms.cq_off.cqes);
+		return true;
+	}
+
+	/**
+	 * Unmaps the queues and closes the ring.
+	 */
+	void LSE_CALL CIoUring::Reset() {
+		if ( m_psqeSqes ) {
+			::munmap( m_psqeSqes, m_uiptrSqesSize );
+			m_psqeSqes = NULL;
+		}
+		if ( m_pui8CqRing && m_pui8CqRing != m_pui8SqRing ) {
+			::munmap( m_pui8CqRing, m_uiptrCqRingSize );
+		}
+		m_pui8CqRing = NULL;
+		if ( m_pui8SqRing ) {
+			::munmap( m_pui8SqRing, m_uiptrSqRingSize );
+			m_pui8SqRing = NULL;
+		}
+		if ( m_iRing >= 0 ) {
+			::close( m_iRing );
+			m_iRing = -1;
+		}
+		m_pui32SqHead = m_pui32SqTail = m_pui32SqArray = NULL;
+		m_pui32CqHead = m_pui32CqTail = NULL;
+		m_pcqeCqes = NULL;
+		m_ui32SqEntries = m_ui32SqLocalTail = 0;
+	}
+
+	/**
+	 * Asks the kernel whether it supports the given operation.
+	 *
+	 * \param _ui8Op An IORING_OP_* value.
+	 * \return Returns true if the operation is supported.
+	 */
+	LSBOOL LSE_CALL CIoUring::Supports( uint8_t _ui8Op ) const {
+		if ( m_iRing < 0 ) { return false; }
+		// The probe is followed by one io_uring_probe_op per operation.
+		uint8_t ui8Buffer[sizeof( io_uring_probe )+256*sizeof( io_uring_probe_op )];
+		CStd::MemSet( ui8Buffer, 0, sizeof( ui8Buffer ) );
+		io_uring_probe * pupProbe = reinterpret_cast<io_uring_probe *>(ui8Buffer);
+		// Kernels older than 5.6 have no probe, and also none of the operations CAsyncReader needs.
+		if ( ::syscall( __NR_io_uring_register, m_iRing, IORING_REGISTER_PROBE, pupProbe, 256 ) < 0 ) { return false; }
+		if ( _ui8Op > pupProbe->last_op ) { return false; }
+		return (pupProbe->ops[_ui8Op].flags & IO_URING_OP_SUPPORTED) != 0;
+	}
+
+	/**
+	 * Gets a cleared submission-queue entry to fill.  It is submitted by the next call to Submit().
+	 *
+	 * \return Returns the entry, or NULL if the submission queue is full.
+	 */
+	io_uring_sqe * LSE_CALL CIoUring::GetSqe() {
+		uint32_t ui32Head = __atomic_load_n( m_pui32SqHead, __ATOMIC_ACQUIRE );
+		if ( m_ui32SqLocalTail - ui32Head >= m_ui32SqEntries ) { return NULL; }
+		uint32_t ui32Index = m_ui32SqLocalTail & m_ui32SqMask;
+		io_uring_sqe * psqeRet = &m_psqeSqes[ui32Index];
+		CStd::MemSet( psqeRet, 0, sizeof( io_uring_sqe ) );
+		m_pui32SqArray[ui32Index] = ui32Index;
+		++m_ui32SqLocalTail;
+		return psqeRet;
+	}
+
+	/**
+	 * Submits all entries obtained by GetSqe() since the last call and optionally waits for completions.
+	 *
+	 * \param _ui32WaitFor The number of completions for which to wait.
+	 * \return Returns true if the kernel accepted the call.
+	 */
+	LSBOOL LSE_CALL CIoUring::Submit( uint32_t _ui32WaitFor ) {
+		// The entries must be visible before the kernel sees the new tail.
+		__atomic_store_n( m_pui32SqTail, m_ui32SqLocalTail, __ATOMIC_RELEASE );
+		while ( true ) {
+			// Count against the kernel's head so that entries left over from an earlier partial submit are included.
+			uint32_t ui32Pending = m_ui32SqLocalTail - __atomic_load_n( m_pui32SqHead, __ATOMIC_ACQUIRE );
+			if ( !ui32Pending && !_ui32WaitFor ) { return true; }
+			long lRet = ::syscall( __NR_io_uring_enter, m_iRing, ui32Pending, _ui32WaitFor,
+				_ui32WaitFor ? IORING_ENTER_GETEVENTS : 0, NULL, 0 );
+			if ( lRet >= 0 ) { return true; }
+			if ( errno != EINTR ) { return false; }
+		}
+	}
+
+	/**
+	 * Gets the oldest completion that has not been marked as seen.
+	 *
+	 * \return Returns the completion, or NULL if none are waiting.
+	 */
+	io_uring_cqe * LSE_CALL CIoUring::PeekCqe() {
+		uint32_t ui32Head = *m_pui32CqHead;
+		if ( ui32Head == __atomic_load_n( m_pui32CqTail, __ATOMIC_ACQUIRE ) ) { return NULL; }
+		return &m_pcqeCqes[ui32Head&m_ui32CqMask];
+	}
+
+	/**
+	 * Marks the completion returned by PeekCqe() as seen, returning its slot to the kernel.
+	 */
+	void LSE_CALL CIoUring::SeenCqe() {
+		// The completion must have been read before the kernel can overwrite it.
+		__atomic_store_n( m_pui32CqHead, *m_pui32CqHead + 1, __ATOMIC_RELEASE );
+	}
+
+}	// namespace lsf
+
+#endif	// #ifdef LSF_IO_URING
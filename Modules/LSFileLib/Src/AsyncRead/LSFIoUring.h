@@ -0,0 +1,160 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A minimal wrapper around a Linux io_uring instance, talking to the kernel through the raw system calls
+ *	so that liburing is not needed.  Only what CAsyncReader needs is exposed.  LSF_IO_URING is defined when the
+ *	platform headers provide io_uring; the kernel may still refuse it at run time, in which case Init() fails.
+ */
+
+
+#ifndef __LSF_IOURING_H__
+#define __LSF_IOURING_H__
+
+#include "../LSFFileLib.h"
+
+#if defined( LSE_LINUX ) && defined( __has_include )
+#if __has_include( <linux/io_uring.h> )
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#if defined( __NR_io_uring_setup ) && defined( __NR_io_uring_enter ) && defined( __NR_io_uring_register )
+#define LSF_IO_URING
+#endif	// #if defined( __NR_io_uring_setup ) && defined( __NR_io_uring_enter ) && defined( __NR_io_uring_register )
+#endif	// #if __has_include( <linux/io_uring.h> )
+#endif	// #if defined( LSE_LINUX ) && defined( __has_include )
+
+#ifdef LSF_IO_URING
+
+namespace lsf {
+
+	/**
+	 * Class CIoUring
+	 * \brief A minimal io_uring wrapper.
+	 *
+	 * Description: A minimal wrapper around a Linux io_uring instance.  Not thread-safe: one thread prepares submissions
+	 *	and reaps completions.
+	 */
+	class CIoUring {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CIoUring();
+		LSE_CALLCTOR								~CIoUring();
+
+
+		// == Functions.
+		/**
+		 * Creates the ring and maps its queues.
+		 *
+		 * \param _ui32Entries The number of submission-queue entries.  Rounded up to a power of 2 by the kernel.
+		 * \return Returns true if the ring was created.  Returns false if the kernel does not support io_uring or it
+		 *	has been disabled.
+		 */
+		LSBOOL LSE_CALL								Init( uint32_t _ui32Entries );
+
+		/**
+		 * Unmaps the queues and closes the ring.
+		 */
+		void LSE_CALL								Reset();
+
+		/**
+		 * Asks the kernel whether it supports the given operation.
+		 *
+		 * \param _ui8Op An IORING_OP_* value.
+		 * \return Returns true if the operation is supported.
+		 */
+		LSBOOL LSE_CALL								Supports( uint8_t _ui8Op ) const;
+
+		/**
+		 * Gets a cleared submission-queue entry to fill.  It is submitted by the next call to Submit().
+		 *
+		 * \return Returns the entry, or NULL if the submission queue is full.
+		 */
+		io_uring_sqe * LSE_CALL						GetSqe();
+
+		/**
+		 * Submits all entries obtained by GetSqe() since the last call and optionally waits for completions.
+		 *
+		 * \param _ui32WaitFor The number of completions for which to wait.
+		 * \return Returns true if the kernel accepted the call.
+		 */
+		LSBOOL LSE_CALL								Submit( uint32_t _ui32WaitFor );
+
+		/**
+		 * Gets the oldest completion that has not been marked as seen.
+		 *
+		 * \return Returns the completion, or NULL if none are waiting.
+		 */
+		io_uring_cqe * LSE_CALL						PeekCqe();
+
+		/**
+		 * Marks the completion returned by PeekCqe() as seen, returning its slot to the kernel.
+		 */
+		void LSE_CALL								SeenCqe();
+
+
+	protected :
+		// == Members.
+		/** The ring descriptor. */
+		int											m_iRing;
+
+		/** The submission-queue ring mapping. */
+		uint8_t *									m_pui8SqRing;
+
+		/** Size of m_pui8SqRing. */
+		uintptr_t									m_uiptrSqRingSize;
+
+		/** The completion-queue ring mapping.  The same as m_pui8SqRing if the kernel maps both at once. */
+		uint8_t *									m_pui8CqRing;
+
+		/** Size of m_pui8CqRing. */
+		uintptr_t									m_uiptrCqRingSize;
+
+		/** The submission-queue entries. */
+		io_uring_sqe *								m_psqeSqes;
+
+		/** Size of m_psqeSqes in bytes. */
+		uintptr_t									m_uiptrSqesSize;
+
+		/** The kernel's submission-queue head. */
+		uint32_t *									m_pui32SqHead;
+
+		/** The submission-queue tail. */
+		uint32_t *									m_pui32SqTail;
+
+		/** The submission-queue index array. */
+		uint32_t *									m_pui32SqArray;
+
+		/** The submission-queue mask. */
+		uint32_t									m_ui32SqMask;
+
+		/** The number of submission-queue entries. */
+		uint32_t									m_ui32SqEntries;
+
+		/** The local submission-queue tail, published by Submit(). */
+		uint32_t									m_ui32SqLocalTail;
+
+		/** The completion-queue head. */
+		uint32_t *									m_pui32CqHead;
+
+		/** The kernel's completion-queue tail. */
+		uint32_t *									m_pui32CqTail;
+
+		/** The completion-queue mask. */
+		uint32_t									m_ui32CqMask;
+
+		/** The completion-queue entries. */
+		io_uring_cqe *								m_pcqeCqes;
+	};
+
+}	// namespace lsf
+
+#endif	// #ifdef LSF_IO_URING
+
+#endif	// __LSF_IOURING_H__
@@ -0,0 +1,245 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A read-only file stream that reads the file a block at a time and serves primitive reads out of the
+ *	block.  Read<>() and ReadArray<>() are inlined and non-virtual, so parsing a format field by field costs a copy
+ *	per field instead of a virtual call and a system call.
+ */
+
+#include "LSFBufferedFileReader.h"
+
+
+namespace lsf {
+
+	// == Various constructors.
+	LSE_CALLCTOR CBufferedFileReader::CBufferedFileReader( const char * _pcFile, uint32_t _ui32BlockSize ) :
+		m_pui8Block( NULL ),
+		m_ui32BlockSize( _ui32BlockSize ? _ui32BlockSize : LSF_BUFFERED_BLOCK_SIZE ),
+		m_ui32Pos( 0 ),
+		m_ui32End( 0 ),
+		m_ui64FilePos( 0 ),
+		m_ui64FileSize( 0 ) {
+		m_fFile = CFileLib::OpenFile( _pcFile, LSF_OF_READ, false );
+		if ( !m_fFile ) {
+			CStd::DebugPrintA( "FAILED TO OPEN FILE " );
+			CStd::DebugPrintA( _pcFile );
+			CStd::DebugPrintA( ".\r\n" );
+			return;
+		}
+		m_ui64FileSize = CFileLib::GetFileSize( m_fFile );
+		m_pui8Block = LSENEW uint8_t[m_ui32BlockSize];
+		if ( !m_pui8Block ) {
+			CFileLib::CloseFile( m_fFile );
+			m_fFile = NULL;
+		}
+	}
+	LSE_CALLCTOR CBufferedFileReader::~CBufferedFileReader() {
+		LSEDELETE [] m_pui8Block;
+		m_pui8Block = NULL;
+		if ( m_fFile ) {
+			CFileLib::CloseFile( m_fFile );
+		}
+	}
+
+	// == Functions.
+	/**
+	 * Skips the given number of bytes.
+	 *
+	 * \param _ui64Skip The number of bytes to skip.
+	 * \return Returns true if the new position is within the file.
+	 */
+	LSBOOL LSE_CALL CBufferedFileReader::SkipBytes( uint64_t _ui64Skip ) const {
+		if ( !m_pui8Block ) { return false; }
+		if ( _ui64Skip <= m_ui32End - m_ui32Pos ) {
+			m_ui32Pos += static_cast<uint32_t>(_ui64Skip);
+			return true;
+		}
+		uint64_t ui64Target = GetPos() + _ui64Skip;
+		if ( ui64Target > m_ui64FileSize ) { return false; }
+		if ( !CFileLib::SetFilePointer( m_fFile, static_cast<int64_t>(ui64Target), LSF_S_BEGIN ) ) { return false; }
+		m_ui64FilePos = ui64Target;
+		m_ui32Pos = m_ui32End = 0;
+		return true;
+	}
+
+	/**
+	 * Read bytes from the stream.  Stream position is advanced by the amount read.
+	 *
+	 * \param _pui8Buffer Buffer to hold the bytes read from the stream.
+	 * \param _ui32BytesToRead Number of bytes to read.
+	 * \return Returns the actual number of bytes read or LSSTD_SE_ERROR on error.
+	 */
+	uint32_t LSE_CALL CBufferedFileReader::ReadBytes( uint8_t * _pui8Buffer, uint32_t _ui32BytesToRead ) const {
+		if ( !m_pui8Block ) { return 0; }
+		uint32_t ui32Done = 0;
+		while ( ui32Done < _ui32BytesToRead ) {
+			uint32_t ui32Left = _ui32BytesToRead - ui32Done;
+			uint32_t ui32Avail = m_ui32End - m_ui32Pos;
+			if ( ui32Avail ) {
+				uint32_t ui32Copy = CStd::Min( ui32Avail, ui32Left );
+				CStd::MemCpy( _pui8Buffer + ui32Done, m_pui8Block + m_ui32Pos, ui32Copy );
+				m_ui32Pos += ui32Copy;
+				ui32Done += ui32Copy;
+				continue;
+			}
+
+			// The block is empty.  CFileLib::ReadFile() fails on short reads, so never ask for more than remains.
+			uint64_t ui64FileLeft = m_ui64FileSize - m_ui64FilePos;
+			if ( !ui64FileLeft ) { break; }
+			if ( ui32Left >= m_ui32BlockSize ) {
+				// Large reads go straight to the caller's buffer.
+				uint32_t ui32Direct = static_cast<uint32_t>(CStd::Min<uint64_t>( ui32Left, ui64FileLeft ));
+				if ( !CFileLib::ReadFile( m_fFile, _pui8Buffer + ui32Done, ui32Direct ) ) { break; }
+				m_ui64FilePos += ui32Direct;
+				ui32Done += ui32Direct;
+				continue;
+			}
+			uint32_t ui32Fill = static_cast<uint32_t>(CStd::Min<uint64_t>( m_ui32BlockSize, ui64FileLeft ));
+			if ( !CFileLib::ReadFile( m_fFile, m_pui8Block, ui32Fill ) ) { break; }
+			m_ui64FilePos += ui32Fill;
+			m_ui32Pos = 0;
+			m_ui32End = ui32Fill;
+		}
+		return ui32Done;
+	}
+
+	/**
+	 * Reads a 64-bit unsigned integer from the stream and advances the stream position.
+	 *
+	 * \return Returns the 64-bit unsigned integer at the current position in the stream.
+	 */
+	uint64_t LSE_CALL CBufferedFileReader::ReadUInt64() const {
+		uint64_t ui64Ret;
+		if ( !Read( ui64Ret ) ) { return 0ULL; }
+		return ui64Ret;
+	}
+
+	/**
+	 * Reads a 32-bit unsigned integer from the stream and advances the stream position.
+	 *
+	 * \return Returns the 32-bit unsigned integer at the current position in the stream.
+	 */
+	uint32_t LSE_CALL CBufferedFileReader::ReadUInt32() const {
+		uint32_t ui32Ret;
+		if ( !Read( ui32Ret ) ) { return 0; }
+		return ui32Ret;
+	}
+
+	/**
+	 * Reads a 16-bit unsigned integer from the stream and advances the stream position.
+	 *
+	 * \return Returns the 16-bit unsigned integer at the current position in the stream.
+	 */
+	uint16_t LSE_CALL CBufferedFileReader::ReadUInt16() const {
+		uint16_t ui16Ret;
+		if ( !Read( ui16Ret ) ) { return 0; }
+		return ui16Ret;
+	}
+
+	/**
+	 * Reads an 8-bit unsigned integer from the stream and advances the stream position.
+	 *
+	 * \return Returns the 8-bit unsigned integer at the current position in the stream.
+	 */
+	uint8_t LSE_CALL CBufferedFileReader::ReadUInt8() const {
+		uint8_t ui8Ret;
+		if ( !Read( ui8Ret ) ) { return 0; }
+		return ui8Ret;
+	}
+
+	/**
+	 * Reads a 32-bit float from the stream and advances the stream position.
+	 *
+	 * \return Returns the 32-bit float at the current position in the stream.
+	 */
+	float LSE_CALL CBufferedFileReader::ReadFloat() const {
+		float fRet;
+		if ( !Read( fRet ) ) { return 0.0f; }
+		return fRet;
+	}
+
+	/**
+	 * Reads a 64-bit double from the stream and advances the stream position.
+	 *
+	 * \return Returns the 64-bit double at the current position in the stream.
+	 */
+	double LSE_CALL CBufferedFileReader::ReadDouble() const {
+		double dRet;
+		if ( !Read( dRet ) ) { return 0.0; }
+		return dRet;
+	}
+
+	/**
+	 * Not supported.  The stream is read-only.
+	 *
+	 * \param _pui8Buffer Unused.
+	 * \param _ui32BytesToWrite Unused.
+	 * \return Returns LSSTD_SE_ERROR.
+	 */
+	uint32_t LSE_CALL CBufferedFileReader::WriteBytes( const uint8_t * /*_pui8Buffer*/, uint32_t /*_ui32BytesToWrite*/ ) {
+		return LSSTD_SE_ERROR;
+	}
+
+	/**
+	 * Not supported.  The stream is read-only.
+	 *
+	 * \return Returns false.
+	 */
+	LSBOOL LSE_CALL CBufferedFileReader::WriteUInt64( const uint64_t &/*_ui64Value*/ ) {
+		return false;
+	}
+
+	/**
+	 * Not supported.  The stream is read-only.
+	 *
+	 * \return Returns false.
+	 */
+	LSBOOL LSE_CALL CBufferedFileReader::WriteUInt32( uint32_t /*_ui32Value*/ ) {
+		return false;
+	}
+
+	/**
+	 * Not supported.  The stream is read-only.
+	 *
+	 * \return Returns false.
+	 */
+	LSBOOL LSE_CALL CBufferedFileReader::WriteUInt16( uint16_t /*_ui16Value*/ ) {
+		return false;
+	}
+
+	/**
+	 * Not supported.  The stream is read-only.
+	 *
+	 * \return Returns false.
+	 */
+	LSBOOL LSE_CALL CBufferedFileReader::WriteUInt8( uint8_t /*_ui8Value*/ ) {
+		return false;
+	}
+
+	/**
+	 * Not supported.  The stream is read-only.
+	 *
+	 * \return Returns false.
+	 */
+	LSBOOL LSE_CALL CBufferedFileReader::WriteFloat( float /*_fValue*/ ) {
+		return false;
+	}
+
+	/**
+	 * Not supported.  The stream is read-only.
+	 *
+	 * \return Returns false.
+	 */
+	LSBOOL LSE_CALL CBufferedFileReader::WriteDouble( const double &/*_dValue*/ ) {
+		return false;
+	}
+
+}	// namespace lsf
@@ -0,0 +1,284 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A read-only file stream that reads the file a block at a time and serves primitive reads out of the
+ *	block.  Read<>() and ReadArray<>() are inlined and non-virtual, so parsing a format field by field costs a copy
+ *	per field instead of a virtual call and a system call.
+ */
+
+
+#ifndef __LSF_BUFFEREDFILEREADER_H__
+#define __LSF_BUFFEREDFILEREADER_H__
+
+#include "../LSFFileLib.h"
+#include "Streams/LSSTDStream.h"
+
+/** Default block size of buffered file streams. */
+#define LSF_BUFFERED_BLOCK_SIZE						(64 * 1024)
+
+namespace lsf {
+
+	/**
+	 * Class CBufferedFileReader
+	 * \brief A read-only file stream that reads a block at a time.
+	 *
+	 * Description: A read-only file stream that reads the file a block at a time and serves primitive reads out of the
+	 *	block.  The CStream interface is implemented for code that takes any stream, but code that knows it has a
+	 *	CBufferedFileReader should call Read<>() and ReadArray<>(), which are inlined.
+	 */
+	class CBufferedFileReader : public lsstd::CStream {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CBufferedFileReader( const char * _pcFile, uint32_t _ui32BlockSize = LSF_BUFFERED_BLOCK_SIZE );
+		LSE_CALLCTOR								~CBufferedFileReader();
+
+
+		// == Functions.
+		/**
+		 * Was the file opened?
+		 *
+		 * \return Returns true if the file was opened and the block allocated.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					IsOpen() const;
+
+		/**
+		 * Reads a value of any plain-old-data type.
+		 *
+		 * \param _tValue Holds the returned value.
+		 * \return Returns true if the whole value was read.
+		 */
+		template <typename _tType>
+		LSE_INLINE LSBOOL LSE_CALL					Read( _tType &_tValue ) const;
+
+		/**
+		 * Reads an array of values of any plain-old-data type, optionally byte-swapping each one.
+		 *
+		 * \param _ptValues Holds the returned values.
+		 * \param _ui32Total Number of values to read.
+		 * \param _bByteSwap If true, each value is byte-swapped after being read (for files of the other endianness).
+		 * \return Returns true if all of the values were read.
+		 */
+		template <typename _tType>
+		LSE_INLINE LSBOOL LSE_CALL					ReadArray( _tType * _ptValues, uint32_t _ui32Total, LSBOOL _bByteSwap = false ) const;
+
+		/**
+		 * Skips the given number of bytes.
+		 *
+		 * \param _ui64Skip The number of bytes to skip.
+		 * \return Returns true if the new position is within the file.
+		 */
+		LSBOOL LSE_CALL								SkipBytes( uint64_t _ui64Skip ) const;
+
+		/**
+		 * Gets the position in the file of the next byte to be read.
+		 *
+		 * \return Returns the position in the file of the next byte to be read.
+		 */
+		LSE_INLINE uint64_t LSE_CALL				GetPos() const;
+
+		/**
+		 * Read bytes from the stream.  Stream position is advanced by the amount read.
+		 *
+		 * \param _pui8Buffer Buffer to hold the bytes read from the stream.
+		 * \param _ui32BytesToRead Number of bytes to read.
+		 * \return Returns the actual number of bytes read or LSSTD_SE_ERROR on error.
+		 */
+		virtual uint32_t LSE_CALL					ReadBytes( uint8_t * _pui8Buffer, uint32_t _ui32BytesToRead ) const;
+
+		/**
+		 * Reads a 64-bit unsigned integer from the stream and advances the stream position.
+		 *
+		 * \return Returns the 64-bit unsigned integer at the current position in the stream.
+		 */
+		virtual uint64_t LSE_CALL					ReadUInt64() const;
+
+		/**
+		 * Reads a 32-bit unsigned integer from the stream and advances the stream position.
+		 *
+		 * \return Returns the 32-bit unsigned integer at the current position in the stream.
+		 */
+		virtual uint32_t LSE_CALL					ReadUInt32() const;
+
+		/**
+		 * Reads a 16-bit unsigned integer from the stream and advances the stream position.
+		 *
+		 * \return Returns the 16-bit unsigned integer at the current position in the stream.
+		 */
+		virtual uint16_t LSE_CALL					ReadUInt16() const;
+
+		/**
+		 * Reads an 8-bit unsigned integer from the stream and advances the stream position.
+		 *
+		 * \return Returns the 8-bit unsigned integer at the current position in the stream.
+		 */
+		virtual uint8_t LSE_CALL					ReadUInt8() const;
+
+		/**
+		 * Reads a 32-bit float from the stream and advances the stream position.
+		 *
+		 * \return Returns the 32-bit float at the current position in the stream.
+		 */
+		virtual float LSE_CALL						ReadFloat() const;
+
+		/**
+		 * Reads a 64-bit double from the stream and advances the stream position.
+		 *
+		 * \return Returns the 64-bit double at the current position in the stream.
+		 */
+		virtual double LSE_CALL						ReadDouble() const;
+
+		/**
+		 * Not supported.  The stream is read-only.
+		 *
+		 * \param _pui8Buffer Unused.
+		 * \param _ui32BytesToWrite Unused.
+		 * \return Returns LSSTD_SE_ERROR.
+		 */
+		virtual uint32_t LSE_CALL					WriteBytes( const uint8_t * _pui8Buffer, uint32_t _ui32BytesToWrite );
+
+		/**
+		 * Not supported.  The stream is read-only.
+		 *
+		 * \return Returns false.
+		 */
+		virtual LSBOOL LSE_CALL						WriteUInt64( const uint64_t &_ui64Value );
+
+		/**
+		 * Not supported.  The stream is read-only.
+		 *
+		 * \return Returns false.
+		 */
+		virtual LSBOOL LSE_CALL						WriteUInt32( uint32_t _ui32Value );
+
+		/**
+		 * Not supported.  The stream is read-only.
+		 *
+		 * \return Returns false.
+		 */
+		virtual LSBOOL LSE_CALL						WriteUInt16( uint16_t _ui16Value );
+
+		/**
+		 * Not supported.  The stream is read-only.
+		 *
+		 * \return Returns false.
+		 */
+		virtual LSBOOL LSE_CALL						WriteUInt8( uint8_t _ui8Value );
+
+		/**
+		 * Not supported.  The stream is read-only.
+		 *
+		 * \return Returns false.
+		 */
+		virtual LSBOOL LSE_CALL						WriteFloat( float _fValue );
+
+		/**
+		 * Not supported.  The stream is read-only.
+		 *
+		 * \return Returns false.
+		 */
+		virtual LSBOOL LSE_CALL						WriteDouble( const double &_dValue );
+
+
+	protected :
+		// == Members.
+		/** The file. */
+		LSF_FILE									m_fFile;
+
+		/** The block. */
+		uint8_t *									m_pui8Block;
+
+		/** Size of the block. */
+		uint32_t									m_ui32BlockSize;
+
+		/** Read position within the block. */
+		mutable uint32_t							m_ui32Pos;
+
+		/** Number of valid bytes in the block. */
+		mutable uint32_t							m_ui32End;
+
+		/** Position in the file of the byte after the last one in the block. */
+		mutable uint64_t							m_ui64FilePos;
+
+		/** Size of the file. */
+		uint64_t									m_ui64FileSize;
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Was the file opened?
+	 *
+	 * \return Returns true if the file was opened and the block allocated.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CBufferedFileReader::IsOpen() const {
+		return m_pui8Block != NULL;
+	}
+
+	/**
+	 * Reads a value of any plain-old-data type.
+	 *
+	 * \param _tValue Holds the returned value.
+	 * \return Returns true if the whole value was read.
+	 */
+	template <typename _tType>
+	LSE_INLINE LSBOOL LSE_CALL CBufferedFileReader::Read( _tType &_tValue ) const {
+		if ( m_ui32End - m_ui32Pos >= sizeof( _tType ) ) {
+			// A fixed-length byte loop rather than MemCpy(), so that the compiler turns it into a single unaligned load.
+			const uint8_t * pui8Src = m_pui8Block + m_ui32Pos;
+			uint8_t * pui8Dst = reinterpret_cast<uint8_t *>(&_tValue);
+			for ( uint32_t I = 0; I < sizeof( _tType ); ++I ) {
+				pui8Dst[I] = pui8Src[I];
+			}
+			m_ui32Pos += sizeof( _tType );
+			return true;
+		}
+		return ReadBytes( reinterpret_cast<uint8_t *>(&_tValue), sizeof( _tType ) ) == sizeof( _tType );
+	}
+
+	/**
+	 * Reads an array of values of any plain-old-data type, optionally byte-swapping each one.
+	 *
+	 * \param _ptValues Holds the returned values.
+	 * \param _ui32Total Number of values to read.
+	 * \param _bByteSwap If true, each value is byte-swapped after being read (for files of the other endianness).
+	 * \return Returns true if all of the values were read.
+	 */
+	template <typename _tType>
+	LSE_INLINE LSBOOL LSE_CALL CBufferedFileReader::ReadArray( _tType * _ptValues, uint32_t _ui32Total, LSBOOL _bByteSwap ) const {
+		uint8_t * pui8Dst = reinterpret_cast<uint8_t *>(_ptValues);
+		uint64_t ui64Size = static_cast<uint64_t>(_ui32Total) * sizeof( _tType );
+		// ReadBytes() takes 32-bit lengths.
+		for ( uint64_t ui64Done = 0; ui64Done < ui64Size; ) {
+			uint32_t ui32Chunk = static_cast<uint32_t>(CStd::Min<uint64_t>( ui64Size - ui64Done, 0x80000000ULL ));
+			if ( ReadBytes( pui8Dst + ui64Done, ui32Chunk ) != ui32Chunk ) { return false; }
+			ui64Done += ui32Chunk;
+		}
+		if ( _bByteSwap ) {
+			CStd::ByteSwapArray( _ptValues, _ui32Total, sizeof( _tType ) );
+		}
+		return true;
+	}
+
+	/**
+	 * Gets the position in the file of the next byte to be read.
+	 *
+	 * \return Returns the position in the file of the next byte to be read.
+	 */
+	LSE_INLINE uint64_t LSE_CALL CBufferedFileReader::GetPos() const {
+		return m_ui64FilePos - (m_ui32End - m_ui32Pos);
+	}
+
+}	// namespace lsf
+
+#endif	// __LSF_BUFFEREDFILEREADER_H__
@@ -0,0 +1,225 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A write-only file stream that gathers writes into a block and writes the block to the file when it
+ *	fills.  Write<>() and WriteArray<>() are inlined and non-virtual.  The counterpart to CBufferedFileReader.
+ */
+
+#include "LSFBufferedFileWriter.h"
+
+
+namespace lsf {
+
+	// == Various constructors.
+	LSE_CALLCTOR CBufferedFileWriter::CBufferedFileWriter( const char * _pcFile, LSBOOL _bAppend, uint32_t _ui32BlockSize ) :
+		m_pui8Block( NULL ),
+		m_ui32BlockSize( _ui32BlockSize ? _ui32BlockSize : LSF_BUFFERED_BLOCK_SIZE ),
+		m_ui32Pos( 0 ),
+		m_ui64FilePos( 0 ) {
+		m_fFile = CFileLib::OpenFile( _pcFile, _bAppend ? LSF_OF_APPEND : LSF_OF_WRITE, true );
+		if ( !m_fFile ) {
+			CStd::DebugPrintA( "FAILED TO OPEN FILE " );
+			CStd::DebugPrintA( _pcFile );
+			CStd::DebugPrintA( ".\r\n" );
+			return;
+		}
+		if ( _bAppend ) {
+			m_ui64FilePos = CFileLib::GetFileSize( m_fFile );
+		}
+		m_pui8Block = LSENEW uint8_t[m_ui32BlockSize];
+		if ( !m_pui8Block ) {
+			CFileLib::CloseFile( m_fFile );
+			m_fFile = NULL;
+		}
+	}
+	LSE_CALLCTOR CBufferedFileWriter::~CBufferedFileWriter() {
+		Flush();
+		LSEDELETE [] m_pui8Block;
+		m_pui8Block = NULL;
+		if ( m_fFile ) {
+			CFileLib::CloseFile( m_fFile );
+		}
+	}
+
+	// == Functions.
+	/**
+	 * Writes anything in the block to the file.
+	 *
+	 * \return Returns true if the block was written.
+	 */
+	LSBOOL LSE_CALL CBufferedFileWriter::Flush() {
+		if ( !m_pui8Block ) { return false; }
+		if ( !m_ui32Pos ) { return true; }
+		if ( !CFileLib::WriteFile( m_fFile, m_pui8Block, m_ui32Pos ) ) { return false; }
+		m_ui64FilePos += m_ui32Pos;
+		m_ui32Pos = 0;
+		return true;
+	}
+
+	/**
+	 * Not supported.  The stream is write-only.
+	 *
+	 * \param _pui8Buffer Unused.
+	 * \param _ui32BytesToRead Unused.
+	 * \return Returns LSSTD_SE_ERROR.
+	 */
+	uint32_t LSE_CALL CBufferedFileWriter::ReadBytes( uint8_t * /*_pui8Buffer*/, uint32_t /*_ui32BytesToRead*/ ) const {
+		return LSSTD_SE_ERROR;
+	}
+
+	/**
+	 * Not supported.  The stream is write-only.
+	 *
+	 * \return Returns 0.
+	 */
+	uint64_t LSE_CALL CBufferedFileWriter::ReadUInt64() const {
+		return 0ULL;
+	}
+
+	/**
+	 * Not supported.  The stream is write-only.
+	 *
+	 * \return Returns 0.
+	 */
+	uint32_t LSE_CALL CBufferedFileWriter::ReadUInt32() const {
+		return 0;
+	}
+
+	/**
+	 * Not supported.  The stream is write-only.
+	 *
+	 * \return Returns 0.
+	 */
+	uint16_t LSE_CALL CBufferedFileWriter::ReadUInt16() const {
+		return 0;
+	}
+
+	/**
+	 * Not supported.  The stream is write-only.
+	 *
+	 * \return Returns 0.
+	 */
+	uint8_t LSE_CALL CBufferedFileWriter::ReadUInt8() const {
+		return 0;
+	}
+
+	/**
+	 * Not supported.  The stream is write-only.
+	 *
+	 * \return Returns 0.
+	 */
+	float LSE_CALL CBufferedFileWriter::ReadFloat() const {
+		return 0.0f;
+	}
+
+	/**
+	 * Not supported.  The stream is write-only.
+	 *
+	 * \return Returns 0.
+	 */
+	double LSE_CALL CBufferedFileWriter::ReadDouble() const {
+		return 0.0;
+	}
+
+	/**
+	 * Writes bytes to the stream.  Stream position is advanced by the amount written.
+	 *
+	 * \param _pui8Buffer Buffer containing the bytes to write.
+	 * \param _ui32BytesToWrite Number of bytes to write.
+	 * \return Returns the actual number of bytes written or LSSTD_SE_ERROR on error.
+	 */
+	uint32_t LSE_CALL CBufferedFileWriter::WriteBytes( const uint8_t * _pui8Buffer, uint32_t _ui32BytesToWrite ) {
+		if ( !m_pui8Block ) { return LSSTD_SE_ERROR; }
+		uint32_t ui32Done = 0;
+		while ( ui32Done < _ui32BytesToWrite ) {
+			uint32_t ui32Left = _ui32BytesToWrite - ui32Done;
+			uint32_t ui32Room = m_ui32BlockSize - m_ui32Pos;
+			if ( ui32Left < ui32Room || (m_ui32Pos && ui32Left <= ui32Room) ) {
+				CStd::MemCpy( m_pui8Block + m_ui32Pos, _pui8Buffer + ui32Done, ui32Left );
+				m_ui32Pos += ui32Left;
+				break;
+			}
+			if ( !m_ui32Pos ) {
+				// Large writes go straight to the file.
+				if ( !CFileLib::WriteFile( m_fFile, _pui8Buffer + ui32Done, ui32Left ) ) { return ui32Done; }
+				m_ui64FilePos += ui32Left;
+				break;
+			}
+			// Top up the block and write it.
+			CStd::MemCpy( m_pui8Block + m_ui32Pos, _pui8Buffer + ui32Done, ui32Room );
+			m_ui32Pos += ui32Room;
+			ui32Done += ui32Room;
+			if ( !Flush() ) { return ui32Done; }
+		}
+		return _ui32BytesToWrite;
+	}
+
+	/**
+	 * Writes a 64-bit unsigned integer to the stream and advances the stream position.
+	 *
+	 * \param _ui64Value The value to write.
+	 * \return Returns true if the value was written.
+	 */
+	LSBOOL LSE_CALL CBufferedFileWriter::WriteUInt64( const uint64_t &_ui64Value ) {
+		return Write( _ui64Value );
+	}
+
+	/**
+	 * Writes a 32-bit unsigned integer to the stream and advances the stream position.
+	 *
+	 * \param _ui32Value The value to write.
+	 * \return Returns true if the value was written.
+	 */
+	LSBOOL LSE_CALL CBufferedFileWriter::WriteUInt32( uint32_t _ui32Value ) {
+		return Write( _ui32Value );
+	}
+
+	/**
+	 * Writes a 16-bit unsigned integer to the stream and advances the stream position.
+	 *
+	 * \param _ui16Value The value to write.
+	 * \return Returns true if the value was written.
+	 */
+	LSBOOL LSE_CALL CBufferedFileWriter::WriteUInt16( uint16_t _ui16Value ) {
+		return Write( _ui16Value );
+	}
+
+	/**
+	 * Writes an 8-bit unsigned integer to the stream and advances the stream position.
+	 *
+	 * \param _ui8Value The value to write.
+	 * \return Returns true if the value was written.
+	 */
+	LSBOOL LSE_CALL CBufferedFileWriter::WriteUInt8( uint8_t _ui8Value ) {
+		return Write( _ui8Value );
+	}
+
+	/**
+	 * Writes a 32-bit float to the stream and advances the stream position.
+	 *
+	 * \param _fValue The value to write.
+	 * \return Returns true if the value was written.
+	 */
+	LSBOOL LSE_CALL CBufferedFileWriter::WriteFloat( float _fValue ) {
+		return Write( _fValue );
+	}
+
+	/**
+	 * Writes a 64-bit double to the stream and advances the stream position.
+	 *
+	 * \param _dValue The value to write.
+	 * \return Returns true if the value was written.
+	 */
+	LSBOOL LSE_CALL CBufferedFileWriter::WriteDouble( const double &_dValue ) {
+		return Write( _dValue );
+	}
+
+}	// namespace lsf
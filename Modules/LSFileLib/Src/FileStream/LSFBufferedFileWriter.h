@@ -0,0 +1,303 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A write-only file stream that gathers writes into a block and writes the block to the file when it
+ *	fills.  Write<>() and WriteArray<>() are inlined and non-virtual.  The counterpart to CBufferedFileReader.
+ */
+
+
+#ifndef __LSF_BUFFEREDFILEWRITER_H__
+#define __LSF_BUFFEREDFILEWRITER_H__
+
+#include "../LSFFileLib.h"
+#include "LSFBufferedFileReader.h"
+#include "Streams/LSSTDStream.h"
+
+namespace lsf {
+
+	/**
+	 * Class CBufferedFileWriter
+	 * \brief A write-only file stream that writes a block at a time.
+	 *
+	 * Description: A write-only file stream that gathers writes into a block and writes the block to the file when it
+	 *	fills.  Anything still in the block is written by Flush() or on destruction.
+	 */
+	class CBufferedFileWriter : public lsstd::CStream {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CBufferedFileWriter( const char * _pcFile, LSBOOL _bAppend = false, uint32_t _ui32BlockSize = LSF_BUFFERED_BLOCK_SIZE );
+		LSE_CALLCTOR								~CBufferedFileWriter();
+
+
+		// == Functions.
+		/**
+		 * Was the file opened?
+		 *
+		 * \return Returns true if the file was opened and the block allocated.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					IsOpen() const;
+
+		/**
+		 * Writes a value of any plain-old-data type.
+		 *
+		 * \param _tValue The value to write.
+		 * \return Returns true if the value was written.
+		 */
+		template <typename _tType>
+		LSE_INLINE LSBOOL LSE_CALL					Write( const _tType &_tValue );
+
+		/**
+		 * Writes an array of values of any plain-old-data type, optionally byte-swapping each one.  The source array is
+		 *	not modified.
+		 *
+		 * \param _ptValues The values to write.
+		 * \param _ui32Total Number of values to write.
+		 * \param _bByteSwap If true, each value is byte-swapped as it is written (for files of the other endianness).
+		 * \return Returns true if all of the values were written.
+		 */
+		template <typename _tType>
+		LSE_INLINE LSBOOL LSE_CALL					WriteArray( const _tType * _ptValues, uint32_t _ui32Total, LSBOOL _bByteSwap = false );
+
+		/**
+		 * Writes anything in the block to the file.
+		 *
+		 * \return Returns true if the block was written.
+		 */
+		LSBOOL LSE_CALL								Flush();
+
+		/**
+		 * Gets the position in the file of the next byte to be written.
+		 *
+		 * \return Returns the position in the file of the next byte to be written.
+		 */
+		LSE_INLINE uint64_t LSE_CALL				GetPos() const;
+
+		/**
+		 * Not supported.  The stream is write-only.
+		 *
+		 * \param _pui8Buffer Unused.
+		 * \param _ui32BytesToRead Unused.
+		 * \return Returns LSSTD_SE_ERROR.
+		 */
+		virtual uint32_t LSE_CALL					ReadBytes( uint8_t * _pui8Buffer, uint32_t _ui32BytesToRead ) const;
+
+		/**
+		 * Not supported.  The stream is write-only.
+		 *
+		 * \return Returns 0.
+		 */
+		virtual uint64_t LSE_CALL					ReadUInt64() const;
+
+		/**
+		 * Not supported.  The stream is write-only.
+		 *
+		 * \return Returns 0.
+		 */
+		virtual uint32_t LSE_CALL					ReadUInt32() const;
+
+		/**
+		 * Not supported.  The stream is write-only.
+		 *
+		 * \return Returns 0.
+		 */
+		virtual uint16_t LSE_CALL					ReadUInt16() const;
+
+		/**
+		 * Not supported.  The stream is write-only.
+		 *
+		 * \return Returns 0.
+		 */
+		virtual uint8_t LSE_CALL					ReadUInt8() const;
+
+		/**
+		 * Not supported.  The stream is write-only.
+		 *
+		 * \return Returns 0.
+		 */
+		virtual float LSE_CALL						ReadFloat() const;
+
+		/**
+		 * Not supported.  The stream is write-only.
+		 *
+		 * \return Returns 0.
+		 */
+		virtual double LSE_CALL						ReadDouble() const;
+
+		/**
+		 * Writes bytes to the stream.  Stream position is advanced by the amount written.
+		 *
+		 * \param _pui8Buffer Buffer containing the bytes to write.
+		 * \param _ui32BytesToWrite Number of bytes to write.
+		 * \return Returns the actual number of bytes written or LSSTD_SE_ERROR on error.
+		 */
+		virtual uint32_t LSE_CALL					WriteBytes( const uint8_t * _pui8Buffer, uint32_t _ui32BytesToWrite );
+
+		/**
+		 * Writes a 64-bit unsigned integer to the stream and advances the stream position.
+		 *
+		 * \param _ui64Value The value to write.
+		 * \return Returns true if the value was written.
+		 */
+		virtual LSBOOL LSE_CALL						WriteUInt64( const uint64_t &_ui64Value );
+
+		/**
+		 * Writes a 32-bit unsigned integer to the stream and advances the stream position.
+		 *
+		 * \param _ui32Value The value to write.
+		 * \return Returns true if the value was written.
+		 */
+		virtual LSBOOL LSE_CALL						WriteUInt32( uint32_t _ui32Value );
+
+		/**
+		 * Writes a 16-bit unsigned integer to the stream and advances the stream position.
+		 *
+		 * \param _ui16Value The value to write.
+		 * \return Returns true if the value was written.
+		 */
+		virtual LSBOOL LSE_CALL						WriteUInt16( uint16_t _ui16Value );
+
+		/**
+		 * Writes an 8-bit unsigned integer to the stream and advances the stream position.
+		 *
+		 * \param _ui8Value The value to write.
+		 * \return Returns true if the value was written.
+		 */
+		virtual LSBOOL LSE_CALL						WriteUInt8( uint8_t _ui8Value );
+
+		/**
+		 * Writes a 32-bit float to the stream and advances the stream position.
+		 *
+		 * \param _fValue The value to write.
+		 * \return Returns true if the value was written.
+		 */
+		virtual LSBOOL LSE_CALL						WriteFloat( float _fValue );
+
+		/**
+		 * Writes a 64-bit double to the stream and advances the stream position.
+		 *
+		 * \param _dValue The value to write.
+		 * \return Returns true if the value was written.
+		 */
+		virtual LSBOOL LSE_CALL						WriteDouble( const double &_dValue );
+
+
+	protected :
+		// == Members.
+		/** The file. */
+		LSF_FILE									m_fFile;
+
+		/** The block. */
+		uint8_t *									m_pui8Block;
+
+		/** Size of the block. */
+		uint32_t									m_ui32BlockSize;
+
+		/** Number of bytes in the block. */
+		uint32_t									m_ui32Pos;
+
+		/** Number of bytes written to the file. */
+		uint64_t									m_ui64FilePos;
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Was the file opened?
+	 *
+	 * \return Returns true if the file was opened and the block allocated.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CBufferedFileWriter::IsOpen() const {
+		return m_pui8Block != NULL;
+	}
+
+	/**
+	 * Writes a value of any plain-old-data type.
+	 *
+	 * \param _tValue The value to write.
+	 * \return Returns true if the value was written.
+	 */
+	template <typename _tType>
+	LSE_INLINE LSBOOL LSE_CALL CBufferedFileWriter::Write( const _tType &_tValue ) {
+		if ( m_ui32BlockSize - m_ui32Pos >= sizeof( _tType ) ) {
+			// A fixed-length byte loop rather than MemCpy(), so that the compiler turns it into a single unaligned store.
+			const uint8_t * pui8Src = reinterpret_cast<const uint8_t *>(&_tValue);
+			uint8_t * pui8Dst = m_pui8Block + m_ui32Pos;
+			for ( uint32_t I = 0; I < sizeof( _tType ); ++I ) {
+				pui8Dst[I] = pui8Src[I];
+			}
+			m_ui32Pos += sizeof( _tType );
+			return true;
+		}
+		return WriteBytes( reinterpret_cast<const uint8_t *>(&_tValue), sizeof( _tType ) ) == sizeof( _tType );
+	}
+
+	/**
+	 * Writes an array of values of any plain-old-data type, optionally byte-swapping each one.  The source array is
+	 *	not modified.
+	 *
+	 * \param _ptValues The values to write.
+	 * \param _ui32Total Number of values to write.
+	 * \param _bByteSwap If true, each value is byte-swapped as it is written (for files of the other endianness).
+	 * \return Returns true if all of the values were written.
+	 */
+	template <typename _tType>
+	LSE_INLINE LSBOOL LSE_CALL CBufferedFileWriter::WriteArray( const _tType * _ptValues, uint32_t _ui32Total, LSBOOL _bByteSwap ) {
+		const uint8_t * pui8Src = reinterpret_cast<const uint8_t *>(_ptValues);
+		if ( !_bByteSwap ) {
+			uint64_t ui64Size = static_cast<uint64_t>(_ui32Total) * sizeof( _tType );
+			// WriteBytes() takes 32-bit lengths.
+			for ( uint64_t ui64Done = 0; ui64Done < ui64Size; ) {
+				uint32_t ui32Chunk = static_cast<uint32_t>(CStd::Min<uint64_t>( ui64Size - ui64Done, 0x80000000ULL ));
+				if ( WriteBytes( pui8Src + ui64Done, ui32Chunk ) != ui32Chunk ) { return false; }
+				ui64Done += ui32Chunk;
+			}
+			return true;
+		}
+
+		// Swapping is done in the block so that the source is left alone.  Values too large for the block go one at a time.
+		if ( !m_pui8Block ) { return false; }
+		for ( uint32_t I = 0; I < _ui32Total; ) {
+			uint32_t ui32Fits = (m_ui32BlockSize - m_ui32Pos) / sizeof( _tType );
+			if ( !ui32Fits ) {
+				if ( m_ui32Pos ) {
+					if ( !Flush() ) { return false; }
+					continue;
+				}
+				_tType tSwapped = _ptValues[I++];
+				CStd::ByteSwapArray( &tSwapped, 1, sizeof( _tType ) );
+				if ( WriteBytes( reinterpret_cast<const uint8_t *>(&tSwapped), sizeof( _tType ) ) != sizeof( _tType ) ) { return false; }
+				continue;
+			}
+			uint32_t ui32Copy = CStd::Min( ui32Fits, _ui32Total - I );
+			uint8_t * pui8Dst = m_pui8Block + m_ui32Pos;
+			CStd::MemCpy( pui8Dst, pui8Src + static_cast<uintptr_t>(I) * sizeof( _tType ), ui32Copy * sizeof( _tType ) );
+			CStd::ByteSwapArray( pui8Dst, ui32Copy, sizeof( _tType ) );
+			m_ui32Pos += ui32Copy * sizeof( _tType );
+			I += ui32Copy;
+		}
+		return true;
+	}
+
+	/**
+	 * Gets the position in the file of the next byte to be written.
+	 *
+	 * \return Returns the position in the file of the next byte to be written.
+	 */
+	LSE_INLINE uint64_t LSE_CALL CBufferedFileWriter::GetPos() const {
+		return m_ui64FilePos + m_ui32Pos;
+	}
+
+}	// namespace lsf
+
+#endif	// __LSF_BUFFEREDFILEWRITER_H__
@@ -16,6 +16,11 @@
 #include "LSFFilesEx.h"
 #include "String/LSTLWString.h"
 #include <cassert>
+#ifdef LSE_LINUX
+#include <dirent.h>			// For ::opendir().
+#include <fnmatch.h>		// For ::fnmatch().
+#include <sys/stat.h>		// For ::stat().
+#endif	// #ifdef LSE_LINUX
 
 
 namespace lsf {
@@ -186,6 +191,51 @@ namespace lsf {
 
 		::FindClose( hDir );
 		return true;
+#elif defined( LSE_LINUX )
+		CString sPath = _pcFolderPath;
+		sPath.FindAndReplaceChar( '\\', '/' );
+		while ( sPath.GetLastChar() == '/' ) { sPath.RemLastChar(); }
+		sPath.Append( '/' );
+		CString sSearch;
+		if ( _pcSearchString ) {
+			sSearch = _pcSearchString;
+			sSearch.FindAndReplaceChar( '\\', '/' );
+			while ( sSearch.CStr()[0] == '/' ) {
+				sSearch.RemChar( 0 );
+			}
+		}
+		else {
+			sSearch = "*";
+		}
+
+		DIR * pdDir = ::opendir( sPath.CStr() );
+		if ( !pdDir ) { return false; }
+
+		// Like ::FindFirstFile(), succeed if anything matched, even if it was then filtered out.
+		LSBOOL bFound = false;
+		struct dirent * pdeEntry;
+		while ( (pdeEntry = ::readdir( pdDir )) != NULL ) {
+			if ( pdeEntry->d_name[0] == '.' ) { continue; }
+			if ( ::fnmatch( sSearch.CStr(), pdeEntry->d_name, 0 ) != 0 ) { continue; }
+			bFound = true;
+			CString sFile = sPath + pdeEntry->d_name;
+			bool bIsFolder = pdeEntry->d_type == DT_DIR;
+			if ( pdeEntry->d_type == DT_UNKNOWN || pdeEntry->d_type == DT_LNK ) {
+				// Not every file system fills in d_type, and links must be followed.
+				struct stat sStat;
+				bIsFolder = ::stat( sFile.CStr(), &sStat ) == 0 && S_ISDIR( sStat.st_mode );
+			}
+			if ( !_bIncludeFolders && bIsFolder ) {
+				continue;
+			}
+			if ( !_slReturn.Push( sFile ) ) {
+				::closedir( pdDir );
+				return false;
+			}
+		}
+
+		::closedir( pdDir );
+		return bFound;
 #else
 
 		return false;
@@ -242,6 +292,12 @@ namespace lsf {
 
 		::FindClose( hDir );
 		return true;
+#elif defined( LSE_LINUX )
+		CString sPath = CString::CStringFromUtfX( _pwcFolderPath );
+		if ( !_pwcSearchString ) {
+			return GetFilesInDir( sPath.CStr(), NULL, _bIncludeFolders, _slReturn );
+		}
+		return GetFilesInDir( sPath.CStr(), CString::CStringFromUtfX( _pwcSearchString ).CStr(), _bIncludeFolders, _slReturn );
 #else
 
 		return false;
@@ -33,6 +33,7 @@ namespace lsf {
 	 *	functionality such as loading files to RAM.
 	 */
 	class CFilesEx {
+		friend class						CAsyncReader;
 	public :
 		// == Functions.
 		/**
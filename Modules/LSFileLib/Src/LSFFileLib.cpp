@@ -49,6 +49,15 @@
 #include <sys/stat.h>		// For ::stat().
 #include <unistd.h>			// For ::close().
 #endif	// #ifdef LSE_MAC
+#ifdef LSE_LINUX
+#include "String/LSTLWStringList.h"
+#include <cassert>
+#include <cerrno>			// For errno.
+#include <fcntl.h>			// For ::open() and ::posix_fadvise().
+#include <sys/mman.h>		// For ::mmap() and ::madvise().
+#include <sys/stat.h>		// For ::fstat().
+#include <unistd.h>			// For ::pread() and ::close().
+#endif	// #ifdef LSE_LINUX
 
 
 
@@ -64,7 +73,66 @@ namespace lsf {
 	 * Length of the resource path in characters.
 	 */
 	uint32_t CFileLib::m_ui32ResPathLen = 0;
-	
+
+#ifdef LSE_LINUX
+	// == Functions.
+	/**
+	 * Reads from a file descriptor at a given offset until the requested number of bytes has been read, the end of
+	 *	the file is reached, or an error occurs.
+	 *
+	 * \param _iFile The file descriptor.
+	 * \param _pui8Buffer The buffer to fill.
+	 * \param _uiptrBytesToRead Number of bytes to read.
+	 * \param _ui64Offset The offset in the file from which to read.
+	 * \return Returns the number of bytes read, or ~0 if the descriptor reported an error.
+	 */
+	static uintptr_t LSE_CALL PRead( int _iFile, uint8_t * _pui8Buffer, uintptr_t _uiptrBytesToRead, uint64_t _ui64Offset ) {
+		uintptr_t uiptrRead = 0;
+		while ( uiptrRead < _uiptrBytesToRead ) {
+			ssize_t sThis = ::pread( _iFile, _pui8Buffer + uiptrRead, _uiptrBytesToRead - uiptrRead,
+				static_cast<off_t>(_ui64Offset + uiptrRead) );
+			if ( sThis < 0 ) {
+				if ( errno == EINTR ) { continue; }
+				return static_cast<uintptr_t>(~0);
+			}
+			if ( sThis == 0 ) { break; }
+			uiptrRead += static_cast<uintptr_t>(sThis);
+		}
+		return uiptrRead;
+	}
+
+	/**
+	 * Reads with O_DIRECT, bypassing the page cache, opening the direct descriptor the first time.  The file position,
+	 *	the buffer, and the length must all be multiples of LSF_DIRECT_READ_ALIGN.
+	 *
+	 * \param _fFile The file from which to read.  Its position is advanced by the number of bytes read.
+	 * \param _pui8Buffer The buffer to fill.
+	 * \param _uiptrBytesToRead Number of bytes to read.
+	 * \return Returns the number of bytes read, which is 0 if the file system does not allow direct reads.  The
+	 *	caller reads whatever remains normally.
+	 */
+	static uintptr_t LSE_CALL ReadDirect( LSF_FILE _fFile, uint8_t * _pui8Buffer, uintptr_t _uiptrBytesToRead ) {
+		if ( _fFile->iDirectFile == -1 ) {
+			// The path is not kept, so reopen the file through its descriptor.
+			char szPath[32];
+			CStd::SPrintF( szPath, LSE_ELEMENTS( szPath ), "/proc/self/fd/%d", _fFile->iFile );
+			_fFile->iDirectFile = ::open( szPath, O_RDONLY | O_DIRECT | O_CLOEXEC );
+			if ( _fFile->iDirectFile == -1 ) { _fFile->iDirectFile = -2; }
+		}
+		if ( _fFile->iDirectFile < 0 ) { return 0; }
+
+		uintptr_t uiptrRead = PRead( _fFile->iDirectFile, _pui8Buffer, _uiptrBytesToRead, _fFile->ui64Pos );
+		if ( uiptrRead == static_cast<uintptr_t>(~0) ) {
+			// Some file systems (tmpfs, some network mounts) accept the open but not the read.
+			::close( _fFile->iDirectFile );
+			_fFile->iDirectFile = -2;
+			return 0;
+		}
+		_fFile->ui64Pos += uiptrRead;
+		return uiptrRead;
+	}
+#endif	// #ifdef LSE_LINUX
+
 	// == Functions.
 	/**
 	 * Open a file.  Returns NULL if failed.
@@ -157,6 +225,41 @@ namespace lsf {
 		CStd::StrCat( cString, "b" );
 		LSF_FILE fRet = ::fopen( szFinal, cString );
 		
+		return fRet;
+#elif defined( LSE_LINUX )
+		int iFlags = O_CLOEXEC;
+		if ( !(_ofOpenType & (LSF_OF_WRITE | LSF_OF_APPEND)) ) { iFlags |= O_RDONLY; }
+		else if ( _ofOpenType & LSF_OF_READ ) { iFlags |= O_RDWR; }
+		else { iFlags |= O_WRONLY; }
+		if ( _ofOpenType & LSF_OF_APPEND ) { iFlags |= O_APPEND; }
+		if ( _bOpenAlways ) {
+			iFlags |= O_CREAT;
+			// As on Windows, opening for writing with _bOpenAlways replaces the file.  Appending never does.
+			if ( (_ofOpenType & LSF_OF_WRITE) && !(_ofOpenType & LSF_OF_APPEND) ) { iFlags |= O_TRUNC; }
+		}
+
+		int iFile;
+		do {
+			iFile = ::open( _pcFile, iFlags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH );
+		} while ( iFile == -1 && errno == EINTR );
+		if ( iFile == -1 ) { return NULL; }
+
+		LSF_FILE fRet = LSENEW LSF_FILE_DESC;
+		if ( !fRet ) {
+			::close( iFile );
+			return NULL;
+		}
+		fRet->iFile = iFile;
+		fRet->iDirectFile = -1;
+		fRet->ui64Pos = 0;
+		fRet->ui32Mode = _ofOpenType;
+		if ( _ofOpenType & LSF_OF_APPEND ) {
+			fRet->ui64Pos = GetFileSize( fRet );
+		}
+		if ( _ofOpenType & LSF_OF_READ ) {
+			// Files are almost always read front to back; this doubles the kernel's read-ahead window.
+			::posix_fadvise( iFile, 0, 0, POSIX_FADV_SEQUENTIAL );
+		}
 		return fRet;
 #endif	// LSE_WINDOWS
 	}
@@ -184,6 +287,15 @@ namespace lsf {
 			return true;
 		}
 		return false;
+#elif defined( LSE_LINUX )
+		// The descriptor is released even if ::close() reports an error, so the handle is always freed.
+		if ( _fFile->iDirectFile >= 0 ) {
+			::close( _fFile->iDirectFile );
+		}
+		LSBOOL bRet = ::close( _fFile->iFile ) == 0;
+		LSEDELETE _fFile;
+		_fFile = NULL;
+		return bRet;
 #endif	// LSE_WINDOWS
 	}
 
@@ -207,6 +319,28 @@ namespace lsf {
 		return true;
 #elif defined( LSE_MAC )
 		return ::fread( _pvBuffer, _uiptrBytesToRead, 1, _fFile ) == 1;
+#elif defined( LSE_LINUX )
+		uint8_t * pui8Buffer = static_cast<uint8_t *>(_pvBuffer);
+#if LSF_DIRECT_READ_SIZE
+		// The position and the buffer must be aligned alike for any part of the read to be direct.
+		if ( _uiptrBytesToRead >= LSF_DIRECT_READ_SIZE && !(_fFile->ui32Mode & LSF_OF_WRITE) &&
+			((_fFile->ui64Pos - reinterpret_cast<uintptr_t>(pui8Buffer)) & (LSF_DIRECT_READ_ALIGN - 1)) == 0 ) {
+			// Read up to the first aligned position normally.
+			uintptr_t uiptrHead = static_cast<uintptr_t>((LSF_DIRECT_READ_ALIGN - (_fFile->ui64Pos & (LSF_DIRECT_READ_ALIGN - 1))) & (LSF_DIRECT_READ_ALIGN - 1));
+			if ( PRead( _fFile->iFile, pui8Buffer, uiptrHead, _fFile->ui64Pos ) != uiptrHead ) { return false; }
+			_fFile->ui64Pos += uiptrHead;
+			pui8Buffer += uiptrHead;
+			_uiptrBytesToRead -= uiptrHead;
+
+			uintptr_t uiptrDirect = ReadDirect( _fFile, pui8Buffer, _uiptrBytesToRead & ~static_cast<uintptr_t>(LSF_DIRECT_READ_ALIGN - 1) );
+			pui8Buffer += uiptrDirect;
+			_uiptrBytesToRead -= uiptrDirect;
+		}
+#endif	// #if LSF_DIRECT_READ_SIZE
+		uintptr_t uiptrRead = PRead( _fFile->iFile, pui8Buffer, _uiptrBytesToRead, _fFile->ui64Pos );
+		if ( uiptrRead == static_cast<uintptr_t>(~0) ) { return false; }
+		_fFile->ui64Pos += uiptrRead;
+		return uiptrRead == _uiptrBytesToRead;
 #endif	// LSE_WINDOWS
 	}
 
@@ -230,6 +364,26 @@ namespace lsf {
 		return true;
 #elif defined( LSE_MAC )
 		return ::fwrite( _pvBuffer, _uiptrBytesToWrite, 1, _fFile ) == 1;
+#elif defined( LSE_LINUX )
+		const uint8_t * pui8Buffer = static_cast<const uint8_t *>(_pvBuffer);
+		LSBOOL bAppend = (_fFile->ui32Mode & LSF_OF_APPEND) != 0;
+		while ( _uiptrBytesToWrite ) {
+			// Linux ignores the offset given to ::pwrite() on files opened with O_APPEND, so use ::write() for those.
+			ssize_t sThis = bAppend ? ::write( _fFile->iFile, pui8Buffer, _uiptrBytesToWrite ) :
+				::pwrite( _fFile->iFile, pui8Buffer, _uiptrBytesToWrite, static_cast<off_t>(_fFile->ui64Pos) );
+			if ( sThis < 0 ) {
+				if ( errno == EINTR ) { continue; }
+				return false;
+			}
+			pui8Buffer += sThis;
+			_uiptrBytesToWrite -= static_cast<uintptr_t>(sThis);
+			_fFile->ui64Pos += static_cast<uint64_t>(sThis);
+		}
+		if ( bAppend ) {
+			// Appends go to the end regardless of the position.
+			_fFile->ui64Pos = static_cast<uint64_t>(::lseek( _fFile->iFile, 0, SEEK_CUR ));
+		}
+		return true;
 #endif	// LSE_WINDOWS
 	}
 
@@ -250,6 +404,28 @@ namespace lsf {
 		return ::SetFilePointerEx( _fFile, liDist, NULL, _sMoveMethod );
 #elif defined( LSE_MAC )
 		return ::fseeko( _fFile, _i64DistanceToMove, _sMoveMethod ) == 0;
+#elif defined( LSE_LINUX )
+		int64_t i64Base;
+		switch ( _sMoveMethod ) {
+			case LSF_S_BEGIN : {
+				i64Base = 0;
+				break;
+			}
+			case LSF_S_CURRENT : {
+				i64Base = static_cast<int64_t>(_fFile->ui64Pos);
+				break;
+			}
+			case LSF_S_END : {
+				struct stat sStat;
+				if ( ::fstat( _fFile->iFile, &sStat ) != 0 ) { return false; }
+				i64Base = static_cast<int64_t>(sStat.st_size);
+				break;
+			}
+			default : { return false; }
+		}
+		if ( i64Base + _i64DistanceToMove < 0 ) { return false; }
+		_fFile->ui64Pos = static_cast<uint64_t>(i64Base + _i64DistanceToMove);
+		return true;
 #endif	// LSE_WINDOWS
 	}
 
@@ -270,6 +446,8 @@ namespace lsf {
 		return liRet.QuadPart;
 #elif defined( LSE_MAC )
 		return static_cast<uint64_t>(::ftello( _fFile ));
+#elif defined( LSE_LINUX )
+		return _fFile->ui64Pos;
 #endif	// LSE_WINDOWS
 	}
 
@@ -367,6 +545,38 @@ namespace lsf {
 		_fmMap.iFile = iFile;
 		_fmMap.ui32Mode = _ofOpenType;
 		return true;
+#elif defined( LSE_LINUX )
+		_fmMap.iFile = -1;
+		_fmMap.ui32Mode = 0;
+		// Shared writable mappings need a descriptor opened for both reading and writing.
+		int iFlags;
+		if ( _ofOpenType == LSF_OF_READ ) {
+			iFlags = O_RDONLY;
+		}
+		else if ( _ofOpenType == LSF_OF_WRITE || _ofOpenType == (LSF_OF_READ | LSF_OF_WRITE) ) {
+			iFlags = O_RDWR;
+		}
+		else {
+			// Invalid mapping type.
+			return false;
+		}
+		int iFile = ::open( _pcFile, iFlags | O_CLOEXEC );
+		if ( iFile == -1 ) { return false; }
+
+		// As on Windows, the file must not be 0 bytes.
+		struct stat sStat;
+		if ( ::fstat( iFile, &sStat ) != 0 || sStat.st_size == 0 ) {
+			::close( iFile );
+			return false;
+		}
+		if ( _ofOpenType == LSF_OF_READ ) {
+			::posix_fadvise( iFile, 0, 0, POSIX_FADV_SEQUENTIAL );
+		}
+
+		// Done.  Save everything.
+		_fmMap.iFile = iFile;
+		_fmMap.ui32Mode = _ofOpenType;
+		return true;
 #endif	// LSE_WINDOWS
 
 	}
@@ -460,6 +670,14 @@ namespace lsf {
 		_fmMap.iFile = iFile;
 		_fmMap.ui32Mode = _ofOpenType;
 		return true;
+#elif defined( LSE_LINUX )
+		char szBuffer[LSF_MAX_PATH];
+		if ( !CStd::UtfXToUtf8( _pwcFile, szBuffer, LSF_MAX_PATH ) ) {
+			_fmMap.iFile = -1;
+			_fmMap.ui32Mode = 0;
+			return false;
+		}
+		return CreateFileMap( szBuffer, _ofOpenType, _fmMap );
 #endif	// LSE_WINDOWS
 	}
 
@@ -483,7 +701,7 @@ namespace lsf {
 			_fmMap.hFile = NULL;
 		}
 		// Done.
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		if ( _fmMap.iFile != -1 ) {
 			::close( _fmMap.iFile );
 			_fmMap.iFile = -1;
@@ -558,6 +776,18 @@ namespace lsf {
 		void * pvData = ::mmap( NULL, _uiptrLen, static_cast<int>(ui32Prot), MAP_SHARED, _fmMap.iFile, static_cast<off_t>(_ui64Offset) );
 		if ( pvData == MAP_FAILED ) { return NULL; }
 		return pvData;
+#elif defined( LSE_LINUX )
+		int iProt = PROT_READ;
+		if ( _fmMap.ui32Mode & LSF_OF_WRITE ) {
+			iProt |= PROT_WRITE;
+		}
+		void * pvData = ::mmap( NULL, _uiptrLen, iProt, MAP_SHARED, _fmMap.iFile, static_cast<off_t>(_ui64Offset) );
+		if ( pvData == MAP_FAILED ) { return NULL; }
+		// CFileMap walks each view front to back, so ask for aggressive read-ahead and start it now instead of on the
+		//	first page fault.
+		::madvise( pvData, _uiptrLen, MADV_SEQUENTIAL );
+		::madvise( pvData, _uiptrLen, MADV_WILLNEED );
+		return pvData;
 #endif	// LSE_WINDOWS
 	}
 
@@ -573,7 +803,7 @@ namespace lsf {
 		// Remove warning C4100.
 		static_cast<uintptr_t>(_uiptrLen);
 		::UnmapViewOfFile( _pvAddr );
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		::munmap( const_cast<void *>(_pvAddr), _uiptrLen );
 #endif	// LSE_WINDOWS
 	}
@@ -600,6 +830,8 @@ namespace lsf {
 		return siInfo.dwPageSize;
 #elif defined( LSE_MAC )
 		return static_cast<uint32_t>(::getpagesize());
+#elif defined( LSE_LINUX )
+		return static_cast<uint32_t>(::sysconf( _SC_PAGESIZE ));
 #endif	// LSE_WINDOWS
 	}
 
@@ -624,6 +856,10 @@ namespace lsf {
 		uint64_t ui64Pos = static_cast<uint64_t>(::ftello( _fFile ));
 		::fsetpos( _fFile, &pPos );
 		return ui64Pos;
+#elif defined( LSE_LINUX )
+		struct stat sStat;
+		if ( ::fstat( _fFile->iFile, &sStat ) != 0 ) { return 0xFFFFFFFFFFFFFFFFULL; }
+		return static_cast<uint64_t>(sStat.st_size);
 #endif	// LSE_WINDOWS
 	}
 
@@ -666,6 +902,12 @@ namespace lsf {
 		}
 		LSEDELETE [] pcCopy;
 		return static_cast<uint64_t>(sStat.st_size);
+#elif defined( LSE_LINUX )
+		char szBuffer[LSF_MAX_PATH];
+		if ( !CStd::UtfXToUtf8( _pwcFile, szBuffer, LSF_MAX_PATH ) ) { return 0ULL; }
+		struct stat sStat;
+		if ( ::stat( szBuffer, &sStat ) == -1 ) { return 0ULL; }
+		return static_cast<uint64_t>(sStat.st_size);
 #endif	// LSE_WINDOWS
 	}
 
@@ -716,6 +958,12 @@ namespace lsf {
 		LSBOOL bRet = [[NSFileManager defaultManager] fileExistsAtPath:psStr];
 		[psStr release];
 		return bRet;*/
+#elif defined( LSE_LINUX )
+		char szBuffer[LSF_MAX_PATH];
+		if ( !CStd::UtfXToUtf8( _pwcFile, szBuffer, LSF_MAX_PATH ) ) { return false; }
+		struct stat sStat;
+		if ( ::stat( szBuffer, &sStat ) == -1 ) { return false; }
+		return S_ISREG( sStat.st_mode );
 #else
 		return false;	// TODO.
 #endif	// #ifdef LSE_WINDOWS
@@ -778,6 +1026,16 @@ namespace lsf {
 		_pwcRet[iLen++] = L'/';
 		_pwcRet[iLen] = L'\0';
 		return _pwcRet;
+#elif defined( LSE_LINUX )
+		char szBuffer[LSF_MAX_PATH];
+		ssize_t sLen = ::readlink( "/proc/self/exe", szBuffer, LSF_MAX_PATH - 1 );
+		if ( sLen <= 0 ) { return NULL; }
+		// Cut after the last slash.
+		while ( sLen && szBuffer[sLen-1] != '/' ) { --sLen; }
+		if ( !sLen ) { return NULL; }
+		szBuffer[sLen] = '\0';
+		CStd::Utf8ToUtfX( _pwcRet, reinterpret_cast<const LSUTF8 *>(szBuffer), LSF_MAX_PATH );
+		return _pwcRet;
 #endif	// LSE_WINDOWS
 	}
 
@@ -846,8 +1104,8 @@ namespace lsf {
 		BOOL bRet = ::PathCanonicalizeW( _pwcRet, pcBuffer );
 		LSEDELETE [] pcBuffer;
 		return bRet ? _pwcRet : NULL;
-#elif defined( LSE_MAC )
-		// On Macintosh, if the first character is a /, the path is absolute.
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
+		// On Macintosh and Linux, if the first character is a /, the path is absolute.
 		uintptr_t uiptrLen = CStd::WStrLen( _pwcPath ) + LSF_MAX_PATH + 1;
 		wchar_t * pcBuffer = LSENEW wchar_t[uiptrLen];
 		if ( !pcBuffer ) { return NULL; }	// Out of memory?
@@ -859,7 +1117,18 @@ namespace lsf {
 		else {
 			// To hold the path to the curent directory.
 			wchar_t szCurDirectory[LSF_MAX_PATH];
+#ifdef LSE_LINUX
+			// As on Windows, relative paths are relative to the working directory.
+			char szCwd[LSF_MAX_PATH];
+			if ( !::getcwd( szCwd, LSF_MAX_PATH - 1 ) ) {
+				LSEDELETE [] pcBuffer;
+				return NULL;
+			}
+			CStd::StrCat( szCwd, "/" );
+			CStd::Utf8ToUtfX( szCurDirectory, reinterpret_cast<const LSUTF8 *>(szCwd), LSF_MAX_PATH );
+#else
 			GetSelfDir( szCurDirectory );
+#endif	// #ifdef LSE_LINUX
 			
 			// Combine the current directory and the given path.
 			CStd::WStrCpy( pcBuffer, szCurDirectory );
@@ -974,7 +1243,7 @@ namespace lsf {
 			CStd::StrCpy( _pcRet, _pcPath );
 			return _pcRet;
 		}
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		if ( _pcPath[0] == '\\' || _pcPath[0] == '/' ) {
 			// Just copy the path over.
 			CStd::StrCpy( _pcRet, _pcPath );
@@ -1014,7 +1283,7 @@ namespace lsf {
 #ifdef LSE_WINDOWS
 		::PathRemoveExtensionW( _pwcPath );
 		return _pwcPath;
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		if ( !_pwcPath ) { return NULL; }
 		wchar_t * pwcEnd = _pwcPath;
 		// Go to the end.
@@ -1069,7 +1338,7 @@ namespace lsf {
 #ifdef LSE_WINDOWS
 		::PathStripPathW( _pwcPath );
 		return _pwcPath;
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		wchar_t * pwcEnd = _pwcPath;
 		// Find the last directory delimiter.
 		wchar_t * pwcDirDel = NULL;
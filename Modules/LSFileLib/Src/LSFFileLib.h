@@ -48,9 +48,35 @@ using namespace ::lstl;
 #define LSF_PATH_DELIMITER					"/"						/**< Path delimiter. */
 #define LSF_PATH_DELIMITER_CHAR				'/'						/**< Path delimiter in character form. */
 
+#elif defined( LSE_LINUX )	// Linux uses file descriptors directly so that reads can be positioned and hinted.
+#include <climits>
+#include <cstdio>
+
+#define LSF_MAX_PATH						PATH_MAX				/**< Max file path length. */
+#define LSF_PATH_DELIMITER					"/"						/**< Path delimiter. */
+#define LSF_PATH_DELIMITER_CHAR				'/'						/**< Path delimiter in character form. */
+
 #endif	// #if defined( LSE_WINDOWS )
 
 
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// TUNING
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#ifdef LSE_LINUX
+/**
+ * Reads of at least this many bytes bypass the page cache (O_DIRECT) for the block-aligned middle of the read, so that
+ *	streaming a huge file does not evict everything else from the cache.  Files already in the cache are read more slowly
+ *	this way, so keep this large.  0 disables direct reads.
+ */
+#ifndef LSF_DIRECT_READ_SIZE
+#define LSF_DIRECT_READ_SIZE				(64 * 1024 * 1024)
+#endif	// #ifndef LSF_DIRECT_READ_SIZE
+
+/** Alignment of the buffer, file offset, and length required by O_DIRECT reads. */
+#define LSF_DIRECT_READ_ALIGN				4096
+#endif	// #ifdef LSE_LINUX
+
+
 // TODO: Learn and add the headers for other systems.
 
 
@@ -65,7 +91,7 @@ namespace lsf {
 		LSF_OF_READ							= FILE_READ_DATA,
 		LSF_OF_WRITE						= FILE_WRITE_DATA,
 		LSF_OF_APPEND						= FILE_APPEND_DATA,
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		LSF_OF_READ							= (1 << 0),
 		LSF_OF_WRITE						= (1 << 1),
 		LSF_OF_APPEND						= (1 << 2),
@@ -113,6 +139,46 @@ namespace lsf {
 		LSF_S_END							= SEEK_END
 	};
 
+	/**
+	 * Structure to keep track of data for mapping of files.
+	 */
+	typedef struct LSF_FILE_MAP {
+		// Handle for the open file and later close.
+		int									iFile;
+
+		// Mapping mode.
+		uint32_t							ui32Mode;
+	} * LPLSF_FILE_MAP, * const LPCLSF_FILE_MAP;
+#elif defined( LSE_LINUX )
+	/**
+	 * An open file.  The position is tracked here rather than by the kernel so that reads and writes are single
+	 *	pread()/pwrite() calls and seeking never enters the kernel.
+	 */
+	typedef struct LSF_FILE_DESC {
+		// The file descriptor.
+		int									iFile;
+
+		// The file descriptor opened with O_DIRECT, -1 if not yet opened, or -2 if the file system refused it.
+		int									iDirectFile;
+
+		// The current position.
+		uint64_t							ui64Pos;
+
+		// The LSF_OPEN_FILE flags with which the file was opened.
+		uint32_t							ui32Mode;
+	} * LPLSF_FILE_DESC, * const LPCLSF_FILE_DESC;
+
+	typedef LSF_FILE_DESC *					LSF_FILE;
+
+	/**
+	 * Seek flags.
+	 */
+	enum LSF_SEEK {
+		LSF_S_BEGIN							= SEEK_SET,
+		LSF_S_CURRENT						= SEEK_CUR,
+		LSF_S_END							= SEEK_END
+	};
+
 	/**
 	 * Structure to keep track of data for mapping of files.
 	 */
@@ -42,6 +42,7 @@ extern void compressBlockETC2ExhaustivePerceptual(uint8 *img, uint8 *imgdec,int
 extern void compressBlockETC2FastPerceptual(uint8 *img, uint8 *imgdec,int width,int height,int startx,int starty, unsigned int &compressed1, unsigned int &compressed2);
 extern void compressBlockETC2Exhaustive(uint8 *img, uint8 *imgdec,int width,int height,int startx,int starty, unsigned int &compressed1, unsigned int &compressed2);
 extern void compressBlockETC2Fast(uint8 *img, uint8* alphaimg, uint8 *imgdec,int width,int height,int startx,int starty, unsigned int &compressed1, unsigned int &compressed2);
+extern void compressBlockDiffFlipFastPerceptual(uint8 *img, uint8 *imgdec,int width,int height,int startx,int starty, unsigned int &compressed1, unsigned int &compressed2);
 extern void compressBlockAlphaSlow(uint8* data, int ix, int iy, int width, int /*height*/, uint8* returnData);
 extern void compressBlockAlphaFast(uint8 * data, int ix, int iy, int width, int /*height*/, uint8* returnData);
 extern void compressBlockAlpha16(uint8* data, int ix, int iy, int width, int height, uint8* returnData);
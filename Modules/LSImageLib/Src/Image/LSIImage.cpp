@@ -22,6 +22,7 @@
 #include "../Png/LSIPng.h"
 #include "../Tga/LSITga.h"
 #include "../Qoi/LSIQoi.h"
+#include "../SimdConvert/LSISimdConvert.h"
 #include "Crc/LSSTDCrc.h"
 #include "FreeImage.h"
 #include "HighLevel/LSFFilesEx.h"
@@ -35,6 +36,39 @@
 
 namespace lsi {
 
+	// == Members.
+	/** The built-in loaders, sorted from highest to lowest priority.  Formats with signatures come first, then the formats that have
+	 *	none.  TGA is the last of the image formats, followed only by LSI, whose loader can mistake TGA files for its own. */
+	const CImage::LSI_LOADER CImage::m_lBuiltInLoaders[] = {
+		{ CImage::LoaderPng, { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A }, 8, 0, 100 },
+		{ CImage::LoaderDds, { 'D', 'D', 'S', ' ' }, 4, 0, 100 },
+		{ CImage::LoaderKtx1, { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, 0x0D, 0x0A, 0x1A, 0x0A }, 12, 0, 100 },
+		{ CImage::LoaderKtx2, { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, 0x0D, 0x0A, 0x1A, 0x0A }, 12, 0, 100 },
+		{ CImage::LoaderQoi, { 'q', 'o', 'i', 'f' }, 4, 0, 100 },
+		{ CImage::LoaderPBmp, { 'P', 'B', 'M', 'P' }, 4, 0, 100 },
+		{ CImage::LoaderBmp, { 'B', 'M' }, 2, 0, 100 },
+		{ CImage::LoaderFreeImage, { 0xFF, 0xD8, 0xFF }, 3, 0, 50 },												// JPEG.
+		{ CImage::LoaderFreeImage, { 'G', 'I', 'F', '8' }, 4, 0, 50 },											// GIF.
+		{ CImage::LoaderFreeImage, { 'I', 'I', 0x2A, 0x00 }, 4, 0, 50 },										// TIFF (little-endian).
+		{ CImage::LoaderFreeImage, { 'M', 'M', 0x00, 0x2A }, 4, 0, 50 },										// TIFF (big-endian).
+		{ CImage::LoaderFreeImage, { '8', 'B', 'P', 'S' }, 4, 0, 50 },											// PSD.
+		{ CImage::LoaderFreeImage, { 0x76, 0x2F, 0x31, 0x01 }, 4, 0, 50 },										// EXR.
+		{ CImage::LoaderFreeImage, { '#', '?', 'R', 'A', 'D', 'I', 'A', 'N', 'C', 'E' }, 10, 0, 50 },			// HDR.
+		{ CImage::LoaderFreeImage, { '#', '?', 'R', 'G', 'B', 'E' }, 6, 0, 50 },								// HDR.
+		{ CImage::LoaderFreeImage, { 'W', 'E', 'B', 'P' }, 4, 8, 50 },											// WebP.
+		{ CImage::LoaderFreeImage, { 0x00, 0x00, 0x00, 0x0C, 'j', 'P', ' ', ' ' }, 8, 0, 50 },					// JPEG-2000.
+		{ CImage::LoaderFreeImage, { 0xFF, 0x4F, 0xFF, 0x51 }, 4, 0, 50 },										// JPEG-2000 codestream.
+		{ CImage::LoaderFreeImageProbe, { 0 }, 0, 0, 20 },
+		{ CImage::LoaderTga, { 0 }, 0, 0, 10 },
+		{ CImage::LoaderLsi, { 0 }, 0, 0, 0 },
+	};
+
+	/** The registered loaders, sorted from highest to lowest priority. */
+	CImage::LSI_LOADER CImage::m_lLoaders[CImage::LSI_MAX_LOADERS];
+
+	/** Number of loaders in m_lLoaders. */
+	uint32_t CImage::m_ui32Loaders = 0;
+
 	// == Operators.
 	/**
 	 * Less-than comparison.
@@ -286,31 +320,26 @@ namespace lsi {
 	 */
 	LSBOOL LSE_CALL CImage::LoadFileFromMemory( const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes ) {
 		Reset();
-		
-		if ( CBmp::LoadBmp( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, m_tbBuffer ) ) { PostLoad(); return true; }
-		//if ( CGif::LoadGif( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, m_tbBuffer ) ) { PostLoad(); return true; }
-		if ( CTga::LoadTga( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, m_tbBuffer ) ) { PostLoad(); return true; }
-		bool bSrgb = false;
-		if ( CQoi::LoadQoi( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, bSrgb, m_tbBuffer ) ) {
-			SetColorSpace( bSrgb ? LSI_G_sRGB : LSI_G_LINEAR );
-			PostLoad();
-			return true;
-		}
-		//if ( CPng::LoadPng( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, m_tbBuffer ) ) { PostLoad(); return true; }
-		if ( CDds::LoadDds( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, m_tbBuffer, m_vMipMapBuffer ) ) { PostLoad(); return true; }
-		if ( LoadFreeImage( _pui8FileData, _ui32DataLen ) ) { PostLoad(); return true; }
 
-		if ( CKtx::LoadKtx1( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, 
-			m_kvKtx1.ktGlType, m_kvKtx1.kfGlFormat, m_kvKtx1.kifGlInternalFormat, m_kvKtx1.kbifGlInternalBaseFormat,
-			m_tbBuffer, m_vMipMapBuffer ) ) { PostLoad(); return true; }
-		if ( CKtx::LoadKtx2( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, 
-			m_kvKtx2.vkFormat,
-			m_tbBuffer, m_vMipMapBuffer ) ) { PostLoad(); return true; }
-
-		if ( _ppdPalettes ) {
-			if ( CPBmp::LoadPBmp( _pui8FileData, _ui32DataLen, m_ui32Width, m_ui32Height, m_pfFormat, (*_ppdPalettes), m_tbBuffer, m_vMipMapBuffer ) ) { PostLoad(); return true; }
+		// Loaders whose signatures match go first, so most files are identified without any failed parses.  If they all
+		//	fail, the loaders without signatures get a chance.
+		for ( uint32_t P = 0; P < 2; ++P ) {
+			// Merge the built-in and registered loaders by priority.  Built-in loaders go before registered loaders of the
+			//	same priority.
+			uint32_t B = 0, R = 0;
+			while ( B < LSE_ELEMENTS( m_lBuiltInLoaders ) || R < m_ui32Loaders ) {
+				const LSI_LOADER & lLoader = (R == m_ui32Loaders || (B < LSE_ELEMENTS( m_lBuiltInLoaders ) &&
+					m_lBuiltInLoaders[B].i32Priority >= m_lLoaders[R].i32Priority)) ?
+					m_lBuiltInLoaders[B++] : m_lLoaders[R++];
+				if ( P == 0 ? !MatchesMagic( lLoader, _pui8FileData, _ui32DataLen ) : lLoader.ui32MagicLen != 0 ) { continue; }
+				if ( lLoader.pfLoader( (*this), _pui8FileData, _ui32DataLen, _ppdPalettes ) ) {
+					PostLoad();
+					return true;
+				}
+				Reset();
+			}
 		}
-		return LoadLsi( _pui8FileData, _ui32DataLen );	// Calls PostLoad().
+		return false;
 	}
 
 	/**
@@ -329,6 +358,29 @@ namespace lsi {
 		return bRet;
 	}
 
+	/**
+	 * Adds a loader to the loaders LoadFileFromMemory() can dispatch to.  Loaders with the same priority are tried in the
+	 *	order in which they were added, after the built-in loaders.  Not thread-safe; loaders should be registered at
+	 *	start-up, before any images are loaded.
+	 *
+	 * \param _lLoader The loader to add.
+	 * \return Returns false if the signature is too long or LSI_MAX_LOADERS loaders have already been added.
+	 */
+	LSBOOL LSE_CALL CImage::RegisterLoader( const LSI_LOADER &_lLoader ) {
+		if ( !_lLoader.pfLoader || _lLoader.ui32MagicLen > LSI_MAX_MAGIC ) { return false; }
+		if ( m_ui32Loaders == LSI_MAX_LOADERS ) { return false; }
+
+		// Insert after every loader of the same or higher priority.
+		uint32_t ui32Index = m_ui32Loaders;
+		while ( ui32Index && m_lLoaders[ui32Index-1].i32Priority < _lLoader.i32Priority ) {
+			m_lLoaders[ui32Index] = m_lLoaders[ui32Index-1];
+			--ui32Index;
+		}
+		m_lLoaders[ui32Index] = _lLoader;
+		++m_ui32Loaders;
+		return true;
+	}
+
 	/**
 	 * Creates a blank image.
 	 *
@@ -749,6 +801,22 @@ namespace lsi {
 			}
 		}
 		if ( !m_ui32Height || !m_ui32Width ) { return; }
+
+		// Stream the conversion a band at a time when the source can be decoded in bands.
+		LSI_BAND_CODEC bcSrc;
+		if ( _pfFormat < LSI_PF_TOTAL && GetBandCodec( bcSrc ) ) {
+			LSI_GAMMA gSrcGamma = m_gColorSpace;
+			if ( bcSrc.pfDecode ) {
+				if ( bcSrc.pkifdData ) { bcSrc.pvParm = _pvParm; }
+				// These conversions to RGBA32F always give a linear result.
+				gSrcGamma = LSI_G_LINEAR;
+				_iDest.SetColorSpace( gSrcGamma );
+			}
+			LSI_BAND_CODEC bcDst = { _pfFormat, NULL, NULL, NULL, NULL, 0, 1 };
+			if ( !ConvertMipMapsInBands( bcSrc, _iDest, bcDst, gSrcGamma == gTarget ? LSI_G_NONE : gTarget ) ) { throw LSSTD_E_OUTOFMEMORY; }
+			return;
+		}
+
 		uint32_t ui32H = m_ui32Height;
 		uint32_t ui32W = m_ui32Width;
 		for ( uint32_t I = 0; I < TotalMipLevels(); ++I ) {
@@ -1564,99 +1632,97 @@ namespace lsi {
 			doOptions.fAlphaThresh = 0.0f;
 		}
 
-		// First convert this image to floating-point format.
-		CImage iTemp;
+		// Transcode a block at a time when possible.  sRGB images take the floating-point path, which encodes the
+		//	sRGB curve.
+		LSI_PIXEL_FORMAT pfSrc = TranscoderFormat();
+		if ( !IsSRgb() && CTranscoder::CanTranscode( pfSrc, _pfFormat ) ) {
+			CTranscoder::LSI_TRANSCODE_OPTIONS toOptions = {
+				CTranscoder::LSI_TQ_NORMAL,
+				doOptions.fAlphaThresh,
+				doOptions.fRedWeight,
+				doOptions.fGreenWeight,
+				doOptions.fBlueWeight,
+			};
+			if ( !_iDst.CreateBlank( _pfFormat, GetWidth(), GetHeight(), TotalMipLevels() ) ) { return false; }
+			return TranscodeMipMaps( pfSrc, _pfFormat, _iDst, toOptions );
+		}
+
+		bool bSrgb = IsSRgb() != 0;
+		CKtx::PfFromRgba32F pfEncode = NULL;
+		switch ( _pfFormat ) {
+			case LSI_PF_DXT1 : {
+				pfEncode = bSrgb ? &CDds::Dxt1FromRgba32F<0, true> : &CDds::Dxt1FromRgba32F<0, false>;
+				break;
+			}
+			case LSI_PF_DXT2 : {
+				pfEncode = bSrgb ? &CDds::Dxt2FromRgba32F<true> : &CDds::Dxt2FromRgba32F<false>;
+				break;
+			}
+			case LSI_PF_DXT3 : {
+				pfEncode = bSrgb ? &CDds::Dxt3FromRgba32F<true> : &CDds::Dxt3FromRgba32F<false>;
+				break;
+			}
+			case LSI_PF_DXT4 : {
+				pfEncode = bSrgb ? &CDds::Dxt4FromRgba32F<true> : &CDds::Dxt4FromRgba32F<false>;
+				break;
+			}
+			case LSI_PF_DXT5 : {
+				pfEncode = bSrgb ? &CDds::Dxt5FromRgba32F<true> : &CDds::Dxt5FromRgba32F<false>;
+				break;
+			}
+			case LSI_PF_BC4 : {
+				pfEncode = bSrgb ? &CDds::Bc4uFromRgba32F<true, false> : &CDds::Bc4uFromRgba32F<false, false>;
+				break;
+			}
+			case LSI_PF_BC4S : {
+				pfEncode = bSrgb ? &CDds::Bc4sFromRgba32F<true, false> : &CDds::Bc4sFromRgba32F<false, false>;
+				break;
+			}
+			case LSI_PF_BC5 : {
+				pfEncode = bSrgb ? &CDds::Bc5uFromRgba32F<true, false> : &CDds::Bc5uFromRgba32F<false, false>;
+				break;
+			}
+			case LSI_PF_BC5S : {
+				pfEncode = bSrgb ? &CDds::Bc5sFromRgba32F<true, false> : &CDds::Bc5sFromRgba32F<false, false>;
+				break;
+			}
+			case LSI_PF_BC6 : {}
+			case LSI_PF_BC6S : {
+				pfEncode = bSrgb ? &CDds::Bc6hFromRgba32F<true> : &CDds::Bc6hFromRgba32F<false>;
+				break;
+			}
+			case LSI_PF_BC7 : {
+				pfEncode = bSrgb ? &CDds::Bc7uFromRgba32F<true> : &CDds::Bc7uFromRgba32F<false>;
+				break;
+			}
+			case LSI_PF_BC7_SRGB : {
+				pfEncode = &CDds::Bc7uFromRgba32F<true>;
+				break;
+			}
+			default : { return false; }
+		}
+
 		try {
+			if ( !_iDst.CreateBlank( _pfFormat, GetWidth(), GetHeight(), TotalMipLevels() ) ) { return false; }
+
+			// Decode, convert, and encode a band at a time when possible.
+			LSI_BAND_CODEC bcSrc;
+			if ( GetBandCodec( bcSrc ) ) {
+				LSI_BAND_CODEC bcDst = { LSI_PF_R32G32B32A32F, NULL, pfEncode, &doOptions, NULL, CDds::DxtBlockSize( _pfFormat ), 4 };
+				LSI_GAMMA gGamma = (bcSrc.pfDecode && m_gColorSpace != LSI_G_LINEAR) ? m_gColorSpace : LSI_G_NONE;
+				return ConvertMipMapsInBands( bcSrc, _iDst, bcDst, gGamma );
+			}
+
+			// First convert this image to floating-point format.
+			CImage iTemp;
 			ConvertToFormat( LSI_PF_R32G32B32A32F, iTemp );
 
-			// We will gather every 4-by-4 block into a linear array.
-			//LSI_BLOCK bColors[4][4];
-			if ( !_iDst.CreateBlank( _pfFormat, GetWidth(), GetHeight(), TotalMipLevels() ) ) { return false; }
 			uint32_t uiW = GetWidth();
 			uint32_t uiH = GetHeight();
 			for ( uint32_t I = 0; I < TotalMipLevels(); ++I ) {
 				uiW = CStd::Max<uint32_t>( uiW, 1UL );
 				uiH = CStd::Max<uint32_t>( uiH, 1UL );
-
-				switch ( _pfFormat ) {
-					case LSI_PF_DXT1 : {
-						IsSRgb() ?
-							CDds::Dxt1FromRgba32F<0, true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Dxt1FromRgba32F<0, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_DXT2 : {
-						IsSRgb() ?
-							CDds::Dxt2FromRgba32F<true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Dxt2FromRgba32F<false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_DXT3 : {
-						IsSRgb() ?
-							CDds::Dxt3FromRgba32F<true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Dxt3FromRgba32F<false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_DXT4 : {
-						IsSRgb() ?
-							CDds::Dxt4FromRgba32F<true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Dxt4FromRgba32F<false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_DXT5 : {
-						IsSRgb() ?
-							CDds::Dxt5FromRgba32F<true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Dxt5FromRgba32F<false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_BC4 : {
-						IsSRgb() ?
-							CDds::Bc4uFromRgba32F<true, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Bc4uFromRgba32F<false, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_BC4S : {
-						IsSRgb() ?
-							CDds::Bc4sFromRgba32F<true, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Bc4sFromRgba32F<false, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_BC5 : {
-						IsSRgb() ?
-							CDds::Bc5uFromRgba32F<true, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Bc5uFromRgba32F<false, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_BC5S : {
-						IsSRgb() ?
-							CDds::Bc5sFromRgba32F<true, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Bc5sFromRgba32F<false, false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_BC6 : {
-						IsSRgb() ?
-							CDds::Bc6hFromRgba32F<true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Bc6hFromRgba32F<false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_BC6S : {
-						IsSRgb() ?
-							CDds::Bc6hFromRgba32F<true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Bc6hFromRgba32F<false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_BC7 : {
-						IsSRgb() ?
-							CDds::Bc7uFromRgba32F<true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions ) :
-							CDds::Bc7uFromRgba32F<false>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						break;
-					}
-					case LSI_PF_BC7_SRGB : {
-						CDds::Bc7uFromRgba32F<true>( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
-						iTemp.SetColorSpace( LSI_G_sRGB );
-						break;
-					}
-				}
+				pfEncode( &iTemp.GetMipMapBuffers( I )[0], const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( I )[0]), uiW, uiH, 1, &doOptions );
 
 				uiW >>= 1;
 				uiH >>= 1;
@@ -1872,9 +1938,32 @@ namespace lsi {
 		if ( !pkifdData->pfFromRgba32F ) { return false; }
 
 		if ( !_iDst.CreateBlankKtx1( _kifFormat, GetWidth(), GetHeight(), TotalMipLevels() ) ) { return false; }
-		// First convert this image to floating-point format.
-		CImage iTemp;
+
+		// Transcode ETC2 a block at a time when possible.  ETC1 keeps the ISPC encoder and sRGB keeps the
+		//	floating-point path, which encodes the sRGB curve.
+		LSI_PIXEL_FORMAT pfSrc = TranscoderFormat();
+		LSI_PIXEL_FORMAT pfDst = EtcFormat( _kifFormat );
+		if ( pfDst != LSI_PF_ETC1 && !IsSRgb() && !pkifdData->bSrgb && CTranscoder::CanTranscode( pfSrc, pfDst ) ) {
+			CTranscoder::LSI_TRANSCODE_OPTIONS toOptions = {
+				CTranscoder::LSI_TQ_NORMAL,
+				0.0f,
+				LSI_R_WEIGHT,
+				LSI_G_WEIGHT,
+				LSI_B_WEIGHT,
+			};
+			return TranscodeMipMaps( pfSrc, pfDst, _iDst, toOptions );
+		}
+
 		try {
+			// Decode, convert, and encode a band at a time when possible.
+			LSI_BAND_CODEC bcSrc, bcDst;
+			if ( GetBandCodec( bcSrc ) && GetKtx1BandCodec( pkifdData, _pvParm, bcDst ) ) {
+				LSI_GAMMA gGamma = (bcSrc.pfDecode && m_gColorSpace != LSI_G_LINEAR) ? m_gColorSpace : LSI_G_NONE;
+				return ConvertMipMapsInBands( bcSrc, _iDst, bcDst, gGamma );
+			}
+
+			// First convert this image to floating-point format.
+			CImage iTemp;
 			ConvertToFormat( LSI_PF_R32G32B32A32F, iTemp );
 			iTemp.SetColorSpace( pkifdData->bSrgb ? LSI_G_sRGB : LSI_G_LINEAR );
 			// Convert each mipmap from RGBA32F to the destiation format.
@@ -2783,14 +2872,15 @@ namespace lsi {
 	 *
 	 * \param _pui8FileData The in-memory image of the file.
 	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _bSkipTga If true, files FreeImage identifies as TGA are not loaded, leaving them to CTga.
 	 * \return Returns true if the file was successfully loaded.  False indicates an invalid file or lack of RAM.
 	 */
-	LSBOOL LSE_CALL CImage::LoadFreeImage( const uint8_t * _pui8FileData, uint32_t _ui32DataLen ) {
+	LSBOOL LSE_CALL CImage::LoadFreeImage( const uint8_t * _pui8FileData, uint32_t _ui32DataLen, LSBOOL _bSkipTga ) {
 		FIMEMORY * pmMem = ::FreeImage_OpenMemory( const_cast<uint8_t *>(_pui8FileData), _ui32DataLen );
 		if ( !pmMem ) { return false; }
 
 		FREE_IMAGE_FORMAT fifFormat = ::FreeImage_GetFileTypeFromMemory( pmMem, 0 );
-		if ( FIF_UNKNOWN == fifFormat ) {
+		if ( FIF_UNKNOWN == fifFormat || (_bSkipTga && FIF_TARGA == fifFormat) ) {
 			::FreeImage_CloseMemory( pmMem );
 			return false;
 		}
@@ -2915,14 +3005,13 @@ namespace lsi {
 						break;
 					}
 					case 32 : {
-						LSI_CREATE( LSI_PF_R8G8B8A8 );
+						LSBOOL bCreated = CreateBlank( LSI_PF_R8G8B8A8, ui32Width, ui32Height );
 						if ( bCreated ) {
+							// Whole scanlines only need their bytes rearranged.
 							for ( uint32_t Y = 0; Y < ui32Height; ++Y ) {
-								const RGBQUAD * prgbqData = reinterpret_cast<RGBQUAD *>(::FreeImage_GetScanLine( pbData, Y ));
-								for ( uint32_t X = 0; X < ui32Width; ++X ) {
-									LSI_MAKE_COLOR( prgbqData[X].rgbRed, prgbqData[X].rgbGreen,
-										prgbqData[X].rgbBlue, prgbqData[X].rgbReserved );
-								}
+								CSimdConvert::SwizzleToRgba8( ::FreeImage_GetScanLine( pbData, Y ),
+									FI_RGBA_RED, FI_RGBA_GREEN, FI_RGBA_BLUE, FI_RGBA_ALPHA,
+									&m_tbBuffer[Y*m_ui32RowWidth], ui32Width );
 							}
 							bRes = true;
 						}
@@ -3084,6 +3173,448 @@ namespace lsi {
 		return bRes;
 	}
 
+	/**
+	 * Gets the format of the image as understood by CTranscoder.  KTX 1 images in an ETC format map to the matching
+	 *	LSI_PF_ETC* format.
+	 *
+	 * \return Returns the CTranscoder format of the image or LSI_PF_ANY if the image cannot be transcoded directly.
+	 */
+	LSI_PIXEL_FORMAT LSE_CALL CImage::TranscoderFormat() const {
+		switch ( GetFormat() ) {
+			case LSI_PF_R8G8B8A8 : {}
+			case LSI_PF_DXT1 : {}
+			case LSI_PF_DXT3 : {}
+			case LSI_PF_DXT5 : {}
+			case LSI_PF_BC4 : {}
+			case LSI_PF_BC5 : { return GetFormat(); }
+			case LSI_PF_KTX1 : { return EtcFormat( m_kvKtx1.kifGlInternalFormat ); }
+			default : { return LSI_PF_ANY; }
+		}
+	}
+
+	/**
+	 * Transcodes every mipmap of the image directly from _pfSrc to _pfDst via CTranscoder, without going through
+	 *	RGBA32F.  The destination image must already have been created in the destination format.
+	 *
+	 * \param _pfSrc The CTranscoder format of this image.
+	 * \param _pfDst The CTranscoder format of the destination image.
+	 * \param _iDst The destination image.
+	 * \param _toOptions The transcoding options.
+	 * \return Returns true if there are no resource problems.
+	 */
+	LSBOOL LSE_CALL CImage::TranscodeMipMaps( LSI_PIXEL_FORMAT _pfSrc, LSI_PIXEL_FORMAT _pfDst, CImage &_iDst,
+		const CTranscoder::LSI_TRANSCODE_OPTIONS &_toOptions ) const {
+		uint32_t ui32W = GetWidth();
+		uint32_t ui32H = GetHeight();
+		for ( uint32_t I = 0; I < TotalMipLevels(); ++I ) {
+			const CImageLib::CTexelBuffer & tbSrc = GetMipMapBuffers( I );
+			CImageLib::CTexelBuffer & tbDst = const_cast<CImageLib::CTexelBuffer &>(_iDst.GetMipMapBuffers( I ));
+			if ( tbSrc.Length() < CTranscoder::GetSize( _pfSrc, ui32W, ui32H ) ||
+				tbDst.Length() < CTranscoder::GetSize( _pfDst, ui32W, ui32H ) ) { return false; }
+			if ( !CTranscoder::Transcode( &tbSrc[0], _pfSrc, &tbDst[0], _pfDst, ui32W, ui32H, 1, &_toOptions ) ) { return false; }
+			ui32W = CStd::Max<uint32_t>( ui32W >> 1, 1 );
+			ui32H = CStd::Max<uint32_t>( ui32H >> 1, 1 );
+		}
+		return true;
+	}
+
+	/**
+	 * Gets the CTranscoder format matching a KTX 1 internal format.
+	 *
+	 * \param _kifFormat The KTX 1 internal format.
+	 * \return Returns the matching LSI_PF_ETC* format or LSI_PF_ANY if the internal format is not an ETC format.
+	 */
+	LSI_PIXEL_FORMAT LSE_CALL CImage::EtcFormat( LSI_KTX_INTERNAL_FORMAT _kifFormat ) {
+		switch ( _kifFormat ) {
+			case LSI_KIF_GL_ETC1_RGB8_OES : { return LSI_PF_ETC1; }
+			case LSI_KIF_GL_COMPRESSED_RGB8_ETC2 : { return LSI_PF_ETC2; }
+			case LSI_KIF_GL_COMPRESSED_SRGB8_ETC2 : { return LSI_PF_ETC2_SRGB; }
+			case LSI_KIF_GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 : { return LSI_PF_ETC2_PT_ALPHA1; }
+			case LSI_KIF_GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 : { return LSI_PF_ETC2_PT_ALPHA1_SRGB; }
+			case LSI_KIF_GL_COMPRESSED_RGBA8_ETC2_EAC : { return LSI_PF_ETC2_EAC; }
+			case LSI_KIF_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : { return LSI_PF_ETC2_EAC_SRGB; }
+			default : { return LSI_PF_ANY; }
+		}
+	}
+
+	/**
+	 * Gets the codec for reading this image a band of rows at a time.  Compressed images are decoded to RGBA32F.
+	 *
+	 * \param _bcCodec The returned codec.
+	 * \return Returns false if the image cannot be read a band at a time, in which case the whole image must be decoded at once.
+	 */
+	LSBOOL LSE_CALL CImage::GetBandCodec( LSI_BAND_CODEC &_bcCodec ) const {
+		_bcCodec.pfFormat = LSI_PF_R32G32B32A32F;
+		_bcCodec.pfDecode = NULL;
+		_bcCodec.pfEncode = NULL;
+		_bcCodec.pvParm = NULL;
+		_bcCodec.pkifdData = NULL;
+		_bcCodec.ui32BlockSize = 0;
+		_bcCodec.ui32BlockHeight = 1;
+		if ( m_pfFormat < LSI_PF_TOTAL ) {
+			_bcCodec.pfFormat = m_pfFormat;
+			return true;
+		}
+		bool bSrgb = IsSRgb() != 0;
+		switch ( m_pfFormat ) {
+			case LSI_PF_DXT1 : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Dxt1ToRgba32F<true> : &CDds::Dxt1ToRgba32F<false>;
+				break;
+			}
+			case LSI_PF_DXT3 : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Dxt3ToRgba32F<true> : &CDds::Dxt3ToRgba32F<false>;
+				break;
+			}
+			case LSI_PF_DXT5 : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Dxt5ToRgba32F<true> : &CDds::Dxt5ToRgba32F<false>;
+				break;
+			}
+			case LSI_PF_BC4 : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Bc4uToRgba32F<true, false> : &CDds::Bc4uToRgba32F<false, false>;
+				break;
+			}
+			case LSI_PF_BC4S : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Bc4sToRgba32F<true, false> : &CDds::Bc4sToRgba32F<false, false>;
+				break;
+			}
+			case LSI_PF_BC5 : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Bc5uToRgba32F<true, false> : &CDds::Bc5uToRgba32F<false, false>;
+				break;
+			}
+			case LSI_PF_BC5S : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Bc5sToRgba32F<true, false> : &CDds::Bc5sToRgba32F<false, false>;
+				break;
+			}
+			case LSI_PF_BC6U : {}
+			case LSI_PF_BC6S : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Bc6hToRgba32F<true> : &CDds::Bc6hToRgba32F<false>;
+				break;
+			}
+			case LSI_PF_BC7U : {
+				_bcCodec.pfDecode = bSrgb ? &CDds::Bc7uToRgba32F<true> : &CDds::Bc7uToRgba32F<false>;
+				break;
+			}
+			case LSI_PF_BC7_SRGB : {
+				_bcCodec.pfDecode = &CDds::Bc7uToRgba32F<true>;
+				break;
+			}
+			case LSI_PF_KTX1 : {
+				const CKtx::LSI_KTX_INTERNAL_FORMAT_DATA * pkifdData = CKtx::FindInternalFormatData( m_kvKtx1.kifGlInternalFormat );
+				if ( !pkifdData || !pkifdData->pfToRgba32F ) { return false; }
+				return GetKtx1BandCodec( pkifdData, NULL, _bcCodec );
+			}
+			default : {
+				// DXT2 and DXT4 are only decoded a whole image at a time.
+				return false;
+			}
+		}
+		_bcCodec.ui32BlockSize = CDds::DxtBlockSize( m_pfFormat );
+		_bcCodec.ui32BlockHeight = 4;
+		return true;
+	}
+
+	/**
+	 * Gets the codec for reading or writing a band of rows in a KTX 1 format.
+	 *
+	 * \param _pkifdData The KTX 1 format.
+	 * \param _pvParm Parameters to pass to the decoder or encoder.
+	 * \param _bcCodec The returned codec.
+	 * \return Returns false if the format cannot be read or written a band at a time.
+	 */
+	LSBOOL LSE_CALL CImage::GetKtx1BandCodec( const CKtx::LSI_KTX_INTERNAL_FORMAT_DATA * _pkifdData, void * _pvParm, LSI_BAND_CODEC &_bcCodec ) {
+		// Palettes are shared by the whole image and PVRTC blocks depend on their neighbors.
+		if ( _pkifdData->bPalette || _pkifdData->ui32MinBlocksX != 1 || _pkifdData->ui32MinBlocksY != 1 ||
+			_pkifdData->ui32BlockDepth != 1 ) { return false; }
+		_bcCodec.pfFormat = LSI_PF_R32G32B32A32F;
+		_bcCodec.pfDecode = _pkifdData->pfToRgba32F;
+		_bcCodec.pfEncode = _pkifdData->pfFromRgba32F;
+		_bcCodec.pvParm = _pvParm;
+		_bcCodec.pkifdData = _pkifdData;
+		_bcCodec.ui32BlockSize = 0;
+		_bcCodec.ui32BlockHeight = CStd::Max<uint32_t>( _pkifdData->ui32BlockHeight, 1 );
+		return true;
+	}
+
+	/**
+	 * Gets the offset of a row of texels from the start of a mipmap.
+	 *
+	 * \param _bcCodec The format of the mipmap.
+	 * \param _ui32Width Width of the mipmap.
+	 * \param _ui32Row The row, which must be the first row of a block.
+	 * \return Returns the offset, in bytes, of the row.
+	 */
+	uint32_t LSE_CALL CImage::BandOffset( const LSI_BAND_CODEC &_bcCodec, uint32_t _ui32Width, uint32_t _ui32Row ) {
+		if ( !_ui32Row ) { return 0; }
+		if ( _bcCodec.pkifdData ) {
+			return CKtx::GetTextureSize( _ui32Width, _ui32Row, 1, _bcCodec.pkifdData );
+		}
+		if ( _bcCodec.ui32BlockSize ) {
+			return CDds::GetCompressedSize( _ui32Width, _ui32Row, _bcCodec.ui32BlockSize );
+		}
+		return CImageLib::GetRowSize( _bcCodec.pfFormat, _ui32Width ) * _ui32Row;
+	}
+
+	/**
+	 * Converts every mipmap of this image to the format of another image a band of rows at a time.  Each band is
+	 *	decoded, converted, and encoded before moving on, and bands are converted in parallel, so the only extra
+	 *	memory used is a pair of band-sized scratch buffers per thread.
+	 *
+	 * \param _bcSrc How to read this image.
+	 * \param _iDst The destination image, which must already have been created.
+	 * \param _bcDst How to write the destination image.
+	 * \param _gGamma If not LSI_G_NONE, an sRGB <-> Linear conversion is performed.
+	 * \return Returns false if there are resource problems.
+	 */
+	LSBOOL LSE_CALL CImage::ConvertMipMapsInBands( const LSI_BAND_CODEC &_bcSrc, CImage &_iDst, const LSI_BAND_CODEC &_bcDst,
+		LSI_GAMMA _gGamma ) const {
+		// The KTX 1 codecs keep state in globals and run their own threads, so they are given one large band at a time
+		//	on this thread instead.
+		LSBOOL bKtx = _bcSrc.pkifdData || _bcDst.pkifdData;
+		uint32_t ui32BandTexels = bKtx ? LSI_CONVERT_KTX_BAND_TEXELS : LSI_CONVERT_BAND_TEXELS;
+
+		// Bands must start on a row of blocks in both formats.
+		uint32_t ui32Align = _bcSrc.ui32BlockHeight;
+		while ( ui32Align % _bcDst.ui32BlockHeight ) { ui32Align += _bcSrc.ui32BlockHeight; }
+
+		LSI_CONVERT_JOB_DATA cjdData;
+		cjdData.cbdBand.pbcSrc = &_bcSrc;
+		cjdData.cbdBand.pbcDst = &_bcDst;
+		cjdData.cbdBand.gGamma = _gGamma;
+		CAtomic::AtomicStore( cjdData.aFailed, 0 );
+		uint32_t ui32H = m_ui32Height;
+		uint32_t ui32W = m_ui32Width;
+		for ( uint32_t M = 0; M < TotalMipLevels(); ++M ) {
+			cjdData.pui8Src = &GetMipMapBuffers( M )[0];
+			cjdData.pui8Dst = const_cast<uint8_t *>(&_iDst.GetMipMapBuffers( M )[0]);
+			cjdData.cbdBand.ui32Width = ui32W;
+			cjdData.ui32Height = ui32H;
+			cjdData.ui32Rows = CStd::Max<uint32_t>( ui32BandTexels / ui32W, 1 );
+			cjdData.ui32Rows = (cjdData.ui32Rows + ui32Align - 1) / ui32Align * ui32Align;
+			uint32_t ui32Bands = (ui32H + cjdData.ui32Rows - 1) / cjdData.ui32Rows;
+			if ( bKtx ) {
+				ConvertRange( 0, ui32Bands, &cjdData );
+			}
+			else {
+				CJobSystem::ParallelFor( ui32Bands, ConvertRange, &cjdData );
+			}
+			if ( CAtomic::AtomicLoad( cjdData.aFailed ) ) { return false; }
+
+			ui32H = CStd::Max<uint32_t>( ui32H >> 1, 1 );
+			ui32W = CStd::Max<uint32_t>( ui32W >> 1, 1 );
+		}
+		return true;
+	}
+
+	/**
+	 * Converts a single band of rows.
+	 *
+	 * \param _cbdData The band to convert.
+	 * \return Returns false if there are resource problems.
+	 */
+	LSBOOL LSE_CALL CImage::ConvertBand( const LSI_CONVERT_BAND_DATA &_cbdData ) {
+		const uint8_t * pui8Src = _cbdData.pui8Src;
+		LSI_PIXEL_FORMAT pfSrcFormat = _cbdData.pbcSrc->pfFormat;
+		uint32_t ui32Total = _cbdData.ui32Width * _cbdData.ui32Rows;
+		if ( _cbdData.pbcSrc->pfDecode ) {
+			CImageLib::CTexelBuffer & tbTmp = _cbdData.ptbScratch[0];
+			if ( !tbTmp.Resize( CImageLib::GetBufferSizeWithPadding( LSI_PF_R32G32B32A32F, _cbdData.ui32Width, _cbdData.ui32Rows ) ) ) { return false; }
+			if ( !_cbdData.pbcSrc->pfDecode( pui8Src, &tbTmp[0], _cbdData.ui32Width, _cbdData.ui32Rows, 1, _cbdData.pbcSrc->pvParm ) ) { return false; }
+			pui8Src = &tbTmp[0];
+			pfSrcFormat = LSI_PF_R32G32B32A32F;
+		}
+
+		if ( !_cbdData.pbcDst->pfEncode ) {
+			ConvertTexelsExact( pfSrcFormat, pui8Src, _cbdData.pbcDst->pfFormat, _cbdData.pui8Dst, ui32Total, _cbdData.gGamma );
+			return true;
+		}
+		if ( pfSrcFormat != LSI_PF_R32G32B32A32F || _cbdData.gGamma != LSI_G_NONE ) {
+			CImageLib::CTexelBuffer & tbTmp = _cbdData.ptbScratch[1];
+			if ( !tbTmp.Resize( CImageLib::GetBufferSizeWithPadding( LSI_PF_R32G32B32A32F, _cbdData.ui32Width, _cbdData.ui32Rows ) ) ) { return false; }
+			CImageLib::BatchAnyTexelToAnytexel( pfSrcFormat, pui8Src, LSI_PF_R32G32B32A32F, &tbTmp[0], ui32Total, _cbdData.gGamma );
+			pui8Src = &tbTmp[0];
+		}
+		return _cbdData.pbcDst->pfEncode( pui8Src, _cbdData.pui8Dst, _cbdData.ui32Width, _cbdData.ui32Rows, 1, _cbdData.pbcDst->pvParm );
+	}
+
+	/**
+	 * Converts texels between uncompressed formats without writing past the end of the destination, which
+	 *	CImageLib::BatchAnyTexelToAnytexel() otherwise does by up to 8 bytes.
+	 *
+	 * \param _pfSrcFormat The source texel format.
+	 * \param _pvSrcBuffer The source buffer.  Must be over-allocated by 8 bytes.
+	 * \param _pfDstFormat The destination texel format.
+	 * \param _pvDstBuffer The destination buffer.
+	 * \param _ui32Total The total number of texels to convert.
+	 * \param _gGamma If _gGamma is not LSI_G_NONE, then an sRGB <-> Linear conversion is performed.
+	 */
+	void LSE_CALL CImage::ConvertTexelsExact( LSI_PIXEL_FORMAT _pfSrcFormat, const void * _pvSrcBuffer,
+		LSI_PIXEL_FORMAT _pfDstFormat, void * _pvDstBuffer, uint32_t _ui32Total, LSI_GAMMA _gGamma ) {
+		// The last texels that could spill over the end go through a local buffer.
+		uint32_t ui32SrcSize = CImageLib::GetFormatSize( _pfSrcFormat );
+		uint32_t ui32DstSize = CImageLib::GetFormatSize( _pfDstFormat );
+		uint32_t ui32Tail = CStd::Min<uint32_t>( (8 + ui32DstSize - 1) / ui32DstSize, _ui32Total );
+		uint32_t ui32Head = _ui32Total - ui32Tail;
+		if ( ui32Head ) {
+			CImageLib::BatchAnyTexelToAnytexel( _pfSrcFormat, _pvSrcBuffer, _pfDstFormat, _pvDstBuffer, ui32Head, _gGamma );
+		}
+		uint64_t ui64Tail[8];
+		CImageLib::BatchAnyTexelToAnytexel( _pfSrcFormat, static_cast<const uint8_t *>(_pvSrcBuffer) + ui32Head * ui32SrcSize,
+			_pfDstFormat, ui64Tail, ui32Tail, _gGamma );
+		CStd::MemCpy( static_cast<uint8_t *>(_pvDstBuffer) + ui32Head * ui32DstSize, ui64Tail, ui32Tail * ui32DstSize );
+	}
+
+	/**
+	 * Loads a BMP file.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderBmp( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return CBmp::LoadBmp( _pui8FileData, _ui32DataLen, _iImage.m_ui32Width, _iImage.m_ui32Height, _iImage.m_pfFormat, _iImage.m_tbBuffer );
+	}
+
+	/**
+	 * Loads a TGA file.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderTga( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return CTga::LoadTga( _pui8FileData, _ui32DataLen, _iImage.m_ui32Width, _iImage.m_ui32Height, _iImage.m_pfFormat, _iImage.m_tbBuffer );
+	}
+
+	/**
+	 * Loads a QOI file and sets the color space it specifies.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderQoi( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		bool bSrgb = false;
+		if ( !CQoi::LoadQoi( _pui8FileData, _ui32DataLen, _iImage.m_ui32Width, _iImage.m_ui32Height, _iImage.m_pfFormat, bSrgb, _iImage.m_tbBuffer ) ) { return false; }
+		_iImage.SetColorSpace( bSrgb ? LSI_G_sRGB : LSI_G_LINEAR );
+		return true;
+	}
+
+	/**
+	 * Loads a PNG file.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderPng( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return CPng::LoadPng( _pui8FileData, _ui32DataLen, _iImage.m_ui32Width, _iImage.m_ui32Height, _iImage.m_pfFormat, _iImage.m_tbBuffer );
+	}
+
+	/**
+	 * Loads a DDS file.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderDds( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return CDds::LoadDds( _pui8FileData, _ui32DataLen, _iImage.m_ui32Width, _iImage.m_ui32Height, _iImage.m_pfFormat, _iImage.m_tbBuffer, _iImage.m_vMipMapBuffer );
+	}
+
+	/**
+	 * Loads a KTX 1 file.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderKtx1( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return CKtx::LoadKtx1( _pui8FileData, _ui32DataLen, _iImage.m_ui32Width, _iImage.m_ui32Height, _iImage.m_pfFormat,
+			_iImage.m_kvKtx1.ktGlType, _iImage.m_kvKtx1.kfGlFormat, _iImage.m_kvKtx1.kifGlInternalFormat, _iImage.m_kvKtx1.kbifGlInternalBaseFormat,
+			_iImage.m_tbBuffer, _iImage.m_vMipMapBuffer );
+	}
+
+	/**
+	 * Loads a KTX 2 file.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderKtx2( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return CKtx::LoadKtx2( _pui8FileData, _ui32DataLen, _iImage.m_ui32Width, _iImage.m_ui32Height, _iImage.m_pfFormat,
+			_iImage.m_kvKtx2.vkFormat,
+			_iImage.m_tbBuffer, _iImage.m_vMipMapBuffer );
+	}
+
+	/**
+	 * Loads a PBMP file.  Fails if no palette database is given.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderPBmp( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes ) {
+		if ( !_ppdPalettes ) { return false; }
+		return CPBmp::LoadPBmp( _pui8FileData, _ui32DataLen, _iImage.m_ui32Width, _iImage.m_ui32Height, _iImage.m_pfFormat, (*_ppdPalettes),
+			_iImage.m_tbBuffer, _iImage.m_vMipMapBuffer );
+	}
+
+	/**
+	 * Loads an LSI file.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderLsi( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return _iImage.LoadLsi( _pui8FileData, _ui32DataLen );
+	}
+
+	/**
+	 * Loads a file via FreeImage.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderFreeImage( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return _iImage.LoadFreeImage( _pui8FileData, _ui32DataLen );
+	}
+
+	/**
+	 * Loads any file FreeImage recognizes other than TGA files, which are left to CTga.
+	 *
+	 * \param _iImage The image to fill.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \param _ppdPalettes An optional palette database.
+	 * \return Returns true if the file was successfully loaded.
+	 */
+	LSBOOL LSE_CALL CImage::LoaderFreeImageProbe( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * /*_ppdPalettes*/ ) {
+		return _iImage.LoadFreeImage( _pui8FileData, _ui32DataLen, true );
+	}
+
 	/**
 	 * A thread function for resampling from a source image to a destination texel buffer.
 	 *
@@ -3222,4 +3753,30 @@ namespace lsi {
 		return 0;
 	}
 
+	/**
+	 * Job function for converting a range of bands of a mipmap.
+	 *
+	 * \param _ui32Begin Index of the first band to convert.
+	 * \param _ui32End Index of the band after the last to convert.
+	 * \param _pvParm Pointer to an LSI_CONVERT_JOB_DATA structure.
+	 */
+	void LSE_CALL CImage::ConvertRange( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm ) {
+		LPLSI_CONVERT_JOB_DATA lpcjdData = static_cast<LPLSI_CONVERT_JOB_DATA>(_pvParm);
+		// The scratch buffers are reused by every band in the range.
+		CImageLib::CTexelBuffer tbScratch[2];
+		LSI_CONVERT_BAND_DATA cbdBand = lpcjdData->cbdBand;
+		cbdBand.ptbScratch = tbScratch;
+		for ( uint32_t I = _ui32Begin; I < _ui32End; ++I ) {
+			if ( CAtomic::AtomicLoad( lpcjdData->aFailed ) ) { return; }
+			uint32_t ui32Y = I * lpcjdData->ui32Rows;
+			cbdBand.pui8Src = lpcjdData->pui8Src + BandOffset( (*cbdBand.pbcSrc), cbdBand.ui32Width, ui32Y );
+			cbdBand.pui8Dst = lpcjdData->pui8Dst + BandOffset( (*cbdBand.pbcDst), cbdBand.ui32Width, ui32Y );
+			cbdBand.ui32Rows = CStd::Min<uint32_t>( lpcjdData->ui32Rows, lpcjdData->ui32Height - ui32Y );
+			if ( !ConvertBand( cbdBand ) ) {
+				CAtomic::AtomicStore( lpcjdData->aFailed, 1 );
+				return;
+			}
+		}
+	}
+
 }	// namespace lsi
@@ -17,11 +17,13 @@
 #define __LSI_IMAGE_H__
 
 #include "../LSIImageLib.h"
+#include "JobSystem/LSHJobSystem.h"				// Before detex.h, which redefines __thread.
 #include "../Dds/LSIDds.h"
 #include "../Kernel/LSIKernel.h"
 #include "../Ktx/LSIKtx.h"
 #include "../Palette/LSIPaletteDatabase.h"
 #include "../Resampler/LSIResampler.h"
+#include "../Transcoder/LSITranscoder.h"
 #include "Map/LSTLLinearMap.h"
 #include "Map/LSTLStaticMap.h"
 #include "Misc/LSCMisc.h"
@@ -29,6 +31,12 @@
 #include "Vector/LSTLVectorPoD.h"
 #include "Vector/LSTLVector.h"
 
+/** The number of texels in each band of a format conversion.  Small enough for a band of RGBA32F texels to stay in the cache. */
+#define LSI_CONVERT_BAND_TEXELS						(32 * 1024)
+
+/** The number of texels in each band of a format conversion through a KTX 1 codec, which runs its own threads. */
+#define LSI_CONVERT_KTX_BAND_TEXELS					(512 * 1024)
+
 namespace lsi {
 
 	// == Enumerations.
@@ -84,6 +92,12 @@ namespace lsi {
 			LSI_CA_MAX								= 6,			/**< Maximum between the RGB channels. */
 		};
 
+		/** Loader limits. */
+		enum LSI_LOADER_LIMITS {
+			LSI_MAX_LOADERS							= 32,			/**< Maximum number of loaders that can be registered in addition to the built-in loaders. */
+			LSI_MAX_MAGIC							= 16,			/**< Maximum length of a loader's file signature. */
+		};
+
 
 		// == Types.
 		/** A table entry for single-color DXT values. */
@@ -137,6 +151,27 @@ namespace lsi {
 			LSI_VKFORMAT							vkFormat;
 		} * LPLSI_KTX2_VALUES, * const LPCLSI_KTX2_VALUES;
 
+		/**
+		 * An image loader.  The image has been reset before the call.  On success the loader fills the image's
+		 *	dimensions, format, and texels, and PostLoad() is called for it.
+		 */
+		typedef LSBOOL (LSE_CALL *					PfLoader)( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen,
+			const CPaletteDatabase * _ppdPalettes );
+
+		/** A loader and the signature that identifies the files it loads. */
+		typedef struct LSI_LOADER {
+			/** The loader. */
+			PfLoader								pfLoader;
+			/** The leading bytes of the files this loader handles. */
+			uint8_t									ui8Magic[LSI_MAX_MAGIC];
+			/** Length of the signature.  A loader with no signature is tried only after the loaders whose signatures match have failed. */
+			uint32_t								ui32MagicLen;
+			/** Offset of the signature from the start of the file. */
+			uint32_t								ui32MagicOffset;
+			/** Loaders are tried from highest to lowest priority. */
+			int32_t									i32Priority;
+		} * LPLSI_LOADER, * const LPCLSI_LOADER;
+
 
 		// == Operators.
 		/**
@@ -261,6 +296,16 @@ namespace lsi {
 		 */
 		LSBOOL LSE_CALL								LoadFile( const char * _pcFile, const CPaletteDatabase * _ppdPalettes = NULL );
 
+		/**
+		 * Adds a loader to the loaders LoadFileFromMemory() can dispatch to.  Loaders with the same priority are tried in the
+		 *	order in which they were added, after the built-in loaders.  Not thread-safe; loaders should be registered at
+		 *	start-up, before any images are loaded.
+		 *
+		 * \param _lLoader The loader to add.
+		 * \return Returns false if the signature is too long or LSI_MAX_LOADERS loaders have already been added.
+		 */
+		static LSBOOL LSE_CALL						RegisterLoader( const LSI_LOADER &_lLoader );
+
 		/**
 		 * Creates a blank image.
 		 *
@@ -803,6 +848,79 @@ namespace lsi {
 			CImage::LSI_DXT_OPTIONS *				pdoOptions;
 		} * LPLSI_DXT_THREAD_DATA, * const LPCLSI_DXT_THREAD_DATA;
 
+		/** Describes how to read or write a band of rows in a given format. */
+		typedef struct LSI_BAND_CODEC {
+			/** The texel format, or LSI_PF_R32G32B32A32F if pfDecode or pfEncode is used. */
+			LSI_PIXEL_FORMAT						pfFormat;
+
+			/** Decodes a band to RGBA32F when reading, or NULL if the texels are converted directly. */
+			CKtx::PfToRgba32F						pfDecode;
+
+			/** Encodes a band from RGBA32F when writing, or NULL if the texels are converted directly. */
+			CKtx::PfFromRgba32F						pfEncode;
+
+			/** Parameters for pfDecode or pfEncode. */
+			void *									pvParm;
+
+			/** KTX 1 format data for getting the size of rows of blocks, or NULL. */
+			const CKtx::LSI_KTX_INTERNAL_FORMAT_DATA *
+													pkifdData;
+
+			/** The size of a DDS block in bytes, or 0. */
+			uint32_t								ui32BlockSize;
+
+			/** The height of a block in texels.  Bands always start on a row of blocks. */
+			uint32_t								ui32BlockHeight;
+		} * LPLSI_BAND_CODEC, * const LPCLSI_BAND_CODEC;
+
+		/** A band of rows to convert. */
+		typedef struct LSI_CONVERT_BAND_DATA {
+			/** How to read the source. */
+			const LSI_BAND_CODEC *					pbcSrc;
+
+			/** How to write the destination. */
+			const LSI_BAND_CODEC *					pbcDst;
+
+			/** The start of the band in the source. */
+			const uint8_t *							pui8Src;
+
+			/** The start of the band in the destination. */
+			uint8_t *								pui8Dst;
+
+			/** Width of the image. */
+			uint32_t								ui32Width;
+
+			/** Number of rows in the band. */
+			uint32_t								ui32Rows;
+
+			/** If not LSI_G_NONE, an sRGB <-> Linear conversion is performed. */
+			LSI_GAMMA								gGamma;
+
+			/** 2 scratch buffers.  They are only ever as large as a band. */
+			CImageLib::CTexelBuffer *				ptbScratch;
+		} * LPLSI_CONVERT_BAND_DATA, * const LPCLSI_CONVERT_BAND_DATA;
+
+		/** Data passed to the jobs converting the bands of a mipmap. */
+		typedef struct LSI_CONVERT_JOB_DATA {
+			/** The band settings shared by all bands.  The band pointers, row count, and scratch buffers are filled per band. */
+			LSI_CONVERT_BAND_DATA					cbdBand;
+
+			/** The source mipmap. */
+			const uint8_t *							pui8Src;
+
+			/** The destination mipmap. */
+			uint8_t *								pui8Dst;
+
+			/** Height of the mipmap. */
+			uint32_t								ui32Height;
+
+			/** Number of rows in each band but the last. */
+			uint32_t								ui32Rows;
+
+			/** Set to 1 if any band could not be converted. */
+			CAtomic::ATOM							aFailed;
+		} * LPLSI_CONVERT_JOB_DATA, * const LPCLSI_CONVERT_JOB_DATA;
+
 
 		// == Members.
 		/** The actual texel buffer. */
@@ -838,6 +956,15 @@ namespace lsi {
 		/** Was the color space set in the file? */
 		LSBOOL										m_bAutoGamma;
 
+		/** The built-in loaders, sorted from highest to lowest priority. */
+		static const LSI_LOADER						m_lBuiltInLoaders[];
+
+		/** The registered loaders, sorted from highest to lowest priority. */
+		static LSI_LOADER							m_lLoaders[LSI_MAX_LOADERS];
+
+		/** Number of loaders in m_lLoaders. */
+		static uint32_t								m_ui32Loaders;
+
 
 		// == Functions.
 		/**
@@ -961,9 +1088,234 @@ namespace lsi {
 		 *
 		 * \param _pui8FileData The in-memory image of the file.
 		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _bSkipTga If true, files FreeImage identifies as TGA are not loaded, leaving them to CTga.
 		 * \return Returns true if the file was successfully loaded.  False indicates an invalid file or lack of RAM.
 		 */
-		LSBOOL LSE_CALL								LoadFreeImage( const uint8_t * _pui8FileData, uint32_t _ui32DataLen );
+		LSBOOL LSE_CALL								LoadFreeImage( const uint8_t * _pui8FileData, uint32_t _ui32DataLen, LSBOOL _bSkipTga = false );
+
+		/**
+		 * Gets the format of the image as understood by CTranscoder.  KTX 1 images in an ETC format map to the matching
+		 *	LSI_PF_ETC* format.
+		 *
+		 * \return Returns the CTranscoder format of the image or LSI_PF_ANY if the image cannot be transcoded directly.
+		 */
+		LSI_PIXEL_FORMAT LSE_CALL					TranscoderFormat() const;
+
+		/**
+		 * Transcodes every mipmap of the image directly from _pfSrc to _pfDst via CTranscoder, without going through
+		 *	RGBA32F.  The destination image must already have been created in the destination format.
+		 *
+		 * \param _pfSrc The CTranscoder format of this image.
+		 * \param _pfDst The CTranscoder format of the destination image.
+		 * \param _iDst The destination image.
+		 * \param _toOptions The transcoding options.
+		 * \return Returns true if there are no resource problems.
+		 */
+		LSBOOL LSE_CALL								TranscodeMipMaps( LSI_PIXEL_FORMAT _pfSrc, LSI_PIXEL_FORMAT _pfDst, CImage &_iDst,
+			const CTranscoder::LSI_TRANSCODE_OPTIONS &_toOptions ) const;
+
+		/**
+		 * Gets the CTranscoder format matching a KTX 1 internal format.
+		 *
+		 * \param _kifFormat The KTX 1 internal format.
+		 * \return Returns the matching LSI_PF_ETC* format or LSI_PF_ANY if the internal format is not an ETC format.
+		 */
+		static LSI_PIXEL_FORMAT LSE_CALL			EtcFormat( LSI_KTX_INTERNAL_FORMAT _kifFormat );
+
+		/**
+		 * Gets the codec for reading this image a band of rows at a time.  Compressed images are decoded to RGBA32F.
+		 *
+		 * \param _bcCodec The returned codec.
+		 * \return Returns false if the image cannot be read a band at a time, in which case the whole image must be decoded at once.
+		 */
+		LSBOOL LSE_CALL								GetBandCodec( LSI_BAND_CODEC &_bcCodec ) const;
+
+		/**
+		 * Gets the codec for reading or writing a band of rows in a KTX 1 format.
+		 *
+		 * \param _pkifdData The KTX 1 format.
+		 * \param _pvParm Parameters to pass to the decoder or encoder.
+		 * \param _bcCodec The returned codec.
+		 * \return Returns false if the format cannot be read or written a band at a time.
+		 */
+		static LSBOOL LSE_CALL						GetKtx1BandCodec( const CKtx::LSI_KTX_INTERNAL_FORMAT_DATA * _pkifdData, void * _pvParm, LSI_BAND_CODEC &_bcCodec );
+
+		/**
+		 * Gets the offset of a row of texels from the start of a mipmap.
+		 *
+		 * \param _bcCodec The format of the mipmap.
+		 * \param _ui32Width Width of the mipmap.
+		 * \param _ui32Row The row, which must be the first row of a block.
+		 * \return Returns the offset, in bytes, of the row.
+		 */
+		static uint32_t LSE_CALL					BandOffset( const LSI_BAND_CODEC &_bcCodec, uint32_t _ui32Width, uint32_t _ui32Row );
+
+		/**
+		 * Converts every mipmap of this image to the format of another image a band of rows at a time.  Each band is
+		 *	decoded, converted, and encoded before moving on, and bands are spread over the job system, so the only extra
+		 *	memory used is a pair of band-sized scratch buffers per job.
+		 *
+		 * \param _bcSrc How to read this image.
+		 * \param _iDst The destination image, which must already have been created.
+		 * \param _bcDst How to write the destination image.
+		 * \param _gGamma If not LSI_G_NONE, an sRGB <-> Linear conversion is performed.
+		 * \return Returns false if there are resource problems.
+		 */
+		LSBOOL LSE_CALL								ConvertMipMapsInBands( const LSI_BAND_CODEC &_bcSrc, CImage &_iDst, const LSI_BAND_CODEC &_bcDst,
+			LSI_GAMMA _gGamma ) const;
+
+		/**
+		 * Converts a single band of rows.
+		 *
+		 * \param _cbdData The band to convert.
+		 * \return Returns false if there are resource problems.
+		 */
+		static LSBOOL LSE_CALL						ConvertBand( const LSI_CONVERT_BAND_DATA &_cbdData );
+
+		/**
+		 * Converts texels between uncompressed formats without writing past the end of the destination, which
+		 *	CImageLib::BatchAnyTexelToAnytexel() otherwise does by up to 8 bytes.
+		 *
+		 * \param _pfSrcFormat The source texel format.
+		 * \param _pvSrcBuffer The source buffer.  Must be over-allocated by 8 bytes.
+		 * \param _pfDstFormat The destination texel format.
+		 * \param _pvDstBuffer The destination buffer.
+		 * \param _ui32Total The total number of texels to convert.
+		 * \param _gGamma If _gGamma is not LSI_G_NONE, then an sRGB <-> Linear conversion is performed.
+		 */
+		static void LSE_CALL						ConvertTexelsExact( LSI_PIXEL_FORMAT _pfSrcFormat, const void * _pvSrcBuffer,
+			LSI_PIXEL_FORMAT _pfDstFormat, void * _pvDstBuffer, uint32_t _ui32Total, LSI_GAMMA _gGamma );
+
+		/**
+		 * Determines whether the given file begins with the signature of the given loader.
+		 *
+		 * \param _lLoader The loader.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \return Returns true if the loader has a signature and the file contains it.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL			MatchesMagic( const LSI_LOADER &_lLoader, const uint8_t * _pui8FileData, uint32_t _ui32DataLen );
+
+		/**
+		 * Loads a BMP file.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderBmp( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads a TGA file.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderTga( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads a QOI file and sets the color space it specifies.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderQoi( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads a PNG file.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderPng( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads a DDS file.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderDds( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads a KTX 1 file.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderKtx1( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads a KTX 2 file.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderKtx2( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads a PBMP file.  Fails if no palette database is given.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderPBmp( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads an LSI file.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderLsi( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads a file via FreeImage.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderFreeImage( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
+
+		/**
+		 * Loads any file FreeImage recognizes other than TGA files, which are left to CTga.
+		 *
+		 * \param _iImage The image to fill.
+		 * \param _pui8FileData The in-memory image of the file.
+		 * \param _ui32DataLen The length of the in-memory image of the file.
+		 * \param _ppdPalettes An optional palette database.
+		 * \return Returns true if the file was successfully loaded.
+		 */
+		static LSBOOL LSE_CALL						LoaderFreeImageProbe( CImage &_iImage, const uint8_t * _pui8FileData, uint32_t _ui32DataLen, const CPaletteDatabase * _ppdPalettes );
 
 		/**
 		 * A thread function for resampling from a source image to a destination texel buffer.
@@ -981,6 +1333,15 @@ namespace lsi {
 		 */
 		static uint32_t LSH_CALL					DxtThread( void * _lpParameter );
 
+		/**
+		 * Job function for converting a range of bands of a mipmap.
+		 *
+		 * \param _ui32Begin Index of the first band to convert.
+		 * \param _ui32End Index of the band after the last to convert.
+		 * \param _pvParm Pointer to an LSI_CONVERT_JOB_DATA structure.
+		 */
+		static void LSE_CALL						ConvertRange( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm );
+
 	};
 
 
@@ -1331,6 +1692,20 @@ namespace lsi {
 		return m_kvKtx1;
 	}
 
+	/**
+	 * Determines whether the given file begins with the signature of the given loader.
+	 *
+	 * \param _lLoader The loader.
+	 * \param _pui8FileData The in-memory image of the file.
+	 * \param _ui32DataLen The length of the in-memory image of the file.
+	 * \return Returns true if the loader has a signature and the file contains it.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CImage::MatchesMagic( const LSI_LOADER &_lLoader, const uint8_t * _pui8FileData, uint32_t _ui32DataLen ) {
+		if ( !_lLoader.ui32MagicLen ) { return false; }
+		if ( _ui32DataLen < _lLoader.ui32MagicOffset || _ui32DataLen - _lLoader.ui32MagicOffset < _lLoader.ui32MagicLen ) { return false; }
+		return CStd::MemCmpF( &_pui8FileData[_lLoader.ui32MagicOffset], _lLoader.ui8Magic, _lLoader.ui32MagicLen );
+	}
+
 }	// namespace lsi
 
 #endif	// __LSI_IMAGE_H__
@@ -15,6 +15,7 @@
 #include "LSIImageLib.h"
 #include "FreeImage.h"
 #include "Dds/LSIDds.h"
+#include "SimdConvert/LSISimdConvert.h"
 
 
 namespace lsi {
@@ -333,4 +334,20 @@ namespace lsi {
 		return Float32TexelToIntegerTexel( _pfDstFormat, fArray, _gGamma );
 	}
 
+	/**
+	 * Converts a batch of texels with a SIMD kernel if there is one for the pair of formats on this CPU.
+	 *
+	 * \param _pfSrcFormat The source texel format.
+	 * \param _pvSrcBuffer The source buffer.
+	 * \param _pfDstFormat The destination texel format.
+	 * \param _pvDstBuffer The destination buffer.
+	 * \param _ui32Total The total number of texels to convert.
+	 * \param _gGamma If _gGamma is not LSI_G_NONE, then an sRGB <-> Linear conversion is performed.
+	 * \return Returns true if the texels were converted.  If false is returned, nothing was written.
+	 */
+	LSBOOL LSE_CALL CImageLib::BatchSimd( LSI_PIXEL_FORMAT _pfSrcFormat, const void * _pvSrcBuffer,
+		LSI_PIXEL_FORMAT _pfDstFormat, void * _pvDstBuffer, uint32_t _ui32Total, LSI_GAMMA _gGamma ) {
+		return CSimdConvert::Convert( _pfSrcFormat, _pvSrcBuffer, _pfDstFormat, _pvDstBuffer, _ui32Total, _gGamma );
+	}
+
 }	// namespace lsi
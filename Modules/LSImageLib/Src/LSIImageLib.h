@@ -625,6 +625,20 @@ namespace lsi {
 
 	protected :
 		// == Functions.
+		/**
+		 * Converts a batch of texels with a SIMD kernel if there is one for the pair of formats on this CPU.
+		 *
+		 * \param _pfSrcFormat The source texel format.
+		 * \param _pvSrcBuffer The source buffer.
+		 * \param _pfDstFormat The destination texel format.
+		 * \param _pvDstBuffer The destination buffer.
+		 * \param _ui32Total The total number of texels to convert.
+		 * \param _gGamma If _gGamma is not LSI_G_NONE, then an sRGB <-> Linear conversion is performed.
+		 * \return Returns true if the texels were converted.  If false is returned, nothing was written.
+		 */
+		static LSBOOL LSE_CALL					BatchSimd( LSI_PIXEL_FORMAT _pfSrcFormat, const void * _pvSrcBuffer,
+			LSI_PIXEL_FORMAT _pfDstFormat, void * _pvDstBuffer, uint32_t _ui32Total, LSI_GAMMA _gGamma );
+
 		/**
 		 * Converts a single component from one integer form to another, optionally doing an sRGB <-> Linear conversion.
 		 *
@@ -1291,6 +1305,7 @@ namespace lsi {
 			CStd::MemCpy( _pvDstBuffer, _pvSrcBuffer, GetFormatSize( _pfSrcFormat ) * _ui32Total );
 			return;
 		}
+		if ( BatchSimd( _pfSrcFormat, _pvSrcBuffer, _pfDstFormat, _pvDstBuffer, _ui32Total, _gGamma ) ) { return; }
 		// Convert texel-by-texel.
 		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrcBuffer);
 		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDstBuffer);
@@ -1340,6 +1355,7 @@ namespace lsi {
 	 */
 	LSE_INLINE void LSE_CALL CImageLib::BatchIntegerTexelToFloat32Texel( LSI_PIXEL_FORMAT _pfSrcFormat, const void * _pvSrcBuffer,
 		void * _pvDstBuffer, uint32_t _ui32Total, LSI_GAMMA _gGamma ) {
+		if ( BatchSimd( _pfSrcFormat, _pvSrcBuffer, LSI_PF_R32G32B32A32F, _pvDstBuffer, _ui32Total, _gGamma ) ) { return; }
 		// Convert texel-by-texel.
 		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrcBuffer);
 		float * pfDst = static_cast<float *>(_pvDstBuffer);
@@ -1414,6 +1430,7 @@ namespace lsi {
 	 */
 	LSE_INLINE void LSE_CALL CImageLib::BatchFloat32TexelToIntegerTexel( const void * _pvSrcBuffer, LSI_PIXEL_FORMAT _pfDstFormat,
 		void * _pvDstBuffer, uint32_t _ui32Total, LSI_GAMMA _gGamma ) {
+		if ( BatchSimd( LSI_PF_R32G32B32A32F, _pvSrcBuffer, _pfDstFormat, _pvDstBuffer, _ui32Total, _gGamma ) ) { return; }
 		// Convert texel-by-texel.
 		const float * pfSrc = static_cast<const float *>(_pvSrcBuffer);
 		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDstBuffer);
@@ -1468,6 +1485,7 @@ namespace lsi {
 			CStd::MemCpy( _pvDstBuffer, _pvSrcBuffer, GetFormatSize( _pfSrcFormat ) * _ui32Total );
 			return;
 		}
+		if ( BatchSimd( _pfSrcFormat, _pvSrcBuffer, _pfDstFormat, _pvDstBuffer, _ui32Total, _gGamma ) ) { return; }
 		switch ( _gGamma ) {
 			case LSI_G_sRGB : {
 				if ( _pfSrcFormat == LSI_PF_R16G16B16A16F && _pfDstFormat == LSI_PF_R16G16B16A16F ) {
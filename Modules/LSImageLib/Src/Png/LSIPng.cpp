@@ -9,22 +9,21 @@
  *	You may not take credit for having written this code.
  *
  *
- * Description: Handles the loading of 8-bit PNG files.
+ * Description: Handles the loading of PNG files.  All color types, bit depths, and interlacing are supported.
+ *	Image data is inflated and unfiltered a row at a time as the IDAT chunks are read, and each row is written
+ *	straight to the returned buffer in the native format.
  */
 
 #include "LSIPng.h"
-#include "ZLib/LSCZLib.h"
+#include "Simd/LSSTDSimdStd.h"
+#include "ZLib/LSCZLibStreamDecoder.h"
 
+#ifdef LSSTD_SIMD_SSE2
+#include <emmintrin.h>
+#endif	// #ifdef LSSTD_SIMD_SSE2
 
-namespace lsi {
 
-	// == Members.
-	/**
-	 * Translates from a standard filter to a first-row filter.
-	 */
-	CPng::LSI_PNG_FILTER CPng::m_pfFirstRowFilter[] = {
-		LSI_PF_NONE, LSI_PF_SUB, LSI_PF_NONE, LSI_PF_AVG_FIRST, LSI_PF_PAETH_FIRST
-	};
+namespace lsi {
 
 	// == Functions.
 	/**
@@ -45,156 +44,154 @@ namespace lsi {
 
 		if ( !CheckHeader( ebsStream ) ) { return false; }
 
-		uint8_t ui8Palette[1024];
-		uint8_t ui8PalImgN = 0;
-		uint32_t ui32ImgN = 0, ui32PalLen = 0;
-		CVectorPoD<uint8_t, uint32_t, 4096UL> vDataI;
-		uint8_t ui8Components = 0, ui8Interlace = 0;
-		LSBOOL bHasTrans = false;
-		uint8_t ui8Tc[3];
+		LSI_PNG_DECODE pdDecode;
+		pdDecode.ui32PalLen = 0;
+		pdDecode.bTrns = false;
+		pdDecode.bBgr = false;
+		// The palette is opaque unless tRNS says otherwise.
+		CStd::MemSet( pdDecode.ui8Palette, 0xFF, sizeof( pdDecode.ui8Palette ) );
+
+		// Two rows plus a filter byte each, with room for SIMD reads past the ends.
+		CVectorPoD<uint8_t, uint32_t> vRows;
+		lsc::CZLibStreamDecoder zsdInflate;
 
-		LSBOOL bIPhone = false, bInterlaced = false, bFirst = true;
+		LSBOOL bHeader = false, bHaveData = false, bDataEnded = false;
 #define LSI_PNG_TYPE( A, B, C, D )  (((A) << 24UL) + ((B) << 16) + ((C) << 8) + (D))
-		for ( ; ; bFirst = false ) {
+		for ( ; ; ) {
 			LSI_PNG_CHUNK pcChunk;
 			if ( !NextChunk( ebsStream, pcChunk ) ) { return false; }
+			if ( pcChunk.ui32Length > _ui32DataLen - ebsStream.GetPos() ) { return false; }
+			if ( bHaveData && pcChunk.ui32Type != LSI_PNG_TYPE( 'I', 'D', 'A', 'T' ) ) {
+				// IDAT chunks must be consecutive.
+				bDataEnded = true;
+			}
 			switch ( pcChunk.ui32Type ) {
 				case LSI_PNG_TYPE( 'C', 'g', 'B', 'I' ) : {
-					bIPhone = true;
+					if ( bHeader ) { return false; }
+					pdDecode.bBgr = true;
 					Skip( ebsStream, pcChunk.ui32Length );
 					break;
 				}
 				case LSI_PNG_TYPE( 'I', 'H', 'D', 'R' ) : {
-					if ( !bFirst ) { return false; }
-					bFirst = false;
-					if ( pcChunk.ui32Length != 13 ) { return false; }	// Bad header.
+					if ( bHeader ) { return false; }
+					bHeader = true;
+					if ( pcChunk.ui32Length != 13 ) { return false; }		// Bad header.
 					if ( !ReadUi32( ebsStream, _ui32Width ) ) { return false; }
 					if ( !ReadUi32( ebsStream, _ui32Height ) ) { return false; }
-					if ( !_ui32Width || !_ui32Height ) { return false; }// 0-sized image.
+					if ( !_ui32Width || !_ui32Height ) { return false; }	// 0-sized image.
+					if ( _ui32Width > (1UL << 24) || _ui32Height > (1UL << 24) ) { return false; }
 
-					uint8_t ui8Depth;
+					uint8_t ui8Depth, ui8Color, ui8Compression, ui8Filter, ui8Interlace;
 					if ( !ReadUi8( ebsStream, ui8Depth ) ) { return false; }
-					if ( ui8Depth != 8 ) { return false; }				// We only handle 8-bit images.
-
-					uint8_t ui8Color;
 					if ( !ReadUi8( ebsStream, ui8Color ) ) { return false; }
-					if ( ui8Color > 6 ) { return false; }				// Bad ctype.
-
-					if ( ui8Color == 3 ) {
-						ui8PalImgN = 3;
-					}
-					else if ( ui8Color & 1 ) {
-						return false;									// Bad ctype.
-					}
-
-
-					if ( !ReadUi8( ebsStream, ui8Components ) ) { return false; }
-					if ( ui8Components ) { return false; }				// Bad component method.
-					if ( ui8Components > 4 ) { return false; }
-
-					uint8_t ui8Filter;
+					if ( !ReadUi8( ebsStream, ui8Compression ) ) { return false; }
 					if ( !ReadUi8( ebsStream, ui8Filter ) ) { return false; }
-					if ( ui8Filter ) { return false; }					// Bad filter method.
-
-					
 					if ( !ReadUi8( ebsStream, ui8Interlace ) ) { return false; }
-					if ( ui8Interlace > 1 ) { return false; }			// Bad interlace setting.
-					bInterlaced = ui8Interlace;
-
-					if ( !ui8PalImgN ) {
-						// No palette.
-						ui32ImgN = (ui8Color & 2 ? 3 : 1) + (ui8Color & 4 ? 1 : 0);
-					}
-					else {
-						// Paletted.
-						ui32ImgN = 1;
+					if ( ui8Compression || ui8Filter || ui8Interlace > 1 ) { return false; }
+
+					// Validate the combination of color type and bit depth.
+					switch ( ui8Color ) {
+						case LSI_PCT_GRAY : {
+							if ( ui8Depth != 1 && ui8Depth != 2 && ui8Depth != 4 && ui8Depth != 8 && ui8Depth != 16 ) { return false; }
+							pdDecode.ui32Channels = 1;
+							break;
+						}
+						case LSI_PCT_PALETTE : {
+							if ( ui8Depth != 1 && ui8Depth != 2 && ui8Depth != 4 && ui8Depth != 8 ) { return false; }
+							pdDecode.ui32Channels = 1;
+							break;
+						}
+						case LSI_PCT_RGB : {}
+						case LSI_PCT_GRAY_ALPHA : {}
+						case LSI_PCT_RGBA : {
+							if ( ui8Depth != 8 && ui8Depth != 16 ) { return false; }
+							pdDecode.ui32Channels = ui8Color == LSI_PCT_RGB ? 3 : (ui8Color == LSI_PCT_RGBA ? 4 : 2);
+							break;
+						}
+						default : { return false; }								// Bad color type.
 					}
+					pdDecode.ui32Width = _ui32Width;
+					pdDecode.ui32Height = _ui32Height;
+					pdDecode.ui32Depth = ui8Depth;
+					pdDecode.ui32Color = ui8Color;
+					pdDecode.ui32Bpp = CStd::Max<uint32_t>( pdDecode.ui32Channels * ui8Depth / 8, 1 );
+					pdDecode.bInterlaced = ui8Interlace;
 					break;
 				}
 				case LSI_PNG_TYPE( 'P', 'L', 'T', 'E' ) : {
-					if ( bFirst ) { return false; }
+					if ( !bHeader || bHaveData ) { return false; }
 					if ( pcChunk.ui32Length > 256 * 3 ) { return false; }
-					ui32PalLen = pcChunk.ui32Length / 3;
-					if ( ui32PalLen * 3 != pcChunk.ui32Length ) { return false; }	// Make sure the palette length is a multiple of 3.
-					for ( uint32_t I = 0; I < ui32PalLen; ++I ) {
-						if ( !ReadUi8( ebsStream, ui8Palette[(I<<2)+0] ) ) { return false; }
-						if ( !ReadUi8( ebsStream, ui8Palette[(I<<2)+1] ) ) { return false; }
-						if ( !ReadUi8( ebsStream, ui8Palette[(I<<2)+2] ) ) { return false; }
-						ui8Palette[(I<<2)+3] = 0xFF;
-						
+					pdDecode.ui32PalLen = pcChunk.ui32Length / 3;
+					if ( pdDecode.ui32PalLen * 3 != pcChunk.ui32Length ) { return false; }	// Make sure the palette length is a multiple of 3.
+					for ( uint32_t I = 0; I < pdDecode.ui32PalLen; ++I ) {
+						if ( !ReadUi8( ebsStream, pdDecode.ui8Palette[(I<<2)+0] ) ) { return false; }
+						if ( !ReadUi8( ebsStream, pdDecode.ui8Palette[(I<<2)+1] ) ) { return false; }
+						if ( !ReadUi8( ebsStream, pdDecode.ui8Palette[(I<<2)+2] ) ) { return false; }
 					}
 					break;
 				}
 				case LSI_PNG_TYPE( 't', 'R', 'N', 'S' ) : {
-					if ( bFirst ) { return false; }
-					if ( vDataI.Length() ) { return false; }
-					if ( ui8PalImgN ) {
-						if ( ui32PalLen == 0 ) { return false; }
-						if ( pcChunk.ui32Length > ui32PalLen ) { return false; }
-						ui8PalImgN = 4;
+					if ( !bHeader || bHaveData ) { return false; }
+					if ( pdDecode.ui32Color == LSI_PCT_PALETTE ) {
+						if ( pcChunk.ui32Length > 256 ) { return false; }
 						for ( uint32_t I = 0; I < pcChunk.ui32Length; ++I ) {
-							if ( !ReadUi8( ebsStream, ui8Palette[(I<<2)+3] ) ) { return false; }
+							if ( !ReadUi8( ebsStream, pdDecode.ui8Palette[(I<<2)+3] ) ) { return false; }
 						}
 					}
-					else {
-						if ( !(ui32ImgN & 1) ) { return false; }
-						if ( pcChunk.ui32Length != (ui32ImgN << 1) ) { return false; }
-						bHasTrans = true;
-						for ( uint32_t I = 0; I < ui32ImgN; ++I ) {
-							uint16_t ui16Temp;
-							if ( !ReadUi16( ebsStream, ui16Temp ) ) { return false; }
-							ui8Tc[I] = static_cast<uint8_t>(ui16Temp);
+					else if ( pdDecode.ui32Color == LSI_PCT_GRAY || pdDecode.ui32Color == LSI_PCT_RGB ) {
+						if ( pcChunk.ui32Length != pdDecode.ui32Channels * 2 ) { return false; }
+						for ( uint32_t I = 0; I < pdDecode.ui32Channels; ++I ) {
+							if ( !ReadUi16( ebsStream, pdDecode.ui16Trns[I] ) ) { return false; }
 						}
 					}
+					else {
+						// Not allowed on images with an alpha channel.
+						return false;
+					}
+					pdDecode.bTrns = true;
 					break;
 				}
 				case LSI_PNG_TYPE( 'I', 'D', 'A', 'T' ) : {
-					if ( bFirst ) { return false; }
-					if ( ui8PalImgN && !ui32PalLen ) { return false; }
-					uint32_t ui32Len = vDataI.Length();
-					if ( !vDataI.Resize( ui32Len + pcChunk.ui32Length ) ) { return false; }	// Out of memory.
-
-					if ( !ebsStream.ReadBytes( &vDataI[ui32Len], pcChunk.ui32Length ) ) { return false; }
+					if ( !bHeader || bDataEnded ) { return false; }
+					if ( !bHaveData ) {
+						if ( pdDecode.ui32Color == LSI_PCT_PALETTE && !pdDecode.ui32PalLen ) { return false; }
+						bHaveData = true;
+
+						// Pick the output format.
+						if ( pdDecode.ui32Depth == 16 ) {
+							pdDecode.pfFormat = LSI_PF_R16G16B16A16;
+						}
+						else {
+							pdDecode.pfFormat = ((pdDecode.ui32Color & 4) || pdDecode.bTrns) ? LSI_PF_R8G8B8A8 : LSI_PF_R8G8B8;
+						}
+						pdDecode.ui32TexelSize = CImageLib::GetFormatSize( pdDecode.pfFormat );
+						if ( static_cast<uint64_t>(_ui32Width) * _ui32Height * pdDecode.ui32TexelSize >= 0x80000000ULL ) { return false; }
+						if ( !_tbReturn.Resize( CImageLib::GetBufferSizeWithPadding( pdDecode.pfFormat, _ui32Width, _ui32Height ) ) ) { return false; }
+						pdDecode.pui8Dst = &_tbReturn[0];
+
+						uint32_t ui32RowSize = (_ui32Width * pdDecode.ui32Channels * pdDecode.ui32Depth + 7) / 8 + 1 + 16;
+						if ( !vRows.Resize( ui32RowSize * 2 ) ) { return false; }
+						CStd::MemSet( &vRows[0], 0, vRows.Length() );
+						pdDecode.pui8Cur = &vRows[1];
+						pdDecode.pui8Prev = &vRows[ui32RowSize+1];
+
+						// CgBI images hold raw deflate data.
+						zsdInflate.Reset( pdDecode.bBgr );
+						BeginPass( pdDecode, 0 );
+					}
+					if ( !DecodeData( pdDecode, zsdInflate, _pui8FileData + ebsStream.GetPos(), pcChunk.ui32Length ) ) { return false; }
+					Skip( ebsStream, pcChunk.ui32Length );
 					break;
 				}
 				case LSI_PNG_TYPE( 'I', 'E', 'N', 'D' ) : {
-					if ( bFirst ) { return false; }
-					if ( !vDataI.Length() ) { return false; }
-					CZLib::LSC_ZLIB_BUFFER zbRet;
-					CZLib zLib;
-					if ( !zLib.DecodeZLib( &vDataI[0], vDataI.Length(), bIPhone, zbRet ) ) { return false; }
-					if ( !zbRet.Length() ) { return false; }
-					vDataI.Reset();		// Save some memory.
-
-					LSI_PNG_FINAL pfFinal;
-					pfFinal.ui32X = pfFinal.ui32Width = _ui32Width;
-					pfFinal.ui32Y = pfFinal.ui32Height = _ui32Height;
-					pfFinal.ui32Components = ui32ImgN;
-					pfFinal.puiRawData = &zbRet[0];
-					pfFinal.ui32RawLen = zbRet.Length();
-					if ( !CreatePng( pfFinal, _tbReturn, ui8Interlace ) ) { return false; }
-
-					static const LSI_PIXEL_FORMAT pfFormats[] = {
-						LSI_PF_R3G3B2,
-						LSI_PF_R4G4B4A4,
-						LSI_PF_R8G8B8,
-						LSI_PF_R8G8B8A8
-					};
-					if ( ui8PalImgN ) {
-						_pfFormat = pfFormats[ui8PalImgN-1];
-						if ( !ExpandPalette( _tbReturn, ui8Palette, ui32PalLen, _ui32Width, _ui32Height, ui8PalImgN, !bIPhone ) ) { return false; }
-					}
-					else {
-						_pfFormat = pfFormats[ui32ImgN-1];
-
-						if ( !bIPhone ) {
-							FixColors( _tbReturn, ui32ImgN );
-						}
-					}
+					// Every row must have been decoded.
+					if ( !bHaveData || pdDecode.ui32Pass != 7 ) { return false; }
+					_pfFormat = pdDecode.pfFormat;
 					return true;
 				}
 				default : {
-					if ( bFirst ) { return false; }
+					if ( !bHeader ) { return false; }
+					// Unknown critical chunks cannot be skipped.
 					if ( !(pcChunk.ui32Type & (1 << 29UL)) ) { return false; }
 					Skip( ebsStream, pcChunk.ui32Length );
 				}
@@ -240,241 +237,349 @@ namespace lsi {
 	}
 
 	/**
-	 * Create the final image data from decompressed PNG data.  Image data must not be interlaced.
+	 * Inflates the data of an IDAT chunk, unfiltering and storing each row as it is completed.
 	 *
-	 * \param _pfFinal Parameters.
-	 * \param _tbReturn The output of the processing.
-	 * \return Returns true if there is enough memory to allocate the final buffer.
+	 * \param _pdDecode The decoding state.
+	 * \param _zsdInflate The inflater, which keeps its state from one IDAT chunk to the next.
+	 * \param _pui8Data The data of the chunk.
+	 * \param _ui32Length Length of the data of the chunk.
+	 * \return Returns false if the data is invalid.
 	 */
-	LSBOOL LSE_CALL CPng::CreatePng( LSI_PNG_FINAL &_pfFinal, CImageLib::CTexelBuffer &_tbReturn ) {
-		uint32_t ui32Stride = _pfFinal.ui32X * _pfFinal.ui32Components;
-		if ( !_tbReturn.Resize( ui32Stride * _pfFinal.ui32Y ) ) { return false; }
+	LSBOOL LSE_CALL CPng::DecodeData( LSI_PNG_DECODE &_pdDecode, lsc::CZLibStreamDecoder &_zsdInflate,
+		const uint8_t * _pui8Data, uint32_t _ui32Length ) {
+		uintptr_t uiptrLeft = _ui32Length;
+		// Once every row has been decoded, anything left (such as the checksum) is not needed.
+		while ( _pdDecode.ui32Pass < 7 ) {
+			uintptr_t uiptrUsed, uiptrWritten;
+			lsc::LSC_DECODE_STATUS dsStatus = _zsdInflate.Decode( _pui8Data, uiptrLeft, uiptrUsed,
+				_pdDecode.pui8Cur - 1 + _pdDecode.ui32Filled, _pdDecode.ui32RowBytes + 1 - _pdDecode.ui32Filled, uiptrWritten );
+			_pui8Data += uiptrUsed;
+			uiptrLeft -= uiptrUsed;
+			_pdDecode.ui32Filled += static_cast<uint32_t>(uiptrWritten);
+
+			if ( _pdDecode.ui32Filled == _pdDecode.ui32RowBytes + 1 ) {
+				if ( !Unfilter( _pdDecode.pui8Cur[-1], _pdDecode.pui8Cur, _pdDecode.pui8Prev, _pdDecode.ui32RowBytes, _pdDecode.ui32Bpp ) ) { return false; }
+				if ( !StoreRow( _pdDecode ) ) { return false; }
+
+				uint8_t * pui8Temp = _pdDecode.pui8Cur;
+				_pdDecode.pui8Cur = _pdDecode.pui8Prev;
+				_pdDecode.pui8Prev = pui8Temp;
+				_pdDecode.ui32Filled = 0;
+				if ( ++_pdDecode.ui32Row == _pdDecode.ui32PassHeight ) {
+					BeginPass( _pdDecode, _pdDecode.ui32Pass + 1 );
+				}
+				continue;
+			}
+			// The stream ended before the image did or is damaged.
+			if ( dsStatus == lsc::LSC_DS_ERROR || dsStatus == lsc::LSC_DS_DONE ) { return false; }
+			if ( dsStatus == lsc::LSC_DS_NEED_INPUT ) { break; }
+		}
+		return true;
+	}
 
+	/**
+	 * Prepares the given interlace pass, skipping passes that contain no pixels.  Non-interlaced images have
+	 *	only pass 0.
+	 *
+	 * \param _pdDecode The decoding state.
+	 * \param _ui32Pass The pass to begin.
+	 */
+	void LSE_CALL CPng::BeginPass( LSI_PNG_DECODE &_pdDecode, uint32_t _ui32Pass ) {
+		static const uint32_t ui32OrigX[] = { 0, 4, 0, 2, 0, 1, 0 };
+		static const uint32_t ui32OrigY[] = { 0, 0, 4, 0, 2, 0, 1 };
+		static const uint32_t ui32SpaceX[]  = { 8, 8, 4, 4, 2, 2, 1 };
+		static const uint32_t ui32SpaceY[]  = { 8, 8, 8, 4, 4, 2, 2 };
 
-		if ( _pfFinal.ui32Width == _pfFinal.ui32X && _pfFinal.ui32Height == _pfFinal.ui32Y ) {
-			if ( _pfFinal.ui32RawLen != (_pfFinal.ui32Components * _pfFinal.ui32X + 1) * _pfFinal.ui32Y ) { return false; }
+		_pdDecode.ui32Row = 0;
+		_pdDecode.ui32Filled = 0;
+		if ( !_pdDecode.bInterlaced ) {
+			_pdDecode.ui32Pass = _ui32Pass ? 7 : 0;
+			_pdDecode.ui32PassWidth = _pdDecode.ui32Width;
+			_pdDecode.ui32PassHeight = _pdDecode.ui32Height;
 		}
 		else {
-			// Interlaced.
-			if ( _pfFinal.ui32RawLen < (_pfFinal.ui32Components * _pfFinal.ui32X + 1) * _pfFinal.ui32Y ) { return false; }
+			for ( _pdDecode.ui32Pass = _ui32Pass; _pdDecode.ui32Pass < 7; ++_pdDecode.ui32Pass ) {
+				uint32_t P = _pdDecode.ui32Pass;
+				_pdDecode.ui32PassWidth = _pdDecode.ui32Width > ui32OrigX[P] ? (_pdDecode.ui32Width - ui32OrigX[P] + ui32SpaceX[P] - 1) / ui32SpaceX[P] : 0;
+				_pdDecode.ui32PassHeight = _pdDecode.ui32Height > ui32OrigY[P] ? (_pdDecode.ui32Height - ui32OrigY[P] + ui32SpaceY[P] - 1) / ui32SpaceY[P] : 0;
+				if ( _pdDecode.ui32PassWidth && _pdDecode.ui32PassHeight ) { break; }
+			}
 		}
+		if ( _pdDecode.ui32Pass == 7 ) { return; }
+		_pdDecode.ui32RowBytes = (_pdDecode.ui32PassWidth * _pdDecode.ui32Channels * _pdDecode.ui32Depth + 7) / 8;
+		// The first row of each pass has nothing above it.
+		CStd::MemSet( _pdDecode.pui8Prev, 0, _pdDecode.ui32RowBytes );
+	}
 
-
-		uint8_t * pui8Raw = _pfFinal.puiRawData;
-		for ( uint32_t J = 0; J < _pfFinal.ui32Y; ++J ) {
-			uint8_t * pui8Cur = &_tbReturn[0] + ui32Stride * J;
-			uint8_t * pui8Prev = pui8Cur - ui32Stride;
-			uint32_t ui32Filter = (*pui8Raw++);
-			if ( ui32Filter > 4 ) { return false; }
-
-			if ( J == 0 ) {
-				// First row must not sample previous row.
-				ui32Filter = m_pfFirstRowFilter[ui32Filter];
+	/**
+	 * Unfilters a row in place.
+	 *
+	 * \param _ui32Filter The filter applied to the row.
+	 * \param _pui8Cur The row to unfilter.
+	 * \param _pui8Prev The previous unfiltered row, or all 0's for the first row of a pass.  Must be readable for 16
+	 *	bytes past _ui32Bytes, as must _pui8Cur.
+	 * \param _ui32Bytes Bytes in the row.
+	 * \param _ui32Bpp Bytes per complete pixel, at least 1.
+	 * \return Returns false if the filter is invalid.
+	 */
+	LSBOOL LSE_CALL CPng::Unfilter( uint32_t _ui32Filter, uint8_t * _pui8Cur, const uint8_t * _pui8Prev,
+		uint32_t _ui32Bytes, uint32_t _ui32Bpp ) {
+		uint32_t I = 0;
+		switch ( _ui32Filter ) {
+			case LSI_PF_NONE : { return true; }
+			case LSI_PF_UP : {
+#ifdef LSSTD_SIMD_SSE2
+				for ( ; I + 16 <= _ui32Bytes; I += 16 ) {
+					_mm_storeu_si128( reinterpret_cast<__m128i *>(_pui8Cur + I), _mm_add_epi8(
+						_mm_loadu_si128( reinterpret_cast<const __m128i *>(_pui8Cur + I) ),
+						_mm_loadu_si128( reinterpret_cast<const __m128i *>(_pui8Prev + I) ) ) );
+				}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+				for ( ; I < _ui32Bytes; ++I ) {
+					_pui8Cur[I] = static_cast<uint8_t>(_pui8Cur[I] + _pui8Prev[I]);
+				}
+				return true;
 			}
+			case LSI_PF_SUB : {}
+			case LSI_PF_AVG : {}
+			case LSI_PF_PAETH : { break; }
+			default : { return false; }
+		}
 
-			uint32_t K;
-			for ( K = 0; K < _pfFinal.ui32Components; ++K ) {
-				switch ( ui32Filter ) {
-					case LSI_PF_NONE : {
-						pui8Cur[K] = pui8Raw[K];
-						break;
-					}
+#ifdef LSSTD_SIMD_SSE2
+		if ( _ui32Bpp >= 3 ) {
+			// One pixel at a time with each byte in a 16-bit lane.  Bytes past the pixel are read but never stored;
+			//	the rows are padded for this.  The pixel to the left (A) and above-left (C) stay in registers.
+			const __m128i mZero = _mm_setzero_si128();
+			__m128i mA = mZero, mC = mZero;
+			for ( ; I < _ui32Bytes; I += _ui32Bpp ) {
+				__m128i mX = _mm_unpacklo_epi8( _mm_loadl_epi64( reinterpret_cast<const __m128i *>(_pui8Cur + I) ), mZero );
+				__m128i mB = _mm_unpacklo_epi8( _mm_loadl_epi64( reinterpret_cast<const __m128i *>(_pui8Prev + I) ), mZero );
+				switch ( _ui32Filter ) {
 					case LSI_PF_SUB : {
-						pui8Cur[K] = pui8Raw[K];
-						break;
-					}
-					case LSI_PF_UP : {
-						pui8Cur[K] = pui8Raw[K] + pui8Prev[K];
+						mX = _mm_add_epi16( mX, mA );
 						break;
 					}
 					case LSI_PF_AVG : {
-						pui8Cur[K] = pui8Raw[K] + (pui8Prev[K] >> 1);
+						mX = _mm_add_epi16( mX, _mm_srli_epi16( _mm_add_epi16( mA, mB ), 1 ) );
 						break;
 					}
-					case LSI_PF_PAETH : {
-						pui8Cur[K] = static_cast<uint8_t>(pui8Raw[K] + Paeth( 0, pui8Prev[K], 0 ));
-						break;
+					default : {
+						// |B - C|, |A - C|, and |A + B - 2C|.
+						__m128i mPa = _mm_sub_epi16( mB, mC );
+						__m128i mPb = _mm_sub_epi16( mA, mC );
+						__m128i mPc = _mm_add_epi16( mPa, mPb );
+						mPa = _mm_max_epi16( mPa, _mm_sub_epi16( mZero, mPa ) );
+						mPb = _mm_max_epi16( mPb, _mm_sub_epi16( mZero, mPb ) );
+						mPc = _mm_max_epi16( mPc, _mm_sub_epi16( mZero, mPc ) );
+						__m128i mMin = _mm_min_epi16( _mm_min_epi16( mPa, mPb ), mPc );
+						// C unless B is the smallest, then A if it is the smallest.
+						__m128i mMask = _mm_cmpeq_epi16( mPb, mMin );
+						__m128i mPred = _mm_or_si128( _mm_and_si128( mMask, mB ), _mm_andnot_si128( mMask, mC ) );
+						mMask = _mm_cmpeq_epi16( mPa, mMin );
+						mPred = _mm_or_si128( _mm_and_si128( mMask, mA ), _mm_andnot_si128( mMask, mPred ) );
+						mX = _mm_add_epi16( mX, mPred );
 					}
 				}
+				mA = _mm_and_si128( mX, _mm_set1_epi16( 0xFF ) );
+				mC = mB;
+
+				// Store only the bytes of this pixel.
+				uint64_t ui64Pixel;
+				_mm_storel_epi64( reinterpret_cast<__m128i *>(&ui64Pixel), _mm_packus_epi16( mA, mZero ) );
+				CStd::MemCpy( _pui8Cur + I, &ui64Pixel, _ui32Bpp );
 			}
-			pui8Raw += _pfFinal.ui32Components;
-			pui8Cur += _pfFinal.ui32Components;
-			pui8Prev += _pfFinal.ui32Components;
-
-			uint32_t I;
-			switch ( ui32Filter ) {
-				case LSI_PF_NONE : {
-					for ( I = _pfFinal.ui32X - 1; I >= 1; --I,
-						pui8Raw += _pfFinal.ui32Components,
-						pui8Cur += _pfFinal.ui32Components,
-						pui8Prev += _pfFinal.ui32Components ) {
-						for ( K = 0; K < _pfFinal.ui32Components; ++K ) {
-							pui8Cur[K] = pui8Raw[K];
-						}
-					}
-					break;
-				}
-				case LSI_PF_SUB : {
-					for ( I = _pfFinal.ui32X - 1; I >= 1; --I,
-						pui8Raw += _pfFinal.ui32Components,
-						pui8Cur += _pfFinal.ui32Components,
-						pui8Prev += _pfFinal.ui32Components ) {
-						for ( K = 0; K < _pfFinal.ui32Components; ++K ) {
-							pui8Cur[K] = pui8Raw[K] + pui8Cur[static_cast<uintptr_t>(K)-static_cast<uintptr_t>(_pfFinal.ui32Components)];
-						}
-					}
-					break;
-				}
-				case LSI_PF_UP : {
-					for ( I = _pfFinal.ui32X - 1; I >= 1; --I,
-						pui8Raw += _pfFinal.ui32Components,
-						pui8Cur += _pfFinal.ui32Components,
-						pui8Prev += _pfFinal.ui32Components ) {
-						for ( K = 0; K < _pfFinal.ui32Components; ++K ) {
-							pui8Cur[K] = pui8Raw[K] + pui8Prev[K];
-						}
-					}
-					break;
+			return true;
+		}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+
+		// The first pixel has nothing to its left.
+		for ( ; I < _ui32Bpp && I < _ui32Bytes; ++I ) {
+			if ( _ui32Filter == LSI_PF_AVG ) { _pui8Cur[I] = static_cast<uint8_t>(_pui8Cur[I] + (_pui8Prev[I] >> 1)); }
+			else if ( _ui32Filter == LSI_PF_PAETH ) { _pui8Cur[I] = static_cast<uint8_t>(_pui8Cur[I] + _pui8Prev[I]); }
+		}
+		switch ( _ui32Filter ) {
+			case LSI_PF_SUB : {
+				for ( ; I < _ui32Bytes; ++I ) {
+					_pui8Cur[I] = static_cast<uint8_t>(_pui8Cur[I] + _pui8Cur[I-_ui32Bpp]);
 				}
-				case LSI_PF_AVG : {
-					for ( I = _pfFinal.ui32X - 1; I >= 1; --I,
-						pui8Raw += _pfFinal.ui32Components,
-						pui8Cur += _pfFinal.ui32Components,
-						pui8Prev += _pfFinal.ui32Components ) {
-						for ( K = 0; K < _pfFinal.ui32Components; ++K ) {
-							pui8Cur[K] = pui8Raw[K] + ((pui8Prev[K] + pui8Cur[static_cast<uintptr_t>(K)-static_cast<uintptr_t>(_pfFinal.ui32Components)]) >> 1);
-						}
-					}
-					break;
+				break;
+			}
+			case LSI_PF_AVG : {
+				for ( ; I < _ui32Bytes; ++I ) {
+					_pui8Cur[I] = static_cast<uint8_t>(_pui8Cur[I] + ((_pui8Cur[I-_ui32Bpp] + _pui8Prev[I]) >> 1));
 				}
-				case LSI_PF_PAETH : {
-					for ( I = _pfFinal.ui32X - 1; I >= 1; --I,
-						pui8Raw += _pfFinal.ui32Components,
-						pui8Cur += _pfFinal.ui32Components,
-						pui8Prev += _pfFinal.ui32Components ) {
-						for ( K = 0; K < _pfFinal.ui32Components; ++K ) {
-							pui8Cur[K] = static_cast<uint8_t>(pui8Raw[K] + Paeth( pui8Cur[static_cast<uintptr_t>(K)-static_cast<uintptr_t>(_pfFinal.ui32Components)], pui8Prev[K], pui8Prev[static_cast<uintptr_t>(K)-static_cast<uintptr_t>(_pfFinal.ui32Components)] ));
-						}
-					}
-					break;
+				break;
+			}
+			default : {
+				for ( ; I < _ui32Bytes; ++I ) {
+					_pui8Cur[I] = static_cast<uint8_t>(_pui8Cur[I] + Paeth( _pui8Cur[I-_ui32Bpp], _pui8Prev[I], _pui8Prev[I-_ui32Bpp] ));
 				}
 			}
 		}
-
-
 		return true;
 	}
 
 	/**
-	 * Create the final image data from decompressed PNG data.
+	 * Writes the current unfiltered row to the output buffer, converting it to the output format.
 	 *
-	 * \param _pfFinal Parameters.
-	 * \param _tbReturn The output of the processing.
-	 * \param _bInterlaced If true, the interlace decoder is used.
-	 * \return Returns true if there is enough memory to allocate the final buffer.
+	 * \param _pdDecode The decoding state.
+	 * \return Returns false if a palette index is out of range.
 	 */
-	LSBOOL LSE_CALL CPng::CreatePng( LSI_PNG_FINAL &_pfFinal, CImageLib::CTexelBuffer &_tbReturn, LSBOOL _bInterlaced ) {
-		if ( !_bInterlaced ) { return CreatePng( _pfFinal, _tbReturn ); }
-
-		CImageLib::CTexelBuffer tbTemp;
-		if ( !_tbReturn.Resize( _pfFinal.ui32Width * _pfFinal.ui32Height * _pfFinal.ui32Components ) ) { return false; }
-
+	LSBOOL LSE_CALL CPng::StoreRow( LSI_PNG_DECODE &_pdDecode ) {
 		static const uint32_t ui32OrigX[] = { 0, 4, 0, 2, 0, 1, 0 };
 		static const uint32_t ui32OrigY[] = { 0, 0, 4, 0, 2, 0, 1 };
 		static const uint32_t ui32SpaceX[]  = { 8, 8, 4, 4, 2, 2, 1 };
 		static const uint32_t ui32SpaceY[]  = { 8, 8, 8, 4, 4, 2, 2 };
 
-		for ( uint32_t I = 0; I < 7UL; ++I ) {
-			_pfFinal.ui32X = (_pfFinal.ui32Width - ui32OrigX[I] + ui32SpaceX[I] - 1) / ui32SpaceX[I];
-			_pfFinal.ui32Y = (_pfFinal.ui32Height - ui32OrigY[I] + ui32SpaceY[I] - 1) / ui32SpaceY[I];
-
-			if ( _pfFinal.ui32X && _pfFinal.ui32Y ) {
-				if ( !CreatePng( _pfFinal, tbTemp ) ) { return false; }
-				for ( uint32_t Y = 0; Y < _pfFinal.ui32Y; ++Y ) {
-					for ( uint32_t X = 0; X < _pfFinal.ui32X; ++X ) {
-						CStd::MemCpy( &_tbReturn[0] + (Y * ui32SpaceY[I] + ui32OrigY[I]) * _pfFinal.ui32Width * _pfFinal.ui32Components +
-							(X * ui32SpaceX[I] + ui32OrigX[I]) * _pfFinal.ui32Components,
-							&tbTemp[0] + (Y * _pfFinal.ui32X + X) * _pfFinal.ui32Components,
-							_pfFinal.ui32Components );
+		uint32_t ui32X = 0, ui32Y = _pdDecode.ui32Row, ui32Space = 1;
+		if ( _pdDecode.bInterlaced ) {
+			uint32_t P = _pdDecode.ui32Pass;
+			ui32X = ui32OrigX[P];
+			ui32Y = ui32OrigY[P] + ui32Y * ui32SpaceY[P];
+			ui32Space = ui32SpaceX[P];
+		}
+		const uint8_t * pui8Src = _pdDecode.pui8Cur;
+		uint8_t * pui8Dst = _pdDecode.pui8Dst + (static_cast<uintptr_t>(ui32Y) * _pdDecode.ui32Width + ui32X) * _pdDecode.ui32TexelSize;
+		uint32_t ui32Step = ui32Space * _pdDecode.ui32TexelSize;
+		uint32_t ui32Total = _pdDecode.ui32PassWidth;
+		// Native order is the reverse of PNG order: B, G, R for RGB and A, B, G, R for RGBA.  CgBI images are
+		//	already stored B, G, R(, A).
+		uint32_t ui32R = _pdDecode.bBgr ? 2 : 0, ui32B = 2 - ui32R;
+
+		// Fast paths for the most common formats.
+		if ( _pdDecode.ui32Depth == 8 && !_pdDecode.bTrns ) {
+			if ( _pdDecode.ui32Color == LSI_PCT_RGBA ) {
+				uint32_t I = 0;
+				if ( !_pdDecode.bBgr && ui32Space == 1 ) {
+#ifdef LSSTD_SIMD_SSE2
+					// Reverse the bytes in each 32-bit lane.
+					for ( ; I + 4 <= ui32Total; I += 4 ) {
+						__m128i mThis = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src + I * 4) );
+						mThis = _mm_or_si128( _mm_slli_epi16( mThis, 8 ), _mm_srli_epi16( mThis, 8 ) );
+						mThis = _mm_shufflelo_epi16( _mm_shufflehi_epi16( mThis, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _MM_SHUFFLE( 2, 3, 0, 1 ) );
+						_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst + I * 4), mThis );
 					}
+#endif	// #ifdef LSSTD_SIMD_SSE2
 				}
-
-				_pfFinal.puiRawData += (_pfFinal.ui32X * _pfFinal.ui32Components + 1) * _pfFinal.ui32Y;
-				_pfFinal.ui32RawLen -= (_pfFinal.ui32X * _pfFinal.ui32Components + 1) * _pfFinal.ui32Y;
+				for ( ; I < ui32Total; ++I ) {
+					const uint8_t * pui8This = pui8Src + I * 4;
+					uint8_t * pui8Out = pui8Dst + I * ui32Step;
+					pui8Out[0] = pui8This[3];
+					pui8Out[1] = pui8This[ui32B];
+					pui8Out[2] = pui8This[1];
+					pui8Out[3] = pui8This[ui32R];
+				}
+				return true;
+			}
+			if ( _pdDecode.ui32Color == LSI_PCT_RGB ) {
+				for ( uint32_t I = 0; I < ui32Total; ++I, pui8Src += 3, pui8Dst += ui32Step ) {
+					pui8Dst[0] = pui8Src[ui32B];
+					pui8Dst[1] = pui8Src[1];
+					pui8Dst[2] = pui8Src[ui32R];
+				}
+				return true;
+			}
+			if ( _pdDecode.ui32Color == LSI_PCT_GRAY ) {
+				for ( uint32_t I = 0; I < ui32Total; ++I, pui8Dst += ui32Step ) {
+					pui8Dst[0] = pui8Dst[1] = pui8Dst[2] = pui8Src[I];
+				}
+				return true;
 			}
 		}
-
-		return true;
-	}
-
-	/**
-	 * Expand the color data with the data in the given palette.
-	 *
-	 * \param _tbReturn The buffer to expand in-place.
-	 * \param _pui8Palette The palette.
-	 * \param _ui32Len Length of the palette.
-	 * \param _ui32Width Width of the image.
-	 * \param _ui32Height Height of the image.
-	 * \param _ui32Components Components in the image.
-	 * \param _bSwapRB If true, the R and B components of the palette are swapped as they are placed into the image buffer.
-	 * \return Returns true if there is enough memory to expand the buffer and if none of the indices refence above
-	 *	or equal to _ui32Len.
-	 */
-	LSBOOL LSE_CALL CPng::ExpandPalette( CImageLib::CTexelBuffer &_tbReturn, const uint8_t * _pui8Palette, uint32_t _ui32Len,
-		uint32_t _ui32Width, uint32_t _ui32Height, uint32_t _ui32Components, LSBOOL _bSwapRB ) {
-		uint32_t ui32Orig = _tbReturn.Length();
-		if ( !_tbReturn.Resize( _ui32Width * _ui32Height * _ui32Components ) ) { return false; }
-		_ui32Len *= 4;
-		uint8_t * pui8Dest = &_tbReturn[0] + _tbReturn.Length();
-
-		uint32_t ui32R = _bSwapRB ? 2 : 0;
-		uint32_t ui32B = _bSwapRB ? 0 : 2;
-		if ( _ui32Components == 3 ) {
-			for ( uint32_t I = ui32Orig; I--; ) {
-				pui8Dest -= 3;
-				uint32_t ui32Index = static_cast<uint32_t>(_tbReturn[I]) << 2;
-				if ( ui32Index >= _ui32Len ) { return false; }
-				pui8Dest[0] = _pui8Palette[ui32Index+ui32R];
-				pui8Dest[1] = _pui8Palette[ui32Index+1];
-				pui8Dest[2] = _pui8Palette[ui32Index+ui32B];
-
+		if ( _pdDecode.ui32Depth == 8 && _pdDecode.ui32Color == LSI_PCT_PALETTE ) {
+			const uint8_t * pui8Pal = _pdDecode.ui8Palette;
+			LSBOOL bAlpha = _pdDecode.pfFormat == LSI_PF_R8G8B8A8;
+			for ( uint32_t I = 0; I < ui32Total; ++I, pui8Dst += ui32Step ) {
+				uint32_t ui32Index = pui8Src[I];
+				if ( ui32Index >= _pdDecode.ui32PalLen ) { return false; }
+				const uint8_t * pui8This = &pui8Pal[ui32Index<<2];
+				if ( bAlpha ) {
+					pui8Dst[0] = pui8This[3];
+					pui8Dst[1] = pui8This[2];
+					pui8Dst[2] = pui8This[1];
+					pui8Dst[3] = pui8This[0];
+				}
+				else {
+					pui8Dst[0] = pui8This[2];
+					pui8Dst[1] = pui8This[1];
+					pui8Dst[2] = pui8This[0];
+				}
 			}
+			return true;
 		}
-		else {
-			for ( uint32_t I = ui32Orig; I--; ) {
-				pui8Dest -= 4;
-				uint32_t ui32Index = static_cast<uint32_t>(_tbReturn[I]) << 2;
-				if ( ui32Index >= _ui32Len ) { return false; }
-				pui8Dest[0] = _pui8Palette[ui32Index+3];
-				pui8Dest[1] = _pui8Palette[ui32Index+ui32R];
-				pui8Dest[2] = _pui8Palette[ui32Index+1];
-				pui8Dest[3] = _pui8Palette[ui32Index+ui32B];
 
+		// The general case, one sample at a time.
+		uint32_t ui32Depth = _pdDecode.ui32Depth;
+		uint32_t ui32Max = (1UL << ui32Depth) - 1UL;
+		// Scales samples of 1, 2, and 4 bits up to 8 bits.  Palette indices are not scaled.
+		uint32_t ui32Scale = ui32Depth < 8 && _pdDecode.ui32Color != LSI_PCT_PALETTE ? 0xFF / ui32Max : 1;
+		uint32_t ui32Bit = 0;
+#define LSI_SAMPLE()			(ui32Depth == 8 ? pui8Src[ui32Bit>>3] :																\
+	(ui32Depth == 16 ? ((pui8Src[ui32Bit>>3] << 8) | pui8Src[(ui32Bit>>3)+1]) :															\
+	((pui8Src[ui32Bit>>3] >> (8 - ui32Depth - (ui32Bit & 7))) & ui32Max)))
+		for ( uint32_t I = 0; I < ui32Total; ++I, pui8Dst += ui32Step ) {
+			uint32_t ui32Rgba[4];
+			switch ( _pdDecode.ui32Color ) {
+				case LSI_PCT_GRAY : {
+					uint32_t ui32Gray = LSI_SAMPLE();
+					ui32Bit += ui32Depth;
+					ui32Rgba[0] = ui32Rgba[1] = ui32Rgba[2] = ui32Gray;
+					ui32Rgba[3] = (_pdDecode.bTrns && ui32Gray == _pdDecode.ui16Trns[0]) ? 0 : ui32Max;
+					break;
+				}
+				case LSI_PCT_RGB : {
+					for ( uint32_t J = 0; J < 3; ++J, ui32Bit += ui32Depth ) {
+						ui32Rgba[J] = LSI_SAMPLE();
+					}
+					ui32Rgba[3] = (_pdDecode.bTrns && ui32Rgba[0] == _pdDecode.ui16Trns[0] &&
+						ui32Rgba[1] == _pdDecode.ui16Trns[1] && ui32Rgba[2] == _pdDecode.ui16Trns[2]) ? 0 : ui32Max;
+					break;
+				}
+				case LSI_PCT_PALETTE : {
+					uint32_t ui32Index = LSI_SAMPLE();
+					ui32Bit += ui32Depth;
+					if ( ui32Index >= _pdDecode.ui32PalLen ) { return false; }
+					for ( uint32_t J = 0; J < 4; ++J ) {
+						ui32Rgba[J] = _pdDecode.ui8Palette[(ui32Index<<2)+J];
+					}
+					break;
+				}
+				case LSI_PCT_GRAY_ALPHA : {
+					ui32Rgba[0] = ui32Rgba[1] = ui32Rgba[2] = LSI_SAMPLE();
+					ui32Bit += ui32Depth;
+					ui32Rgba[3] = LSI_SAMPLE();
+					ui32Bit += ui32Depth;
+					break;
+				}
+				default : {
+					for ( uint32_t J = 0; J < 4; ++J, ui32Bit += ui32Depth ) {
+						ui32Rgba[J] = LSI_SAMPLE();
+					}
+				}
 			}
-		}
-		return true;
-	}
 
-	/**
-	 * Swap the RGB colors in the given buffer.
-	 *
-	 * \param _tbBuffer Buffer of colors to fix.
-	 * \param _ui32Components Number of components.
-	 */
-	void LSE_CALL CPng::FixColors( CImageLib::CTexelBuffer &_tbBuffer, uint32_t _ui32Components ) {
-		if ( _ui32Components == 1 ) { return; }
-		if ( _ui32Components == 4 ) {
-			for ( uint32_t I = 0; I < _tbBuffer.Length(); I += 4 ) {
-				(*reinterpret_cast<uint32_t *>(&_tbBuffer[I])) = CStd::ByteSwap32( (*reinterpret_cast<uint32_t *>(&_tbBuffer[I])) );
+			if ( ui32Depth == 16 ) {
+				uint16_t * pui16Dst = reinterpret_cast<uint16_t *>(pui8Dst);
+				pui16Dst[0] = static_cast<uint16_t>(ui32Rgba[3]);
+				pui16Dst[1] = static_cast<uint16_t>(ui32Rgba[ui32B]);
+				pui16Dst[2] = static_cast<uint16_t>(ui32Rgba[1]);
+				pui16Dst[3] = static_cast<uint16_t>(ui32Rgba[ui32R]);
 			}
-		}
-		else {
-			for ( uint32_t I = 0; I < _tbBuffer.Length(); I += _ui32Components ) {
-				uint8_t ui8This = _tbBuffer[I+0];
-				_tbBuffer[I+0] = _tbBuffer[I+2];
-				_tbBuffer[I+2] = ui8This;
+			else if ( _pdDecode.pfFormat == LSI_PF_R8G8B8A8 ) {
+				pui8Dst[0] = static_cast<uint8_t>(ui32Rgba[3] * ui32Scale);
+				pui8Dst[1] = static_cast<uint8_t>(ui32Rgba[ui32B] * ui32Scale);
+				pui8Dst[2] = static_cast<uint8_t>(ui32Rgba[1] * ui32Scale);
+				pui8Dst[3] = static_cast<uint8_t>(ui32Rgba[ui32R] * ui32Scale);
+			}
+			else {
+				pui8Dst[0] = static_cast<uint8_t>(ui32Rgba[ui32B] * ui32Scale);
+				pui8Dst[1] = static_cast<uint8_t>(ui32Rgba[1] * ui32Scale);
+				pui8Dst[2] = static_cast<uint8_t>(ui32Rgba[ui32R] * ui32Scale);
 			}
 		}
+#undef LSI_SAMPLE
+		return true;
 	}
 
 	/**
@@ -524,25 +629,4 @@ namespace lsi {
 		_ebsStream.SetPos( _ebsStream.GetPos() + _ui32Length );
 	}
 
-	/**
-	 * Perform a PAETH filter.
-	 *
-	 * \param _i32A A.
-	 * \param _i32B B.
-	 * \param _i32C C.
-	 * \return Returns happiness.
-	 */
-	int32_t LSE_CALL CPng::Paeth( int32_t _i32A, int32_t _i32B, int32_t _i32C ) {
-		int32_t i32P = _i32A + _i32B - _i32C;
-#define LSI_ABS( VAL )		(VAL) > 0 ? (VAL) : -(VAL)
-		int32_t i32Pa = LSI_ABS( i32P - _i32A );
-		int32_t i32Pb = LSI_ABS( i32P - _i32B );
-		int32_t i32Pc = LSI_ABS( i32P - _i32C );
-		if ( i32Pa < i32Pb && i32Pa <= i32Pc ) { return _i32A; }
-		if ( i32Pb <= i32Pc ) { return _i32B; }
-
-		return _i32C;
-#undef LSI_ABS
-	}
-
 }	// namespace lsi
@@ -9,7 +9,9 @@
  *	You may not take credit for having written this code.
  *
  *
- * Description: Handles the loading of 8-bit PNG files.
+ * Description: Handles the loading of PNG files.  All color types, bit depths, and interlacing are supported.
+ *	Image data is inflated and unfiltered a row at a time as the IDAT chunks are read, and each row is written
+ *	straight to the returned buffer in the native format.
  */
 
 
@@ -19,13 +21,23 @@
 #include "../LSIImageLib.h"
 #include "Streams/LSSTDExternalByteStream.h"
 
+namespace lsc {
+	class								CZLibStreamDecoder;
+}
+
 namespace lsi {
 
 	/**
 	 * Class CPng
-	 * \brief Handles the loading of 8-bit PNG files.
+	 * \brief Handles the loading of PNG files.
+	 *
+	 * Description: Handles the loading of PNG files.  All color types, bit depths, and interlacing are supported.
+	 *	Image data is inflated and unfiltered a row at a time as the IDAT chunks are read, and each row is written
+	 *	straight to the returned buffer in the native format.
 	 *
-	 * Description: Handles the loading of 8-bit PNG files.
+	 * Images with 16 bits per channel are returned as LSI_PF_R16G16B16A16.  Otherwise images with an alpha channel
+	 *	or transparency (tRNS) are returned as LSI_PF_R8G8B8A8 and opaque images as LSI_PF_R8G8B8.  Grayscale values
+	 *	are copied to R, G, and B.
 	 */
 	class CPng {
 	public :
@@ -49,14 +61,26 @@ namespace lsi {
 
 	protected :
 		// == Enumerations.
+		/**
+		 * Row filters.
+		 */
 		enum LSI_PNG_FILTER {
 			LSI_PF_NONE,
 			LSI_PF_SUB,
 			LSI_PF_UP,
 			LSI_PF_AVG,
 			LSI_PF_PAETH,
-			LSI_PF_AVG_FIRST,
-			LSI_PF_PAETH_FIRST,
+		};
+
+		/**
+		 * Color types.
+		 */
+		enum LSI_PNG_COLOR_TYPE {
+			LSI_PCT_GRAY					= 0,
+			LSI_PCT_RGB						= 2,
+			LSI_PCT_PALETTE					= 3,
+			LSI_PCT_GRAY_ALPHA				= 4,
+			LSI_PCT_RGBA					= 6,
 		};
 
 
@@ -77,9 +101,9 @@ namespace lsi {
 		} * LPLSI_PNG_CHUNK, * const LPCLSI_PNG_CHUNK;
 
 		/**
-		 * For composing the final PNG structure.
+		 * The state of the image data as it is decoded.
 		 */
-		typedef struct LSI_PNG_FINAL {
+		typedef struct LSI_PNG_DECODE {
 			/**
 			 * Width of the image.
 			 */
@@ -91,36 +115,110 @@ namespace lsi {
 			uint32_t					ui32Height;
 
 			/**
-			 * X value.
+			 * Bits per sample.
 			 */
-			uint32_t					ui32X;
+			uint32_t					ui32Depth;
 
 			/**
-			 * Y value.
+			 * The color type.
 			 */
-			uint32_t					ui32Y;
+			uint32_t					ui32Color;
 
 			/**
-			 * Pointer to the raw data.
+			 * Samples per pixel.
 			 */
-			uint8_t *					puiRawData;
+			uint32_t					ui32Channels;
 
 			/**
-			 * Length of the raw data.
+			 * Bytes per complete pixel, at least 1.  Filters refer to the byte this far to the left.
 			 */
-			uint32_t					ui32RawLen;
+			uint32_t					ui32Bpp;
 
 			/**
-			 * Components.
+			 * If true, the image is interlaced.
 			 */
-			uint32_t					ui32Components;
-		} * LPLSI_PNG_FINAL, * const LPCLSI_PNG_FINAL;
+			LSBOOL						bInterlaced;
 
-		// == Members.
-		/**
-		 * Translates from a standard filter to a first-row filter.
-		 */
-		static LSI_PNG_FILTER			m_pfFirstRowFilter[];
+			/**
+			 * If true, the image is an Apple CgBI image, whose data is raw deflate in BGR order.
+			 */
+			LSBOOL						bBgr;
+
+			/**
+			 * The current interlace pass, or 7 when all rows have been decoded.
+			 */
+			uint32_t					ui32Pass;
+
+			/**
+			 * Width of the current pass.
+			 */
+			uint32_t					ui32PassWidth;
+
+			/**
+			 * Height of the current pass.
+			 */
+			uint32_t					ui32PassHeight;
+
+			/**
+			 * Bytes in each row of the current pass, not counting the filter byte.
+			 */
+			uint32_t					ui32RowBytes;
+
+			/**
+			 * The current row in the current pass.
+			 */
+			uint32_t					ui32Row;
+
+			/**
+			 * Bytes of the current row decoded so far, including the filter byte.
+			 */
+			uint32_t					ui32Filled;
+
+			/**
+			 * The row being decoded.  The filter byte is at index -1.
+			 */
+			uint8_t *					pui8Cur;
+
+			/**
+			 * The previous unfiltered row of the current pass.
+			 */
+			uint8_t *					pui8Prev;
+
+			/**
+			 * The palette, 4 bytes (RGBA) per entry.
+			 */
+			uint8_t						ui8Palette[256*4];
+
+			/**
+			 * Number of entries in the palette.
+			 */
+			uint32_t					ui32PalLen;
+
+			/**
+			 * If true, ui16Trns holds the transparent color of a grayscale or RGB image.
+			 */
+			LSBOOL						bTrns;
+
+			/**
+			 * The transparent color.
+			 */
+			uint16_t					ui16Trns[3];
+
+			/**
+			 * The output format.
+			 */
+			LSI_PIXEL_FORMAT			pfFormat;
+
+			/**
+			 * Bytes per output texel.
+			 */
+			uint32_t					ui32TexelSize;
+
+			/**
+			 * The output buffer.
+			 */
+			uint8_t *					pui8Dst;
+		} * LPLSI_PNG_DECODE, * const LPCLSI_PNG_DECODE;
 
 
 		// == Functions.
@@ -144,47 +242,47 @@ namespace lsi {
 		static LSBOOL LSE_CALL			NextChunk( const CExternalByteStream &_ebsStream, LSI_PNG_CHUNK &_pcChunk );
 
 		/**
-		 * Create the final image data from decompressed PNG data.  Image data must not be interlaced.
+		 * Inflates the data of an IDAT chunk, unfiltering and storing each row as it is completed.
 		 *
-		 * \param _pfFinal Parameters.
-		 * \param _tbReturn The output of the processing.
-		 * \return Returns true if there is enough memory to allocate the final buffer.
+		 * \param _pdDecode The decoding state.
+		 * \param _zsdInflate The inflater, which keeps its state from one IDAT chunk to the next.
+		 * \param _pui8Data The data of the chunk.
+		 * \param _ui32Length Length of the data of the chunk.
+		 * \return Returns false if the data is invalid.
 		 */
-		static LSBOOL LSE_CALL			CreatePng( LSI_PNG_FINAL &_pfFinal, CImageLib::CTexelBuffer &_tbReturn );
+		static LSBOOL LSE_CALL			DecodeData( LSI_PNG_DECODE &_pdDecode, lsc::CZLibStreamDecoder &_zsdInflate,
+			const uint8_t * _pui8Data, uint32_t _ui32Length );
 
 		/**
-		 * Create the final image data from decompressed PNG data.
+		 * Prepares the given interlace pass, skipping passes that contain no pixels.  Non-interlaced images have
+		 *	only pass 0.
 		 *
-		 * \param _pfFinal Parameters.
-		 * \param _tbReturn The output of the processing.
-		 * \param _bInterlaced If true, the interlace decoder is used.
-		 * \return Returns true if there is enough memory to allocate the final buffer.
+		 * \param _pdDecode The decoding state.
+		 * \param _ui32Pass The pass to begin.
 		 */
-		static LSBOOL LSE_CALL			CreatePng( LSI_PNG_FINAL &_pfFinal, CImageLib::CTexelBuffer &_tbReturn, LSBOOL _bInterlaced );
+		static void LSE_CALL			BeginPass( LSI_PNG_DECODE &_pdDecode, uint32_t _ui32Pass );
 
 		/**
-		 * Expand the color data with the data in the given palette.
+		 * Unfilters a row in place.
 		 *
-		 * \param _tbReturn The buffer to expand in-place.
-		 * \param _pui8Palette The palette.
-		 * \param _ui32Len Length of the palette.
-		 * \param _ui32Width Width of the image.
-		 * \param _ui32Height Height of the image.
-		 * \param _ui32Components Components in the image.
-		 * \param _bSwapRB If true, the R and B components of the palette are swapped as they are placed into the image buffer.
-		 * \return Returns true if there is enough memory to expand the buffer and if none of the indices refence above
-		 *	or equal to _ui32Len.
+		 * \param _ui32Filter The filter applied to the row.
+		 * \param _pui8Cur The row to unfilter.
+		 * \param _pui8Prev The previous unfiltered row, or all 0's for the first row of a pass.  Must be readable for 16
+		 *	bytes past _ui32Bytes, as must _pui8Cur.
+		 * \param _ui32Bytes Bytes in the row.
+		 * \param _ui32Bpp Bytes per complete pixel, at least 1.
+		 * \return Returns false if the filter is invalid.
 		 */
-		static LSBOOL LSE_CALL			ExpandPalette( CImageLib::CTexelBuffer &_tbReturn, const uint8_t * _pui8Palette, uint32_t _ui32Len,
-			uint32_t _ui32Width, uint32_t _ui32Height, uint32_t _ui32Components, LSBOOL _bSwapRB );
+		static LSBOOL LSE_CALL			Unfilter( uint32_t _ui32Filter, uint8_t * _pui8Cur, const uint8_t * _pui8Prev,
+			uint32_t _ui32Bytes, uint32_t _ui32Bpp );
 
 		/**
-		 * Swap the RGB colors in the given buffer.
+		 * Writes the current unfiltered row to the output buffer, converting it to the output format.
 		 *
-		 * \param _tbBuffer Buffer of colors to fix.
-		 * \param _ui32Components Number of components.
+		 * \param _pdDecode The decoding state.
+		 * \return Returns false if a palette index is out of range.
 		 */
-		static void LSE_CALL			FixColors( CImageLib::CTexelBuffer &_tbBuffer, uint32_t _ui32Components );
+		static LSBOOL LSE_CALL			StoreRow( LSI_PNG_DECODE &_pdDecode );
 
 		/**
 		 * Reads a single 8-bit value from the given stream.
@@ -224,14 +322,40 @@ namespace lsi {
 		/**
 		 * Perform a PAETH filter.
 		 *
-		 * \param _i32A A.
-		 * \param _i32B B.
-		 * \param _i32C C.
-		 * \return Returns happiness.
+		 * \param _i32A The byte to the left.
+		 * \param _i32B The byte above.
+		 * \param _i32C The byte above and to the left.
+		 * \return Returns whichever of the 3 bytes is closest to A + B - C, preferring A, then B.
 		 */
-		static int32_t LSE_CALL			Paeth( int32_t _i32A, int32_t _i32B, int32_t _i32C );
+		static LSE_INLINE int32_t LSE_CALL
+										Paeth( int32_t _i32A, int32_t _i32B, int32_t _i32C );
 	};
 
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Perform a PAETH filter.
+	 *
+	 * \param _i32A The byte to the left.
+	 * \param _i32B The byte above.
+	 * \param _i32C The byte above and to the left.
+	 * \return Returns whichever of the 3 bytes is closest to A + B - C, preferring A, then B.
+	 */
+	LSE_INLINE int32_t LSE_CALL CPng::Paeth( int32_t _i32A, int32_t _i32B, int32_t _i32C ) {
+		int32_t i32Pa = _i32B - _i32C;
+		int32_t i32Pb = _i32A - _i32C;
+		int32_t i32Pc = i32Pa + i32Pb;
+		if ( i32Pa < 0 ) { i32Pa = -i32Pa; }
+		if ( i32Pb < 0 ) { i32Pb = -i32Pb; }
+		if ( i32Pc < 0 ) { i32Pc = -i32Pc; }
+		if ( i32Pa <= i32Pb && i32Pa <= i32Pc ) { return _i32A; }
+		if ( i32Pb <= i32Pc ) { return _i32B; }
+		return _i32C;
+	}
+
 }	// namespace lsi
 
 #endif	// __LSI_PNG_H__
@@ -0,0 +1,792 @@
+/**
+ * Copyright L. Spiro 2021
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: SIMD kernels for the most common texel conversions performed by CImageLib.  The kernels produce
+ *	exactly the same bits as the generic per-texel converters and are selected at run-time from the instruction
+ *	sets the CPU supports.
+ */
+
+#include "LSISimdConvert.h"
+
+#ifdef LSSTD_SIMD_SSE2
+#include <emmintrin.h>
+#include <immintrin.h>
+#elif defined( LSSTD_SIMD_NEON )
+#include <arm_neon.h>
+#endif	// #ifdef LSSTD_SIMD_SSE2
+
+#if defined( LSSTD_SIMD_NEON ) && (defined( __aarch64__ ) || defined( _M_ARM64 ))
+/** 64-bit ARM, which adds a vector divide to NEON. */
+#define LSI_SIMD_NEON64
+#endif	// #if defined( LSSTD_SIMD_NEON ) && (defined( __aarch64__ ) || defined( _M_ARM64 ))
+
+
+namespace lsi {
+
+	// == Members.
+	/** The selected kernels.  NULL where the CPU has no kernel. */
+	CSimdConvert::PfKernel CSimdConvert::m_pfKernels[LSI_SK_TOTAL] = { NULL };
+
+	/** The selected byte-permutation kernel. */
+	CSimdConvert::PfPermute CSimdConvert::m_pfPermute = CSimdConvert::PermuteScalar;
+
+	/** LSI_PF_R8G8B8A8 components to floats, indexed by LSI_G_sRGB, LSI_G_LINEAR, and then 2 for no conversion. */
+	float CSimdConvert::m_fRgba8ToRgba32F[3][256];
+
+	/** LSI_PF_R8G8B8A8 color components to LSI_PF_R8G8B8A8 color components, indexed by LSI_G_sRGB and
+	 *	LSI_G_LINEAR. */
+	uint8_t CSimdConvert::m_ui8Rgba8ToRgba8[2][256];
+
+	/** The smallest float color component that converts to each LSI_PF_R8G8B8A8 value, indexed by LSI_G_sRGB and
+	 *	LSI_G_LINEAR.  Entry 0 is not used and entry 256, like any value that is never reached, is above 1. */
+	float CSimdConvert::m_fRgba32FToRgba8[2][257];
+
+	/** The LSI_PF_R8G8B8A8 value of the start of each of the LSI_SIMD_GAMMA_RANGES ranges from 0 to 1, plus 1
+	 *	itself, indexed by LSI_G_sRGB and LSI_G_LINEAR. */
+	uint8_t CSimdConvert::m_ui8Rgba32FToRgba8Start[2][LSI_SIMD_GAMMA_RANGES+1];
+
+	/** Set when the kernels are selected and the tables built during static initialization.  Until then,
+	 *	Convert() always returns false. */
+	LSBOOL CSimdConvert::m_bSelected = CSimdConvert::Select();
+
+	// == Functions.
+	/**
+	 * Converts a batch of texels if there is a kernel for the pair of formats.  Texels are tightly packed in both
+	 *	buffers.
+	 *
+	 * \param _pfSrcFormat The source texel format.
+	 * \param _pvSrcBuffer The source buffer.
+	 * \param _pfDstFormat The destination texel format.
+	 * \param _pvDstBuffer The destination buffer.
+	 * \param _ui32Total The total number of texels to convert.
+	 * \param _gGamma If _gGamma is not LSI_G_NONE, then an sRGB <-> Linear conversion is performed.
+	 * \return Returns false if there is no kernel for the conversion on this CPU, in which case nothing is
+	 *	written.
+	 */
+	LSBOOL LSE_CALL CSimdConvert::Convert( LSI_PIXEL_FORMAT _pfSrcFormat, const void * _pvSrcBuffer,
+		LSI_PIXEL_FORMAT _pfDstFormat, void * _pvDstBuffer, uint32_t _ui32Total, LSI_GAMMA _gGamma ) {
+		if ( !m_bSelected ) { return false; }
+
+		if ( _gGamma != LSI_G_NONE ) {
+			if ( _pfSrcFormat == LSI_PF_R8G8B8A8 && _pfDstFormat == LSI_PF_R32G32B32A32F ) {
+				Rgba8ToRgba32FGamma( _pvSrcBuffer, _pvDstBuffer, _ui32Total, _gGamma );
+				return true;
+			}
+			if ( _pfSrcFormat == LSI_PF_R32G32B32A32F && _pfDstFormat == LSI_PF_R8G8B8A8 ) {
+				Rgba32FToRgba8Gamma( _pvSrcBuffer, _pvDstBuffer, _ui32Total, _gGamma );
+				return true;
+			}
+			if ( _pfSrcFormat == LSI_PF_R8G8B8A8 && _pfDstFormat == LSI_PF_R8G8B8A8 ) {
+				Rgba8ToRgba8Gamma( _pvSrcBuffer, _pvDstBuffer, _ui32Total, _gGamma );
+				return true;
+			}
+			return false;
+		}
+
+		LSI_SIMD_KERNELS skKernel;
+		switch ( _pfSrcFormat ) {
+			case LSI_PF_R8G8B8A8 : {
+				switch ( _pfDstFormat ) {
+					case LSI_PF_R32G32B32A32F : { skKernel = LSI_SK_RGBA8_TO_RGBA32F; break; }
+					case LSI_PF_R5G6B5 : { skKernel = LSI_SK_RGBA8_TO_R5G6B5; break; }
+					case LSI_PF_R4G4B4A4 : { skKernel = LSI_SK_RGBA8_TO_R4G4B4A4; break; }
+					default : { return false; }
+				}
+				break;
+			}
+			case LSI_PF_R32G32B32A32F : {
+				switch ( _pfDstFormat ) {
+					case LSI_PF_R8G8B8A8 : { skKernel = LSI_SK_RGBA32F_TO_RGBA8; break; }
+					case LSI_PF_R16G16B16A16F : { skKernel = LSI_SK_RGBA32F_TO_RGBA16F; break; }
+					default : { return false; }
+				}
+				break;
+			}
+			case LSI_PF_R5G6B5 : {
+				if ( _pfDstFormat != LSI_PF_R8G8B8A8 ) { return false; }
+				skKernel = LSI_SK_R5G6B5_TO_RGBA8;
+				break;
+			}
+			case LSI_PF_R4G4B4A4 : {
+				if ( _pfDstFormat != LSI_PF_R8G8B8A8 ) { return false; }
+				skKernel = LSI_SK_R4G4B4A4_TO_RGBA8;
+				break;
+			}
+			case LSI_PF_R16G16B16A16F : {
+				if ( _pfDstFormat != LSI_PF_R32G32B32A32F ) { return false; }
+				skKernel = LSI_SK_RGBA16F_TO_RGBA32F;
+				break;
+			}
+			default : { return false; }
+		}
+		if ( !m_pfKernels[skKernel] ) { return false; }
+		RunKernel( m_pfKernels[skKernel], _pvSrcBuffer, CImageLib::GetFormatSize( _pfSrcFormat ),
+			_pvDstBuffer, CImageLib::GetFormatSize( _pfDstFormat ), _ui32Total );
+		return true;
+	}
+
+	/**
+	 * Converts 4-byte texels whose components are stored in any byte order (for example B, G, R, A) to
+	 *	LSI_PF_R8G8B8A8.
+	 *
+	 * \param _pvSrc The source texels.
+	 * \param _ui32R The byte index of the red component within each source texel.
+	 * \param _ui32G The byte index of the green component within each source texel.
+	 * \param _ui32B The byte index of the blue component within each source texel.
+	 * \param _ui32A The byte index of the alpha component within each source texel.
+	 * \param _pvDst The destination texels.  Must not overlap the source texels.
+	 * \param _ui32Total The total number of texels to convert.
+	 */
+	void LSE_CALL CSimdConvert::SwizzleToRgba8( const void * _pvSrc,
+		uint32_t _ui32R, uint32_t _ui32G, uint32_t _ui32B, uint32_t _ui32A,
+		void * _pvDst, uint32_t _ui32Total ) {
+		uint8_t ui8Map[4];
+		ui8Map[CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_R )>>3] = static_cast<uint8_t>(_ui32R);
+		ui8Map[CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_G )>>3] = static_cast<uint8_t>(_ui32G);
+		ui8Map[CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_B )>>3] = static_cast<uint8_t>(_ui32B);
+		ui8Map[CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_A )>>3] = static_cast<uint8_t>(_ui32A);
+		RunPermute( _pvSrc, _pvDst, _ui32Total, ui8Map );
+	}
+
+	/**
+	 * Converts LSI_PF_R8G8B8A8 texels to 4-byte texels whose components are stored in any byte order.
+	 *
+	 * \param _pvSrc The source texels.
+	 * \param _ui32R The byte index of the red component within each destination texel.
+	 * \param _ui32G The byte index of the green component within each destination texel.
+	 * \param _ui32B The byte index of the blue component within each destination texel.
+	 * \param _ui32A The byte index of the alpha component within each destination texel.
+	 * \param _pvDst The destination texels.  Must not overlap the source texels.
+	 * \param _ui32Total The total number of texels to convert.
+	 */
+	void LSE_CALL CSimdConvert::SwizzleFromRgba8( const void * _pvSrc,
+		uint32_t _ui32R, uint32_t _ui32G, uint32_t _ui32B, uint32_t _ui32A,
+		void * _pvDst, uint32_t _ui32Total ) {
+		uint8_t ui8Map[4];
+		ui8Map[_ui32R&3] = static_cast<uint8_t>(CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_R )>>3);
+		ui8Map[_ui32G&3] = static_cast<uint8_t>(CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_G )>>3);
+		ui8Map[_ui32B&3] = static_cast<uint8_t>(CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_B )>>3);
+		ui8Map[_ui32A&3] = static_cast<uint8_t>(CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_A )>>3);
+		RunPermute( _pvSrc, _pvDst, _ui32Total, ui8Map );
+	}
+
+	/**
+	 * Selects the fastest kernels supported by the CPU and builds the gamma tables.
+	 *
+	 * \return Returns true.
+	 */
+	LSBOOL LSE_CALL CSimdConvert::Select() {
+		float fRgba[4];
+		for ( uint32_t I = 0; I < 256; ++I ) {
+			uint64_t ui64Texel = I * 0x01010101ULL;
+			CImageLib::IntegerTexelToFloat32Texel( LSI_PF_R8G8B8A8, ui64Texel, fRgba, LSI_G_NONE );
+			m_fRgba8ToRgba32F[2][I] = fRgba[LSI_PC_R];
+			for ( uint32_t G = LSI_G_sRGB; G <= LSI_G_LINEAR; ++G ) {
+				CImageLib::IntegerTexelToFloat32Texel( LSI_PF_R8G8B8A8, ui64Texel, fRgba, static_cast<LSI_GAMMA>(G) );
+				m_fRgba8ToRgba32F[G][I] = fRgba[LSI_PC_R];
+				m_ui8Rgba8ToRgba8[G][I] = static_cast<uint8_t>(CImageLib::IntegerTexelToIntegerTexel( LSI_PF_R8G8B8A8, LSI_PF_R8G8B8A8,
+					ui64Texel, static_cast<LSI_GAMMA>(G) ) >> CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_R ));
+			}
+		}
+
+		// For each output value, search the bits of the floats from 0 to 1 for the first that converts to at least that
+		//	value.  0x3F800001 is just past 1.0f and stands for a value that is never reached.
+		for ( uint32_t G = LSI_G_sRGB; G <= LSI_G_LINEAR; ++G ) {
+			m_fRgba32FToRgba8[G][0] = 0.0f;
+			for ( uint32_t I = 1; I <= 256; ++I ) {
+				uint32_t ui32Lo = 0, ui32Hi = 0x3F800001;
+				while ( ui32Lo < ui32Hi ) {
+					uint32_t ui32Mid = (ui32Lo + ui32Hi) >> 1;
+					float fVal;
+					CStd::MemCpy( &fVal, &ui32Mid, sizeof( fVal ) );
+					fRgba[0] = fRgba[1] = fRgba[2] = fRgba[3] = fVal;
+					uint32_t ui32Val = static_cast<uint32_t>(CImageLib::Float32TexelToIntegerTexel( LSI_PF_R8G8B8A8, fRgba,
+						static_cast<LSI_GAMMA>(G) ) >> CImageLib::GetComponentOffset( LSI_PF_R8G8B8A8, LSI_PC_R )) & 0xFF;
+					if ( ui32Val >= I ) { ui32Hi = ui32Mid; }
+					else { ui32Lo = ui32Mid + 1; }
+				}
+				CStd::MemCpy( &m_fRgba32FToRgba8[G][I], &ui32Lo, sizeof( float ) );
+			}
+			uint32_t ui32Val = 0;
+			for ( uint32_t I = 0; I <= LSI_SIMD_GAMMA_RANGES; ++I ) {
+				float fStart = static_cast<float>(I) / LSI_SIMD_GAMMA_RANGES;
+				while ( fStart >= m_fRgba32FToRgba8[G][ui32Val+1] ) { ++ui32Val; }
+				m_ui8Rgba32FToRgba8Start[G][I] = static_cast<uint8_t>(ui32Val);
+			}
+		}
+
+#ifdef LSSTD_SIMD_SSE2
+		if ( CCpu::HasSse41() ) {
+			m_pfKernels[LSI_SK_RGBA8_TO_RGBA32F] = Rgba8ToRgba32F128;
+			m_pfKernels[LSI_SK_RGBA32F_TO_RGBA8] = Rgba32FToRgba8128;
+			m_pfKernels[LSI_SK_R5G6B5_TO_RGBA8] = R5G6B5ToRgba8128;
+			m_pfKernels[LSI_SK_RGBA8_TO_R5G6B5] = Rgba8ToR5G6B5128;
+			m_pfKernels[LSI_SK_R4G4B4A4_TO_RGBA8] = R4G4B4A4ToRgba8128;
+			m_pfKernels[LSI_SK_RGBA8_TO_R4G4B4A4] = Rgba8ToR4G4B4A4128;
+			m_pfPermute = Permute128;
+			if ( CCpu::HasF16c() ) {
+				m_pfKernels[LSI_SK_RGBA16F_TO_RGBA32F] = Rgba16FToRgba32FF16c;
+				m_pfKernels[LSI_SK_RGBA32F_TO_RGBA16F] = Rgba32FToRgba16FF16c;
+			}
+		}
+		if ( CCpu::HasAvx2() ) {
+			m_pfKernels[LSI_SK_RGBA8_TO_RGBA32F] = Rgba8ToRgba32F256;
+			m_pfKernels[LSI_SK_RGBA32F_TO_RGBA8] = Rgba32FToRgba8256;
+			m_pfPermute = Permute256;
+		}
+#elif defined( LSSTD_SIMD_NEON )
+#ifdef LSI_SIMD_NEON64
+		m_pfKernels[LSI_SK_RGBA8_TO_RGBA32F] = Rgba8ToRgba32F128;
+#endif	// #ifdef LSI_SIMD_NEON64
+		m_pfKernels[LSI_SK_RGBA32F_TO_RGBA8] = Rgba32FToRgba8128;
+		m_pfKernels[LSI_SK_R5G6B5_TO_RGBA8] = R5G6B5ToRgba8128;
+		m_pfKernels[LSI_SK_RGBA8_TO_R5G6B5] = Rgba8ToR5G6B5128;
+		m_pfKernels[LSI_SK_R4G4B4A4_TO_RGBA8] = R4G4B4A4ToRgba8128;
+		m_pfKernels[LSI_SK_RGBA8_TO_R4G4B4A4] = Rgba8ToR4G4B4A4128;
+		m_pfPermute = Permute128;
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		return true;
+	}
+
+	/**
+	 * Runs a kernel over any number of texels, passing the texels left over after the last whole
+	 *	LSI_SIMD_BLOCK through a padded block on the stack.
+	 *
+	 * \param _pfKernel The kernel to run.
+	 * \param _pvSrc The source texels.
+	 * \param _ui32SrcSize The size of a source texel in bytes.
+	 * \param _pvDst The destination texels.
+	 * \param _ui32DstSize The size of a destination texel in bytes.
+	 * \param _ui32Total The total number of texels to convert.
+	 */
+	void LSE_CALL CSimdConvert::RunKernel( PfKernel _pfKernel, const void * _pvSrc, uint32_t _ui32SrcSize,
+		void * _pvDst, uint32_t _ui32DstSize, uint32_t _ui32Total ) {
+		uint32_t ui32Whole = _ui32Total & ~static_cast<uint32_t>(LSI_SIMD_BLOCK - 1);
+		if ( ui32Whole ) {
+			_pfKernel( _pvSrc, _pvDst, ui32Whole );
+		}
+		uint32_t ui32Left = _ui32Total - ui32Whole;
+		if ( ui32Left ) {
+			// Zeros keep the unused texels away from NaN and denormal slow paths.
+			uint8_t ui8Src[LSI_SIMD_BLOCK*LSI_SIMD_MAX_TEXEL] = { 0 };
+			uint8_t ui8Dst[LSI_SIMD_BLOCK*LSI_SIMD_MAX_TEXEL];
+			CStd::MemCpy( ui8Src, static_cast<const uint8_t *>(_pvSrc) + ui32Whole * _ui32SrcSize, ui32Left * _ui32SrcSize );
+			_pfKernel( ui8Src, ui8Dst, LSI_SIMD_BLOCK );
+			CStd::MemCpy( static_cast<uint8_t *>(_pvDst) + ui32Whole * _ui32DstSize, ui8Dst, ui32Left * _ui32DstSize );
+		}
+	}
+
+	/**
+	 * Rearranges the bytes of any number of 4-byte texels with the selected permutation kernel.
+	 *
+	 * \param _pvSrc The source texels.
+	 * \param _pvDst The destination texels.
+	 * \param _ui32Total The total number of texels to convert.
+	 * \param _pui8Map Destination byte I of each texel is source byte _pui8Map[I].
+	 */
+	void LSE_CALL CSimdConvert::RunPermute( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map ) {
+		uint32_t ui32Whole = _ui32Total & ~static_cast<uint32_t>(LSI_SIMD_BLOCK - 1);
+		if ( ui32Whole ) {
+			m_pfPermute( _pvSrc, _pvDst, ui32Whole, _pui8Map );
+		}
+		if ( ui32Whole != _ui32Total ) {
+			PermuteScalar( static_cast<const uint8_t *>(_pvSrc) + (ui32Whole << 2), static_cast<uint8_t *>(_pvDst) + (ui32Whole << 2),
+				_ui32Total - ui32Whole, _pui8Map );
+		}
+	}
+
+	/**
+	 * Converts LSI_PF_R8G8B8A8 to LSI_PF_R32G32B32A32F with an sRGB <-> linear conversion.
+	 *
+	 * \param _pvSrc The source texels.
+	 * \param _pvDst The destination texels.
+	 * \param _ui32Total The total number of texels to convert.
+	 * \param _gGamma LSI_G_sRGB or LSI_G_LINEAR.
+	 */
+	void LSE_CALL CSimdConvert::Rgba8ToRgba32FGamma( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, LSI_GAMMA _gGamma ) {
+		const uint32_t * pui32Src = static_cast<const uint32_t *>(_pvSrc);
+		float * pfDst = static_cast<float *>(_pvDst);
+		const float * pfColor = m_fRgba8ToRgba32F[_gGamma];
+		const float * pfAlpha = m_fRgba8ToRgba32F[2];
+		for ( ; _ui32Total--; pfDst += 4 ) {
+			uint32_t ui32Texel = (*pui32Src++);
+			pfDst[LSI_PC_R] = pfColor[LSI_R( ui32Texel )];
+			pfDst[LSI_PC_G] = pfColor[LSI_G( ui32Texel )];
+			pfDst[LSI_PC_B] = pfColor[LSI_B( ui32Texel )];
+			pfDst[LSI_PC_A] = pfAlpha[LSI_A( ui32Texel )];
+		}
+	}
+
+	/**
+	 * Converts LSI_PF_R32G32B32A32F to LSI_PF_R8G8B8A8 with an sRGB <-> linear conversion.
+	 *
+	 * \param _pvSrc The source texels.
+	 * \param _pvDst The destination texels.
+	 * \param _ui32Total The total number of texels to convert.
+	 * \param _gGamma LSI_G_sRGB or LSI_G_LINEAR.
+	 */
+	void LSE_CALL CSimdConvert::Rgba32FToRgba8Gamma( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, LSI_GAMMA _gGamma ) {
+		const float * pfSrc = static_cast<const float *>(_pvSrc);
+		uint32_t * pui32Dst = static_cast<uint32_t *>(_pvDst);
+		const float * pfSteps = m_fRgba32FToRgba8[_gGamma];
+		const uint8_t * pui8Start = m_ui8Rgba32FToRgba8Start[_gGamma];
+		for ( ; _ui32Total--; pfSrc += 4 ) {
+			uint32_t ui32Color[3];
+			for ( uint32_t I = 0; I < 3; ++I ) {
+				// Same as CStd::Clamp( pfSrc[I], 0.0f, 1.0f ) except that NaN becomes 0.
+				float fVal = pfSrc[I] > 0.0f ? CStd::Min( pfSrc[I], 1.0f ) : 0.0f;
+				// Start from the value at the start of the range containing the component and count the steps after that.
+				uint32_t ui32Val = pui8Start[static_cast<uint32_t>(fVal*LSI_SIMD_GAMMA_RANGES)];
+				while ( fVal >= pfSteps[ui32Val+1] ) { ++ui32Val; }
+				ui32Color[I] = ui32Val;
+			}
+			float fAlpha = pfSrc[LSI_PC_A] > 0.0f ? CStd::Min( pfSrc[LSI_PC_A], 1.0f ) : 0.0f;
+			(*pui32Dst++) = LSI_MAKE_RGBA( ui32Color[LSI_PC_R], ui32Color[LSI_PC_G], ui32Color[LSI_PC_B],
+				static_cast<uint32_t>(fAlpha * 255.0f + 0.5f) );
+		}
+	}
+
+	/**
+	 * Converts LSI_PF_R8G8B8A8 to LSI_PF_R8G8B8A8 with an sRGB <-> linear conversion.
+	 *
+	 * \param _pvSrc The source texels.
+	 * \param _pvDst The destination texels.  May be the same as the source texels.
+	 * \param _ui32Total The total number of texels to convert.
+	 * \param _gGamma LSI_G_sRGB or LSI_G_LINEAR.
+	 */
+	void LSE_CALL CSimdConvert::Rgba8ToRgba8Gamma( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, LSI_GAMMA _gGamma ) {
+		const uint32_t * pui32Src = static_cast<const uint32_t *>(_pvSrc);
+		uint32_t * pui32Dst = static_cast<uint32_t *>(_pvDst);
+		const uint8_t * pui8Table = m_ui8Rgba8ToRgba8[_gGamma];
+		for ( ; _ui32Total--; ) {
+			uint32_t ui32Texel = (*pui32Src++);
+			(*pui32Dst++) = LSI_MAKE_RGBA( pui8Table[LSI_R( ui32Texel )], pui8Table[LSI_G( ui32Texel )], pui8Table[LSI_B( ui32Texel )],
+				LSI_A( ui32Texel ) );
+		}
+	}
+
+	/** Portable implementation of the byte-permutation kernel. */
+	void LSE_CALL CSimdConvert::PermuteScalar( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		for ( ; _ui32Total--; pui8Src += 4, pui8Dst += 4 ) {
+			pui8Dst[0] = pui8Src[_pui8Map[0]];
+			pui8Dst[1] = pui8Src[_pui8Map[1]];
+			pui8Dst[2] = pui8Src[_pui8Map[2]];
+			pui8Dst[3] = pui8Src[_pui8Map[3]];
+		}
+	}
+
+#ifdef LSSTD_SIMD_SSE2
+	/**
+	 * Clamps 4 floats to [0,1] and converts them to integers from 0 to 255 the way CImageLib::Float32TexelToIntegerTexel()
+	 *	does: multiply by 255, add 0.5, and truncate.  NaN becomes 0.
+	 *
+	 * \param _vVal The floats to convert.
+	 * \return Returns the converted values as 32-bit integers.
+	 */
+	static LSE_INLINE __m128i LSE_CALL Float32ToUnorm8( __m128 _vVal ) {
+		_vVal = _mm_min_ps( _mm_max_ps( _vVal, _mm_setzero_ps() ), _mm_set1_ps( 1.0f ) );
+		return _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( _vVal, _mm_set1_ps( 255.0f ) ), _mm_set1_ps( 0.5f ) ) );
+	}
+
+	/**
+	 * Converts 8 16-bit values from 0 to 255 to integers from 0 to _i16Max, rounding the way CImageLib::ConvComp() does.
+	 *	The maximum is odd, so no value is exactly halfway and (X * _i16Max + 127) / 255 rounds to the nearest.
+	 *
+	 * \param _vVal The values to convert.
+	 * \param _i16Max The largest destination value (15, 31, or 63).
+	 * \return Returns the converted values.
+	 */
+	static LSE_INLINE __m128i LSE_CALL Unorm8ToUnormN( __m128i _vVal, int16_t _i16Max ) {
+		__m128i vX = _mm_add_epi16( _mm_mullo_epi16( _vVal, _mm_set1_epi16( _i16Max ) ), _mm_set1_epi16( 128 ) );
+		return _mm_srli_epi16( _mm_add_epi16( vX, _mm_srli_epi16( vX, 8 ) ), 8 );
+	}
+
+	/** SSE4.1 implementation of LSI_SK_RGBA8_TO_RGBA32F. */
+	LSSTD_TARGET( "sse4.1" )
+	void LSE_CALL CSimdConvert::Rgba8ToRgba32F128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		float * pfDst = static_cast<float *>(_pvDst);
+		// Texels are stored A, B, G, R in memory; reversing the bytes of each gives R, G, B, A.
+		const __m128i vReverse = _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+		const __m128 vMax = _mm_set1_ps( 255.0f );
+		for ( ; _ui32Total; _ui32Total -= 4, pui8Src += 16, pfDst += 16 ) {
+			__m128i vTexels = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src) ), vReverse );
+			// Divide rather than multiply by the reciprocal to match the generic code.
+			_mm_storeu_ps( pfDst, _mm_div_ps( _mm_cvtepi32_ps( _mm_cvtepu8_epi32( vTexels ) ), vMax ) );
+			_mm_storeu_ps( pfDst + 4, _mm_div_ps( _mm_cvtepi32_ps( _mm_cvtepu8_epi32( _mm_srli_si128( vTexels, 4 ) ) ), vMax ) );
+			_mm_storeu_ps( pfDst + 8, _mm_div_ps( _mm_cvtepi32_ps( _mm_cvtepu8_epi32( _mm_srli_si128( vTexels, 8 ) ) ), vMax ) );
+			_mm_storeu_ps( pfDst + 12, _mm_div_ps( _mm_cvtepi32_ps( _mm_cvtepu8_epi32( _mm_srli_si128( vTexels, 12 ) ) ), vMax ) );
+		}
+	}
+
+	/** SSE4.1 implementation of LSI_SK_RGBA32F_TO_RGBA8. */
+	LSSTD_TARGET( "sse4.1" )
+	void LSE_CALL CSimdConvert::Rgba32FToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const float * pfSrc = static_cast<const float *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const __m128i vReverse = _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+		for ( ; _ui32Total; _ui32Total -= 4, pfSrc += 16, pui8Dst += 16 ) {
+			__m128i vWords0 = _mm_packs_epi32( Float32ToUnorm8( _mm_loadu_ps( pfSrc ) ), Float32ToUnorm8( _mm_loadu_ps( pfSrc + 4 ) ) );
+			__m128i vWords1 = _mm_packs_epi32( Float32ToUnorm8( _mm_loadu_ps( pfSrc + 8 ) ), Float32ToUnorm8( _mm_loadu_ps( pfSrc + 12 ) ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst), _mm_shuffle_epi8( _mm_packus_epi16( vWords0, vWords1 ), vReverse ) );
+		}
+	}
+
+	/** SSE4.1 implementation of LSI_SK_R5G6B5_TO_RGBA8. */
+	LSSTD_TARGET( "sse4.1" )
+	void LSE_CALL CSimdConvert::R5G6B5ToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const __m128i vMask5 = _mm_set1_epi16( 0x1F );
+		const __m128i vMask6 = _mm_set1_epi16( 0x3F );
+		for ( ; _ui32Total; _ui32Total -= 8, pui8Src += 16, pui8Dst += 32 ) {
+			__m128i vTexels = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src) );
+			// (X * 527 + 23) >> 6 and (X * 259 + 33) >> 6 equal round( X * 255 / 31 ) and round( X * 255 / 63 ) exactly.
+			__m128i vR = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( _mm_srli_epi16( vTexels, 11 ), _mm_set1_epi16( 527 ) ), _mm_set1_epi16( 23 ) ), 6 );
+			__m128i vG = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi16( vTexels, 5 ), vMask6 ), _mm_set1_epi16( 259 ) ), _mm_set1_epi16( 33 ) ), 6 );
+			__m128i vB = _mm_srli_epi16( _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( vTexels, vMask5 ), _mm_set1_epi16( 527 ) ), _mm_set1_epi16( 23 ) ), 6 );
+			__m128i vHi = _mm_or_si128( _mm_slli_epi16( vR, 8 ), vG );
+			__m128i vLo = _mm_or_si128( _mm_slli_epi16( vB, 8 ), _mm_set1_epi16( 0xFF ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst), _mm_unpacklo_epi16( vLo, vHi ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst + 16), _mm_unpackhi_epi16( vLo, vHi ) );
+		}
+	}
+
+	/** SSE4.1 implementation of LSI_SK_RGBA8_TO_R5G6B5. */
+	LSSTD_TARGET( "sse4.1" )
+	void LSE_CALL CSimdConvert::Rgba8ToR5G6B5128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const __m128i vMask = _mm_set1_epi32( 0xFF );
+		for ( ; _ui32Total; _ui32Total -= 8, pui8Src += 32, pui8Dst += 16 ) {
+			__m128i vTexels0 = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src) );
+			__m128i vTexels1 = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src + 16) );
+			__m128i vR = _mm_packus_epi32( _mm_srli_epi32( vTexels0, 24 ), _mm_srli_epi32( vTexels1, 24 ) );
+			__m128i vG = _mm_packus_epi32( _mm_and_si128( _mm_srli_epi32( vTexels0, 16 ), vMask ), _mm_and_si128( _mm_srli_epi32( vTexels1, 16 ), vMask ) );
+			__m128i vB = _mm_packus_epi32( _mm_and_si128( _mm_srli_epi32( vTexels0, 8 ), vMask ), _mm_and_si128( _mm_srli_epi32( vTexels1, 8 ), vMask ) );
+			__m128i vOut = _mm_or_si128( _mm_slli_epi16( Unorm8ToUnormN( vR, 31 ), 11 ),
+				_mm_or_si128( _mm_slli_epi16( Unorm8ToUnormN( vG, 63 ), 5 ), Unorm8ToUnormN( vB, 31 ) ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst), vOut );
+		}
+	}
+
+	/** SSE4.1 implementation of LSI_SK_R4G4B4A4_TO_RGBA8. */
+	LSSTD_TARGET( "sse4.1" )
+	void LSE_CALL CSimdConvert::R4G4B4A4ToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const __m128i vMask = _mm_set1_epi16( 0xF );
+		const __m128i vScale = _mm_set1_epi16( 17 );
+		for ( ; _ui32Total; _ui32Total -= 8, pui8Src += 16, pui8Dst += 32 ) {
+			__m128i vTexels = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src) );
+			__m128i vR = _mm_mullo_epi16( _mm_srli_epi16( vTexels, 12 ), vScale );
+			__m128i vG = _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi16( vTexels, 8 ), vMask ), vScale );
+			__m128i vB = _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi16( vTexels, 4 ), vMask ), vScale );
+			__m128i vA = _mm_mullo_epi16( _mm_and_si128( vTexels, vMask ), vScale );
+			__m128i vHi = _mm_or_si128( _mm_slli_epi16( vR, 8 ), vG );
+			__m128i vLo = _mm_or_si128( _mm_slli_epi16( vB, 8 ), vA );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst), _mm_unpacklo_epi16( vLo, vHi ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst + 16), _mm_unpackhi_epi16( vLo, vHi ) );
+		}
+	}
+
+	/** SSE4.1 implementation of LSI_SK_RGBA8_TO_R4G4B4A4. */
+	LSSTD_TARGET( "sse4.1" )
+	void LSE_CALL CSimdConvert::Rgba8ToR4G4B4A4128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const __m128i vMask = _mm_set1_epi32( 0xFF );
+		for ( ; _ui32Total; _ui32Total -= 8, pui8Src += 32, pui8Dst += 16 ) {
+			__m128i vTexels0 = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src) );
+			__m128i vTexels1 = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src + 16) );
+			__m128i vR = _mm_packus_epi32( _mm_srli_epi32( vTexels0, 24 ), _mm_srli_epi32( vTexels1, 24 ) );
+			__m128i vG = _mm_packus_epi32( _mm_and_si128( _mm_srli_epi32( vTexels0, 16 ), vMask ), _mm_and_si128( _mm_srli_epi32( vTexels1, 16 ), vMask ) );
+			__m128i vB = _mm_packus_epi32( _mm_and_si128( _mm_srli_epi32( vTexels0, 8 ), vMask ), _mm_and_si128( _mm_srli_epi32( vTexels1, 8 ), vMask ) );
+			__m128i vA = _mm_packus_epi32( _mm_and_si128( vTexels0, vMask ), _mm_and_si128( vTexels1, vMask ) );
+			__m128i vOut = _mm_or_si128( _mm_or_si128( _mm_slli_epi16( Unorm8ToUnormN( vR, 15 ), 12 ), _mm_slli_epi16( Unorm8ToUnormN( vG, 15 ), 8 ) ),
+				_mm_or_si128( _mm_slli_epi16( Unorm8ToUnormN( vB, 15 ), 4 ), Unorm8ToUnormN( vA, 15 ) ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst), vOut );
+		}
+	}
+
+	/** SSSE3 implementation of the byte-permutation kernel. */
+	LSSTD_TARGET( "ssse3" )
+	void LSE_CALL CSimdConvert::Permute128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		LSE_ALIGN( 16 ) uint8_t ui8Shuffle[16] LSE_POSTALIGN( 16 );
+		for ( uint32_t I = 0; I < 16; ++I ) {
+			ui8Shuffle[I] = static_cast<uint8_t>((I & ~3) + (_pui8Map[I&3] & 3));
+		}
+		const __m128i vShuffle = _mm_load_si128( reinterpret_cast<const __m128i *>(ui8Shuffle) );
+		for ( ; _ui32Total; _ui32Total -= 4, pui8Src += 16, pui8Dst += 16 ) {
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst),
+				_mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src) ), vShuffle ) );
+		}
+	}
+
+	/** AVX2 implementation of LSI_SK_RGBA8_TO_RGBA32F. */
+	LSSTD_TARGET( "avx2" )
+	void LSE_CALL CSimdConvert::Rgba8ToRgba32F256( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		float * pfDst = static_cast<float *>(_pvDst);
+		const __m128i vReverse = _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+		const __m256 vMax = _mm256_set1_ps( 255.0f );
+		for ( ; _ui32Total; _ui32Total -= 4, pui8Src += 16, pfDst += 16 ) {
+			__m128i vTexels = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src) ), vReverse );
+			_mm256_storeu_ps( pfDst, _mm256_div_ps( _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( vTexels ) ), vMax ) );
+			_mm256_storeu_ps( pfDst + 8, _mm256_div_ps( _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( _mm_srli_si128( vTexels, 8 ) ) ), vMax ) );
+		}
+		_mm256_zeroupper();
+	}
+
+	/** AVX2 implementation of LSI_SK_RGBA32F_TO_RGBA8. */
+	LSSTD_TARGET( "avx2" )
+	void LSE_CALL CSimdConvert::Rgba32FToRgba8256( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const float * pfSrc = static_cast<const float *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const __m256 vZero = _mm256_setzero_ps();
+		const __m256 vOne = _mm256_set1_ps( 1.0f );
+		const __m256 vMax = _mm256_set1_ps( 255.0f );
+		const __m256 vHalf = _mm256_set1_ps( 0.5f );
+		const __m256i vReverse = _mm256_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+		const __m256i vOrder = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+		for ( ; _ui32Total; _ui32Total -= 8, pfSrc += 32, pui8Dst += 32 ) {
+			__m256i vInts[4];
+			for ( uint32_t I = 0; I < 4; ++I ) {
+				__m256 vVal = _mm256_min_ps( _mm256_max_ps( _mm256_loadu_ps( pfSrc + (I << 3) ), vZero ), vOne );
+				vInts[I] = _mm256_cvttps_epi32( _mm256_add_ps( _mm256_mul_ps( vVal, vMax ), vHalf ) );
+			}
+			// Packing works within each 128-bit half, leaving texels in the order 0, 2, 4, 6, 1, 3, 5, 7.
+			__m256i vBytes = _mm256_packus_epi16( _mm256_packs_epi32( vInts[0], vInts[1] ), _mm256_packs_epi32( vInts[2], vInts[3] ) );
+			vBytes = _mm256_permutevar8x32_epi32( _mm256_shuffle_epi8( vBytes, vReverse ), vOrder );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>(pui8Dst), vBytes );
+		}
+		_mm256_zeroupper();
+	}
+
+	/** AVX2 implementation of the byte-permutation kernel. */
+	LSSTD_TARGET( "avx2" )
+	void LSE_CALL CSimdConvert::Permute256( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		LSE_ALIGN( 32 ) uint8_t ui8Shuffle[32] LSE_POSTALIGN( 32 );
+		for ( uint32_t I = 0; I < 32; ++I ) {
+			ui8Shuffle[I] = static_cast<uint8_t>(((I & 15) & ~3) + (_pui8Map[I&3] & 3));
+		}
+		const __m256i vShuffle = _mm256_load_si256( reinterpret_cast<const __m256i *>(ui8Shuffle) );
+		for ( ; _ui32Total; _ui32Total -= 16, pui8Src += 64, pui8Dst += 64 ) {
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>(pui8Dst),
+				_mm256_shuffle_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Src) ), vShuffle ) );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>(pui8Dst + 32),
+				_mm256_shuffle_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Src + 32) ), vShuffle ) );
+		}
+		_mm256_zeroupper();
+	}
+
+	/** F16C implementation of LSI_SK_RGBA16F_TO_RGBA32F. */
+	LSSTD_TARGET( "f16c" )
+	void LSE_CALL CSimdConvert::Rgba16FToRgba32FF16c( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		float * pfDst = static_cast<float *>(_pvDst);
+		const __m128i vAbs = _mm_set1_epi32( 0x7FFF );
+		const __m128i vSign = _mm_set1_epi32( 0x8000 );
+		const __m128i vInf = _mm_set1_epi32( 0x7C00 );
+		const __m128i vNanBias = _mm_set1_epi32( 0x70000000 );
+		for ( uint32_t I = _ui32Total; I--; pui8Src += 8, pfDst += 4 ) {
+			__m128i vHalves = _mm_loadl_epi64( reinterpret_cast<const __m128i *>(pui8Src) );
+			__m128 vFloats = _mm_cvtph_ps( vHalves );
+			// VCVTPH2PS sets the quiet bit of signaling NaNs but CFloat16 copies the payload unchanged.
+			__m128i vWide = _mm_cvtepu16_epi32( vHalves );
+			__m128i vAbsVal = _mm_and_si128( vWide, vAbs );
+			__m128i vNan = _mm_cmpgt_epi32( vAbsVal, vInf );
+			__m128i vNanVal = _mm_or_si128( _mm_slli_epi32( _mm_and_si128( vWide, vSign ), 16 ),
+				_mm_add_epi32( _mm_slli_epi32( vAbsVal, 13 ), vNanBias ) );
+			_mm_storeu_ps( pfDst, _mm_blendv_ps( vFloats, _mm_castsi128_ps( vNanVal ), _mm_castsi128_ps( vNan ) ) );
+		}
+	}
+
+	/** F16C implementation of LSI_SK_RGBA32F_TO_RGBA16F. */
+	LSSTD_TARGET( "f16c" )
+	void LSE_CALL CSimdConvert::Rgba32FToRgba16FF16c( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const float * pfSrc = static_cast<const float *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const __m128i vAbs = _mm_set1_epi32( 0x7FFFFFFF );
+		const __m128i vMaxHalf = _mm_set1_epi32( 0x477FE000 );		// 65504.0f.
+		const __m128i vInf = _mm_set1_epi32( 0x7F800000 );
+		const __m128i vHalfInf = _mm_set1_epi32( 0x7C00 );
+		const __m128i vNanBias = _mm_set1_epi32( 0x38000 );
+		const __m128i vMinNan = _mm_set1_epi32( 0x7C01 );
+		const __m128i vSign = _mm_set1_epi32( 0x8000 );
+		for ( uint32_t I = _ui32Total >> 1; I--; pfSrc += 8, pui8Dst += 16 ) {
+			// CFloat16 truncates toward zero, which VCVTPS2PH matches for finite values that are in range.
+			__m128i vSpecial[2], vFix[2];
+			for ( uint32_t J = 0; J < 2; ++J ) {
+				__m128i vBits = _mm_castps_si128( _mm_loadu_ps( pfSrc + (J << 2) ) );
+				__m128i vAbsVal = _mm_and_si128( vBits, vAbs );
+				// Finite values above 65504 become infinity rather than 65504.
+				__m128i vNan = _mm_cmpgt_epi32( vAbsVal, vInf );
+				__m128i vOverflow = _mm_andnot_si128( vNan, _mm_cmpgt_epi32( vAbsVal, vMaxHalf ) );
+				// NaN keeps the top 10 bits of its payload, or 1 if they are all 0, and never gains the quiet bit.
+				__m128i vNanVal = _mm_max_epi32( _mm_sub_epi32( _mm_srli_epi32( vAbsVal, 13 ), vNanBias ), vMinNan );
+				vSpecial[J] = _mm_or_si128( vNan, vOverflow );
+				vFix[J] = _mm_or_si128( _mm_and_si128( _mm_srli_epi32( vBits, 16 ), vSign ),
+					_mm_or_si128( _mm_and_si128( vOverflow, vHalfInf ), _mm_and_si128( vNan, vNanVal ) ) );
+			}
+			__m128i vHalves = _mm_unpacklo_epi64( _mm_cvtps_ph( _mm_loadu_ps( pfSrc ), _MM_FROUND_TO_ZERO ),
+				_mm_cvtps_ph( _mm_loadu_ps( pfSrc + 4 ), _MM_FROUND_TO_ZERO ) );
+			vHalves = _mm_blendv_epi8( vHalves, _mm_packus_epi32( vFix[0], vFix[1] ), _mm_packs_epi32( vSpecial[0], vSpecial[1] ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst), vHalves );
+		}
+	}
+#elif defined( LSSTD_SIMD_NEON )
+	/**
+	 * Clamps 4 floats to [0,1] and converts them to integers from 0 to 255 the way CImageLib::Float32TexelToIntegerTexel()
+	 *	does: multiply by 255, add 0.5, and truncate.  NaN becomes 0.
+	 *
+	 * \param _vVal The floats to convert.
+	 * \return Returns the converted values as 32-bit integers.
+	 */
+	static LSE_INLINE uint32x4_t LSE_CALL Float32ToUnorm8( float32x4_t _vVal ) {
+		_vVal = vminq_f32( vmaxq_f32( _vVal, vdupq_n_f32( 0.0f ) ), vdupq_n_f32( 1.0f ) );
+		return vcvtq_u32_f32( vaddq_f32( vmulq_f32( _vVal, vdupq_n_f32( 255.0f ) ), vdupq_n_f32( 0.5f ) ) );
+	}
+
+	/**
+	 * Converts 8 16-bit values from 0 to 255 to integers from 0 to _ui16Max, rounding the way CImageLib::ConvComp() does.
+	 *	The maximum is odd, so no value is exactly halfway and (X * _ui16Max + 127) / 255 rounds to the nearest.
+	 *
+	 * \param _vVal The values to convert.
+	 * \param _ui16Max The largest destination value (15, 31, or 63).
+	 * \return Returns the converted values.
+	 */
+	static LSE_INLINE uint16x8_t LSE_CALL Unorm8ToUnormN( uint16x8_t _vVal, uint16_t _ui16Max ) {
+		uint16x8_t vX = vmlaq_n_u16( vdupq_n_u16( 128 ), _vVal, _ui16Max );
+		return vshrq_n_u16( vsraq_n_u16( vX, vX, 8 ), 8 );
+	}
+
+#ifdef LSI_SIMD_NEON64
+	/** NEON implementation of LSI_SK_RGBA8_TO_RGBA32F. */
+	void LSE_CALL CSimdConvert::Rgba8ToRgba32F128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		float * pfDst = static_cast<float *>(_pvDst);
+		const float32x4_t vMax = vdupq_n_f32( 255.0f );
+		for ( ; _ui32Total; _ui32Total -= 4, pui8Src += 16, pfDst += 16 ) {
+			// Texels are stored A, B, G, R in memory; reversing the bytes of each gives R, G, B, A.
+			uint8x16_t vTexels = vrev32q_u8( vld1q_u8( pui8Src ) );
+			uint16x8_t vLo = vmovl_u8( vget_low_u8( vTexels ) );
+			uint16x8_t vHi = vmovl_u8( vget_high_u8( vTexels ) );
+			// Divide rather than multiply by the reciprocal to match the generic code.
+			vst1q_f32( pfDst, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_low_u16( vLo ) ) ), vMax ) );
+			vst1q_f32( pfDst + 4, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_high_u16( vLo ) ) ), vMax ) );
+			vst1q_f32( pfDst + 8, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_low_u16( vHi ) ) ), vMax ) );
+			vst1q_f32( pfDst + 12, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_high_u16( vHi ) ) ), vMax ) );
+		}
+	}
+#endif	// #ifdef LSI_SIMD_NEON64
+
+	/** NEON implementation of LSI_SK_RGBA32F_TO_RGBA8. */
+	void LSE_CALL CSimdConvert::Rgba32FToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const float * pfSrc = static_cast<const float *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		for ( ; _ui32Total; _ui32Total -= 4, pfSrc += 16, pui8Dst += 16 ) {
+			uint16x8_t vWords0 = vcombine_u16( vmovn_u32( Float32ToUnorm8( vld1q_f32( pfSrc ) ) ), vmovn_u32( Float32ToUnorm8( vld1q_f32( pfSrc + 4 ) ) ) );
+			uint16x8_t vWords1 = vcombine_u16( vmovn_u32( Float32ToUnorm8( vld1q_f32( pfSrc + 8 ) ) ), vmovn_u32( Float32ToUnorm8( vld1q_f32( pfSrc + 12 ) ) ) );
+			vst1q_u8( pui8Dst, vrev32q_u8( vcombine_u8( vmovn_u16( vWords0 ), vmovn_u16( vWords1 ) ) ) );
+		}
+	}
+
+	/** NEON implementation of LSI_SK_R5G6B5_TO_RGBA8. */
+	void LSE_CALL CSimdConvert::R5G6B5ToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint16_t * pui16Src = static_cast<const uint16_t *>(_pvSrc);
+		uint16_t * pui16Dst = static_cast<uint16_t *>(_pvDst);
+		for ( ; _ui32Total; _ui32Total -= 8, pui16Src += 8, pui16Dst += 16 ) {
+			uint16x8_t vTexels = vld1q_u16( pui16Src );
+			// (X * 527 + 23) >> 6 and (X * 259 + 33) >> 6 equal round( X * 255 / 31 ) and round( X * 255 / 63 ) exactly.
+			uint16x8_t vR = vshrq_n_u16( vmlaq_n_u16( vdupq_n_u16( 23 ), vshrq_n_u16( vTexels, 11 ), 527 ), 6 );
+			uint16x8_t vG = vshrq_n_u16( vmlaq_n_u16( vdupq_n_u16( 33 ), vandq_u16( vshrq_n_u16( vTexels, 5 ), vdupq_n_u16( 0x3F ) ), 259 ), 6 );
+			uint16x8_t vB = vshrq_n_u16( vmlaq_n_u16( vdupq_n_u16( 23 ), vandq_u16( vTexels, vdupq_n_u16( 0x1F ) ), 527 ), 6 );
+			uint16x8x2_t vOut;
+			vOut.val[0] = vorrq_u16( vshlq_n_u16( vB, 8 ), vdupq_n_u16( 0xFF ) );
+			vOut.val[1] = vorrq_u16( vshlq_n_u16( vR, 8 ), vG );
+			vst2q_u16( pui16Dst, vOut );
+		}
+	}
+
+	/** NEON implementation of LSI_SK_RGBA8_TO_R5G6B5. */
+	void LSE_CALL CSimdConvert::Rgba8ToR5G6B5128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint16_t * pui16Dst = static_cast<uint16_t *>(_pvDst);
+		for ( ; _ui32Total; _ui32Total -= 8, pui8Src += 32, pui16Dst += 8 ) {
+			// Memory order is A, B, G, R.
+			uint8x8x4_t vTexels = vld4_u8( pui8Src );
+			uint16x8_t vR = Unorm8ToUnormN( vmovl_u8( vTexels.val[3] ), 31 );
+			uint16x8_t vG = Unorm8ToUnormN( vmovl_u8( vTexels.val[2] ), 63 );
+			uint16x8_t vB = Unorm8ToUnormN( vmovl_u8( vTexels.val[1] ), 31 );
+			vst1q_u16( pui16Dst, vorrq_u16( vorrq_u16( vshlq_n_u16( vR, 11 ), vshlq_n_u16( vG, 5 ) ), vB ) );
+		}
+	}
+
+	/** NEON implementation of LSI_SK_R4G4B4A4_TO_RGBA8. */
+	void LSE_CALL CSimdConvert::R4G4B4A4ToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint16_t * pui16Src = static_cast<const uint16_t *>(_pvSrc);
+		uint16_t * pui16Dst = static_cast<uint16_t *>(_pvDst);
+		const uint16x8_t vMask = vdupq_n_u16( 0xF );
+		for ( ; _ui32Total; _ui32Total -= 8, pui16Src += 8, pui16Dst += 16 ) {
+			uint16x8_t vTexels = vld1q_u16( pui16Src );
+			uint16x8_t vR = vmulq_n_u16( vshrq_n_u16( vTexels, 12 ), 17 );
+			uint16x8_t vG = vmulq_n_u16( vandq_u16( vshrq_n_u16( vTexels, 8 ), vMask ), 17 );
+			uint16x8_t vB = vmulq_n_u16( vandq_u16( vshrq_n_u16( vTexels, 4 ), vMask ), 17 );
+			uint16x8_t vA = vmulq_n_u16( vandq_u16( vTexels, vMask ), 17 );
+			uint16x8x2_t vOut;
+			vOut.val[0] = vorrq_u16( vshlq_n_u16( vB, 8 ), vA );
+			vOut.val[1] = vorrq_u16( vshlq_n_u16( vR, 8 ), vG );
+			vst2q_u16( pui16Dst, vOut );
+		}
+	}
+
+	/** NEON implementation of LSI_SK_RGBA8_TO_R4G4B4A4. */
+	void LSE_CALL CSimdConvert::Rgba8ToR4G4B4A4128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint16_t * pui16Dst = static_cast<uint16_t *>(_pvDst);
+		for ( ; _ui32Total; _ui32Total -= 8, pui8Src += 32, pui16Dst += 8 ) {
+			// Memory order is A, B, G, R.
+			uint8x8x4_t vTexels = vld4_u8( pui8Src );
+			uint16x8_t vR = Unorm8ToUnormN( vmovl_u8( vTexels.val[3] ), 15 );
+			uint16x8_t vG = Unorm8ToUnormN( vmovl_u8( vTexels.val[2] ), 15 );
+			uint16x8_t vB = Unorm8ToUnormN( vmovl_u8( vTexels.val[1] ), 15 );
+			uint16x8_t vA = Unorm8ToUnormN( vmovl_u8( vTexels.val[0] ), 15 );
+			vst1q_u16( pui16Dst, vorrq_u16( vorrq_u16( vshlq_n_u16( vR, 12 ), vshlq_n_u16( vG, 8 ) ),
+				vorrq_u16( vshlq_n_u16( vB, 4 ), vA ) ) );
+		}
+	}
+
+	/** NEON implementation of the byte-permutation kernel. */
+	void LSE_CALL CSimdConvert::Permute128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map ) {
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		for ( ; _ui32Total; _ui32Total -= 16, pui8Src += 64, pui8Dst += 64 ) {
+			// Loading 4 ways splits the bytes of each texel across 4 registers, which are stored in the new order.
+			uint8x16x4_t vIn = vld4q_u8( pui8Src );
+			uint8x16x4_t vOut;
+			vOut.val[0] = vIn.val[_pui8Map[0]&3];
+			vOut.val[1] = vIn.val[_pui8Map[1]&3];
+			vOut.val[2] = vIn.val[_pui8Map[2]&3];
+			vOut.val[3] = vIn.val[_pui8Map[3]&3];
+			vst4q_u8( pui8Dst, vOut );
+		}
+	}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+
+}	// namespace lsi
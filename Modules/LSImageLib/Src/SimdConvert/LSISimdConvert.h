@@ -0,0 +1,270 @@
+/**
+ * Copyright L. Spiro 2021
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: SIMD kernels for the most common texel conversions performed by CImageLib.  The kernels produce
+ *	exactly the same bits as the generic per-texel converters and are selected at run-time from the instruction
+ *	sets the CPU supports.
+ */
+
+
+#ifndef __LSI_SIMDCONVERT_H__
+#define __LSI_SIMDCONVERT_H__
+
+#include "../LSIImageLib.h"
+#include "Simd/LSSTDSimdStd.h"
+
+/** The number of texels each kernel converts at a time.  Kernels are only ever given multiples of this. */
+#define LSI_SIMD_BLOCK					16
+
+/** The largest texel handled by the kernels, in bytes. */
+#define LSI_SIMD_MAX_TEXEL				16
+
+/** The number of equal ranges from 0 to 1 used to find the first step to check when converting float color
+ *	components to LSI_PF_R8G8B8A8 with a gamma conversion. */
+#define LSI_SIMD_GAMMA_RANGES			4096
+
+namespace lsi {
+
+	/**
+	 * Class CSimdConvert
+	 * \brief SIMD kernels for the most common texel conversions.
+	 *
+	 * Description: SIMD kernels for the most common texel conversions performed by CImageLib.  The kernels produce
+	 *	exactly the same bits as the generic per-texel converters and are selected at run-time from the instruction
+	 *	sets the CPU supports.  CImageLib's Batch*() functions try Convert() first and fall back to the generic code
+	 *	when it returns false.
+	 *
+	 * Without a gamma conversion the kernels are:
+	 *	LSI_PF_R8G8B8A8 <-> LSI_PF_R32G32B32A32F: SSE4.1, AVX2, and NEON (from float only on 32-bit ARM, which has no
+	 *		vector divide).
+	 *	LSI_PF_R5G6B5 and LSI_PF_R4G4B4A4 <-> LSI_PF_R8G8B8A8: SSE4.1 and NEON.
+	 *	LSI_PF_R16G16B16A16F <-> LSI_PF_R32G32B32A32F: F16C.  Both directions reproduce CFloat16 exactly, including its
+	 *		truncation toward zero, its overflow to infinity, and its handling of NaN.
+	 *
+	 * sRGB <-> linear conversions from LSI_PF_R8G8B8A8 to LSI_PF_R8G8B8A8 and to LSI_PF_R32G32B32A32F use 256-entry
+	 *	tables, and from LSI_PF_R32G32B32A32F to LSI_PF_R8G8B8A8 they use a table of the 255 inputs at which the output
+	 *	steps to the next value.  The tables are built from the generic converters when the library is loaded, so they
+	 *	match them on every platform.
+	 *
+	 * Components that are NaN have no defined integer value in the generic converters; the kernels convert them to 0.
+	 */
+	class CSimdConvert {
+	public :
+		// == Functions.
+		/**
+		 * Converts a batch of texels if there is a kernel for the pair of formats.  Texels are tightly packed in both
+		 *	buffers.
+		 *
+		 * \param _pfSrcFormat The source texel format.
+		 * \param _pvSrcBuffer The source buffer.
+		 * \param _pfDstFormat The destination texel format.
+		 * \param _pvDstBuffer The destination buffer.
+		 * \param _ui32Total The total number of texels to convert.
+		 * \param _gGamma If _gGamma is not LSI_G_NONE, then an sRGB <-> Linear conversion is performed.
+		 * \return Returns false if there is no kernel for the conversion on this CPU, in which case nothing is
+		 *	written.
+		 */
+		static LSBOOL LSE_CALL				Convert( LSI_PIXEL_FORMAT _pfSrcFormat, const void * _pvSrcBuffer,
+			LSI_PIXEL_FORMAT _pfDstFormat, void * _pvDstBuffer, uint32_t _ui32Total, LSI_GAMMA _gGamma );
+
+		/**
+		 * Converts 4-byte texels whose components are stored in any byte order (for example B, G, R, A) to
+		 *	LSI_PF_R8G8B8A8.
+		 *
+		 * \param _pvSrc The source texels.
+		 * \param _ui32R The byte index of the red component within each source texel.
+		 * \param _ui32G The byte index of the green component within each source texel.
+		 * \param _ui32B The byte index of the blue component within each source texel.
+		 * \param _ui32A The byte index of the alpha component within each source texel.
+		 * \param _pvDst The destination texels.  Must not overlap the source texels.
+		 * \param _ui32Total The total number of texels to convert.
+		 */
+		static void LSE_CALL				SwizzleToRgba8( const void * _pvSrc,
+			uint32_t _ui32R, uint32_t _ui32G, uint32_t _ui32B, uint32_t _ui32A,
+			void * _pvDst, uint32_t _ui32Total );
+
+		/**
+		 * Converts LSI_PF_R8G8B8A8 texels to 4-byte texels whose components are stored in any byte order.
+		 *
+		 * \param _pvSrc The source texels.
+		 * \param _ui32R The byte index of the red component within each destination texel.
+		 * \param _ui32G The byte index of the green component within each destination texel.
+		 * \param _ui32B The byte index of the blue component within each destination texel.
+		 * \param _ui32A The byte index of the alpha component within each destination texel.
+		 * \param _pvDst The destination texels.  Must not overlap the source texels.
+		 * \param _ui32Total The total number of texels to convert.
+		 */
+		static void LSE_CALL				SwizzleFromRgba8( const void * _pvSrc,
+			uint32_t _ui32R, uint32_t _ui32G, uint32_t _ui32B, uint32_t _ui32A,
+			void * _pvDst, uint32_t _ui32Total );
+
+
+	protected :
+		// == Enumerations.
+		/** The kernels that have SIMD implementations. */
+		enum LSI_SIMD_KERNELS {
+			LSI_SK_RGBA8_TO_RGBA32F,
+			LSI_SK_RGBA32F_TO_RGBA8,
+			LSI_SK_R5G6B5_TO_RGBA8,
+			LSI_SK_RGBA8_TO_R5G6B5,
+			LSI_SK_R4G4B4A4_TO_RGBA8,
+			LSI_SK_RGBA8_TO_R4G4B4A4,
+			LSI_SK_RGBA16F_TO_RGBA32F,
+			LSI_SK_RGBA32F_TO_RGBA16F,
+			LSI_SK_TOTAL
+		};
+
+
+		// == Types.
+		/** A conversion kernel.  _ui32Total is always a multiple of LSI_SIMD_BLOCK. */
+		typedef void (LSE_CALL * PfKernel)( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** A kernel that rearranges the bytes of 4-byte texels.  Destination byte I of each texel is source byte
+		 *	_pui8Map[I].  _ui32Total is always a multiple of LSI_SIMD_BLOCK. */
+		typedef void (LSE_CALL * PfPermute)( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map );
+
+
+		// == Members.
+		/** The selected kernels.  NULL where the CPU has no kernel. */
+		static PfKernel						m_pfKernels[LSI_SK_TOTAL];
+
+		/** The selected byte-permutation kernel. */
+		static PfPermute					m_pfPermute;
+
+		/** LSI_PF_R8G8B8A8 components to floats, indexed by LSI_G_sRGB, LSI_G_LINEAR, and then 2 for no conversion. */
+		static float						m_fRgba8ToRgba32F[3][256];
+
+		/** LSI_PF_R8G8B8A8 color components to LSI_PF_R8G8B8A8 color components, indexed by LSI_G_sRGB and
+		 *	LSI_G_LINEAR. */
+		static uint8_t						m_ui8Rgba8ToRgba8[2][256];
+
+		/** The smallest float color component that converts to each LSI_PF_R8G8B8A8 value, indexed by LSI_G_sRGB and
+		 *	LSI_G_LINEAR.  Entry 0 is not used and entry 256, like any value that is never reached, is above 1. */
+		static float						m_fRgba32FToRgba8[2][257];
+
+		/** The LSI_PF_R8G8B8A8 value of the start of each of the LSI_SIMD_GAMMA_RANGES ranges from 0 to 1, plus 1
+		 *	itself, indexed by LSI_G_sRGB and LSI_G_LINEAR. */
+		static uint8_t						m_ui8Rgba32FToRgba8Start[2][LSI_SIMD_GAMMA_RANGES+1];
+
+		/** Set when the kernels are selected and the tables built during static initialization.  Until then,
+		 *	Convert() always returns false. */
+		static LSBOOL						m_bSelected;
+
+
+		// == Functions.
+		/**
+		 * Selects the fastest kernels supported by the CPU and builds the gamma tables.
+		 *
+		 * \return Returns true.
+		 */
+		static LSBOOL LSE_CALL				Select();
+
+		/**
+		 * Runs a kernel over any number of texels, passing the texels left over after the last whole
+		 *	LSI_SIMD_BLOCK through a padded block on the stack.
+		 *
+		 * \param _pfKernel The kernel to run.
+		 * \param _pvSrc The source texels.
+		 * \param _ui32SrcSize The size of a source texel in bytes.
+		 * \param _pvDst The destination texels.
+		 * \param _ui32DstSize The size of a destination texel in bytes.
+		 * \param _ui32Total The total number of texels to convert.
+		 */
+		static void LSE_CALL				RunKernel( PfKernel _pfKernel, const void * _pvSrc, uint32_t _ui32SrcSize,
+			void * _pvDst, uint32_t _ui32DstSize, uint32_t _ui32Total );
+
+		/**
+		 * Rearranges the bytes of any number of 4-byte texels with the selected permutation kernel.
+		 *
+		 * \param _pvSrc The source texels.
+		 * \param _pvDst The destination texels.
+		 * \param _ui32Total The total number of texels to convert.
+		 * \param _pui8Map Destination byte I of each texel is source byte _pui8Map[I].
+		 */
+		static void LSE_CALL				RunPermute( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map );
+
+		/**
+		 * Converts LSI_PF_R8G8B8A8 to LSI_PF_R32G32B32A32F with an sRGB <-> linear conversion.
+		 *
+		 * \param _pvSrc The source texels.
+		 * \param _pvDst The destination texels.
+		 * \param _ui32Total The total number of texels to convert.
+		 * \param _gGamma LSI_G_sRGB or LSI_G_LINEAR.
+		 */
+		static void LSE_CALL				Rgba8ToRgba32FGamma( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, LSI_GAMMA _gGamma );
+
+		/**
+		 * Converts LSI_PF_R32G32B32A32F to LSI_PF_R8G8B8A8 with an sRGB <-> linear conversion.
+		 *
+		 * \param _pvSrc The source texels.
+		 * \param _pvDst The destination texels.
+		 * \param _ui32Total The total number of texels to convert.
+		 * \param _gGamma LSI_G_sRGB or LSI_G_LINEAR.
+		 */
+		static void LSE_CALL				Rgba32FToRgba8Gamma( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, LSI_GAMMA _gGamma );
+
+		/**
+		 * Converts LSI_PF_R8G8B8A8 to LSI_PF_R8G8B8A8 with an sRGB <-> linear conversion.
+		 *
+		 * \param _pvSrc The source texels.
+		 * \param _pvDst The destination texels.  May be the same as the source texels.
+		 * \param _ui32Total The total number of texels to convert.
+		 * \param _gGamma LSI_G_sRGB or LSI_G_LINEAR.
+		 */
+		static void LSE_CALL				Rgba8ToRgba8Gamma( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, LSI_GAMMA _gGamma );
+
+		/** Portable implementation of the byte-permutation kernel. */
+		static void LSE_CALL				PermuteScalar( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map );
+
+#if defined( LSSTD_SIMD_SSE2 ) || defined( LSSTD_SIMD_NEON )
+		/** 128-bit (SSE4.1 or NEON) implementation of LSI_SK_RGBA8_TO_RGBA32F. */
+		static void LSE_CALL				Rgba8ToRgba32F128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** 128-bit (SSE4.1 or NEON) implementation of LSI_SK_RGBA32F_TO_RGBA8. */
+		static void LSE_CALL				Rgba32FToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** 128-bit (SSE4.1 or NEON) implementation of LSI_SK_R5G6B5_TO_RGBA8. */
+		static void LSE_CALL				R5G6B5ToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** 128-bit (SSE4.1 or NEON) implementation of LSI_SK_RGBA8_TO_R5G6B5. */
+		static void LSE_CALL				Rgba8ToR5G6B5128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** 128-bit (SSE4.1 or NEON) implementation of LSI_SK_R4G4B4A4_TO_RGBA8. */
+		static void LSE_CALL				R4G4B4A4ToRgba8128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** 128-bit (SSE4.1 or NEON) implementation of LSI_SK_RGBA8_TO_R4G4B4A4. */
+		static void LSE_CALL				Rgba8ToR4G4B4A4128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** 128-bit (SSSE3 or NEON) implementation of the byte-permutation kernel. */
+		static void LSE_CALL				Permute128( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map );
+#endif	// #if defined( LSSTD_SIMD_SSE2 ) || defined( LSSTD_SIMD_NEON )
+
+#ifdef LSSTD_SIMD_SSE2
+		/** AVX2 implementation of LSI_SK_RGBA8_TO_RGBA32F. */
+		static void LSE_CALL				Rgba8ToRgba32F256( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** AVX2 implementation of LSI_SK_RGBA32F_TO_RGBA8. */
+		static void LSE_CALL				Rgba32FToRgba8256( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** AVX2 implementation of the byte-permutation kernel. */
+		static void LSE_CALL				Permute256( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total, const uint8_t * _pui8Map );
+
+		/** F16C implementation of LSI_SK_RGBA16F_TO_RGBA32F. */
+		static void LSE_CALL				Rgba16FToRgba32FF16c( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+
+		/** F16C implementation of LSI_SK_RGBA32F_TO_RGBA16F. */
+		static void LSE_CALL				Rgba32FToRgba16FF16c( const void * _pvSrc, void * _pvDst, uint32_t _ui32Total );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+	};
+
+}	// namespace lsi
+
+#endif	// __LSI_SIMDCONVERT_H__
@@ -0,0 +1,601 @@
+/**
+ * Copyright L. Spiro 2021
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Converts directly between block-compressed formats and between RGBA8 and block-compressed formats
+ *	one 4-by-4 block at a time, without first expanding the whole image to RGBA32F.
+ */
+
+#include "LSITranscoder.h"
+#include "JobSystem/LSHJobSystem.h"
+#include "../Etc/LSIEtc.h"
+#include "../detex/detex.h"
+#include "../Squish/squish.h"
+
+
+namespace lsi {
+
+	// == Functions.
+	/**
+	 * Determines whether the given pair of formats can be transcoded directly.
+	 *
+	 * \param _pfSrc The source format.
+	 * \param _pfDst The destination format.
+	 * \return Returns true if both formats are supported by Transcode().
+	 */
+	LSBOOL LSE_CALL CTranscoder::CanTranscode( LSI_PIXEL_FORMAT _pfSrc, LSI_PIXEL_FORMAT _pfDst ) {
+		return (_pfSrc == LSI_PF_R8G8B8A8 || BlockSize( _pfSrc )) &&
+			(_pfDst == LSI_PF_R8G8B8A8 || BlockSize( _pfDst ));
+	}
+
+	/**
+	 * Gets the size of an image in one of the supported formats.
+	 *
+	 * \param _pfFormat The format.
+	 * \param _ui32Width Width of the image.
+	 * \param _ui32Height Height of the image.
+	 * \return Returns the size, in bytes, of a single slice of the image, or 0 if the format is not supported.
+	 */
+	uint32_t LSE_CALL CTranscoder::GetSize( LSI_PIXEL_FORMAT _pfFormat, uint32_t _ui32Width, uint32_t _ui32Height ) {
+		if ( _pfFormat == LSI_PF_R8G8B8A8 ) { return _ui32Width * _ui32Height * sizeof( uint32_t ); }
+		return ((_ui32Width + 3) >> 2) * ((_ui32Height + 3) >> 2) * BlockSize( _pfFormat );
+	}
+
+	/**
+	 * Transcodes an image from one format to another.  RGBA8 images are tightly packed; compressed images are stored
+	 *	as rows of blocks.
+	 *
+	 * \param _pui8Src The source texels.
+	 * \param _pfSrc The source format.
+	 * \param _pui8Dst The destination texels, which must be GetSize( _pfDst, _ui32Width, _ui32Height ) * _ui32Depth bytes.
+	 * \param _pfDst The destination format.
+	 * \param _ui32Width Width of the image.
+	 * \param _ui32Height Height of the image.
+	 * \param _ui32Depth Depth of the image.
+	 * \param _ptoOptions Optional transcoding options.  If NULL, LSI_TQ_NORMAL with the default weights is used.
+	 * \return Returns false if the pair of formats is not supported.
+	 */
+	LSBOOL LSE_CALL CTranscoder::Transcode( const uint8_t * _pui8Src, LSI_PIXEL_FORMAT _pfSrc,
+		uint8_t * _pui8Dst, LSI_PIXEL_FORMAT _pfDst,
+		uint32_t _ui32Width, uint32_t _ui32Height, uint32_t _ui32Depth,
+		const LSI_TRANSCODE_OPTIONS * _ptoOptions ) {
+		if ( !CanTranscode( _pfSrc, _pfDst ) ) { return false; }
+		uint32_t ui32SrcSlice = GetSize( _pfSrc, _ui32Width, _ui32Height );
+		uint32_t ui32DstSlice = GetSize( _pfDst, _ui32Width, _ui32Height );
+		if ( _pfSrc == _pfDst ) {
+			CStd::MemCpy( _pui8Dst, _pui8Src, ui32SrcSlice * _ui32Depth );
+			return true;
+		}
+
+		LSI_TRANSCODE_OPTIONS toOptions;
+		if ( _ptoOptions ) {
+			toOptions = (*_ptoOptions);
+		}
+		else {
+			toOptions.tqQuality = LSI_TQ_NORMAL;
+			toOptions.fAlphaThresh = 0.0f;
+			toOptions.fRedWeight = LSI_R_WEIGHT;
+			toOptions.fGreenWeight = LSI_G_WEIGHT;
+			toOptions.fBlueWeight = LSI_B_WEIGHT;
+		}
+
+		// ETCPACK keeps its settings in globals, so they are set once here before any jobs start.
+		switch ( _pfDst ) {
+			case LSI_PF_ETC1 : {
+				::readCompressParams();
+				format = ETC1_RGB_NO_MIPMAPS;
+				break;
+			}
+			case LSI_PF_ETC2 : {}
+			case LSI_PF_ETC2_SRGB : {
+				::readCompressParams();
+				format = ETC2PACKAGE_RGB_NO_MIPMAPS;
+				break;
+			}
+			case LSI_PF_ETC2_PT_ALPHA1 : {}
+			case LSI_PF_ETC2_PT_ALPHA1_SRGB : {
+				::readCompressParams();
+				format = ETC2PACKAGE_RGBA1_NO_MIPMAPS;
+				break;
+			}
+			case LSI_PF_ETC2_EAC : {}
+			case LSI_PF_ETC2_EAC_SRGB : {
+				::readCompressParams();
+				::setupAlphaTableAndValtab();
+				format = ETC2PACKAGE_RGBA_NO_MIPMAPS;
+				break;
+			}
+			default : {}
+		}
+
+		LSI_TRANSCODE_JOB_DATA tjdData;
+		tjdData.tbdBand.pfSrc = _pfSrc;
+		tjdData.tbdBand.pfDst = _pfDst;
+		tjdData.tbdBand.ui32Width = _ui32Width;
+		tjdData.tbdBand.ui32Height = _ui32Height;
+		tjdData.tbdBand.ptoOptions = &toOptions;
+		tjdData.pui8Src = _pui8Src;
+		tjdData.pui8Dst = _pui8Dst;
+		tjdData.ui32SrcSlice = ui32SrcSlice;
+		tjdData.ui32DstSlice = ui32DstSlice;
+		tjdData.ui32BlocksH = (_ui32Height + 3) >> 2;
+		tjdData.ui32Bands = (tjdData.ui32BlocksH + LSI_TRANSCODE_ROWS - 1) / LSI_TRANSCODE_ROWS;
+
+		// Bands of every slice are spread over the job system.
+		CJobSystem::ParallelFor( tjdData.ui32Bands * _ui32Depth, TranscodeRange, &tjdData );
+		return true;
+	}
+
+	/**
+	 * Gets the size of a block in a supported compressed format.
+	 *
+	 * \param _pfFormat The format.
+	 * \return Returns 8 or 16 for supported compressed formats, 0 for LSI_PF_R8G8B8A8 and unsupported formats.
+	 */
+	uint32_t LSE_CALL CTranscoder::BlockSize( LSI_PIXEL_FORMAT _pfFormat ) {
+		switch ( _pfFormat ) {
+			case LSI_PF_DXT1 : {}
+			case LSI_PF_BC4 : {}
+			case LSI_PF_ETC1 : {}
+			case LSI_PF_ETC2 : {}
+			case LSI_PF_ETC2_SRGB : {}
+			case LSI_PF_ETC2_PT_ALPHA1 : {}
+			case LSI_PF_ETC2_PT_ALPHA1_SRGB : { return 8; }
+			case LSI_PF_DXT3 : {}
+			case LSI_PF_DXT5 : {}
+			case LSI_PF_BC5 : {}
+			case LSI_PF_ETC2_EAC : {}
+			case LSI_PF_ETC2_EAC_SRGB : { return 16; }
+			default : { return 0; }
+		}
+	}
+
+	/**
+	 * Transcodes a band of rows of blocks.
+	 *
+	 * \param _tbdData The band to transcode.
+	 */
+	void LSE_CALL CTranscoder::TranscodeRows( const LSI_TRANSCODE_BAND_DATA &_tbdData ) {
+		uint32_t ui32BlocksW = (_tbdData.ui32Width + 3) >> 2;
+		uint32_t ui32End = _tbdData.ui32StartRow + _tbdData.ui32Rows;
+		if ( _tbdData.pfSrc == LSI_PF_DXT1 && _tbdData.pfDst == LSI_PF_ETC1 && _tbdData.ptoOptions->tqQuality == LSI_TQ_FASTEST ) {
+			for ( uint32_t Y = _tbdData.ui32StartRow; Y < ui32End; ++Y ) {
+				for ( uint32_t X = 0; X < ui32BlocksW; ++X ) {
+					uint32_t ui32Offset = (Y * ui32BlocksW + X) << 3;
+					Dxt1ToEtc1( &_tbdData.pui8Src[ui32Offset], &_tbdData.pui8Dst[ui32Offset] );
+				}
+			}
+			return;
+		}
+
+		uint8_t ui8Rgba[16*4];
+		for ( uint32_t Y = _tbdData.ui32StartRow; Y < ui32End; ++Y ) {
+			// Texels below the image are masked off.
+			uint32_t ui32RowsIn = CStd::Min<uint32_t>( _tbdData.ui32Height - (Y << 2), 4 );
+			for ( uint32_t X = 0; X < ui32BlocksW; ++X ) {
+				uint32_t ui32ColumnsIn = CStd::Min<uint32_t>( _tbdData.ui32Width - (X << 2), 4 );
+				uint32_t ui32Mask = 0;
+				for ( uint32_t J = 0; J < ui32RowsIn; ++J ) {
+					ui32Mask |= ((1 << ui32ColumnsIn) - 1) << (J << 2);
+				}
+				DecodeBlock( _tbdData.pfSrc, _tbdData.pui8Src, _tbdData.ui32Width, _tbdData.ui32Height, X, Y, ui8Rgba );
+				EncodeBlock( _tbdData.pfDst, ui8Rgba, ui32Mask, _tbdData.pui8Dst, _tbdData.ui32Width, _tbdData.ui32Height, X, Y,
+					(*_tbdData.ptoOptions) );
+			}
+		}
+	}
+
+	/**
+	 * Decodes a single block to RGBA8.
+	 *
+	 * \param _pfSrc The source format.
+	 * \param _pui8Src The source image.
+	 * \param _ui32Width Width of the source image.
+	 * \param _ui32Height Height of the source image.
+	 * \param _ui32X The X coordinate of the block, in blocks.
+	 * \param _ui32Y The Y coordinate of the block, in blocks.
+	 * \param _pui8Rgba The returned block, 16 texels in R, G, B, A byte order, row by row.  Texels outside of
+	 *	the image repeat the nearest edge texel.
+	 */
+	void LSE_CALL CTranscoder::DecodeBlock( LSI_PIXEL_FORMAT _pfSrc, const uint8_t * _pui8Src,
+		uint32_t _ui32Width, uint32_t _ui32Height, uint32_t _ui32X, uint32_t _ui32Y, uint8_t * _pui8Rgba ) {
+		if ( _pfSrc == LSI_PF_R8G8B8A8 ) {
+			const uint32_t * pui32Src = reinterpret_cast<const uint32_t *>(_pui8Src);
+			for ( uint32_t J = 0; J < 4; ++J ) {
+				uint32_t ui32SrcY = CStd::Min<uint32_t>( (_ui32Y << 2) + J, _ui32Height - 1 );
+				for ( uint32_t I = 0; I < 4; ++I ) {
+					uint32_t ui32SrcX = CStd::Min<uint32_t>( (_ui32X << 2) + I, _ui32Width - 1 );
+					uint32_t ui32Texel = pui32Src[ui32SrcY*_ui32Width+ui32SrcX];
+					uint8_t * pui8Dst = &_pui8Rgba[((J<<2)+I)<<2];
+					pui8Dst[LSI_PC_R] = static_cast<uint8_t>(LSI_R( ui32Texel ));
+					pui8Dst[LSI_PC_G] = static_cast<uint8_t>(LSI_G( ui32Texel ));
+					pui8Dst[LSI_PC_B] = static_cast<uint8_t>(LSI_B( ui32Texel ));
+					pui8Dst[LSI_PC_A] = static_cast<uint8_t>(LSI_A( ui32Texel ));
+				}
+			}
+			return;
+		}
+
+		const uint8_t * pui8Block = &_pui8Src[(_ui32Y*((_ui32Width+3)>>2)+_ui32X)*BlockSize( _pfSrc )];
+		switch ( _pfSrc ) {
+			case LSI_PF_DXT1 : {
+				::detexDecompressBlockBC1A( pui8Block, DETEX_MODE_MASK_ALL, 0, _pui8Rgba );
+				break;
+			}
+			case LSI_PF_DXT3 : {
+				::detexDecompressBlockBC2( pui8Block, DETEX_MODE_MASK_ALL, 0, _pui8Rgba );
+				break;
+			}
+			case LSI_PF_DXT5 : {
+				::detexDecompressBlockBC3( pui8Block, DETEX_MODE_MASK_ALL, 0, _pui8Rgba );
+				break;
+			}
+			case LSI_PF_BC4 : {
+				// Decoded to the last 16 bytes and then spread out from the front so nothing is overwritten before it is read.
+				::detexDecompressBlockRGTC1( pui8Block, DETEX_MODE_MASK_ALL, 0, &_pui8Rgba[16*3] );
+				for ( uint32_t I = 0; I < 16; ++I ) {
+					uint8_t ui8R = _pui8Rgba[16*3+I];
+					_pui8Rgba[(I<<2)+LSI_PC_R] = ui8R;
+					_pui8Rgba[(I<<2)+LSI_PC_G] = 0;
+					_pui8Rgba[(I<<2)+LSI_PC_B] = 0;
+					_pui8Rgba[(I<<2)+LSI_PC_A] = 0xFF;
+				}
+				break;
+			}
+			case LSI_PF_BC5 : {
+				::detexDecompressBlockRGTC2( pui8Block, DETEX_MODE_MASK_ALL, 0, &_pui8Rgba[16*2] );
+				for ( uint32_t I = 0; I < 16; ++I ) {
+					uint8_t ui8R = _pui8Rgba[16*2+(I<<1)+0];
+					uint8_t ui8G = _pui8Rgba[16*2+(I<<1)+1];
+					_pui8Rgba[(I<<2)+LSI_PC_R] = ui8R;
+					_pui8Rgba[(I<<2)+LSI_PC_G] = ui8G;
+					_pui8Rgba[(I<<2)+LSI_PC_B] = 0;
+					_pui8Rgba[(I<<2)+LSI_PC_A] = 0xFF;
+				}
+				break;
+			}
+			case LSI_PF_ETC1 : {
+				::detexDecompressBlockETC1( pui8Block, DETEX_MODE_MASK_ALL_MODES_ETC1, 0, _pui8Rgba );
+				break;
+			}
+			case LSI_PF_ETC2 : {}
+			case LSI_PF_ETC2_SRGB : {
+				::detexDecompressBlockETC2( pui8Block, DETEX_MODE_MASK_ALL_MODES_ETC2, 0, _pui8Rgba );
+				break;
+			}
+			case LSI_PF_ETC2_PT_ALPHA1 : {}
+			case LSI_PF_ETC2_PT_ALPHA1_SRGB : {
+				::detexDecompressBlockETC2_PUNCHTHROUGH( pui8Block, DETEX_MODE_MASK_ALL_MODES_ETC2_PUNCHTHROUGH, 0, _pui8Rgba );
+				break;
+			}
+			case LSI_PF_ETC2_EAC : {}
+			case LSI_PF_ETC2_EAC_SRGB : {
+				::detexDecompressBlockETC2_EAC( pui8Block, DETEX_MODE_MASK_ALL_MODES_ETC2, 0, _pui8Rgba );
+				break;
+			}
+			default : {}
+		}
+	}
+
+	/**
+	 * Encodes a single block from RGBA8.
+	 *
+	 * \param _pfDst The destination format.
+	 * \param _pui8Rgba The block, 16 texels in R, G, B, A byte order, row by row.
+	 * \param _ui32Mask Bit N is set if texel N is inside the image.
+	 * \param _pui8Dst The destination image.
+	 * \param _ui32Width Width of the destination image.
+	 * \param _ui32Height Height of the destination image.
+	 * \param _ui32X The X coordinate of the block, in blocks.
+	 * \param _ui32Y The Y coordinate of the block, in blocks.
+	 * \param _toOptions The options.
+	 */
+	void LSE_CALL CTranscoder::EncodeBlock( LSI_PIXEL_FORMAT _pfDst, const uint8_t * _pui8Rgba, uint32_t _ui32Mask,
+		uint8_t * _pui8Dst, uint32_t _ui32Width, uint32_t /*_ui32Height*/, uint32_t _ui32X, uint32_t _ui32Y,
+		const LSI_TRANSCODE_OPTIONS &_toOptions ) {
+		if ( _pfDst == LSI_PF_R8G8B8A8 ) {
+			uint32_t * pui32Dst = reinterpret_cast<uint32_t *>(_pui8Dst);
+			for ( uint32_t I = 0; I < 16; ++I ) {
+				if ( _ui32Mask & (1 << I) ) {
+					const uint8_t * pui8Src = &_pui8Rgba[I<<2];
+					pui32Dst[((_ui32Y<<2)+(I>>2))*_ui32Width+(_ui32X<<2)+(I&3)] = LSI_MAKE_RGBA( pui8Src[LSI_PC_R], pui8Src[LSI_PC_G],
+						pui8Src[LSI_PC_B], pui8Src[LSI_PC_A] );
+				}
+			}
+			return;
+		}
+
+		uint8_t * pui8Block = &_pui8Dst[(_ui32Y*((_ui32Width+3)>>2)+_ui32X)*BlockSize( _pfDst )];
+		switch ( _pfDst ) {
+			case LSI_PF_DXT1 : {}
+			case LSI_PF_DXT3 : {}
+			case LSI_PF_DXT5 : {}
+			case LSI_PF_BC4 : {}
+			case LSI_PF_BC5 : {
+				int iFlags = _toOptions.tqQuality == LSI_TQ_NORMAL ?
+					(squish::kColorMetricPerceptual | squish::kColorIterativeClusterFit | squish::kWeightColorByAlpha) :
+					(squish::kColorMetricPerceptual | squish::kColorRangeFit);
+				switch ( _pfDst ) {
+					case LSI_PF_DXT1 : { iFlags |= squish::kDxt1; break; }
+					case LSI_PF_DXT3 : { iFlags |= squish::kDxt3; break; }
+					case LSI_PF_DXT5 : { iFlags |= squish::kDxt5; break; }
+					case LSI_PF_BC4 : { iFlags |= squish::kBc4; break; }
+					default : { iFlags |= squish::kBc5; }
+				}
+				squish::SquishConfig scConfig = {
+					_toOptions.fRedWeight,
+					_toOptions.fGreenWeight,
+					_toOptions.fBlueWeight,
+					_pfDst == LSI_PF_DXT1 ? _toOptions.fAlphaThresh : 0.0f,
+				};
+#ifdef SQUISH_USE_FLOATS
+				// Only the block is expanded, never the image.
+				float fBlock[16*4];
+				for ( uint32_t I = 0; I < 16 * 4; ++I ) {
+					fBlock[I] = CImageLib::Uint8ToUNorm( _pui8Rgba[I], false );
+				}
+				squish::CompressMasked( fBlock, static_cast<int>(_ui32Mask), pui8Block, iFlags, scConfig );
+#else
+				squish::CompressMasked( reinterpret_cast<const squish::u8 *>(_pui8Rgba), static_cast<int>(_ui32Mask), pui8Block, iFlags, scConfig );
+#endif	// #ifdef SQUISH_USE_FLOATS
+				break;
+			}
+			default : {
+				// ETC.  ETCPACK works on 4-by-4 RGB8 and A8 images.
+				uint8 ui8Rgb[16*3], ui8Alpha[16], ui8Scratch[16*3];
+				for ( uint32_t I = 0; I < 16; ++I ) {
+					ui8Rgb[I*3+0] = _pui8Rgba[(I<<2)+LSI_PC_R];
+					ui8Rgb[I*3+1] = _pui8Rgba[(I<<2)+LSI_PC_G];
+					ui8Rgb[I*3+2] = _pui8Rgba[(I<<2)+LSI_PC_B];
+					ui8Alpha[I] = _pui8Rgba[(I<<2)+LSI_PC_A];
+				}
+				if ( _pfDst == LSI_PF_ETC2_PT_ALPHA1 || _pfDst == LSI_PF_ETC2_PT_ALPHA1_SRGB ) {
+					// ETCPACK only accepts 0 or 255 for punch-through alpha.
+					for ( uint32_t I = 0; I < 16; ++I ) {
+						ui8Alpha[I] = ui8Alpha[I] >= 0x80 ? 0xFF : 0x00;
+					}
+				}
+				unsigned int uiBlock1, uiBlock2;
+				switch ( _pfDst ) {
+					case LSI_PF_ETC1 : {
+						::compressBlockDiffFlipFastPerceptual( ui8Rgb, ui8Scratch, 4, 4, 0, 0, uiBlock1, uiBlock2 );
+						break;
+					}
+					case LSI_PF_ETC2_PT_ALPHA1 : {}
+					case LSI_PF_ETC2_PT_ALPHA1_SRGB : {
+						::compressBlockETC2Fast( ui8Rgb, ui8Alpha, ui8Scratch, 4, 4, 0, 0, uiBlock1, uiBlock2 );
+						break;
+					}
+					case LSI_PF_ETC2_EAC : {}
+					case LSI_PF_ETC2_EAC_SRGB : {
+						// The alpha block comes first.
+						if ( _toOptions.tqQuality == LSI_TQ_NORMAL ) {
+							::compressBlockAlphaSlow( ui8Alpha, 0, 0, 4, 4, pui8Block );
+						}
+						else {
+							::compressBlockAlphaFast( ui8Alpha, 0, 0, 4, 4, pui8Block );
+						}
+						pui8Block += 8;
+						// Fall through.
+					}
+					default : {
+						if ( _toOptions.tqQuality == LSI_TQ_NORMAL ) {
+							::compressBlockETC2ExhaustivePerceptual( ui8Rgb, ui8Scratch, 4, 4, 0, 0, uiBlock1, uiBlock2 );
+						}
+						else {
+							::compressBlockETC2FastPerceptual( ui8Rgb, ui8Scratch, 4, 4, 0, 0, uiBlock1, uiBlock2 );
+						}
+					}
+				}
+				// Blocks are stored big-endian.
+				for ( uint32_t I = 0; I < 4; ++I ) {
+					pui8Block[I] = static_cast<uint8_t>(uiBlock1 >> (24 - (I << 3)));
+					pui8Block[I+4] = static_cast<uint8_t>(uiBlock2 >> (24 - (I << 3)));
+				}
+			}
+		}
+	}
+
+	/**
+	 * Converts a DXT1 block to an ETC1 block by fitting ETC1 base colors and intensity tables to the DXT1 palette
+	 *	and remapping the DXT1 selectors.
+	 *
+	 * \param _pui8Dxt1 The 8-byte DXT1 block.
+	 * \param _pui8Etc1 The returned 8-byte ETC1 block.
+	 */
+	void LSE_CALL CTranscoder::Dxt1ToEtc1( const uint8_t * _pui8Dxt1, uint8_t * _pui8Etc1 ) {
+		// Expand the palette.
+		uint32_t ui32C0 = _pui8Dxt1[0] | (_pui8Dxt1[1] << 8);
+		uint32_t ui32C1 = _pui8Dxt1[2] | (_pui8Dxt1[3] << 8);
+		uint32_t ui32Selectors = _pui8Dxt1[4] | (_pui8Dxt1[5] << 8) | (_pui8Dxt1[6] << 16) | (static_cast<uint32_t>(_pui8Dxt1[7]) << 24);
+		uint8_t ui8Palette[4*3];
+		const uint32_t ui32Colors[2] = { ui32C0, ui32C1 };
+		for ( uint32_t I = 0; I < 2; ++I ) {
+			uint32_t ui32R = (ui32Colors[I] >> 11) & 0x1F, ui32G = (ui32Colors[I] >> 5) & 0x3F, ui32B = ui32Colors[I] & 0x1F;
+			ui8Palette[I*3+0] = static_cast<uint8_t>((ui32R << 3) | (ui32R >> 2));
+			ui8Palette[I*3+1] = static_cast<uint8_t>((ui32G << 2) | (ui32G >> 4));
+			ui8Palette[I*3+2] = static_cast<uint8_t>((ui32B << 3) | (ui32B >> 2));
+		}
+		for ( uint32_t C = 0; C < 3; ++C ) {
+			if ( ui32C0 > ui32C1 ) {
+				ui8Palette[2*3+C] = static_cast<uint8_t>((ui8Palette[C] * 2 + ui8Palette[3+C]) / 3);
+				ui8Palette[3*3+C] = static_cast<uint8_t>((ui8Palette[C] + ui8Palette[3+C] * 2) / 3);
+			}
+			else {
+				// Index 3 is transparent black, which ETC1 can only show as black.
+				ui8Palette[2*3+C] = static_cast<uint8_t>((ui8Palette[C] + ui8Palette[3+C]) / 2);
+				ui8Palette[3*3+C] = 0;
+			}
+		}
+
+		// Try both orientations of the sub-blocks.  Only the palette and how often each entry is used matter, so
+		//	the cost does not depend on the texels.
+		uint32_t ui32BestErr = ~0U;
+		uint32_t ui32BestFlip = 0;
+		LSBOOL bBestDiff = false;
+		int32_t i32BestBase[2][3];
+		uint32_t ui32BestTable[2];
+		uint8_t ui8BestMap[2][4];
+		for ( uint32_t F = 0; F < 2; ++F ) {
+			uint32_t ui32Counts[2][4] = { { 0 } };
+			for ( uint32_t I = 0; I < 16; ++I ) {
+				uint32_t ui32Sub = F ? (I >> 3) : ((I & 3) >> 1);
+				++ui32Counts[ui32Sub][(ui32Selectors>>(I<<1))&3];
+			}
+
+			// Quantize the averages, in differential mode if they are close enough.
+			int32_t i32Quant[2][3];
+			for ( uint32_t S = 0; S < 2; ++S ) {
+				for ( uint32_t C = 0; C < 3; ++C ) {
+					uint32_t ui32Sum = 0;
+					for ( uint32_t K = 0; K < 4; ++K ) {
+						ui32Sum += ui32Counts[S][K] * ui8Palette[K*3+C];
+					}
+					i32Quant[S][C] = static_cast<int32_t>(((ui32Sum + 4) >> 3) * 31 + 127) / 255;
+				}
+			}
+			LSBOOL bDiff = true;
+			for ( uint32_t C = 0; C < 3; ++C ) {
+				int32_t i32Delta = i32Quant[1][C] - i32Quant[0][C];
+				if ( i32Delta < -4 || i32Delta > 3 ) { bDiff = false; }
+			}
+			int32_t i32Base[2][3];
+			for ( uint32_t S = 0; S < 2; ++S ) {
+				for ( uint32_t C = 0; C < 3; ++C ) {
+					if ( bDiff ) {
+						i32Base[S][C] = i32Quant[S][C];
+					}
+					else {
+						uint32_t ui32Sum = 0;
+						for ( uint32_t K = 0; K < 4; ++K ) {
+							ui32Sum += ui32Counts[S][K] * ui8Palette[K*3+C];
+						}
+						i32Base[S][C] = static_cast<int32_t>(((ui32Sum + 4) >> 3) * 15 + 127) / 255;
+					}
+				}
+			}
+
+			uint32_t ui32Err = 0;
+			uint32_t ui32Table[2];
+			uint8_t ui8Map[2][4];
+			for ( uint32_t S = 0; S < 2; ++S ) {
+				int32_t i32Expanded[3];
+				for ( uint32_t C = 0; C < 3; ++C ) {
+					i32Expanded[C] = bDiff ? ((i32Base[S][C] << 3) | (i32Base[S][C] >> 2)) : (i32Base[S][C] * 17);
+				}
+				ui32Err += FitEtc1Table( i32Expanded, ui8Palette, ui32Counts[S], ui32Table[S], ui8Map[S] );
+			}
+			if ( ui32Err < ui32BestErr ) {
+				ui32BestErr = ui32Err;
+				ui32BestFlip = F;
+				bBestDiff = bDiff;
+				CStd::MemCpy( i32BestBase, i32Base, sizeof( i32Base ) );
+				CStd::MemCpy( ui32BestTable, ui32Table, sizeof( ui32Table ) );
+				CStd::MemCpy( ui8BestMap, ui8Map, sizeof( ui8Map ) );
+			}
+		}
+
+		// Pack the block.
+		for ( uint32_t C = 0; C < 3; ++C ) {
+			_pui8Etc1[C] = bBestDiff ?
+				static_cast<uint8_t>((i32BestBase[0][C] << 3) | ((i32BestBase[1][C] - i32BestBase[0][C]) & 0x7)) :
+				static_cast<uint8_t>((i32BestBase[0][C] << 4) | i32BestBase[1][C]);
+		}
+		_pui8Etc1[3] = static_cast<uint8_t>((ui32BestTable[0] << 5) | (ui32BestTable[1] << 2) | ((bBestDiff ? 1 : 0) << 1) | ui32BestFlip);
+		// ETC1 indices run down the columns; DXT1 selectors run across the rows.
+		uint32_t ui32Msb = 0, ui32Lsb = 0;
+		for ( uint32_t I = 0; I < 16; ++I ) {
+			uint32_t ui32X = I & 3, ui32Y = I >> 2;
+			uint32_t ui32Sub = ui32BestFlip ? (ui32Y >> 1) : (ui32X >> 1);
+			uint32_t ui32Index = ui8BestMap[ui32Sub][(ui32Selectors>>(I<<1))&3];
+			uint32_t ui32Bit = (ui32X << 2) + ui32Y;
+			ui32Msb |= (ui32Index >> 1) << ui32Bit;
+			ui32Lsb |= (ui32Index & 1) << ui32Bit;
+		}
+		_pui8Etc1[4] = static_cast<uint8_t>(ui32Msb >> 8);
+		_pui8Etc1[5] = static_cast<uint8_t>(ui32Msb);
+		_pui8Etc1[6] = static_cast<uint8_t>(ui32Lsb >> 8);
+		_pui8Etc1[7] = static_cast<uint8_t>(ui32Lsb);
+	}
+
+	/**
+	 * Fits an ETC1 intensity table to the palette entries used by a sub-block.
+	 *
+	 * \param _pi32Base The base color of the sub-block, expanded to 8 bits.
+	 * \param _pui8Palette The 4 DXT1 palette entries, 3 bytes each.
+	 * \param _pui32Counts How many times each palette entry is used by the sub-block.
+	 * \param _ui32Table The returned table index.
+	 * \param _pui8Map The returned ETC1 modifier index for each palette entry.
+	 * \return Returns the squared error of the best table.
+	 */
+	uint32_t LSE_CALL CTranscoder::FitEtc1Table( const int32_t * _pi32Base, const uint8_t * _pui8Palette, const uint32_t * _pui32Counts,
+		uint32_t &_ui32Table, uint8_t * _pui8Map ) {
+		// Modifiers in the order of the ETC1 index values.
+		static const int32_t i32Modifiers[8][4] = {
+			{ 2, 8, -2, -8 },
+			{ 5, 17, -5, -17 },
+			{ 9, 29, -9, -29 },
+			{ 13, 42, -13, -42 },
+			{ 18, 60, -18, -60 },
+			{ 24, 80, -24, -80 },
+			{ 33, 106, -33, -106 },
+			{ 47, 183, -47, -183 },
+		};
+		uint32_t ui32BestErr = ~0U;
+		_ui32Table = 0;
+		for ( uint32_t T = 0; T < 8; ++T ) {
+			uint32_t ui32Err = 0;
+			uint8_t ui8Map[4] = { 0 };
+			for ( uint32_t K = 0; K < 4; ++K ) {
+				if ( !_pui32Counts[K] ) { continue; }
+				uint32_t ui32EntryErr = ~0U;
+				for ( uint32_t M = 0; M < 4; ++M ) {
+					uint32_t ui32ThisErr = 0;
+					for ( uint32_t C = 0; C < 3; ++C ) {
+						int32_t i32Diff = CStd::Clamp<int32_t>( _pi32Base[C] + i32Modifiers[T][M], 0, 255 ) - _pui8Palette[K*3+C];
+						ui32ThisErr += static_cast<uint32_t>(i32Diff * i32Diff);
+					}
+					if ( ui32ThisErr < ui32EntryErr ) {
+						ui32EntryErr = ui32ThisErr;
+						ui8Map[K] = static_cast<uint8_t>(M);
+					}
+				}
+				ui32Err += ui32EntryErr * _pui32Counts[K];
+			}
+			if ( ui32Err < ui32BestErr ) {
+				ui32BestErr = ui32Err;
+				_ui32Table = T;
+				CStd::MemCpy( _pui8Map, ui8Map, sizeof( ui8Map ) );
+			}
+		}
+		return ui32BestErr;
+	}
+
+	/**
+	 * Job function for transcoding a range of bands.
+	 *
+	 * \param _ui32Begin Index of the first band to transcode, counting the bands of every slice in order.
+	 * \param _ui32End Index of the band after the last to transcode.
+	 * \param _pvParm Pointer to an LSI_TRANSCODE_JOB_DATA structure.
+	 */
+	void LSE_CALL CTranscoder::TranscodeRange( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm ) {
+		const LSI_TRANSCODE_JOB_DATA * ptjdData = static_cast<const LSI_TRANSCODE_JOB_DATA *>(_pvParm);
+		LSI_TRANSCODE_BAND_DATA tbdBand = ptjdData->tbdBand;
+		for ( uint32_t I = _ui32Begin; I < _ui32End; ++I ) {
+			uint32_t ui32Slice = I / ptjdData->ui32Bands;
+			tbdBand.pui8Src = ptjdData->pui8Src + ui32Slice * ptjdData->ui32SrcSlice;
+			tbdBand.pui8Dst = ptjdData->pui8Dst + ui32Slice * ptjdData->ui32DstSlice;
+			tbdBand.ui32StartRow = (I % ptjdData->ui32Bands) * LSI_TRANSCODE_ROWS;
+			tbdBand.ui32Rows = CStd::Min<uint32_t>( LSI_TRANSCODE_ROWS, ptjdData->ui32BlocksH - tbdBand.ui32StartRow );
+			TranscodeRows( tbdBand );
+		}
+	}
+
+}	// namespace lsi
@@ -0,0 +1,254 @@
+/**
+ * Copyright L. Spiro 2021
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Converts directly between block-compressed formats and between RGBA8 and block-compressed formats
+ *	one 4-by-4 block at a time, without first expanding the whole image to RGBA32F.
+ */
+
+
+#ifndef __LSI_TRANSCODER_H__
+#define __LSI_TRANSCODER_H__
+
+#include "../LSIImageLib.h"
+
+/** How many rows of blocks to give to a job at a time.  Small enough for a band of source and destination blocks to stay in the cache. */
+#define LSI_TRANSCODE_ROWS				8
+
+namespace lsi {
+
+	/**
+	 * Class CTranscoder
+	 * \brief Converts directly between block-compressed formats and between RGBA8 and block-compressed formats.
+	 *
+	 * Description: Converts directly between block-compressed formats and between RGBA8 and block-compressed formats
+	 *	one 4-by-4 block at a time, without first expanding the whole image to RGBA32F.  Each source block is decoded
+	 *	to 64 bytes of RGBA8 on the stack and immediately encoded to the destination format, so the only memory used is
+	 *	the source and destination images themselves.
+	 *
+	 * Supported formats are LSI_PF_R8G8B8A8, LSI_PF_DXT1, LSI_PF_DXT3, LSI_PF_DXT5, LSI_PF_BC4, LSI_PF_BC5, LSI_PF_ETC1,
+	 *	and the ETC2 RGB, punch-through alpha, and EAC formats (linear and sRGB).  sRGB formats are treated as storage
+	 *	only: texel values are carried across unchanged, so the source and destination should share a color space.
+	 *
+	 * DXT1 -> ETC1 has a dedicated path at LSI_TQ_FASTEST that reuses the DXT1 palette and selectors: the ETC1 base
+	 *	colors and intensity tables are fit to the (at most) 4 palette entries weighted by how often each is selected,
+	 *	and the selectors are remapped rather than searched per texel.
+	 */
+	class CTranscoder {
+	public :
+		// == Enumerations.
+		/** Encoding quality. */
+		enum LSI_TRANSCODE_QUALITY {
+			LSI_TQ_FASTEST,												/**< As LSI_TQ_FAST, but DXT1 -> ETC1 reuses the DXT1 endpoints and selectors. */
+			LSI_TQ_FAST,												/**< Range fit for DXT and the fast ETCPACK modes for ETC. */
+			LSI_TQ_NORMAL,												/**< The same encoders CImage uses when converting from RGBA32F. */
+		};
+
+
+		// == Types.
+		/** Options for transcoding. */
+		typedef struct LSI_TRANSCODE_OPTIONS {
+			/** Encoding quality. */
+			LSI_TRANSCODE_QUALITY			tqQuality;
+
+			/** Alpha cut-off for DXT1 images. */
+			float							fAlphaThresh;
+
+			/** Red weight. */
+			float							fRedWeight;
+
+			/** Green weight. */
+			float							fGreenWeight;
+
+			/** Blue weight. */
+			float							fBlueWeight;
+		} * LPLSI_TRANSCODE_OPTIONS, * const LPCLSI_TRANSCODE_OPTIONS;
+
+
+		// == Functions.
+		/**
+		 * Determines whether the given pair of formats can be transcoded directly.
+		 *
+		 * \param _pfSrc The source format.
+		 * \param _pfDst The destination format.
+		 * \return Returns true if both formats are supported by Transcode().
+		 */
+		static LSBOOL LSE_CALL				CanTranscode( LSI_PIXEL_FORMAT _pfSrc, LSI_PIXEL_FORMAT _pfDst );
+
+		/**
+		 * Gets the size of an image in one of the supported formats.
+		 *
+		 * \param _pfFormat The format.
+		 * \param _ui32Width Width of the image.
+		 * \param _ui32Height Height of the image.
+		 * \return Returns the size, in bytes, of a single slice of the image, or 0 if the format is not supported.
+		 */
+		static uint32_t LSE_CALL			GetSize( LSI_PIXEL_FORMAT _pfFormat, uint32_t _ui32Width, uint32_t _ui32Height );
+
+		/**
+		 * Transcodes an image from one format to another.  RGBA8 images are tightly packed; compressed images are stored
+		 *	as rows of blocks.
+		 *
+		 * \param _pui8Src The source texels.
+		 * \param _pfSrc The source format.
+		 * \param _pui8Dst The destination texels, which must be GetSize( _pfDst, _ui32Width, _ui32Height ) * _ui32Depth bytes.
+		 * \param _pfDst The destination format.
+		 * \param _ui32Width Width of the image.
+		 * \param _ui32Height Height of the image.
+		 * \param _ui32Depth Depth of the image.
+		 * \param _ptoOptions Optional transcoding options.  If NULL, LSI_TQ_NORMAL with the default weights is used.
+		 * \return Returns false if the pair of formats is not supported.
+		 */
+		static LSBOOL LSE_CALL				Transcode( const uint8_t * _pui8Src, LSI_PIXEL_FORMAT _pfSrc,
+			uint8_t * _pui8Dst, LSI_PIXEL_FORMAT _pfDst,
+			uint32_t _ui32Width, uint32_t _ui32Height, uint32_t _ui32Depth,
+			const LSI_TRANSCODE_OPTIONS * _ptoOptions = NULL );
+
+
+	protected :
+		// == Types.
+		/** A band of rows of blocks to transcode. */
+		typedef struct LSI_TRANSCODE_BAND_DATA {
+			/** The source slice. */
+			const uint8_t *					pui8Src;
+
+			/** The destination slice. */
+			uint8_t *						pui8Dst;
+
+			/** The source format. */
+			LSI_PIXEL_FORMAT				pfSrc;
+
+			/** The destination format. */
+			LSI_PIXEL_FORMAT				pfDst;
+
+			/** Image width. */
+			uint32_t						ui32Width;
+
+			/** Image height. */
+			uint32_t						ui32Height;
+
+			/** The first row of blocks to transcode. */
+			uint32_t						ui32StartRow;
+
+			/** The number of rows of blocks to transcode. */
+			uint32_t						ui32Rows;
+
+			/** The options. */
+			const LSI_TRANSCODE_OPTIONS *	ptoOptions;
+		} * LPLSI_TRANSCODE_BAND_DATA, * const LPCLSI_TRANSCODE_BAND_DATA;
+
+		/** Data passed to the jobs transcoding the bands of an image. */
+		typedef struct LSI_TRANSCODE_JOB_DATA {
+			/** The band settings shared by all bands.  The slices, start row, and row count are filled per band. */
+			LSI_TRANSCODE_BAND_DATA			tbdBand;
+
+			/** The source image. */
+			const uint8_t *					pui8Src;
+
+			/** The destination image. */
+			uint8_t *						pui8Dst;
+
+			/** Size of a source slice in bytes. */
+			uint32_t						ui32SrcSlice;
+
+			/** Size of a destination slice in bytes. */
+			uint32_t						ui32DstSlice;
+
+			/** Height of the image in blocks. */
+			uint32_t						ui32BlocksH;
+
+			/** Number of bands in each slice. */
+			uint32_t						ui32Bands;
+		} * LPLSI_TRANSCODE_JOB_DATA, * const LPCLSI_TRANSCODE_JOB_DATA;
+
+
+		// == Functions.
+		/**
+		 * Gets the size of a block in a supported compressed format.
+		 *
+		 * \param _pfFormat The format.
+		 * \return Returns 8 or 16 for supported compressed formats, 0 for LSI_PF_R8G8B8A8 and unsupported formats.
+		 */
+		static uint32_t LSE_CALL			BlockSize( LSI_PIXEL_FORMAT _pfFormat );
+
+		/**
+		 * Transcodes a band of rows of blocks.
+		 *
+		 * \param _tbdData The band to transcode.
+		 */
+		static void LSE_CALL				TranscodeRows( const LSI_TRANSCODE_BAND_DATA &_tbdData );
+
+		/**
+		 * Decodes a single block to RGBA8.
+		 *
+		 * \param _pfSrc The source format.
+		 * \param _pui8Src The source image.
+		 * \param _ui32Width Width of the source image.
+		 * \param _ui32Height Height of the source image.
+		 * \param _ui32X The X coordinate of the block, in blocks.
+		 * \param _ui32Y The Y coordinate of the block, in blocks.
+		 * \param _pui8Rgba The returned block, 16 texels in R, G, B, A byte order, row by row.  Texels outside of
+		 *	the image repeat the nearest edge texel.
+		 */
+		static void LSE_CALL				DecodeBlock( LSI_PIXEL_FORMAT _pfSrc, const uint8_t * _pui8Src,
+			uint32_t _ui32Width, uint32_t _ui32Height, uint32_t _ui32X, uint32_t _ui32Y, uint8_t * _pui8Rgba );
+
+		/**
+		 * Encodes a single block from RGBA8.
+		 *
+		 * \param _pfDst The destination format.
+		 * \param _pui8Rgba The block, 16 texels in R, G, B, A byte order, row by row.
+		 * \param _ui32Mask Bit N is set if texel N is inside the image.
+		 * \param _pui8Dst The destination image.
+		 * \param _ui32Width Width of the destination image.
+		 * \param _ui32Height Height of the destination image.
+		 * \param _ui32X The X coordinate of the block, in blocks.
+		 * \param _ui32Y The Y coordinate of the block, in blocks.
+		 * \param _toOptions The options.
+		 */
+		static void LSE_CALL				EncodeBlock( LSI_PIXEL_FORMAT _pfDst, const uint8_t * _pui8Rgba, uint32_t _ui32Mask,
+			uint8_t * _pui8Dst, uint32_t _ui32Width, uint32_t _ui32Height, uint32_t _ui32X, uint32_t _ui32Y,
+			const LSI_TRANSCODE_OPTIONS &_toOptions );
+
+		/**
+		 * Converts a DXT1 block to an ETC1 block by fitting ETC1 base colors and intensity tables to the DXT1 palette
+		 *	and remapping the DXT1 selectors.
+		 *
+		 * \param _pui8Dxt1 The 8-byte DXT1 block.
+		 * \param _pui8Etc1 The returned 8-byte ETC1 block.
+		 */
+		static void LSE_CALL				Dxt1ToEtc1( const uint8_t * _pui8Dxt1, uint8_t * _pui8Etc1 );
+
+		/**
+		 * Fits an ETC1 intensity table to the palette entries used by a sub-block.
+		 *
+		 * \param _pi32Base The base color of the sub-block, expanded to 8 bits.
+		 * \param _pui8Palette The 4 DXT1 palette entries, 3 bytes each.
+		 * \param _pui32Counts How many times each palette entry is used by the sub-block.
+		 * \param _ui32Table The returned table index.
+		 * \param _pui8Map The returned ETC1 modifier index for each palette entry.
+		 * \return Returns the squared error of the best table.
+		 */
+		static uint32_t LSE_CALL			FitEtc1Table( const int32_t * _pi32Base, const uint8_t * _pui8Palette, const uint32_t * _pui32Counts,
+			uint32_t &_ui32Table, uint8_t * _pui8Map );
+
+		/**
+		 * Job function for transcoding a range of bands.
+		 *
+		 * \param _ui32Begin Index of the first band to transcode, counting the bands of every slice in order.
+		 * \param _ui32End Index of the band after the last to transcode.
+		 * \param _pvParm Pointer to an LSI_TRANSCODE_JOB_DATA structure.
+		 */
+		static void LSE_CALL				TranscodeRange( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm );
+	};
+
+}	// namespace lsi
+
+#endif	// __LSI_TRANSCODER_H__
@@ -0,0 +1,380 @@
+/**
+ * Copyright L. Spiro 2021
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Checks that the CSimdConvert kernels produce exactly the same bits as CImageLib's generic per-texel
+ *	converters.  Every pair of formats (and gamma conversion) with a kernel is run on every 16-bit source texel or on
+ *	a mix of edge-case and random texels, at every length up to a few blocks so that the leftover texels are covered,
+ *	with the kernels the CPU selects and, where a wider kernel was selected, with the 128-bit kernels as well.  The
+ *	swizzles are checked in all 24 component orders, with the portable permutation as well.  Build it with
+ *	LSImageLib and its dependencies.  Returns 0 if all tests pass.
+ */
+
+#include "LSIImageLib.h"
+#include "SimdConvert/LSISimdConvert.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace ::lsi;
+
+/** The number of texels converted at once.  All 16-bit values plus a partial block. */
+#define LSI_TEXELS					(0x10000 + LSI_SIMD_BLOCK / 2 + 1)
+
+/** The largest length tested texel-by-texel. */
+#define LSI_MAX_TAIL				(LSI_SIMD_BLOCK * 3)
+
+/** The value written past the end of the destination to catch overruns. */
+#define LSI_GUARD					0xEE
+
+
+/**
+ * Class CSimdConvertTest
+ * \brief Exposes the kernel selection of CSimdConvert.
+ *
+ * Description: Exposes the kernel selection of CSimdConvert so that the generic converters can be run for reference
+ *	and each implementation of a kernel can be tested.
+ */
+class CSimdConvertTest : public CSimdConvert {
+public :
+	// == Functions.
+	/**
+	 * Enables or disables the kernels.  While disabled, CImageLib converts texel-by-texel.
+	 *
+	 * \param _bEnable Whether to enable the kernels.
+	 */
+	static void LSE_CALL				Enable( LSBOOL _bEnable ) {
+		m_bSelected = _bEnable;
+	}
+
+	/**
+	 * Gets the number of sets of kernels that can be tested on this CPU.
+	 *
+	 * \return Returns the number of sets of kernels.
+	 */
+	static uint32_t LSE_CALL			Sets() {
+		SaveSelected();
+#ifdef LSSTD_SIMD_SSE2
+		// The 128-bit kernels are replaced by the AVX2 kernels if the CPU has them.
+		if ( m_pfSelected[LSI_SK_RGBA8_TO_RGBA32F] == Rgba8ToRgba32F256 ) { return 2; }
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		return 1;
+	}
+
+	/**
+	 * Selects a set of kernels.  Set 0 is the set the CPU selected and set 1 replaces the AVX2 kernels with the
+	 *	128-bit kernels.
+	 *
+	 * \param _ui32Set The set of kernels to select.
+	 * \return Returns the name of the set.
+	 */
+	static const char * LSE_CALL		SelectSet( uint32_t _ui32Set ) {
+		SaveSelected();
+		CStd::MemCpy( m_pfKernels, m_pfSelected, sizeof( m_pfKernels ) );
+		m_pfPermute = m_pfSelectedPermute;
+#ifdef LSSTD_SIMD_SSE2
+		if ( _ui32Set == 1 ) {
+			m_pfKernels[LSI_SK_RGBA8_TO_RGBA32F] = Rgba8ToRgba32F128;
+			m_pfKernels[LSI_SK_RGBA32F_TO_RGBA8] = Rgba32FToRgba8128;
+			m_pfPermute = Permute128;
+			return "128-bit";
+		}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		return "selected";
+	}
+
+	/**
+	 * Selects the portable byte-permutation kernel.
+	 */
+	static void LSE_CALL				SelectPortablePermute() {
+		SaveSelected();
+		m_pfPermute = PermuteScalar;
+	}
+
+	/**
+	 * Gets the smallest float color component that converts to the given LSI_PF_R8G8B8A8 value.
+	 *
+	 * \param _gGamma LSI_G_sRGB or LSI_G_LINEAR.
+	 * \param _ui32Val The value, from 1 to 255.
+	 * \return Returns the smallest float that converts to _ui32Val.
+	 */
+	static float LSE_CALL				Threshold( LSI_GAMMA _gGamma, uint32_t _ui32Val ) {
+		return m_fRgba32FToRgba8[_gGamma][_ui32Val];
+	}
+
+
+protected :
+	// == Members.
+	/** The kernels the CPU selected. */
+	static PfKernel						m_pfSelected[LSI_SK_TOTAL];
+
+	/** The byte-permutation kernel the CPU selected. */
+	static PfPermute					m_pfSelectedPermute;
+
+	/** Set once the selected kernels are saved. */
+	static LSBOOL						m_bSaved;
+
+
+	// == Functions.
+	/**
+	 * Saves the kernels the CPU selected.
+	 */
+	static void LSE_CALL				SaveSelected() {
+		if ( !m_bSaved ) {
+			CStd::MemCpy( m_pfSelected, m_pfKernels, sizeof( m_pfKernels ) );
+			m_pfSelectedPermute = m_pfPermute;
+			m_bSaved = true;
+		}
+	}
+};
+
+CSimdConvertTest::PfKernel CSimdConvertTest::m_pfSelected[LSI_SK_TOTAL] = { NULL };
+CSimdConvertTest::PfPermute CSimdConvertTest::m_pfSelectedPermute = NULL;
+LSBOOL CSimdConvertTest::m_bSaved = false;
+
+/** A conversion that has a kernel. */
+typedef struct LSI_TEST_PAIR {
+	/** The source format. */
+	LSI_PIXEL_FORMAT				pfSrc;
+
+	/** The destination format. */
+	LSI_PIXEL_FORMAT				pfDst;
+
+	/** The gamma conversion. */
+	LSI_GAMMA						gGamma;
+
+	/** The name of the conversion, for printing. */
+	const char *					pcName;
+} * LPLSI_TEST_PAIR, * const LPCLSI_TEST_PAIR;
+
+/** Every conversion that has a kernel. */
+static const LSI_TEST_PAIR g_tpPairs[] = {
+	{ LSI_PF_R8G8B8A8, LSI_PF_R32G32B32A32F, LSI_G_NONE, "R8G8B8A8 -> R32G32B32A32F" },
+	{ LSI_PF_R8G8B8A8, LSI_PF_R32G32B32A32F, LSI_G_sRGB, "R8G8B8A8 -> R32G32B32A32F (sRGB)" },
+	{ LSI_PF_R8G8B8A8, LSI_PF_R32G32B32A32F, LSI_G_LINEAR, "R8G8B8A8 -> R32G32B32A32F (linear)" },
+	{ LSI_PF_R32G32B32A32F, LSI_PF_R8G8B8A8, LSI_G_NONE, "R32G32B32A32F -> R8G8B8A8" },
+	{ LSI_PF_R32G32B32A32F, LSI_PF_R8G8B8A8, LSI_G_sRGB, "R32G32B32A32F -> R8G8B8A8 (sRGB)" },
+	{ LSI_PF_R32G32B32A32F, LSI_PF_R8G8B8A8, LSI_G_LINEAR, "R32G32B32A32F -> R8G8B8A8 (linear)" },
+	{ LSI_PF_R8G8B8A8, LSI_PF_R8G8B8A8, LSI_G_sRGB, "R8G8B8A8 -> R8G8B8A8 (sRGB)" },
+	{ LSI_PF_R8G8B8A8, LSI_PF_R8G8B8A8, LSI_G_LINEAR, "R8G8B8A8 -> R8G8B8A8 (linear)" },
+	{ LSI_PF_R5G6B5, LSI_PF_R8G8B8A8, LSI_G_NONE, "R5G6B5 -> R8G8B8A8" },
+	{ LSI_PF_R8G8B8A8, LSI_PF_R5G6B5, LSI_G_NONE, "R8G8B8A8 -> R5G6B5" },
+	{ LSI_PF_R4G4B4A4, LSI_PF_R8G8B8A8, LSI_G_NONE, "R4G4B4A4 -> R8G8B8A8" },
+	{ LSI_PF_R8G8B8A8, LSI_PF_R4G4B4A4, LSI_G_NONE, "R8G8B8A8 -> R4G4B4A4" },
+	{ LSI_PF_R16G16B16A16F, LSI_PF_R32G32B32A32F, LSI_G_NONE, "R16G16B16A16F -> R32G32B32A32F" },
+	{ LSI_PF_R32G32B32A32F, LSI_PF_R16G16B16A16F, LSI_G_NONE, "R32G32B32A32F -> R16G16B16A16F" },
+};
+
+/** The source texels, the reference result, and the kernel result, over-allocated by 8 bytes for the generic
+ *	converters. */
+static uint8_t g_ui8Src[LSI_TEXELS*LSI_SIMD_MAX_TEXEL+8];
+static uint8_t g_ui8Ref[LSI_TEXELS*LSI_SIMD_MAX_TEXEL+8];
+static uint8_t g_ui8Simd[LSI_TEXELS*LSI_SIMD_MAX_TEXEL+8];
+
+/** The state of the random-number generator. */
+static uint32_t g_ui32Seed = 1;
+
+/**
+ * Gets a pseudo-random number.
+ *
+ * \return Returns a pseudo-random 32-bit number.
+ */
+static uint32_t LSE_CALL Rand() {
+	uint32_t ui32Hi = (g_ui32Seed = g_ui32Seed * 1103515245 + 12345) >> 16;
+	uint32_t ui32Lo = (g_ui32Seed = g_ui32Seed * 1103515245 + 12345) >> 16;
+	return (ui32Hi << 16) | ui32Lo;
+}
+
+/**
+ * Makes a float from its bits.
+ *
+ * \param _ui32Bits The bits of the float.
+ * \return Returns the float.
+ */
+static float LSE_CALL Float( uint32_t _ui32Bits ) {
+	float fRet;
+	CStd::MemCpy( &fRet, &_ui32Bits, sizeof( fRet ) );
+	return fRet;
+}
+
+/**
+ * Fills g_ui8Src with texels of the given format.  16-bit texels take every value, 8-bit components take every
+ *	value before the rest are random, and floats are the edge cases of each conversion followed by random values.
+ *
+ * \param _tpPair The conversion whose source texels are to be made.
+ */
+static void LSE_CALL MakeSource( const LSI_TEST_PAIR &_tpPair ) {
+	switch ( _tpPair.pfSrc ) {
+		case LSI_PF_R5G6B5 :
+		case LSI_PF_R4G4B4A4 : {
+			uint16_t * pui16Src = reinterpret_cast<uint16_t *>(g_ui8Src);
+			for ( uint32_t I = 0; I < LSI_TEXELS; ++I ) { pui16Src[I] = static_cast<uint16_t>(I); }
+			break;
+		}
+		case LSI_PF_R16G16B16A16F : {
+			// Every half in every component.
+			uint16_t * pui16Src = reinterpret_cast<uint16_t *>(g_ui8Src);
+			for ( uint32_t I = 0; I < LSI_TEXELS; ++I ) {
+				for ( uint32_t J = 0; J < 4; ++J ) { pui16Src[I*4+J] = static_cast<uint16_t>(I + J * 0x4000); }
+			}
+			break;
+		}
+		case LSI_PF_R32G32B32A32F : {
+			float * pfSrc = reinterpret_cast<float *>(g_ui8Src);
+			uint32_t ui32Total = 0;
+			static const uint32_t ui32Special[] = {
+				0x00000000, 0x80000000, 0x00000001, 0x807FFFFF, 0x00800000, 0x3F000000, 0x3EFFFFFF, 0x3F800000,
+				0x3F7FFFFF, 0x3F800001, 0xBF800000, 0x477FE000, 0x477FF000, 0x477FEFFF, 0x33800000, 0x33000000,
+				0x7F7FFFFF, 0xFF7FFFFF, 0x7F800000, 0xFF800000, 0x4B000000, 0x4F000000, 0xCF000000, 0x38800000,
+			};
+			for ( uint32_t I = 0; I < LSE_ELEMENTS( ui32Special ); ++I ) { pfSrc[ui32Total++] = Float( ui32Special[I] ); }
+			// Every step of each gamma conversion and the float just below it.
+			for ( uint32_t G = LSI_G_sRGB; G <= LSI_G_LINEAR; ++G ) {
+				for ( uint32_t I = 1; I < 256; ++I ) {
+					float fThis = CSimdConvertTest::Threshold( static_cast<LSI_GAMMA>(G), I );
+					uint32_t ui32Bits;
+					CStd::MemCpy( &ui32Bits, &fThis, sizeof( ui32Bits ) );
+					pfSrc[ui32Total++] = fThis;
+					pfSrc[ui32Total++] = Float( ui32Bits - 1 );
+				}
+			}
+			// Every step of the non-gamma conversion, halfway between 2 values.
+			for ( uint32_t I = 0; I < 256; ++I ) { pfSrc[ui32Total++] = (I + 0.5f) / 255.0f; }
+			while ( ui32Total < LSI_TEXELS * 4 ) {
+				uint32_t ui32Bits = Rand();
+				if ( (ui32Total & 1) ) {
+					pfSrc[ui32Total++] = static_cast<float>(ui32Bits % 3000) / 2000.0f - 0.25f;
+					continue;
+				}
+				// NaN has no defined integer value, so it is only used when converting to half floats.
+				if ( (ui32Bits & 0x7FFFFFFF) > 0x7F800000 && _tpPair.pfDst != LSI_PF_R16G16B16A16F ) { continue; }
+				pfSrc[ui32Total++] = Float( ui32Bits );
+			}
+			break;
+		}
+		default : {
+			uint32_t * pui32Src = reinterpret_cast<uint32_t *>(g_ui8Src);
+			for ( uint32_t I = 0; I < LSI_TEXELS; ++I ) {
+				pui32Src[I] = I < 256 ? I * 0x01010101 : Rand();
+			}
+		}
+	}
+}
+
+/**
+ * Converts the given number of texels with the generic converters and with the kernels, and compares them.
+ *
+ * \param _tpPair The conversion to test.
+ * \param _ui32Total The number of texels to convert.
+ * \param _pcSet The name of the set of kernels, for printing.
+ * \return Returns true if the results match and the kernels wrote nothing past the end of the destination.
+ */
+static LSBOOL LSE_CALL Compare( const LSI_TEST_PAIR &_tpPair, uint32_t _ui32Total, const char * _pcSet ) {
+	uint32_t ui32Size = _ui32Total * CImageLib::GetFormatSize( _tpPair.pfDst );
+	CSimdConvertTest::Enable( false );
+	CImageLib::BatchAnyTexelToAnytexel( _tpPair.pfSrc, g_ui8Src, _tpPair.pfDst, g_ui8Ref, _ui32Total, _tpPair.gGamma );
+	CSimdConvertTest::Enable( true );
+
+	std::memset( g_ui8Simd, LSI_GUARD, ui32Size + 8 );
+	if ( !CSimdConvert::Convert( _tpPair.pfSrc, g_ui8Src, _tpPair.pfDst, g_ui8Simd, _ui32Total, _tpPair.gGamma ) ) {
+		// This CPU has no kernel for the conversion.
+		return true;
+	}
+	for ( uint32_t I = 0; I < ui32Size; ++I ) {
+		if ( g_ui8Simd[I] != g_ui8Ref[I] ) {
+			::printf( "FAILED: %s, %s kernels, %u texels: texel %u differs.\r\n", _tpPair.pcName, _pcSet, _ui32Total,
+				I / CImageLib::GetFormatSize( _tpPair.pfDst ) );
+			return false;
+		}
+	}
+	for ( uint32_t I = ui32Size; I < ui32Size + 8; ++I ) {
+		if ( g_ui8Simd[I] != LSI_GUARD ) {
+			::printf( "FAILED: %s, %s kernels, %u texels: wrote past the end.\r\n", _tpPair.pcName, _pcSet, _ui32Total );
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Checks the swizzles in every component order against a byte-by-byte reference.
+ *
+ * \param _pcSet The name of the set of kernels, for printing.
+ * \return Returns the number of failures.
+ */
+static uint32_t LSE_CALL TestSwizzles( const char * _pcSet ) {
+	uint32_t ui32Fails = 0;
+	for ( uint32_t ui32Order = 0; ui32Order < 256; ++ui32Order ) {
+		uint32_t R = ui32Order & 3, G = (ui32Order >> 2) & 3, B = (ui32Order >> 4) & 3, A = ui32Order >> 6;
+		if ( R == G || R == B || R == A || G == B || G == A || B == A ) { continue; }
+		for ( uint32_t ui32Total = 0; ui32Total <= LSI_MAX_TAIL + 1; ++ui32Total ) {
+			for ( uint32_t I = 0; I < ui32Total; ++I ) {
+				const uint8_t * pui8Src = &g_ui8Src[I*4];
+				uint32_t ui32Texel = LSI_MAKE_RGBA( pui8Src[R], pui8Src[G], pui8Src[B], pui8Src[A] );
+				CStd::MemCpy( &g_ui8Ref[I*4], &ui32Texel, sizeof( ui32Texel ) );
+			}
+			std::memset( g_ui8Simd, LSI_GUARD, ui32Total * 4 + 8 );
+			CSimdConvert::SwizzleToRgba8( g_ui8Src, R, G, B, A, g_ui8Simd, ui32Total );
+			if ( std::memcmp( g_ui8Simd, g_ui8Ref, ui32Total * 4 ) != 0 || g_ui8Simd[ui32Total*4] != LSI_GUARD ) {
+				::printf( "FAILED: SwizzleToRgba8( %u, %u, %u, %u ), %s kernels, %u texels.\r\n", R, G, B, A, _pcSet, ui32Total );
+				++ui32Fails;
+			}
+
+			// Back to the original order.
+			std::memset( g_ui8Ref, LSI_GUARD, ui32Total * 4 + 8 );
+			CSimdConvert::SwizzleFromRgba8( g_ui8Simd, R, G, B, A, g_ui8Ref, ui32Total );
+			if ( std::memcmp( g_ui8Ref, g_ui8Src, ui32Total * 4 ) != 0 || g_ui8Ref[ui32Total*4] != LSI_GUARD ) {
+				::printf( "FAILED: SwizzleFromRgba8( %u, %u, %u, %u ), %s kernels, %u texels.\r\n", R, G, B, A, _pcSet, ui32Total );
+				++ui32Fails;
+			}
+		}
+	}
+	return ui32Fails;
+}
+
+/**
+ * The main entrypoint for this program.
+ *
+ * \return Returns 0 if all tests pass, 1 otherwise.
+ */
+int LSE_CCALL main() {
+	uint32_t ui32Fails = 0;
+	uint32_t ui32Sets = CSimdConvertTest::Sets();
+	for ( uint32_t S = 0; S < ui32Sets; ++S ) {
+		const char * pcSet = CSimdConvertTest::SelectSet( S );
+		for ( uint32_t I = 0; I < LSE_ELEMENTS( g_tpPairs ); ++I ) {
+			MakeSource( g_tpPairs[I] );
+			if ( !Compare( g_tpPairs[I], LSI_TEXELS, pcSet ) ) {
+				++ui32Fails;
+				continue;
+			}
+			// Short lengths go partly or entirely through the padded block for leftover texels.
+			for ( uint32_t ui32Total = 0; ui32Total <= LSI_MAX_TAIL; ++ui32Total ) {
+				if ( !Compare( g_tpPairs[I], ui32Total, pcSet ) ) {
+					++ui32Fails;
+					break;
+				}
+			}
+		}
+
+		for ( uint32_t I = 0; I < (LSI_MAX_TAIL + 2) * 4; ++I ) { g_ui8Src[I] = static_cast<uint8_t>(Rand()); }
+		ui32Fails += TestSwizzles( pcSet );
+	}
+	CSimdConvertTest::SelectSet( 0 );
+	CSimdConvertTest::SelectPortablePermute();
+	ui32Fails += TestSwizzles( "portable" );
+	CSimdConvertTest::SelectSet( 0 );
+
+	if ( ui32Fails ) {
+		::printf( "%u failures.\r\n", ui32Fails );
+		return 1;
+	}
+	::printf( "All tests passed.\r\n" );
+	return 0;
+}
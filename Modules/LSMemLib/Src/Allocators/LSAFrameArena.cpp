@@ -0,0 +1,295 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A scratch allocator for data that lives for at most a frame or two.  Each thread allocates from
+ *	the top of its own chunks without locking, and nothing is freed individually: a thread can rewind to a marker
+ *	it took earlier, and whole frames are recycled by NextFrame().  Allocations are double-buffered, so anything
+ *	allocated during a frame stays valid until the end of the following frame.
+ */
+
+#include "LSAFrameArena.h"
+
+
+namespace lsa {
+
+	// == Members.
+	/** The source of arena IDs. */
+	CAtomic::ATOM CFrameArena::m_aNextId = 0;
+
+	/** The ID of the arena whose allocations the calling thread used last. */
+	LSE_THREAD_LOCAL CAtomic::ATOM CFrameArena::m_aThreadId = 0;
+
+	/** The calling thread's allocations in the arena whose ID is m_aThreadId. */
+	LSE_THREAD_LOCAL CFrameArena::LSA_FA_THREAD * CFrameArena::m_ptThread = NULL;
+
+	/** Its address identifies the calling thread. */
+	LSE_THREAD_LOCAL uint8_t CFrameArena::m_ui8ThreadKey = 0;
+
+	// == Various constructors.
+	LSE_CALLCTOR CFrameArena::CFrameArena( LSA_SIZE _sChunkSize ) :
+		m_ptHead( NULL ),
+		m_ui32Frame( 0 ),
+		m_sChunkSize( _sChunkSize ),
+		m_sReserved( 0 ),
+		m_ui32Chunks( 0 ),
+		m_sFrameHighWater( 0 ),
+		m_sThreadHighWater( 0 ),
+		m_aId( CAtomic::InterlockedIncrement( m_aNextId ) ) {
+	}
+	LSE_CALLCTOR CFrameArena::~CFrameArena() {
+		Reset();
+	}
+
+	// == Functions.
+	/**
+	 * Resizes the calling thread's last allocation in place.  Fails if anything has been allocated after it or if
+	 *	its chunk does not have room for the new size.
+	 *
+	 * \param _pvAddr The last allocation made by the calling thread.
+	 * \param _sOldSize The size with which it was allocated or last resized.
+	 * \param _sNewSize The new size.
+	 * \return Returns true if the allocation was resized.
+	 */
+	LSBOOL LSE_CALL CFrameArena::ReAllocLast( void * _pvAddr, LSA_SIZE _sOldSize, LSA_SIZE _sNewSize ) {
+		LSA_FA_FRAME * pfFrame = ThreadFrame();
+		if ( !pfFrame || !_pvAddr ) { return false; }
+		uint8_t * pui8Addr = static_cast<uint8_t *>(_pvAddr);
+		if ( pfFrame->pui8Pos != pui8Addr + _sOldSize ) { return false; }
+		if ( _sNewSize > _sOldSize ) {
+			if ( _sNewSize - _sOldSize > static_cast<LSA_SIZE>(pfFrame->pui8End - pfFrame->pui8Pos) ) { return false; }
+		}
+		else {
+			// Shrinking lowers the usage, so keep the peak first.
+			pfFrame->sPeak = CStd::Max( pfFrame->sPeak, Used( (*pfFrame) ) );
+		}
+		pfFrame->pui8Pos = pui8Addr + _sNewSize;
+		return true;
+	}
+
+	/**
+	 * Gets the calling thread's current position, to which it can later rewind.
+	 *
+	 * \return Returns a marker to pass to Rewind().
+	 */
+	CFrameArena::LSA_FA_MARKER LSE_CALL CFrameArena::GetMarker() {
+		LSA_FA_MARKER mRet;
+		mRet.ui32Frame = m_ui32Frame;
+		LSA_FA_FRAME * pfFrame = ThreadFrame();
+		if ( !pfFrame ) {
+			mRet.pvChunk = NULL;
+			mRet.pui8Pos = NULL;
+			mRet.sUsedBefore = 0;
+			return mRet;
+		}
+		mRet.pvChunk = pfFrame->pcCur;
+		mRet.pui8Pos = pfFrame->pui8Pos;
+		mRet.sUsedBefore = pfFrame->sUsedBefore;
+		return mRet;
+	}
+
+	/**
+	 * Releases everything the calling thread allocated after taking the given marker.  The marker must have been
+	 *	taken by the calling thread during the current frame.
+	 *
+	 * \param _mMarker The marker to which to rewind.
+	 */
+	void LSE_CALL CFrameArena::Rewind( const LSA_FA_MARKER &_mMarker ) {
+		assert( _mMarker.ui32Frame == m_ui32Frame );
+		if ( _mMarker.ui32Frame != m_ui32Frame ) { return; }
+		LSA_FA_FRAME * pfFrame = ThreadFrame();
+		if ( !pfFrame ) { return; }
+
+		// Usage only grows between rewinds, so the peak can only have been reached just before one.
+		pfFrame->sPeak = CStd::Max( pfFrame->sPeak, Used( (*pfFrame) ) );
+		if ( !_mMarker.pvChunk ) {
+			// Taken before the thread had any chunks.
+			ClearFrame( (*pfFrame) );
+			return;
+		}
+		// The chunks after the marker's chunk stay linked and are reused as the thread allocates again.
+		pfFrame->pcCur = static_cast<LSA_FA_CHUNK *>(_mMarker.pvChunk);
+		pfFrame->pui8Pos = _mMarker.pui8Pos;
+		pfFrame->pui8End = pfFrame->pcCur->pui8End;
+		pfFrame->sUsedBefore = _mMarker.sUsedBefore;
+	}
+
+	/**
+	 * Begins a new frame.  The allocations of the frame LSA_FA_FRAMES frames ago become invalid and their
+	 *	RAM is reused.
+	 */
+	void LSE_CALL CFrameArena::NextFrame() {
+		CCriticalSection::CLocker lLock( m_csThreads );
+		uint32_t ui32Slot = m_ui32Frame % LSA_FA_FRAMES;
+		LSA_SIZE sTotal = 0;
+		for ( LSA_FA_THREAD * ptThis = m_ptHead; ptThis; ptThis = ptThis->ptNext ) {
+			LSA_SIZE sPeak = CStd::Max( ptThis->fFrames[ui32Slot].sPeak, Used( ptThis->fFrames[ui32Slot] ) );
+			m_sThreadHighWater = CStd::Max( m_sThreadHighWater, sPeak );
+			sTotal += sPeak;
+		}
+		m_sFrameHighWater = CStd::Max( m_sFrameHighWater, sTotal );
+
+		++m_ui32Frame;
+		ui32Slot = m_ui32Frame % LSA_FA_FRAMES;
+		for ( LSA_FA_THREAD * ptThis = m_ptHead; ptThis; ptThis = ptThis->ptNext ) {
+			ClearFrame( ptThis->fFrames[ui32Slot] );
+			ptThis->fFrames[ui32Slot].sPeak = 0;
+		}
+	}
+
+	/**
+	 * Releases all RAM back to the OS.  All allocations become invalid.
+	 */
+	void LSE_CALL CFrameArena::Reset() {
+		CCriticalSection::CLocker lLock( m_csThreads );
+		// Threads that still point to the released allocations will see the new ID and look them up again.
+		m_aId = CAtomic::InterlockedIncrement( m_aNextId );
+
+		LSA_FA_THREAD * ptNext;
+		for ( LSA_FA_THREAD * ptThis = m_ptHead; ptThis; ptThis = ptNext ) {
+			ptNext = ptThis->ptNext;
+			for ( uint32_t I = LSA_FA_FRAMES; I--; ) {
+				LSA_FA_CHUNK * pcNext;
+				for ( LSA_FA_CHUNK * pcThis = ptThis->fFrames[I].pcHead; pcThis; pcThis = pcNext ) {
+					pcNext = pcThis->pcNext;
+					COsHeap::Free( pcThis );
+				}
+			}
+			COsHeap::Free( ptThis );
+		}
+		m_ptHead = NULL;
+		m_ui32Frame = 0;
+		m_sReserved = 0;
+		m_ui32Chunks = 0;
+		m_sFrameHighWater = 0;
+		m_sThreadHighWater = 0;
+	}
+
+	/**
+	 * Gets usage statistics.
+	 *
+	 * \param _fsStats Filled with the statistics.
+	 */
+	void LSE_CALL CFrameArena::GetStats( LSA_FA_STATS &_fsStats ) const {
+		CCriticalSection::CLocker lLock( m_csThreads );
+		uint32_t ui32Slot = m_ui32Frame % LSA_FA_FRAMES;
+		_fsStats.sUsed = 0;
+		_fsStats.sThreadHighWater = m_sThreadHighWater;
+		_fsStats.ui32Threads = 0;
+		// Include the frame in progress.
+		LSA_SIZE sTotal = 0;
+		for ( const LSA_FA_THREAD * ptThis = m_ptHead; ptThis; ptThis = ptThis->ptNext ) {
+			LSA_SIZE sUsed = Used( ptThis->fFrames[ui32Slot] );
+			LSA_SIZE sPeak = CStd::Max( ptThis->fFrames[ui32Slot].sPeak, sUsed );
+			_fsStats.sUsed += sUsed;
+			_fsStats.sThreadHighWater = CStd::Max( _fsStats.sThreadHighWater, sPeak );
+			sTotal += sPeak;
+			++_fsStats.ui32Threads;
+		}
+		_fsStats.sFrameHighWater = CStd::Max( m_sFrameHighWater, sTotal );
+		_fsStats.sReserved = m_sReserved;
+		_fsStats.ui32Chunks = m_ui32Chunks;
+		_fsStats.ui32Frame = m_ui32Frame;
+	}
+
+	/**
+	 * Finds or creates the calling thread's allocations.
+	 *
+	 * \return Returns the calling thread's allocations or NULL if there is not enough RAM to create them.
+	 */
+	CFrameArena::LSA_FA_THREAD * LSE_CALL CFrameArena::FindThread() {
+		CCriticalSection::CLocker lLock( m_csThreads );
+		LSA_FA_THREAD * ptThread = NULL;
+		for ( LSA_FA_THREAD * ptThis = m_ptHead; ptThis; ptThis = ptThis->ptNext ) {
+			if ( ptThis->pvThread == &m_ui8ThreadKey ) {
+				ptThread = ptThis;
+				break;
+			}
+		}
+		if ( !ptThread ) {
+			ptThread = static_cast<LSA_FA_THREAD *>(COsHeap::Alloc( sizeof( LSA_FA_THREAD ) ));
+			if ( !ptThread ) { return NULL; }
+			for ( uint32_t I = LSA_FA_FRAMES; I--; ) {
+				ptThread->fFrames[I].pcHead = NULL;
+				ClearFrame( ptThread->fFrames[I] );
+				ptThread->fFrames[I].sPeak = 0;
+			}
+			ptThread->pvThread = &m_ui8ThreadKey;
+			ptThread->ptNext = m_ptHead;
+			m_ptHead = ptThread;
+		}
+		m_aThreadId = m_aId;
+		m_ptThread = ptThread;
+		return ptThread;
+	}
+
+	/**
+	 * Allocates from a new chunk when the current one is full.
+	 *
+	 * \param _pfFrame The calling thread's allocations in the current frame.
+	 * \param _sSize Amount of RAM to allocate.
+	 * \param _ui32Align Alignment of the RAM to allocate.
+	 * \return Returns the allocated RAM or NULL if there is not enough RAM available to make the allocation.
+	 */
+	void * LSE_CALL CFrameArena::AllocSlow( LSA_FA_FRAME * _pfFrame, LSA_SIZE _sSize, uint32_t _ui32Align ) {
+		LSA_SIZE sNeeded = _sSize + _ui32Align;
+		if ( sNeeded < _sSize ) { return NULL; }
+
+		// Use the next chunk if it was left by an earlier frame or a rewind and is large enough.
+		LSA_FA_CHUNK * pcNext = _pfFrame->pcCur ? _pfFrame->pcCur->pcNext : NULL;
+		if ( !pcNext || static_cast<LSA_SIZE>(pcNext->pui8End - ChunkStart( pcNext )) < sNeeded ) {
+			LSA_SIZE sHeader = LSE_ROUND_UP( sizeof( LSA_FA_CHUNK ), LSA_MIN_ALIGN );
+			LSA_SIZE sSize = m_sChunkSize;
+			if ( sNeeded > sSize ) {
+				// Large allocations are usually containers that are still growing, so leave them room to grow in place.
+				sSize = sNeeded + (sNeeded >> 1);
+				if ( sSize < sNeeded ) { sSize = sNeeded; }
+			}
+			LSA_FA_CHUNK * pcNew = static_cast<LSA_FA_CHUNK *>(COsHeap::Alloc( sHeader + sSize ));
+			if ( !pcNew ) { return NULL; }
+			pcNew->pui8End = ChunkStart( pcNew ) + sSize;
+			// Insert it after the current chunk so that any chunks already there are still reused later.
+			pcNew->pcNext = pcNext;
+			if ( _pfFrame->pcCur ) {
+				_pfFrame->pcCur->pcNext = pcNew;
+			}
+			else {
+				_pfFrame->pcHead = pcNew;
+			}
+			pcNext = pcNew;
+
+			CCriticalSection::CLocker lLock( m_csThreads );
+			m_sReserved += sHeader + sSize;
+			++m_ui32Chunks;
+		}
+
+		if ( _pfFrame->pcCur ) {
+			_pfFrame->sUsedBefore += _pfFrame->pui8Pos - ChunkStart( _pfFrame->pcCur );
+		}
+		_pfFrame->pcCur = pcNext;
+		_pfFrame->pui8End = pcNext->pui8End;
+		uintptr_t uiptrAddr = LSE_ROUND_UP( reinterpret_cast<uintptr_t>(ChunkStart( pcNext )), static_cast<uintptr_t>(_ui32Align) );
+		_pfFrame->pui8Pos = reinterpret_cast<uint8_t *>(uiptrAddr + _sSize);
+		return reinterpret_cast<void *>(uiptrAddr);
+	}
+
+	/**
+	 * Empties a thread's allocations in a frame, keeping its chunks for reuse.
+	 *
+	 * \param _fFrame The thread's allocations in the frame.
+	 */
+	void LSE_CALL CFrameArena::ClearFrame( LSA_FA_FRAME &_fFrame ) {
+		_fFrame.pcCur = _fFrame.pcHead;
+		_fFrame.pui8Pos = _fFrame.pcHead ? ChunkStart( _fFrame.pcHead ) : NULL;
+		_fFrame.pui8End = _fFrame.pcHead ? _fFrame.pcHead->pui8End : NULL;
+		_fFrame.sUsedBefore = 0;
+	}
+
+}	// namespace lsa
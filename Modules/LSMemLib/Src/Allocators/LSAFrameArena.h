@@ -0,0 +1,371 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A scratch allocator for data that lives for at most a frame or two.  Each thread allocates from
+ *	the top of its own chunks without locking, and nothing is freed individually: a thread can rewind to a marker
+ *	it took earlier, and whole frames are recycled by NextFrame().  Allocations are double-buffered, so anything
+ *	allocated during a frame stays valid until the end of the following frame.
+ */
+
+
+#ifndef __LSA_FRAMEARENA_H__
+#define __LSA_FRAMEARENA_H__
+
+#include "../OSHeap/LSAOsHeap.h"
+#include "Atomic/LSSTDAtomic.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// TUNING
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// Number of frames whose allocations are alive at once.  A frame's RAM is reused this many frames later.
+#define LSA_FA_FRAMES						2
+
+// Default size of the chunks each thread takes from the OS heap.  Larger allocations get chunks of their own.
+#define LSA_FA_CHUNK_SIZE					(256 * 1024)
+
+
+namespace lsa {
+
+	/**
+	 * Class CFrameArena
+	 * \brief A scratch allocator for data that lives for at most a frame or two.
+	 *
+	 * Description: A scratch allocator for data that lives for at most a frame or two.  Each thread allocates from
+	 *	the top of its own chunks without locking, and nothing is freed individually: a thread can rewind to a marker
+	 *	it took earlier, and whole frames are recycled by NextFrame().  Allocations are double-buffered, so anything
+	 *	allocated during a frame stays valid until the end of the following frame.
+	 * Chunks are kept when frames are recycled, so once the arena has warmed up it no longer touches the OS heap.
+	 *	NextFrame(), Reset() and GetStats() must be called at a point where no other thread is allocating.
+	 */
+	class CFrameArena {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR							CFrameArena( LSA_SIZE _sChunkSize = LSA_FA_CHUNK_SIZE );
+		LSE_CALLCTOR							~CFrameArena();
+
+
+		// == Types.
+		/** A position in the calling thread's allocations, as returned by GetMarker(). */
+		typedef struct LSA_FA_MARKER {
+			/** The chunk. */
+			void *								pvChunk;
+
+			/** The position in the chunk. */
+			uint8_t *							pui8Pos;
+
+			/** Bytes used by the thread in the frame before the chunk. */
+			LSA_SIZE							sUsedBefore;
+
+			/** The frame. */
+			uint32_t							ui32Frame;
+		} * LPLSA_FA_MARKER, * const LPCLSA_FA_MARKER;
+
+		/** Usage statistics. */
+		typedef struct LSA_FA_STATS {
+			/** Bytes in use by all threads in the current frame. */
+			LSA_SIZE							sUsed;
+
+			/** The most bytes used in a single frame, adding together the peak of each thread. */
+			LSA_SIZE							sFrameHighWater;
+
+			/** The most bytes used by a single thread in a single frame. */
+			LSA_SIZE							sThreadHighWater;
+
+			/** Bytes taken from the OS heap. */
+			LSA_SIZE							sReserved;
+
+			/** Number of chunks taken from the OS heap. */
+			uint32_t							ui32Chunks;
+
+			/** Number of threads that have allocated from the arena. */
+			uint32_t							ui32Threads;
+
+			/** Number of frames since the arena was created or reset. */
+			uint32_t							ui32Frame;
+		} * LPLSA_FA_STATS, * const LPCLSA_FA_STATS;
+
+		/**
+		 * Rewinds the calling thread's allocations when it goes out of scope.
+		 */
+		class CScopedMarker {
+		public :
+			// == Various constructors.
+			LSE_INLINE LSE_CALLCTOR				CScopedMarker( CFrameArena &_faArena ) :
+				m_pfaArena( &_faArena ),
+				m_mMarker( _faArena.GetMarker() ) {
+			}
+			LSE_INLINE LSE_CALLCTOR				~CScopedMarker() {
+				m_pfaArena->Rewind( m_mMarker );
+			}
+
+		private :
+			// == Members.
+			/** The arena to rewind. */
+			CFrameArena *						m_pfaArena;
+
+			/** The position to which to rewind. */
+			LSA_FA_MARKER						m_mMarker;
+		};
+
+
+		// == Functions.
+		/**
+		 * Allocates RAM from the calling thread's chunks.  The RAM is valid until the calling thread rewinds past it
+		 *	or LSA_FA_FRAMES calls to NextFrame() have been made.
+		 *
+		 * \param _sSize Amount of RAM to allocate.
+		 * \param _ui32Align Alignment of the RAM to allocate.  Can be any power of 2.
+		 * \return Returns the allocated RAM or NULL if there is not enough RAM available to make the allocation.
+		 */
+		LSE_INLINE void * LSE_CALL				Alloc( LSA_SIZE _sSize, uint32_t _ui32Align = LSA_MIN_ALIGN );
+
+		/**
+		 * Resizes the calling thread's last allocation in place.  Fails if anything has been allocated after it or if
+		 *	its chunk does not have room for the new size.
+		 *
+		 * \param _pvAddr The last allocation made by the calling thread.
+		 * \param _sOldSize The size with which it was allocated or last resized.
+		 * \param _sNewSize The new size.
+		 * \return Returns true if the allocation was resized.
+		 */
+		LSBOOL LSE_CALL							ReAllocLast( void * _pvAddr, LSA_SIZE _sOldSize, LSA_SIZE _sNewSize );
+
+		/**
+		 * Gets the calling thread's current position, to which it can later rewind.
+		 *
+		 * \return Returns a marker to pass to Rewind().
+		 */
+		LSA_FA_MARKER LSE_CALL					GetMarker();
+
+		/**
+		 * Releases everything the calling thread allocated after taking the given marker.  The marker must have been
+		 *	taken by the calling thread during the current frame.
+		 *
+		 * \param _mMarker The marker to which to rewind.
+		 */
+		void LSE_CALL							Rewind( const LSA_FA_MARKER &_mMarker );
+
+		/**
+		 * Begins a new frame.  The allocations of the frame LSA_FA_FRAMES frames ago become invalid and their
+		 *	RAM is reused.
+		 */
+		void LSE_CALL							NextFrame();
+
+		/**
+		 * Releases all RAM back to the OS.  All allocations become invalid.
+		 */
+		void LSE_CALL							Reset();
+
+		/**
+		 * Gets usage statistics.
+		 *
+		 * \param _fsStats Filled with the statistics.
+		 */
+		void LSE_CALL							GetStats( LSA_FA_STATS &_fsStats ) const;
+
+
+	protected :
+		// == Types.
+		/** A chunk.  The usable RAM follows the header. */
+		typedef struct LSA_FA_CHUNK {
+			/** The next chunk in the frame or in the free list. */
+			LSA_FA_CHUNK *						pcNext;
+
+			/** The end of the chunk. */
+			uint8_t *							pui8End;
+		} * LPLSA_FA_CHUNK, * const LPCLSA_FA_CHUNK;
+
+		/** A thread's allocations in one of the frames. */
+		typedef struct LSA_FA_FRAME {
+			/** The current position. */
+			uint8_t *							pui8Pos;
+
+			/** The end of the current chunk. */
+			uint8_t *							pui8End;
+
+			/** The current chunk.  Chunks after it have been used before and are reused next. */
+			LSA_FA_CHUNK *						pcCur;
+
+			/** The first chunk. */
+			LSA_FA_CHUNK *						pcHead;
+
+			/** Bytes used in the chunks before the current chunk. */
+			LSA_SIZE							sUsedBefore;
+
+			/** The most bytes used at once during the frame, as of the last rewind. */
+			LSA_SIZE							sPeak;
+		} * LPLSA_FA_FRAME, * const LPCLSA_FA_FRAME;
+
+		/** A thread's allocations. */
+		typedef struct LSA_FA_THREAD {
+			/** The thread's allocations in each frame. */
+			LSA_FA_FRAME						fFrames[LSA_FA_FRAMES];
+
+			/** Identifies the thread. */
+			const void *						pvThread;
+
+			/** The next thread. */
+			LSA_FA_THREAD *						ptNext;
+		} * LPLSA_FA_THREAD, * const LPCLSA_FA_THREAD;
+
+
+		// == Members.
+		/** Each thread's allocations. */
+		LSA_FA_THREAD *							m_ptHead;
+
+		/** The current frame. */
+		uint32_t								m_ui32Frame;
+
+		/** The size of new chunks. */
+		LSA_SIZE								m_sChunkSize;
+
+		/** Bytes taken from the OS heap. */
+		LSA_SIZE								m_sReserved;
+
+		/** Number of chunks taken from the OS heap. */
+		uint32_t								m_ui32Chunks;
+
+		/** The most bytes used in a single frame by all threads. */
+		LSA_SIZE								m_sFrameHighWater;
+
+		/** The most bytes used in a single frame by one thread. */
+		LSA_SIZE								m_sThreadHighWater;
+
+		/** Identifies this arena to the threads' caches.  Changes on Reset(). */
+		CAtomic::ATOM							m_aId;
+
+		/** Guards the list of threads. */
+		mutable CCriticalSection				m_csThreads;
+
+		/** The source of arena IDs. */
+		static CAtomic::ATOM					m_aNextId;
+
+		/** The ID of the arena whose allocations the calling thread used last. */
+		static LSE_THREAD_LOCAL CAtomic::ATOM	m_aThreadId;
+
+		/** The calling thread's allocations in the arena whose ID is m_aThreadId. */
+		static LSE_THREAD_LOCAL LSA_FA_THREAD *	m_ptThread;
+
+		/** Its address identifies the calling thread. */
+		static LSE_THREAD_LOCAL uint8_t			m_ui8ThreadKey;
+
+
+		// == Functions.
+		/**
+		 * Gets the calling thread's allocations in the current frame, creating them if necessary.
+		 *
+		 * \return Returns the calling thread's allocations in the current frame or NULL if there is not enough RAM.
+		 */
+		LSE_INLINE LSA_FA_FRAME * LSE_CALL		ThreadFrame();
+
+		/**
+		 * Finds or creates the calling thread's allocations.
+		 *
+		 * \return Returns the calling thread's allocations or NULL if there is not enough RAM to create them.
+		 */
+		LSA_FA_THREAD * LSE_CALL				FindThread();
+
+		/**
+		 * Allocates from a new chunk when the current one is full.
+		 *
+		 * \param _pfFrame The calling thread's allocations in the current frame.
+		 * \param _sSize Amount of RAM to allocate.
+		 * \param _ui32Align Alignment of the RAM to allocate.
+		 * \return Returns the allocated RAM or NULL if there is not enough RAM available to make the allocation.
+		 */
+		void * LSE_CALL							AllocSlow( LSA_FA_FRAME * _pfFrame, LSA_SIZE _sSize, uint32_t _ui32Align );
+
+		/**
+		 * Gets the bytes used by a thread in a frame.
+		 *
+		 * \param _fFrame The thread's allocations in the frame.
+		 * \return Returns the bytes used by the thread in the frame.
+		 */
+		static LSE_INLINE LSA_SIZE LSE_CALL	Used( const LSA_FA_FRAME &_fFrame );
+
+		/**
+		 * Gets the start of the usable RAM in a chunk.
+		 *
+		 * \param _pcChunk The chunk.
+		 * \return Returns the start of the usable RAM in the chunk.
+		 */
+		static LSE_INLINE uint8_t * LSE_CALL	ChunkStart( LSA_FA_CHUNK * _pcChunk );
+
+		/**
+		 * Empties a thread's allocations in a frame, keeping its chunks for reuse.
+		 *
+		 * \param _fFrame The thread's allocations in the frame.
+		 */
+		static void LSE_CALL					ClearFrame( LSA_FA_FRAME &_fFrame );
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Allocates RAM from the calling thread's chunks.  The RAM is valid until the calling thread rewinds past it
+	 *	or LSA_FA_FRAMES calls to NextFrame() have been made.
+	 *
+	 * \param _sSize Amount of RAM to allocate.
+	 * \param _ui32Align Alignment of the RAM to allocate.  Can be any power of 2.
+	 * \return Returns the allocated RAM or NULL if there is not enough RAM available to make the allocation.
+	 */
+	LSE_INLINE void * LSE_CALL CFrameArena::Alloc( LSA_SIZE _sSize, uint32_t _ui32Align ) {
+		LSA_FA_FRAME * pfFrame = ThreadFrame();
+		if ( !pfFrame ) { return NULL; }
+		// Before the first chunk, both pointers are NULL and this falls through to AllocSlow().
+		uintptr_t uiptrAddr = LSE_ROUND_UP( reinterpret_cast<uintptr_t>(pfFrame->pui8Pos), static_cast<uintptr_t>(_ui32Align) );
+		uintptr_t uiptrEnd = reinterpret_cast<uintptr_t>(pfFrame->pui8End);
+		if ( LSE_EXPECT( uiptrAddr < uiptrEnd && _sSize <= uiptrEnd - uiptrAddr, 1 ) ) {
+			pfFrame->pui8Pos = reinterpret_cast<uint8_t *>(uiptrAddr + _sSize);
+			return reinterpret_cast<void *>(uiptrAddr);
+		}
+		return AllocSlow( pfFrame, _sSize, _ui32Align );
+	}
+
+	/**
+	 * Gets the calling thread's allocations in the current frame, creating them if necessary.
+	 *
+	 * \return Returns the calling thread's allocations in the current frame or NULL if there is not enough RAM.
+	 */
+	LSE_INLINE CFrameArena::LSA_FA_FRAME * LSE_CALL CFrameArena::ThreadFrame() {
+		LSA_FA_THREAD * ptThread = LSE_EXPECT( m_aThreadId == m_aId, 1 ) ? m_ptThread : FindThread();
+		if ( !ptThread ) { return NULL; }
+		return &ptThread->fFrames[m_ui32Frame%LSA_FA_FRAMES];
+	}
+
+	/**
+	 * Gets the bytes used by a thread in a frame.
+	 *
+	 * \param _fFrame The thread's allocations in the frame.
+	 * \return Returns the bytes used by the thread in the frame.
+	 */
+	LSE_INLINE LSA_SIZE LSE_CALL CFrameArena::Used( const LSA_FA_FRAME &_fFrame ) {
+		if ( !_fFrame.pcCur ) { return 0; }
+		return _fFrame.sUsedBefore + (_fFrame.pui8Pos - ChunkStart( _fFrame.pcCur ));
+	}
+
+	/**
+	 * Gets the start of the usable RAM in a chunk.
+	 *
+	 * \param _pcChunk The chunk.
+	 * \return Returns the start of the usable RAM in the chunk.
+	 */
+	LSE_INLINE uint8_t * LSE_CALL CFrameArena::ChunkStart( LSA_FA_CHUNK * _pcChunk ) {
+		return reinterpret_cast<uint8_t *>(_pcChunk) + LSE_ROUND_UP( sizeof( LSA_FA_CHUNK ), LSA_MIN_ALIGN );
+	}
+
+}	// namespace lsa
+
+#endif	// __LSA_FRAMEARENA_H__
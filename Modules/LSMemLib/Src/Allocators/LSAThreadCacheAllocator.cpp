@@ -0,0 +1,382 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A thread-caching front-end for small allocations.  Each thread keeps a free list per size class
+ *	and allocates from and frees to it without locking.  Free lists are refilled from, and overflow back into,
+ *	central per-size-class lists in batches, so the lock for a size class is taken once per batch instead of
+ *	once per allocation, and the allocator-wide lock is never taken.
+ * Blocks of a given size class come from 64-kilobyte spans carved out of 1-megabyte superblocks that come
+ *	directly from the OS heap.  Each span is carved by a single thread cache, its owner.  A block's size class
+ *	and owner are found from its address through a hash table of spans, so no per-allocation header is needed.
+ *	Any thread can free any block: a block freed by its owner goes into the owner's free list, and a block
+ *	freed by any other thread is pushed onto a lock-free remote-free list in the owner's cache, which the owner
+ *	takes back in one exchange the next time its free list for that size class runs dry.
+ * A thread's cache is released automatically when the thread exits and is reused by the next thread that
+ *	allocates.
+ */
+
+#include "LSAThreadCacheAllocator.h"
+
+
+namespace lsa {
+
+	// == Members.
+	/** The calling thread's cache. */
+	LSE_THREAD_LOCAL CThreadCacheAllocator::LSA_TC_THREAD_CACHE * CThreadCacheAllocator::m_ptcThreadCache = NULL;
+
+	/** The value of m_ui32Generation when m_ptcThreadCache was set. */
+	LSE_THREAD_LOCAL uint32_t CThreadCacheAllocator::m_ui32ThreadGeneration = 0;
+
+	// == Various constructors.
+	LSE_CALLCTOR CThreadCacheAllocator::CThreadCacheAllocator() :
+		m_psbHead( NULL ),
+		m_ptcHead( NULL ),
+		m_ui32Superblocks( 0 ),
+		m_ui32Generation( 1 ) {
+		for ( uint32_t I = LSA_TC_CLASSES; I--; ) {
+			m_tcCentral[I].pbHead = NULL;
+		}
+		for ( uint32_t I = LSA_TC_TABLE_SIZE; I--; ) {
+			m_psbTable[I] = NULL;
+		}
+#ifdef LSE_WINDOWS
+		m_dwExitSlot = ::FlsAlloc( ThreadExit );
+#else
+		if ( ::pthread_key_create( &m_kExitKey, ThreadExit ) != 0 ) {
+			m_kExitKey = static_cast<pthread_key_t>(-1);
+		}
+#endif	// #ifdef LSE_WINDOWS
+	}
+	LSE_CALLCTOR CThreadCacheAllocator::~CThreadCacheAllocator() {
+		Reset();
+#ifdef LSE_WINDOWS
+		// Any callbacks this runs find the caches already released by Reset().
+		if ( m_dwExitSlot != FLS_OUT_OF_INDEXES ) {
+			::FlsFree( m_dwExitSlot );
+		}
+#else
+		if ( m_kExitKey != static_cast<pthread_key_t>(-1) ) {
+			::pthread_key_delete( m_kExitKey );
+		}
+#endif	// #ifdef LSE_WINDOWS
+	}
+
+	// == Functions.
+	/**
+	 * Gets the usable size of a block allocated by this allocator.
+	 *
+	 * \param _pvAddr The block whose size is to be obtained.
+	 * \return Returns the usable size of the block or 0 if the block was not allocated by this allocator.
+	 */
+	LSA_SIZE LSE_CALL CThreadCacheAllocator::GetSize( const void * _pvAddr ) const {
+		LSA_TC_SUPERBLOCK * psbBlock = FindSuperblock( _pvAddr );
+		if ( !psbBlock ) { return 0; }
+		return ClassSize( psbBlock->ui8Class[(reinterpret_cast<const uint8_t *>(_pvAddr)-psbBlock->pui8Base)>>LSA_TC_SPAN_BITS] );
+	}
+
+	/**
+	 * Returns all blocks cached by the calling thread to the central lists.  Called automatically when a thread
+	 *	that allocated from this allocator exits; the cache is then reused by the next thread that allocates.
+	 */
+	void LSE_CALL CThreadCacheAllocator::ReleaseThreadCache() {
+		if ( m_ui32ThreadGeneration != m_ui32Generation ) { return; }
+		LSA_TC_THREAD_CACHE * ptcCache = m_ptcThreadCache;
+		// Other threads stop pushing to the remote-free lists once the cache is not in use, so mark it first and
+		//	then collect anything pushed before they saw the change.
+		CAtomic::AtomicStore( ptcCache->aInUse, 0 );
+		for ( uint32_t I = LSA_TC_CLASSES; I--; ) {
+			TakeRemote( ptcCache, I );
+			if ( ptcCache->ui32Counts[I] ) {
+				Flush( ptcCache, I, ptcCache->ui32Counts[I] );
+			}
+		}
+		m_ptcThreadCache = NULL;
+		m_ui32ThreadGeneration = 0;
+	}
+
+	/**
+	 * Releases all RAM.  All blocks allocated by this allocator become invalid.
+	 */
+	void LSE_CALL CThreadCacheAllocator::Reset() {
+		CCriticalSection::CLocker lLock( m_csSpans );
+		// Threads that still point to released caches will see the new generation and make new caches.
+		if ( ++m_ui32Generation == 0 ) { m_ui32Generation = 1; }
+
+		LSA_TC_THREAD_CACHE * ptcNext;
+		for ( LSA_TC_THREAD_CACHE * ptcThis = m_ptcHead; ptcThis; ptcThis = ptcNext ) {
+			ptcNext = ptcThis->ptcNext;
+			COsHeap::Free( ptcThis );
+		}
+		m_ptcHead = NULL;
+
+		for ( uint32_t I = LSA_TC_TABLE_SIZE; I--; ) {
+			m_psbTable[I] = NULL;
+		}
+		LSA_TC_SUPERBLOCK * psbNext;
+		for ( LSA_TC_SUPERBLOCK * psbThis = m_psbHead; psbThis; psbThis = psbNext ) {
+			psbNext = psbThis->psbNext;
+			COsHeap::Free( psbThis->pvAlloc );
+			COsHeap::Free( psbThis );
+		}
+		m_psbHead = NULL;
+		m_ui32Superblocks = 0;
+
+		for ( uint32_t I = LSA_TC_CLASSES; I--; ) {
+			CCriticalSection::CLocker lCentral( m_tcCentral[I].csLock );
+			m_tcCentral[I].pbHead = NULL;
+		}
+	}
+
+	/**
+	 * Gets the total amount of RAM this allocator has taken from the OS.
+	 *
+	 * \return Returns the total amount of RAM this allocator has taken from the OS.
+	 */
+	LSA_SIZE LSE_CALL CThreadCacheAllocator::GetTotalAllocatedSize() const {
+		CCriticalSection::CLocker lLock( m_csSpans );
+		LSA_SIZE sRet = static_cast<LSA_SIZE>(m_ui32Superblocks) *
+			(sizeof( LSA_TC_SUPERBLOCK ) + (static_cast<LSA_SIZE>(1) << LSA_TC_SUPERBLOCK_BITS) + (static_cast<LSA_SIZE>(1) << LSA_TC_SPAN_BITS));
+		for ( const LSA_TC_THREAD_CACHE * ptcThis = m_ptcHead; ptcThis; ptcThis = ptcThis->ptcNext ) {
+			sRet += sizeof( LSA_TC_THREAD_CACHE );
+		}
+		return sRet;
+	}
+
+	/**
+	 * Creates or reuses a cache for the calling thread.
+	 *
+	 * \return Returns the new cache or NULL if there is not enough RAM to create one.
+	 */
+	CThreadCacheAllocator::LSA_TC_THREAD_CACHE * LSE_CALL CThreadCacheAllocator::CreateThreadCache() {
+		CCriticalSection::CLocker lLock( m_csSpans );
+		LSA_TC_THREAD_CACHE * ptcCache = NULL;
+		// Reuse a cache released by a thread that has exited.  Released caches have empty free lists but keep
+		//	their partly carved spans, and may have picked up remote frees since they were released.
+		for ( LSA_TC_THREAD_CACHE * ptcThis = m_ptcHead; ptcThis; ptcThis = ptcThis->ptcNext ) {
+			if ( !CAtomic::AtomicLoad( ptcThis->aInUse ) ) {
+				ptcCache = ptcThis;
+				break;
+			}
+		}
+		if ( !ptcCache ) {
+			ptcCache = static_cast<LSA_TC_THREAD_CACHE *>(COsHeap::Alloc( sizeof( LSA_TC_THREAD_CACHE ) ));
+			if ( !ptcCache ) { return NULL; }
+			for ( uint32_t I = LSA_TC_CLASSES; I--; ) {
+				ptcCache->pbHeads[I] = NULL;
+				ptcCache->ui32Counts[I] = 0;
+				ptcCache->pui8Carve[I] = ptcCache->pui8CarveEnd[I] = NULL;
+				ptcCache->pvRemote[I] = NULL;
+			}
+			ptcCache->ptcNext = m_ptcHead;
+			m_ptcHead = ptcCache;
+		}
+		CAtomic::AtomicStore( ptcCache->aInUse, 1 );
+		m_ptcThreadCache = ptcCache;
+		m_ui32ThreadGeneration = m_ui32Generation;
+
+		// Have the OS call ThreadExit() when this thread exits.  The value only has to be non-NULL.
+#ifdef LSE_WINDOWS
+		if ( m_dwExitSlot != FLS_OUT_OF_INDEXES ) {
+			::FlsSetValue( m_dwExitSlot, this );
+		}
+#else
+		if ( m_kExitKey != static_cast<pthread_key_t>(-1) ) {
+			::pthread_setspecific( m_kExitKey, this );
+		}
+#endif	// #ifdef LSE_WINDOWS
+		return ptcCache;
+	}
+
+	/**
+	 * Fills a thread cache's free list with a batch from the central list, carving a new span if needed.
+	 *
+	 * \param _ptcCache The cache to fill.
+	 * \param _ui32Class The size class to fill.
+	 * \return Returns true if at least one block was added to the cache.
+	 */
+	LSBOOL LSE_CALL CThreadCacheAllocator::Refill( LSA_TC_THREAD_CACHE * _ptcCache, uint32_t _ui32Class ) {
+		uint32_t ui32Total = 0;
+		LSA_TC_BLOCK * pbHead = _ptcCache->pbHeads[_ui32Class];
+
+		// Take freed blocks first.
+		{
+			LSA_TC_CENTRAL & tcCentral = m_tcCentral[_ui32Class];
+			CCriticalSection::CLocker lLock( tcCentral.csLock );
+			while ( tcCentral.pbHead && ui32Total < LSA_TC_BATCH ) {
+				LSA_TC_BLOCK * pbThis = tcCentral.pbHead;
+				tcCentral.pbHead = pbThis->pbNext;
+				pbThis->pbNext = pbHead;
+				pbHead = pbThis;
+				++ui32Total;
+			}
+		}
+
+		// If none have been freed, carve new blocks from this cache's span.  The span belongs to this cache, so no
+		//	lock is needed.
+		if ( !ui32Total ) {
+			if ( _ptcCache->pui8Carve[_ui32Class] == _ptcCache->pui8CarveEnd[_ui32Class] ) {
+				uint8_t * pui8Span = NewSpan( _ui32Class, _ptcCache );
+				if ( !pui8Span ) { return false; }
+				_ptcCache->pui8Carve[_ui32Class] = pui8Span;
+				// Spans are not always a multiple of the block size, so stop before a partial block.
+				LSA_SIZE sBlocks = (static_cast<LSA_SIZE>(1) << LSA_TC_SPAN_BITS) / ClassSize( _ui32Class );
+				_ptcCache->pui8CarveEnd[_ui32Class] = pui8Span + sBlocks * ClassSize( _ui32Class );
+			}
+			LSA_SIZE sSize = ClassSize( _ui32Class );
+			while ( _ptcCache->pui8Carve[_ui32Class] != _ptcCache->pui8CarveEnd[_ui32Class] && ui32Total < LSA_TC_BATCH ) {
+				LSA_TC_BLOCK * pbThis = reinterpret_cast<LSA_TC_BLOCK *>(_ptcCache->pui8Carve[_ui32Class]);
+				_ptcCache->pui8Carve[_ui32Class] += sSize;
+				pbThis->pbNext = pbHead;
+				pbHead = pbThis;
+				++ui32Total;
+			}
+		}
+
+		_ptcCache->pbHeads[_ui32Class] = pbHead;
+		_ptcCache->ui32Counts[_ui32Class] += ui32Total;
+		return ui32Total != 0;
+	}
+
+	/**
+	 * Moves the blocks other threads have freed to a cache into the cache's free list.
+	 *
+	 * \param _ptcCache The cache to which the blocks belong.
+	 * \param _ui32Class The size class to take.
+	 * \return Returns the number of blocks moved.
+	 */
+	uint32_t LSE_CALL CThreadCacheAllocator::TakeRemote( LSA_TC_THREAD_CACHE * _ptcCache, uint32_t _ui32Class ) {
+		if ( !CAtomic::AtomicLoadPointer( _ptcCache->pvRemote[_ui32Class] ) ) { return 0; }
+		LSA_TC_BLOCK * pbHead = static_cast<LSA_TC_BLOCK *>(CAtomic::AtomicExchangePointer( _ptcCache->pvRemote[_ui32Class], NULL ));
+		if ( !pbHead ) { return 0; }
+		uint32_t ui32Total = 1;
+		LSA_TC_BLOCK * pbTail = pbHead;
+		for ( ; pbTail->pbNext; pbTail = pbTail->pbNext ) {
+			++ui32Total;
+		}
+		pbTail->pbNext = _ptcCache->pbHeads[_ui32Class];
+		_ptcCache->pbHeads[_ui32Class] = pbHead;
+		_ptcCache->ui32Counts[_ui32Class] += ui32Total;
+		return ui32Total;
+	}
+
+	/**
+	 * Frees a block to a cache other than the calling thread's.
+	 *
+	 * \param _ptcOwner The cache that carved the block.
+	 * \param _ui32Class The size class of the block.
+	 * \param _pbBlock The block to free.
+	 */
+	void LSE_CALL CThreadCacheAllocator::RemoteFree( LSA_TC_THREAD_CACHE * _ptcOwner, uint32_t _ui32Class, LSA_TC_BLOCK * _pbBlock ) {
+		if ( !CAtomic::AtomicLoad( _ptcOwner->aInUse ) ) {
+			// No thread owns the cache to take the block back, so give it to the central list.
+			LSA_TC_CENTRAL & tcCentral = m_tcCentral[_ui32Class];
+			CCriticalSection::CLocker lLock( tcCentral.csLock );
+			_pbBlock->pbNext = tcCentral.pbHead;
+			tcCentral.pbHead = _pbBlock;
+			return;
+		}
+		// Blocks are only ever pushed one at a time and taken all at once, so the classic ABA problem of a
+		//	lock-free stack cannot occur.
+		void * pvHead = CAtomic::AtomicLoadPointer( _ptcOwner->pvRemote[_ui32Class] );
+		while ( true ) {
+			_pbBlock->pbNext = static_cast<LSA_TC_BLOCK *>(pvHead);
+			void * pvPrev = CAtomic::AtomicCompareExchangePointer( _ptcOwner->pvRemote[_ui32Class], _pbBlock, pvHead );
+			if ( pvPrev == pvHead ) { break; }
+			pvHead = pvPrev;
+		}
+	}
+
+	/**
+	 * Moves a batch of blocks from a thread cache's free list to the central list.
+	 *
+	 * \param _ptcCache The cache from which to move blocks.
+	 * \param _ui32Class The size class to move.
+	 * \param _ui32Total The number of blocks to move.
+	 */
+	void LSE_CALL CThreadCacheAllocator::Flush( LSA_TC_THREAD_CACHE * _ptcCache, uint32_t _ui32Class, uint32_t _ui32Total ) {
+		// Detach the run outside of the lock.
+		LSA_TC_BLOCK * pbHead = _ptcCache->pbHeads[_ui32Class];
+		LSA_TC_BLOCK * pbTail = pbHead;
+		for ( uint32_t I = 1; I < _ui32Total; ++I ) {
+			pbTail = pbTail->pbNext;
+		}
+		_ptcCache->pbHeads[_ui32Class] = pbTail->pbNext;
+		_ptcCache->ui32Counts[_ui32Class] -= _ui32Total;
+
+		LSA_TC_CENTRAL & tcCentral = m_tcCentral[_ui32Class];
+		CCriticalSection::CLocker lLock( tcCentral.csLock );
+		pbTail->pbNext = tcCentral.pbHead;
+		tcCentral.pbHead = pbHead;
+	}
+
+	/**
+	 * Gets a new span for the given size class.
+	 *
+	 * \param _ui32Class The size class to which to assign the span.
+	 * \param _ptcOwner The cache that will carve the span.
+	 * \return Returns the start of the span or NULL if there is not enough RAM.
+	 */
+	uint8_t * LSE_CALL CThreadCacheAllocator::NewSpan( uint32_t _ui32Class, LSA_TC_THREAD_CACHE * _ptcOwner ) {
+		CCriticalSection::CLocker lLock( m_csSpans );
+		// Spans are never given back, so only the newest superblock can have unused spans.
+		LSA_TC_SUPERBLOCK * psbBlock = m_psbHead;
+		if ( !psbBlock || psbBlock->ui32Used == LSA_TC_SPANS ) {
+			// Keep the table at most half full so that probes stay short.
+			if ( (m_ui32Superblocks + 1) * LSA_TC_SPANS > LSA_TC_TABLE_SIZE / 2 ) { return NULL; }
+
+			psbBlock = static_cast<LSA_TC_SUPERBLOCK *>(COsHeap::Alloc( sizeof( LSA_TC_SUPERBLOCK ) ));
+			if ( !psbBlock ) { return NULL; }
+			// Spans must be aligned to their size so that a block's span can be found by masking its address.
+			psbBlock->pvAlloc = COsHeap::Alloc( (static_cast<LSA_SIZE>(1) << LSA_TC_SUPERBLOCK_BITS) + (static_cast<LSA_SIZE>(1) << LSA_TC_SPAN_BITS) );
+			if ( !psbBlock->pvAlloc ) {
+				COsHeap::Free( psbBlock );
+				return NULL;
+			}
+			psbBlock->pui8Base = reinterpret_cast<uint8_t *>(LSE_ROUND_UP( reinterpret_cast<uintptr_t>(psbBlock->pvAlloc), static_cast<uintptr_t>(1) << LSA_TC_SPAN_BITS ));
+			for ( uint32_t I = LSA_TC_SPANS; I--; ) {
+				psbBlock->ui8Class[I] = 0xFF;
+				psbBlock->ptcOwner[I] = NULL;
+			}
+			psbBlock->ui32Used = 0;
+			psbBlock->psbNext = m_psbHead;
+			m_psbHead = psbBlock;
+			++m_ui32Superblocks;
+
+			// Publish the spans only after the superblock is filled in.
+			CAtomic::ThreadFence();
+			for ( uint32_t I = 0; I < LSA_TC_SPANS; ++I ) {
+				uintptr_t uiptrSpan = reinterpret_cast<uintptr_t>(psbBlock->pui8Base) + (static_cast<uintptr_t>(I) << LSA_TC_SPAN_BITS);
+				uint32_t ui32Index = Hash( uiptrSpan );
+				while ( m_psbTable[ui32Index] ) {
+					ui32Index = (ui32Index + 1) & (LSA_TC_TABLE_SIZE - 1);
+				}
+				m_psbTable[ui32Index] = psbBlock;
+			}
+		}
+		psbBlock->ui8Class[psbBlock->ui32Used] = static_cast<uint8_t>(_ui32Class);
+		psbBlock->ptcOwner[psbBlock->ui32Used] = _ptcOwner;
+		return psbBlock->pui8Base + (static_cast<LSA_SIZE>(psbBlock->ui32Used++) << LSA_TC_SPAN_BITS);
+	}
+
+	/**
+	 * Called by the OS when a thread that has a cache exits.
+	 *
+	 * \param _pvParm The allocator that owns the cache.
+	 */
+	void
+#ifdef LSE_WINDOWS
+		NTAPI
+#endif	// #ifdef LSE_WINDOWS
+		CThreadCacheAllocator::ThreadExit( void * _pvParm ) {
+		static_cast<CThreadCacheAllocator *>(_pvParm)->ReleaseThreadCache();
+	}
+
+}	// namespace lsa
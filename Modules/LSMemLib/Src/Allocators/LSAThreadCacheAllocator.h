@@ -0,0 +1,437 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A thread-caching front-end for small allocations.  Each thread keeps a free list per size class
+ *	and allocates from and frees to it without locking.  Free lists are refilled from, and overflow back into,
+ *	central per-size-class lists in batches, so the lock for a size class is taken once per batch instead of
+ *	once per allocation, and the allocator-wide lock is never taken.
+ * Blocks of a given size class come from 64-kilobyte spans carved out of 1-megabyte superblocks that come
+ *	directly from the OS heap.  Each span is carved by a single thread cache, its owner.  A block's size class
+ *	and owner are found from its address through a hash table of spans, so no per-allocation header is needed.
+ *	Any thread can free any block: a block freed by its owner goes into the owner's free list, and a block
+ *	freed by any other thread is pushed onto a lock-free remote-free list in the owner's cache, which the owner
+ *	takes back in one exchange the next time its free list for that size class runs dry.
+ * A thread's cache is released automatically when the thread exits and is reused by the next thread that
+ *	allocates.
+ */
+
+
+#ifndef __LSA_THREADCACHEALLOCATOR_H__
+#define __LSA_THREADCACHEALLOCATOR_H__
+
+#include "../OSHeap/LSAOsHeap.h"
+#include "LSASmallAllocator.h"
+#include "Atomic/LSSTDAtomic.h"
+
+#if defined( LSE_MAC ) || defined( LSE_LINUX )
+#include <pthread.h>
+#endif	// #if defined( LSE_MAC ) || defined( LSE_LINUX )
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// TUNING
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// Number of size classes.  Classes are LSA_SMALLEST_ALLOCATION_SIZE bytes apart, up to LSA_LARGEST_ALLOCATION_SIZE.
+#define LSA_TC_CLASSES						LSA_WS
+
+// Size of a span (a run of blocks of a single size class) as a power of 2.
+#define LSA_TC_SPAN_BITS					16
+
+// Size of a superblock (a run of spans allocated from the OS at once) as a power of 2.
+#define LSA_TC_SUPERBLOCK_BITS				20
+
+// Number of spans in a superblock.
+#define LSA_TC_SPANS						(1 << (LSA_TC_SUPERBLOCK_BITS - LSA_TC_SPAN_BITS))
+
+// Number of blocks moved between a thread cache and the central list at once.
+#define LSA_TC_BATCH						32
+
+// Number of blocks of a single size class a thread may cache before it returns a batch.
+#define LSA_TC_MAX_CACHED					(LSA_TC_BATCH * 2)
+
+// Number of entries in the span hash table.  Must be a power of 2.  Half of these can be used, which allows
+//	256 megabytes of small allocations with 64-kilobyte spans.  Allocations beyond that fall back to CStdAllocator.
+#define LSA_TC_TABLE_SIZE					8192
+
+
+namespace lsa {
+
+	/**
+	 * Class CThreadCacheAllocator
+	 *
+	 * Description: A thread-caching front-end for small allocations.  Only one instance may be used at a time
+	 *	(the one owned by CMemLib) because the per-thread caches are found through a single thread-local pointer.
+	 */
+	class CThreadCacheAllocator {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CThreadCacheAllocator();
+		LSE_CALLCTOR								~CThreadCacheAllocator();
+
+
+		// == Functions.
+		/**
+		 * Allocates a small block.
+		 *
+		 * \param _sSize Amount of RAM to allocate.
+		 * \param _ui32Align Alignment of the RAM to allocate.  0 is treated as LSA_MIN_ALIGN.
+		 * \return Returns the allocated RAM or NULL if the size is too large for this allocator or RAM is exhausted.
+		 */
+		LSE_INLINE void * LSE_CALL					Alloc( LSA_SIZE _sSize, uint32_t _ui32Align );
+
+		/**
+		 * Frees a block if it was allocated by this allocator.
+		 *
+		 * \param _pvAddr The RAM to free.
+		 * \return Returns true if the address was allocated by this allocator and was freed.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Free( void * _pvAddr );
+
+		/**
+		 * Gets the usable size of a block allocated by this allocator.
+		 *
+		 * \param _pvAddr The block whose size is to be obtained.
+		 * \return Returns the usable size of the block or 0 if the block was not allocated by this allocator.
+		 */
+		LSA_SIZE LSE_CALL							GetSize( const void * _pvAddr ) const;
+
+		/**
+		 * Returns all blocks cached by the calling thread to the central lists.  Called automatically when a thread
+		 *	that allocated from this allocator exits; the cache is then reused by the next thread that allocates.
+		 */
+		void LSE_CALL								ReleaseThreadCache();
+
+		/**
+		 * Releases all RAM.  All blocks allocated by this allocator become invalid.
+		 */
+		void LSE_CALL								Reset();
+
+		/**
+		 * Gets the total amount of RAM this allocator has taken from the OS.
+		 *
+		 * \return Returns the total amount of RAM this allocator has taken from the OS.
+		 */
+		LSA_SIZE LSE_CALL							GetTotalAllocatedSize() const;
+
+
+	protected :
+		// == Types.
+		/** A free block, linked through its own memory. */
+		typedef struct LSA_TC_BLOCK {
+			/** The next free block. */
+			LSA_TC_BLOCK *							pbNext;
+		} * LPLSA_TC_BLOCK, * const LPCLSA_TC_BLOCK;
+
+		/** A per-thread cache. */
+		typedef struct LSA_TC_THREAD_CACHE {
+			/** Free lists per size class. */
+			LSA_TC_BLOCK *							pbHeads[LSA_TC_CLASSES];
+
+			/** Number of blocks in each free list. */
+			uint32_t								ui32Counts[LSA_TC_CLASSES];
+
+			/** The next uncarved byte in the span this cache is carving for each size class. */
+			uint8_t *								pui8Carve[LSA_TC_CLASSES];
+
+			/** The end of the span this cache is carving for each size class. */
+			uint8_t *								pui8CarveEnd[LSA_TC_CLASSES];
+
+			/** Is a thread using this cache?  Read by other threads, so only accessed atomically. */
+			CAtomic::ATOM							aInUse;
+
+			/** The next cache. */
+			LSA_TC_THREAD_CACHE *					ptcNext;
+
+			/** Keeps pvRemote off the cache lines of the owner's free lists. */
+			uint8_t									ui8Pad[LSE_CACHE_LINE_SIZE];
+
+			/** Blocks from this cache's spans freed by other threads, per size class.  Pushed by any thread and
+			 *	taken by the owner, only through atomic operations. */
+			void * volatile							pvRemote[LSA_TC_CLASSES];
+		} * LPLSA_TC_THREAD_CACHE, * const LPCLSA_TC_THREAD_CACHE;
+
+		/** A superblock. */
+		typedef struct LSA_TC_SUPERBLOCK {
+			/** The address returned by the OS heap. */
+			void *									pvAlloc;
+
+			/** The span-aligned start of the superblock. */
+			uint8_t *								pui8Base;
+
+			/** The size class of each span, or 0xFF if unused. */
+			uint8_t									ui8Class[LSA_TC_SPANS];
+
+			/** The cache that carves each span.  Set before any block in the span is handed out and never changed. */
+			LSA_TC_THREAD_CACHE *					ptcOwner[LSA_TC_SPANS];
+
+			/** Number of spans handed out. */
+			uint32_t								ui32Used;
+
+			/** The next superblock. */
+			LSA_TC_SUPERBLOCK *						psbNext;
+		} * LPLSA_TC_SUPERBLOCK, * const LPCLSA_TC_SUPERBLOCK;
+
+		/** The central list of a size class.  Padded so that neighbouring classes do not share cache lines. */
+		typedef struct LSE_ALIGN( LSE_CACHE_LINE_SIZE ) LSA_TC_CENTRAL {
+			/** Guards this size class. */
+			CCriticalSection						csLock;
+
+			/** Free blocks. */
+			LSA_TC_BLOCK *							pbHead;
+		} LSE_POSTALIGN( LSE_CACHE_LINE_SIZE ) * LPLSA_TC_CENTRAL, * const LPCLSA_TC_CENTRAL;
+
+
+		// == Members.
+		/** The central lists. */
+		LSA_TC_CENTRAL								m_tcCentral[LSA_TC_CLASSES];
+
+		/** Superblocks by span address.  Written under m_csSpans and read without locking. */
+		LSA_TC_SUPERBLOCK * volatile				m_psbTable[LSA_TC_TABLE_SIZE];
+
+		/** All superblocks. */
+		LSA_TC_SUPERBLOCK *							m_psbHead;
+
+		/** All thread caches. */
+		LSA_TC_THREAD_CACHE *						m_ptcHead;
+
+		/** Number of superblocks. */
+		uint32_t									m_ui32Superblocks;
+
+		/** Incremented on Reset() so that threads drop caches that were released. */
+		uint32_t									m_ui32Generation;
+
+		/** Guards superblocks, spans, and the list of thread caches. */
+		mutable CCriticalSection					m_csSpans;
+
+#ifdef LSE_WINDOWS
+		/** Fiber-local slot whose callback releases a thread's cache when the thread exits. */
+		DWORD										m_dwExitSlot;
+#else
+		/** Thread-specific key whose destructor releases a thread's cache when the thread exits. */
+		pthread_key_t								m_kExitKey;
+#endif	// #ifdef LSE_WINDOWS
+
+		/** The calling thread's cache. */
+		static LSE_THREAD_LOCAL LSA_TC_THREAD_CACHE *
+													m_ptcThreadCache;
+
+		/** The value of m_ui32Generation when m_ptcThreadCache was set. */
+		static LSE_THREAD_LOCAL uint32_t			m_ui32ThreadGeneration;
+
+
+		// == Functions.
+		/**
+		 * Gets the calling thread's cache, creating one if necessary.
+		 *
+		 * \return Returns the calling thread's cache or NULL if there is not enough RAM to create one.
+		 */
+		LSE_INLINE LSA_TC_THREAD_CACHE * LSE_CALL	GetThreadCache();
+
+		/**
+		 * Creates or reuses a cache for the calling thread.
+		 *
+		 * \return Returns the new cache or NULL if there is not enough RAM to create one.
+		 */
+		LSA_TC_THREAD_CACHE * LSE_CALL				CreateThreadCache();
+
+		/**
+		 * Finds the superblock containing the given address.
+		 *
+		 * \param _pvAddr The address to find.
+		 * \return Returns the superblock containing the address or NULL if the address was not allocated by this allocator.
+		 */
+		LSE_INLINE LSA_TC_SUPERBLOCK * LSE_CALL		FindSuperblock( const void * _pvAddr ) const;
+
+		/**
+		 * Gets the hash-table index for a span address.
+		 *
+		 * \param _uiptrBase The aligned address of a span.
+		 * \return Returns the first hash-table index to probe.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Hash( uintptr_t _uiptrBase );
+
+		/**
+		 * Fills a thread cache's free list with a batch from the central list, carving a new span if needed.
+		 *
+		 * \param _ptcCache The cache to fill.
+		 * \param _ui32Class The size class to fill.
+		 * \return Returns true if at least one block was added to the cache.
+		 */
+		LSBOOL LSE_CALL								Refill( LSA_TC_THREAD_CACHE * _ptcCache, uint32_t _ui32Class );
+
+		/**
+		 * Moves the blocks other threads have freed to a cache into the cache's free list.
+		 *
+		 * \param _ptcCache The cache to which the blocks belong.
+		 * \param _ui32Class The size class to take.
+		 * \return Returns the number of blocks moved.
+		 */
+		uint32_t LSE_CALL							TakeRemote( LSA_TC_THREAD_CACHE * _ptcCache, uint32_t _ui32Class );
+
+		/**
+		 * Frees a block to a cache other than the calling thread's.
+		 *
+		 * \param _ptcOwner The cache that carved the block.
+		 * \param _ui32Class The size class of the block.
+		 * \param _pbBlock The block to free.
+		 */
+		void LSE_CALL								RemoteFree( LSA_TC_THREAD_CACHE * _ptcOwner, uint32_t _ui32Class, LSA_TC_BLOCK * _pbBlock );
+
+		/**
+		 * Moves a batch of blocks from a thread cache's free list to the central list.
+		 *
+		 * \param _ptcCache The cache from which to move blocks.
+		 * \param _ui32Class The size class to move.
+		 * \param _ui32Total The number of blocks to move.
+		 */
+		void LSE_CALL								Flush( LSA_TC_THREAD_CACHE * _ptcCache, uint32_t _ui32Class, uint32_t _ui32Total );
+
+		/**
+		 * Gets a new span for the given size class.
+		 *
+		 * \param _ui32Class The size class to which to assign the span.
+		 * \param _ptcOwner The cache that will carve the span.
+		 * \return Returns the start of the span or NULL if there is not enough RAM.
+		 */
+		uint8_t * LSE_CALL							NewSpan( uint32_t _ui32Class, LSA_TC_THREAD_CACHE * _ptcOwner );
+
+		/**
+		 * Called by the OS when a thread that has a cache exits.
+		 *
+		 * \param _pvParm The allocator that owns the cache.
+		 */
+		static void
+#ifdef LSE_WINDOWS
+			NTAPI
+#endif	// #ifdef LSE_WINDOWS
+													ThreadExit( void * _pvParm );
+
+		/**
+		 * Gets the block size of a size class.
+		 *
+		 * \param _ui32Class The size class.
+		 * \return Returns the size of blocks in the given class.
+		 */
+		static LSE_INLINE LSA_SIZE LSE_CALL			ClassSize( uint32_t _ui32Class );
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Allocates a small block.
+	 *
+	 * \param _sSize Amount of RAM to allocate.
+	 * \param _ui32Align Alignment of the RAM to allocate.  0 is treated as LSA_MIN_ALIGN.
+	 * \return Returns the allocated RAM or NULL if the size is too large for this allocator or RAM is exhausted.
+	 */
+	LSE_INLINE void * LSE_CALL CThreadCacheAllocator::Alloc( LSA_SIZE _sSize, uint32_t _ui32Align ) {
+		if ( !_sSize ) { _sSize = 1; }
+		// Blocks are at multiples of the block size from a span-aligned base, so a block size that is a multiple
+		//	of the alignment gives aligned blocks.
+		if ( _ui32Align > LSA_MIN_ALIGN ) {
+			_sSize = LSE_ROUND_UP( _sSize, _ui32Align );
+		}
+		if ( _sSize > LSA_LARGEST_ALLOCATION_SIZE ) { return NULL; }
+		uint32_t ui32Class = static_cast<uint32_t>((_sSize - 1) >> LSA_SMALLEST_ALLOCATION_BITS);
+
+		LSA_TC_THREAD_CACHE * ptcCache = GetThreadCache();
+		if ( !ptcCache ) { return NULL; }
+		if ( !ptcCache->pbHeads[ui32Class] ) {
+			if ( !TakeRemote( ptcCache, ui32Class ) && !Refill( ptcCache, ui32Class ) ) { return NULL; }
+		}
+		LSA_TC_BLOCK * pbRet = ptcCache->pbHeads[ui32Class];
+		ptcCache->pbHeads[ui32Class] = pbRet->pbNext;
+		--ptcCache->ui32Counts[ui32Class];
+		return pbRet;
+	}
+
+	/**
+	 * Frees a block if it was allocated by this allocator.
+	 *
+	 * \param _pvAddr The RAM to free.
+	 * \return Returns true if the address was allocated by this allocator and was freed.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CThreadCacheAllocator::Free( void * _pvAddr ) {
+		LSA_TC_SUPERBLOCK * psbBlock = FindSuperblock( _pvAddr );
+		if ( !psbBlock ) { return false; }
+		uint32_t ui32Span = static_cast<uint32_t>((reinterpret_cast<uint8_t *>(_pvAddr)-psbBlock->pui8Base)>>LSA_TC_SPAN_BITS);
+		uint32_t ui32Class = psbBlock->ui8Class[ui32Span];
+		LSA_TC_BLOCK * pbBlock = static_cast<LSA_TC_BLOCK *>(_pvAddr);
+
+		// Only the owner touches its free lists.  Any other thread hands the block back through the owner's
+		//	remote-free list.
+		LSA_TC_THREAD_CACHE * ptcCache = m_ui32ThreadGeneration == m_ui32Generation ? m_ptcThreadCache : NULL;
+		if ( LSE_EXPECT( ptcCache != psbBlock->ptcOwner[ui32Span], 0 ) ) {
+			RemoteFree( psbBlock->ptcOwner[ui32Span], ui32Class, pbBlock );
+			return true;
+		}
+		pbBlock->pbNext = ptcCache->pbHeads[ui32Class];
+		ptcCache->pbHeads[ui32Class] = pbBlock;
+		if ( ++ptcCache->ui32Counts[ui32Class] > LSA_TC_MAX_CACHED ) {
+			Flush( ptcCache, ui32Class, LSA_TC_BATCH );
+		}
+		return true;
+	}
+
+	/**
+	 * Gets the calling thread's cache, creating one if necessary.
+	 *
+	 * \return Returns the calling thread's cache or NULL if there is not enough RAM to create one.
+	 */
+	LSE_INLINE CThreadCacheAllocator::LSA_TC_THREAD_CACHE * LSE_CALL CThreadCacheAllocator::GetThreadCache() {
+		if ( LSE_EXPECT( m_ui32ThreadGeneration == m_ui32Generation, 1 ) ) { return m_ptcThreadCache; }
+		return CreateThreadCache();
+	}
+
+	/**
+	 * Finds the superblock containing the given address.
+	 *
+	 * \param _pvAddr The address to find.
+	 * \return Returns the superblock containing the address or NULL if the address was not allocated by this allocator.
+	 */
+	LSE_INLINE CThreadCacheAllocator::LSA_TC_SUPERBLOCK * LSE_CALL CThreadCacheAllocator::FindSuperblock( const void * _pvAddr ) const {
+		uintptr_t uiptrSpan = reinterpret_cast<uintptr_t>(_pvAddr) & ~((static_cast<uintptr_t>(1) << LSA_TC_SPAN_BITS) - 1);
+		for ( uint32_t I = Hash( uiptrSpan ); ; I = (I + 1) & (LSA_TC_TABLE_SIZE - 1) ) {
+			// Entries are only ever added, and each superblock is fully built before it is published, so the loaded
+			//	pointer can be followed without a lock.
+			LSA_TC_SUPERBLOCK * psbThis = m_psbTable[I];
+			if ( !psbThis ) { return NULL; }
+			if ( uiptrSpan - reinterpret_cast<uintptr_t>(psbThis->pui8Base) < (static_cast<uintptr_t>(1) << LSA_TC_SUPERBLOCK_BITS) ) { return psbThis; }
+		}
+	}
+
+	/**
+	 * Gets the hash-table index for a span address.
+	 *
+	 * \param _uiptrBase The aligned address of a span.
+	 * \return Returns the first hash-table index to probe.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CThreadCacheAllocator::Hash( uintptr_t _uiptrBase ) {
+		uint64_t ui64Key = static_cast<uint64_t>(_uiptrBase >> LSA_TC_SPAN_BITS);
+		return static_cast<uint32_t>((ui64Key * 0x9E3779B97F4A7C15ULL) >> 40) & (LSA_TC_TABLE_SIZE - 1);
+	}
+
+	/**
+	 * Gets the block size of a size class.
+	 *
+	 * \param _ui32Class The size class.
+	 * \return Returns the size of blocks in the given class.
+	 */
+	LSE_INLINE LSA_SIZE LSE_CALL CThreadCacheAllocator::ClassSize( uint32_t _ui32Class ) {
+		return static_cast<LSA_SIZE>(_ui32Class + 1) << LSA_SMALLEST_ALLOCATION_BITS;
+	}
+
+}	// namespace lsa
+
+#endif	// __LSA_THREADCACHEALLOCATOR_H__
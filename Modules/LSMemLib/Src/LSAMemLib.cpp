@@ -22,6 +22,13 @@ namespace lsa {
 	 * The object we use for allocation.
 	 */
 	CStdAllocator CMemLib::m_saAllocator;
+
+#ifndef LSA_DEBUG
+	/**
+	 * Lock-free per-thread caches for small allocations, in front of m_saAllocator.
+	 */
+	CThreadCacheAllocator CMemLib::m_tcaSmallAllocator;
+#endif	// #ifndef LSA_DEBUG
 	
 	/**
 	 * If the allocator has not been constructed then we cannot use it (new/delete overloads cannot use it).
@@ -50,6 +57,9 @@ namespace lsa {
 	 * Destroy the memory manager.  Called once when the game is shutting down.
 	 */
 	void LSE_CALL CMemLib::Destroy() {
+#ifndef LSA_DEBUG
+		m_tcaSmallAllocator.Reset();
+#endif	// #ifndef LSA_DEBUG
 		m_saAllocator.Clear();
 		m_bAllocatorReady = false;
 		COsHeap::Destroy();
@@ -94,6 +104,12 @@ namespace lsa {
 	 * \return Returns the allocated memory or NULL if the allocation failed.
 	 */
 	void * LSE_CALL CMemLib::AllocD( LSA_SIZE _sSize, uint32_t _ulAlign LSA_DEBUGPARMSDEF ) {
+#ifndef LSA_DEBUG
+		if ( _sSize <= LSA_LARGEST_ALLOCATION_SIZE ) {
+			void * pvRet = m_tcaSmallAllocator.Alloc( _sSize, _ulAlign );
+			if ( pvRet ) { return pvRet; }
+		}
+#endif	// #ifndef LSA_DEBUG
 		return m_saAllocator.Alloc( _sSize, _ulAlign LSA_DEBUGPARMSPASS );
 	}
 
@@ -105,6 +121,15 @@ namespace lsa {
 	 * \return Returns the allocated memory or NULL if the allocation failed.
 	 */
 	void * LSE_CALL CMemLib::CAllocD( LSA_SIZE _sSize, uint32_t _ulAlign LSA_DEBUGPARMSDEF ) {
+#ifndef LSA_DEBUG
+		if ( _sSize <= LSA_LARGEST_ALLOCATION_SIZE ) {
+			void * pvRet = m_tcaSmallAllocator.Alloc( _sSize, _ulAlign );
+			if ( pvRet ) {
+				CStd::MemSet( pvRet, 0, _sSize );
+				return pvRet;
+			}
+		}
+#endif	// #ifndef LSA_DEBUG
 		return m_saAllocator.CAlloc( _sSize, _ulAlign LSA_DEBUGPARMSPASS );
 	}
 
@@ -115,6 +140,9 @@ namespace lsa {
 	 * \return Returns true if the address was allocated by this memory manager.
 	 */
 	LSBOOL LSE_CALL CMemLib::Free( void * _pvAddr ) {
+#ifndef LSA_DEBUG
+		if ( m_tcaSmallAllocator.Free( _pvAddr ) ) { return true; }
+#endif	// #ifndef LSA_DEBUG
 		return m_saAllocator.Free( _pvAddr );
 	}
 
@@ -127,9 +155,36 @@ namespace lsa {
 	 *	memory that must be freed.
 	 */
 	void * LSE_CALL CMemLib::ReAllocD( void * _pvAddr, LSA_SIZE _sSize LSA_DEBUGPARMSDEF ) {
+#ifndef LSA_DEBUG
+		LSA_SIZE sOldSize = m_tcaSmallAllocator.GetSize( _pvAddr );
+		if ( sOldSize ) {
+			// Blocks in the thread caches cannot grow, but they can shrink in place.
+			if ( _sSize == 0 ) { return NULL; }
+			if ( _sSize <= sOldSize ) { return _pvAddr; }
+			// The original alignment is not stored, but every block in a size class is aligned to the largest power
+			//	of 2 that divides the class size, which is at least the alignment that was requested.
+			uint32_t ui32Align = static_cast<uint32_t>(sOldSize & (~sOldSize + 1));
+			void * pvNew = AllocD( _sSize, ui32Align < LSA_MIN_ALIGN ? LSA_MIN_ALIGN : ui32Align LSA_DEBUGPARMSPASS );
+			if ( !pvNew ) { return NULL; }
+			CStd::MemCpy( pvNew, _pvAddr, sOldSize );
+			m_tcaSmallAllocator.Free( _pvAddr );
+			return pvNew;
+		}
+#endif	// #ifndef LSA_DEBUG
 		return m_saAllocator.ReAlloc( _pvAddr, _sSize LSA_DEBUGPARMSPASS );
 	}
 	
+	/**
+	 * Returns the small blocks cached by the calling thread to the shared pool.  This happens automatically when a
+	 *	thread exits; call it directly only to give the blocks back early from a thread that will stop allocating.
+	 *	Does nothing if LSA_DEBUG is defined.
+	 */
+	void LSE_CALL CMemLib::ReleaseThreadCache() {
+#ifndef LSA_DEBUG
+		m_tcaSmallAllocator.ReleaseThreadCache();
+#endif	// #ifndef LSA_DEBUG
+	}
+
 	/**
 	 * Release empty pools excluding the initial pool.
 	 */
@@ -169,7 +224,11 @@ namespace lsa {
 	 * \return Returns the total amount of RAM allocated by the main heap.
 	 */
 	LSA_SIZE LSE_CALL CMemLib::GetTotalAllocatedSize() {
+#ifndef LSA_DEBUG
+		return m_saAllocator.GetTotalAllocatedSize() + m_tcaSmallAllocator.GetTotalAllocatedSize();
+#else
 		return m_saAllocator.GetTotalAllocatedSize();
+#endif	// #ifndef LSA_DEBUG
 	}
 	
 }	// namespace lsa
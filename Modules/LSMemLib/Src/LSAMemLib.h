@@ -18,6 +18,7 @@
 
 #include "OSHeap/LSAOsHeap.h"
 #include "Allocators/LSAStdAllocator.h"
+#include "Allocators/LSAThreadCacheAllocator.h"
 
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -124,6 +125,13 @@ namespace lsa {
 		 */
 		static void * LSE_CALL					ReAllocD( void * _pvAddr, LSA_SIZE _sSize LSA_DEBUGPARMSDECL );
 		
+		/**
+		 * Returns the small blocks cached by the calling thread to the shared pool.  This happens automatically when a
+		 *	thread exits; call it directly only to give the blocks back early from a thread that will stop allocating.
+		 *	Does nothing if LSA_DEBUG is defined.
+		 */
+		static void LSE_CALL						ReleaseThreadCache();
+
 		/**
 		 * Are we ready for allocation?
 		 *
@@ -214,6 +222,13 @@ namespace lsa {
 		 * The object we use for allocation.
 		 */
 		static CStdAllocator						m_saAllocator;
+
+#ifndef LSA_DEBUG
+		/**
+		 * Lock-free per-thread caches for small allocations, in front of m_saAllocator.
+		 */
+		static CThreadCacheAllocator				m_tcaSmallAllocator;
+#endif	// #ifndef LSA_DEBUG
 		
 		/**
 		 * If the allocator has not been constructed then we cannot use it (new/delete overloads cannot use it).
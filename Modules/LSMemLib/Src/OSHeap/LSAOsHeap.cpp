@@ -14,6 +14,10 @@
 
 #include "LSAOsHeap.h"
 
+#if defined( LSE_MAC ) || defined( LSE_LINUX )
+#include <cstdlib>			// For ::malloc() and ::free().
+#endif	// #if defined( LSE_MAC ) || defined( LSE_LINUX )
+
 #ifdef LSE_IPHONE
 #include <CoreFoundation/CoreFoundation.h>
 #include <fcntl.h>			// For ::open().
@@ -178,10 +182,8 @@ namespace lsa {
 		}
 		m_pfmFileMaps[m_ui32TotalMaps++].pvAddr = pvAddr;
 		return pvAddr;
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		return ::malloc( _sSize );
-#elif defined( LSE_LINUX )
-#error "No implementation available for COsHeap::Alloc() on Linux."
 #endif
 	}
 
@@ -218,11 +220,9 @@ namespace lsa {
 		}
 		::free( _pvAddr );
 		return true;	// No way to detect otherwise.
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		::free( _pvAddr );
 		return true;	// No way to detect otherwise.
-#elif defined( LSE_LINUX )
-#error "No implementation available for COsHeap::Free() on Linux."
 #endif
 	}
 
@@ -120,9 +120,11 @@ namespace lsa {
 	 */
 	class COsHeap {
 		friend class						CDynamicStackAllocator;
+		friend class						CFrameArena;
 		friend class						CMemLib;
 		friend class						CStackAllocator;
 		friend class						CStdAllocator;
+		friend class						CThreadCacheAllocator;
 
 
 		// Protect everything to deny unauthorized access.
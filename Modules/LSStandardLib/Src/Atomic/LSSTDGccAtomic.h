@@ -72,6 +72,25 @@ namespace lsstd {
 		 */
 		static LSE_INLINE ATOM LSE_CALL				InterlockedDecrement( ATOM &_aAddend );
 
+		/**
+		 * Increments (increases by one) the value of the specified 32-bit variable as an atomic operation with no ordering constraints.  Suitable
+		 *	for reference counts, where taking a new reference never needs to publish other writes.
+		 *
+		 * \param _aAddend A reference to the variable to be incremented.
+		 * \return Returns the resulting incremented value.
+		 */
+		static LSE_INLINE ATOM LSE_CALL				InterlockedIncrementRelaxed( ATOM &_aAddend );
+
+		/**
+		 * Decrements (decreases by one) the value of the specified 32-bit variable as an atomic operation with acquire and release semantics.
+		 *	Suitable for reference counts, where the thread that releases the last reference must see every write made through the other
+		 *	references before destroying the object.
+		 *
+		 * \param _aAddend A reference to the variable to be decremented.
+		 * \return Returns the resulting decremented value.
+		 */
+		static LSE_INLINE ATOM LSE_CALL				InterlockedDecrementAcqRel( ATOM &_aAddend );
+
 		/**
 		 * Performs an atomic AND operation on the specified ATOM values.
 		 *
@@ -110,6 +129,62 @@ namespace lsstd {
 		 */
 		static LSE_INLINE ATOM LSE_CALL				InterlockedCompareExchange( ATOM &_aDestination, ATOM_OP _aoExchange, ATOM_OP _aoComparand );
 
+		/**
+		 * Reads an atomic value with acquire semantics.  Reads and writes that follow this call in program order are not moved before it.
+		 *
+		 * \param _aSource The value to read.
+		 * \return Returns the value of _aSource.
+		 */
+		static LSE_INLINE ATOM_OP LSE_CALL			AtomicLoad( const ATOM &_aSource );
+
+		/**
+		 * Writes an atomic value with release semantics.  Reads and writes that precede this call in program order are not moved after it.
+		 *
+		 * \param _aDestination The value to write.
+		 * \param _aoValue The value to store in _aDestination.
+		 */
+		static LSE_INLINE void LSE_CALL				AtomicStore( ATOM &_aDestination, ATOM_OP _aoValue );
+
+		/**
+		 * A full memory barrier.  No reads or writes are moved across this call in either direction, including stores followed by loads.
+		 */
+		static LSE_INLINE void LSE_CALL				ThreadFence();
+
+		/**
+		 * Reads a pointer with acquire semantics.  Reads and writes that follow this call in program order are not moved before it.
+		 *
+		 * \param _pvSource The pointer to read.
+		 * \return Returns the value of _pvSource.
+		 */
+		static LSE_INLINE void * LSE_CALL			AtomicLoadPointer( void * const volatile &_pvSource );
+
+		/**
+		 * Writes a pointer with release semantics.  Reads and writes that precede this call in program order are not moved after it.
+		 *
+		 * \param _pvDestination The pointer to write.
+		 * \param _pvValue The value to store in _pvDestination.
+		 */
+		static LSE_INLINE void LSE_CALL				AtomicStorePointer( void * volatile &_pvDestination, void * _pvValue );
+
+		/**
+		 * Atomically replaces a pointer and returns its previous value, with both acquire and release semantics.
+		 *
+		 * \param _pvDestination The pointer to replace.
+		 * \param _pvValue The value to store in _pvDestination.
+		 * \return Returns the original value of _pvDestination.
+		 */
+		static LSE_INLINE void * LSE_CALL			AtomicExchangePointer( void * volatile &_pvDestination, void * _pvValue );
+
+		/**
+		 * Replaces a pointer if it is equal to a given value and returns its previous value, with both acquire and release semantics.
+		 *
+		 * \param _pvDestination The pointer to replace.
+		 * \param _pvExchange The value to store in _pvDestination if it is equal to _pvComparand.
+		 * \param _pvComparand The value to compare to _pvDestination.
+		 * \return Returns the original value of _pvDestination.
+		 */
+		static LSE_INLINE void * LSE_CALL			AtomicCompareExchangePointer( void * volatile &_pvDestination, void * _pvExchange, void * _pvComparand );
+
 
 	protected :
 		// == Members.
@@ -166,6 +241,29 @@ namespace lsstd {
 		return InterlockedSubtract( _aAddend, 1 ) - 1;
 	}
 
+	/**
+	 * Increments (increases by one) the value of the specified 32-bit variable as an atomic operation with no ordering constraints.  Suitable
+	 *	for reference counts, where taking a new reference never needs to publish other writes.
+	 *
+	 * \param _aAddend A reference to the variable to be incremented.
+	 * \return Returns the resulting incremented value.
+	 */
+	LSE_INLINE CGccAtomic::ATOM LSE_CALL CGccAtomic::InterlockedIncrementRelaxed( ATOM &_aAddend ) {
+		return __atomic_add_fetch( &_aAddend, 1, __ATOMIC_RELAXED );
+	}
+
+	/**
+	 * Decrements (decreases by one) the value of the specified 32-bit variable as an atomic operation with acquire and release semantics.
+	 *	Suitable for reference counts, where the thread that releases the last reference must see every write made through the other
+	 *	references before destroying the object.
+	 *
+	 * \param _aAddend A reference to the variable to be decremented.
+	 * \return Returns the resulting decremented value.
+	 */
+	LSE_INLINE CGccAtomic::ATOM LSE_CALL CGccAtomic::InterlockedDecrementAcqRel( ATOM &_aAddend ) {
+		return __atomic_sub_fetch( &_aAddend, 1, __ATOMIC_ACQ_REL );
+	}
+
 	/**
 	 * Performs an atomic AND operation on the specified ATOM values.
 	 *
@@ -209,7 +307,78 @@ namespace lsstd {
 	 * \return Returns the original value of the _aDestination parameter.
 	 */
 	LSE_INLINE CGccAtomic::ATOM LSE_CALL CGccAtomic::InterlockedCompareExchange( ATOM &_aDestination, ATOM_OP _aoExchange, ATOM_OP _aoComparand ) {
-		return __sync_val_compare_and_swap( &_aDestination, _aoExchange, _aoComparand );
+		return __sync_val_compare_and_swap( &_aDestination, _aoComparand, _aoExchange );
+	}
+
+	/**
+	 * Reads an atomic value with acquire semantics.  Reads and writes that follow this call in program order are not moved before it.
+	 *
+	 * \param _aSource The value to read.
+	 * \return Returns the value of _aSource.
+	 */
+	LSE_INLINE CGccAtomic::ATOM_OP LSE_CALL CGccAtomic::AtomicLoad( const ATOM &_aSource ) {
+		return __atomic_load_n( &_aSource, __ATOMIC_ACQUIRE );
+	}
+
+	/**
+	 * Writes an atomic value with release semantics.  Reads and writes that precede this call in program order are not moved after it.
+	 *
+	 * \param _aDestination The value to write.
+	 * \param _aoValue The value to store in _aDestination.
+	 */
+	LSE_INLINE void LSE_CALL CGccAtomic::AtomicStore( ATOM &_aDestination, ATOM_OP _aoValue ) {
+		__atomic_store_n( &_aDestination, _aoValue, __ATOMIC_RELEASE );
+	}
+
+	/**
+	 * A full memory barrier.  No reads or writes are moved across this call in either direction, including stores followed by loads.
+	 */
+	LSE_INLINE void LSE_CALL CGccAtomic::ThreadFence() {
+		__sync_synchronize();
+	}
+
+	/**
+	 * Reads a pointer with acquire semantics.  Reads and writes that follow this call in program order are not moved before it.
+	 *
+	 * \param _pvSource The pointer to read.
+	 * \return Returns the value of _pvSource.
+	 */
+	LSE_INLINE void * LSE_CALL CGccAtomic::AtomicLoadPointer( void * const volatile &_pvSource ) {
+		return __atomic_load_n( &_pvSource, __ATOMIC_ACQUIRE );
+	}
+
+	/**
+	 * Writes a pointer with release semantics.  Reads and writes that precede this call in program order are not moved after it.
+	 *
+	 * \param _pvDestination The pointer to write.
+	 * \param _pvValue The value to store in _pvDestination.
+	 */
+	LSE_INLINE void LSE_CALL CGccAtomic::AtomicStorePointer( void * volatile &_pvDestination, void * _pvValue ) {
+		__atomic_store_n( &_pvDestination, _pvValue, __ATOMIC_RELEASE );
+	}
+
+	/**
+	 * Atomically replaces a pointer and returns its previous value, with both acquire and release semantics.
+	 *
+	 * \param _pvDestination The pointer to replace.
+	 * \param _pvValue The value to store in _pvDestination.
+	 * \return Returns the original value of _pvDestination.
+	 */
+	LSE_INLINE void * LSE_CALL CGccAtomic::AtomicExchangePointer( void * volatile &_pvDestination, void * _pvValue ) {
+		return __atomic_exchange_n( &_pvDestination, _pvValue, __ATOMIC_ACQ_REL );
+	}
+
+	/**
+	 * Replaces a pointer if it is equal to a given value and returns its previous value, with both acquire and release semantics.
+	 *
+	 * \param _pvDestination The pointer to replace.
+	 * \param _pvExchange The value to store in _pvDestination if it is equal to _pvComparand.
+	 * \param _pvComparand The value to compare to _pvDestination.
+	 * \return Returns the original value of _pvDestination.
+	 */
+	LSE_INLINE void * LSE_CALL CGccAtomic::AtomicCompareExchangePointer( void * volatile &_pvDestination, void * _pvExchange, void * _pvComparand ) {
+		__atomic_compare_exchange_n( &_pvDestination, &_pvComparand, _pvExchange, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE );
+		return _pvComparand;
 	}
 
 }	// namespace lsstd
@@ -75,6 +75,25 @@ namespace lsstd {
 		 */
 		static LSE_INLINE ATOM LSE_CALL				InterlockedDecrement( ATOM &_aAddend );
 
+		/**
+		 * Increments (increases by one) the value of the specified 32-bit variable as an atomic operation with no ordering constraints.  Suitable
+		 *	for reference counts, where taking a new reference never needs to publish other writes.
+		 *
+		 * \param _aAddend A reference to the variable to be incremented.
+		 * \return Returns the resulting incremented value.
+		 */
+		static LSE_INLINE ATOM LSE_CALL				InterlockedIncrementRelaxed( ATOM &_aAddend );
+
+		/**
+		 * Decrements (decreases by one) the value of the specified 32-bit variable as an atomic operation with acquire and release semantics.
+		 *	Suitable for reference counts, where the thread that releases the last reference must see every write made through the other
+		 *	references before destroying the object.
+		 *
+		 * \param _aAddend A reference to the variable to be decremented.
+		 * \return Returns the resulting decremented value.
+		 */
+		static LSE_INLINE ATOM LSE_CALL				InterlockedDecrementAcqRel( ATOM &_aAddend );
+
 		/**
 		 * Performs an atomic AND operation on the specified ATOM values.
 		 *
@@ -113,6 +132,62 @@ namespace lsstd {
 		 */
 		static LSE_INLINE ATOM LSE_CALL				InterlockedCompareExchange( ATOM &_aDestination, ATOM_OP _aoExchange, ATOM_OP _aoComparand );
 
+		/**
+		 * Reads an atomic value with acquire semantics.  Reads and writes that follow this call in program order are not moved before it.
+		 *
+		 * \param _aSource The value to read.
+		 * \return Returns the value of _aSource.
+		 */
+		static LSE_INLINE ATOM_OP LSE_CALL			AtomicLoad( const ATOM &_aSource );
+
+		/**
+		 * Writes an atomic value with release semantics.  Reads and writes that precede this call in program order are not moved after it.
+		 *
+		 * \param _aDestination The value to write.
+		 * \param _aoValue The value to store in _aDestination.
+		 */
+		static LSE_INLINE void LSE_CALL				AtomicStore( ATOM &_aDestination, ATOM_OP _aoValue );
+
+		/**
+		 * A full memory barrier.  No reads or writes are moved across this call in either direction, including stores followed by loads.
+		 */
+		static LSE_INLINE void LSE_CALL				ThreadFence();
+
+		/**
+		 * Reads a pointer with acquire semantics.  Reads and writes that follow this call in program order are not moved before it.
+		 *
+		 * \param _pvSource The pointer to read.
+		 * \return Returns the value of _pvSource.
+		 */
+		static LSE_INLINE void * LSE_CALL			AtomicLoadPointer( void * const volatile &_pvSource );
+
+		/**
+		 * Writes a pointer with release semantics.  Reads and writes that precede this call in program order are not moved after it.
+		 *
+		 * \param _pvDestination The pointer to write.
+		 * \param _pvValue The value to store in _pvDestination.
+		 */
+		static LSE_INLINE void LSE_CALL				AtomicStorePointer( void * volatile &_pvDestination, void * _pvValue );
+
+		/**
+		 * Atomically replaces a pointer and returns its previous value, with both acquire and release semantics.
+		 *
+		 * \param _pvDestination The pointer to replace.
+		 * \param _pvValue The value to store in _pvDestination.
+		 * \return Returns the original value of _pvDestination.
+		 */
+		static LSE_INLINE void * LSE_CALL			AtomicExchangePointer( void * volatile &_pvDestination, void * _pvValue );
+
+		/**
+		 * Replaces a pointer if it is equal to a given value and returns its previous value, with both acquire and release semantics.
+		 *
+		 * \param _pvDestination The pointer to replace.
+		 * \param _pvExchange The value to store in _pvDestination if it is equal to _pvComparand.
+		 * \param _pvComparand The value to compare to _pvDestination.
+		 * \return Returns the original value of _pvDestination.
+		 */
+		static LSE_INLINE void * LSE_CALL			AtomicCompareExchangePointer( void * volatile &_pvDestination, void * _pvExchange, void * _pvComparand );
+
 	};
 
 
@@ -166,6 +241,34 @@ namespace lsstd {
 		return ::InterlockedDecrement( &_aAddend );
 	}
 
+	/**
+	 * Increments (increases by one) the value of the specified 32-bit variable as an atomic operation with no ordering constraints.  Suitable
+	 *	for reference counts, where taking a new reference never needs to publish other writes.
+	 *
+	 * \param _aAddend A reference to the variable to be incremented.
+	 * \return Returns the resulting incremented value.
+	 */
+	LSE_INLINE CWindowsAtomic::ATOM LSE_CALL CWindowsAtomic::InterlockedIncrementRelaxed( ATOM &_aAddend ) {
+#if defined( _M_ARM ) || defined( _M_ARM64 )
+		return ::_InterlockedIncrement_nf( &_aAddend );
+#else
+		// Locked instructions on x86 are always full barriers.
+		return ::InterlockedIncrement( &_aAddend );
+#endif	// #if defined( _M_ARM ) || defined( _M_ARM64 )
+	}
+
+	/**
+	 * Decrements (decreases by one) the value of the specified 32-bit variable as an atomic operation with acquire and release semantics.
+	 *	Suitable for reference counts, where the thread that releases the last reference must see every write made through the other
+	 *	references before destroying the object.
+	 *
+	 * \param _aAddend A reference to the variable to be decremented.
+	 * \return Returns the resulting decremented value.
+	 */
+	LSE_INLINE CWindowsAtomic::ATOM LSE_CALL CWindowsAtomic::InterlockedDecrementAcqRel( ATOM &_aAddend ) {
+		return ::InterlockedDecrement( &_aAddend );
+	}
+
 	/**
 	 * Performs an atomic AND operation on the specified ATOM values.
 	 *
@@ -230,6 +333,99 @@ namespace lsstd {
 		return ::InterlockedCompareExchange( &_aDestination, _aoExchange, _aoComparand );
 	}
 
+	/**
+	 * Reads an atomic value with acquire semantics.  Reads and writes that follow this call in program order are not moved before it.
+	 *
+	 * \param _aSource The value to read.
+	 * \return Returns the value of _aSource.
+	 */
+	LSE_INLINE CWindowsAtomic::ATOM_OP LSE_CALL CWindowsAtomic::AtomicLoad( const ATOM &_aSource ) {
+		ATOM_OP aoRet = _aSource;
+#if defined( _M_IX86 ) || defined( _M_X64 )
+		// x86 loads already have acquire semantics; only the compiler needs to be stopped.
+		_ReadWriteBarrier();
+#else
+		::MemoryBarrier();
+#endif	// #if defined( _M_IX86 ) || defined( _M_X64 )
+		return aoRet;
+	}
+
+	/**
+	 * Writes an atomic value with release semantics.  Reads and writes that precede this call in program order are not moved after it.
+	 *
+	 * \param _aDestination The value to write.
+	 * \param _aoValue The value to store in _aDestination.
+	 */
+	LSE_INLINE void LSE_CALL CWindowsAtomic::AtomicStore( ATOM &_aDestination, ATOM_OP _aoValue ) {
+#if defined( _M_IX86 ) || defined( _M_X64 )
+		_ReadWriteBarrier();
+#else
+		::MemoryBarrier();
+#endif	// #if defined( _M_IX86 ) || defined( _M_X64 )
+		_aDestination = _aoValue;
+	}
+
+	/**
+	 * A full memory barrier.  No reads or writes are moved across this call in either direction, including stores followed by loads.
+	 */
+	LSE_INLINE void LSE_CALL CWindowsAtomic::ThreadFence() {
+		::MemoryBarrier();
+	}
+
+	/**
+	 * Reads a pointer with acquire semantics.  Reads and writes that follow this call in program order are not moved before it.
+	 *
+	 * \param _pvSource The pointer to read.
+	 * \return Returns the value of _pvSource.
+	 */
+	LSE_INLINE void * LSE_CALL CWindowsAtomic::AtomicLoadPointer( void * const volatile &_pvSource ) {
+		void * pvRet = _pvSource;
+#if defined( _M_IX86 ) || defined( _M_X64 )
+		_ReadWriteBarrier();
+#else
+		::MemoryBarrier();
+#endif	// #if defined( _M_IX86 ) || defined( _M_X64 )
+		return pvRet;
+	}
+
+	/**
+	 * Writes a pointer with release semantics.  Reads and writes that precede this call in program order are not moved after it.
+	 *
+	 * \param _pvDestination The pointer to write.
+	 * \param _pvValue The value to store in _pvDestination.
+	 */
+	LSE_INLINE void LSE_CALL CWindowsAtomic::AtomicStorePointer( void * volatile &_pvDestination, void * _pvValue ) {
+#if defined( _M_IX86 ) || defined( _M_X64 )
+		_ReadWriteBarrier();
+#else
+		::MemoryBarrier();
+#endif	// #if defined( _M_IX86 ) || defined( _M_X64 )
+		_pvDestination = _pvValue;
+	}
+
+	/**
+	 * Atomically replaces a pointer and returns its previous value, with both acquire and release semantics.
+	 *
+	 * \param _pvDestination The pointer to replace.
+	 * \param _pvValue The value to store in _pvDestination.
+	 * \return Returns the original value of _pvDestination.
+	 */
+	LSE_INLINE void * LSE_CALL CWindowsAtomic::AtomicExchangePointer( void * volatile &_pvDestination, void * _pvValue ) {
+		return ::InterlockedExchangePointer( &_pvDestination, _pvValue );
+	}
+
+	/**
+	 * Replaces a pointer if it is equal to a given value and returns its previous value, with both acquire and release semantics.
+	 *
+	 * \param _pvDestination The pointer to replace.
+	 * \param _pvExchange The value to store in _pvDestination if it is equal to _pvComparand.
+	 * \param _pvComparand The value to compare to _pvDestination.
+	 * \return Returns the original value of _pvDestination.
+	 */
+	LSE_INLINE void * LSE_CALL CWindowsAtomic::AtomicCompareExchangePointer( void * volatile &_pvDestination, void * _pvExchange, void * _pvComparand ) {
+		return ::InterlockedCompareExchangePointer( &_pvDestination, _pvExchange, _pvComparand );
+	}
+
 }	// namespace lsstd
 
 #endif	// #ifdef LSE_WINDOWS
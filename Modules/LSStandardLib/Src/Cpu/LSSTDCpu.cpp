@@ -0,0 +1,93 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reports the instruction-set extensions supported by the CPU at run-time so that code paths
+ *	using them can be selected when the program starts.
+ */
+
+#include "LSSTDCpu.h"
+
+#ifdef LSSTD_CPU_X86
+#ifdef LSE_VISUALSTUDIO
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif	// #ifdef LSE_VISUALSTUDIO
+#endif	// #ifdef LSSTD_CPU_X86
+
+
+namespace lsstd {
+
+	// == Members.
+	/** The detected features.  Zero until the first query. */
+	uint32_t CCpu::m_ui32Features = 0;
+
+	// == Functions.
+	/**
+	 * Queries the CPU.  Safe to call from multiple threads, since every call produces the same result.
+	 *
+	 * \return Returns the LSSTD_CPU_FEATURES flags supported by the CPU, including LSSTD_CF_DETECTED.
+	 */
+	uint32_t LSE_CALL CCpu::Detect() {
+		uint32_t ui32Ret = LSSTD_CF_DETECTED;
+#ifdef LSSTD_CPU_X86
+		uint32_t ui32Regs[4] = { 0 };	// EAX, EBX, ECX, EDX.
+#ifdef LSE_VISUALSTUDIO
+		int iRegs[4];
+		::__cpuid( iRegs, 0 );
+		uint32_t ui32MaxLeaf = static_cast<uint32_t>(iRegs[0]);
+		if ( ui32MaxLeaf >= 1 ) {
+			::__cpuid( iRegs, 1 );
+			for ( uint32_t I = 4; I--; ) { ui32Regs[I] = static_cast<uint32_t>(iRegs[I]); }
+		}
+#else
+		uint32_t ui32MaxLeaf = ::__get_cpuid_max( 0, NULL );
+		if ( ui32MaxLeaf >= 1 ) {
+			__cpuid( 1, ui32Regs[0], ui32Regs[1], ui32Regs[2], ui32Regs[3] );
+		}
+#endif	// #ifdef LSE_VISUALSTUDIO
+		if ( ui32Regs[3] & (1 << 26) ) { ui32Ret |= LSSTD_CF_SSE2; }
+		if ( ui32Regs[2] & (1 << 9) ) { ui32Ret |= LSSTD_CF_SSSE3; }
+		if ( ui32Regs[2] & (1 << 19) ) { ui32Ret |= LSSTD_CF_SSE41; }
+		if ( ui32Regs[2] & (1 << 1) ) { ui32Ret |= LSSTD_CF_PCLMUL; }
+
+		// AVX2 and F16C also need the operating system to save the YMM registers (OSXSAVE, then XCR0 bits 1 and 2).
+		if ( (ui32Regs[2] & (1 << 27)) && (ui32Regs[2] & (1 << 28)) ) {
+#ifdef LSE_VISUALSTUDIO
+			uint64_t ui64Xcr0 = ::_xgetbv( 0 );
+#else
+			uint32_t ui32XcrLo, ui32XcrHi;
+			__asm__ __volatile__( "xgetbv" : "=a" (ui32XcrLo), "=d" (ui32XcrHi) : "c" (0) );
+			uint64_t ui64Xcr0 = (static_cast<uint64_t>(ui32XcrHi) << 32) | ui32XcrLo;
+#endif	// #ifdef LSE_VISUALSTUDIO
+			if ( (ui64Xcr0 & 0x6) == 0x6 ) {
+				if ( ui32Regs[2] & (1 << 29) ) { ui32Ret |= LSSTD_CF_F16C; }
+				if ( ui32MaxLeaf >= 7 ) {
+#ifdef LSE_VISUALSTUDIO
+					::__cpuidex( iRegs, 7, 0 );
+					uint32_t ui32Ebx7 = static_cast<uint32_t>(iRegs[1]);
+#else
+					uint32_t ui32Eax7, ui32Ebx7, ui32Ecx7, ui32Edx7;
+					__cpuid_count( 7, 0, ui32Eax7, ui32Ebx7, ui32Ecx7, ui32Edx7 );
+#endif	// #ifdef LSE_VISUALSTUDIO
+					if ( ui32Ebx7 & (1 << 5) ) { ui32Ret |= LSSTD_CF_AVX2; }
+				}
+			}
+		}
+#elif defined( __ARM_NEON__ ) || defined( __ARM_NEON ) || defined( _M_ARM64 ) || defined( _M_ARM )
+		// Every ARM target we build for requires NEON.
+		ui32Ret |= LSSTD_CF_NEON;
+#endif	// #ifdef LSSTD_CPU_X86
+		return ui32Ret;
+	}
+
+}	// namespace lsstd
@@ -0,0 +1,227 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reports the instruction-set extensions supported by the CPU at run-time so that code paths
+ *	using them can be selected when the program starts.
+ */
+
+
+#ifndef __LSSTD_CPU_H__
+#define __LSSTD_CPU_H__
+
+#include "../LSSTDStandardLib.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// MACROS
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __i386__ ) || defined( __x86_64__ )
+/** Defined when compiling for x86 or x64, where extensions beyond SSE2 must be detected at run-time. */
+#define LSSTD_CPU_X86
+#elif defined( _M_ARM ) || defined( _M_ARM64 ) || defined( __arm__ ) || defined( __aarch64__ )
+/** Defined when compiling for ARM. */
+#define LSSTD_CPU_ARM
+#endif	// #if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __i386__ ) || defined( __x86_64__ )
+
+/**
+ * Marks a function as being compiled for the given instruction set (for example "avx2") regardless of the
+ *	project's settings.  Such functions must only be called after checking CCpu.  Visual Studio always allows
+ *	intrinsics, so it needs no marking.
+ */
+#if defined( LSSTD_CPU_X86 ) && defined( __GNUC__ )
+#define LSSTD_TARGET( ISA )				__attribute__( (target( ISA )) )
+#else
+#define LSSTD_TARGET( ISA )
+#endif	// #if defined( LSSTD_CPU_X86 ) && defined( __GNUC__ )
+
+namespace lsstd {
+
+	/**
+	 * Class CCpu
+	 * \brief Reports the instruction-set extensions supported by the CPU at run-time.
+	 *
+	 * Description: Reports the instruction-set extensions supported by the CPU at run-time so that code paths
+	 *	using them can be selected when the program starts.  The CPU is queried once, on the first call.
+	 */
+	class CCpu {
+	public :
+		// == Functions.
+		/**
+		 * Is SSE2 supported?  Always true on x64.
+		 *
+		 * \return Returns true if SSE2 instructions can be used.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL	HasSse2();
+
+		/**
+		 * Is SSSE3 supported?
+		 *
+		 * \return Returns true if SSSE3 instructions can be used.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL	HasSsse3();
+
+		/**
+		 * Is SSE4.1 supported?
+		 *
+		 * \return Returns true if SSE4.1 instructions can be used.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL	HasSse41();
+
+		/**
+		 * Is carry-less multiplication (PCLMULQDQ) supported?
+		 *
+		 * \return Returns true if PCLMULQDQ can be used.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL	HasPclmul();
+
+		/**
+		 * Are AVX2 and the operating-system support for saving YMM registers both available?
+		 *
+		 * \return Returns true if AVX2 instructions can be used.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL	HasAvx2();
+
+		/**
+		 * Are the half-precision conversion instructions (F16C) and the operating-system support for saving YMM
+		 *	registers both available?
+		 *
+		 * \return Returns true if F16C instructions can be used.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL	HasF16c();
+
+		/**
+		 * Is NEON supported?  Always true on 64-bit ARM.
+		 *
+		 * \return Returns true if NEON instructions can be used.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL	HasNeon();
+
+
+	protected :
+		// == Enumerations.
+		/** Feature flags. */
+		enum LSSTD_CPU_FEATURES {
+			LSSTD_CF_SSE2						= (1 << 0),
+			LSSTD_CF_SSSE3						= (1 << 1),
+			LSSTD_CF_SSE41						= (1 << 2),
+			LSSTD_CF_PCLMUL						= (1 << 3),
+			LSSTD_CF_AVX2						= (1 << 4),
+			LSSTD_CF_NEON						= (1 << 5),
+			LSSTD_CF_F16C						= (1 << 6),
+			LSSTD_CF_DETECTED					= 0x80000000,
+		};
+
+
+		// == Members.
+		/** The detected features.  Zero until the first query. */
+		static uint32_t							m_ui32Features;
+
+
+		// == Functions.
+		/**
+		 * Gets the feature flags, detecting them if necessary.
+		 *
+		 * \return Returns the LSSTD_CPU_FEATURES flags supported by the CPU.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		Features();
+
+		/**
+		 * Queries the CPU.  Safe to call from multiple threads, since every call produces the same result.
+		 *
+		 * \return Returns the LSSTD_CPU_FEATURES flags supported by the CPU, including LSSTD_CF_DETECTED.
+		 */
+		static uint32_t LSE_CALL				Detect();
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Is SSE2 supported?  Always true on x64.
+	 *
+	 * \return Returns true if SSE2 instructions can be used.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CCpu::HasSse2() {
+		return (Features() & LSSTD_CF_SSE2) != 0;
+	}
+
+	/**
+	 * Is SSSE3 supported?
+	 *
+	 * \return Returns true if SSSE3 instructions can be used.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CCpu::HasSsse3() {
+		return (Features() & LSSTD_CF_SSSE3) != 0;
+	}
+
+	/**
+	 * Is SSE4.1 supported?
+	 *
+	 * \return Returns true if SSE4.1 instructions can be used.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CCpu::HasSse41() {
+		return (Features() & LSSTD_CF_SSE41) != 0;
+	}
+
+	/**
+	 * Is carry-less multiplication (PCLMULQDQ) supported?
+	 *
+	 * \return Returns true if PCLMULQDQ can be used.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CCpu::HasPclmul() {
+		return (Features() & LSSTD_CF_PCLMUL) != 0;
+	}
+
+	/**
+	 * Are AVX2 and the operating-system support for saving YMM registers both available?
+	 *
+	 * \return Returns true if AVX2 instructions can be used.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CCpu::HasAvx2() {
+		return (Features() & LSSTD_CF_AVX2) != 0;
+	}
+
+	/**
+	 * Are the half-precision conversion instructions (F16C) and the operating-system support for saving YMM
+	 *	registers both available?
+	 *
+	 * \return Returns true if F16C instructions can be used.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CCpu::HasF16c() {
+		return (Features() & LSSTD_CF_F16C) != 0;
+	}
+
+	/**
+	 * Is NEON supported?  Always true on 64-bit ARM.
+	 *
+	 * \return Returns true if NEON instructions can be used.
+	 */
+	LSE_INLINE LSBOOL LSE_CALL CCpu::HasNeon() {
+		return (Features() & LSSTD_CF_NEON) != 0;
+	}
+
+	/**
+	 * Gets the feature flags, detecting them if necessary.
+	 *
+	 * \return Returns the LSSTD_CPU_FEATURES flags supported by the CPU.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CCpu::Features() {
+		uint32_t ui32Ret = m_ui32Features;
+		if ( !(ui32Ret & LSSTD_CF_DETECTED) ) {
+			ui32Ret = m_ui32Features = Detect();
+		}
+		return ui32Ret;
+	}
+
+}	// namespace lsstd
+
+#endif	// __LSSTD_CPU_H__
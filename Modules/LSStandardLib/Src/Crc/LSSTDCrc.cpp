@@ -9,24 +9,105 @@
  *	You may not take credit for having written this code.
  *
  *
- * Description: A standard 32-bit cyclic redundancy check calculator.
+ * Description: A standard 32-bit cyclic redundancy check calculator.  Large buffers are processed 16 bytes at a
+ *	time using slicing-by-16 tables, or with carry-less multiplication (PCLMULQDQ) when the CPU supports it.
  */
 
 #include "LSSTDCrc.h"
+#include "../Cpu/LSSTDCpu.h"
+
+#ifdef LSSTD_CPU_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef LSE_VISUALSTUDIO
+#include <intrin.h>
+#endif	// #ifdef LSE_VISUALSTUDIO
+
+/** Defined when CRC values can be calculated by folding with carry-less multiplication. */
+#define LSSTD_CRC_FOLD
+#endif	// #ifdef LSSTD_CPU_X86
 
 
 namespace lsstd {
 
+#ifdef LSSTD_CRC_FOLD
+	/**
+	 * Updates a CRC by folding 64 bytes at a time with carry-less multiplication, then reduces it back to 32 bits.
+	 *	Based on "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel, 2009).
+	 *	When _bBackwards is true, the data is read backwards from _pui8Data, which points to its end.
+	 *
+	 * \param _pui64Fold The folding constants.
+	 * \param _pui64Barrett The Barrett-reduction constants.
+	 * \param _pui8Data The data to add to the CRC calculation.
+	 * \param _uiptrLen Length of the data.  Must be a multiple of 16 and at least 64.
+	 * \param _ui32Crc The CRC to update.
+	 * \return Returns the updated CRC.
+	 */
+	template <bool _bBackwards>
+	static LSSTD_TARGET( "pclmul,ssse3" ) uint32_t LSE_CALL Fold( const uint64_t * _pui64Fold, const uint64_t * _pui64Barrett,
+		const uint8_t * _pui8Data, uintptr_t _uiptrLen, uint32_t _ui32Crc ) {
+		const __m128i mReverse = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+#define LSSTD_CRC_LOAD( OFF )		(_bBackwards ?																	\
+		_mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i *>(_pui8Data - (OFF) - 16) ), mReverse ) :	\
+		_mm_loadu_si128( reinterpret_cast<const __m128i *>(_pui8Data + (OFF)) ))
+#define LSSTD_CRC_FOLD16( X, Y, K )	_mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( X, K, 0x00 ),				\
+		_mm_clmulepi64_si128( X, K, 0x11 ) ), Y )
+
+		__m128i mX0 = _mm_xor_si128( LSSTD_CRC_LOAD( 0x00 ), _mm_cvtsi32_si128( static_cast<int>(_ui32Crc) ) );
+		__m128i mX1 = LSSTD_CRC_LOAD( 0x10 );
+		__m128i mX2 = LSSTD_CRC_LOAD( 0x20 );
+		__m128i mX3 = LSSTD_CRC_LOAD( 0x30 );
+		uintptr_t uiptrOff = 64;
+
+		// Fold 4 blocks at a time.
+		__m128i mK = _mm_loadu_si128( reinterpret_cast<const __m128i *>(&_pui64Fold[0]) );
+		for ( ; uiptrOff + 64 <= _uiptrLen; uiptrOff += 64 ) {
+			mX0 = LSSTD_CRC_FOLD16( mX0, LSSTD_CRC_LOAD( uiptrOff + 0x00 ), mK );
+			mX1 = LSSTD_CRC_FOLD16( mX1, LSSTD_CRC_LOAD( uiptrOff + 0x10 ), mK );
+			mX2 = LSSTD_CRC_FOLD16( mX2, LSSTD_CRC_LOAD( uiptrOff + 0x20 ), mK );
+			mX3 = LSSTD_CRC_FOLD16( mX3, LSSTD_CRC_LOAD( uiptrOff + 0x30 ), mK );
+		}
+
+		// Fold the 4 blocks into 1, then fold in what is left 1 block at a time.
+		mK = _mm_loadu_si128( reinterpret_cast<const __m128i *>(&_pui64Fold[2]) );
+		mX0 = LSSTD_CRC_FOLD16( mX0, mX1, mK );
+		mX0 = LSSTD_CRC_FOLD16( mX0, mX2, mK );
+		mX0 = LSSTD_CRC_FOLD16( mX0, mX3, mK );
+		for ( ; uiptrOff < _uiptrLen; uiptrOff += 16 ) {
+			mX0 = LSSTD_CRC_FOLD16( mX0, LSSTD_CRC_LOAD( uiptrOff ), mK );
+		}
+#undef LSSTD_CRC_FOLD16
+#undef LSSTD_CRC_LOAD
+
+		// Fold 128 bits down to 64.
+		const __m128i mLow32 = _mm_setr_epi32( -1, 0, -1, 0 );
+		mX0 = _mm_xor_si128( _mm_srli_si128( mX0, 8 ), _mm_clmulepi64_si128( mX0, mK, 0x10 ) );
+		mK = _mm_loadl_epi64( reinterpret_cast<const __m128i *>(&_pui64Fold[4]) );
+		mX0 = _mm_xor_si128( _mm_srli_si128( mX0, 4 ), _mm_clmulepi64_si128( _mm_and_si128( mX0, mLow32 ), mK, 0x00 ) );
+
+		// Barrett reduction down to 32 bits.
+		mK = _mm_loadu_si128( reinterpret_cast<const __m128i *>(_pui64Barrett) );
+		__m128i mT = _mm_and_si128( _mm_clmulepi64_si128( _mm_and_si128( mX0, mLow32 ), mK, 0x10 ), mLow32 );
+		mX0 = _mm_xor_si128( mX0, _mm_clmulepi64_si128( mT, mK, 0x00 ) );
+		return static_cast<uint32_t>(_mm_cvtsi128_si32( _mm_srli_si128( mX0, 4 ) ));
+	}
+#endif	// #ifdef LSSTD_CRC_FOLD
+
 	// == Members.
 	/**
-	 * Standard table of codes.
+	 * Standard key.
 	 */
-	uint32_t CCrc::m_ui32StdTable[256] = { 0 };
+	CCrc::LSSTD_CRC_KEY CCrc::m_ckStd;
 
 	/**
-	 * Alternative table of codes.
+	 * Alternative key.
 	 */
-	uint32_t CCrc::m_ui32AltTable[256] = { 0 };
+	CCrc::LSSTD_CRC_KEY CCrc::m_ckAlt;
+
+	/**
+	 * Can carry-less multiplication be used?
+	 */
+	LSBOOL CCrc::m_bFold = false;
 
 	/**
 	 * Has the table been initialized?
@@ -45,9 +126,15 @@ namespace lsstd {
 		Init();
 
 		uint32_t ui32Crc = LSE_MAXU32;
-		for ( uintptr_t I = 0; I < _uiptrLen; ++I ) {
-			GetCrc( m_ui32StdTable, (*_pui8Data++), ui32Crc );
+#ifdef LSSTD_CRC_FOLD
+		if ( m_bFold && _uiptrLen >= 64 ) {
+			uintptr_t uiptrFold = _uiptrLen & ~static_cast<uintptr_t>(15);
+			ui32Crc = Fold<false>( m_ckStd.ui64Fold, m_ckStd.ui64Barrett, _pui8Data, uiptrFold, ui32Crc );
+			_pui8Data += uiptrFold;
+			_uiptrLen -= uiptrFold;
 		}
+#endif	// #ifdef LSSTD_CRC_FOLD
+		ui32Crc = Slice( m_ckStd, _pui8Data, _uiptrLen, ui32Crc );
 
 		return ~ui32Crc;
 	}
@@ -64,31 +151,74 @@ namespace lsstd {
 
 		uint32_t ui32Crc = LSE_MAXU32;
 		_pui8Data += _uiptrLen;
-		for ( uintptr_t I = 0; I < _uiptrLen; ++I ) {
-			GetCrc( m_ui32AltTable, (*--_pui8Data), ui32Crc );
+#ifdef LSSTD_CRC_FOLD
+		if ( m_bFold && _uiptrLen >= 64 ) {
+			uintptr_t uiptrFold = _uiptrLen & ~static_cast<uintptr_t>(15);
+			ui32Crc = Fold<true>( m_ckAlt.ui64Fold, m_ckAlt.ui64Barrett, _pui8Data, uiptrFold, ui32Crc );
+			_pui8Data -= uiptrFold;
+			_uiptrLen -= uiptrFold;
 		}
+#endif	// #ifdef LSSTD_CRC_FOLD
+		ui32Crc = SliceBackwards( m_ckAlt, _pui8Data, _uiptrLen, ui32Crc );
 
 		return ~ui32Crc;
 	}
 
+	/**
+	 * Combines the standard CRC values of 2 consecutive blocks of data into the standard CRC value of the
+	 *	whole.
+	 *
+	 * \param _ui32Crc0 The standard CRC value of the first block.
+	 * \param _ui32Crc1 The standard CRC value of the block that follows it.
+	 * \param _uiptrLen1 Length of the second block.
+	 * \return Returns the standard 32-bit CRC value of both blocks together.
+	 */
+	uint32_t LSE_CALL CCrc::Combine( uint32_t _ui32Crc0, uint32_t _ui32Crc1, uintptr_t _uiptrLen1 ) {
+		Init();
+
+		// Running the first block's CRC through _uiptrLen1 more bytes is the same as multiplying it by
+		//	x^(8 * _uiptrLen1).  The starting and final inversions of both values cancel out.
+		return MulMod( BytesMod( m_ckStd, _uiptrLen1 ), _ui32Crc0, m_ckStd.ui32Key ) ^ _ui32Crc1;
+	}
+
+	/**
+	 * Combines the alternative CRC values of 2 consecutive blocks of data into the alternative CRC value of
+	 *	the whole.  The alternative CRC reads the data backwards, so it is the length of the first block that
+	 *	is needed.
+	 *
+	 * \param _ui32Crc0 The alternative CRC value of the first block.
+	 * \param _ui32Crc1 The alternative CRC value of the block that follows it.
+	 * \param _uiptrLen0 Length of the first block.
+	 * \return Returns the alternative 32-bit CRC value of both blocks together.
+	 */
+	uint32_t LSE_CALL CCrc::CombineAlt( uint32_t _ui32Crc0, uint32_t _ui32Crc1, uintptr_t _uiptrLen0 ) {
+		Init();
+
+		return MulMod( BytesMod( m_ckAlt, _uiptrLen0 ), _ui32Crc1, m_ckAlt.ui32Key ) ^ _ui32Crc0;
+	}
+
 	/**
 	 * Initialize the table.
 	 */
 	void LSE_CALL CCrc::Init() {
 		if ( !m_bInit ) {
-			Init( m_ui32StdTable, 0xEDB88320 );
-			Init( m_ui32AltTable, 0x04C11DB7 );
+			Init( m_ckStd, 0xEDB88320 );
+			Init( m_ckAlt, 0x04C11DB7 );
+#ifdef LSSTD_CRC_FOLD
+			m_bFold = CCpu::HasPclmul() && CCpu::HasSsse3();
+#endif	// #ifdef LSSTD_CRC_FOLD
 			m_bInit = true;
 		}		
 	}
 
 	/**
-	 * Initialize a table with a key.
+	 * Initialize the tables and constants for a key.
 	 *
-	 * \param _pui32Table The table to initialize
+	 * \param _ckKey The tables and constants to initialize.
 	 * \param _ui32Key The key to use for initialization.
 	 */
-	void LSE_CALL CCrc::Init( uint32_t * _pui32Table, uint32_t _ui32Key ) {
+	void LSE_CALL CCrc::Init( LSSTD_CRC_KEY &_ckKey, uint32_t _ui32Key ) {
+		_ckKey.ui32Key = _ui32Key;
 		for ( uint32_t I = 0; I < 256; ++I ) {
 			uint32_t ui32Crc = I;
 			for ( uint32_t J = 8; J--; ) {
@@ -99,8 +229,135 @@ namespace lsstd {
 					ui32Crc >>= 1;
 				}
 			}
-			_pui32Table[I] = ui32Crc;
+			_ckKey.ui32Table[0][I] = ui32Crc;
+		}
+		for ( uint32_t I = 0; I < 256; ++I ) {
+			for ( uint32_t J = 1; J < 16; ++J ) {
+				uint32_t ui32Crc = _ckKey.ui32Table[J-1][I];
+				_ckKey.ui32Table[J][I] = (ui32Crc >> 8) ^ _ckKey.ui32Table[0][ui32Crc&0xFF];
+			}
+		}
+
+		// The folding constants are used 33 bits wide, bit-reversed, so they are shifted up by 1.
+		static const uintptr_t uiptrFoldBytes[5] = { 544 / 8, 480 / 8, 160 / 8, 96 / 8, 64 / 8 };
+		for ( uint32_t I = 0; I < 5; ++I ) {
+			_ckKey.ui64Fold[I] = static_cast<uint64_t>(BytesMod( _ckKey, uiptrFoldBytes[I] )) << 1;
+		}
+
+		// Divide x^64 by the key (with its x^32 term restored) for the Barrett constant.  The key is bit-reversed,
+		//	so bit J of the key is the x^(31 - J) term.
+		uint64_t ui64Key = 1ULL << 32;
+		for ( uint32_t J = 0; J < 32; ++J ) {
+			if ( _ui32Key & (1UL << J) ) { ui64Key |= 1ULL << (31 - J); }
+		}
+		// The quotient starts with x^32, leaving x^32 times the rest of the key to divide.
+		uint64_t ui64Rem = ui64Key ^ (1ULL << 32);
+		uint64_t ui64Quot = 1ULL << 32;
+		for ( uint32_t J = 32; J--; ) {
+			ui64Rem <<= 1;
+			if ( ui64Rem & (1ULL << 32) ) {
+				ui64Rem ^= ui64Key;
+				ui64Quot |= 1ULL << J;
+			}
+		}
+		_ckKey.ui64Barrett[0] = (static_cast<uint64_t>(_ui32Key) << 1) | 1;
+		_ckKey.ui64Barrett[1] = 0;
+		for ( uint32_t J = 0; J < 33; ++J ) {
+			if ( ui64Quot & (1ULL << J) ) { _ckKey.ui64Barrett[1] |= 1ULL << (32 - J); }
+		}
+	}
+
+	/**
+	 * Multiplies 2 polynomials modulo the key.  Polynomials are bit-reversed, with x^0 in the high bit.
+	 *
+	 * \param _ui32A The first polynomial.
+	 * \param _ui32B The second polynomial.
+	 * \param _ui32Key The key.
+	 * \return Returns _ui32A * _ui32B modulo the key.
+	 */
+	uint32_t LSE_CALL CCrc::MulMod( uint32_t _ui32A, uint32_t _ui32B, uint32_t _ui32Key ) {
+		uint32_t ui32Ret = 0;
+		for ( uint32_t ui32Mask = 0x80000000; ui32Mask && _ui32A; ui32Mask >>= 1 ) {
+			if ( _ui32A & ui32Mask ) {
+				ui32Ret ^= _ui32B;
+				_ui32A ^= ui32Mask;
+			}
+			_ui32B = (_ui32B & 1) ? ((_ui32B >> 1) ^ _ui32Key) : (_ui32B >> 1);
+		}
+		return ui32Ret;
+	}
+
+	/**
+	 * Calculates x^(8 * _uiptrLen) modulo a key, which is the effect of running _uiptrLen 0 bytes through a CRC.
+	 *
+	 * \param _ckKey The key.
+	 * \param _uiptrLen The number of bytes.
+	 * \return Returns x^(8 * _uiptrLen) modulo the key.
+	 */
+	uint32_t LSE_CALL CCrc::BytesMod( const LSSTD_CRC_KEY &_ckKey, uintptr_t _uiptrLen ) {
+		uint32_t ui32Ret = 0x80000000;		// x^0.
+		uint32_t ui32Pow = 0x00800000;		// x^8.
+		while ( _uiptrLen ) {
+			if ( _uiptrLen & 1 ) {
+				ui32Ret = MulMod( ui32Pow, ui32Ret, _ckKey.ui32Key );
+			}
+			_uiptrLen >>= 1;
+			if ( _uiptrLen ) {
+				ui32Pow = MulMod( ui32Pow, ui32Pow, _ckKey.ui32Key );
+			}
+		}
+		return ui32Ret;
+	}
+
+	/**
+	 * Updates a CRC with the given data, 16 bytes at a time.
+	 *
+	 * \param _ckKey The key.
+	 * \param _pui8Data The data to add to the CRC calculation.
+	 * \param _uiptrLen Length of the data.
+	 * \param _ui32Crc The CRC to update.
+	 * \return Returns the updated CRC.
+	 */
+	uint32_t LSE_CALL CCrc::Slice( const LSSTD_CRC_KEY &_ckKey, const uint8_t * _pui8Data, uintptr_t _uiptrLen, uint32_t _ui32Crc ) {
+		const uint32_t (* pui32Table)[256] = _ckKey.ui32Table;
+		// Each byte is looked up in the table that advances it past the bytes that follow it in the block.
+		for ( ; _uiptrLen >= 16; _uiptrLen -= 16, _pui8Data += 16 ) {
+			uint32_t ui32Crc = _ui32Crc ^ (_pui8Data[0] | (_pui8Data[1] << 8) | (_pui8Data[2] << 16) | (static_cast<uint32_t>(_pui8Data[3]) << 24));
+			_ui32Crc = pui32Table[15][ui32Crc&0xFF] ^ pui32Table[14][(ui32Crc>>8)&0xFF] ^
+				pui32Table[13][(ui32Crc>>16)&0xFF] ^ pui32Table[12][ui32Crc>>24] ^
+				pui32Table[11][_pui8Data[4]] ^ pui32Table[10][_pui8Data[5]] ^ pui32Table[9][_pui8Data[6]] ^ pui32Table[8][_pui8Data[7]] ^
+				pui32Table[7][_pui8Data[8]] ^ pui32Table[6][_pui8Data[9]] ^ pui32Table[5][_pui8Data[10]] ^ pui32Table[4][_pui8Data[11]] ^
+				pui32Table[3][_pui8Data[12]] ^ pui32Table[2][_pui8Data[13]] ^ pui32Table[1][_pui8Data[14]] ^ pui32Table[0][_pui8Data[15]];
+		}
+		for ( ; _uiptrLen; --_uiptrLen ) {
+			GetCrc( pui32Table[0], (*_pui8Data++), _ui32Crc );
+		}
+		return _ui32Crc;
+	}
+
+	/**
+	 * Updates a CRC with the given data, 16 bytes at a time, reading backwards from the end of the data.
+	 *
+	 * \param _ckKey The key.
+	 * \param _pui8End The end of the data to add to the CRC calculation.
+	 * \param _uiptrLen Length of the data.
+	 * \param _ui32Crc The CRC to update.
+	 * \return Returns the updated CRC.
+	 */
+	uint32_t LSE_CALL CCrc::SliceBackwards( const LSSTD_CRC_KEY &_ckKey, const uint8_t * _pui8End, uintptr_t _uiptrLen, uint32_t _ui32Crc ) {
+		const uint32_t (* pui32Table)[256] = _ckKey.ui32Table;
+		for ( ; _uiptrLen >= 16; _uiptrLen -= 16, _pui8End -= 16 ) {
+			uint32_t ui32Crc = _ui32Crc ^ (_pui8End[-1] | (_pui8End[-2] << 8) | (_pui8End[-3] << 16) | (static_cast<uint32_t>(_pui8End[-4]) << 24));
+			_ui32Crc = pui32Table[15][ui32Crc&0xFF] ^ pui32Table[14][(ui32Crc>>8)&0xFF] ^
+				pui32Table[13][(ui32Crc>>16)&0xFF] ^ pui32Table[12][ui32Crc>>24] ^
+				pui32Table[11][_pui8End[-5]] ^ pui32Table[10][_pui8End[-6]] ^ pui32Table[9][_pui8End[-7]] ^ pui32Table[8][_pui8End[-8]] ^
+				pui32Table[7][_pui8End[-9]] ^ pui32Table[6][_pui8End[-10]] ^ pui32Table[5][_pui8End[-11]] ^ pui32Table[4][_pui8End[-12]] ^
+				pui32Table[3][_pui8End[-13]] ^ pui32Table[2][_pui8End[-14]] ^ pui32Table[1][_pui8End[-15]] ^ pui32Table[0][_pui8End[-16]];
+		}
+		for ( ; _uiptrLen; --_uiptrLen ) {
+			GetCrc( pui32Table[0], (*--_pui8End), _ui32Crc );
 		}
+		return _ui32Crc;
 	}
 
 	/**
@@ -110,7 +367,7 @@ namespace lsstd {
 	 * \param _ui8Val The byte to add to the CRC calculation.
 	 * \param _ui32Crc The CRC to update.
 	 */
-	void LSE_CALL CCrc::GetCrc( uint32_t * _pui32Table, uint8_t _ui8Val, uint32_t &_ui32Crc ) {
+	void LSE_CALL CCrc::GetCrc( const uint32_t * _pui32Table, uint8_t _ui8Val, uint32_t &_ui32Crc ) {
 		_ui32Crc = (_ui32Crc >> 8) ^ _pui32Table[_ui8Val^(_ui32Crc&0xFF)];
 	}
 
@@ -9,7 +9,8 @@
  *	You may not take credit for having written this code.
  *
  *
- * Description: A standard 32-bit cyclic redundancy check calculator.
+ * Description: A standard 32-bit cyclic redundancy check calculator.  Large buffers are processed 16 bytes at a
+ *	time using slicing-by-16 tables, or with carry-less multiplication (PCLMULQDQ) when the CPU supports it.
  */
 
 
@@ -24,7 +25,8 @@ namespace lsstd {
 	 * Class CCrc
 	 * \brief A standard 32-bit cyclic redundancy check calculator.
 	 *
-	 * Description: A standard 32-bit cyclic redundancy check calculator.
+	 * Description: A standard 32-bit cyclic redundancy check calculator.  CRC values of separate blocks can be
+	 *	combined, so large buffers can be split into chunks that are processed in parallel.
 	 */
 	class CCrc {
 	public :
@@ -47,18 +49,63 @@ namespace lsstd {
 		 */
 		static uint32_t LSE_CALL		GetAltCrc( const uint8_t * _pui8Data, uintptr_t _uiptrLen );
 
+		/**
+		 * Combines the standard CRC values of 2 consecutive blocks of data into the standard CRC value of the
+		 *	whole.
+		 *
+		 * \param _ui32Crc0 The standard CRC value of the first block.
+		 * \param _ui32Crc1 The standard CRC value of the block that follows it.
+		 * \param _uiptrLen1 Length of the second block.
+		 * \return Returns the standard 32-bit CRC value of both blocks together.
+		 */
+		static uint32_t LSE_CALL		Combine( uint32_t _ui32Crc0, uint32_t _ui32Crc1, uintptr_t _uiptrLen1 );
+
+		/**
+		 * Combines the alternative CRC values of 2 consecutive blocks of data into the alternative CRC value of
+		 *	the whole.  The alternative CRC reads the data backwards, so it is the length of the first block that
+		 *	is needed.
+		 *
+		 * \param _ui32Crc0 The alternative CRC value of the first block.
+		 * \param _ui32Crc1 The alternative CRC value of the block that follows it.
+		 * \param _uiptrLen0 Length of the first block.
+		 * \return Returns the alternative 32-bit CRC value of both blocks together.
+		 */
+		static uint32_t LSE_CALL		CombineAlt( uint32_t _ui32Crc0, uint32_t _ui32Crc1, uintptr_t _uiptrLen0 );
+
 
 	protected :
+		// == Types.
+		/** Everything needed to process data with a given key. */
+		typedef struct LSSTD_CRC_KEY {
+			/** Slicing tables.  Table 0 is the standard byte-at-a-time table and table N advances a byte N bytes further. */
+			uint32_t					ui32Table[16][256];
+
+			/** The key. */
+			uint32_t					ui32Key;
+
+			/** Folding constants for carry-less multiplication: x^544, x^480, x^160, x^96 and x^64 modulo the key. */
+			uint64_t					ui64Fold[5];
+
+			/** The key with its x^32 term and the quotient of x^64 divided by the key, for Barrett reduction. */
+			uint64_t					ui64Barrett[2];
+		} * LPLSSTD_CRC_KEY, * const LPCLSSTD_CRC_KEY;
+
+
 		// == Members.
 		/**
-		 * Standard table of codes.
+		 * Standard key.
 		 */
-		static uint32_t					m_ui32StdTable[256];
+		static LSSTD_CRC_KEY			m_ckStd;
 
 		/**
-		 * Alternative table of codes.
+		 * Alternative key.
 		 */
-		static uint32_t					m_ui32AltTable[256];
+		static LSSTD_CRC_KEY			m_ckAlt;
+
+		/**
+		 * Can carry-less multiplication be used?
+		 */
+		static LSBOOL					m_bFold;
 
 		/**
 		 * Has the table been initialized?
@@ -73,12 +120,53 @@ namespace lsstd {
 		static void LSE_CALL			Init();
 
 		/**
-		 * Initialize a table with a key.
+		 * Initialize the tables and constants for a key.
 		 *
-		 * \param _pui32Table The table to initialize
+		 * \param _ckKey The tables and constants to initialize.
 		 * \param _ui32Key The key to use for initialization.
 		 */
-		static void LSE_CALL			Init( uint32_t * _pui32Table, uint32_t _ui32Key );
+		static void LSE_CALL			Init( LSSTD_CRC_KEY &_ckKey, uint32_t _ui32Key );
+
+		/**
+		 * Multiplies 2 polynomials modulo the key.  Polynomials are bit-reversed, with x^0 in the high bit.
+		 *
+		 * \param _ui32A The first polynomial.
+		 * \param _ui32B The second polynomial.
+		 * \param _ui32Key The key.
+		 * \return Returns _ui32A * _ui32B modulo the key.
+		 */
+		static uint32_t LSE_CALL		MulMod( uint32_t _ui32A, uint32_t _ui32B, uint32_t _ui32Key );
+
+		/**
+		 * Calculates x^(8 * _uiptrLen) modulo a key, which is the effect of running _uiptrLen 0 bytes through a CRC.
+		 *
+		 * \param _ckKey The key.
+		 * \param _uiptrLen The number of bytes.
+		 * \return Returns x^(8 * _uiptrLen) modulo the key.
+		 */
+		static uint32_t LSE_CALL		BytesMod( const LSSTD_CRC_KEY &_ckKey, uintptr_t _uiptrLen );
+
+		/**
+		 * Updates a CRC with the given data, 16 bytes at a time.
+		 *
+		 * \param _ckKey The key.
+		 * \param _pui8Data The data to add to the CRC calculation.
+		 * \param _uiptrLen Length of the data.
+		 * \param _ui32Crc The CRC to update.
+		 * \return Returns the updated CRC.
+		 */
+		static uint32_t LSE_CALL		Slice( const LSSTD_CRC_KEY &_ckKey, const uint8_t * _pui8Data, uintptr_t _uiptrLen, uint32_t _ui32Crc );
+
+		/**
+		 * Updates a CRC with the given data, 16 bytes at a time, reading backwards from the end of the data.
+		 *
+		 * \param _ckKey The key.
+		 * \param _pui8End The end of the data to add to the CRC calculation.
+		 * \param _uiptrLen Length of the data.
+		 * \param _ui32Crc The CRC to update.
+		 * \return Returns the updated CRC.
+		 */
+		static uint32_t LSE_CALL		SliceBackwards( const LSSTD_CRC_KEY &_ckKey, const uint8_t * _pui8End, uintptr_t _uiptrLen, uint32_t _ui32Crc );
 
 		/**
 		 * Calculates the CRC of a given byte, modifying the previous CRC value in-place.
@@ -87,7 +175,7 @@ namespace lsstd {
 		 * \param _ui8Val The byte to add to the CRC calculation.
 		 * \param _ui32Crc The CRC to update.
 		 */
-		static void LSE_CALL			GetCrc( uint32_t * _pui32Table, uint8_t _ui8Val, uint32_t &_ui32Crc );
+		static void LSE_CALL			GetCrc( const uint32_t * _pui32Table, uint8_t _ui8Val, uint32_t &_ui32Crc );
 	};
 
 }	// namespace lsstd
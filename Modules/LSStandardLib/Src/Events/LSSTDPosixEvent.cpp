@@ -19,7 +19,8 @@
 namespace lsstd	{
 
 	// == Various constructors.
-	LSE_CALLCTOR CPosixEvent::CPosixEvent() {
+	LSE_CALLCTOR CPosixEvent::CPosixEvent() :
+		m_bSignaled( false ) {
 		::pthread_cond_init( &m_cHandle, NULL );
 		::pthread_mutex_init( &m_mLock, NULL );
 	}
@@ -37,7 +38,10 @@ namespace lsstd	{
 			CStd::DebugPrintA( "CPosixEvent::WaitEvent(): Failed to acquire mutex lock." );
 			return;
 		}
-		while ( ::pthread_cond_wait( &m_cHandle, &m_mLock ) != 0 ) {}
+		while ( !m_bSignaled ) {
+			::pthread_cond_wait( &m_cHandle, &m_mLock );
+		}
+		m_bSignaled = false;
 		::pthread_mutex_unlock( &m_mLock );
 	}
 
@@ -51,11 +55,27 @@ namespace lsstd	{
 			CStd::DebugPrintA( "CPosixEvent::Trigger(): Failed to acquire mutex lock." );
 			return false;
 		}
+		m_bSignaled = true;
 		::pthread_cond_signal( &m_cHandle );
 		::pthread_mutex_unlock( &m_mLock );
 		return true;
 	}
 
+	/**
+	 * Clears a trigger that no thread has consumed by calling WaitEvent().
+	 *
+	 * \return Returns true if resetting the event succeeded.
+	 */
+	LSBOOL LSE_CALL CPosixEvent::Reset() {
+		if ( ::pthread_mutex_lock( &m_mLock ) != 0 ) {
+			CStd::DebugPrintA( "CPosixEvent::Reset(): Failed to acquire mutex lock." );
+			return false;
+		}
+		m_bSignaled = false;
+		::pthread_mutex_unlock( &m_mLock );
+		return true;
+	}
+
 }	// namespace lsstd
 
 #endif	// #ifdef LSE_POSIX
@@ -50,6 +50,13 @@ namespace lsstd {
 		 */
 		LSBOOL LSE_CALL							Trigger();
 
+		/**
+		 * Clears a trigger that no thread has consumed by calling WaitEvent().
+		 *
+		 * \return Returns true if resetting the event succeeded.
+		 */
+		LSBOOL LSE_CALL							Reset();
+
 
 	protected :
 		// == Members.
@@ -59,6 +66,9 @@ namespace lsstd {
 		/** The mutex. */
 		::pthread_mutex_t						m_mLock;
 
+		/** Set by Trigger() and cleared by the WaitEvent() it releases, so a trigger with no waiter is not lost (matches auto-reset Windows events). */
+		LSBOOL									m_bSignaled;
+
 	};
 
 
@@ -58,6 +58,19 @@ namespace lsstd	{
 		return true;
 	}
 
+	/**
+	 * Clears a trigger that no thread has consumed by calling WaitEvent().
+	 *
+	 * \return Returns true if resetting the event succeeded.
+	 */
+	LSBOOL LSE_CALL CWindowsEvent::Reset() {
+		if ( !::ResetEvent( m_hHandle ) ) {
+			PrintError( L"Reset()" );
+			return false;
+		}
+		return true;
+	}
+
 	/**
 	 * reports GetError() results.
 	 *
@@ -50,6 +50,13 @@ namespace lsstd {
 		 */
 		LSBOOL LSE_CALL							Trigger();
 
+		/**
+		 * Clears a trigger that no thread has consumed by calling WaitEvent().
+		 *
+		 * \return Returns true if resetting the event succeeded.
+		 */
+		LSBOOL LSE_CALL							Reset();
+
 
 	protected :
 		// == Members.
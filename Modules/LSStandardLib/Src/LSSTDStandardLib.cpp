@@ -15,6 +15,7 @@
 
 #include "LSSTDStandardLib.h"
 #include "LargeInteger/LSSTDLargeInteger.h"
+#include "Simd/LSSTDSimdStd.h"
 #include <cstdarg>
 #include <cstdio>
 #ifdef __LSE_CRT_MEMFUNCS__
@@ -261,6 +262,9 @@ namespace lsstd {
 	 *	_pcLeft is greater than _pcRight, lexicographically.
 	 */
 	int32_t LSE_CALL CStd::StrCmp( const char * _pcLeft, const char * _pcRight ) {
+#ifdef LSSTD_SIMD
+		return CSimdStd::StrCmp( _pcLeft, _pcRight );
+#else
 		for ( uint32_t I = 0; true; ++I ) {
 			char cLeft = _pcLeft[I];
 			int32_t i32Dif = cLeft - _pcRight[I];
@@ -268,6 +272,7 @@ namespace lsstd {
 			
 			if ( cLeft == '\0' ) { return 0; }
 		}
+#endif	// #ifdef LSSTD_SIMD
 	}
 
 	/**
@@ -380,6 +385,8 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::StrLen( const char * _pcStr ) {
 #ifdef __LSE_CRT_MEMFUNCS__
 		return static_cast<uint32_t>(::strlen( _pcStr ));
+#elif defined( LSSTD_SIMD )
+		return CSimdStd::StrLen( _pcStr );
 #else
 		// Once we get to an X-byte boundary we can do full X-byte comparisons.
 		// X = bytes-per-address on the current operating system.  We use uintptr_t
@@ -1308,7 +1315,7 @@ namespace lsstd {
 		uint32_t ui32Len = CStd::StrLen( szBuffer );
 		szBuffer[ui32Len++] = _i8Format;
 		szBuffer[ui32Len] = '\0';
-#if defined( LSE_IPHONE ) || defined( LSE_MAC )
+#if defined( LSE_IPHONE ) || defined( LSE_MAC ) || defined( LSE_LINUX )
 		char szNewBuffer[1048];
 		::sprintf( szNewBuffer, szBuffer, _dValue );
 		CStd::StrNCpy( _pcBuffer, szNewBuffer, _ui32MaxLen );
@@ -1367,7 +1374,7 @@ namespace lsstd {
 #ifdef LSE_WINDOWS
 		Utf16ToUtf8( reinterpret_cast<LSUTF8 *>(_pcRet), reinterpret_cast<const LSUTF16 *>(_pwcSrc), _ui32RetLen );
 		return _pcRet;
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		Utf32ToUtf8( reinterpret_cast<LSUTF8 *>(_pcRet), reinterpret_cast<const LSUTF32 *>(_pwcSrc), _ui32RetLen );
 		return _pcRet;
 #endif	// #ifdef LSE_WINDOWS
@@ -1383,7 +1390,7 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::UtfXToUtf8Len( const LSUTFX * _pwcSrc ) {
 #ifdef LSE_WINDOWS
 		return Utf16StrLenAsUtf8( reinterpret_cast<const LSUTF16 *>(_pwcSrc) );
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		// LSUTFX is 4 bytes on Macintosh.
 		return Utf32StrLenAsUtf8( reinterpret_cast<const LSUTF32 *>(_pwcSrc) );
 		/*CFStringRef srStr = ::CFStringCreateWithBytes( NULL, reinterpret_cast<const UInt8 *>(_pwcSrc), CStd::WStrLen( _pwcSrc ) * sizeof( LSUTFX ), kCFStringEncodingUTF32LE, false );
@@ -1838,6 +1845,12 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf32ToUtf8( LSUTF8 * _putf8Dst, const LSUTF32 * _putf32Src,
 		uint32_t _ui32MaxLen ) {
 		for ( uint32_t I = 0; I < _ui32MaxLen; ) {
+#ifdef LSSTD_SIMD
+			// ASCII characters convert one-to-one.  Leave room for the terminating NULL.
+			uint32_t ui32Run = CSimdStd::Utf32AsciiToUtf8( &_putf8Dst[I], _putf32Src, _ui32MaxLen - I - 1 );
+			I += ui32Run;
+			_putf32Src += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			uint32_t ui32Value = RawUnicodeToUtf8Char( NextUtf32Char( _putf32Src++, 1 ), ui32ThisLen );
 			if ( !ui32Value ) {
@@ -1874,6 +1887,12 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf32ToUtf16( LSUTF16 * _putf16Dst, const LSUTF32 * _putf32Src,
 		uint32_t _ui32MaxLen ) {
 		for ( uint32_t I = 0; I < _ui32MaxLen; ) {
+#ifdef LSSTD_SIMD
+			// Characters below the surrogates convert one-to-one.  Leave room for the terminating NULL.
+			uint32_t ui32Run = CSimdStd::Utf32BmpToUtf16( &_putf16Dst[I], _putf32Src, _ui32MaxLen - I - 1 );
+			I += ui32Run;
+			_putf32Src += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			uint32_t ui32Value = RawUnicodeToUtf16Char( NextUtf32Char( _putf32Src++, 1 ), ui32ThisLen );
 			if ( !ui32Value ) {
@@ -1910,6 +1929,12 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf16ToUtf8( LSUTF8 * _putf8Dst, const LSUTF16 * _putf16Src,
 		uint32_t _ui32MaxLen ) {
 		for ( uint32_t I = 0; I < _ui32MaxLen; ) {
+#ifdef LSSTD_SIMD
+			// ASCII characters convert one-to-one.  Leave room for the terminating NULL.
+			uint32_t ui32Run = CSimdStd::Utf16AsciiToUtf8( &_putf8Dst[I], _putf16Src, _ui32MaxLen - I - 1 );
+			I += ui32Run;
+			_putf16Src += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			uint32_t ui32SrcLen;
 			uint32_t ui32Value = RawUnicodeToUtf8Char( NextUtf16Char( _putf16Src, 2, &ui32SrcLen ), ui32ThisLen );
@@ -1949,6 +1974,12 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf16ToUtf32( LSUTF32 * _putf32Dst, const LSUTF16 * _putf16Src,
 		uint32_t _ui32MaxLen ) {
 		for ( uint32_t I = 0; I < _ui32MaxLen; ++I ) {
+#ifdef LSSTD_SIMD
+			// Characters below the surrogates convert one-to-one.  Leave room for the terminating NULL.
+			uint32_t ui32Run = CSimdStd::Utf16BmpToUtf32( &_putf32Dst[I], _putf16Src, _ui32MaxLen - I - 1 );
+			I += ui32Run;
+			_putf16Src += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			uint32_t ui32SrcLen;
 			_putf32Dst[I] = RawUnicodeToUtf32Char( NextUtf16Char( _putf16Src, 2, &ui32SrcLen ), ui32ThisLen );
@@ -1983,6 +2014,12 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf8ToUtf16( LSUTF16 * _putf16Dst, const LSUTF8 * _putf8Src,
 		uint32_t _ui32MaxLen ) {
 		for ( uint32_t I = 0; I < _ui32MaxLen; ) {
+#ifdef LSSTD_SIMD
+			// ASCII characters convert one-to-one.  Leave room for the terminating NULL.
+			uint32_t ui32Run = CSimdStd::Utf8AsciiToUtf16( &_putf16Dst[I], _putf8Src, _ui32MaxLen - I - 1 );
+			I += ui32Run;
+			_putf8Src += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			uint32_t ui32SrcLen;
 			uint32_t ui32Value = RawUnicodeToUtf16Char( NextUtf8Char( _putf8Src, 4, &ui32SrcLen ), ui32ThisLen );
@@ -2022,6 +2059,12 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf8ToUtf32( LSUTF32 * _putf32Dst, const LSUTF8 * _putf8Src,
 		uint32_t _ui32MaxLen ) {
 		for ( uint32_t I = 0; I < _ui32MaxLen; ++I ) {
+#ifdef LSSTD_SIMD
+			// ASCII characters convert one-to-one.  Leave room for the terminating NULL.
+			uint32_t ui32Run = CSimdStd::Utf8AsciiToUtf32( &_putf32Dst[I], _putf8Src, _ui32MaxLen - I - 1 );
+			I += ui32Run;
+			_putf8Src += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			uint32_t ui32SrcLen;
 			_putf32Dst[I] = RawUnicodeToUtf32Char( NextUtf8Char( _putf8Src, 4, &ui32SrcLen ), ui32ThisLen );
@@ -2069,10 +2112,21 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf32StrLen( const LSUTF32 * _putf32String ) {
 		uint32_t ui32Ret = 0;
 		uint32_t ui32ThisLen;
+#ifdef LSSTD_SIMD
+		// Runs of ASCII characters are counted in blocks.
+		uint32_t ui32Run = CSimdStd::Utf32AsciiLen( _putf32String );
+		ui32Ret += ui32Run;
+		_putf32String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 		uint32_t ui32Char = NextUtf32Char( _putf32String, 1, &ui32ThisLen );
 		while ( ui32Char ) {
 			++ui32Ret;
 			_putf32String += ui32ThisLen;
+#ifdef LSSTD_SIMD
+			ui32Run = CSimdStd::Utf32AsciiLen( _putf32String );
+			ui32Ret += ui32Run;
+			_putf32String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			ui32Char = NextUtf32Char( _putf32String, 1, &ui32ThisLen );
 		}
 		return ui32Ret;
@@ -2087,10 +2141,21 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf16StrLen( const LSUTF16 * _putf16String ) {
 		uint32_t ui32Ret = 0;
 		uint32_t ui32ThisLen;
+#ifdef LSSTD_SIMD
+		// Runs of ASCII characters are counted in blocks.
+		uint32_t ui32Run = CSimdStd::Utf16AsciiLen( _putf16String );
+		ui32Ret += ui32Run;
+		_putf16String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 		uint32_t ui32Char = NextUtf16Char( _putf16String, 2, &ui32ThisLen );
 		while ( ui32Char ) {
 			++ui32Ret;
 			_putf16String += ui32ThisLen;
+#ifdef LSSTD_SIMD
+			ui32Run = CSimdStd::Utf16AsciiLen( _putf16String );
+			ui32Ret += ui32Run;
+			_putf16String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			ui32Char = NextUtf16Char( _putf16String, 2, &ui32ThisLen );
 		}
 		return ui32Ret;
@@ -2105,10 +2170,21 @@ namespace lsstd {
 	uint32_t LSE_CALL CStd::Utf8StrLen( const LSUTF8 * _putf8String ) {
 		uint32_t ui32Ret = 0;
 		uint32_t ui32ThisLen;
+#ifdef LSSTD_SIMD
+		// Runs of ASCII characters are counted in blocks.
+		uint32_t ui32Run = CSimdStd::Utf8AsciiLen( _putf8String );
+		ui32Ret += ui32Run;
+		_putf8String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 		uint32_t ui32Char = NextUtf8Char( _putf8String, 4, &ui32ThisLen );
 		while ( ui32Char ) {
 			++ui32Ret;
 			_putf8String += ui32ThisLen;
+#ifdef LSSTD_SIMD
+			ui32Run = CSimdStd::Utf8AsciiLen( _putf8String );
+			ui32Ret += ui32Run;
+			_putf8String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			ui32Char = NextUtf8Char( _putf8String, 4, &ui32ThisLen );
 		}
 		return ui32Ret;
@@ -2127,6 +2203,12 @@ namespace lsstd {
 
 		uint32_t ui32Char;
 		do {
+#ifdef LSSTD_SIMD
+			// ASCII characters take one unit in every encoding.
+			uint32_t ui32Run = CSimdStd::Utf32AsciiLen( _putf32String );
+			ui32Total += ui32Run;
+			_putf32String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			// From UTF-32 to raw.
 			ui32Char = NextUtf32Char( _putf32String, 1, &ui32ThisLen );
@@ -2154,6 +2236,12 @@ namespace lsstd {
 
 		uint32_t ui32Char;
 		do {
+#ifdef LSSTD_SIMD
+			// ASCII characters take one unit in every encoding.
+			uint32_t ui32Run = CSimdStd::Utf32AsciiLen( _putf32String );
+			ui32Total += ui32Run;
+			_putf32String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			// From UTF-32 to raw.
 			ui32Char = NextUtf32Char( _putf32String, 1, &ui32ThisLen );
@@ -2181,6 +2269,12 @@ namespace lsstd {
 
 		uint32_t ui32Char;
 		do {
+#ifdef LSSTD_SIMD
+			// ASCII characters take one unit in every encoding.
+			uint32_t ui32Run = CSimdStd::Utf16AsciiLen( _putf16String );
+			ui32Total += ui32Run;
+			_putf16String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			// From UTF-16 to raw.
 			ui32Char = NextUtf16Char( _putf16String, 2, &ui32ThisLen );
@@ -2208,6 +2302,12 @@ namespace lsstd {
 
 		uint32_t ui32Char;
 		do {
+#ifdef LSSTD_SIMD
+			// ASCII characters take one unit in every encoding.
+			uint32_t ui32Run = CSimdStd::Utf16AsciiLen( _putf16String );
+			ui32Total += ui32Run;
+			_putf16String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			// From UTF-16 to raw.
 			ui32Char = NextUtf16Char( _putf16String, 2, &ui32ThisLen );
@@ -2235,6 +2335,12 @@ namespace lsstd {
 
 		uint32_t ui32Char;
 		do {
+#ifdef LSSTD_SIMD
+			// ASCII characters take one unit in every encoding.
+			uint32_t ui32Run = CSimdStd::Utf8AsciiLen( _putf8String );
+			ui32Total += ui32Run;
+			_putf8String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			// From UTF-8 to raw.
 			ui32Char = NextUtf8Char( _putf8String, 4, &ui32ThisLen );
@@ -2262,6 +2368,12 @@ namespace lsstd {
 
 		uint32_t ui32Char;
 		do {
+#ifdef LSSTD_SIMD
+			// ASCII characters take one unit in every encoding.
+			uint32_t ui32Run = CSimdStd::Utf8AsciiLen( _putf8String );
+			ui32Total += ui32Run;
+			_putf8String += ui32Run;
+#endif	// #ifdef LSSTD_SIMD
 			uint32_t ui32ThisLen;
 			// From UTF-8 to raw.
 			ui32Char = NextUtf8Char( _putf8String, 4, &ui32ThisLen );
@@ -2420,6 +2532,8 @@ namespace lsstd {
 	void * LSE_CALL CStd::MemCpy( void * _pvDst, const void * _pvSrc, uintptr_t _uiptrSize ) {
 #ifdef __LSE_CRT_MEMFUNCS__
 		return ::memcpy( _pvDst, _pvSrc, _uiptrSize );
+#elif defined( LSSTD_SIMD )
+		return CSimdStd::MemCpy( _pvDst, _pvSrc, _uiptrSize );
 #else
 		// X = bytes-per-address on the current operating system.  We use uintptr_t
 		//	for this.
@@ -2534,6 +2648,9 @@ namespace lsstd {
 	 * \return Returns true if the buffers' contents are an exact match, false otherwise.
 	 */
 	LSBOOL LSE_CALL CStd::MemCmpF( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize ) {
+#ifdef LSSTD_SIMD
+		return CSimdStd::MemCmp( _pvBuf0, _pvBuf1, _uiptrSize ) == 0;
+#else
 		// X = bytes-per-address on the current operating system.  We use uintptr_t
 		//	for this.
 		//
@@ -2579,6 +2696,7 @@ namespace lsstd {
 		}
 
 		return true;
+#endif	// #ifdef LSSTD_SIMD
 	}
 #endif	// #if !(defined( __LSE_CRT_MEMFUNCS__ ) || defined( __LSE_CRT_MEMCMP__ ))
 
@@ -2592,6 +2710,9 @@ namespace lsstd {
 	 * \return Returns the lexicographic relationship between the given buffers.
 	 */
 	int32_t LSE_CALL CStd::MemCmp( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize ) {
+#ifdef LSSTD_SIMD
+		return CSimdStd::MemCmp( _pvBuf0, _pvBuf1, _uiptrSize );
+#else
 		// X = bytes-per-address on the current operating system.  We use uintptr_t
 		//	for this.
 		//
@@ -2608,7 +2729,7 @@ namespace lsstd {
 				if ( (*pui8Dest) < (*pui8Source) ) { return -1; }
 				if ( (*pui8Dest++) > (*pui8Source++) ) { return 1; }
 			}
-			return true;
+			return 0;
 		}
 
 		if ( uiptrX > _uiptrSize ) { uiptrX = _uiptrSize; }
@@ -2618,7 +2739,7 @@ namespace lsstd {
 			if ( (*pui8Dest) < (*pui8Source) ) { return -1; }
 			if ( (*pui8Dest++) > (*pui8Source++) ) { return 1; }
 		}
-		if ( uiptrX == _uiptrSize ) { return true; }
+		if ( uiptrX == _uiptrSize ) { return 0; }
 
 
 		// #2: Compare in chunks of X bytes.
@@ -2649,6 +2770,7 @@ namespace lsstd {
 		}
 
 		return 0;
+#endif	// #ifdef LSSTD_SIMD
 	}
 #endif	// #if !(defined( __LSE_CRT_MEMFUNCS__ ) || defined( __LSE_CRT_MEMCMP__ ))
 
@@ -2663,6 +2785,8 @@ namespace lsstd {
 #ifdef __LSE_CRT_MEMFUNCS__
 		::memset( _pvDst, _ui8Value, _uiptrSize );
 		return;
+#elif defined( LSSTD_SIMD )
+		CSimdStd::MemSet( _pvDst, _ui8Value, _uiptrSize );
 #else
 		// X = bytes-per-address on the current operating system.  We use uintptr_t
 		//	for this.
@@ -2842,7 +2966,7 @@ namespace lsstd {
 		else {
 			// Sleep for the given period of time.
 			timespec tsTime;
-			tsTime.tv_sec = static_cast<__darwin_time_t>(_ui32Milliseconds / 1000UL);
+			tsTime.tv_sec = static_cast<time_t>(_ui32Milliseconds / 1000UL);
 			tsTime.tv_nsec = static_cast<long>((_ui32Milliseconds % 1000UL) * 1000000UL);
 			::nanosleep( &tsTime, NULL );
 			// Whew!
@@ -2850,6 +2974,45 @@ namespace lsstd {
 #endif	// #ifdef LSE_WINDOWS
 	}
 
+	/**
+	 * Byte-swap each value in an array in place.
+	 *
+	 * \param _pvValues The values to byte-swap.
+	 * \param _uiptrTotal Number of values to which _pvValues points.
+	 * \param _ui32Size Size of each value in bytes.
+	 */
+	void LSE_CALL CStd::ByteSwapArray( void * _pvValues, uintptr_t _uiptrTotal, uint32_t _ui32Size ) {
+		uint8_t * pui8Values = static_cast<uint8_t *>(_pvValues);
+		// Aligned arrays of the common sizes go through the single-value swaps, which compile to one instruction.
+		if ( (reinterpret_cast<uintptr_t>(pui8Values) & (_ui32Size - 1)) == 0 ) {
+			switch ( _ui32Size ) {
+				case 1 : { return; }
+				case 2 : {
+					uint16_t * pui16Values = reinterpret_cast<uint16_t *>(pui8Values);
+					for ( uintptr_t I = 0; I < _uiptrTotal; ++I ) { pui16Values[I] = ByteSwap16( pui16Values[I] ); }
+					return;
+				}
+				case 4 : {
+					uint32_t * pui32Values = reinterpret_cast<uint32_t *>(pui8Values);
+					for ( uintptr_t I = 0; I < _uiptrTotal; ++I ) { pui32Values[I] = ByteSwap32( pui32Values[I] ); }
+					return;
+				}
+				case 8 : {
+					uint64_t * pui64Values = reinterpret_cast<uint64_t *>(pui8Values);
+					for ( uintptr_t I = 0; I < _uiptrTotal; ++I ) { pui64Values[I] = ByteSwap64( pui64Values[I] ); }
+					return;
+				}
+			}
+		}
+		for ( uintptr_t I = 0; I < _uiptrTotal; ++I, pui8Values += _ui32Size ) {
+			for ( uint32_t J = 0; J < _ui32Size / 2; ++J ) {
+				uint8_t ui8Temp = pui8Values[J];
+				pui8Values[J] = pui8Values[_ui32Size-1-J];
+				pui8Values[_ui32Size-1-J] = ui8Temp;
+			}
+		}
+	}
+
 	/**
 	 * Print a wide-character string to the debug console.
 	 *
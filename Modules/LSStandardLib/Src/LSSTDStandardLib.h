@@ -39,6 +39,7 @@
 #endif	// #if TARGET_OS_IPHONE
 #elif defined( __linux__ )
 #define LSE_LINUX
+#define LSE_POSIX			// Linux uses POSIX.
 #endif	// defined( WIN32 ) || defined( _WIN32 ) || defined( _WIN64 )
 
 
@@ -90,6 +91,7 @@ LSE_INLINE __m128 operator / ( const __m128 &_mL, const __m128 &_mR ) {
 #define LSE_EXPECT( COND, VAL )			(COND)
 #define LSE_PREFETCH_LINE( ADDR )		_mm_prefetch( reinterpret_cast<const char *>(ADDR), _MM_HINT_T0 )
 #define LSE_PREFETCH_LINE_WRITE( ADDR )
+#define LSE_THREAD_LOCAL				__declspec( thread )
 
 #define LSE_VISUALSTUDIO
 #ifndef _WCHAR_T_DEFINED
@@ -123,6 +125,7 @@ typedef unsigned short					wchar_t;
 #define LSE_EXPECT( COND, VAL )			__builtin_expect( COND, VAL )
 #define LSE_PREFETCH_LINE( ADDR )		__builtin_prefetch( reinterpret_cast<const void *>(ADDR), 0, 1 )
 #define LSE_PREFETCH_LINE_WRITE( ADDR )	__builtin_prefetch( reinterpret_cast<const void *>(ADDR), 1, 1 )
+#define LSE_THREAD_LOCAL				__thread
 
 #define LSE_GCC
 #else
@@ -177,6 +180,9 @@ typedef unsigned short					wchar_t;
 /** Round up to the next nearest Xth, where X is any number. */
 #define LSE_ROUND_UP_ANY( VALUE, X )	(((VALUE + ((X) - 1)) / (X)) * (X))
 
+/** Size of a cache line in bytes.  Used to pad data shared between threads so that unrelated values do not share a line. */
+#define LSE_CACHE_LINE_SIZE				64
+
 /** Number of elements in an array. */
 #define LSE_ELEMENTS( ARRAY )			(sizeof( (ARRAY) ) / sizeof( (ARRAY)[0] ))
 
@@ -1382,6 +1388,15 @@ namespace lsstd {
 		 */
 		static uint16_t LSE_CALL		ByteSwap16( uint16_t _ui16Value );
 
+		/**
+		 * Byte-swap each value in an array in place.
+		 *
+		 * \param _pvValues The values to byte-swap.
+		 * \param _uiptrTotal Number of values to which _pvValues points.
+		 * \param _ui32Size Size of each value in bytes.
+		 */
+		static void LSE_CALL			ByteSwapArray( void * _pvValues, uintptr_t _uiptrTotal, uint32_t _ui32Size );
+
 		/**
 		 * Swap the bits in a single byte.
 		 *
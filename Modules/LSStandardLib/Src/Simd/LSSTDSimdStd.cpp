@@ -0,0 +1,1059 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: SIMD implementations of the CStd memory and string routines.  SSE2 is used on x86 and x64 and
+ *	NEON on ARM.  AVX2 versions replace the SSE2 versions when the CPU supports them.
+ */
+
+#include "LSSTDSimdStd.h"
+
+#ifdef LSSTD_SIMD
+
+#ifdef LSSTD_SIMD_SSE2
+#include <emmintrin.h>
+#include <immintrin.h>
+#else
+#include <arm_neon.h>
+#endif	// #ifdef LSSTD_SIMD_SSE2
+
+#ifdef LSE_VISUALSTUDIO
+#include <intrin.h>
+#endif	// #ifdef LSE_VISUALSTUDIO
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// MACROS
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+/** The smallest page size of any supported platform.  Memory protection never changes within a page. */
+#define LSSTD_SIMD_PAGE_SIZE						4096
+
+/** Determines whether SIZE bytes starting at ADDR lie within one page, in which case they can all be read if
+ *	any of them can. */
+#define LSSTD_SIMD_SAME_PAGE( ADDR, SIZE )			((reinterpret_cast<uintptr_t>(ADDR) & (LSSTD_SIMD_PAGE_SIZE - 1)) <= (LSSTD_SIMD_PAGE_SIZE - (SIZE)))
+
+namespace lsstd {
+
+	/**
+	 * Class CSimd128
+	 * \brief The 128-bit operations shared by the SSE2 and NEON implementations.
+	 *
+	 * Description: The 128-bit operations shared by the SSE2 and NEON implementations.  Comparisons return a
+	 *	mask with (1 << LSSTD_MASK_SHIFT) bits set for each matching byte, lowest address in the lowest bits.  SSE2
+	 *	produces 1 bit per byte with PMOVMSKB; NEON has no equivalent and produces 4 bits per byte by narrowing.
+	 */
+	class CSimd128 {
+	public :
+		// == Types.
+#ifdef LSSTD_SIMD_SSE2
+		/** A vector. */
+		typedef __m128i								LSSTD_VECTOR;
+
+		/** Mask bits per byte, as a power of 2. */
+		enum { LSSTD_MASK_SHIFT = 0 };
+#else
+		/** A vector. */
+		typedef uint8x16_t							LSSTD_VECTOR;
+
+		/** Mask bits per byte, as a power of 2. */
+		enum { LSSTD_MASK_SHIFT = 2 };
+#endif	// #ifdef LSSTD_SIMD_SSE2
+
+
+		// == Functions.
+		/**
+		 * Loads 16 bytes from any address.
+		 *
+		 * \param _pvSrc The address from which to load.
+		 * \return Returns the loaded vector.
+		 */
+		static LSE_INLINE LSSTD_VECTOR LSE_CALL		Load( const void * _pvSrc ) {
+#ifdef LSSTD_SIMD_SSE2
+			return _mm_loadu_si128( static_cast<const __m128i *>(_pvSrc) );
+#else
+			return vld1q_u8( static_cast<const uint8_t *>(_pvSrc) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Loads 16 bytes from a 16-byte-aligned address.
+		 *
+		 * \param _pvSrc The address from which to load.
+		 * \return Returns the loaded vector.
+		 */
+		static LSE_INLINE LSSTD_VECTOR LSE_CALL		LoadAligned( const void * _pvSrc ) {
+#ifdef LSSTD_SIMD_SSE2
+			return _mm_load_si128( static_cast<const __m128i *>(_pvSrc) );
+#else
+			return vld1q_u8( static_cast<const uint8_t *>(_pvSrc) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Stores 16 bytes to any address.
+		 *
+		 * \param _pvDst The address to which to store.
+		 * \param _vVal The vector to store.
+		 */
+		static LSE_INLINE void LSE_CALL				Store( void * _pvDst, LSSTD_VECTOR _vVal ) {
+#ifdef LSSTD_SIMD_SSE2
+			_mm_storeu_si128( static_cast<__m128i *>(_pvDst), _vVal );
+#else
+			vst1q_u8( static_cast<uint8_t *>(_pvDst), _vVal );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Stores 16 bytes to a 16-byte-aligned address.
+		 *
+		 * \param _pvDst The address to which to store.
+		 * \param _vVal The vector to store.
+		 */
+		static LSE_INLINE void LSE_CALL				StoreAligned( void * _pvDst, LSSTD_VECTOR _vVal ) {
+#ifdef LSSTD_SIMD_SSE2
+			_mm_store_si128( static_cast<__m128i *>(_pvDst), _vVal );
+#else
+			vst1q_u8( static_cast<uint8_t *>(_pvDst), _vVal );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Copies 8 bytes between any addresses.
+		 *
+		 * \param _pvDst The address to which to copy.
+		 * \param _pvSrc The address from which to copy.
+		 */
+		static LSE_INLINE void LSE_CALL				Copy8( void * _pvDst, const void * _pvSrc ) {
+#ifdef LSSTD_SIMD_SSE2
+			_mm_storel_epi64( static_cast<__m128i *>(_pvDst), _mm_loadl_epi64( static_cast<const __m128i *>(_pvSrc) ) );
+#else
+			vst1_u8( static_cast<uint8_t *>(_pvDst), vld1_u8( static_cast<const uint8_t *>(_pvSrc) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Stores the low 8 bytes of a vector to any address.
+		 *
+		 * \param _pvDst The address to which to store.
+		 * \param _vVal The vector to store.
+		 */
+		static LSE_INLINE void LSE_CALL				Store8( void * _pvDst, LSSTD_VECTOR _vVal ) {
+#ifdef LSSTD_SIMD_SSE2
+			_mm_storel_epi64( static_cast<__m128i *>(_pvDst), _vVal );
+#else
+			vst1_u8( static_cast<uint8_t *>(_pvDst), vget_low_u8( _vVal ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Creates a vector with every byte set to the same value.
+		 *
+		 * \param _ui8Value The value.
+		 * \return Returns the vector.
+		 */
+		static LSE_INLINE LSSTD_VECTOR LSE_CALL		Splat( uint8_t _ui8Value ) {
+#ifdef LSSTD_SIMD_SSE2
+			return _mm_set1_epi8( static_cast<char>(_ui8Value) );
+#else
+			return vdupq_n_u8( _ui8Value );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Gets the mask that has every byte set.
+		 *
+		 * \return Returns the mask of a full vector.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			Full() {
+#ifdef LSSTD_SIMD_SSE2
+			return 0xFFFFULL;
+#else
+			return ~0ULL;
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Compares the bytes in two vectors.
+		 *
+		 * \param _vA The first vector.
+		 * \param _vB The second vector.
+		 * \return Returns a vector with 0xFF in each byte that is equal and 0 in the rest.
+		 */
+		static LSE_INLINE LSSTD_VECTOR LSE_CALL		CmpEq( LSSTD_VECTOR _vA, LSSTD_VECTOR _vB ) {
+#ifdef LSSTD_SIMD_SSE2
+			return _mm_cmpeq_epi8( _vA, _vB );
+#else
+			return vceqq_u8( _vA, _vB );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Bitwise AND of two vectors.
+		 *
+		 * \param _vA The first vector.
+		 * \param _vB The second vector.
+		 * \return Returns _vA & _vB.
+		 */
+		static LSE_INLINE LSSTD_VECTOR LSE_CALL		And( LSSTD_VECTOR _vA, LSSTD_VECTOR _vB ) {
+#ifdef LSSTD_SIMD_SSE2
+			return _mm_and_si128( _vA, _vB );
+#else
+			return vandq_u8( _vA, _vB );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Unsigned minimum of the bytes in two vectors.
+		 *
+		 * \param _vA The first vector.
+		 * \param _vB The second vector.
+		 * \return Returns the per-byte minimum of _vA and _vB.
+		 */
+		static LSE_INLINE LSSTD_VECTOR LSE_CALL		Min( LSSTD_VECTOR _vA, LSSTD_VECTOR _vB ) {
+#ifdef LSSTD_SIMD_SSE2
+			return _mm_min_epu8( _vA, _vB );
+#else
+			return vminq_u8( _vA, _vB );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Converts a vector of 0x00 and 0xFF bytes to a mask.
+		 *
+		 * \param _vA The vector.
+		 * \return Returns the mask of the 0xFF bytes.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			MoveMask( LSSTD_VECTOR _vA ) {
+#ifdef LSSTD_SIMD_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8( _vA ));
+#else
+			return vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( _vA ), 4 ) ), 0 );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Finds the bytes that are equal in two vectors.
+		 *
+		 * \param _vA The first vector.
+		 * \param _vB The second vector.
+		 * \return Returns the mask of equal bytes.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			Equal( LSSTD_VECTOR _vA, LSSTD_VECTOR _vB ) {
+			return MoveMask( CmpEq( _vA, _vB ) );
+		}
+
+		/**
+		 * Finds the bytes that are 0.
+		 *
+		 * \param _vA The vector.
+		 * \return Returns the mask of 0 bytes.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			Zero8( LSSTD_VECTOR _vA ) {
+			return Equal( _vA, Splat( 0 ) );
+		}
+
+		/**
+		 * Finds the 8-bit units that are not ASCII (1-127).
+		 *
+		 * \param _vA The vector.
+		 * \return Returns the mask of units that are 0 or above 127.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			NotAscii8( LSSTD_VECTOR _vA ) {
+#ifdef LSSTD_SIMD_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8( _vA )) | Zero8( _vA );
+#else
+			return MoveMask( vorrq_u8( vcgtq_u8( _vA, vdupq_n_u8( 0x7F ) ), vceqq_u8( _vA, vdupq_n_u8( 0 ) ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Finds the 16-bit units that are not ASCII (1-127).  Both bytes of each such unit are set in the mask.
+		 *
+		 * \param _vA The vector.
+		 * \return Returns the mask of units that are 0 or above 127.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			NotAscii16( LSSTD_VECTOR _vA ) {
+#ifdef LSSTD_SIMD_SSE2
+			__m128i vZero = _mm_setzero_si128();
+			__m128i vAscii = _mm_cmpeq_epi16( _mm_and_si128( _vA, _mm_set1_epi16( static_cast<short>(0xFF80) ) ), vZero );
+			return (static_cast<uint32_t>(_mm_movemask_epi8( vAscii )) ^ 0xFFFF) |
+				static_cast<uint32_t>(_mm_movemask_epi8( _mm_cmpeq_epi16( _vA, vZero ) ));
+#else
+			uint16x8_t vA = vreinterpretq_u16_u8( _vA );
+			return MoveMask( vreinterpretq_u8_u16( vorrq_u16( vcgtq_u16( vA, vdupq_n_u16( 0x7F ) ), vceqq_u16( vA, vdupq_n_u16( 0 ) ) ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Finds the 32-bit units that are not ASCII (1-127).  All bytes of each such unit are set in the mask.
+		 *
+		 * \param _vA The vector.
+		 * \return Returns the mask of units that are 0 or above 127.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			NotAscii32( LSSTD_VECTOR _vA ) {
+#ifdef LSSTD_SIMD_SSE2
+			return NotInRange32( _vA, 0x80 );
+#else
+			uint32x4_t vA = vreinterpretq_u32_u8( _vA );
+			return MoveMask( vreinterpretq_u8_u32( vorrq_u32( vcgtq_u32( vA, vdupq_n_u32( 0x7F ) ), vceqq_u32( vA, vdupq_n_u32( 0 ) ) ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Finds the 16-bit units that are not from 1 to 0xD7FF.  Both bytes of each such unit are set in the mask.
+		 *
+		 * \param _vA The vector.
+		 * \return Returns the mask of units that are 0 or above 0xD7FF.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			NotBmp16( LSSTD_VECTOR _vA ) {
+#ifdef LSSTD_SIMD_SSE2
+			// The saturating subtraction leaves 0 exactly for units up to 0xD7FF.
+			__m128i vZero = _mm_setzero_si128();
+			__m128i vOver = _mm_subs_epu16( _vA, _mm_set1_epi16( static_cast<short>(0xD7FF) ) );
+			return (static_cast<uint32_t>(_mm_movemask_epi8( _mm_cmpeq_epi16( vOver, vZero ) )) ^ 0xFFFF) |
+				static_cast<uint32_t>(_mm_movemask_epi8( _mm_cmpeq_epi16( _vA, vZero ) ));
+#else
+			uint16x8_t vA = vreinterpretq_u16_u8( _vA );
+			return MoveMask( vreinterpretq_u8_u16( vorrq_u16( vcgtq_u16( vA, vdupq_n_u16( 0xD7FF ) ), vceqq_u16( vA, vdupq_n_u16( 0 ) ) ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Finds the 32-bit units that are not from 1 to 0xD7FF.  All bytes of each such unit are set in the mask.
+		 *
+		 * \param _vA The vector.
+		 * \return Returns the mask of units that are 0 or above 0xD7FF.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			NotBmp32( LSSTD_VECTOR _vA ) {
+#ifdef LSSTD_SIMD_SSE2
+			return NotInRange32( _vA, 0xD800 );
+#else
+			uint32x4_t vA = vreinterpretq_u32_u8( _vA );
+			return MoveMask( vreinterpretq_u8_u32( vorrq_u32( vcgtq_u32( vA, vdupq_n_u32( 0xD7FF ) ), vceqq_u32( vA, vdupq_n_u32( 0 ) ) ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Gets the index of the first byte set in a non-zero mask.
+		 *
+		 * \param _ui64Mask The mask.
+		 * \return Returns the index of the lowest byte in the mask.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			FirstByte( uint64_t _ui64Mask ) {
+#ifdef LSE_VISUALSTUDIO
+			unsigned long ulIndex;
+#ifdef LSSTD_SIMD_SSE2
+			// SSE2 and AVX2 masks fit in 32 bits, which also serves 32-bit builds without _BitScanForward64().
+			::_BitScanForward( &ulIndex, static_cast<unsigned long>(_ui64Mask) );
+#else
+			::_BitScanForward64( &ulIndex, _ui64Mask );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+			return static_cast<uint32_t>(ulIndex) >> LSSTD_MASK_SHIFT;
+#else
+			return static_cast<uint32_t>(__builtin_ctzll( _ui64Mask )) >> LSSTD_MASK_SHIFT;
+#endif	// #ifdef LSE_VISUALSTUDIO
+		}
+
+		/**
+		 * Widens the 16 8-bit units in a vector to 16 bits.
+		 *
+		 * \param _vA The vector.
+		 * \param _vLo Holds the first 8 units.
+		 * \param _vHi Holds the last 8 units.
+		 */
+		static LSE_INLINE void LSE_CALL				Widen8( LSSTD_VECTOR _vA, LSSTD_VECTOR &_vLo, LSSTD_VECTOR &_vHi ) {
+#ifdef LSSTD_SIMD_SSE2
+			_vLo = _mm_unpacklo_epi8( _vA, _mm_setzero_si128() );
+			_vHi = _mm_unpackhi_epi8( _vA, _mm_setzero_si128() );
+#else
+			_vLo = vreinterpretq_u8_u16( vmovl_u8( vget_low_u8( _vA ) ) );
+			_vHi = vreinterpretq_u8_u16( vmovl_u8( vget_high_u8( _vA ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Widens the 8 16-bit units in a vector to 32 bits.
+		 *
+		 * \param _vA The vector.
+		 * \param _vLo Holds the first 4 units.
+		 * \param _vHi Holds the last 4 units.
+		 */
+		static LSE_INLINE void LSE_CALL				Widen16( LSSTD_VECTOR _vA, LSSTD_VECTOR &_vLo, LSSTD_VECTOR &_vHi ) {
+#ifdef LSSTD_SIMD_SSE2
+			_vLo = _mm_unpacklo_epi16( _vA, _mm_setzero_si128() );
+			_vHi = _mm_unpackhi_epi16( _vA, _mm_setzero_si128() );
+#else
+			uint16x8_t vA = vreinterpretq_u16_u8( _vA );
+			_vLo = vreinterpretq_u8_u32( vmovl_u16( vget_low_u16( vA ) ) );
+			_vHi = vreinterpretq_u8_u32( vmovl_u16( vget_high_u16( vA ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Narrows two vectors of 16-bit units below 0x80 to one vector of 8-bit units.
+		 *
+		 * \param _vLo The first 8 units.
+		 * \param _vHi The last 8 units.
+		 * \return Returns the 16 narrowed units.
+		 */
+		static LSE_INLINE LSSTD_VECTOR LSE_CALL		Narrow16( LSSTD_VECTOR _vLo, LSSTD_VECTOR _vHi ) {
+#ifdef LSSTD_SIMD_SSE2
+			return _mm_packus_epi16( _vLo, _vHi );
+#else
+			return vcombine_u8( vmovn_u16( vreinterpretq_u16_u8( _vLo ) ), vmovn_u16( vreinterpretq_u16_u8( _vHi ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+		/**
+		 * Narrows two vectors of 32-bit units below 0xD800 to one vector of 16-bit units.
+		 *
+		 * \param _vLo The first 4 units.
+		 * \param _vHi The last 4 units.
+		 * \return Returns the 8 narrowed units.
+		 */
+		static LSE_INLINE LSSTD_VECTOR LSE_CALL		Narrow32( LSSTD_VECTOR _vLo, LSSTD_VECTOR _vHi ) {
+#ifdef LSSTD_SIMD_SSE2
+			// SSE2 only packs with signed saturation, so sign-extend the low halves first to keep values
+			//	from 0x8000 intact.
+			return _mm_packs_epi32( _mm_srai_epi32( _mm_slli_epi32( _vLo, 16 ), 16 ),
+				_mm_srai_epi32( _mm_slli_epi32( _vHi, 16 ), 16 ) );
+#else
+			return vreinterpretq_u8_u16( vcombine_u16( vmovn_u32( vreinterpretq_u32_u8( _vLo ) ), vmovn_u32( vreinterpretq_u32_u8( _vHi ) ) ) );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		}
+
+
+	protected :
+		// == Functions.
+#ifdef LSSTD_SIMD_SSE2
+		/**
+		 * Finds the 32-bit units that are not from 1 to _i32Limit - 1.
+		 *
+		 * \param _vA The vector.
+		 * \param _i32Limit The exclusive upper limit, which must be positive.
+		 * \return Returns the mask of units outside of the range.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL			NotInRange32( __m128i _vA, int32_t _i32Limit ) {
+			// Units above 0x7FFFFFFF are negative and fail the first test.
+			__m128i vIn = _mm_and_si128( _mm_cmpgt_epi32( _vA, _mm_setzero_si128() ),
+				_mm_cmplt_epi32( _vA, _mm_set1_epi32( _i32Limit ) ) );
+			return static_cast<uint32_t>(_mm_movemask_epi8( vIn )) ^ 0xFFFF;
+		}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+	};
+
+	/**
+	 * Copies up to 16 bytes without vectors.
+	 *
+	 * \param _pui8Dst Destination buffer.
+	 * \param _pui8Src Buffer from which to copy.
+	 * \param _uiptrSize Number of bytes to copy, from 0 to 16.
+	 */
+	static LSE_INLINE void LSE_CALL					CopySmall( uint8_t * _pui8Dst, const uint8_t * _pui8Src, uintptr_t _uiptrSize ) {
+		// Two overlapping copies cover every size in each range.
+		if ( _uiptrSize >= 8 ) {
+			CSimd128::Copy8( _pui8Dst, _pui8Src );
+			CSimd128::Copy8( _pui8Dst + _uiptrSize - 8, _pui8Src + _uiptrSize - 8 );
+		}
+		else if ( _uiptrSize >= 4 ) {
+			uint32_t ui32A = (*reinterpret_cast<const uint32_t *>(_pui8Src));
+			uint32_t ui32B = (*reinterpret_cast<const uint32_t *>(_pui8Src + _uiptrSize - 4));
+			(*reinterpret_cast<uint32_t *>(_pui8Dst)) = ui32A;
+			(*reinterpret_cast<uint32_t *>(_pui8Dst + _uiptrSize - 4)) = ui32B;
+		}
+		else if ( _uiptrSize ) {
+			uint8_t ui8A = _pui8Src[0], ui8B = _pui8Src[_uiptrSize>>1], ui8C = _pui8Src[_uiptrSize-1];
+			_pui8Dst[0] = ui8A;
+			_pui8Dst[_uiptrSize>>1] = ui8B;
+			_pui8Dst[_uiptrSize-1] = ui8C;
+		}
+	}
+
+	/**
+	 * Fills up to 16 bytes without vectors.
+	 *
+	 * \param _pui8Dst Buffer to fill.
+	 * \param _ui8Value Value with which to fill the buffer.
+	 * \param _uiptrSize Number of bytes to fill, from 0 to 16.
+	 */
+	static LSE_INLINE void LSE_CALL					SetSmall( uint8_t * _pui8Dst, uint8_t _ui8Value, uintptr_t _uiptrSize ) {
+		if ( _uiptrSize >= 8 ) {
+			CSimd128::LSSTD_VECTOR vVal = CSimd128::Splat( _ui8Value );
+			CSimd128::Store8( _pui8Dst, vVal );
+			CSimd128::Store8( _pui8Dst + _uiptrSize - 8, vVal );
+		}
+		else if ( _uiptrSize >= 4 ) {
+			uint32_t ui32Val = _ui8Value * 0x01010101U;
+			(*reinterpret_cast<uint32_t *>(_pui8Dst)) = ui32Val;
+			(*reinterpret_cast<uint32_t *>(_pui8Dst + _uiptrSize - 4)) = ui32Val;
+		}
+		else if ( _uiptrSize ) {
+			_pui8Dst[0] = _ui8Value;
+			_pui8Dst[_uiptrSize>>1] = _ui8Value;
+			_pui8Dst[_uiptrSize-1] = _ui8Value;
+		}
+	}
+
+	// == Members.
+	/** The selected MemCpy() implementation. */
+	CSimdStd::PfMemCpy CSimdStd::m_pfMemCpy = CSimdStd::MemCpy128;
+
+	/** The selected MemSet() implementation. */
+	CSimdStd::PfMemSet CSimdStd::m_pfMemSet = CSimdStd::MemSet128;
+
+	/** The selected MemCmp() implementation. */
+	CSimdStd::PfMemCmp CSimdStd::m_pfMemCmp = CSimdStd::MemCmp128;
+
+	/** The selected StrLen() implementation. */
+	CSimdStd::PfStrLen CSimdStd::m_pfStrLen = CSimdStd::StrLen128;
+
+	/** The selected StrCmp() implementation. */
+	CSimdStd::PfStrCmp CSimdStd::m_pfStrCmp = CSimdStd::StrCmp128;
+
+	/** Set when the implementations are selected during static initialization.  Until then, the 128-bit
+	 *	implementations are used. */
+	LSBOOL CSimdStd::m_bSelected = CSimdStd::Select();
+
+	// == Functions.
+	/**
+	 * Selects the fastest implementations supported by the CPU.
+	 *
+	 * \return Returns true.
+	 */
+	LSBOOL LSE_CALL CSimdStd::Select() {
+#ifdef LSSTD_SIMD_SSE2
+		if ( CCpu::HasAvx2() ) {
+			m_pfMemCpy = MemCpy256;
+			m_pfMemSet = MemSet256;
+			m_pfMemCmp = MemCmp256;
+			m_pfStrLen = StrLen256;
+			m_pfStrCmp = StrCmp256;
+		}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+		return true;
+	}
+
+	/** 128-bit (SSE2 or NEON) implementation of MemCpy(). */
+	void * LSE_CALL CSimdStd::MemCpy128( void * _pvDst, const void * _pvSrc, uintptr_t _uiptrSize ) {
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		if ( _uiptrSize <= 16 ) {
+			CopySmall( pui8Dst, pui8Src, _uiptrSize );
+			return _pvDst;
+		}
+		CSimd128::LSSTD_VECTOR vHead = CSimd128::Load( pui8Src );
+		CSimd128::LSSTD_VECTOR vTail = CSimd128::Load( pui8Src + _uiptrSize - 16 );
+		uint8_t * pui8Tail = pui8Dst + _uiptrSize - 16;
+		if ( _uiptrSize > 32 ) {
+			// The unaligned head and tail cover the ends, so the middle is copied in whole aligned blocks.
+			uintptr_t uiptrSkip = 16 - (reinterpret_cast<uintptr_t>(pui8Dst) & 15);
+			uint8_t * pui8This = pui8Dst + uiptrSkip;
+			const uint8_t * pui8ThisSrc = pui8Src + uiptrSkip;
+			while ( pui8This + 64 <= pui8Tail ) {
+				CSimd128::LSSTD_VECTOR vA = CSimd128::Load( pui8ThisSrc );
+				CSimd128::LSSTD_VECTOR vB = CSimd128::Load( pui8ThisSrc + 16 );
+				CSimd128::LSSTD_VECTOR vC = CSimd128::Load( pui8ThisSrc + 32 );
+				CSimd128::LSSTD_VECTOR vD = CSimd128::Load( pui8ThisSrc + 48 );
+				CSimd128::StoreAligned( pui8This, vA );
+				CSimd128::StoreAligned( pui8This + 16, vB );
+				CSimd128::StoreAligned( pui8This + 32, vC );
+				CSimd128::StoreAligned( pui8This + 48, vD );
+				pui8This += 64;
+				pui8ThisSrc += 64;
+			}
+			while ( pui8This < pui8Tail ) {
+				CSimd128::StoreAligned( pui8This, CSimd128::Load( pui8ThisSrc ) );
+				pui8This += 16;
+				pui8ThisSrc += 16;
+			}
+		}
+		CSimd128::Store( pui8Dst, vHead );
+		CSimd128::Store( pui8Tail, vTail );
+		return _pvDst;
+	}
+
+	/** 128-bit (SSE2 or NEON) implementation of MemSet(). */
+	void LSE_CALL CSimdStd::MemSet128( void * _pvDst, uint8_t _ui8Value, uintptr_t _uiptrSize ) {
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		if ( _uiptrSize <= 16 ) {
+			SetSmall( pui8Dst, _ui8Value, _uiptrSize );
+			return;
+		}
+		CSimd128::LSSTD_VECTOR vVal = CSimd128::Splat( _ui8Value );
+		uint8_t * pui8Tail = pui8Dst + _uiptrSize - 16;
+		CSimd128::Store( pui8Dst, vVal );
+		if ( _uiptrSize > 32 ) {
+			uint8_t * pui8This = pui8Dst + 16 - (reinterpret_cast<uintptr_t>(pui8Dst) & 15);
+			while ( pui8This + 64 <= pui8Tail ) {
+				CSimd128::StoreAligned( pui8This, vVal );
+				CSimd128::StoreAligned( pui8This + 16, vVal );
+				CSimd128::StoreAligned( pui8This + 32, vVal );
+				CSimd128::StoreAligned( pui8This + 48, vVal );
+				pui8This += 64;
+			}
+			while ( pui8This < pui8Tail ) {
+				CSimd128::StoreAligned( pui8This, vVal );
+				pui8This += 16;
+			}
+		}
+		CSimd128::Store( pui8Tail, vVal );
+	}
+
+	/** 128-bit (SSE2 or NEON) implementation of MemCmp(). */
+	int32_t LSE_CALL CSimdStd::MemCmp128( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize ) {
+		const uint8_t * pui8Left = static_cast<const uint8_t *>(_pvBuf0);
+		const uint8_t * pui8Right = static_cast<const uint8_t *>(_pvBuf1);
+		if ( _uiptrSize < 16 ) {
+			for ( uintptr_t I = 0; I < _uiptrSize; ++I ) {
+				if ( pui8Left[I] != pui8Right[I] ) {
+					return static_cast<int32_t>(pui8Left[I]) - static_cast<int32_t>(pui8Right[I]);
+				}
+			}
+			return 0;
+		}
+		uintptr_t I = 0;
+		// Check 64 bytes at a time with one mask, then go back to find the difference.
+		for ( ; I + 64 <= _uiptrSize; I += 64 ) {
+			CSimd128::LSSTD_VECTOR vEq = CSimd128::And(
+				CSimd128::And( CSimd128::CmpEq( CSimd128::Load( pui8Left + I ), CSimd128::Load( pui8Right + I ) ),
+					CSimd128::CmpEq( CSimd128::Load( pui8Left + I + 16 ), CSimd128::Load( pui8Right + I + 16 ) ) ),
+				CSimd128::And( CSimd128::CmpEq( CSimd128::Load( pui8Left + I + 32 ), CSimd128::Load( pui8Right + I + 32 ) ),
+					CSimd128::CmpEq( CSimd128::Load( pui8Left + I + 48 ), CSimd128::Load( pui8Right + I + 48 ) ) ) );
+			if ( CSimd128::MoveMask( vEq ) != CSimd128::Full() ) { break; }
+		}
+		uintptr_t uiptrLast = _uiptrSize - 16;
+		for ( ; ; I += 16 ) {
+			// The final block overlaps the previous one so that no partial block remains.
+			if ( I > uiptrLast ) { I = uiptrLast; }
+			uint64_t ui64Diff = CSimd128::Equal( CSimd128::Load( pui8Left + I ), CSimd128::Load( pui8Right + I ) ) ^ CSimd128::Full();
+			if ( ui64Diff ) {
+				I += CSimd128::FirstByte( ui64Diff );
+				return static_cast<int32_t>(pui8Left[I]) - static_cast<int32_t>(pui8Right[I]);
+			}
+			if ( I == uiptrLast ) { return 0; }
+		}
+	}
+
+	/** 128-bit (SSE2 or NEON) implementation of StrLen(). */
+	uint32_t LSE_CALL CSimdStd::StrLen128( const char * _pcStr ) {
+		// Aligned blocks never cross a page.  Bytes before the string in the first block are shifted out of the mask.
+		uintptr_t uiptrOffset = reinterpret_cast<uintptr_t>(_pcStr) & 15;
+		const char * pcThis = _pcStr - uiptrOffset;
+		uint64_t ui64Mask = CSimd128::Zero8( CSimd128::LoadAligned( pcThis ) ) >> (uiptrOffset << CSimd128::LSSTD_MASK_SHIFT);
+		if ( ui64Mask ) { return CSimd128::FirstByte( ui64Mask ); }
+		// Single blocks up to a 64-byte boundary, then 4 blocks at a time.
+		for ( pcThis += 16; reinterpret_cast<uintptr_t>(pcThis) & 63; pcThis += 16 ) {
+			ui64Mask = CSimd128::Zero8( CSimd128::LoadAligned( pcThis ) );
+			if ( ui64Mask ) { return static_cast<uint32_t>(pcThis - _pcStr) + CSimd128::FirstByte( ui64Mask ); }
+		}
+		while ( true ) {
+			CSimd128::LSSTD_VECTOR vA = CSimd128::LoadAligned( pcThis );
+			CSimd128::LSSTD_VECTOR vB = CSimd128::LoadAligned( pcThis + 16 );
+			CSimd128::LSSTD_VECTOR vC = CSimd128::LoadAligned( pcThis + 32 );
+			CSimd128::LSSTD_VECTOR vD = CSimd128::LoadAligned( pcThis + 48 );
+			// A byte is 0 in the minimum if it is 0 in any of the blocks.
+			if ( CSimd128::Zero8( CSimd128::Min( CSimd128::Min( vA, vB ), CSimd128::Min( vC, vD ) ) ) ) {
+				uint32_t ui32Base = static_cast<uint32_t>(pcThis - _pcStr);
+				if ( (ui64Mask = CSimd128::Zero8( vA )) != 0 ) { return ui32Base + CSimd128::FirstByte( ui64Mask ); }
+				if ( (ui64Mask = CSimd128::Zero8( vB )) != 0 ) { return ui32Base + 16 + CSimd128::FirstByte( ui64Mask ); }
+				if ( (ui64Mask = CSimd128::Zero8( vC )) != 0 ) { return ui32Base + 32 + CSimd128::FirstByte( ui64Mask ); }
+				return ui32Base + 48 + CSimd128::FirstByte( CSimd128::Zero8( vD ) );
+			}
+			pcThis += 64;
+		}
+	}
+
+	/** 128-bit (SSE2 or NEON) implementation of StrCmp(). */
+	int32_t LSE_CALL CSimdStd::StrCmp128( const char * _pcLeft, const char * _pcRight ) {
+		uintptr_t I = 0;
+		while ( true ) {
+			// Blocks can be read from both strings until one of them reaches the end of a page.
+			uintptr_t uiptrLeft = LSSTD_SIMD_PAGE_SIZE - (reinterpret_cast<uintptr_t>(_pcLeft + I) & (LSSTD_SIMD_PAGE_SIZE - 1));
+			uintptr_t uiptrRight = LSSTD_SIMD_PAGE_SIZE - (reinterpret_cast<uintptr_t>(_pcRight + I) & (LSSTD_SIMD_PAGE_SIZE - 1));
+			uintptr_t uiptrEnd = I + (uiptrLeft < uiptrRight ? uiptrLeft : uiptrRight);
+			for ( ; I + 16 <= uiptrEnd; I += 16 ) {
+				CSimd128::LSSTD_VECTOR vLeft = CSimd128::Load( _pcLeft + I );
+				uint64_t ui64Stop = (CSimd128::Equal( vLeft, CSimd128::Load( _pcRight + I ) ) ^ CSimd128::Full()) |
+					CSimd128::Zero8( vLeft );
+				if ( ui64Stop ) {
+					I += CSimd128::FirstByte( ui64Stop );
+					return _pcLeft[I] - _pcRight[I];
+				}
+			}
+			// Step over the page boundary a byte at a time.
+			for ( ; I < uiptrEnd; ++I ) {
+				char cLeft = _pcLeft[I];
+				int32_t i32Diff = cLeft - _pcRight[I];
+				if ( i32Diff || !cLeft ) { return i32Diff; }
+			}
+		}
+	}
+
+#ifdef LSSTD_SIMD_SSE2
+	/** AVX2 implementation of MemCpy(). */
+	LSSTD_TARGET( "avx2" )
+	void * LSE_CALL CSimdStd::MemCpy256( void * _pvDst, const void * _pvSrc, uintptr_t _uiptrSize ) {
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		const uint8_t * pui8Src = static_cast<const uint8_t *>(_pvSrc);
+		if ( _uiptrSize <= 32 ) {
+			if ( _uiptrSize <= 16 ) {
+				CopySmall( pui8Dst, pui8Src, _uiptrSize );
+			}
+			else {
+				__m128i vHead = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src) );
+				__m128i vTail = _mm_loadu_si128( reinterpret_cast<const __m128i *>(pui8Src + _uiptrSize - 16) );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst), vHead );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst + _uiptrSize - 16), vTail );
+			}
+			return _pvDst;
+		}
+		__m256i vHead = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Src) );
+		__m256i vTail = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Src + _uiptrSize - 32) );
+		uint8_t * pui8Tail = pui8Dst + _uiptrSize - 32;
+		if ( _uiptrSize > 64 ) {
+			uintptr_t uiptrSkip = 32 - (reinterpret_cast<uintptr_t>(pui8Dst) & 31);
+			uint8_t * pui8This = pui8Dst + uiptrSkip;
+			const uint8_t * pui8ThisSrc = pui8Src + uiptrSkip;
+			while ( pui8This + 128 <= pui8Tail ) {
+				__m256i vA = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8ThisSrc) );
+				__m256i vB = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8ThisSrc + 32) );
+				__m256i vC = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8ThisSrc + 64) );
+				__m256i vD = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8ThisSrc + 96) );
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This), vA );
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This + 32), vB );
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This + 64), vC );
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This + 96), vD );
+				pui8This += 128;
+				pui8ThisSrc += 128;
+			}
+			while ( pui8This < pui8Tail ) {
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This), _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8ThisSrc) ) );
+				pui8This += 32;
+				pui8ThisSrc += 32;
+			}
+		}
+		_mm256_storeu_si256( reinterpret_cast<__m256i *>(pui8Dst), vHead );
+		_mm256_storeu_si256( reinterpret_cast<__m256i *>(pui8Tail), vTail );
+		_mm256_zeroupper();
+		return _pvDst;
+	}
+
+	/** AVX2 implementation of MemSet(). */
+	LSSTD_TARGET( "avx2" )
+	void LSE_CALL CSimdStd::MemSet256( void * _pvDst, uint8_t _ui8Value, uintptr_t _uiptrSize ) {
+		uint8_t * pui8Dst = static_cast<uint8_t *>(_pvDst);
+		if ( _uiptrSize <= 32 ) {
+			if ( _uiptrSize <= 16 ) {
+				SetSmall( pui8Dst, _ui8Value, _uiptrSize );
+			}
+			else {
+				__m128i vVal = _mm_set1_epi8( static_cast<char>(_ui8Value) );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst), vVal );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Dst + _uiptrSize - 16), vVal );
+			}
+			return;
+		}
+		__m256i vVal = _mm256_set1_epi8( static_cast<char>(_ui8Value) );
+		uint8_t * pui8Tail = pui8Dst + _uiptrSize - 32;
+		_mm256_storeu_si256( reinterpret_cast<__m256i *>(pui8Dst), vVal );
+		if ( _uiptrSize > 64 ) {
+			uint8_t * pui8This = pui8Dst + 32 - (reinterpret_cast<uintptr_t>(pui8Dst) & 31);
+			while ( pui8This + 128 <= pui8Tail ) {
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This), vVal );
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This + 32), vVal );
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This + 64), vVal );
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This + 96), vVal );
+				pui8This += 128;
+			}
+			while ( pui8This < pui8Tail ) {
+				_mm256_store_si256( reinterpret_cast<__m256i *>(pui8This), vVal );
+				pui8This += 32;
+			}
+		}
+		_mm256_storeu_si256( reinterpret_cast<__m256i *>(pui8Tail), vVal );
+		_mm256_zeroupper();
+	}
+
+	/** AVX2 implementation of MemCmp(). */
+	LSSTD_TARGET( "avx2" )
+	int32_t LSE_CALL CSimdStd::MemCmp256( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize ) {
+		const uint8_t * pui8Left = static_cast<const uint8_t *>(_pvBuf0);
+		const uint8_t * pui8Right = static_cast<const uint8_t *>(_pvBuf1);
+		if ( _uiptrSize < 32 ) {
+			return MemCmp128( _pvBuf0, _pvBuf1, _uiptrSize );
+		}
+		uintptr_t I = 0;
+		for ( ; I + 128 <= _uiptrSize; I += 128 ) {
+			__m256i vEq0 = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Left + I) ),
+				_mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Right + I) ) );
+			__m256i vEq1 = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Left + I + 32) ),
+				_mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Right + I + 32) ) );
+			__m256i vEq2 = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Left + I + 64) ),
+				_mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Right + I + 64) ) );
+			__m256i vEq3 = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Left + I + 96) ),
+				_mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Right + I + 96) ) );
+			__m256i vEq = _mm256_and_si256( _mm256_and_si256( vEq0, vEq1 ), _mm256_and_si256( vEq2, vEq3 ) );
+			if ( static_cast<uint32_t>(_mm256_movemask_epi8( vEq )) != 0xFFFFFFFF ) { break; }
+		}
+		uintptr_t uiptrLast = _uiptrSize - 32;
+		for ( ; ; I += 32 ) {
+			if ( I > uiptrLast ) { I = uiptrLast; }
+			__m256i vEq = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Left + I) ),
+				_mm256_loadu_si256( reinterpret_cast<const __m256i *>(pui8Right + I) ) );
+			uint32_t ui32Diff = ~static_cast<uint32_t>(_mm256_movemask_epi8( vEq ));
+			if ( ui32Diff ) {
+				_mm256_zeroupper();
+				I += CSimd128::FirstByte( ui32Diff );
+				return static_cast<int32_t>(pui8Left[I]) - static_cast<int32_t>(pui8Right[I]);
+			}
+			if ( I == uiptrLast ) {
+				_mm256_zeroupper();
+				return 0;
+			}
+		}
+	}
+
+	/** AVX2 implementation of StrLen(). */
+	LSSTD_TARGET( "avx2" )
+	uint32_t LSE_CALL CSimdStd::StrLen256( const char * _pcStr ) {
+		uintptr_t uiptrOffset = reinterpret_cast<uintptr_t>(_pcStr) & 31;
+		const char * pcThis = _pcStr - uiptrOffset;
+		__m256i vZero = _mm256_setzero_si256();
+		uint32_t ui32Mask = static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_load_si256( reinterpret_cast<const __m256i *>(pcThis) ), vZero ) )) >> uiptrOffset;
+		if ( ui32Mask ) {
+			_mm256_zeroupper();
+			return CSimd128::FirstByte( ui32Mask );
+		}
+		for ( pcThis += 32; reinterpret_cast<uintptr_t>(pcThis) & 127; pcThis += 32 ) {
+			ui32Mask = static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_load_si256( reinterpret_cast<const __m256i *>(pcThis) ), vZero ) ));
+			if ( ui32Mask ) {
+				_mm256_zeroupper();
+				return static_cast<uint32_t>(pcThis - _pcStr) + CSimd128::FirstByte( ui32Mask );
+			}
+		}
+		while ( true ) {
+			__m256i vA = _mm256_load_si256( reinterpret_cast<const __m256i *>(pcThis) );
+			__m256i vB = _mm256_load_si256( reinterpret_cast<const __m256i *>(pcThis + 32) );
+			__m256i vC = _mm256_load_si256( reinterpret_cast<const __m256i *>(pcThis + 64) );
+			__m256i vD = _mm256_load_si256( reinterpret_cast<const __m256i *>(pcThis + 96) );
+			__m256i vMin = _mm256_min_epu8( _mm256_min_epu8( vA, vB ), _mm256_min_epu8( vC, vD ) );
+			if ( _mm256_movemask_epi8( _mm256_cmpeq_epi8( vMin, vZero ) ) ) {
+				// Pair up the block masks to find the first 0 with fewer branches.
+				uint64_t ui64Lo = static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( vA, vZero ) )) |
+					(static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( vB, vZero ) ))) << 32);
+				uint64_t ui64Hi = static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( vC, vZero ) )) |
+					(static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( vD, vZero ) ))) << 32);
+				_mm256_zeroupper();
+				uint32_t ui32Base = static_cast<uint32_t>(pcThis - _pcStr);
+				if ( !ui64Lo ) {
+					ui32Base += 64;
+					ui64Lo = ui64Hi;
+				}
+				if ( !static_cast<uint32_t>(ui64Lo) ) {
+					ui32Base += 32;
+					ui64Lo >>= 32;
+				}
+				return ui32Base + CSimd128::FirstByte( static_cast<uint32_t>(ui64Lo) );
+			}
+			pcThis += 128;
+		}
+	}
+
+	/** AVX2 implementation of StrCmp(). */
+	LSSTD_TARGET( "avx2" )
+	int32_t LSE_CALL CSimdStd::StrCmp256( const char * _pcLeft, const char * _pcRight ) {
+		__m256i vZero = _mm256_setzero_si256();
+		uintptr_t I = 0;
+		while ( true ) {
+			uintptr_t uiptrLeft = LSSTD_SIMD_PAGE_SIZE - (reinterpret_cast<uintptr_t>(_pcLeft + I) & (LSSTD_SIMD_PAGE_SIZE - 1));
+			uintptr_t uiptrRight = LSSTD_SIMD_PAGE_SIZE - (reinterpret_cast<uintptr_t>(_pcRight + I) & (LSSTD_SIMD_PAGE_SIZE - 1));
+			uintptr_t uiptrEnd = I + (uiptrLeft < uiptrRight ? uiptrLeft : uiptrRight);
+			for ( ; I + 32 <= uiptrEnd; I += 32 ) {
+				__m256i vLeft = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(_pcLeft + I) );
+				__m256i vRight = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(_pcRight + I) );
+				uint32_t ui32Stop = ~static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( vLeft, vRight ) )) |
+					static_cast<uint32_t>(_mm256_movemask_epi8( _mm256_cmpeq_epi8( vLeft, vZero ) ));
+				if ( ui32Stop ) {
+					_mm256_zeroupper();
+					I += CSimd128::FirstByte( ui32Stop );
+					return _pcLeft[I] - _pcRight[I];
+				}
+			}
+			for ( ; I < uiptrEnd; ++I ) {
+				char cLeft = _pcLeft[I];
+				int32_t i32Diff = cLeft - _pcRight[I];
+				if ( i32Diff || !cLeft ) {
+					_mm256_zeroupper();
+					return i32Diff;
+				}
+			}
+		}
+	}
+#endif	// #ifdef LSSTD_SIMD_SSE2
+
+	/** Implementation of Utf8AsciiLen() once the first 2 characters are known to be ASCII. */
+	uint32_t LSE_CALL CSimdStd::Utf8AsciiLen128( const LSUTF8 * _putf8Src ) {
+		const LSUTF8 * putf8This = _putf8Src;
+		while ( true ) {
+			if ( LSSTD_SIMD_SAME_PAGE( putf8This, 16 ) ) {
+				uint64_t ui64Stop = CSimd128::NotAscii8( CSimd128::Load( putf8This ) );
+				if ( ui64Stop ) { return static_cast<uint32_t>(putf8This - _putf8Src) + CSimd128::FirstByte( ui64Stop ); }
+				putf8This += 16;
+			}
+			else {
+				if ( !LSSTD_SIMD_IS_ASCII( (*putf8This) ) ) { return static_cast<uint32_t>(putf8This - _putf8Src); }
+				++putf8This;
+			}
+		}
+	}
+
+	/** Implementation of Utf16AsciiLen() once the first 2 characters are known to be ASCII. */
+	uint32_t LSE_CALL CSimdStd::Utf16AsciiLen128( const LSUTF16 * _putf16Src ) {
+		const LSUTF16 * putf16This = _putf16Src;
+		while ( true ) {
+			if ( LSSTD_SIMD_SAME_PAGE( putf16This, 16 ) ) {
+				uint64_t ui64Stop = CSimd128::NotAscii16( CSimd128::Load( putf16This ) );
+				if ( ui64Stop ) { return static_cast<uint32_t>(putf16This - _putf16Src) + (CSimd128::FirstByte( ui64Stop ) >> 1); }
+				putf16This += 8;
+			}
+			else {
+				if ( !LSSTD_SIMD_IS_ASCII( (*putf16This) ) ) { return static_cast<uint32_t>(putf16This - _putf16Src); }
+				++putf16This;
+			}
+		}
+	}
+
+	/** Implementation of Utf32AsciiLen() once the first 2 characters are known to be ASCII. */
+	uint32_t LSE_CALL CSimdStd::Utf32AsciiLen128( const LSUTF32 * _putf32Src ) {
+		const LSUTF32 * putf32This = _putf32Src;
+		while ( true ) {
+			if ( LSSTD_SIMD_SAME_PAGE( putf32This, 16 ) ) {
+				uint64_t ui64Stop = CSimd128::NotAscii32( CSimd128::Load( putf32This ) );
+				if ( ui64Stop ) { return static_cast<uint32_t>(putf32This - _putf32Src) + (CSimd128::FirstByte( ui64Stop ) >> 2); }
+				putf32This += 4;
+			}
+			else {
+				if ( !LSSTD_SIMD_IS_ASCII( (*putf32This) ) ) { return static_cast<uint32_t>(putf32This - _putf32Src); }
+				++putf32This;
+			}
+		}
+	}
+
+	/** Implementation of Utf8AsciiToUtf16() once the first 2 characters are known to be ASCII. */
+	uint32_t LSE_CALL CSimdStd::Utf8AsciiToUtf16128( LSUTF16 * _putf16Dst, const LSUTF8 * _putf8Src, uint32_t _ui32MaxLen ) {
+		uint32_t I = 0;
+		while ( I + 16 <= _ui32MaxLen && LSSTD_SIMD_SAME_PAGE( _putf8Src + I, 16 ) ) {
+			CSimd128::LSSTD_VECTOR vSrc = CSimd128::Load( _putf8Src + I );
+			if ( CSimd128::NotAscii8( vSrc ) ) { break; }
+			CSimd128::LSSTD_VECTOR vLo, vHi;
+			CSimd128::Widen8( vSrc, vLo, vHi );
+			CSimd128::Store( _putf16Dst + I, vLo );
+			CSimd128::Store( _putf16Dst + I + 8, vHi );
+			I += 16;
+		}
+		// Finish the block containing the stop, or whatever does not fit in a whole block.
+		for ( ; I < _ui32MaxLen && LSSTD_SIMD_IS_ASCII( _putf8Src[I] ); ++I ) {
+			_putf16Dst[I] = _putf8Src[I];
+		}
+		return I;
+	}
+
+	/** Implementation of Utf8AsciiToUtf32() once the first 2 characters are known to be ASCII. */
+	uint32_t LSE_CALL CSimdStd::Utf8AsciiToUtf32128( LSUTF32 * _putf32Dst, const LSUTF8 * _putf8Src, uint32_t _ui32MaxLen ) {
+		uint32_t I = 0;
+		while ( I + 16 <= _ui32MaxLen && LSSTD_SIMD_SAME_PAGE( _putf8Src + I, 16 ) ) {
+			CSimd128::LSSTD_VECTOR vSrc = CSimd128::Load( _putf8Src + I );
+			if ( CSimd128::NotAscii8( vSrc ) ) { break; }
+			CSimd128::LSSTD_VECTOR vLo16, vHi16, vA, vB;
+			CSimd128::Widen8( vSrc, vLo16, vHi16 );
+			CSimd128::Widen16( vLo16, vA, vB );
+			CSimd128::Store( _putf32Dst + I, vA );
+			CSimd128::Store( _putf32Dst + I + 4, vB );
+			CSimd128::Widen16( vHi16, vA, vB );
+			CSimd128::Store( _putf32Dst + I + 8, vA );
+			CSimd128::Store( _putf32Dst + I + 12, vB );
+			I += 16;
+		}
+		for ( ; I < _ui32MaxLen && LSSTD_SIMD_IS_ASCII( _putf8Src[I] ); ++I ) {
+			_putf32Dst[I] = _putf8Src[I];
+		}
+		return I;
+	}
+
+	/** Implementation of Utf16AsciiToUtf8() once the first 2 characters are known to be ASCII. */
+	uint32_t LSE_CALL CSimdStd::Utf16AsciiToUtf8128( LSUTF8 * _putf8Dst, const LSUTF16 * _putf16Src, uint32_t _ui32MaxLen ) {
+		uint32_t I = 0;
+		while ( I + 16 <= _ui32MaxLen && LSSTD_SIMD_SAME_PAGE( _putf16Src + I, 32 ) ) {
+			CSimd128::LSSTD_VECTOR vLo = CSimd128::Load( _putf16Src + I );
+			CSimd128::LSSTD_VECTOR vHi = CSimd128::Load( _putf16Src + I + 8 );
+			if ( CSimd128::NotAscii16( vLo ) | CSimd128::NotAscii16( vHi ) ) { break; }
+			CSimd128::Store( _putf8Dst + I, CSimd128::Narrow16( vLo, vHi ) );
+			I += 16;
+		}
+		for ( ; I < _ui32MaxLen && LSSTD_SIMD_IS_ASCII( _putf16Src[I] ); ++I ) {
+			_putf8Dst[I] = static_cast<LSUTF8>(_putf16Src[I]);
+		}
+		return I;
+	}
+
+	/** Implementation of Utf32AsciiToUtf8() once the first 2 characters are known to be ASCII. */
+	uint32_t LSE_CALL CSimdStd::Utf32AsciiToUtf8128( LSUTF8 * _putf8Dst, const LSUTF32 * _putf32Src, uint32_t _ui32MaxLen ) {
+		uint32_t I = 0;
+		while ( I + 16 <= _ui32MaxLen && LSSTD_SIMD_SAME_PAGE( _putf32Src + I, 64 ) ) {
+			CSimd128::LSSTD_VECTOR vA = CSimd128::Load( _putf32Src + I );
+			CSimd128::LSSTD_VECTOR vB = CSimd128::Load( _putf32Src + I + 4 );
+			CSimd128::LSSTD_VECTOR vC = CSimd128::Load( _putf32Src + I + 8 );
+			CSimd128::LSSTD_VECTOR vD = CSimd128::Load( _putf32Src + I + 12 );
+			if ( CSimd128::NotAscii32( vA ) | CSimd128::NotAscii32( vB ) | CSimd128::NotAscii32( vC ) | CSimd128::NotAscii32( vD ) ) { break; }
+			CSimd128::Store( _putf8Dst + I, CSimd128::Narrow16( CSimd128::Narrow32( vA, vB ), CSimd128::Narrow32( vC, vD ) ) );
+			I += 16;
+		}
+		for ( ; I < _ui32MaxLen && LSSTD_SIMD_IS_ASCII( _putf32Src[I] ); ++I ) {
+			_putf8Dst[I] = static_cast<LSUTF8>(_putf32Src[I]);
+		}
+		return I;
+	}
+
+	/** Implementation of Utf16BmpToUtf32() once the first 2 characters are known to be in range. */
+	uint32_t LSE_CALL CSimdStd::Utf16BmpToUtf32128( LSUTF32 * _putf32Dst, const LSUTF16 * _putf16Src, uint32_t _ui32MaxLen ) {
+		uint32_t I = 0;
+		while ( I + 8 <= _ui32MaxLen && LSSTD_SIMD_SAME_PAGE( _putf16Src + I, 16 ) ) {
+			CSimd128::LSSTD_VECTOR vSrc = CSimd128::Load( _putf16Src + I );
+			if ( CSimd128::NotBmp16( vSrc ) ) { break; }
+			CSimd128::LSSTD_VECTOR vLo, vHi;
+			CSimd128::Widen16( vSrc, vLo, vHi );
+			CSimd128::Store( _putf32Dst + I, vLo );
+			CSimd128::Store( _putf32Dst + I + 4, vHi );
+			I += 8;
+		}
+		for ( ; I < _ui32MaxLen && LSSTD_SIMD_IS_BMP( _putf16Src[I] ); ++I ) {
+			_putf32Dst[I] = _putf16Src[I];
+		}
+		return I;
+	}
+
+	/** Implementation of Utf32BmpToUtf16() once the first 2 characters are known to be in range. */
+	uint32_t LSE_CALL CSimdStd::Utf32BmpToUtf16128( LSUTF16 * _putf16Dst, const LSUTF32 * _putf32Src, uint32_t _ui32MaxLen ) {
+		uint32_t I = 0;
+		while ( I + 8 <= _ui32MaxLen && LSSTD_SIMD_SAME_PAGE( _putf32Src + I, 32 ) ) {
+			CSimd128::LSSTD_VECTOR vLo = CSimd128::Load( _putf32Src + I );
+			CSimd128::LSSTD_VECTOR vHi = CSimd128::Load( _putf32Src + I + 4 );
+			if ( CSimd128::NotBmp32( vLo ) | CSimd128::NotBmp32( vHi ) ) { break; }
+			CSimd128::Store( _putf16Dst + I, CSimd128::Narrow32( vLo, vHi ) );
+			I += 8;
+		}
+		for ( ; I < _ui32MaxLen && LSSTD_SIMD_IS_BMP( _putf32Src[I] ); ++I ) {
+			_putf16Dst[I] = static_cast<LSUTF16>(_putf32Src[I]);
+		}
+		return I;
+	}
+
+}	// namespace lsstd
+
+#endif	// #ifdef LSSTD_SIMD
@@ -0,0 +1,496 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: SIMD implementations of the CStd memory and string routines.  SSE2 is used on x86 and x64 and
+ *	NEON on ARM.  AVX2 versions replace the SSE2 versions when the CPU supports them.
+ */
+
+
+#ifndef __LSSTD_SIMDSTD_H__
+#define __LSSTD_SIMDSTD_H__
+
+#include "../LSSTDStandardLib.h"
+#include "../Cpu/LSSTDCpu.h"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// MACROS
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#if defined( __SSE2__ ) || defined( _M_X64 ) || (defined( _M_IX86_FP ) && _M_IX86_FP >= 2)
+/** SSE2 is always available (with AVX2 selected at run-time). */
+#define LSSTD_SIMD_SSE2
+#elif defined( __ARM_NEON__ ) || defined( __ARM_NEON ) || defined( _M_ARM64 )
+/** NEON is always available. */
+#define LSSTD_SIMD_NEON
+#endif	// #if defined( __SSE2__ ) || defined( _M_X64 ) || (defined( _M_IX86_FP ) && _M_IX86_FP >= 2)
+
+#if defined( LSSTD_SIMD_SSE2 ) || defined( LSSTD_SIMD_NEON )
+/** CSimdStd is available. */
+#define LSSTD_SIMD
+#endif	// #if defined( LSSTD_SIMD_SSE2 ) || defined( LSSTD_SIMD_NEON )
+
+/** Determines whether a UTF unit is ASCII other than NULL (1-127). */
+#define LSSTD_SIMD_IS_ASCII( UNIT )					(static_cast<uint32_t>((UNIT) - 1) < 0x7F)
+
+/** Determines whether a UTF-16 or UTF-32 unit is a character from 1 to 0xD7FF. */
+#define LSSTD_SIMD_IS_BMP( UNIT )					(static_cast<uint32_t>((UNIT) - 1) < 0xD7FF)
+
+#ifdef LSSTD_SIMD
+
+namespace lsstd {
+
+	/**
+	 * Class CSimdStd
+	 * \brief SIMD implementations of the CStd memory and string routines.
+	 *
+	 * Description: SIMD implementations of the CStd memory and string routines.  SSE2 is used on x86 and x64 and
+	 *	NEON on ARM.  AVX2 versions replace the SSE2 versions when the CPU supports them.
+	 *
+	 * Routines that search for a terminating NULL read whole 16- or 32-byte blocks and never let a block cross a
+	 *	page boundary, so they may read past the end of a string but never into memory that is not mapped.
+	 *
+	 * The Utf*Ascii*() and Utf*Bmp*() functions convert the run of characters at the start of a string that
+	 *	map one-to-one into the destination encoding, stopping at the first character that does not (including
+	 *	the terminating NULL).  They return the number of characters converted so that the caller can continue
+	 *	with the general decoder.
+	 */
+	class CSimdStd {
+	public :
+		// == Functions.
+		/**
+		 * Copy memory.  Does not check for overlap.
+		 *
+		 * \param _pvDst Destination buffer.
+		 * \param _pvSrc Buffer from which to copy.
+		 * \param _uiptrSize Number of bytes to copy.
+		 * \return Returns the destination buffer.
+		 */
+		static LSE_INLINE void * LSE_CALL			MemCpy( void * _pvDst, const void * _pvSrc, uintptr_t _uiptrSize );
+
+		/**
+		 * Fill memory with a given byte value.
+		 *
+		 * \param _pvDst Buffer to fill.
+		 * \param _ui8Value Value with which to fill the buffer.
+		 * \param _uiptrSize Number of bytes to fill.
+		 */
+		static LSE_INLINE void LSE_CALL				MemSet( void * _pvDst, uint8_t _ui8Value, uintptr_t _uiptrSize );
+
+		/**
+		 * Compare the memory at one location with the memory at another location.  Performs a lexicographic comparison.
+		 *
+		 * \param _pvBuf0 Buffer to compare.
+		 * \param _pvBuf1 Buffer to compare.
+		 * \param _uiptrSize Number of bytes to compare.
+		 * \return Returns the lexicographic relationship between the given buffers.
+		 */
+		static LSE_INLINE int32_t LSE_CALL			MemCmp( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize );
+
+		/**
+		 * Gets the length of a string.
+		 *
+		 * \param _pcStr NULL-terminated string whose length is to be obtained.
+		 * \return Returns the length of the string.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			StrLen( const char * _pcStr );
+
+		/**
+		 * Compare a string against another lexicographically.  Characters are compared as char values, as in
+		 *	CStd::StrCmp().
+		 *
+		 * \param _pcLeft NULL-terminated string to compare.
+		 * \param _pcRight NULL-terminated string to compare.
+		 * \return Returns < 0 if _pcLeft is less than _pcRight, 0 if they are equal, and > 0 if
+		 *	_pcLeft is greater than _pcRight, lexicographically.
+		 */
+		static LSE_INLINE int32_t LSE_CALL			StrCmp( const char * _pcLeft, const char * _pcRight );
+
+		/**
+		 * Counts the ASCII characters (1-127) at the start of a UTF-8 string.
+		 *
+		 * \param _putf8Src The NULL-terminated string.
+		 * \return Returns the number of ASCII characters before the first non-ASCII character or NULL.  Runs
+		 *	shorter than 2 characters are left to the caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf8AsciiLen( const LSUTF8 * _putf8Src );
+
+		/**
+		 * Counts the ASCII characters (1-127) at the start of a UTF-16 string.
+		 *
+		 * \param _putf16Src The NULL-terminated string.
+		 * \return Returns the number of ASCII characters before the first non-ASCII character or NULL.  Runs
+		 *	shorter than 2 characters are left to the caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf16AsciiLen( const LSUTF16 * _putf16Src );
+
+		/**
+		 * Counts the ASCII characters (1-127) at the start of a UTF-32 string.
+		 *
+		 * \param _putf32Src The NULL-terminated string.
+		 * \return Returns the number of ASCII characters before the first non-ASCII character or NULL.  Runs
+		 *	shorter than 2 characters are left to the caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf32AsciiLen( const LSUTF32 * _putf32Src );
+
+		/**
+		 * Converts the ASCII characters at the start of a UTF-8 string to UTF-16.
+		 *
+		 * \param _putf16Dst The destination buffer.
+		 * \param _putf8Src The NULL-terminated source string.
+		 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+		 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+		 *	caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf8AsciiToUtf16( LSUTF16 * _putf16Dst, const LSUTF8 * _putf8Src, uint32_t _ui32MaxLen );
+
+		/**
+		 * Converts the ASCII characters at the start of a UTF-8 string to UTF-32.
+		 *
+		 * \param _putf32Dst The destination buffer.
+		 * \param _putf8Src The NULL-terminated source string.
+		 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+		 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+		 *	caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf8AsciiToUtf32( LSUTF32 * _putf32Dst, const LSUTF8 * _putf8Src, uint32_t _ui32MaxLen );
+
+		/**
+		 * Converts the ASCII characters at the start of a UTF-16 string to UTF-8.
+		 *
+		 * \param _putf8Dst The destination buffer.
+		 * \param _putf16Src The NULL-terminated source string.
+		 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+		 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+		 *	caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf16AsciiToUtf8( LSUTF8 * _putf8Dst, const LSUTF16 * _putf16Src, uint32_t _ui32MaxLen );
+
+		/**
+		 * Converts the ASCII characters at the start of a UTF-32 string to UTF-8.
+		 *
+		 * \param _putf8Dst The destination buffer.
+		 * \param _putf32Src The NULL-terminated source string.
+		 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+		 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+		 *	caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf32AsciiToUtf8( LSUTF8 * _putf8Dst, const LSUTF32 * _putf32Src, uint32_t _ui32MaxLen );
+
+		/**
+		 * Converts the characters from 1 to 0xD7FF at the start of a UTF-16 string to UTF-32.
+		 *
+		 * \param _putf32Dst The destination buffer.
+		 * \param _putf16Src The NULL-terminated source string.
+		 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+		 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+		 *	caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf16BmpToUtf32( LSUTF32 * _putf32Dst, const LSUTF16 * _putf16Src, uint32_t _ui32MaxLen );
+
+		/**
+		 * Converts the characters from 1 to 0xD7FF at the start of a UTF-32 string to UTF-16.
+		 *
+		 * \param _putf16Dst The destination buffer.
+		 * \param _putf32Src The NULL-terminated source string.
+		 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+		 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+		 *	caller and return 0.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Utf32BmpToUtf16( LSUTF16 * _putf16Dst, const LSUTF32 * _putf32Src, uint32_t _ui32MaxLen );
+
+
+	protected :
+		// == Types.
+		/** A MemCpy() implementation. */
+		typedef void * (LSE_CALL *					PfMemCpy)( void * _pvDst, const void * _pvSrc, uintptr_t _uiptrSize );
+
+		/** A MemSet() implementation. */
+		typedef void (LSE_CALL *					PfMemSet)( void * _pvDst, uint8_t _ui8Value, uintptr_t _uiptrSize );
+
+		/** A MemCmp() implementation. */
+		typedef int32_t (LSE_CALL *					PfMemCmp)( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize );
+
+		/** A StrLen() implementation. */
+		typedef uint32_t (LSE_CALL *				PfStrLen)( const char * _pcStr );
+
+		/** A StrCmp() implementation. */
+		typedef int32_t (LSE_CALL *					PfStrCmp)( const char * _pcLeft, const char * _pcRight );
+
+
+		// == Members.
+		/** The selected MemCpy() implementation. */
+		static PfMemCpy								m_pfMemCpy;
+
+		/** The selected MemSet() implementation. */
+		static PfMemSet								m_pfMemSet;
+
+		/** The selected MemCmp() implementation. */
+		static PfMemCmp								m_pfMemCmp;
+
+		/** The selected StrLen() implementation. */
+		static PfStrLen								m_pfStrLen;
+
+		/** The selected StrCmp() implementation. */
+		static PfStrCmp								m_pfStrCmp;
+
+		/** Set when the implementations are selected during static initialization.  Until then, the 128-bit
+		 *	implementations are used. */
+		static LSBOOL								m_bSelected;
+
+
+		// == Functions.
+		/**
+		 * Selects the fastest implementations supported by the CPU.
+		 *
+		 * \return Returns true.
+		 */
+		static LSBOOL LSE_CALL						Select();
+
+		/** 128-bit (SSE2 or NEON) implementation of MemCpy(). */
+		static void * LSE_CALL						MemCpy128( void * _pvDst, const void * _pvSrc, uintptr_t _uiptrSize );
+
+		/** 128-bit (SSE2 or NEON) implementation of MemSet(). */
+		static void LSE_CALL						MemSet128( void * _pvDst, uint8_t _ui8Value, uintptr_t _uiptrSize );
+
+		/** 128-bit (SSE2 or NEON) implementation of MemCmp(). */
+		static int32_t LSE_CALL						MemCmp128( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize );
+
+		/** 128-bit (SSE2 or NEON) implementation of StrLen(). */
+		static uint32_t LSE_CALL					StrLen128( const char * _pcStr );
+
+		/** 128-bit (SSE2 or NEON) implementation of StrCmp(). */
+		static int32_t LSE_CALL						StrCmp128( const char * _pcLeft, const char * _pcRight );
+
+#ifdef LSSTD_SIMD_SSE2
+		/** AVX2 implementation of MemCpy(). */
+		static void * LSE_CALL						MemCpy256( void * _pvDst, const void * _pvSrc, uintptr_t _uiptrSize );
+
+		/** AVX2 implementation of MemSet(). */
+		static void LSE_CALL						MemSet256( void * _pvDst, uint8_t _ui8Value, uintptr_t _uiptrSize );
+
+		/** AVX2 implementation of MemCmp(). */
+		static int32_t LSE_CALL						MemCmp256( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize );
+
+		/** AVX2 implementation of StrLen(). */
+		static uint32_t LSE_CALL					StrLen256( const char * _pcStr );
+
+		/** AVX2 implementation of StrCmp(). */
+		static int32_t LSE_CALL						StrCmp256( const char * _pcLeft, const char * _pcRight );
+#endif	// #ifdef LSSTD_SIMD_SSE2
+
+		/** Implementation of Utf8AsciiLen() once the first 2 characters are known to be ASCII. */
+		static uint32_t LSE_CALL					Utf8AsciiLen128( const LSUTF8 * _putf8Src );
+
+		/** Implementation of Utf16AsciiLen() once the first 2 characters are known to be ASCII. */
+		static uint32_t LSE_CALL					Utf16AsciiLen128( const LSUTF16 * _putf16Src );
+
+		/** Implementation of Utf32AsciiLen() once the first 2 characters are known to be ASCII. */
+		static uint32_t LSE_CALL					Utf32AsciiLen128( const LSUTF32 * _putf32Src );
+
+		/** Implementation of Utf8AsciiToUtf16() once the first 2 characters are known to be ASCII. */
+		static uint32_t LSE_CALL					Utf8AsciiToUtf16128( LSUTF16 * _putf16Dst, const LSUTF8 * _putf8Src, uint32_t _ui32MaxLen );
+
+		/** Implementation of Utf8AsciiToUtf32() once the first 2 characters are known to be ASCII. */
+		static uint32_t LSE_CALL					Utf8AsciiToUtf32128( LSUTF32 * _putf32Dst, const LSUTF8 * _putf8Src, uint32_t _ui32MaxLen );
+
+		/** Implementation of Utf16AsciiToUtf8() once the first 2 characters are known to be ASCII. */
+		static uint32_t LSE_CALL					Utf16AsciiToUtf8128( LSUTF8 * _putf8Dst, const LSUTF16 * _putf16Src, uint32_t _ui32MaxLen );
+
+		/** Implementation of Utf32AsciiToUtf8() once the first 2 characters are known to be ASCII. */
+		static uint32_t LSE_CALL					Utf32AsciiToUtf8128( LSUTF8 * _putf8Dst, const LSUTF32 * _putf32Src, uint32_t _ui32MaxLen );
+
+		/** Implementation of Utf16BmpToUtf32() once the first 2 characters are known to be in range. */
+		static uint32_t LSE_CALL					Utf16BmpToUtf32128( LSUTF32 * _putf32Dst, const LSUTF16 * _putf16Src, uint32_t _ui32MaxLen );
+
+		/** Implementation of Utf32BmpToUtf16() once the first 2 characters are known to be in range. */
+		static uint32_t LSE_CALL					Utf32BmpToUtf16128( LSUTF16 * _putf16Dst, const LSUTF32 * _putf32Src, uint32_t _ui32MaxLen );
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Copy memory.  Does not check for overlap.
+	 *
+	 * \param _pvDst Destination buffer.
+	 * \param _pvSrc Buffer from which to copy.
+	 * \param _uiptrSize Number of bytes to copy.
+	 * \return Returns the destination buffer.
+	 */
+	LSE_INLINE void * LSE_CALL CSimdStd::MemCpy( void * _pvDst, const void * _pvSrc, uintptr_t _uiptrSize ) {
+		return m_pfMemCpy( _pvDst, _pvSrc, _uiptrSize );
+	}
+
+	/**
+	 * Fill memory with a given byte value.
+	 *
+	 * \param _pvDst Buffer to fill.
+	 * \param _ui8Value Value with which to fill the buffer.
+	 * \param _uiptrSize Number of bytes to fill.
+	 */
+	LSE_INLINE void LSE_CALL CSimdStd::MemSet( void * _pvDst, uint8_t _ui8Value, uintptr_t _uiptrSize ) {
+		m_pfMemSet( _pvDst, _ui8Value, _uiptrSize );
+	}
+
+	/**
+	 * Compare the memory at one location with the memory at another location.  Performs a lexicographic comparison.
+	 *
+	 * \param _pvBuf0 Buffer to compare.
+	 * \param _pvBuf1 Buffer to compare.
+	 * \param _uiptrSize Number of bytes to compare.
+	 * \return Returns the lexicographic relationship between the given buffers.
+	 */
+	LSE_INLINE int32_t LSE_CALL CSimdStd::MemCmp( const void * _pvBuf0, const void * _pvBuf1, uintptr_t _uiptrSize ) {
+		return m_pfMemCmp( _pvBuf0, _pvBuf1, _uiptrSize );
+	}
+
+	/**
+	 * Gets the length of a string.
+	 *
+	 * \param _pcStr NULL-terminated string whose length is to be obtained.
+	 * \return Returns the length of the string.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::StrLen( const char * _pcStr ) {
+		return m_pfStrLen( _pcStr );
+	}
+
+	/**
+	 * Compare a string against another lexicographically.  Characters are compared as char values, as in
+	 *	CStd::StrCmp().
+	 *
+	 * \param _pcLeft NULL-terminated string to compare.
+	 * \param _pcRight NULL-terminated string to compare.
+	 * \return Returns < 0 if _pcLeft is less than _pcRight, 0 if they are equal, and > 0 if
+	 *	_pcLeft is greater than _pcRight, lexicographically.
+	 */
+	LSE_INLINE int32_t LSE_CALL CSimdStd::StrCmp( const char * _pcLeft, const char * _pcRight ) {
+		return m_pfStrCmp( _pcLeft, _pcRight );
+	}
+
+	/**
+	 * Counts the ASCII characters (1-127) at the start of a UTF-8 string.
+	 *
+	 * \param _putf8Src The NULL-terminated string.
+	 * \return Returns the number of ASCII characters before the first non-ASCII character or NULL.  Runs
+	 *	shorter than 2 characters are left to the caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf8AsciiLen( const LSUTF8 * _putf8Src ) {
+		// Checking the first 2 characters inline keeps mostly non-ASCII text from paying for a call per character.
+		//	The second is only read if the first is not the terminator.
+		return (LSSTD_SIMD_IS_ASCII( _putf8Src[0] ) && LSSTD_SIMD_IS_ASCII( _putf8Src[1] )) ? Utf8AsciiLen128( _putf8Src ) : 0;
+	}
+
+	/**
+	 * Counts the ASCII characters (1-127) at the start of a UTF-16 string.
+	 *
+	 * \param _putf16Src The NULL-terminated string.
+	 * \return Returns the number of ASCII characters before the first non-ASCII character or NULL.  Runs
+	 *	shorter than 2 characters are left to the caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf16AsciiLen( const LSUTF16 * _putf16Src ) {
+		return (LSSTD_SIMD_IS_ASCII( _putf16Src[0] ) && LSSTD_SIMD_IS_ASCII( _putf16Src[1] )) ? Utf16AsciiLen128( _putf16Src ) : 0;
+	}
+
+	/**
+	 * Counts the ASCII characters (1-127) at the start of a UTF-32 string.
+	 *
+	 * \param _putf32Src The NULL-terminated string.
+	 * \return Returns the number of ASCII characters before the first non-ASCII character or NULL.  Runs
+	 *	shorter than 2 characters are left to the caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf32AsciiLen( const LSUTF32 * _putf32Src ) {
+		return (LSSTD_SIMD_IS_ASCII( _putf32Src[0] ) && LSSTD_SIMD_IS_ASCII( _putf32Src[1] )) ? Utf32AsciiLen128( _putf32Src ) : 0;
+	}
+
+	/**
+	 * Converts the ASCII characters at the start of a UTF-8 string to UTF-16.
+	 *
+	 * \param _putf16Dst The destination buffer.
+	 * \param _putf8Src The NULL-terminated source string.
+	 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+	 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+	 *	caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf8AsciiToUtf16( LSUTF16 * _putf16Dst, const LSUTF8 * _putf8Src, uint32_t _ui32MaxLen ) {
+		return (_ui32MaxLen >= 2 && LSSTD_SIMD_IS_ASCII( _putf8Src[0] ) && LSSTD_SIMD_IS_ASCII( _putf8Src[1] )) ? Utf8AsciiToUtf16128( _putf16Dst, _putf8Src, _ui32MaxLen ) : 0;
+	}
+
+	/**
+	 * Converts the ASCII characters at the start of a UTF-8 string to UTF-32.
+	 *
+	 * \param _putf32Dst The destination buffer.
+	 * \param _putf8Src The NULL-terminated source string.
+	 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+	 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+	 *	caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf8AsciiToUtf32( LSUTF32 * _putf32Dst, const LSUTF8 * _putf8Src, uint32_t _ui32MaxLen ) {
+		return (_ui32MaxLen >= 2 && LSSTD_SIMD_IS_ASCII( _putf8Src[0] ) && LSSTD_SIMD_IS_ASCII( _putf8Src[1] )) ? Utf8AsciiToUtf32128( _putf32Dst, _putf8Src, _ui32MaxLen ) : 0;
+	}
+
+	/**
+	 * Converts the ASCII characters at the start of a UTF-16 string to UTF-8.
+	 *
+	 * \param _putf8Dst The destination buffer.
+	 * \param _putf16Src The NULL-terminated source string.
+	 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+	 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+	 *	caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf16AsciiToUtf8( LSUTF8 * _putf8Dst, const LSUTF16 * _putf16Src, uint32_t _ui32MaxLen ) {
+		return (_ui32MaxLen >= 2 && LSSTD_SIMD_IS_ASCII( _putf16Src[0] ) && LSSTD_SIMD_IS_ASCII( _putf16Src[1] )) ? Utf16AsciiToUtf8128( _putf8Dst, _putf16Src, _ui32MaxLen ) : 0;
+	}
+
+	/**
+	 * Converts the ASCII characters at the start of a UTF-32 string to UTF-8.
+	 *
+	 * \param _putf8Dst The destination buffer.
+	 * \param _putf32Src The NULL-terminated source string.
+	 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+	 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+	 *	caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf32AsciiToUtf8( LSUTF8 * _putf8Dst, const LSUTF32 * _putf32Src, uint32_t _ui32MaxLen ) {
+		return (_ui32MaxLen >= 2 && LSSTD_SIMD_IS_ASCII( _putf32Src[0] ) && LSSTD_SIMD_IS_ASCII( _putf32Src[1] )) ? Utf32AsciiToUtf8128( _putf8Dst, _putf32Src, _ui32MaxLen ) : 0;
+	}
+
+	/**
+	 * Converts the characters from 1 to 0xD7FF at the start of a UTF-16 string to UTF-32.
+	 *
+	 * \param _putf32Dst The destination buffer.
+	 * \param _putf16Src The NULL-terminated source string.
+	 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+	 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+	 *	caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf16BmpToUtf32( LSUTF32 * _putf32Dst, const LSUTF16 * _putf16Src, uint32_t _ui32MaxLen ) {
+		return (_ui32MaxLen >= 2 && LSSTD_SIMD_IS_BMP( _putf16Src[0] ) && LSSTD_SIMD_IS_BMP( _putf16Src[1] )) ? Utf16BmpToUtf32128( _putf32Dst, _putf16Src, _ui32MaxLen ) : 0;
+	}
+
+	/**
+	 * Converts the characters from 1 to 0xD7FF at the start of a UTF-32 string to UTF-16.
+	 *
+	 * \param _putf16Dst The destination buffer.
+	 * \param _putf32Src The NULL-terminated source string.
+	 * \param _ui32MaxLen The maximum number of characters to write.  No terminating NULL is written.
+	 * \return Returns the number of characters converted.  Runs shorter than 2 characters are left to the
+	 *	caller and return 0.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CSimdStd::Utf32BmpToUtf16( LSUTF16 * _putf16Dst, const LSUTF32 * _putf32Src, uint32_t _ui32MaxLen ) {
+		return (_ui32MaxLen >= 2 && LSSTD_SIMD_IS_BMP( _putf32Src[0] ) && LSSTD_SIMD_IS_BMP( _putf32Src[1] )) ? Utf32BmpToUtf16128( _putf16Dst, _putf32Src, _ui32MaxLen ) : 0;
+	}
+
+}	// namespace lsstd
+
+#endif	// #ifdef LSSTD_SIMD
+
+#endif	// __LSSTD_SIMDSTD_H__
@@ -218,19 +218,24 @@ namespace lsstd {
 		}
 
 		// We are free to write the bits now.
-		// There are enough bytes to fullfill the request.
-		for ( uint32_t I = 0; I < _ui32BitsToWrite; ++I, ++m_ui64Pos ) {
+		// Each pass fills the rest of the current destination byte, leaving the bits around the write untouched.
+		uint8_t * pui8Dst = reinterpret_cast<uint8_t *>(m_pui32Buffer);
+		for ( uint32_t I = 0; I < _ui32BitsToWrite; ) {
 			uint32_t ui32SrcByte, ui32DstByte;
 			uint32_t ui32SrcBit, ui32DstBit;
 			GetByteAndBit( m_ui64Pos, ui32DstByte, ui32DstBit );
 			GetByteAndBit( I, ui32SrcByte, ui32SrcBit );
 
-			uint8_t ui8Value = static_cast<uint8_t>(_pui8Buffer[ui32SrcByte] >> ui32SrcBit);
-			
-			// Unset the bit.
-			reinterpret_cast<uint8_t *>(m_pui32Buffer)[ui32DstByte] &= ~(1 << ui32DstBit);
-			// Set the bit as per its status in the source.
-			reinterpret_cast<uint8_t *>(m_pui32Buffer)[ui32DstByte] |= (ui8Value & 1) << ui32DstBit;
+			uint32_t ui32Count = CStd::Min<uint32_t>( 8 - ui32DstBit, _ui32BitsToWrite - I );
+			uint32_t ui32Value = _pui8Buffer[ui32SrcByte] >> ui32SrcBit;
+			if ( ui32SrcBit + ui32Count > 8 ) {
+				ui32Value |= static_cast<uint32_t>(_pui8Buffer[ui32SrcByte+1]) << (8 - ui32SrcBit);
+			}
+			uint32_t ui32Mask = ((1 << ui32Count) - 1) << ui32DstBit;
+			pui8Dst[ui32DstByte] = static_cast<uint8_t>((pui8Dst[ui32DstByte] & ~ui32Mask) | ((ui32Value << ui32DstBit) & ui32Mask));
+
+			I += ui32Count;
+			m_ui64Pos += ui32Count;
 		}
 		m_ui32Total = static_cast<uint32_t>(ui64FinalPos);
 		m_ui64TotalBits = CStd::Max( m_ui64TotalBits, m_ui64Pos );
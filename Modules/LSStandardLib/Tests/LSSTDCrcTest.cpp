@@ -0,0 +1,185 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Checks CCrc against a byte-at-a-time reference.  Every length up to a few kilobytes is tested at
+ *	every alignment, with slicing-by-16 alone and (if the CPU supports it) with carry-less-multiplication
+ *	folding, and Combine()/CombineAlt() are checked at every split point.  Build it with LSStandardLib.  Returns 0
+ *	if all tests pass.
+ */
+
+#include "LSSTDStandardLib.h"
+#include "Cpu/LSSTDCpu.h"
+#include "Crc/LSSTDCrc.h"
+#include <cstdio>
+
+
+/**
+ * Class CCrcTest
+ * \brief Exposes the choice between folding and slicing.
+ *
+ * Description: Exposes the choice between folding and slicing.
+ */
+class CCrcTest : public lsstd::CCrc {
+public :
+	// == Functions.
+	/**
+	 * Enables or disables carry-less-multiplication folding.
+	 *
+	 * \param _bFold If true, folding is used where the CPU supports it.
+	 * \return Returns true if folding is enabled.
+	 */
+	static lsstd::LSBOOL LSE_CALL		SetFold( lsstd::LSBOOL _bFold ) {
+		Init();
+		m_bFold = _bFold && lsstd::CCpu::HasPclmul() && lsstd::CCpu::HasSsse3();
+		return m_bFold;
+	}
+};
+
+/** The reference tables. */
+static uint32_t g_ui32StdTable[256], g_ui32AltTable[256];
+
+/**
+ * Initializes a reference table.
+ *
+ * \param _pui32Table The table to initialize.
+ * \param _ui32Key The key.
+ */
+static void LSE_CALL InitTable( uint32_t * _pui32Table, uint32_t _ui32Key ) {
+	for ( uint32_t I = 0; I < 256; ++I ) {
+		uint32_t ui32Crc = I;
+		for ( uint32_t J = 8; J--; ) {
+			ui32Crc = (ui32Crc & 1) ? ((ui32Crc >> 1) ^ _ui32Key) : (ui32Crc >> 1);
+		}
+		_pui32Table[I] = ui32Crc;
+	}
+}
+
+/**
+ * The reference standard CRC, one byte at a time.
+ *
+ * \param _pui8Data The data.
+ * \param _uiptrLen Length of the data.
+ * \return Returns the standard CRC of the data.
+ */
+static uint32_t LSE_CALL RefCrc( const uint8_t * _pui8Data, uintptr_t _uiptrLen ) {
+	uint32_t ui32Crc = LSE_MAXU32;
+	for ( uintptr_t I = 0; I < _uiptrLen; ++I ) {
+		ui32Crc = (ui32Crc >> 8) ^ g_ui32StdTable[_pui8Data[I]^(ui32Crc&0xFF)];
+	}
+	return ~ui32Crc;
+}
+
+/**
+ * The reference alternative CRC, one byte at a time from the end of the data.
+ *
+ * \param _pui8Data The data.
+ * \param _uiptrLen Length of the data.
+ * \return Returns the alternative CRC of the data.
+ */
+static uint32_t LSE_CALL RefAltCrc( const uint8_t * _pui8Data, uintptr_t _uiptrLen ) {
+	uint32_t ui32Crc = LSE_MAXU32;
+	for ( uintptr_t I = _uiptrLen; I--; ) {
+		ui32Crc = (ui32Crc >> 8) ^ g_ui32AltTable[_pui8Data[I]^(ui32Crc&0xFF)];
+	}
+	return ~ui32Crc;
+}
+
+/**
+ * Checks GetCrc() and GetAltCrc() at every length and alignment, and Combine() and CombineAlt() at every split of
+ *	some of those lengths.
+ *
+ * \param _pui8Data The data, which must be at least _uiptrMax + 16 bytes.
+ * \param _uiptrMax The largest length to test.
+ * \param _pcPath The name of the code path being tested, for printing.
+ * \return Returns the number of failures.
+ */
+static uint32_t LSE_CALL Test( const uint8_t * _pui8Data, uintptr_t _uiptrMax, const char * _pcPath ) {
+	uint32_t ui32Fails = 0;
+	for ( uintptr_t uiptrOff = 0; uiptrOff < 16; ++uiptrOff ) {
+		const uint8_t * pui8Data = _pui8Data + uiptrOff;
+		for ( uintptr_t uiptrLen = 0; uiptrLen <= _uiptrMax; ++uiptrLen ) {
+			uint32_t ui32Std = RefCrc( pui8Data, uiptrLen );
+			uint32_t ui32Alt = RefAltCrc( pui8Data, uiptrLen );
+			if ( lsstd::CCrc::GetCrc( pui8Data, uiptrLen ) != ui32Std ) {
+				::printf( "FAILED: %s: GetCrc(), offset %u, length %u.\r\n", _pcPath,
+					static_cast<uint32_t>(uiptrOff), static_cast<uint32_t>(uiptrLen) );
+				++ui32Fails;
+			}
+			if ( lsstd::CCrc::GetAltCrc( pui8Data, uiptrLen ) != ui32Alt ) {
+				::printf( "FAILED: %s: GetAltCrc(), offset %u, length %u.\r\n", _pcPath,
+					static_cast<uint32_t>(uiptrOff), static_cast<uint32_t>(uiptrLen) );
+				++ui32Fails;
+			}
+
+			// Every split of lengths around the folding thresholds, and a few splits of the rest.
+			if ( uiptrOff == 0 && (uiptrLen <= 160 || (uiptrLen % 97) == 0) ) {
+				for ( uintptr_t uiptrSplit = 0; uiptrSplit <= uiptrLen; ++uiptrSplit ) {
+					uintptr_t uiptrLen1 = uiptrLen - uiptrSplit;
+					uint32_t ui32Combined = lsstd::CCrc::Combine( RefCrc( pui8Data, uiptrSplit ),
+						RefCrc( pui8Data + uiptrSplit, uiptrLen1 ), uiptrLen1 );
+					if ( ui32Combined != ui32Std ) {
+						::printf( "FAILED: %s: Combine(), length %u split at %u.\r\n", _pcPath,
+							static_cast<uint32_t>(uiptrLen), static_cast<uint32_t>(uiptrSplit) );
+						++ui32Fails;
+					}
+					ui32Combined = lsstd::CCrc::CombineAlt( RefAltCrc( pui8Data, uiptrSplit ),
+						RefAltCrc( pui8Data + uiptrSplit, uiptrLen1 ), uiptrSplit );
+					if ( ui32Combined != ui32Alt ) {
+						::printf( "FAILED: %s: CombineAlt(), length %u split at %u.\r\n", _pcPath,
+							static_cast<uint32_t>(uiptrLen), static_cast<uint32_t>(uiptrSplit) );
+						++ui32Fails;
+					}
+				}
+			}
+		}
+	}
+	return ui32Fails;
+}
+
+/**
+ * The main entrypoint for this program.
+ *
+ * \return Returns 0 if all tests pass, 1 otherwise.
+ */
+int LSE_CCALL main() {
+	InitTable( g_ui32StdTable, 0xEDB88320 );
+	InitTable( g_ui32AltTable, 0x04C11DB7 );
+
+	static uint8_t ui8Data[4096+16];
+	uint32_t ui32Seed = 1;
+	for ( uint32_t I = 0; I < sizeof( ui8Data ); ++I ) {
+		ui32Seed = ui32Seed * 1103515245 + 12345;
+		ui8Data[I] = static_cast<uint8_t>(ui32Seed >> 16);
+	}
+
+	// The check value of the standard CRC.
+	uint32_t ui32Fails = 0;
+	if ( lsstd::CCrc::GetCrc( reinterpret_cast<const uint8_t *>("123456789"), 9 ) != 0xCBF43926 ) {
+		::printf( "FAILED: GetCrc( \"123456789\" ) is not 0xCBF43926.\r\n" );
+		++ui32Fails;
+	}
+
+	CCrcTest::SetFold( false );
+	ui32Fails += Test( ui8Data, 4096, "slicing" );
+	if ( CCrcTest::SetFold( true ) ) {
+		ui32Fails += Test( ui8Data, 4096, "folding" );
+	}
+	else {
+		::printf( "Carry-less multiplication is not supported; folding was not tested.\r\n" );
+	}
+
+	if ( ui32Fails ) {
+		::printf( "%u failures.\r\n", ui32Fails );
+		return 1;
+	}
+	::printf( "All tests passed.\r\n" );
+	return 0;
+}
@@ -45,8 +45,8 @@ namespace lstl {
 		 * \param _tVal The value to find within the vector.
 		 * \return Returns the index of the given item if found, or the length of the vector if not.
 		 */
-		template <typename _tType, typename _tDataType, unsigned _uAllocSize>
-		static uint32_t LSE_CALL			Find( const CVectorPoD<_tType, _tDataType, _uAllocSize> &_vVec, const _tType &_tVal ) {
+		template <typename _tType, typename _tDataType, unsigned _uAllocSize, unsigned _uGrowthPercent>
+		static uint32_t LSE_CALL			Find( const CVectorPoD<_tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vVec, const _tType &_tVal ) {
 			for ( uint32_t I = 0; I < _vVec.Length(); ++I ) {
 				if ( _vVec[I] == _tVal ) { return I; }
 			}
@@ -61,8 +61,8 @@ namespace lstl {
 		 * \param _tVal The value to find within the vector.
 		 * \return Returns the index of the given item if found, or the length of the vector if not.
 		 */
-		template <typename _tType, typename _tDataType, unsigned _uAllocSize>
-		static uint32_t LSE_CALL			Find( const CSVectorPoD<_tType, _tDataType, _uAllocSize> &_vVec, const _tType &_tVal ) {
+		template <typename _tType, typename _tDataType, unsigned _uAllocSize, unsigned _uGrowthPercent>
+		static uint32_t LSE_CALL			Find( const CSVectorPoD<_tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vVec, const _tType &_tVal ) {
 			for ( uint32_t I = 0; I < _vVec.Length(); ++I ) {
 				if ( _vVec[I] == _tVal ) { return I; }
 			}
@@ -77,8 +77,8 @@ namespace lstl {
 		 * \param _tVal The value to find within the vector.
 		 * \return Returns the index of the given item if found, or the length of the vector if not.
 		 */
-		template <typename _tType, typename _tDataType, unsigned _uAllocSize>
-		static uint32_t LSE_CALL			Find( const CVector<_tType, _tDataType, _uAllocSize> &_vVec, const _tType &_tVal ) {
+		template <typename _tType, typename _tDataType, unsigned _uAllocSize, unsigned _uGrowthPercent>
+		static uint32_t LSE_CALL			Find( const CVector<_tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vVec, const _tType &_tVal ) {
 			for ( uint32_t I = 0; I < _vVec.Length(); ++I ) {
 				if ( _vVec[I] == _tVal ) { return I; }
 			}
@@ -95,9 +95,9 @@ namespace lstl {
 		 * \return If the value is found, true is returned and the index of that value is held by _ui32Index.
 		 *	If not found, false is returned and _ui32Index holds the index where the item should be in the array.
 		 */
-		template <typename _tType, typename _tDataType, unsigned _uAllocSize>
-		static LSBOOL LSE_CALL				BSearch( const CVector<_tType, _tDataType, _uAllocSize> &_vVec, const _tType &_tVal, uint32_t &_ui32Index ) {
-			return BSearch<_tType, _tDataType, _uAllocSize, _tType>( _vVec, _tVal, _ui32Index );
+		template <typename _tType, typename _tDataType, unsigned _uAllocSize, unsigned _uGrowthPercent>
+		static LSBOOL LSE_CALL				BSearch( const CVector<_tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vVec, const _tType &_tVal, uint32_t &_ui32Index ) {
+			return BSearch<_tType, _tDataType, _uAllocSize, _uGrowthPercent, _tType>( _vVec, _tVal, _ui32Index );
 		}
 
 		/**
@@ -110,8 +110,8 @@ namespace lstl {
 		 * \return If the value is found, true is returned and the index of that value is held by _ui32Index.
 		 *	If not found, false is returned and _ui32Index holds the index where the item should be in the array.
 		 */
-		template <typename _tType, typename _tDataType, unsigned _uAllocSize, typename _tKeyType>
-		static LSBOOL LSE_CALL				BSearch( const CVector<_tType, _tDataType, _uAllocSize> &_vVec, const _tKeyType &_tVal, uint32_t &_ui32Index ) {
+		template <typename _tType, typename _tDataType, unsigned _uAllocSize, unsigned _uGrowthPercent, typename _tKeyType>
+		static LSBOOL LSE_CALL				BSearch( const CVector<_tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vVec, const _tKeyType &_tVal, uint32_t &_ui32Index ) {
 			if ( !_vVec.Length() ) {
 				_ui32Index = 0;
 				return false;
@@ -0,0 +1,83 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: An allocator that lets the containers in this library allocate from a CFrameArena.  Containers
+ *	using it must not outlive their data's frame, and their RAM is only reclaimed when the arena rewinds or
+ *	recycles the frame.
+ */
+
+#include "LSTLFrameArenaAllocator.h"
+
+
+namespace lstl {
+
+	// == Various constructors.
+	LSE_CALLCTOR CFrameArenaAllocator::CFrameArenaAllocator( CFrameArena &_faArena ) :
+		m_pfaArena( &_faArena ) {
+	}
+
+	// == Functions.
+	/**
+	 * Allocates.
+	 *
+	 * \param _uiptrSize Number of bytes to allocate.
+	 * \return Returns the allocated bytes or NULL on failure.
+	 */
+	void * LSE_CALL CFrameArenaAllocator::Alloc( uintptr_t _uiptrSize ) {
+		// The size is kept in front of the allocation for ReAlloc().
+		uint8_t * pui8Addr = static_cast<uint8_t *>(m_pfaArena->Alloc( _uiptrSize + LSA_MIN_ALIGN, LSA_MIN_ALIGN ));
+		if ( !pui8Addr ) { return NULL; }
+		(*reinterpret_cast<uintptr_t *>(pui8Addr)) = _uiptrSize;
+		return pui8Addr + LSA_MIN_ALIGN;
+	}
+
+	/**
+	 * Reallocate memory.
+	 *
+	 * \param _pvAddr The address whose allocation size is to be changed.  If NULL, this behaves
+	 *	exactly the same way as Alloc().
+	 * \param _uiptrSize The new size of the allocated data.
+	 * \return Returns the reallocated pointer or NULL on failure.  Upon failure, the original
+	 *	data is not modified and _pvAddr remains valid.
+	 */
+	void * LSE_CALL CFrameArenaAllocator::ReAlloc( void * _pvAddr, uintptr_t _uiptrSize ) {
+		if ( !_pvAddr ) { return Alloc( _uiptrSize ); }
+		uint8_t * pui8Base = static_cast<uint8_t *>(_pvAddr) - LSA_MIN_ALIGN;
+		uintptr_t & uiptrSize = (*reinterpret_cast<uintptr_t *>(pui8Base));
+		if ( m_pfaArena->ReAllocLast( pui8Base, uiptrSize + LSA_MIN_ALIGN, _uiptrSize + LSA_MIN_ALIGN ) ||
+			_uiptrSize <= uiptrSize ) {
+			uiptrSize = _uiptrSize;
+			return _pvAddr;
+		}
+		void * pvNew = Alloc( _uiptrSize );
+		if ( !pvNew ) { return NULL; }
+		CStd::MemCpy( pvNew, _pvAddr, uiptrSize );
+		return pvNew;
+	}
+
+	/**
+	 * Does nothing.  The RAM is reclaimed when the arena rewinds or recycles the frame.
+	 *
+	 * \param _pvAddr Not used.
+	 */
+	void LSE_CALL CFrameArenaAllocator::Free( void * /*_pvAddr*/ ) {
+	}
+
+	/**
+	 * Gets the arena from which this allocates.
+	 *
+	 * \return Returns the arena from which this allocates.
+	 */
+	CFrameArena & LSE_CALL CFrameArenaAllocator::Arena() {
+		return (*m_pfaArena);
+	}
+
+}	// namespace lstl
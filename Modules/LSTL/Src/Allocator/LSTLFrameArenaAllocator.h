@@ -0,0 +1,85 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: An allocator that lets the containers in this library allocate from a CFrameArena.  Containers
+ *	using it must not outlive their data's frame, and their RAM is only reclaimed when the arena rewinds or
+ *	recycles the frame.
+ */
+
+
+#ifndef __LSTL_FRAMEARENAALLOCATOR_H__
+#define __LSTL_FRAMEARENAALLOCATOR_H__
+
+#include "../LSTLib.h"
+#include "Allocators/LSAFrameArena.h"
+#include "LSTLAllocator.h"
+
+namespace lstl {
+
+	/**
+	 * Class CFrameArenaAllocator
+	 * \brief An allocator that lets the containers in this library allocate from a CFrameArena.
+	 *
+	 * Description: An allocator that lets the containers in this library allocate from a CFrameArena.  Containers
+	 *	using it must not outlive their data's frame, and their RAM is only reclaimed when the arena rewinds or
+	 *	recycles the frame.  Free() does nothing, and ReAlloc() grows the calling thread's last allocation in place
+	 *	when it can, so a single growing container does not leave copies of itself behind.
+	 */
+	class CFrameArenaAllocator : public CAllocator {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR						CFrameArenaAllocator( CFrameArena &_faArena );
+
+
+		// == Functions.
+		/**
+		 * Allocates.
+		 *
+		 * \param _uiptrSize Number of bytes to allocate.
+		 * \return Returns the allocated bytes or NULL on failure.
+		 */
+		virtual void * LSE_CALL			Alloc( uintptr_t _uiptrSize );
+
+		/**
+		 * Reallocate memory.
+		 *
+		 * \param _pvAddr The address whose allocation size is to be changed.  If NULL, this behaves
+		 *	exactly the same way as Alloc().
+		 * \param _uiptrSize The new size of the allocated data.
+		 * \return Returns the reallocated pointer or NULL on failure.  Upon failure, the original
+		 *	data is not modified and _pvAddr remains valid.
+		 */
+		virtual void * LSE_CALL			ReAlloc( void * _pvAddr, uintptr_t _uiptrSize );
+
+		/**
+		 * Does nothing.  The RAM is reclaimed when the arena rewinds or recycles the frame.
+		 *
+		 * \param _pvAddr Not used.
+		 */
+		virtual void LSE_CALL				Free( void * _pvAddr );
+
+		/**
+		 * Gets the arena from which this allocates.
+		 *
+		 * \return Returns the arena from which this allocates.
+		 */
+		CFrameArena & LSE_CALL				Arena();
+
+
+	protected :
+		// == Members.
+		/** The arena from which we allocate. */
+		CFrameArena *						m_pfaArena;
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_FRAMEARENAALLOCATOR_H__
@@ -0,0 +1,231 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: An unordered associative container pairing a unique key with a mapped value, stored in an
+ *	open-addressing hash table.  Lookups, insertions, and removals take constant time on average.
+ *
+ * The key type must implement the == operator and be hashable by _tHasher (see CHasher).  Unlike CMap,
+ *	items do not keep their addresses when the map grows.
+ */
+
+
+#ifndef __LSTL_HASHMAP_H__
+#define __LSTL_HASHMAP_H__
+
+#include "../LSTLib.h"
+#include "../Map/LSTLMapTemplateBase.h"
+#include "LSTLHashTableCrtp.h"
+
+namespace lstl {
+
+	/**
+	 * Class CHashMap
+	 * \brief An unordered container associating unique keys with mapped values.
+	 *
+	 * Description: An unordered associative container pairing a unique key with a mapped value, stored in an
+	 *	open-addressing hash table.  Lookups, insertions, and removals take constant time on average.
+	 *
+	 * The key type must implement the == operator and be hashable by _tHasher (see CHasher).  Unlike CMap,
+	 *	items do not keep their addresses when the map grows.
+	 */
+	template <typename _tKeyType, typename _tMappedType, unsigned _uAllocSize = 16, typename _tHasher = CHasher<_tKeyType> >
+	class CHashMap : public CHashTableCrtp<CHashMap<_tKeyType, _tMappedType, _uAllocSize, _tHasher>, _tKeyType, LSTL_PAIR<_tKeyType, _tMappedType>, _tHasher, _uAllocSize> {
+		// The base class needs SlotKey().
+		friend class							CHashTableCrtp<CHashMap<_tKeyType, _tMappedType, _uAllocSize, _tHasher>, _tKeyType, LSTL_PAIR<_tKeyType, _tMappedType>, _tHasher, _uAllocSize>;
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR							CHashMap() {
+		}
+		explicit LSE_CALLCTOR					CHashMap( const CHashMap<_tKeyType, _tMappedType, _uAllocSize, _tHasher> &_hmSrc ) :
+			Parent() {
+			Parent::CopyFrom( _hmSrc );
+		}
+		explicit LSE_CALLCTOR					CHashMap( CAllocator * _paAllocator ) :
+			Parent( _paAllocator ) {
+		}
+
+
+		// == Operators.
+		/**
+		 * Access a mapped value by its key.  If the given key does not exist, it is added and its default
+		 *	mapped value is returned.  Throws an exception if a memory failure prevents the adding of a key.
+		 *
+		 * \param _tKey The key of the value to find.
+		 * \return Returns the mapped value associated with the given key.
+		 */
+		_tMappedType & LSE_CALL					operator [] ( const _tKeyType &_tKey ) {
+			_tMappedType * ptValue = NULL;
+			if ( !Insert( _tKey, _tMappedType(), &ptValue ) ) {
+				throw LSSTD_E_OUTOFMEMORY;
+			}
+			return (*ptValue);
+		}
+
+		/**
+		 * Access a mapped value by its key.  Throws an exception if the key does not exist.
+		 *
+		 * \param _tKey The key of the value to find.
+		 * \return Returns the mapped value associated with the given key.
+		 */
+		const _tMappedType & LSE_CALL			operator [] ( const _tKeyType &_tKey ) const {
+			uint32_t ui32Index;
+			if ( !Parent::GetItemIndex( _tKey, ui32Index ) ) {
+				// The const form of this function can only be used when values are
+				//	known to exist in the map.
+				throw LSSTD_E_INVALIDCALL;
+			}
+			return Parent::m_ptSlots[ui32Index].tValue;
+		}
+
+		/**
+		 * Copy another map into this one.  Each element in the source map is copied.  The allocator
+		 *	is not copied.
+		 *
+		 * \param _hmSrc The map of which to make a copy.
+		 * \return Returns a reference to this object after the copy.
+		 */
+		CHashMap<_tKeyType, _tMappedType, _uAllocSize, _tHasher> & LSE_CALL
+												operator = ( const CHashMap<_tKeyType, _tMappedType, _uAllocSize, _tHasher> &_hmSrc ) {
+			if ( !Parent::CopyFrom( _hmSrc ) ) {
+				throw LSSTD_E_OUTOFMEMORY;
+			}
+			return (*this);
+		}
+
+
+		// == Functions.
+		/**
+		 * Insert a single pair of a key and its mapped value.  If the key exists, it is not modified.
+		 *
+		 * \param _pPair The pair to insert.
+		 * \param _pptReturnValue The returned mapped value.
+		 * \return Returns true if the item was added or already exists.  A return of false always indicates a
+		 *	memory failure.
+		 */
+		LSBOOL LSE_CALL							Insert( const LSTL_PAIR<_tKeyType, _tMappedType> &_pPair, _tMappedType ** _pptReturnValue = NULL ) {
+			return Insert( _pPair.tKey, _pPair.tValue, _pptReturnValue );
+		}
+
+		/**
+		 * Insert a single pair of a key and its mapped value.  If the key exists, it is not modified.
+		 *
+		 * \param _tKey The pair's key.
+		 * \param _tValue The pair's mapped value.
+		 * \param _pptReturnValue The returned mapped value.
+		 * \return Returns true if the item was added or already exists.  A return of false always indicates a
+		 *	memory failure.
+		 */
+		LSBOOL LSE_CALL							Insert( const _tKeyType &_tKey, const _tMappedType &_tValue, _tMappedType ** _pptReturnValue = NULL ) {
+			uint32_t ui32Index;
+			LSBOOL bFound;
+			if ( !Parent::FindOrPrepareInsert( _tKey, ui32Index, bFound ) ) {
+				if ( _pptReturnValue ) {
+					(*_pptReturnValue) = NULL;
+				}
+				return false;
+			}
+			if ( !bFound ) {
+				LSTL_PAIR<_tKeyType, _tMappedType> * ppSlot = new( &Parent::m_ptSlots[ui32Index] ) LSTL_PAIR<_tKeyType, _tMappedType>();
+				ppSlot->tKey = _tKey;
+				ppSlot->tValue = _tValue;
+			}
+			if ( _pptReturnValue ) {
+				(*_pptReturnValue) = &Parent::m_ptSlots[ui32Index].tValue;
+			}
+			return true;
+		}
+
+		/**
+		 * Removes a pair.
+		 *
+		 * \param _tKey The key of the pair to remove.
+		 */
+		void LSE_CALL							Remove( const _tKeyType &_tKey ) {
+			uint32_t ui32Index;
+			if ( Parent::GetItemIndex( _tKey, ui32Index ) ) {
+				Parent::RemoveByIndex( ui32Index );
+			}
+		}
+
+		/**
+		 * Finds a mapped value by its key.
+		 *
+		 * \param _tKey The key of the value to find.
+		 * \return Returns a pointer to the mapped value or NULL if the key is not in the map.
+		 */
+		_tMappedType * LSE_CALL					Find( const _tKeyType &_tKey ) {
+			uint32_t ui32Index;
+			return Parent::GetItemIndex( _tKey, ui32Index ) ? &Parent::m_ptSlots[ui32Index].tValue : NULL;
+		}
+
+		/**
+		 * Finds a mapped value by its key.
+		 *
+		 * \param _tKey The key of the value to find.
+		 * \return Returns a pointer to the mapped value or NULL if the key is not in the map.
+		 */
+		const _tMappedType * LSE_CALL			Find( const _tKeyType &_tKey ) const {
+			uint32_t ui32Index;
+			return Parent::GetItemIndex( _tKey, ui32Index ) ? &Parent::m_ptSlots[ui32Index].tValue : NULL;
+		}
+
+		/**
+		 * Gets a mapped value by slot index.
+		 *
+		 * \param _ui32Index The slot index of the mapped value to get, which must hold an item.
+		 * \return Returns a reference to the mapped value at the given slot index.
+		 */
+		_tMappedType & LSE_CALL					GetByIndex( uint32_t _ui32Index ) {
+			return Parent::m_ptSlots[_ui32Index].tValue;
+		}
+
+		/**
+		 * Gets a mapped value by slot index.
+		 *
+		 * \param _ui32Index The slot index of the mapped value to get, which must hold an item.
+		 * \return Returns a reference to the mapped value at the given slot index.
+		 */
+		const _tMappedType & LSE_CALL			GetByIndex( uint32_t _ui32Index ) const {
+			return Parent::m_ptSlots[_ui32Index].tValue;
+		}
+
+		/**
+		 * Gets a key by slot index.
+		 *
+		 * \param _ui32Index The slot index of the key to get, which must hold an item.
+		 * \return Returns a reference to the key at the given slot index.
+		 */
+		const _tKeyType & LSE_CALL				GetKeyByIndex( uint32_t _ui32Index ) const {
+			return Parent::m_ptSlots[_ui32Index].tKey;
+		}
+
+
+	protected :
+		// == Functions.
+		/**
+		 * Gets the key of a slot.
+		 *
+		 * \param _pSlot The slot.
+		 * \return Returns the key of the slot.
+		 */
+		static LSE_INLINE const _tKeyType & LSE_CALL
+												SlotKey( const LSTL_PAIR<_tKeyType, _tMappedType> &_pSlot ) {
+			return _pSlot.tKey;
+		}
+
+	private :
+		typedef CHashTableCrtp<CHashMap<_tKeyType, _tMappedType, _uAllocSize, _tHasher>, _tKeyType, LSTL_PAIR<_tKeyType, _tMappedType>, _tHasher, _uAllocSize>
+												Parent;
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_HASHMAP_H__
@@ -0,0 +1,131 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: An unordered container storing one unique instance of each given key, stored in an open-addressing
+ *	hash table.  Lookups, insertions, and removals take constant time on average.
+ *
+ * The key type must implement the == operator and be hashable by _tHasher (see CHasher).
+ */
+
+
+#ifndef __LSTL_HASHSET_H__
+#define __LSTL_HASHSET_H__
+
+#include "../LSTLib.h"
+#include "LSTLHashTableCrtp.h"
+
+namespace lstl {
+
+	/**
+	 * Class CHashSet
+	 * \brief An unordered container storing one unique instance of each given key.
+	 *
+	 * Description: An unordered container storing one unique instance of each given key, stored in an open-addressing
+	 *	hash table.  Lookups, insertions, and removals take constant time on average.
+	 *
+	 * The key type must implement the == operator and be hashable by _tHasher (see CHasher).
+	 */
+	template <typename _tKeyType, unsigned _uAllocSize = 16, typename _tHasher = CHasher<_tKeyType> >
+	class CHashSet : public CHashTableCrtp<CHashSet<_tKeyType, _uAllocSize, _tHasher>, _tKeyType, _tKeyType, _tHasher, _uAllocSize> {
+		// The base class needs SlotKey().
+		friend class							CHashTableCrtp<CHashSet<_tKeyType, _uAllocSize, _tHasher>, _tKeyType, _tKeyType, _tHasher, _uAllocSize>;
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR							CHashSet() {
+		}
+		explicit LSE_CALLCTOR					CHashSet( const CHashSet<_tKeyType, _uAllocSize, _tHasher> &_hsSrc ) :
+			Parent() {
+			Parent::CopyFrom( _hsSrc );
+		}
+		explicit LSE_CALLCTOR					CHashSet( CAllocator * _paAllocator ) :
+			Parent( _paAllocator ) {
+		}
+
+
+		// == Operators.
+		/**
+		 * Copy another set into this one.  Each element in the source set is copied.  The allocator
+		 *	is not copied.
+		 *
+		 * \param _hsSrc The set of which to make a copy.
+		 * \return Returns a reference to this object after the copy.
+		 */
+		CHashSet<_tKeyType, _uAllocSize, _tHasher> & LSE_CALL
+												operator = ( const CHashSet<_tKeyType, _uAllocSize, _tHasher> &_hsSrc ) {
+			if ( !Parent::CopyFrom( _hsSrc ) ) {
+				throw LSSTD_E_OUTOFMEMORY;
+			}
+			return (*this);
+		}
+
+
+		// == Functions.
+		/**
+		 * Inserts a key.  If the key exists, it is not modified.
+		 *
+		 * \param _tKey The key to insert.
+		 * \return Returns true if the key was added or already exists.  A return of false always indicates a
+		 *	memory failure.
+		 */
+		LSBOOL LSE_CALL							Insert( const _tKeyType &_tKey ) {
+			uint32_t ui32Index;
+			LSBOOL bFound;
+			if ( !Parent::FindOrPrepareInsert( _tKey, ui32Index, bFound ) ) { return false; }
+			if ( !bFound ) {
+				new( &Parent::m_ptSlots[ui32Index] ) _tKeyType( _tKey );
+			}
+			return true;
+		}
+
+		/**
+		 * Removes a key.
+		 *
+		 * \param _tKey The key to remove.
+		 */
+		void LSE_CALL							Remove( const _tKeyType &_tKey ) {
+			uint32_t ui32Index;
+			if ( Parent::GetItemIndex( _tKey, ui32Index ) ) {
+				Parent::RemoveByIndex( ui32Index );
+			}
+		}
+
+		/**
+		 * Gets a key by slot index.
+		 *
+		 * \param _ui32Index The slot index of the key to get, which must hold an item.
+		 * \return Returns a reference to the key at the given slot index.
+		 */
+		const _tKeyType & LSE_CALL				GetByIndex( uint32_t _ui32Index ) const {
+			return Parent::m_ptSlots[_ui32Index];
+		}
+
+
+	protected :
+		// == Functions.
+		/**
+		 * Gets the key of a slot.
+		 *
+		 * \param _tSlot The slot.
+		 * \return Returns the key of the slot.
+		 */
+		static LSE_INLINE const _tKeyType & LSE_CALL
+												SlotKey( const _tKeyType &_tSlot ) {
+			return _tSlot;
+		}
+
+	private :
+		typedef CHashTableCrtp<CHashSet<_tKeyType, _uAllocSize, _tHasher>, _tKeyType, _tKeyType, _tHasher, _uAllocSize>
+												Parent;
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_HASHSET_H__
@@ -0,0 +1,30 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Provides a default allocator shared among all instances of CHashMap and CHashSet classes, along
+ *	with the hashing and control-byte matching shared by all hash tables.
+ */
+
+#include "LSTLHashTableBase.h"
+
+
+namespace lstl {
+
+	// == Members.
+	// Modifiable pointer to a default allocator used by all hash-table objects that do not
+	//	explicitly allow using a specific allocator.  Must never be set to NULL.  Should only
+	//	be changed once, before any allocations are ever made.
+	CAllocator * CHashTableBase::m_paDefaultAllocator = &m_aAllocator;
+
+	// The default allocator if none are supplied.
+	CAllocator CHashTableBase::m_aAllocator;
+
+}	// namespace lstl
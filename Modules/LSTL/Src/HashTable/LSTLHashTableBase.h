@@ -0,0 +1,275 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Provides a default allocator shared among all instances of CHashMap and CHashSet classes, along
+ *	with the hashing and control-byte matching shared by all hash tables.
+ */
+
+
+#ifndef __LSTL_HASHTABLEBASE_H__
+#define __LSTL_HASHTABLEBASE_H__
+
+#include "../LSTLib.h"
+#include "../Allocator/LSTLAllocator.h"
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || (defined( _M_IX86_FP ) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LSTL_HASH_SSE2
+#endif	// #if defined( __SSE2__ ) || defined( _M_X64 ) || (defined( _M_IX86_FP ) && _M_IX86_FP >= 2)
+
+#ifdef LSE_VISUALSTUDIO
+#include <intrin.h>
+#endif	// #ifdef LSE_VISUALSTUDIO
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// MACROS
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+/** Number of control bytes (and slots) examined at once. */
+#define LSTL_HASH_GROUP							16
+
+/** Control byte of a slot that has never been used. */
+#define LSTL_HASH_EMPTY							static_cast<int8_t>(-128)
+
+/** Control byte of a slot whose item was removed. */
+#define LSTL_HASH_DELETED						static_cast<int8_t>(-2)
+
+namespace lstl {
+
+	/**
+	 * Class CHashTableBase
+	 * \brief Provides a default allocator shared among all instances of CHashMap and CHashSet classes.
+	 *
+	 * Description: Provides a default allocator shared among all instances of CHashMap and CHashSet classes.  Also
+	 *	provides hashing and control-byte matching.
+	 *
+	 * Each slot has a control byte that is either LSTL_HASH_EMPTY, LSTL_HASH_DELETED, or (if the slot holds an
+	 *	item) the low 7 bits of the hash of its key.  Control bytes are examined LSTL_HASH_GROUP at a time, with
+	 *	SSE2 where available, so a lookup usually compares keys only for the items whose 7 bits match.
+	 */
+	class CHashTableBase {
+	public :
+		// == Members.
+		/**
+		 * Modifiable pointer to a default allocator used by all hash-table objects that do not
+		 *	explicitly allow using a specific allocator.  Must never be set to NULL.  Should only
+		 *	be changed once, before any allocations are ever made.  If a hash table allocates from
+		 *	the default allocator and then the default is changed, the hash table will not be able to
+		 *	free its memory unless the default is changed back.
+		 */
+		static CAllocator *						m_paDefaultAllocator;
+
+
+		// == Functions.
+		/**
+		 * Mixes the bits of a 64-bit value so that every input bit affects every output bit.
+		 *
+		 * \param _ui64Value The value to mix.
+		 * \return Returns the mixed value.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL		Mix( uint64_t _ui64Value );
+
+		/**
+		 * Hashes a run of bytes.
+		 *
+		 * \param _pvData The bytes to hash.
+		 * \param _uiptrSize The number of bytes to hash.
+		 * \return Returns the hash of the bytes.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL		HashBytes( const void * _pvData, uintptr_t _uiptrSize );
+
+
+	protected :
+		// == Members.
+		/**
+		 * The default allocator if none are supplied.
+		 */
+		static CAllocator						m_aAllocator;
+
+
+		// == Functions.
+		/**
+		 * Finds the control bytes in a group that match the given 7-bit hash.
+		 *
+		 * \param _pi8Group The group of LSTL_HASH_GROUP control bytes.
+		 * \param _i8Hash The 7-bit hash to find.
+		 * \return Returns a mask with bit N set if control byte N matches.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		Match( const int8_t * _pi8Group, int8_t _i8Hash );
+
+		/**
+		 * Finds the empty slots in a group.
+		 *
+		 * \param _pi8Group The group of LSTL_HASH_GROUP control bytes.
+		 * \return Returns a mask with bit N set if control byte N is LSTL_HASH_EMPTY.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		MatchEmpty( const int8_t * _pi8Group );
+
+		/**
+		 * Finds the slots in a group that do not hold items.
+		 *
+		 * \param _pi8Group The group of LSTL_HASH_GROUP control bytes.
+		 * \return Returns a mask with bit N set if control byte N is LSTL_HASH_EMPTY or LSTL_HASH_DELETED.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		MatchFree( const int8_t * _pi8Group );
+
+		/**
+		 * Gets the index of the lowest set bit in a non-zero value.
+		 *
+		 * \param _ui32Value The value to scan.  Must not be 0.
+		 * \return Returns the index of the lowest set bit.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		LowestBit( uint32_t _ui32Value );
+	};
+
+	/**
+	 * Class CHasher
+	 * \brief The default hash function used by CHashMap and CHashSet.
+	 *
+	 * Description: The default hash function used by CHashMap and CHashSet.  Hashes the bytes of the key, which is
+	 *	correct for integers, pointers, enumerations, and plain structures without padding.  Specialize this (or
+	 *	pass a different _tHasher to the container) for other key types.  Equal keys must hash equally.
+	 */
+	template <typename _tKeyType>
+	class CHasher {
+	public :
+		// == Functions.
+		/**
+		 * Hashes a key.
+		 *
+		 * \param _tKey The key to hash.
+		 * \return Returns the hash of the key.
+		 */
+		static LSE_INLINE uint64_t LSE_CALL		Hash( const _tKeyType &_tKey ) {
+			return CHashTableBase::HashBytes( &_tKey, sizeof( _tKey ) );
+		}
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Mixes the bits of a 64-bit value so that every input bit affects every output bit.
+	 *
+	 * \param _ui64Value The value to mix.
+	 * \return Returns the mixed value.
+	 */
+	LSE_INLINE uint64_t LSE_CALL CHashTableBase::Mix( uint64_t _ui64Value ) {
+		// The MurmurHash3 finalizer.
+		_ui64Value ^= _ui64Value >> 33;
+		_ui64Value *= 0xFF51AFD7ED558CCDULL;
+		_ui64Value ^= _ui64Value >> 33;
+		_ui64Value *= 0xC4CEB9FE1A85EC53ULL;
+		_ui64Value ^= _ui64Value >> 33;
+		return _ui64Value;
+	}
+
+	/**
+	 * Hashes a run of bytes.
+	 *
+	 * \param _pvData The bytes to hash.
+	 * \param _uiptrSize The number of bytes to hash.
+	 * \return Returns the hash of the bytes.
+	 */
+	LSE_INLINE uint64_t LSE_CALL CHashTableBase::HashBytes( const void * _pvData, uintptr_t _uiptrSize ) {
+		const uint8_t * pui8Data = static_cast<const uint8_t *>(_pvData);
+		// Keys are usually small and their sizes are known at compile time, so these cases collapse to one mix.
+		switch ( _uiptrSize ) {
+			case 1 : { return Mix( pui8Data[0] ); }
+			case 2 : { return Mix( (*reinterpret_cast<const uint16_t *>(pui8Data)) ); }
+			case 4 : { return Mix( (*reinterpret_cast<const uint32_t *>(pui8Data)) ); }
+			case 8 : { return Mix( (*reinterpret_cast<const uint64_t *>(pui8Data)) ); }
+		}
+		// FNV-1a.
+		uint64_t ui64Hash = 0xCBF29CE484222325ULL;
+		for ( uintptr_t I = 0; I < _uiptrSize; ++I ) {
+			ui64Hash = (ui64Hash ^ pui8Data[I]) * 0x100000001B3ULL;
+		}
+		return Mix( ui64Hash );
+	}
+
+	/**
+	 * Finds the control bytes in a group that match the given 7-bit hash.
+	 *
+	 * \param _pi8Group The group of LSTL_HASH_GROUP control bytes.
+	 * \param _i8Hash The 7-bit hash to find.
+	 * \return Returns a mask with bit N set if control byte N matches.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CHashTableBase::Match( const int8_t * _pi8Group, int8_t _i8Hash ) {
+#ifdef LSTL_HASH_SSE2
+		__m128i mGroup = _mm_loadu_si128( reinterpret_cast<const __m128i *>(_pi8Group) );
+		return static_cast<uint32_t>(_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( _i8Hash ), mGroup ) ));
+#else
+		uint32_t ui32Mask = 0;
+		for ( uint32_t I = LSTL_HASH_GROUP; I--; ) {
+			ui32Mask = (ui32Mask << 1) | static_cast<uint32_t>(_pi8Group[I] == _i8Hash);
+		}
+		return ui32Mask;
+#endif	// #ifdef LSTL_HASH_SSE2
+	}
+
+	/**
+	 * Finds the empty slots in a group.
+	 *
+	 * \param _pi8Group The group of LSTL_HASH_GROUP control bytes.
+	 * \return Returns a mask with bit N set if control byte N is LSTL_HASH_EMPTY.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CHashTableBase::MatchEmpty( const int8_t * _pi8Group ) {
+		return Match( _pi8Group, LSTL_HASH_EMPTY );
+	}
+
+	/**
+	 * Finds the slots in a group that do not hold items.
+	 *
+	 * \param _pi8Group The group of LSTL_HASH_GROUP control bytes.
+	 * \return Returns a mask with bit N set if control byte N is LSTL_HASH_EMPTY or LSTL_HASH_DELETED.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CHashTableBase::MatchFree( const int8_t * _pi8Group ) {
+#ifdef LSTL_HASH_SSE2
+		// Items have non-negative control bytes and free slots have negative ones, which is exactly the sign mask.
+		return static_cast<uint32_t>(_mm_movemask_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i *>(_pi8Group) ) ));
+#else
+		uint32_t ui32Mask = 0;
+		for ( uint32_t I = LSTL_HASH_GROUP; I--; ) {
+			ui32Mask = (ui32Mask << 1) | static_cast<uint32_t>(_pi8Group[I] < 0);
+		}
+		return ui32Mask;
+#endif	// #ifdef LSTL_HASH_SSE2
+	}
+
+	/**
+	 * Gets the index of the lowest set bit in a non-zero value.
+	 *
+	 * \param _ui32Value The value to scan.  Must not be 0.
+	 * \return Returns the index of the lowest set bit.
+	 */
+	LSE_INLINE uint32_t LSE_CALL CHashTableBase::LowestBit( uint32_t _ui32Value ) {
+#if defined( LSE_VISUALSTUDIO )
+		unsigned long ulIndex;
+		::_BitScanForward( &ulIndex, _ui32Value );
+		return static_cast<uint32_t>(ulIndex);
+#elif defined( __GNUC__ )
+		return static_cast<uint32_t>(__builtin_ctz( _ui32Value ));
+#else
+		uint32_t ui32Ret = 0;
+		while ( !(_ui32Value & 1) ) {
+			_ui32Value >>= 1;
+			++ui32Ret;
+		}
+		return ui32Ret;
+#endif	// #if defined( LSE_VISUALSTUDIO )
+	}
+
+}	// namespace lstl
+
+#endif	// __LSTL_HASHTABLEBASE_H__
@@ -0,0 +1,415 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: The open-addressing hash table shared by CHashMap and CHashSet.  We use the Curious Recurring
+ *	Template Pattern so that the derived class can say where the key is inside each slot, since virtual functions
+ *	are not allowed on templates.
+ * Slots are kept in one flat array with one control byte each.  A key's hash picks a group of LSTL_HASH_GROUP
+ *	slots to search first; groups are then probed in triangular order until a group with an empty slot is
+ *	found.  The table grows (doubling) when it would become more than 7/8 full.
+ * This class cannot be instantiated directly!
+ */
+
+
+#ifndef __LSTL_HASHTABLECRTP_H__
+#define __LSTL_HASHTABLECRTP_H__
+
+#include "../LSTLib.h"
+#include "LSTLHashTableBase.h"
+#include <new>
+
+namespace lstl {
+
+	/**
+	 * Class CHashTableCrtp
+	 * \brief The open-addressing hash table shared by CHashMap and CHashSet.
+	 *
+	 * Description: The open-addressing hash table shared by CHashMap and CHashSet.  _tDerivedType must implement
+	 *	static const _tKeyType & SlotKey( const _tSlotType & ).  _uAllocSize is the smallest number of slots
+	 *	allocated at once and is rounded up to a power of 2 no smaller than LSTL_HASH_GROUP.
+	 *
+	 * Items are addressed by slot index.  Iterate with Begin(), Next(), and End(); indices remain valid until the
+	 *	table is modified.
+	 */
+	template <typename _tDerivedType, typename _tKeyType, typename _tSlotType, typename _tHasher, unsigned _uAllocSize>
+	class CHashTableCrtp : protected CHashTableBase {
+	public :
+		// == Various constructors.
+		explicit LSE_CALLCTOR					CHashTableCrtp( CAllocator * _paAllocator = NULL ) :
+			m_pi8Control( NULL ),
+			m_ptSlots( NULL ),
+			m_ui32Capacity( 0 ),
+			m_ui32Length( 0 ),
+			m_ui32GrowthLeft( 0 ),
+			m_paOurAllocator( _paAllocator ? _paAllocator : m_paDefaultAllocator ) {
+		}
+		LSE_CALLCTOR							~CHashTableCrtp() {
+			Reset();
+		}
+
+
+		// == Functions.
+		/**
+		 * Makes room for at least the given number of items without further allocation.
+		 *
+		 * \param _ui32Total Number of items to make room for.
+		 * \return Returns true if there was enough memory.
+		 */
+		LSBOOL LSE_CALL							Allocate( uint32_t _ui32Total ) {
+			uint32_t ui32Capacity = CapacityFor( _ui32Total );
+			if ( ui32Capacity <= m_ui32Capacity ) { return true; }
+			return Rehash( ui32Capacity );
+		}
+
+		/**
+		 * Removes all items and frees the table.
+		 */
+		void LSE_CALL							Reset() {
+			DestroyAll();
+			if ( m_pi8Control ) {
+				m_paOurAllocator->Free( m_pi8Control );
+			}
+			m_pi8Control = NULL;
+			m_ptSlots = NULL;
+			m_ui32Capacity = m_ui32Length = m_ui32GrowthLeft = 0;
+		}
+
+		/**
+		 * Removes all items without freeing the table.
+		 */
+		void LSE_CALL							ResetNoDealloc() {
+			DestroyAll();
+			if ( m_ui32Capacity ) {
+				CStd::MemSet( m_pi8Control, static_cast<uint8_t>(LSTL_HASH_EMPTY), m_ui32Capacity );
+			}
+			m_ui32Length = 0;
+			m_ui32GrowthLeft = MaxLoad( m_ui32Capacity );
+		}
+
+		/**
+		 * Gets the total number of items.
+		 *
+		 * \return Returns the total number of items in the table.
+		 */
+		uint32_t LSE_CALL						Length() const {
+			return m_ui32Length;
+		}
+
+		/**
+		 * Gets the index of an existing item.
+		 *
+		 * \param _tKey Key of the item to find.
+		 * \param _ui32Index The returned slot index of the found item.
+		 * \return Returns true if the item exists, false otherwise.
+		 */
+		LSBOOL LSE_CALL							GetItemIndex( const _tKeyType &_tKey, uint32_t &_ui32Index ) const {
+			if ( !m_ui32Length ) { return false; }
+			return Find( _tKey, _tHasher::Hash( _tKey ), _ui32Index );
+		}
+
+		/**
+		 * Determines whether the given key is in the table.
+		 *
+		 * \param _tKey The key to find.
+		 * \return Returns true if the key is in the table.
+		 */
+		LSBOOL LSE_CALL							ItemExists( const _tKeyType &_tKey ) const {
+			uint32_t ui32Index;
+			return GetItemIndex( _tKey, ui32Index );
+		}
+
+		/**
+		 * Removes an item by slot index.
+		 *
+		 * \param _ui32Index Slot index of the item to remove, which must hold an item.
+		 */
+		void LSE_CALL							RemoveByIndex( uint32_t _ui32Index ) {
+			m_ptSlots[_ui32Index].~_tSlotType();
+			--m_ui32Length;
+			// If the group still has an empty slot, no probe has ever passed through it, so this slot can become
+			//	empty again instead of leaving a tombstone.
+			if ( MatchEmpty( &m_pi8Control[_ui32Index&~(LSTL_HASH_GROUP-1)] ) ) {
+				m_pi8Control[_ui32Index] = LSTL_HASH_EMPTY;
+				++m_ui32GrowthLeft;
+			}
+			else {
+				m_pi8Control[_ui32Index] = LSTL_HASH_DELETED;
+			}
+		}
+
+		/**
+		 * Gets the slot index of the first item.
+		 *
+		 * \return Returns the slot index of the first item or End() if there are no items.
+		 */
+		uint32_t LSE_CALL						Begin() const {
+			return Next( static_cast<uint32_t>(-1) );
+		}
+
+		/**
+		 * Gets the slot index of the item after the given slot index.
+		 *
+		 * \param _ui32Index The slot index of the current item.
+		 * \return Returns the slot index of the next item or End() if there are no more items.
+		 */
+		uint32_t LSE_CALL						Next( uint32_t _ui32Index ) const {
+			uint32_t ui32Index = _ui32Index + 1;
+			while ( ui32Index < m_ui32Capacity ) {
+				uint32_t ui32Group = ui32Index & ~(LSTL_HASH_GROUP - 1);
+				uint32_t ui32Mask = (~MatchFree( &m_pi8Control[ui32Group] ) & ((1U << LSTL_HASH_GROUP) - 1)) >> (ui32Index - ui32Group);
+				if ( ui32Mask ) { return ui32Index + LowestBit( ui32Mask ); }
+				ui32Index = ui32Group + LSTL_HASH_GROUP;
+			}
+			return m_ui32Capacity;
+		}
+
+		/**
+		 * Gets the slot index that marks the end of iteration.
+		 *
+		 * \return Returns the slot index that marks the end of iteration.
+		 */
+		uint32_t LSE_CALL						End() const {
+			return m_ui32Capacity;
+		}
+
+		/**
+		 * Sets the allocator.  Causes the object to be fully reset.  Should not be used on
+		 *	tables that have contents already.
+		 *
+		 * \param _paAllocator The new allocator to be used by this object or NULL to use the
+		 *	default allocator for hash-table objects.
+		 */
+		void LSE_CALL							SetAllocator( CAllocator * _paAllocator ) {
+			Reset();
+			m_paOurAllocator = _paAllocator ? _paAllocator : m_paDefaultAllocator;
+		}
+
+		/**
+		 * Gets our allocator.
+		 *
+		 * \return Returns a pointer to the allocator used by this object.
+		 */
+		CAllocator * LSE_CALL					GetAllocator() {
+			return m_paOurAllocator;
+		}
+
+
+	protected :
+		// == Members.
+		/** The control bytes, followed in the same allocation by the slots. */
+		int8_t *								m_pi8Control;
+
+		/** The slots. */
+		_tSlotType *							m_ptSlots;
+
+		/** Number of slots.  0 or a power of 2 no smaller than LSTL_HASH_GROUP. */
+		uint32_t								m_ui32Capacity;
+
+		/** Number of items. */
+		uint32_t								m_ui32Length;
+
+		/** Number of empty slots that can be filled before the table must grow. */
+		uint32_t								m_ui32GrowthLeft;
+
+		/** The allocator. */
+		CAllocator *							m_paOurAllocator;
+
+
+		// == Functions.
+		/**
+		 * Finds the slot for a key, preparing an empty slot if the key is not in the table.  If the key is not found,
+		 *	the caller must construct a slot with the key at the returned index.
+		 *
+		 * \param _tKey The key to find or add.
+		 * \param _ui32Index The returned slot index.
+		 * \param _bFound Set to true if the key was already in the table.
+		 * \return Returns false if the table had to grow and there was not enough memory.
+		 */
+		LSBOOL LSE_CALL							FindOrPrepareInsert( const _tKeyType &_tKey, uint32_t &_ui32Index, LSBOOL &_bFound ) {
+			uint64_t ui64Hash = _tHasher::Hash( _tKey );
+			_bFound = m_ui32Length && Find( _tKey, ui64Hash, _ui32Index );
+			if ( _bFound ) { return true; }
+			if ( !m_ui32GrowthLeft ) {
+				// Grow, or if tombstones are what filled the table, rebuild it at the same size.
+				if ( !Rehash( CapacityFor( m_ui32Length + 1 ) ) ) { return false; }
+			}
+			_ui32Index = FindFree( ui64Hash );
+			if ( m_pi8Control[_ui32Index] == LSTL_HASH_EMPTY ) {
+				--m_ui32GrowthLeft;
+			}
+			m_pi8Control[_ui32Index] = Hash2( ui64Hash );
+			++m_ui32Length;
+			return true;
+		}
+
+		/**
+		 * Copies the items from another table into this one.  Existing items are removed first.
+		 *
+		 * \param _htcSrc The table to copy.
+		 * \return Returns false if there was not enough memory to copy every item.
+		 */
+		LSBOOL LSE_CALL							CopyFrom( const CHashTableCrtp<_tDerivedType, _tKeyType, _tSlotType, _tHasher, _uAllocSize> &_htcSrc ) {
+			if ( &_htcSrc == this ) { return true; }
+			ResetNoDealloc();
+			if ( !Allocate( _htcSrc.Length() ) ) { return false; }
+			for ( uint32_t I = _htcSrc.Begin(); I != _htcSrc.End(); I = _htcSrc.Next( I ) ) {
+				uint64_t ui64Hash = _tHasher::Hash( _tDerivedType::SlotKey( _htcSrc.m_ptSlots[I] ) );
+				uint32_t ui32Index = FindFree( ui64Hash );
+				new( &m_ptSlots[ui32Index] ) _tSlotType( _htcSrc.m_ptSlots[I] );
+				m_pi8Control[ui32Index] = Hash2( ui64Hash );
+				--m_ui32GrowthLeft;
+				++m_ui32Length;
+			}
+			return true;
+		}
+
+		/**
+		 * Finds an item given its key and the hash of its key.
+		 *
+		 * \param _tKey Key of the item to find.
+		 * \param _ui64Hash The hash of the key.
+		 * \param _ui32Index The returned slot index of the found item.
+		 * \return Returns true if the item exists, false otherwise.
+		 */
+		LSBOOL LSE_CALL							Find( const _tKeyType &_tKey, uint64_t _ui64Hash, uint32_t &_ui32Index ) const {
+			int8_t i8Hash = Hash2( _ui64Hash );
+			uint32_t ui32GroupMask = (m_ui32Capacity / LSTL_HASH_GROUP) - 1;
+			uint32_t ui32Group = Hash1( _ui64Hash ) & ui32GroupMask;
+			for ( uint32_t ui32Step = 1; ; ++ui32Step ) {
+				const int8_t * pi8Group = &m_pi8Control[ui32Group*LSTL_HASH_GROUP];
+				for ( uint32_t ui32Mask = Match( pi8Group, i8Hash ); ui32Mask; ui32Mask &= ui32Mask - 1 ) {
+					uint32_t ui32Index = ui32Group * LSTL_HASH_GROUP + LowestBit( ui32Mask );
+					if ( _tDerivedType::SlotKey( m_ptSlots[ui32Index] ) == _tKey ) {
+						_ui32Index = ui32Index;
+						return true;
+					}
+				}
+				if ( MatchEmpty( pi8Group ) ) { return false; }
+				ui32Group = (ui32Group + ui32Step) & ui32GroupMask;
+			}
+		}
+
+		/**
+		 * Finds the first free slot along a hash's probe sequence.  There must be one.
+		 *
+		 * \param _ui64Hash The hash whose probe sequence is to be searched.
+		 * \return Returns the index of an empty or deleted slot.
+		 */
+		uint32_t LSE_CALL						FindFree( uint64_t _ui64Hash ) const {
+			uint32_t ui32GroupMask = (m_ui32Capacity / LSTL_HASH_GROUP) - 1;
+			uint32_t ui32Group = Hash1( _ui64Hash ) & ui32GroupMask;
+			for ( uint32_t ui32Step = 1; ; ++ui32Step ) {
+				uint32_t ui32Mask = MatchFree( &m_pi8Control[ui32Group*LSTL_HASH_GROUP] );
+				if ( ui32Mask ) { return ui32Group * LSTL_HASH_GROUP + LowestBit( ui32Mask ); }
+				ui32Group = (ui32Group + ui32Step) & ui32GroupMask;
+			}
+		}
+
+		/**
+		 * Moves all items into a new table of the given size.
+		 *
+		 * \param _ui32Capacity The new number of slots.  Must be large enough for all items.
+		 * \return Returns false if there was not enough memory, in which case the table is unchanged.
+		 */
+		LSBOOL LSE_CALL							Rehash( uint32_t _ui32Capacity ) {
+			uintptr_t uiptrSlotOffset = LSE_ROUND_UP( static_cast<uintptr_t>(_ui32Capacity), sizeof( uint64_t ) * 2 );
+			int8_t * pi8Control = static_cast<int8_t *>(m_paOurAllocator->Alloc( uiptrSlotOffset + _ui32Capacity * sizeof( _tSlotType ) ));
+			if ( !pi8Control ) { return false; }
+			CStd::MemSet( pi8Control, static_cast<uint8_t>(LSTL_HASH_EMPTY), _ui32Capacity );
+
+			int8_t * pi8OldControl = m_pi8Control;
+			_tSlotType * ptOldSlots = m_ptSlots;
+			uint32_t ui32OldCapacity = m_ui32Capacity;
+			m_pi8Control = pi8Control;
+			m_ptSlots = reinterpret_cast<_tSlotType *>(pi8Control + uiptrSlotOffset);
+			m_ui32Capacity = _ui32Capacity;
+			m_ui32GrowthLeft = MaxLoad( _ui32Capacity ) - m_ui32Length;
+
+			for ( uint32_t I = 0; I < ui32OldCapacity; ++I ) {
+				if ( pi8OldControl[I] >= 0 ) {
+					uint64_t ui64Hash = _tHasher::Hash( _tDerivedType::SlotKey( ptOldSlots[I] ) );
+					uint32_t ui32Index = FindFree( ui64Hash );
+					new( &m_ptSlots[ui32Index] ) _tSlotType( ptOldSlots[I] );
+					m_pi8Control[ui32Index] = Hash2( ui64Hash );
+					ptOldSlots[I].~_tSlotType();
+				}
+			}
+			if ( pi8OldControl ) {
+				m_paOurAllocator->Free( pi8OldControl );
+			}
+			return true;
+		}
+
+		/**
+		 * Destroys every item without changing the control bytes.
+		 */
+		void LSE_CALL							DestroyAll() {
+			if ( !m_ui32Length ) { return; }
+			for ( uint32_t I = m_ui32Capacity; I--; ) {
+				if ( m_pi8Control[I] >= 0 ) {
+					m_ptSlots[I].~_tSlotType();
+				}
+			}
+		}
+
+		/**
+		 * Gets the number of slots needed to hold the given number of items.
+		 *
+		 * \param _ui32Total The number of items.
+		 * \return Returns the number of slots needed to hold the given number of items.
+		 */
+		static uint32_t LSE_CALL				CapacityFor( uint32_t _ui32Total ) {
+			uint32_t ui32Capacity = LSTL_HASH_GROUP;
+			while ( ui32Capacity < _uAllocSize ) { ui32Capacity <<= 1; }
+			while ( MaxLoad( ui32Capacity ) < _ui32Total ) { ui32Capacity <<= 1; }
+			return ui32Capacity;
+		}
+
+		/**
+		 * Gets the number of items a table with the given number of slots can hold.
+		 *
+		 * \param _ui32Capacity The number of slots.
+		 * \return Returns the number of items the table can hold before it must grow.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		MaxLoad( uint32_t _ui32Capacity ) {
+			return _ui32Capacity - (_ui32Capacity >> 3);
+		}
+
+		/**
+		 * Gets the part of a hash that selects the first group to probe.
+		 *
+		 * \param _ui64Hash The hash.
+		 * \return Returns the group-selecting part of the hash.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		Hash1( uint64_t _ui64Hash ) {
+			return static_cast<uint32_t>(_ui64Hash >> 7);
+		}
+
+		/**
+		 * Gets the part of a hash that is stored in the control byte.
+		 *
+		 * \param _ui64Hash The hash.
+		 * \return Returns the low 7 bits of the hash.
+		 */
+		static LSE_INLINE int8_t LSE_CALL		Hash2( uint64_t _ui64Hash ) {
+			return static_cast<int8_t>(_ui64Hash & 0x7F);
+		}
+
+	private :
+		// Copying is done by the derived classes through CopyFrom().
+		LSE_CALLCTOR							CHashTableCrtp( const CHashTableCrtp<_tDerivedType, _tKeyType, _tSlotType, _tHasher, _uAllocSize> & );
+		CHashTableCrtp<_tDerivedType, _tKeyType, _tSlotType, _tHasher, _uAllocSize> & LSE_CALL
+												operator = ( const CHashTableCrtp<_tDerivedType, _tKeyType, _tSlotType, _tHasher, _uAllocSize> & );
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_HASHTABLECRTP_H__
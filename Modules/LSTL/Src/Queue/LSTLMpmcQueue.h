@@ -0,0 +1,264 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A fixed-size lock-free queue that any number of threads can push to and pop from at once (Dmitry
+ *	Vyukov's bounded MPMC queue).  Items are copied in and out by value, so _tType must be a plain-old-data type.
+ */
+
+
+#ifndef __LSTL_MPMCQUEUE_H__
+#define __LSTL_MPMCQUEUE_H__
+
+#include "../LSTLib.h"
+#include "Atomic/LSSTDAtomic.h"
+
+namespace lstl {
+
+	/**
+	 * Class CMpmcQueue
+	 * \brief A fixed-size lock-free queue for any number of producers and consumers.
+	 *
+	 * Description: A fixed-size lock-free queue that any number of threads can push to and pop from at once (Dmitry
+	 *	Vyukov's bounded MPMC queue).  Items are copied in and out by value, so _tType must be a plain-old-data type.
+	 *	_uSize must be a power of 2.
+	 *
+	 * Every slot carries a sequence number that tells which lap of the ring it is ready for.  A producer claims position P
+	 *	by advancing the enqueue index with a compare-and-exchange once slot P's sequence is P, writes the item, then sets
+	 *	the sequence to P + 1.  A consumer claims P once the sequence is P + 1 and hands the slot to the next lap by setting
+	 *	it to P + _uSize.  The only shared writes are the two indices and the slot itself.
+	 */
+	template <typename _tType, unsigned _uSize = 1024>
+	class CMpmcQueue {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CMpmcQueue() {
+			for ( unsigned I = 0; I < _uSize; ++I ) {
+				m_sSlots[I].aSequence = static_cast<CAtomic::ATOM_OP>(I);
+			}
+			m_aEnqueue = 0;
+			m_aDequeue = 0;
+		}
+
+
+		// == Functions.
+		/**
+		 * Adds an item to the queue.  Can be called by any thread.
+		 *
+		 * \param _tItem The item to add.
+		 * \return Returns false if the queue is full.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Push( const _tType &_tItem ) {
+			CAtomic::ATOM_OP aoPos = CAtomic::AtomicLoad( m_aEnqueue );
+			LSTL_MPMC_SLOT * psSlot;
+			while ( true ) {
+				psSlot = &m_sSlots[aoPos&(_uSize-1)];
+				int32_t i32Dif = Distance( aoPos, CAtomic::AtomicLoad( psSlot->aSequence ) );
+				if ( i32Dif == 0 ) {
+					CAtomic::ATOM_OP aoOld = CAtomic::InterlockedCompareExchange( m_aEnqueue, Advance( aoPos, 1 ), aoPos );
+					if ( aoOld == aoPos ) { break; }
+					aoPos = aoOld;
+				}
+				else if ( i32Dif < 0 ) {
+					// The slot still holds an item from the previous lap.
+					return false;
+				}
+				else {
+					// Another producer claimed this position first.
+					aoPos = CAtomic::AtomicLoad( m_aEnqueue );
+				}
+			}
+			psSlot->tItem = _tItem;
+			CAtomic::AtomicStore( psSlot->aSequence, Advance( aoPos, 1 ) );
+			return true;
+		}
+
+		/**
+		 * Adds as many of the given items to the queue as will fit, claiming their positions with a single
+		 *	compare-and-exchange.  Can be called by any thread.  The items are added contiguously and in order.
+		 *
+		 * \param _ptItems The items to add.
+		 * \param _ui32Total The number of items to which _ptItems points.
+		 * \return Returns the number of items added, which is less than _ui32Total if the queue filled.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				PushBatch( const _tType * _ptItems, uint32_t _ui32Total ) {
+			if ( _ui32Total > _uSize ) { _ui32Total = _uSize; }
+			CAtomic::ATOM_OP aoPos = CAtomic::AtomicLoad( m_aEnqueue );
+			uint32_t ui32Count;
+			while ( true ) {
+				// Count the free slots starting at aoPos.  Only the producer that claims a position can change its slot, so
+				//	if the claim below succeeds none of the counted slots can have been taken in the meantime.
+				ui32Count = 0;
+				while ( ui32Count < _ui32Total ) {
+					CAtomic::ATOM_OP aoThis = Advance( aoPos, ui32Count );
+					if ( CAtomic::AtomicLoad( m_sSlots[aoThis&(_uSize-1)].aSequence ) != aoThis ) { break; }
+					++ui32Count;
+				}
+				if ( !ui32Count ) {
+					if ( Distance( aoPos, CAtomic::AtomicLoad( m_sSlots[aoPos&(_uSize-1)].aSequence ) ) < 0 ) { return 0; }
+					aoPos = CAtomic::AtomicLoad( m_aEnqueue );
+					continue;
+				}
+				CAtomic::ATOM_OP aoOld = CAtomic::InterlockedCompareExchange( m_aEnqueue, Advance( aoPos, ui32Count ), aoPos );
+				if ( aoOld == aoPos ) { break; }
+				aoPos = aoOld;
+			}
+			for ( uint32_t I = 0; I < ui32Count; ++I ) {
+				CAtomic::ATOM_OP aoThis = Advance( aoPos, I );
+				LSTL_MPMC_SLOT & sSlot = m_sSlots[aoThis&(_uSize-1)];
+				sSlot.tItem = _ptItems[I];
+				CAtomic::AtomicStore( sSlot.aSequence, Advance( aoThis, 1 ) );
+			}
+			return ui32Count;
+		}
+
+		/**
+		 * Removes the oldest item from the queue.  Can be called by any thread.
+		 *
+		 * \param _tItem Holds the returned item.
+		 * \return Returns false if the queue is empty.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Pop( _tType &_tItem ) {
+			CAtomic::ATOM_OP aoPos = CAtomic::AtomicLoad( m_aDequeue );
+			LSTL_MPMC_SLOT * psSlot;
+			while ( true ) {
+				psSlot = &m_sSlots[aoPos&(_uSize-1)];
+				int32_t i32Dif = Distance( Advance( aoPos, 1 ), CAtomic::AtomicLoad( psSlot->aSequence ) );
+				if ( i32Dif == 0 ) {
+					CAtomic::ATOM_OP aoOld = CAtomic::InterlockedCompareExchange( m_aDequeue, Advance( aoPos, 1 ), aoPos );
+					if ( aoOld == aoPos ) { break; }
+					aoPos = aoOld;
+				}
+				else if ( i32Dif < 0 ) {
+					// Nothing has been written to this slot yet.
+					return false;
+				}
+				else {
+					// Another consumer claimed this position first.
+					aoPos = CAtomic::AtomicLoad( m_aDequeue );
+				}
+			}
+			_tItem = psSlot->tItem;
+			CAtomic::AtomicStore( psSlot->aSequence, Advance( aoPos, _uSize ) );
+			return true;
+		}
+
+		/**
+		 * Removes up to the given number of the oldest items from the queue, claiming their positions with a single
+		 *	compare-and-exchange.  Can be called by any thread.
+		 *
+		 * \param _ptItems Holds the returned items.
+		 * \param _ui32Max The number of items _ptItems can hold.
+		 * \return Returns the number of items removed.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				PopBatch( _tType * _ptItems, uint32_t _ui32Max ) {
+			if ( _ui32Max > _uSize ) { _ui32Max = _uSize; }
+			CAtomic::ATOM_OP aoPos = CAtomic::AtomicLoad( m_aDequeue );
+			uint32_t ui32Count;
+			while ( true ) {
+				// Count the filled slots starting at aoPos.  As with PushBatch(), a successful claim guarantees that no other
+				//	consumer took any of them.
+				ui32Count = 0;
+				while ( ui32Count < _ui32Max ) {
+					CAtomic::ATOM_OP aoThis = Advance( aoPos, ui32Count );
+					if ( CAtomic::AtomicLoad( m_sSlots[aoThis&(_uSize-1)].aSequence ) != Advance( aoThis, 1 ) ) { break; }
+					++ui32Count;
+				}
+				if ( !ui32Count ) {
+					if ( Distance( Advance( aoPos, 1 ), CAtomic::AtomicLoad( m_sSlots[aoPos&(_uSize-1)].aSequence ) ) < 0 ) { return 0; }
+					aoPos = CAtomic::AtomicLoad( m_aDequeue );
+					continue;
+				}
+				CAtomic::ATOM_OP aoOld = CAtomic::InterlockedCompareExchange( m_aDequeue, Advance( aoPos, ui32Count ), aoPos );
+				if ( aoOld == aoPos ) { break; }
+				aoPos = aoOld;
+			}
+			for ( uint32_t I = 0; I < ui32Count; ++I ) {
+				CAtomic::ATOM_OP aoThis = Advance( aoPos, I );
+				LSTL_MPMC_SLOT & sSlot = m_sSlots[aoThis&(_uSize-1)];
+				_ptItems[I] = sSlot.tItem;
+				CAtomic::AtomicStore( sSlot.aSequence, Advance( aoThis, _uSize ) );
+			}
+			return ui32Count;
+		}
+
+		/**
+		 * Gets the approximate number of items in the queue.  Exact only when no thread is modifying the queue.
+		 *
+		 * \return Returns the approximate number of items in the queue.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				Size() const {
+			int32_t i32Size = Distance( CAtomic::AtomicLoad( m_aDequeue ), CAtomic::AtomicLoad( m_aEnqueue ) );
+			return i32Size > 0 ? static_cast<uint32_t>(i32Size) : 0;
+		}
+
+		/**
+		 * Gets the maximum number of items the queue can hold.
+		 *
+		 * \return Returns the maximum number of items the queue can hold.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				Capacity() const {
+			return _uSize;
+		}
+
+
+	protected :
+		// == Types.
+		/** A slot in the ring. */
+		typedef struct LSTL_MPMC_SLOT {
+			/** The position for which the slot is ready. */
+			CAtomic::ATOM							aSequence;
+
+			/** The item. */
+			_tType									tItem;
+		} * LPLSTL_MPMC_SLOT, * const LPCLSTL_MPMC_SLOT;
+
+
+		// == Members.
+		/** The position at which the next item is added.  Kept on its own cache line, away from the consumers' m_aDequeue. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) CAtomic::ATOM
+													m_aEnqueue LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+		/** The position of the oldest item. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) CAtomic::ATOM
+													m_aDequeue LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+		/** The slots. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) LSTL_MPMC_SLOT
+													m_sSlots[_uSize] LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+
+		// == Functions.
+		/**
+		 * Gets the signed distance from one position to another.  Positions are allowed to wrap.
+		 *
+		 * \param _aoFrom The starting position.
+		 * \param _aoTo The ending position.
+		 * \return Returns _aoTo - _aoFrom.
+		 */
+		static LSE_INLINE int32_t LSE_CALL			Distance( CAtomic::ATOM_OP _aoFrom, CAtomic::ATOM_OP _aoTo ) {
+			return static_cast<int32_t>(static_cast<uint32_t>(_aoTo) - static_cast<uint32_t>(_aoFrom));
+		}
+
+		/**
+		 * Advances a position, wrapping without signed overflow.
+		 *
+		 * \param _aoPos The position to advance.
+		 * \param _ui32Amount The number of steps by which to advance the position.
+		 * \return Returns _aoPos + _ui32Amount.
+		 */
+		static LSE_INLINE CAtomic::ATOM_OP LSE_CALL	Advance( CAtomic::ATOM_OP _aoPos, uint32_t _ui32Amount ) {
+			return static_cast<CAtomic::ATOM_OP>(static_cast<uint32_t>(_aoPos) + _ui32Amount);
+		}
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_MPMCQUEUE_H__
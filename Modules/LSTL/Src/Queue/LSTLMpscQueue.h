@@ -0,0 +1,201 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: An unbounded lock-free intrusive queue that any number of threads can push to and one thread pops from
+ *	(Dmitry Vyukov's intrusive MPSC queue).  Items are linked through a CMpscNode base, so the queue never allocates.
+ */
+
+
+#ifndef __LSTL_MPSCQUEUE_H__
+#define __LSTL_MPSCQUEUE_H__
+
+#include "../LSTLib.h"
+#include "Atomic/LSSTDAtomic.h"
+
+namespace lstl {
+
+	/**
+	 * Class CMpscNode
+	 * \brief The link by which items are chained inside a CMpscQueue.
+	 *
+	 * Description: The link by which items are chained inside a CMpscQueue.  Types stored in a CMpscQueue must inherit
+	 *	from this publicly.  A node can be in only one queue at a time.
+	 */
+	class CMpscNode {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CMpscNode() :
+			m_pvNext( NULL ) {
+		}
+
+
+	protected :
+		// == Members.
+		/** The next node in the queue. */
+		void * volatile								m_pvNext;
+
+
+	private :
+		template <typename _tType>
+		friend class								CMpscQueue;
+	};
+
+	/**
+	 * Class CMpscQueue
+	 * \brief An unbounded lock-free intrusive queue for any number of producers and one consumer.
+	 *
+	 * Description: An unbounded lock-free intrusive queue that any number of threads can push to and one thread pops from
+	 *	(Dmitry Vyukov's intrusive MPSC queue).  _tType must inherit publicly from CMpscNode.  The queue does not own its
+	 *	nodes; a popped node belongs to the caller again.
+	 *
+	 * A push is one atomic exchange on m_pvHead followed by a release store linking the previous head to the new node, so
+	 *	producers never retry.  Between those two steps the chain is briefly broken, during which Pop() returns NULL even
+	 *	though the queue is not empty; the consumer simply picks the node up on a later call.
+	 */
+	template <typename _tType>
+	class CMpscQueue {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CMpscQueue() {
+			m_pvHead = &m_mnStub;
+			m_pmnTail = &m_mnStub;
+		}
+
+
+		// == Functions.
+		/**
+		 * Adds an item to the queue.  Can be called by any thread.
+		 *
+		 * \param _ptItem The item to add.  Must not already be in a queue.
+		 */
+		LSE_INLINE void LSE_CALL					Push( _tType * _ptItem ) {
+			PushChain( _ptItem, _ptItem );
+		}
+
+		/**
+		 * Adds items to the queue with a single atomic exchange.  Can be called by any thread.  The items are added
+		 *	contiguously and in order.
+		 *
+		 * \param _pptItems The items to add.  None may already be in a queue.
+		 * \param _ui32Total The number of items to which _pptItems points.
+		 */
+		LSE_INLINE void LSE_CALL					PushBatch( _tType * const * _pptItems, uint32_t _ui32Total ) {
+			if ( !_ui32Total ) { return; }
+			// Link the items privately first so that they become visible to the consumer all at once.
+			for ( uint32_t I = 1; I < _ui32Total; ++I ) {
+				static_cast<CMpscNode *>(_pptItems[I-1])->m_pvNext = static_cast<CMpscNode *>(_pptItems[I]);
+			}
+			PushChain( _pptItems[0], _pptItems[_ui32Total-1] );
+		}
+
+		/**
+		 * Removes the oldest item from the queue.  Must only be called by the consumer thread.
+		 *
+		 * \return Returns the oldest item, or NULL if the queue is empty or a producer is midway through adding the
+		 *	oldest item.
+		 */
+		LSE_INLINE _tType * LSE_CALL				Pop() {
+			CMpscNode * pmnTail = m_pmnTail;
+			CMpscNode * pmnNext = Next( pmnTail );
+			if ( pmnTail == &m_mnStub ) {
+				if ( !pmnNext ) { return NULL; }
+				m_pmnTail = pmnNext;
+				pmnTail = pmnNext;
+				pmnNext = Next( pmnNext );
+			}
+			if ( pmnNext ) {
+				m_pmnTail = pmnNext;
+				return static_cast<_tType *>(pmnTail);
+			}
+
+			// pmnTail is the last linked node.  If it is not also the head, a producer has swapped the head but not yet
+			//	linked its node.
+			if ( pmnTail != CAtomic::AtomicLoadPointer( m_pvHead ) ) { return NULL; }
+
+			// Put the stub behind pmnTail so that pmnTail can be unlinked without leaving the queue headless.
+			PushChain( &m_mnStub, &m_mnStub );
+			pmnNext = Next( pmnTail );
+			if ( pmnNext ) {
+				m_pmnTail = pmnNext;
+				return static_cast<_tType *>(pmnTail);
+			}
+			return NULL;
+		}
+
+		/**
+		 * Removes up to the given number of the oldest items from the queue.  Must only be called by the consumer thread.
+		 *
+		 * \param _pptItems Holds the returned items.
+		 * \param _ui32Max The number of items _pptItems can hold.
+		 * \return Returns the number of items removed.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				PopBatch( _tType ** _pptItems, uint32_t _ui32Max ) {
+			uint32_t ui32Count = 0;
+			while ( ui32Count < _ui32Max ) {
+				_tType * ptItem = Pop();
+				if ( !ptItem ) { break; }
+				_pptItems[ui32Count++] = ptItem;
+			}
+			return ui32Count;
+		}
+
+		/**
+		 * Determines whether the queue appears empty.  Must only be called by the consumer thread.  The result can be stale
+		 *	as soon as it is returned.
+		 *
+		 * \return Returns true if no items are waiting.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Empty() const {
+			return m_pmnTail == &m_mnStub && !CAtomic::AtomicLoadPointer( m_mnStub.m_pvNext );
+		}
+
+
+	protected :
+		// == Members.
+		/** The most recently pushed node (a CMpscNode *).  Swapped by producers, so kept on its own cache line. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) void * volatile
+													m_pvHead LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+		/** The oldest node.  Used only by the consumer. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) CMpscNode *
+													m_pmnTail LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+		/** A placeholder node that keeps the chain non-empty. */
+		CMpscNode									m_mnStub;
+
+
+		// == Functions.
+		/**
+		 * Appends an already-linked chain of nodes.
+		 *
+		 * \param _pmnFirst The first node in the chain.
+		 * \param _pmnLast The last node in the chain.
+		 */
+		LSE_INLINE void LSE_CALL					PushChain( CMpscNode * _pmnFirst, CMpscNode * _pmnLast ) {
+			_pmnLast->m_pvNext = NULL;
+			CMpscNode * pmnPrev = static_cast<CMpscNode *>(CAtomic::AtomicExchangePointer( m_pvHead, _pmnLast ));
+			CAtomic::AtomicStorePointer( pmnPrev->m_pvNext, _pmnFirst );
+		}
+
+		/**
+		 * Gets the node after the given node.
+		 *
+		 * \param _pmnNode The node whose link is to be read.
+		 * \return Returns the next node or NULL.
+		 */
+		static LSE_INLINE CMpscNode * LSE_CALL		Next( const CMpscNode * _pmnNode ) {
+			return static_cast<CMpscNode *>(CAtomic::AtomicLoadPointer( _pmnNode->m_pvNext ));
+		}
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_MPSCQUEUE_H__
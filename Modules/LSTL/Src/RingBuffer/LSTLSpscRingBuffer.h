@@ -0,0 +1,193 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A fixed-size lock-free ring buffer for exactly one producer thread and one consumer thread.  Items are
+ *	copied in and out by value, so _tType must be a plain-old-data type.
+ */
+
+
+#ifndef __LSTL_SPSCRINGBUFFER_H__
+#define __LSTL_SPSCRINGBUFFER_H__
+
+#include "../LSTLib.h"
+#include "Atomic/LSSTDAtomic.h"
+
+namespace lstl {
+
+	/**
+	 * Class CSpscRingBuffer
+	 * \brief A fixed-size lock-free ring buffer for one producer and one consumer.
+	 *
+	 * Description: A fixed-size lock-free ring buffer for exactly one producer thread and one consumer thread.  Items are
+	 *	copied in and out by value, so _tType must be a plain-old-data type.  _uSize must be a power of 2.
+	 *
+	 * Each side keeps a private copy of the other side's index and only re-reads the shared index when the copy says the
+	 *	buffer is full (producer) or empty (consumer), so in the steady state neither side touches the other's cache line.
+	 */
+	template <typename _tType, unsigned _uSize = 1024>
+	class CSpscRingBuffer {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CSpscRingBuffer() {
+			m_aHead = 0;
+			m_aTail = 0;
+			m_aoHeadCache = 0;
+			m_aoTailCache = 0;
+		}
+
+
+		// == Functions.
+		/**
+		 * Adds an item to the buffer.  Must only be called by the producer thread.
+		 *
+		 * \param _tItem The item to add.
+		 * \return Returns false if the buffer is full.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Push( const _tType &_tItem ) {
+			CAtomic::ATOM_OP aoTail = m_aTail;
+			if ( Distance( m_aoHeadCache, aoTail ) >= _uSize ) {
+				m_aoHeadCache = CAtomic::AtomicLoad( m_aHead );
+				if ( Distance( m_aoHeadCache, aoTail ) >= _uSize ) { return false; }
+			}
+			m_tItems[aoTail&(_uSize-1)] = _tItem;
+			CAtomic::AtomicStore( m_aTail, Advance( aoTail, 1 ) );
+			return true;
+		}
+
+		/**
+		 * Adds as many of the given items to the buffer as will fit, publishing them all at once.  Must only be called by
+		 *	the producer thread.
+		 *
+		 * \param _ptItems The items to add.
+		 * \param _ui32Total The number of items to which _ptItems points.
+		 * \return Returns the number of items added, which is less than _ui32Total if the buffer filled.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				PushBatch( const _tType * _ptItems, uint32_t _ui32Total ) {
+			CAtomic::ATOM_OP aoTail = m_aTail;
+			uint32_t ui32Free = _uSize - Distance( m_aoHeadCache, aoTail );
+			if ( ui32Free < _ui32Total ) {
+				m_aoHeadCache = CAtomic::AtomicLoad( m_aHead );
+				ui32Free = _uSize - Distance( m_aoHeadCache, aoTail );
+				if ( ui32Free < _ui32Total ) { _ui32Total = ui32Free; }
+			}
+			for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+				m_tItems[Advance( aoTail, I )&(_uSize-1)] = _ptItems[I];
+			}
+			if ( _ui32Total ) { CAtomic::AtomicStore( m_aTail, Advance( aoTail, _ui32Total ) ); }
+			return _ui32Total;
+		}
+
+		/**
+		 * Removes the oldest item from the buffer.  Must only be called by the consumer thread.
+		 *
+		 * \param _tItem Holds the returned item.
+		 * \return Returns false if the buffer is empty.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Pop( _tType &_tItem ) {
+			CAtomic::ATOM_OP aoHead = m_aHead;
+			if ( aoHead == m_aoTailCache ) {
+				m_aoTailCache = CAtomic::AtomicLoad( m_aTail );
+				if ( aoHead == m_aoTailCache ) { return false; }
+			}
+			_tItem = m_tItems[aoHead&(_uSize-1)];
+			CAtomic::AtomicStore( m_aHead, Advance( aoHead, 1 ) );
+			return true;
+		}
+
+		/**
+		 * Removes up to the given number of the oldest items from the buffer, releasing their slots all at once.  Must only
+		 *	be called by the consumer thread.
+		 *
+		 * \param _ptItems Holds the returned items.
+		 * \param _ui32Max The number of items _ptItems can hold.
+		 * \return Returns the number of items removed.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				PopBatch( _tType * _ptItems, uint32_t _ui32Max ) {
+			CAtomic::ATOM_OP aoHead = m_aHead;
+			uint32_t ui32Used = Distance( aoHead, m_aoTailCache );
+			if ( ui32Used < _ui32Max ) {
+				m_aoTailCache = CAtomic::AtomicLoad( m_aTail );
+				ui32Used = Distance( aoHead, m_aoTailCache );
+				if ( ui32Used < _ui32Max ) { _ui32Max = ui32Used; }
+			}
+			for ( uint32_t I = 0; I < _ui32Max; ++I ) {
+				_ptItems[I] = m_tItems[Advance( aoHead, I )&(_uSize-1)];
+			}
+			if ( _ui32Max ) { CAtomic::AtomicStore( m_aHead, Advance( aoHead, _ui32Max ) ); }
+			return _ui32Max;
+		}
+
+		/**
+		 * Gets the approximate number of items in the buffer.  Exact only when neither thread is modifying the buffer.
+		 *
+		 * \return Returns the approximate number of items in the buffer.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				Size() const {
+			return Distance( CAtomic::AtomicLoad( m_aHead ), CAtomic::AtomicLoad( m_aTail ) );
+		}
+
+		/**
+		 * Gets the maximum number of items the buffer can hold.
+		 *
+		 * \return Returns the maximum number of items the buffer can hold.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				Capacity() const {
+			return _uSize;
+		}
+
+
+	protected :
+		// == Members.
+		/** The index of the oldest item.  Written only by the consumer. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) CAtomic::ATOM
+													m_aHead LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+		/** The consumer's copy of m_aTail, kept on the consumer's cache line. */
+		CAtomic::ATOM_OP							m_aoTailCache;
+
+		/** The index at which the next item is added.  Written only by the producer. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) CAtomic::ATOM
+													m_aTail LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+		/** The producer's copy of m_aHead, kept on the producer's cache line. */
+		CAtomic::ATOM_OP							m_aoHeadCache;
+
+		/** The items. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) _tType		m_tItems[_uSize] LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+
+		// == Functions.
+		/**
+		 * Gets the number of steps from one index to another.  Indices are allowed to wrap.
+		 *
+		 * \param _aoFrom The starting index.
+		 * \param _aoTo The ending index.
+		 * \return Returns _aoTo - _aoFrom.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL			Distance( CAtomic::ATOM_OP _aoFrom, CAtomic::ATOM_OP _aoTo ) {
+			return static_cast<uint32_t>(_aoTo) - static_cast<uint32_t>(_aoFrom);
+		}
+
+		/**
+		 * Advances an index, wrapping without signed overflow.
+		 *
+		 * \param _aoIndex The index to advance.
+		 * \param _ui32Amount The number of steps by which to advance the index.
+		 * \return Returns _aoIndex + _ui32Amount.
+		 */
+		static LSE_INLINE CAtomic::ATOM_OP LSE_CALL	Advance( CAtomic::ATOM_OP _aoIndex, uint32_t _ui32Amount ) {
+			return static_cast<CAtomic::ATOM_OP>(static_cast<uint32_t>(_aoIndex) + _ui32Amount);
+		}
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_SPSCRINGBUFFER_H__
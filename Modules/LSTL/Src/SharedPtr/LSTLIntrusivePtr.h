@@ -0,0 +1,239 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A shared pointer to an object that carries its own reference count.  The pointer is the size of
+ *	a raw pointer and can be made from a raw pointer at any time, since the count lives inside the object.
+ */
+
+
+#ifndef __LSTL_INTRUSIVEPTR_H__
+#define __LSTL_INTRUSIVEPTR_H__
+
+#include "../LSTLib.h"
+#include "LSTLRefCounter.h"
+
+namespace lstl {
+
+	/**
+	 * Class CIntrusiveRefCount
+	 * \brief An embedded reference count for objects shared through CIntrusivePtr.
+	 *
+	 * Description: An embedded reference count for objects shared through CIntrusivePtr.  Inherit from this to
+	 *	make a class usable with CIntrusivePtr.  The count is maintained by _tCounter, which is atomic by default.
+	 *	Objects are deleted with LSEDELETE when their last reference is released, so they must be created with
+	 *	LSENEW, and classes that are shared through pointers to their base classes need virtual destructors.
+	 */
+	template <typename _tCounter = CAtomicRefCounter>
+	class CIntrusiveRefCount {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR							CIntrusiveRefCount() :
+			m_cRefCount( 0 ) {
+		}
+		LSE_CALLCTOR							CIntrusiveRefCount( const CIntrusiveRefCount<_tCounter> &/*_ircOther*/ ) :
+			m_cRefCount( 0 ) {
+		}
+
+
+		// == Operators.
+		/**
+		 * Copy operator.  The reference count belongs to the object and is never copied.
+		 *
+		 * \return Returns this object.
+		 */
+		CIntrusiveRefCount<_tCounter> & LSE_CALL
+												operator = ( const CIntrusiveRefCount<_tCounter> &/*_ircOther*/ ) {
+			return (*this);
+		}
+
+
+		// == Functions.
+		/**
+		 * Adds a reference.
+		 */
+		void LSE_CALL							IncRef() const {
+			_tCounter::Increment( m_cRefCount );
+		}
+
+		/**
+		 * Removes a reference.
+		 *
+		 * \return Returns true if that was the last reference, in which case the caller must delete the object.
+		 */
+		LSBOOL LSE_CALL							DecRef() const {
+			return _tCounter::Decrement( m_cRefCount );
+		}
+
+		/**
+		 * Returns the reference count of this object.
+		 *
+		 * \return Returns the reference count of this object.
+		 */
+		uint32_t LSE_CALL						RefCount() const {
+			return _tCounter::Get( m_cRefCount );
+		}
+
+
+	protected :
+		// == Members.
+		/** The reference count. */
+		mutable typename _tCounter::LSSTL_COUNT	m_cRefCount;
+	};
+
+	/**
+	 * Class CIntrusivePtr
+	 * \brief A shared pointer to an object that carries its own reference count.
+	 *
+	 * Description: A shared pointer to an object that carries its own reference count.  _tType must provide
+	 *	IncRef() and DecRef() as CIntrusiveRefCount does.  The object is deleted with LSEDELETE when DecRef()
+	 *	reports that the last reference was released.
+	 */
+	template <typename _tType>
+	class CIntrusivePtr {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR							CIntrusivePtr() :
+			m_ptObj( NULL ) {
+		}
+		LSE_CALLCTOR							CIntrusivePtr( _tType * _ptObj ) :
+			m_ptObj( _ptObj ) {
+			if ( m_ptObj ) {
+				m_ptObj->IncRef();
+			}
+		}
+		LSE_CALLCTOR							CIntrusivePtr( const CIntrusivePtr<_tType> &_ipOther ) :
+			m_ptObj( _ipOther.m_ptObj ) {
+			if ( m_ptObj ) {
+				m_ptObj->IncRef();
+			}
+		}
+		template <typename _tCastType>
+		LSE_CALLCTOR							CIntrusivePtr( const CIntrusivePtr<_tCastType> &_ipOther ) :
+			m_ptObj( const_cast<_tCastType *>(_ipOther.Get()) ) {
+			if ( m_ptObj ) {
+				m_ptObj->IncRef();
+			}
+		}
+		LSE_CALLCTOR							~CIntrusivePtr() {
+			Reset();
+		}
+
+
+		// == Operators.
+		/**
+		 * Copy operator.
+		 *
+		 * \param _ipOther The object to copy.
+		 * \return Returns this object after the copy.
+		 */
+		CIntrusivePtr<_tType> & LSE_CALL		operator = ( const CIntrusivePtr<_tType> &_ipOther ) {
+			return Set( _ipOther.m_ptObj );
+		}
+
+		/**
+		 * Assignment from a raw pointer.
+		 *
+		 * \param _ptObj The object to which to point.
+		 * \return Returns this object after the assignment.
+		 */
+		CIntrusivePtr<_tType> & LSE_CALL		operator = ( _tType * _ptObj ) {
+			return Set( _ptObj );
+		}
+
+		/**
+		 * Dereference operator.
+		 *
+		 * \return Returns a reference to the object that it shares.
+		 */
+		_tType & LSE_CALL						operator * () const {
+			return (*m_ptObj);
+		}
+
+		/**
+		 * Arrow operator.
+		 *
+		 * \return Returns the raw pointer to the object that it shares.
+		 */
+		_tType * LSE_CALL						operator -> () const {
+			return m_ptObj;
+		}
+
+		/**
+		 * Casting to type uintptr_t.
+		 *
+		 * \return Returns the uintptr_t reporesentation of this pointer.
+		 */
+		LSE_CALL								operator uintptr_t() const {
+			return reinterpret_cast<uintptr_t>(m_ptObj);
+		}
+
+
+		// == Functions.
+		/**
+		 * Returns the raw pointer to the object that it shares.
+		 *
+		 * \return Returns the raw pointer to the object that it shares.
+		 */
+		_tType * LSE_CALL						Get() const {
+			return m_ptObj;
+		}
+
+		/**
+		 * Returns true or false depending on whether or not the pointer points to something.
+		 *
+		 * \return Returns true if the pointer is valid.
+		 */
+		LSBOOL LSE_CALL							Valid() const {
+			return m_ptObj != NULL;
+		}
+
+		/**
+		 * Decreases the reference count by one on the object to which this points
+		 *	and deletes it if it reaches 0.
+		 */
+		void LSE_CALL							Reset() {
+			if ( m_ptObj ) {
+				if ( m_ptObj->DecRef() ) {
+					LSEDELETE m_ptObj;
+				}
+				m_ptObj = NULL;
+			}
+		}
+
+
+	protected :
+		// == Members.
+		/** The object to which we point. */
+		_tType *								m_ptObj;
+
+
+		// == Functions.
+		/**
+		 * Points to a new object, releasing the current one.
+		 *
+		 * \param _ptObj The object to which to point.
+		 * \return Returns this object after the change.
+		 */
+		CIntrusivePtr<_tType> & LSE_CALL		Set( _tType * _ptObj ) {
+			if ( _ptObj == m_ptObj ) { return (*this); }
+			if ( _ptObj ) {
+				// Increase their reference count before decreasing ours.
+				_ptObj->IncRef();
+			}
+			Reset();
+			m_ptObj = _ptObj;
+			return (*this);
+		}
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_INTRUSIVEPTR_H__
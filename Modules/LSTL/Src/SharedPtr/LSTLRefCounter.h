@@ -0,0 +1,119 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Reference-counting policies for CSharedPtr.  CRefCounter uses plain increments and decrements and
+ *	is the fastest, but shared pointers using it may only be copied and released by one thread at a time.
+ *	CAtomicRefCounter allows copies of the same shared pointer to be copied and released on any threads.
+ */
+
+
+#ifndef __LSTL_REFCOUNTER_H__
+#define __LSTL_REFCOUNTER_H__
+
+#include "../LSTLib.h"
+#include "Atomic/LSSTDAtomic.h"
+
+namespace lstl {
+
+	/**
+	 * Class CRefCounter
+	 * \brief A non-atomic reference count.
+	 *
+	 * Description: A non-atomic reference count.  Objects shared with this count must only be referenced and
+	 *	released by one thread at a time.
+	 */
+	class CRefCounter {
+	public :
+		// == Types.
+		/** The type of the count. */
+		typedef uint32_t						LSSTL_COUNT;
+
+
+		// == Functions.
+		/**
+		 * Adds a reference.
+		 *
+		 * \param _cCount The count to increase.
+		 */
+		static LSE_INLINE void LSE_CALL			Increment( LSSTL_COUNT &_cCount ) {
+			++_cCount;
+		}
+
+		/**
+		 * Removes a reference.
+		 *
+		 * \param _cCount The count to decrease.
+		 * \return Returns true if that was the last reference.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL		Decrement( LSSTL_COUNT &_cCount ) {
+			return --_cCount == 0;
+		}
+
+		/**
+		 * Gets the current count.
+		 *
+		 * \param _cCount The count to read.
+		 * \return Returns the current count.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		Get( const LSSTL_COUNT &_cCount ) {
+			return _cCount;
+		}
+	};
+
+	/**
+	 * Class CAtomicRefCounter
+	 * \brief An atomic reference count.
+	 *
+	 * Description: An atomic reference count.  Adding a reference is relaxed, since a thread can only copy a
+	 *	reference it already holds.  Removing one is acquire-release so that the thread removing the last
+	 *	reference sees every write made through the others before the object is destroyed.
+	 */
+	class CAtomicRefCounter {
+	public :
+		// == Types.
+		/** The type of the count. */
+		typedef CAtomic::ATOM					LSSTL_COUNT;
+
+
+		// == Functions.
+		/**
+		 * Adds a reference.
+		 *
+		 * \param _cCount The count to increase.
+		 */
+		static LSE_INLINE void LSE_CALL			Increment( LSSTL_COUNT &_cCount ) {
+			CAtomic::InterlockedIncrementRelaxed( _cCount );
+		}
+
+		/**
+		 * Removes a reference.
+		 *
+		 * \param _cCount The count to decrease.
+		 * \return Returns true if that was the last reference.
+		 */
+		static LSE_INLINE LSBOOL LSE_CALL		Decrement( LSSTL_COUNT &_cCount ) {
+			return CAtomic::InterlockedDecrementAcqRel( _cCount ) == 0;
+		}
+
+		/**
+		 * Gets the current count.  The count may be changed by other threads at any time after it is read.
+		 *
+		 * \param _cCount The count to read.
+		 * \return Returns the current count.
+		 */
+		static LSE_INLINE uint32_t LSE_CALL		Get( const LSSTL_COUNT &_cCount ) {
+			return static_cast<uint32_t>(CAtomic::AtomicLoad( _cCount ));
+		}
+	};
+
+}	// namespace lstl
+
+#endif	// __LSTL_REFCOUNTER_H__
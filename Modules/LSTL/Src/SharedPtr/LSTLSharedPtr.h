@@ -9,7 +9,7 @@
  *	You may not take credit for having written this code.
  *
  *
- * Description: A standard shared pointer.
+ * Description: A standard shared pointer.  The object and its reference count share a single allocation.
  */
 
 
@@ -18,6 +18,7 @@
 
 #include "../LSTLib.h"
 #include "../Allocator/LSTLAllocator.h"
+#include "LSTLRefCounter.h"
 
 namespace lstl {
 
@@ -33,9 +34,12 @@ namespace lstl {
 	 * Class CSharedPtr
 	 * \brief A standard shared pointer.
 	 *
-	 * Description: A standard shared pointer.
+	 * Description: A standard shared pointer.  The object and its reference count share a single allocation.
+	 *
+	 * The reference count is maintained by _tCounter.  The default, CRefCounter, is not thread-safe.  Use
+	 *	CAtomicRefCounter for objects that are shared with other threads, such as resources handed to worker threads.
 	 */
-	template <typename _tType>
+	template <typename _tType, typename _tCounter = CRefCounter>
 	class CSharedPtr {
 	public :
 		// == Various constructors.
@@ -45,35 +49,43 @@ namespace lstl {
 		}
 		explicit LSE_CALLCTOR			CSharedPtr( LSSTL_SHARED_PTR /*_spFlag*/ ) {
 			// Create a new object with a 1 reference count.
-			m_pcCont = static_cast<CSharedPtr<_tType>::LSSTL_CONTAINER *>(CMemLib::MNew( NULL, LSSTL_CONTAINER ));
+			m_pcCont = Allocate( NULL );
 			if ( !m_pcCont ) { throw LSSTD_E_OUTOFMEMORY; }
-			m_pcCont->paAllocator = NULL;
-			m_pcCont->ui32RefCount = 1;
-			m_ptDirect = &m_pcCont->tObj;
+			try {
+				m_ptDirect = new( &m_pcCont->tObj ) _tType();
+			}
+			catch ( ... ) {
+				Deallocate( m_pcCont );
+				throw;
+			}
 		}
 		explicit LSE_CALLCTOR			CSharedPtr( CAllocator * _paAllocator ) {
 			// Create a new object with a 1 reference count.
-			m_pcCont = static_cast<CSharedPtr<_tType>::LSSTL_CONTAINER *>(CMemLib::MNew( _paAllocator ? _paAllocator->GetAllocator() : NULL, LSSTL_CONTAINER ));
+			m_pcCont = Allocate( _paAllocator );
 			if ( !m_pcCont ) { throw LSSTD_E_OUTOFMEMORY; }
-			m_pcCont->paAllocator = _paAllocator;
-			m_pcCont->ui32RefCount = 1;
-			m_ptDirect = &m_pcCont->tObj;
+			try {
+				m_ptDirect = new( &m_pcCont->tObj ) _tType();
+			}
+			catch ( ... ) {
+				Deallocate( m_pcCont );
+				throw;
+			}
 		}
-		LSE_CALLCTOR					CSharedPtr( const CSharedPtr<_tType> &_spOther ) {
+		LSE_CALLCTOR					CSharedPtr( const CSharedPtr<_tType, _tCounter> &_spOther ) {
 			// Reference the object to which it points.
 			m_pcCont = _spOther.m_pcCont;
 			m_ptDirect = _spOther.m_ptDirect;
 			if ( m_pcCont ) {
-				++m_pcCont->ui32RefCount;
+				_tCounter::Increment( m_pcCont->cRefCount );
 			}
 		}
 		template <typename _tCastType>	
-		LSE_CALLCTOR					CSharedPtr( const CSharedPtr<_tCastType> &_spOther ) {
+		LSE_CALLCTOR					CSharedPtr( const CSharedPtr<_tCastType, _tCounter> &_spOther ) {
 			// Reference the object to which it points.
 			m_pcCont = const_cast<LSSTL_CONTAINER *>(reinterpret_cast<const LSSTL_CONTAINER *>(_spOther.GetContainer()));
 			m_ptDirect = const_cast<_tType *>(static_cast<const _tType *>(_spOther.Get()));
 			if ( m_pcCont ) {				
-				++m_pcCont->ui32RefCount;
+				_tCounter::Increment( m_pcCont->cRefCount );
 			}
 		}
 		LSE_CALLCTOR					~CSharedPtr() {
@@ -91,7 +103,8 @@ namespace lstl {
 			CAllocator *				paAllocator;
 
 			/** The reference count. */
-			uint32_t					ui32RefCount;
+			typename _tCounter::LSSTL_COUNT
+										cRefCount;
 
 			/** The object we encapsulate. */
 			_tType						tObj;
@@ -105,10 +118,16 @@ namespace lstl {
 		 * \param _spOther The object to copy.
 		 * \return Returns this object after the copy.
 		 */
-		CSharedPtr<_tType> & LSE_CALL	operator = ( const CSharedPtr<_tType> &_spOther ) {
+		CSharedPtr<_tType, _tCounter> & LSE_CALL
+										operator = ( const CSharedPtr<_tType, _tCounter> &_spOther ) {
+			if ( _spOther.m_pcCont == m_pcCont ) {
+				// Already sharing this object.  The reference count does not change.
+				m_ptDirect = _spOther.m_ptDirect;
+				return (*this);
+			}
 			if ( _spOther.m_pcCont ) {
 				// Increase their reference count before decreasing ours.
-				++_spOther.m_pcCont->ui32RefCount;
+				_tCounter::Increment( _spOther.m_pcCont->cRefCount );
 			}
 			Reset();
 			m_pcCont = _spOther.m_pcCont;
@@ -176,14 +195,153 @@ namespace lstl {
 				paAllocator = m_pcCont->paAllocator;
 			}
 			Reset();
-			m_pcCont = static_cast<CSharedPtr<_tType>::LSSTL_CONTAINER *>(CMemLib::MNew( paAllocator ? paAllocator->GetAllocator() : NULL, LSSTL_CONTAINER ));
-			if ( !m_pcCont ) { return false; }
-			m_pcCont->paAllocator = paAllocator;
-			m_pcCont->ui32RefCount = 1;
-			m_ptDirect = &m_pcCont->tObj;
+			LSSTL_CONTAINER * pcCont = Allocate( paAllocator );
+			if ( !pcCont ) { return false; }
+			try {
+				m_ptDirect = new( &pcCont->tObj ) _tType();
+			}
+			catch ( ... ) {
+				Deallocate( pcCont );
+				throw;
+			}
+			m_pcCont = pcCont;
 			return true;
 		}
 
+		/**
+		 * Creates a new object with a 1 reference count, constructed with no parameters.  The object and its
+		 *	reference count are created with a single allocation.  Throws LSSTD_E_OUTOFMEMORY on failure.  If the
+		 *	constructor throws, the allocation is freed and the exception is passed on.
+		 *
+		 * \param _paAllocator The allocator to use, or NULL to use the default allocator.
+		 * \return Returns a shared pointer to the new object.
+		 */
+		static CSharedPtr<_tType, _tCounter> LSE_CALL
+										MakeShared( CAllocator * _paAllocator ) {
+			LSSTL_CONTAINER * pcCont = Allocate( _paAllocator );
+			if ( !pcCont ) { throw LSSTD_E_OUTOFMEMORY; }
+			CSharedPtr<_tType, _tCounter> spRet;
+			try {
+				spRet.m_ptDirect = new( &pcCont->tObj ) _tType();
+			}
+			catch ( ... ) {
+				Deallocate( pcCont );
+				throw;
+			}
+			spRet.m_pcCont = pcCont;
+			return spRet;
+		}
+
+		/**
+		 * Creates a new object with a 1 reference count, constructed with one parameter.  The object and its
+		 *	reference count are created with a single allocation.  Throws LSSTD_E_OUTOFMEMORY on failure.  If the
+		 *	constructor throws, the allocation is freed and the exception is passed on.
+		 *
+		 * \param _paAllocator The allocator to use, or NULL to use the default allocator.
+		 * \param _tA0 The parameter to pass to the object's constructor.
+		 * \return Returns a shared pointer to the new object.
+		 */
+		template <typename _tArg0>
+		static CSharedPtr<_tType, _tCounter> LSE_CALL
+										MakeShared( CAllocator * _paAllocator, const _tArg0 &_tA0 ) {
+			LSSTL_CONTAINER * pcCont = Allocate( _paAllocator );
+			if ( !pcCont ) { throw LSSTD_E_OUTOFMEMORY; }
+			CSharedPtr<_tType, _tCounter> spRet;
+			try {
+				spRet.m_ptDirect = new( &pcCont->tObj ) _tType( _tA0 );
+			}
+			catch ( ... ) {
+				Deallocate( pcCont );
+				throw;
+			}
+			spRet.m_pcCont = pcCont;
+			return spRet;
+		}
+
+		/**
+		 * Creates a new object with a 1 reference count, constructed with two parameters.  The object and its
+		 *	reference count are created with a single allocation.  Throws LSSTD_E_OUTOFMEMORY on failure.  If the
+		 *	constructor throws, the allocation is freed and the exception is passed on.
+		 *
+		 * \param _paAllocator The allocator to use, or NULL to use the default allocator.
+		 * \param _tA0 The first parameter to pass to the object's constructor.
+		 * \param _tA1 The second parameter to pass to the object's constructor.
+		 * \return Returns a shared pointer to the new object.
+		 */
+		template <typename _tArg0, typename _tArg1>
+		static CSharedPtr<_tType, _tCounter> LSE_CALL
+										MakeShared( CAllocator * _paAllocator, const _tArg0 &_tA0, const _tArg1 &_tA1 ) {
+			LSSTL_CONTAINER * pcCont = Allocate( _paAllocator );
+			if ( !pcCont ) { throw LSSTD_E_OUTOFMEMORY; }
+			CSharedPtr<_tType, _tCounter> spRet;
+			try {
+				spRet.m_ptDirect = new( &pcCont->tObj ) _tType( _tA0, _tA1 );
+			}
+			catch ( ... ) {
+				Deallocate( pcCont );
+				throw;
+			}
+			spRet.m_pcCont = pcCont;
+			return spRet;
+		}
+
+		/**
+		 * Creates a new object with a 1 reference count, constructed with three parameters.  The object and its
+		 *	reference count are created with a single allocation.  Throws LSSTD_E_OUTOFMEMORY on failure.  If the
+		 *	constructor throws, the allocation is freed and the exception is passed on.
+		 *
+		 * \param _paAllocator The allocator to use, or NULL to use the default allocator.
+		 * \param _tA0 The first parameter to pass to the object's constructor.
+		 * \param _tA1 The second parameter to pass to the object's constructor.
+		 * \param _tA2 The third parameter to pass to the object's constructor.
+		 * \return Returns a shared pointer to the new object.
+		 */
+		template <typename _tArg0, typename _tArg1, typename _tArg2>
+		static CSharedPtr<_tType, _tCounter> LSE_CALL
+										MakeShared( CAllocator * _paAllocator, const _tArg0 &_tA0, const _tArg1 &_tA1, const _tArg2 &_tA2 ) {
+			LSSTL_CONTAINER * pcCont = Allocate( _paAllocator );
+			if ( !pcCont ) { throw LSSTD_E_OUTOFMEMORY; }
+			CSharedPtr<_tType, _tCounter> spRet;
+			try {
+				spRet.m_ptDirect = new( &pcCont->tObj ) _tType( _tA0, _tA1, _tA2 );
+			}
+			catch ( ... ) {
+				Deallocate( pcCont );
+				throw;
+			}
+			spRet.m_pcCont = pcCont;
+			return spRet;
+		}
+
+		/**
+		 * Creates a new object with a 1 reference count, constructed with four parameters.  The object and its
+		 *	reference count are created with a single allocation.  Throws LSSTD_E_OUTOFMEMORY on failure.  If the
+		 *	constructor throws, the allocation is freed and the exception is passed on.
+		 *
+		 * \param _paAllocator The allocator to use, or NULL to use the default allocator.
+		 * \param _tA0 The first parameter to pass to the object's constructor.
+		 * \param _tA1 The second parameter to pass to the object's constructor.
+		 * \param _tA2 The third parameter to pass to the object's constructor.
+		 * \param _tA3 The fourth parameter to pass to the object's constructor.
+		 * \return Returns a shared pointer to the new object.
+		 */
+		template <typename _tArg0, typename _tArg1, typename _tArg2, typename _tArg3>
+		static CSharedPtr<_tType, _tCounter> LSE_CALL
+										MakeShared( CAllocator * _paAllocator, const _tArg0 &_tA0, const _tArg1 &_tA1, const _tArg2 &_tA2, const _tArg3 &_tA3 ) {
+			LSSTL_CONTAINER * pcCont = Allocate( _paAllocator );
+			if ( !pcCont ) { throw LSSTD_E_OUTOFMEMORY; }
+			CSharedPtr<_tType, _tCounter> spRet;
+			try {
+				spRet.m_ptDirect = new( &pcCont->tObj ) _tType( _tA0, _tA1, _tA2, _tA3 );
+			}
+			catch ( ... ) {
+				Deallocate( pcCont );
+				throw;
+			}
+			spRet.m_pcCont = pcCont;
+			return spRet;
+		}
+
 		/**
 		 * Returns the raw pointer to the object that it shares.
 		 *
@@ -210,7 +368,7 @@ namespace lstl {
 		 *	is invalid.
 		 */
 		uint32_t LSE_CALL				RefCount() const {
-			return m_pcCont ? m_pcCont->ui32RefCount : 0;
+			return m_pcCont ? _tCounter::Get( m_pcCont->cRefCount ) : 0;
 		}
 
 		/**
@@ -228,17 +386,12 @@ namespace lstl {
 		 */
 		void LSE_CALL					Reset() {
 			if ( m_pcCont ) {
-				if ( --m_pcCont->ui32RefCount == 0 ) {
+				if ( _tCounter::Decrement( m_pcCont->cRefCount ) ) {
 					// Delete it.  Use the direct pointer to call the destructor.  This is the only
 					//	way to get virtual destructors to be called properly in the case that this
 					//	object was a cast of a different type of shared pointer.
 					m_ptDirect->~_tType();
-					if ( m_pcCont->paAllocator ) {
-						m_pcCont->paAllocator->Free( m_pcCont );
-					}
-					else {
-						CMemLib::Free( m_pcCont );
-					}
+					Deallocate( m_pcCont );
 				}
 				m_pcCont = NULL;
 				m_ptDirect = NULL;
@@ -251,7 +404,7 @@ namespace lstl {
 		 */
 		void LSE_CALL					Trash() {
 			if ( m_pcCont ) {
-				if ( --m_pcCont->ui32RefCount == 0 ) {
+				if ( _tCounter::Decrement( m_pcCont->cRefCount ) ) {
 					// Trash it.
 					m_ptDirect->Trash();
 				}
@@ -282,6 +435,40 @@ namespace lstl {
 		/** Pointer directly to the object.  Important for cleaning up. */
 		_tType *						m_ptDirect;
 
+
+		// == Functions.
+		/**
+		 * Allocates a container with a 1 reference count.  The object inside it is not constructed.
+		 *
+		 * \param _paAllocator The allocator to use, or NULL to use the default allocator.
+		 * \return Returns the new container or NULL if there is not enough memory.
+		 */
+		static LSSTL_CONTAINER * LSE_CALL
+										Allocate( CAllocator * _paAllocator ) {
+			LSSTL_CONTAINER * pcCont = static_cast<LSSTL_CONTAINER *>(_paAllocator ?
+				_paAllocator->Alloc( sizeof( LSSTL_CONTAINER ) ) :
+				CMemLib::MAlloc( sizeof( LSSTL_CONTAINER ) ));
+			if ( !pcCont ) { return NULL; }
+			pcCont->paAllocator = _paAllocator;
+			pcCont->cRefCount = 1;
+			return pcCont;
+		}
+
+		/**
+		 * Frees a container made by Allocate().  The object inside it must already be destroyed or never have been
+		 *	constructed.
+		 *
+		 * \param _pcCont The container to free.
+		 */
+		static void LSE_CALL			Deallocate( LSSTL_CONTAINER * _pcCont ) {
+			if ( _pcCont->paAllocator ) {
+				_pcCont->paAllocator->Free( _pcCont );
+			}
+			else {
+				CMemLib::Free( _pcCont );
+			}
+		}
+
 	};
 
 }	// namespace lstl
@@ -33,10 +33,13 @@ namespace lstl {
 	 * Class CSVectorCrtp
 	 * \brief A basic vector.
 	 *
-	 * Description: A basic vector.
+	 * Description: A basic vector.  When full, the vector grows by _uAllocSize items, or by _uGrowthPercent
+	 *	percent of its current allocation if that is larger.  With the default _uGrowthPercent of 0, growth is
+	 *	linear, which keeps small vectors small but makes filling a large vector one item at a time quadratic.
+	 *	Use 50 or 100 (1.5x or 2x growth) for vectors that may hold many thousands of items.
 	 */
 	template <typename _tDerivedType,
-		typename _tType, typename _tDataType = uint16_t, unsigned _uAllocSize = 512>
+		typename _tType, typename _tDataType = uint16_t, unsigned _uAllocSize = 512, unsigned _uGrowthPercent = 0>
 	class CSVectorCrtp : protected CVectorBase {
 	public :
 		// == Various constructors.
@@ -45,7 +48,7 @@ namespace lstl {
 			m_tAllocated( 0 ),
 			m_ptData( NULL ) {
 		}
-		LSE_CALLCTOR				CSVectorCrtp( const CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize> &_vcSource ) :
+		LSE_CALLCTOR				CSVectorCrtp( const CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vcSource ) :
 			m_tLen( 0 ),
 			m_tAllocated( 0 ),
 			m_ptData( NULL ) {
@@ -86,8 +89,8 @@ namespace lstl {
 		 * \param _vcOther The source vector.
 		 * \return Returns this vector, which contains a copy of every item in the source vector.
 		 */
-		CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize> & LSE_CALL
-									operator = ( const CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize> &_vcOther ) {
+		CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize, _uGrowthPercent> & LSE_CALL
+									operator = ( const CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vcOther ) {
 			// Clear every item in this list.
 			static_cast<_tDerivedType *>(this)->ResetNoDealloc();
 
@@ -108,8 +111,8 @@ namespace lstl {
 		 * \param _vcOther The source vector.
 		 * \return Returns this vector, which contains a copy of every item in the source vector.
 		 */
-		CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize> & LSE_CALL
-									operator = ( const CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize> &&_vcOther ) {
+		CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize, _uGrowthPercent> & LSE_CALL
+									operator = ( const CSVectorCrtp<_tDerivedType, _tType, _tDataType, _uAllocSize, _uGrowthPercent> &&_vcOther ) {
 			// Clear every item in this list.
 			static_cast<_tDerivedType *>(this)->Reset();
 			m_ptData = _vcOther.m_ptData;
@@ -168,7 +171,7 @@ namespace lstl {
 		 * \return Returns false if the memory could not be allocated.  In this case, the list is not modified.
 		 */
 		LSBOOL LSE_CALL				Allocate( uint32_t _ui32Total ) {
-			if ( m_tLen == static_cast<_tDataType>(_ui32Total) ) {
+			if ( m_tAllocated == static_cast<_tDataType>(_ui32Total) ) {
 				return true;
 			}
 
@@ -245,10 +248,7 @@ namespace lstl {
 		LSBOOL LSE_CALL				Push( const _tType &_tVal ) {
 			// Do we need to allocate more space?
 			if ( m_tLen == m_tAllocated ) {
-				// Overflow checking.
-				_tDataType tNewTotal = static_cast<_tDataType>(m_tAllocated + _uAllocSize);
-				assert( tNewTotal > m_tAllocated );
-				if ( !static_cast<_tDerivedType *>(this)->Allocate( tNewTotal ) ) { return false; }
+				if ( !Grow( static_cast<uint64_t>(m_tLen) + 1 ) ) { return false; }
 			}
 			Construct( m_tLen );
 			m_ptData[m_tLen++] = _tVal;
@@ -286,10 +286,7 @@ namespace lstl {
 		LSBOOL LSE_CALL				Insert( const _tType &_tVal, uint32_t _ui32Index ) {
 			assert( _ui32Index <= m_tLen );
 			if ( m_tLen == m_tAllocated ) {
-				// Overflow checking.
-				_tDataType tNewTotal = m_tAllocated + _uAllocSize;
-				assert( tNewTotal > m_tAllocated );
-				if ( !static_cast<_tDerivedType *>(this)->Allocate( tNewTotal ) ) { return false; }
+				if ( !Grow( static_cast<uint64_t>(m_tLen) + 1 ) ) { return false; }
 			}
 
 			// Move other items.
@@ -302,22 +299,55 @@ namespace lstl {
 		}
 
 		/**
-		 * Append an array of values to the end of the vector.
+		 * Insert an array of values.  The values must not be inside this vector.
+		 *
+		 * \param _ptValues The values to insert.
+		 * \param _ui32Total The number of values to insert.
+		 * \param _ui32Index The index where the values are to be inserted.
+		 * \return Returns false if memory could not be allocated.  In this case, the list is not modified.
+		 */
+		LSBOOL LSE_CALL				InsertRange( const _tType * _ptValues, uint32_t _ui32Total, uint32_t _ui32Index ) {
+			assert( _ui32Index <= m_tLen );
+			if ( !Grow( static_cast<uint64_t>(m_tLen) + _ui32Total ) ) { return false; }
+
+			// Move other items.
+			CStd::MemMove( &m_ptData[_ui32Index+_ui32Total], &m_ptData[_ui32Index], sizeof( _tType ) * (m_tLen - _ui32Index) );
+			CStd::MemCpy( &m_ptData[_ui32Index], _ptValues, sizeof( _tType ) * _ui32Total );
+			m_tLen = static_cast<_tDataType>(m_tLen + _ui32Total);
+			return true;
+		}
+
+		/**
+		 * Append an array of values to the end of the vector.  The values must not be inside this vector.
 		 *
 		 * \param _ptValues The values to append.
 		 * \param _tTotal The number of values to append.
 		 * \return Returns true if there was enough memory to perform the operation.
 		 */
 		LSBOOL LSE_CALL				Append( const _tType * _ptValues, _tDataType _tTotal ) {
-			uintptr_t uiptrNewLen = m_tLen + _tTotal;
-			if ( uiptrNewLen >= m_tAllocated ) {
-				if ( !static_cast<_tDerivedType *>(this)->Allocate( static_cast<_tDataType>(uiptrNewLen + _uAllocSize) ) ) { return false; }
-			}
+			if ( !Grow( static_cast<uint64_t>(m_tLen) + _tTotal ) ) { return false; }
 			CStd::MemCpy( &m_ptData[m_tLen], _ptValues, sizeof( _tType ) * _tTotal );
 			m_tLen += _tTotal;
 			return true;
 		}
 
+		/**
+		 * Resize the array without constructing new items.  Only vectors of plain data types leave new items
+		 *	uninitialized; other vectors construct them as Resize() does.  The allocation grows as it does when
+		 *	pushing but does not shrink.
+		 *
+		 * \param _ui32Total The new total of items in the array.
+		 * \return Returns false if the memory could not be allocated.  In this case, the list is not modified.
+		 */
+		LSBOOL LSE_CALL				ResizeUninitialized( uint32_t _ui32Total ) {
+			if ( !Grow( _ui32Total ) ) { return false; }
+			while ( m_tLen > _ui32Total ) {
+				Destroy( --m_tLen );
+			}
+			m_tLen = static_cast<_tDataType>(_ui32Total);
+			return true;
+		}
+
 		/**
 		 * Removes an element.
 		 *
@@ -394,7 +424,17 @@ namespace lstl {
 		 * Snap it to the size of the list.  This removes allocated space beyond the actual length of the array.
 		 */
 		void LSE_CALL				Snap() {
-			static_cast<_tDerivedType *>(this)->Allocate( m_tLen );
+			ShrinkToFit();
+		}
+
+		/**
+		 * Removes allocated space beyond the actual length of the array.
+		 *
+		 * \return Returns false if the memory could not be reallocated.  In this case, the list is not modified.
+		 */
+		LSBOOL LSE_CALL				ShrinkToFit() {
+			if ( m_tAllocated == m_tLen ) { return true; }
+			return static_cast<_tDerivedType *>(this)->Allocate( m_tLen );
 		}
 
 
@@ -418,6 +458,22 @@ namespace lstl {
 
 
 		// == Functions.
+		/**
+		 * Makes room for at least the given number of items, growing by _uAllocSize items or by _uGrowthPercent
+		 *	percent of the current allocation, whichever is more.
+		 *
+		 * \param _ui64Total The number of items for which to make room.
+		 * \return Returns false if the memory could not be allocated or _tDataType cannot count that many items.
+		 */
+		LSBOOL LSE_CALL				Grow( uint64_t _ui64Total ) {
+			if ( _ui64Total <= m_tAllocated ) { return true; }
+			const uint64_t ui64Max = static_cast<_tDataType>(~static_cast<_tDataType>(0));
+			if ( _ui64Total > ui64Max ) { return false; }
+			uint64_t ui64Step = CStd::Max<uint64_t>( _uAllocSize, static_cast<uint64_t>(m_tAllocated) * _uGrowthPercent / 100 );
+			uint64_t ui64New = CStd::Min<uint64_t>( CStd::Max<uint64_t>( _ui64Total, m_tAllocated + ui64Step ), ui64Max );
+			return static_cast<_tDerivedType *>(this)->Allocate( static_cast<uint32_t>(ui64New) );
+		}
+
 		/**
 		 * Secret way of constructing items.
 		 *
@@ -14,7 +14,8 @@
  *	for arrays of limited length but few bytes vs. arrays of large lengths but requiring
  *	more memory.
  * Additionally, the vectors save valuable space by allocating linearly as it grows rather
- *	than doubling in size each time.  The amount by which it grows can be specified.
+ *	than doubling in size each time.  The amount by which it grows can be specified, and vectors
+ *	that grow large can instead grow by a percentage of their size (_uGrowthPercent).
  * This vector also cleans up after itself when removing items from the list.  When the
  *	list is less than half the allocated length the allocation is adjusted to half of what
  *	it is.
@@ -47,8 +48,8 @@ namespace lstl {
 	 *
 	 * Description: A simple vector.
 	 */
-	template <typename _tType, typename _tDataType = uint16_t, unsigned _uAllocSize = 512>
-	class CSVectorPoD : public CSVectorCrtp<CSVectorPoD<_tType, _tDataType, _uAllocSize>, _tType, _tDataType, _uAllocSize> {
+	template <typename _tType, typename _tDataType = uint16_t, unsigned _uAllocSize = 512, unsigned _uGrowthPercent = 0>
+	class CSVectorPoD : public CSVectorCrtp<CSVectorPoD<_tType, _tDataType, _uAllocSize, _uGrowthPercent>, _tType, _tDataType, _uAllocSize, _uGrowthPercent> {
 	public :
 		// == Various constructors.
 		LSE_CALLCTOR				CSVectorPoD() {
@@ -66,7 +67,7 @@ namespace lstl {
 		// == Members.
 		
 	private :
-		typedef CSVectorCrtp<CSVectorPoD<_tType, _tDataType, _uAllocSize>, _tType, _tDataType, _uAllocSize>
+		typedef CSVectorCrtp<CSVectorPoD<_tType, _tDataType, _uAllocSize, _uGrowthPercent>, _tType, _tDataType, _uAllocSize, _uGrowthPercent>
 									Parent;
 	};
 
@@ -29,8 +29,8 @@ namespace lstl {
 	 * Description: Extends the CSVectorCrtp class to mke it work properly with types that are not plain data.
 	 *	Use this for types that have a complicated destructor, copy constructor, and copy assignment operator.
 	 */
-	template <typename _tType, typename _tDataType = uint16_t, unsigned _uAllocSize = 512>
-	class CVector : public CSVectorCrtp<CVector<_tType, _tDataType, _uAllocSize>, _tType, _tDataType, _uAllocSize> {
+	template <typename _tType, typename _tDataType = uint16_t, unsigned _uAllocSize = 512, unsigned _uGrowthPercent = 0>
+	class CVector : public CSVectorCrtp<CVector<_tType, _tDataType, _uAllocSize, _uGrowthPercent>, _tType, _tDataType, _uAllocSize, _uGrowthPercent> {
 	public :
 		// == Various constructors.
 		LSE_CALLCTOR							CVector() :
@@ -53,7 +53,7 @@ namespace lstl {
 			}
 			Allocate( _tTotal );
 		}
-		LSE_CALLCTOR							CVector( const CVector<_tType, _tDataType, _uAllocSize> &_vOther, CAllocator * _paAllocator = NULL ) :
+		LSE_CALLCTOR							CVector( const CVector<_tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vOther, CAllocator * _paAllocator = NULL ) :
 			m_paOurAllocator( _paAllocator ) {
 			if ( !m_paOurAllocator ) {
 				m_paOurAllocator = Parent::m_paDefaultAllocator;
@@ -148,10 +148,7 @@ namespace lstl {
 
 			// Now we know we are inserting in the middle somewhere.
 			if ( Parent::m_tLen == Parent::m_tAllocated ) {
-				// Overflow checking.
-				_tDataType tNewTotal = Parent::m_tAllocated + _uAllocSize;
-				assert( tNewTotal > Parent::m_tAllocated );
-				if ( !Allocate( tNewTotal ) ) { return false; }
+				if ( !Parent::Grow( static_cast<uint64_t>(Parent::m_tLen) + 1 ) ) { return false; }
 			}
 
 			// Move other items.
@@ -174,7 +171,44 @@ namespace lstl {
 		}
 
 		/**
-		 * Append an array of values to the end of the vector.
+		 * Insert an array of values.  The values must not be inside this vector.
+		 *
+		 * \param _ptValues The values to insert.
+		 * \param _ui32Total The number of values to insert.
+		 * \param _ui32Index The index where the values are to be inserted.
+		 * \return Returns false if memory could not be allocated.  In this case, the list is not modified.
+		 */
+		LSBOOL LSE_CALL							InsertRange( const _tType * _ptValues, uint32_t _ui32Total, uint32_t _ui32Index ) {
+			assert( _ui32Index <= Parent::m_tLen );
+			if ( !Parent::Grow( static_cast<uint64_t>(Parent::m_tLen) + _ui32Total ) ) { return false; }
+
+			// Since this is not a PoD handler, we cannot simply move memory.  Items landing past the old end are
+			//	copy-constructed and the rest are assigned, moving from the back so nothing is overwritten early.
+			uint32_t ui32OldLen = Parent::m_tLen;
+			uint32_t ui32NewLen = ui32OldLen + _ui32Total;
+			for ( uint32_t I = ui32NewLen; I-- > _ui32Index + _ui32Total; ) {
+				if ( I >= ui32OldLen ) {
+					new( &Parent::m_ptData[I] ) _tType( Parent::m_ptData[I-_ui32Total] );
+				}
+				else {
+					Parent::m_ptData[I] = Parent::m_ptData[I-_ui32Total];
+				}
+			}
+			for ( uint32_t I = 0; I < _ui32Total; ++I ) {
+				uint32_t ui32Dst = _ui32Index + I;
+				if ( ui32Dst >= ui32OldLen ) {
+					new( &Parent::m_ptData[ui32Dst] ) _tType( _ptValues[I] );
+				}
+				else {
+					Parent::m_ptData[ui32Dst] = _ptValues[I];
+				}
+			}
+			Parent::m_tLen = static_cast<_tDataType>(ui32NewLen);
+			return true;
+		}
+
+		/**
+		 * Append an array of values to the end of the vector.  The values must not be inside this vector.
 		 *
 		 * \param _ptValues The values to append.
 		 * \param _tTotal The number of values to append.
@@ -182,9 +216,7 @@ namespace lstl {
 		 */
 		LSBOOL LSE_CALL							Append( const _tType * _ptValues, _tDataType _tTotal ) {
 			uintptr_t uiptrNewLen = Parent::m_tLen + _tTotal;
-			if ( uiptrNewLen >= Parent::m_tAllocated ) {
-				if ( !Allocate( static_cast<_tDataType>(uiptrNewLen + _uAllocSize) ) ) { return false; }
-			}
+			if ( !Parent::Grow( uiptrNewLen ) ) { return false; }
 			for ( uintptr_t I = Parent::m_tLen; I < uiptrNewLen; ++I ) {
 				new( &Parent::m_ptData[I] ) _tType( (*_ptValues++) );
 			}
@@ -192,6 +224,22 @@ namespace lstl {
 			return true;
 		}
 
+		/**
+		 * Resize the array.  Since the items are not plain data, new items are constructed as they are by Resize(),
+		 *	but the allocation grows as it does when pushing and does not shrink.
+		 *
+		 * \param _ui32Total The new total of items in the array.
+		 * \return Returns false if the memory could not be allocated.  In this case, the list is not modified.
+		 */
+		LSBOOL LSE_CALL							ResizeUninitialized( uint32_t _ui32Total ) {
+			if ( !Parent::ResizeUninitialized( Parent::m_tLen < _ui32Total ? Parent::m_tLen : _ui32Total ) ) { return false; }
+			if ( !Parent::Grow( _ui32Total ) ) { return false; }
+			for ( ; Parent::m_tLen < _ui32Total; ++Parent::m_tLen ) {
+				Parent::Construct( Parent::m_tLen );
+			}
+			return true;
+		}
+
 		/**
 		 * Removes elements without reallocating.
 		 *
@@ -258,7 +306,7 @@ namespace lstl {
 		CAllocator *							m_paOurAllocator;
 
 	private :
-		typedef CSVectorCrtp<CVector<_tType, _tDataType, _uAllocSize>, _tType, _tDataType, _uAllocSize>
+		typedef CSVectorCrtp<CVector<_tType, _tDataType, _uAllocSize, _uGrowthPercent>, _tType, _tDataType, _uAllocSize, _uGrowthPercent>
 			Parent;
 	};
 
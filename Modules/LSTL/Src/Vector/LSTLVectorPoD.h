@@ -31,8 +31,8 @@ namespace lstl {
 	 *	use the allocator the Allocate() and Reset() functions are replaced.  This vector should be used only for
 	 *	plain data types.
 	 */
-	template <typename _tType, typename _tDataType = uint16_t, unsigned _uAllocSize = 512>
-	class CVectorPoD : public CSVectorCrtp<CVectorPoD<_tType, _tDataType, _uAllocSize>, _tType, _tDataType, _uAllocSize> {
+	template <typename _tType, typename _tDataType = uint16_t, unsigned _uAllocSize = 512, unsigned _uGrowthPercent = 0>
+	class CVectorPoD : public CSVectorCrtp<CVectorPoD<_tType, _tDataType, _uAllocSize, _uGrowthPercent>, _tType, _tDataType, _uAllocSize, _uGrowthPercent> {
 	public :
 		// == Various constructors.
 		LSE_CALLCTOR							CVectorPoD() :
@@ -55,7 +55,7 @@ namespace lstl {
 			}
 			Allocate( _tTotal );
 		}
-		LSE_CALLCTOR							CVectorPoD( const CVectorPoD<_tType, _tDataType, _uAllocSize> &_vOther, CAllocator * _paAllocator = NULL ) :
+		LSE_CALLCTOR							CVectorPoD( const CVectorPoD<_tType, _tDataType, _uAllocSize, _uGrowthPercent> &_vOther, CAllocator * _paAllocator = NULL ) :
 			m_paOurAllocator( _paAllocator ) {
 			if ( !m_paOurAllocator ) {
 				m_paOurAllocator = Parent::m_paDefaultAllocator;
@@ -146,7 +146,7 @@ namespace lstl {
 		CAllocator *							m_paOurAllocator;
 
 	private :
-		typedef CSVectorCrtp<CVectorPoD<_tType, _tDataType, _uAllocSize>, _tType, _tDataType, _uAllocSize>
+		typedef CSVectorCrtp<CVectorPoD<_tType, _tDataType, _uAllocSize, _uGrowthPercent>, _tType, _tDataType, _uAllocSize, _uGrowthPercent>
 			Parent;
 	};
 
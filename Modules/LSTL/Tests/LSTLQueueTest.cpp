@@ -0,0 +1,325 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: Stress test for CSpscRingBuffer, CMpmcQueue and CMpscQueue.  Producer and consumer threads hammer small
+ *	queues (so that they are constantly full, empty and wrapping) with single and batched calls, and every item is
+ *	checked to arrive exactly once and, for each producer, in the order it was pushed.  Build it with LSTL,
+ *	LSThreadLib and LSStandardLib.  Returns 0 if all tests pass.
+ */
+
+#include "LSTLib.h"
+#include "LSHThreadLib.h"
+#include "Queue/LSTLMpmcQueue.h"
+#include "Queue/LSTLMpscQueue.h"
+#include "RingBuffer/LSTLSpscRingBuffer.h"
+#include <cstdio>
+
+using namespace ::lsh;
+using namespace ::lstl;
+
+/** The number of producers and consumers. */
+#define LSTL_THREADS				4
+
+/** The number of items each producer pushes. */
+#define LSTL_ITEMS					100000
+
+/** The largest batch passed to PushBatch() and PopBatch(). */
+#define LSTL_BATCH					7
+
+/** An item in the MPSC queue. */
+typedef struct LSTL_TEST_NODE : public CMpscNode {
+	/** The producer that pushed the node. */
+	uint32_t						ui32Producer;
+
+	/** The order in which the producer pushed the node. */
+	uint32_t						ui32Seq;
+} * LPLSTL_TEST_NODE, * const LPCLSTL_TEST_NODE;
+
+/** Set when the threads can start. */
+static CAtomic::ATOM g_aGo = 0;
+
+/** The number of items popped so far by all consumers. */
+static CAtomic::ATOM g_aPopped = 0;
+
+/** How many times each item has been popped. */
+static CAtomic::ATOM g_aSeen[LSTL_THREADS][LSTL_ITEMS];
+
+/** The number of items that arrived out of order. */
+static CAtomic::ATOM g_aOutOfOrder = 0;
+
+/** The queues being tested.  Small sizes keep them full, empty and wrapping. */
+static CSpscRingBuffer<uint32_t, 64> g_srbSpsc;
+static CMpmcQueue<uint32_t, 64> g_mqMpmc;
+static CMpscQueue<LSTL_TEST_NODE> g_mqMpsc;
+
+/** The nodes pushed to the MPSC queue. */
+static LSTL_TEST_NODE g_tnNodes[LSTL_THREADS][LSTL_ITEMS];
+
+/**
+ * Waits until g_aGo is set so that all threads start at once.
+ */
+static void LSE_CALL WaitForGo() {
+	while ( !CAtomic::AtomicLoad( g_aGo ) ) { CStd::Sleep( 0 ); }
+}
+
+/**
+ * Records a popped item and checks that it follows the previous item from the same producer.
+ *
+ * \param _ui32Producer The producer that pushed the item.
+ * \param _ui32Seq The order in which the producer pushed the item.
+ * \param _pi32Last The last sequence number seen from each producer by this consumer.
+ */
+static void LSE_CALL Record( uint32_t _ui32Producer, uint32_t _ui32Seq, int32_t * _pi32Last ) {
+	if ( _ui32Producer >= LSTL_THREADS || _ui32Seq >= LSTL_ITEMS ) {
+		CAtomic::InterlockedIncrement( g_aOutOfOrder );
+		return;
+	}
+	if ( static_cast<int32_t>(_ui32Seq) <= _pi32Last[_ui32Producer] ) {
+		CAtomic::InterlockedIncrement( g_aOutOfOrder );
+	}
+	_pi32Last[_ui32Producer] = static_cast<int32_t>(_ui32Seq);
+	CAtomic::InterlockedIncrement( g_aSeen[_ui32Producer][_ui32Seq] );
+}
+
+/**
+ * Resets the counters between tests.
+ */
+static void LSE_CALL Reset() {
+	g_aGo = 0;
+	g_aPopped = 0;
+	g_aOutOfOrder = 0;
+	for ( uint32_t I = 0; I < LSTL_THREADS; ++I ) {
+		for ( uint32_t J = 0; J < LSTL_ITEMS; ++J ) { g_aSeen[I][J] = 0; }
+	}
+}
+
+/**
+ * Checks that every item from the given number of producers was popped exactly once and in order.
+ *
+ * \param _pcName Name of the test, for printing.
+ * \param _ui32Producers The number of producers.
+ * \return Returns the number of failures.
+ */
+static uint32_t LSE_CALL Check( const char * _pcName, uint32_t _ui32Producers ) {
+	uint32_t ui32Fails = 0;
+	for ( uint32_t I = 0; I < _ui32Producers; ++I ) {
+		for ( uint32_t J = 0; J < LSTL_ITEMS; ++J ) {
+			if ( g_aSeen[I][J] != 1 ) {
+				if ( ui32Fails++ < 10 ) {
+					::printf( "FAILED: %s: item %u from producer %u popped %d times.\r\n", _pcName, J, I, g_aSeen[I][J] );
+				}
+			}
+		}
+	}
+	if ( g_aOutOfOrder ) {
+		::printf( "FAILED: %s: %d items out of order.\r\n", _pcName, g_aOutOfOrder );
+		++ui32Fails;
+	}
+	return ui32Fails;
+}
+
+/**
+ * Pushes every item of one producer to the SPSC ring buffer, alternating single and batched pushes.
+ *
+ * \param _lpParameter Unused.
+ * \return Returns 0.
+ */
+static uint32_t LSH_CALL SpscProducer( void * /*_lpParameter*/ ) {
+	WaitForGo();
+	uint32_t ui32Batch[LSTL_BATCH];
+	for ( uint32_t I = 0; I < LSTL_ITEMS; ) {
+		if ( I & 1 ) {
+			if ( g_srbSpsc.Push( I ) ) { ++I; }
+			continue;
+		}
+		uint32_t ui32Total = CStd::Min<uint32_t>( I % LSTL_BATCH + 1, LSTL_ITEMS - I );
+		for ( uint32_t J = 0; J < ui32Total; ++J ) { ui32Batch[J] = I + J; }
+		I += g_srbSpsc.PushBatch( ui32Batch, ui32Total );
+	}
+	return 0;
+}
+
+/**
+ * Pushes every item of one producer to the MPMC queue, alternating single and batched pushes.
+ *
+ * \param _lpParameter The index of the producer.
+ * \return Returns 0.
+ */
+static uint32_t LSH_CALL MpmcProducer( void * _lpParameter ) {
+	uint32_t ui32Producer = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(_lpParameter));
+	WaitForGo();
+	uint32_t ui32Batch[LSTL_BATCH];
+	for ( uint32_t I = 0; I < LSTL_ITEMS; ) {
+		if ( I & 1 ) {
+			if ( g_mqMpmc.Push( (ui32Producer << 24) | I ) ) { ++I; }
+			else { CStd::Sleep( 0 ); }
+			continue;
+		}
+		uint32_t ui32Total = CStd::Min<uint32_t>( I % LSTL_BATCH + 1, LSTL_ITEMS - I );
+		for ( uint32_t J = 0; J < ui32Total; ++J ) { ui32Batch[J] = (ui32Producer << 24) | (I + J); }
+		uint32_t ui32Pushed = g_mqMpmc.PushBatch( ui32Batch, ui32Total );
+		if ( !ui32Pushed ) { CStd::Sleep( 0 ); }
+		I += ui32Pushed;
+	}
+	return 0;
+}
+
+/**
+ * Pops items from the MPMC queue until all producers' items have been popped, alternating single and batched pops.
+ *
+ * \param _lpParameter Unused.
+ * \return Returns 0.
+ */
+static uint32_t LSH_CALL MpmcConsumer( void * /*_lpParameter*/ ) {
+	int32_t i32Last[LSTL_THREADS] = { -1, -1, -1, -1 };
+	WaitForGo();
+	uint32_t ui32Batch[LSTL_BATCH];
+	for ( uint32_t I = 0; CAtomic::AtomicLoad( g_aPopped ) < LSTL_THREADS * LSTL_ITEMS; ++I ) {
+		uint32_t ui32Total = (I & 1) ? g_mqMpmc.PopBatch( ui32Batch, I % LSTL_BATCH + 1 ) : g_mqMpmc.Pop( ui32Batch[0] );
+		if ( !ui32Total ) {
+			CStd::Sleep( 0 );
+			continue;
+		}
+		for ( uint32_t J = 0; J < ui32Total; ++J ) {
+			Record( ui32Batch[J] >> 24, ui32Batch[J] & 0xFFFFFF, i32Last );
+		}
+		CAtomic::InterlockedAdd( g_aPopped, static_cast<CAtomic::ATOM_OP>(ui32Total) );
+	}
+	return 0;
+}
+
+/**
+ * Pushes every node of one producer to the MPSC queue, alternating single and batched pushes.
+ *
+ * \param _lpParameter The index of the producer.
+ * \return Returns 0.
+ */
+static uint32_t LSH_CALL MpscProducer( void * _lpParameter ) {
+	uint32_t ui32Producer = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(_lpParameter));
+	WaitForGo();
+	LSTL_TEST_NODE * ptnBatch[LSTL_BATCH];
+	for ( uint32_t I = 0; I < LSTL_ITEMS; ) {
+		if ( I & 1 ) {
+			g_mqMpsc.Push( &g_tnNodes[ui32Producer][I++] );
+			continue;
+		}
+		uint32_t ui32Total = CStd::Min<uint32_t>( I % LSTL_BATCH + 1, LSTL_ITEMS - I );
+		for ( uint32_t J = 0; J < ui32Total; ++J ) { ptnBatch[J] = &g_tnNodes[ui32Producer][I+J]; }
+		g_mqMpsc.PushBatch( ptnBatch, ui32Total );
+		I += ui32Total;
+	}
+	return 0;
+}
+
+/**
+ * Runs producer threads against consumers and checks the results.
+ *
+ * \param _pcName Name of the test, for printing.
+ * \param _pfProducer The producer thread function.
+ * \param _ui32Producers The number of producers.
+ * \param _pfConsumer The consumer thread function, or NULL if the calling thread consumes through _pfConsume.
+ * \param _ui32Consumers The number of consumer threads.
+ * \param _pfConsume If not NULL, called on this thread once the threads have started.
+ * \return Returns the number of failures.
+ */
+static uint32_t LSE_CALL Run( const char * _pcName, LSH_THREAD_PROC _pfProducer, uint32_t _ui32Producers,
+	LSH_THREAD_PROC _pfConsumer, uint32_t _ui32Consumers, void (LSE_CALL * _pfConsume)() ) {
+	Reset();
+	LSH_THREAD tThreads[LSTL_THREADS*2];
+	uint32_t ui32Threads = 0;
+	for ( uint32_t I = 0; I < _ui32Producers + _ui32Consumers; ++I ) {
+		LSH_THREAD_PROC pfProc = I < _ui32Producers ? _pfProducer : _pfConsumer;
+		if ( !CThreadLib::CreateThread( pfProc, reinterpret_cast<void *>(static_cast<uintptr_t>(I)), &tThreads[ui32Threads] ) ) {
+			::printf( "FAILED: %s: could not create a thread.\r\n", _pcName );
+			CAtomic::AtomicStore( g_aGo, 1 );
+			// The threads already created cannot finish without their partners, so they are left running.
+			return 1;
+		}
+		++ui32Threads;
+	}
+	CAtomic::AtomicStore( g_aGo, 1 );
+	if ( _pfConsume ) { _pfConsume(); }
+	for ( uint32_t I = 0; I < ui32Threads; ++I ) {
+		CThreadLib::WaitForThread( tThreads[I], NULL );
+		CThreadLib::CloseThread( tThreads[I] );
+	}
+	return Check( _pcName, _ui32Producers );
+}
+
+/**
+ * Pops every item from the SPSC ring buffer on the calling thread, alternating single and batched pops.
+ */
+static void LSE_CALL SpscConsume() {
+	int32_t i32Last[LSTL_THREADS] = { -1, -1, -1, -1 };
+	uint32_t ui32Batch[LSTL_BATCH];
+	for ( uint32_t I = 0, ui32Popped = 0; ui32Popped < LSTL_ITEMS; ++I ) {
+		uint32_t ui32Total = (I & 1) ? g_srbSpsc.PopBatch( ui32Batch, I % LSTL_BATCH + 1 ) : g_srbSpsc.Pop( ui32Batch[0] );
+		if ( !ui32Total ) {
+			CStd::Sleep( 0 );
+			continue;
+		}
+		for ( uint32_t J = 0; J < ui32Total; ++J ) { Record( 0, ui32Batch[J], i32Last ); }
+		ui32Popped += ui32Total;
+	}
+	if ( g_srbSpsc.Size() ) {
+		::printf( "FAILED: SPSC: %u items left after the last pop.\r\n", g_srbSpsc.Size() );
+		CAtomic::InterlockedIncrement( g_aOutOfOrder );
+	}
+}
+
+/**
+ * Pops every node from the MPSC queue on the calling thread, alternating single and batched pops.
+ */
+static void LSE_CALL MpscConsume() {
+	int32_t i32Last[LSTL_THREADS] = { -1, -1, -1, -1 };
+	LSTL_TEST_NODE * ptnBatch[LSTL_BATCH];
+	for ( uint32_t I = 0, ui32Popped = 0; ui32Popped < LSTL_THREADS * LSTL_ITEMS; ++I ) {
+		uint32_t ui32Total = 0;
+		if ( I & 1 ) { ui32Total = g_mqMpsc.PopBatch( ptnBatch, I % LSTL_BATCH + 1 ); }
+		else if ( (ptnBatch[0] = g_mqMpsc.Pop()) != NULL ) { ui32Total = 1; }
+		if ( !ui32Total ) {
+			CStd::Sleep( 0 );
+			continue;
+		}
+		for ( uint32_t J = 0; J < ui32Total; ++J ) { Record( ptnBatch[J]->ui32Producer, ptnBatch[J]->ui32Seq, i32Last ); }
+		ui32Popped += ui32Total;
+	}
+	if ( !g_mqMpsc.Empty() ) {
+		::printf( "FAILED: MPSC: items left after the last pop.\r\n" );
+		CAtomic::InterlockedIncrement( g_aOutOfOrder );
+	}
+}
+
+/**
+ * The main entrypoint for this program.
+ *
+ * \return Returns 0 if all tests pass, 1 otherwise.
+ */
+int LSE_CCALL main() {
+	for ( uint32_t I = 0; I < LSTL_THREADS; ++I ) {
+		for ( uint32_t J = 0; J < LSTL_ITEMS; ++J ) {
+			g_tnNodes[I][J].ui32Producer = I;
+			g_tnNodes[I][J].ui32Seq = J;
+		}
+	}
+
+	uint32_t ui32Fails = 0;
+	ui32Fails += Run( "SPSC", SpscProducer, 1, NULL, 0, SpscConsume );
+	ui32Fails += Run( "MPMC", MpmcProducer, LSTL_THREADS, MpmcConsumer, LSTL_THREADS, NULL );
+	ui32Fails += Run( "MPSC", MpscProducer, LSTL_THREADS, NULL, 0, MpscConsume );
+
+	if ( ui32Fails ) {
+		::printf( "%u failures.\r\n", ui32Fails );
+		return 1;
+	}
+	::printf( "All tests passed.\r\n" );
+	return 0;
+}
@@ -25,7 +25,49 @@
 
 #include "LSHCriticalSection.h"
 
+#ifdef LSE_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif	// #ifdef LSE_LINUX
+
 
 namespace lsh {
 
+#ifdef LSE_LINUX
+	// == Functions.
+	/**
+	 * The contended path of Lock().  Spins briefly and then sleeps on the futex until the lock is acquired.
+	 *
+	 * \param _i32State The futex value observed by the failed fast-path compare-and-exchange.
+	 */
+	void LSE_CALL CCriticalSection::LockSlow( int32_t _i32State ) {
+		// Most critical sections in the engine are held for very short times, so a short spin usually avoids the system call.
+		for ( uint32_t I = 0; I < 100 && _i32State == 1; ++I ) {
+#if defined( __i386__ ) || defined( __x86_64__ )
+			__builtin_ia32_pause();
+#endif	// #if defined( __i386__ ) || defined( __x86_64__ )
+			_i32State = 0;
+			if ( __atomic_compare_exchange_n( &m_i32Futex, &_i32State, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) ) { return; }
+		}
+
+		// Mark the lock as contended and sleep until it is released.  Once contended, the lock is always taken in the
+		//	contended state because there is no way to know if other threads are still sleeping.
+		if ( _i32State != 2 ) {
+			_i32State = __atomic_exchange_n( &m_i32Futex, 2, __ATOMIC_ACQUIRE );
+		}
+		while ( _i32State != 0 ) {
+			::syscall( SYS_futex, &m_i32Futex, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0 );
+			_i32State = __atomic_exchange_n( &m_i32Futex, 2, __ATOMIC_ACQUIRE );
+		}
+	}
+
+	/**
+	 * Wakes one thread sleeping on the futex.
+	 */
+	void LSE_CALL CCriticalSection::WakeOne() {
+		::syscall( SYS_futex, &m_i32Futex, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+	}
+#endif	// #ifdef LSE_LINUX
+
 }	// namespace lsh
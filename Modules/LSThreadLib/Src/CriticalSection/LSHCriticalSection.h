@@ -121,6 +121,29 @@ namespace lsh {
 		CRITICAL_SECTION							m_csCrit;
 #elif defined( LSE_MAC )
 		pthread_mutex_t								m_ptmCrit;
+#elif defined( LSE_LINUX )
+		/** The futex word.  0 = unlocked, 1 = locked, 2 = locked and other threads may be waiting. */
+		int32_t										m_i32Futex;
+
+		/** The thread that owns the lock, or 0.  Only ever compared against the calling thread. */
+		pthread_t									m_tOwner;
+
+		/** Number of times the owning thread has locked the critical section. */
+		uint32_t									m_ui32Recursion;
+
+
+		// == Functions.
+		/**
+		 * The contended path of Lock().  Spins briefly and then sleeps on the futex until the lock is acquired.
+		 *
+		 * \param _i32State The futex value observed by the failed fast-path compare-and-exchange.
+		 */
+		void LSE_CALL								LockSlow( int32_t _i32State );
+
+		/**
+		 * Wakes one thread sleeping on the futex.
+		 */
+		void LSE_CALL								WakeOne();
 #endif	// #ifdef LSE_WIN32
 	};
 
@@ -138,6 +161,10 @@ namespace lsh {
 		::pthread_mutexattr_settype( &tmaAtt, PTHREAD_MUTEX_RECURSIVE );
 		::pthread_mutex_init( &m_ptmCrit, &tmaAtt );
 		::pthread_mutexattr_destroy( &tmaAtt );
+#elif defined( LSE_LINUX )
+		m_i32Futex = 0;
+		m_tOwner = 0;
+		m_ui32Recursion = 0;
 #endif	// #ifdef LSE_WIN32
 	}
 	LSE_INLINE LSE_CALLCTOR CCriticalSection::~CCriticalSection() {
@@ -155,6 +182,19 @@ namespace lsh {
 		::EnterCriticalSection( &m_csCrit );
 #elif defined( LSE_MAC )
 		::pthread_mutex_lock( &m_ptmCrit );
+#elif defined( LSE_LINUX )
+		// Recursive locking.  Only this thread can have stored its own ID, so a relaxed load is enough.
+		pthread_t tSelf = ::pthread_self();
+		if ( __atomic_load_n( &m_tOwner, __ATOMIC_RELAXED ) == tSelf ) {
+			++m_ui32Recursion;
+			return;
+		}
+		int32_t i32State = 0;
+		if ( !__atomic_compare_exchange_n( &m_i32Futex, &i32State, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) ) {
+			LockSlow( i32State );
+		}
+		__atomic_store_n( &m_tOwner, tSelf, __ATOMIC_RELAXED );
+		m_ui32Recursion = 1;
 #endif	// #ifdef LSE_WIN32
 	}
 
@@ -164,6 +204,13 @@ namespace lsh {
 		::LeaveCriticalSection( &m_csCrit );
 #elif defined( LSE_MAC )
 		::pthread_mutex_unlock( &m_ptmCrit );
+#elif defined( LSE_LINUX )
+		if ( --m_ui32Recursion ) { return; }
+		__atomic_store_n( &m_tOwner, static_cast<pthread_t>(0), __ATOMIC_RELAXED );
+		// Only enter the kernel if someone might be sleeping.
+		if ( __atomic_exchange_n( &m_i32Futex, 0, __ATOMIC_RELEASE ) == 2 ) {
+			WakeOne();
+		}
 #endif	// #ifdef LSE_WIN32
 	}
 
@@ -0,0 +1,379 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A persistent pool of worker threads that run small jobs.  Each worker owns a work-stealing deque and idle
+ *	workers steal from the others.  Completion is tracked with counters, and a thread waiting on a counter runs
+ *	other jobs while it waits instead of sleeping.
+ * If the job system has not been initialized, jobs run immediately on the submitting thread, so code using it
+ *	works (serially) in tools that never call Init().
+ */
+
+#include "LSHJobSystem.h"
+#include "LSAMemLib.h"
+#include <new>
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+// TUNING
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+/** Number of failed attempts to find work before an idle worker yields its time slice. */
+#define LSH_JOB_SPINS						64
+
+/** Number of failed attempts to find work before an idle worker sleeps. */
+#define LSH_JOB_YIELDS						128
+
+/** Maximum number of threads in the pool. */
+#define LSH_JOB_MAX_THREADS					64
+
+namespace lsh {
+
+	// == Members.
+	/** Per-thread data.  Index 0 belongs to the thread that called Init(). */
+	CJobSystem::LSH_WORKER * CJobSystem::m_pwWorkers = NULL;
+
+	/** The allocation holding m_pwWorkers, which is rounded up to a cache line within it. */
+	void * CJobSystem::m_pvWorkerBuffer = NULL;
+
+	/** Number of entries constructed in m_pwWorkers. */
+	uint32_t CJobSystem::m_ui32Workers = 0;
+
+	/** Number of entries in m_pwWorkers that are ready.  Read by other threads, so only accessed atomically. */
+	CAtomic::ATOM CJobSystem::m_aTotal = 0;
+
+	/** Jobs submitted by threads that do not belong to the pool. */
+	CJobSystem::LSH_JOB CJobSystem::m_jShared[1024];
+
+	/** Read index into m_jShared. */
+	uint32_t CJobSystem::m_ui32SharedRead = 0;
+
+	/** Number of jobs in m_jShared.  Written under m_csShared but read without it, so only accessed atomically. */
+	CAtomic::ATOM CJobSystem::m_aSharedCount = 0;
+
+	/** Guards m_jShared. */
+	CCriticalSection CJobSystem::m_csShared;
+
+	/** Idle workers sleep on this. */
+	CEvent CJobSystem::m_eWake;
+
+	/** Number of workers sleeping (or about to sleep) on m_eWake. */
+	CAtomic::ATOM CJobSystem::m_aSleeping = 0;
+
+	/** Tells the workers to exit. */
+	CAtomic::ATOM CJobSystem::m_aStop = 0;
+
+	/** 1 + the index of the calling thread's entry in m_pwWorkers, or 0 if the thread does not belong to the pool. */
+	LSE_THREAD_LOCAL uint32_t CJobSystem::m_ui32ThreadIndex = 0;
+
+	// == Functions.
+	/**
+	 * Starts the worker threads.  The calling thread becomes a member of the pool (it runs jobs while it waits).
+	 *
+	 * \param _ui32Workers The number of worker threads to create.  If 0, one fewer than the number of logical processors is used.
+	 * \return Returns true if the pool was started.  If false is returned, jobs run on the submitting thread.
+	 */
+	LSBOOL LSE_CALL CJobSystem::Init( uint32_t _ui32Workers ) {
+		Destroy();
+		if ( !_ui32Workers ) {
+			_ui32Workers = CThreadLib::GetLogicalProcessorCount() - 1;
+			if ( !_ui32Workers ) { return false; }
+		}
+		if ( _ui32Workers > LSH_JOB_MAX_THREADS - 1 ) { _ui32Workers = LSH_JOB_MAX_THREADS - 1; }
+
+		// The deques are aligned to cache lines but CMemLib aligns to at most 32 bytes, so allocate the rest of a
+		//	cache line extra and round up.
+		m_pvWorkerBuffer = lsa::CMemLib::MAllocAligned( sizeof( LSH_WORKER ) * (_ui32Workers + 1) + (LSE_CACHE_LINE_SIZE - 32), 32 );
+		if ( !m_pvWorkerBuffer ) { return false; }
+		m_pwWorkers = reinterpret_cast<LSH_WORKER *>((reinterpret_cast<uintptr_t>(m_pvWorkerBuffer) + (LSE_CACHE_LINE_SIZE - 1)) &
+			~static_cast<uintptr_t>(LSE_CACHE_LINE_SIZE - 1));
+		m_ui32Workers = _ui32Workers + 1;
+		for ( uint32_t I = 0; I <= _ui32Workers; ++I ) {
+			new( &m_pwWorkers[I] ) LSH_WORKER();
+			CThreadLib::MakeInvalidHandle( m_pwWorkers[I].tThread );
+			m_pwWorkers[I].ui32Seed = I * 0x9E3779B9 + 1;
+		}
+		CAtomic::AtomicStore( m_aTotal, 1 );
+		CAtomic::AtomicStore( m_aStop, 0 );
+		m_ui32ThreadIndex = 1;
+
+		for ( uint32_t I = 1; I <= _ui32Workers; ++I ) {
+			if ( !CThreadLib::CreateThread( WorkerThread, reinterpret_cast<void *>(static_cast<uintptr_t>(I)), &m_pwWorkers[I].tThread ) ) {
+				break;
+			}
+			CThreadLib::SetThreadName( m_pwWorkers[I].tThread, "LSH Job Worker" );
+			// Workers only steal from entries below m_aTotal, so publish each one after it is ready.
+			CAtomic::AtomicStore( m_aTotal, static_cast<CAtomic::ATOM_OP>(I + 1) );
+		}
+		if ( CAtomic::AtomicLoad( m_aTotal ) == 1 ) {
+			Destroy();
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Stops and joins all of the worker threads.  Jobs that have not been run are discarded, so wait on all
+	 *	counters before calling this.
+	 */
+	void LSE_CALL CJobSystem::Destroy() {
+		if ( !m_pwWorkers ) { return; }
+		CAtomic::AtomicStore( m_aStop, 1 );
+		// Each worker that wakes passes the signal on before exiting.
+		m_eWake.Trigger();
+		uint32_t ui32Total = static_cast<uint32_t>(CAtomic::AtomicLoad( m_aTotal ));
+		for ( uint32_t I = 1; I < ui32Total; ++I ) {
+			CThreadLib::WaitForThread( m_pwWorkers[I].tThread, NULL );
+			CThreadLib::CloseThread( m_pwWorkers[I].tThread );
+		}
+		for ( uint32_t I = 0; I < m_ui32Workers; ++I ) {
+			m_pwWorkers[I].~LSH_WORKER();
+		}
+		lsa::CMemLib::Free( m_pvWorkerBuffer );
+		m_pvWorkerBuffer = NULL;
+		m_pwWorkers = NULL;
+		m_ui32Workers = 0;
+		// The last worker to exit passes the stop signal on to no one, so clear it for the next Init().
+		m_eWake.Reset();
+		CAtomic::AtomicStore( m_aTotal, 0 );
+		m_ui32ThreadIndex = 0;
+		m_ui32SharedRead = 0;
+		CAtomic::AtomicStore( m_aSharedCount, 0 );
+	}
+
+	/**
+	 * Submits a job.  The job is pushed onto the calling thread's deque if it has one, otherwise onto a shared queue.
+	 *	If the queue is full or the job system is not running, the job is run immediately.
+	 *
+	 * \param _pfProc The job function.
+	 * \param _pvParm The parameter to pass to the job function.
+	 * \param _pjcCounter Optional counter to increment now and decrement when the job finishes.
+	 */
+	void LSE_CALL CJobSystem::Submit( LSH_JOB_PROC _pfProc, void * _pvParm, CJobCounter * _pjcCounter ) {
+		LSH_JOB jJob = { _pfProc, NULL, _pvParm, _pjcCounter, 0, 0, 0 };
+		if ( _pjcCounter ) {
+			CAtomic::InterlockedIncrement( _pjcCounter->m_aCount );
+		}
+		if ( !Push( jJob ) ) {
+			Run( jJob );
+		}
+	}
+
+	/**
+	 * Waits for all jobs tracked by the given counter to finish, running jobs while waiting.
+	 *
+	 * \param _jcCounter The counter on which to wait.
+	 */
+	void LSE_CALL CJobSystem::Wait( const CJobCounter &_jcCounter ) {
+		uint32_t ui32Fails = 0;
+		while ( !_jcCounter.IsDone() ) {
+			if ( RunOne() ) {
+				ui32Fails = 0;
+			}
+			else if ( ++ui32Fails >= LSH_JOB_SPINS ) {
+				// The remaining jobs are running on other threads.
+				CStd::Sleep( 0 );
+			}
+		}
+	}
+
+	/**
+	 * Calls _pfProc on sub-ranges of [0, _ui32Total) in parallel and returns when all have finished.  Ranges are split in
+	 *	half lazily as they are run, only while the pool is short of work, so the batch size adapts to the load.
+	 *
+	 * \param _ui32Total The size of the range.
+	 * \param _pfProc The function to call on each sub-range.
+	 * \param _pvParm The parameter to pass to _pfProc.
+	 * \param _ui32MinBatch The smallest range that will be split.
+	 */
+	void LSE_CALL CJobSystem::ParallelFor( uint32_t _ui32Total, LSH_PARALLEL_FOR_PROC _pfProc, void * _pvParm, uint32_t _ui32MinBatch ) {
+		if ( !_ui32Total ) { return; }
+		uint32_t ui32Threads = static_cast<uint32_t>(CAtomic::AtomicLoad( m_aTotal ));
+		if ( ui32Threads <= 1 || _ui32Total <= _ui32MinBatch ) {
+			_pfProc( 0, _ui32Total, _pvParm );
+			return;
+		}
+		// Never split finer than 4 ranges per thread on average; smaller pieces only add overhead.
+		uint32_t ui32Grain = _ui32Total / (ui32Threads * 4);
+		if ( ui32Grain < _ui32MinBatch ) { ui32Grain = _ui32MinBatch; }
+		if ( ui32Grain < 1 ) { ui32Grain = 1; }
+
+		CJobCounter jcCounter;
+		jcCounter.m_aCount = 1;
+		LSH_JOB jJob = { NULL, _pfProc, _pvParm, &jcCounter, 0, _ui32Total, ui32Grain };
+		Run( jJob );
+		Wait( jcCounter );
+	}
+
+	/**
+	 * Gets the number of threads that run jobs, including the thread that called Init().
+	 *
+	 * \return Returns the number of threads that run jobs, or 1 if the job system is not running.
+	 */
+	uint32_t LSE_CALL CJobSystem::TotalThreads() {
+		uint32_t ui32Total = static_cast<uint32_t>(CAtomic::AtomicLoad( m_aTotal ));
+		return ui32Total ? ui32Total : 1;
+	}
+
+	/**
+	 * Adds a job to the calling thread's deque or to the shared queue.
+	 *
+	 * \param _jJob The job to add.
+	 * \return Returns false if there was no room for the job.
+	 */
+	LSBOOL LSE_CALL CJobSystem::Push( const LSH_JOB &_jJob ) {
+		if ( !m_pwWorkers ) { return false; }
+		if ( m_ui32ThreadIndex ) {
+			if ( !m_pwWorkers[m_ui32ThreadIndex-1].wsdJobs.Push( _jJob ) ) { return false; }
+		}
+		else {
+			CCriticalSection::CLocker lLock( m_csShared );
+			uint32_t ui32Count = static_cast<uint32_t>(CAtomic::AtomicLoad( m_aSharedCount ));
+			if ( ui32Count == LSE_ELEMENTS( m_jShared ) ) { return false; }
+			m_jShared[(m_ui32SharedRead+ui32Count)%LSE_ELEMENTS( m_jShared )] = _jJob;
+			CAtomic::AtomicStore( m_aSharedCount, static_cast<CAtomic::ATOM_OP>(ui32Count + 1) );
+		}
+		WakeOne();
+		return true;
+	}
+
+	/**
+	 * Finds a job to run, first from the calling thread's deque, then the shared queue, then other threads' deques.
+	 *
+	 * \param _jJob Holds the returned job.
+	 * \return Returns true if a job was found.
+	 */
+	LSBOOL LSE_CALL CJobSystem::FindJob( LSH_JOB &_jJob ) {
+		if ( !m_pwWorkers ) { return false; }
+		uint32_t ui32Self = m_ui32ThreadIndex;
+		if ( ui32Self && m_pwWorkers[ui32Self-1].wsdJobs.Pop( _jJob ) ) { return true; }
+
+		if ( CAtomic::AtomicLoad( m_aSharedCount ) ) {
+			CCriticalSection::CLocker lLock( m_csShared );
+			uint32_t ui32Count = static_cast<uint32_t>(CAtomic::AtomicLoad( m_aSharedCount ));
+			if ( ui32Count ) {
+				_jJob = m_jShared[m_ui32SharedRead];
+				m_ui32SharedRead = (m_ui32SharedRead + 1) % LSE_ELEMENTS( m_jShared );
+				CAtomic::AtomicStore( m_aSharedCount, static_cast<CAtomic::ATOM_OP>(ui32Count - 1) );
+				return true;
+			}
+		}
+
+		// Steal, starting from a pseudo-random victim so that thieves spread out.
+		uint32_t ui32Total = static_cast<uint32_t>(CAtomic::AtomicLoad( m_aTotal ));
+		uint32_t ui32Start;
+		if ( ui32Self ) {
+			uint32_t & ui32Seed = m_pwWorkers[ui32Self-1].ui32Seed;
+			ui32Seed = ui32Seed * 1664525 + 1013904223;
+			ui32Start = (ui32Seed >> 16) % ui32Total;
+		}
+		else {
+			ui32Start = 0;
+		}
+		for ( uint32_t I = 0; I < ui32Total; ++I ) {
+			uint32_t ui32Victim = (ui32Start + I) % ui32Total;
+			if ( ui32Victim + 1 == ui32Self ) { continue; }
+			if ( m_pwWorkers[ui32Victim].wsdJobs.Steal( _jJob ) ) { return true; }
+		}
+		return false;
+	}
+
+	/**
+	 * Runs a job and decrements its counter.
+	 *
+	 * \param _jJob The job to run.
+	 */
+	void LSE_CALL CJobSystem::Run( LSH_JOB &_jJob ) {
+		if ( _jJob.pfProc ) {
+			_jJob.pfProc( _jJob.pvParm );
+		}
+		else {
+			// Give the upper half of the range away while it is still large enough to be worth splitting.  The
+			//	halves are only given away while this thread's deque is nearly empty, so a busy pool runs large batches.
+			while ( _jJob.ui32End - _jJob.ui32Begin > _jJob.ui32Grain &&
+				(!m_ui32ThreadIndex || m_pwWorkers[m_ui32ThreadIndex-1].wsdJobs.Size() < 2) ) {
+				uint32_t ui32Mid = _jJob.ui32Begin + (_jJob.ui32End - _jJob.ui32Begin) / 2;
+				LSH_JOB jHalf = _jJob;
+				jHalf.ui32Begin = ui32Mid;
+				CAtomic::InterlockedIncrement( _jJob.pjcCounter->m_aCount );
+				if ( !Push( jHalf ) ) {
+					CAtomic::InterlockedDecrement( _jJob.pjcCounter->m_aCount );
+					break;
+				}
+				_jJob.ui32End = ui32Mid;
+			}
+			_jJob.pfRangeProc( _jJob.ui32Begin, _jJob.ui32End, _jJob.pvParm );
+		}
+		if ( _jJob.pjcCounter ) {
+			CAtomic::InterlockedDecrement( _jJob.pjcCounter->m_aCount );
+		}
+	}
+
+	/**
+	 * Finds and runs one job.
+	 *
+	 * \return Returns true if a job was run.
+	 */
+	LSBOOL LSE_CALL CJobSystem::RunOne() {
+		LSH_JOB jJob;
+		if ( !FindJob( jJob ) ) { return false; }
+		// If there is more work than this thread can take, get another worker started on it.
+		if ( HasJobs() ) { WakeOne(); }
+		Run( jJob );
+		return true;
+	}
+
+	/**
+	 * Does any queue appear to have jobs?
+	 *
+	 * \return Returns true if any queue appears to have jobs.
+	 */
+	LSBOOL LSE_CALL CJobSystem::HasJobs() {
+		if ( CAtomic::AtomicLoad( m_aSharedCount ) ) { return true; }
+		for ( uint32_t I = static_cast<uint32_t>(CAtomic::AtomicLoad( m_aTotal )); I--; ) {
+			if ( m_pwWorkers[I].wsdJobs.Size() ) { return true; }
+		}
+		return false;
+	}
+
+	/**
+	 * The worker thread function.
+	 *
+	 * \param _lpParameter The index of the worker in m_pwWorkers.
+	 * \return Returns 0.
+	 */
+	uint32_t LSH_CALL CJobSystem::WorkerThread( void * _lpParameter ) {
+		m_ui32ThreadIndex = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(_lpParameter)) + 1;
+		uint32_t ui32Fails = 0;
+		while ( !CAtomic::AtomicLoad( m_aStop ) ) {
+			if ( RunOne() ) {
+				ui32Fails = 0;
+				continue;
+			}
+			++ui32Fails;
+			if ( ui32Fails < LSH_JOB_SPINS ) { continue; }
+			if ( ui32Fails < LSH_JOB_YIELDS ) {
+				CStd::Sleep( 0 );
+				continue;
+			}
+
+			// Announce the sleep before the final check so that a Push() after the check is guaranteed to trigger the event.
+			CAtomic::InterlockedIncrement( m_aSleeping );
+			if ( !HasJobs() && !CAtomic::AtomicLoad( m_aStop ) ) {
+				m_eWake.WaitEvent();
+			}
+			CAtomic::InterlockedDecrement( m_aSleeping );
+			ui32Fails = 0;
+		}
+		// Pass the stop signal on to the next sleeping worker.
+		m_eWake.Trigger();
+		return 0;
+	}
+
+}	// namespace lsh
@@ -0,0 +1,280 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A persistent pool of worker threads that run small jobs.  Each worker owns a work-stealing deque and idle
+ *	workers steal from the others.  Completion is tracked with counters, and a thread waiting on a counter runs
+ *	other jobs while it waits instead of sleeping.
+ * If the job system has not been initialized, jobs run immediately on the submitting thread, so code using it
+ *	works (serially) in tools that never call Init().
+ */
+
+
+#ifndef __LSH_JOBSYSTEM_H__
+#define __LSH_JOBSYSTEM_H__
+
+#include "../LSHThreadLib.h"
+#include "../CriticalSection/LSHCriticalSection.h"
+#include "Atomic/LSSTDAtomic.h"
+#include "Events/LSSTDEvent.h"
+#include "LSHWorkStealingDeque.h"
+
+namespace lsh {
+
+	// == Types.
+	/** A job function. */
+	typedef void (LSE_CALL * LSH_JOB_PROC)( void * _pvParm );
+
+	/** A ParallelFor() function.  Called on the half-open range [_ui32Begin, _ui32End). */
+	typedef void (LSE_CALL * LSH_PARALLEL_FOR_PROC)( uint32_t _ui32Begin, uint32_t _ui32End, void * _pvParm );
+
+	/**
+	 * Class CJobCounter
+	 * \brief Counts unfinished jobs.
+	 *
+	 * Description: Counts unfinished jobs.  Pass the same counter to several CJobSystem::Submit() calls and then call
+	 *	CJobSystem::Wait() on it to wait for all of them.  A job that must run after others can simply be submitted from
+	 *	a job that waits on their counter.
+	 */
+	class CJobCounter {
+		friend class								CJobSystem;
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CJobCounter() {
+			m_aCount = 0;
+		}
+
+
+		// == Functions.
+		/**
+		 * Are all of the jobs tracked by this counter finished?
+		 *
+		 * \return Returns true if all of the jobs tracked by this counter are finished.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					IsDone() const {
+			return CAtomic::AtomicLoad( m_aCount ) == 0;
+		}
+
+
+	protected :
+		// == Members.
+		/** Number of unfinished jobs. */
+		CAtomic::ATOM								m_aCount;
+	};
+
+	/**
+	 * Class CJobSystem
+	 * \brief A persistent pool of worker threads that run small jobs.
+	 *
+	 * Description: A persistent pool of worker threads that run small jobs.  Each worker owns a work-stealing deque and idle
+	 *	workers steal from the others.  Completion is tracked with counters, and a thread waiting on a counter runs
+	 *	other jobs while it waits instead of sleeping.
+	 */
+	class CJobSystem {
+	public :
+		// == Functions.
+		/**
+		 * Starts the worker threads.  The calling thread becomes a member of the pool (it runs jobs while it waits).
+		 *
+		 * \param _ui32Workers The number of worker threads to create.  If 0, one fewer than the number of logical processors is used.
+		 * \return Returns true if the pool was started.  If false is returned, jobs run on the submitting thread.
+		 */
+		static LSBOOL LSE_CALL						Init( uint32_t _ui32Workers = 0 );
+
+		/**
+		 * Stops and joins all of the worker threads.  Jobs that have not been run are discarded, so wait on all
+		 *	counters before calling this.
+		 */
+		static void LSE_CALL						Destroy();
+
+		/**
+		 * Submits a job.  The job is pushed onto the calling thread's deque if it has one, otherwise onto a shared queue.
+		 *	If the queue is full or the job system is not running, the job is run immediately.
+		 *
+		 * \param _pfProc The job function.
+		 * \param _pvParm The parameter to pass to the job function.
+		 * \param _pjcCounter Optional counter to increment now and decrement when the job finishes.
+		 */
+		static void LSE_CALL						Submit( LSH_JOB_PROC _pfProc, void * _pvParm, CJobCounter * _pjcCounter );
+
+		/**
+		 * Waits for all jobs tracked by the given counter to finish, running jobs while waiting.
+		 *
+		 * \param _jcCounter The counter on which to wait.
+		 */
+		static void LSE_CALL						Wait( const CJobCounter &_jcCounter );
+
+		/**
+		 * Calls _pfProc on sub-ranges of [0, _ui32Total) in parallel and returns when all have finished.  Ranges are split in
+		 *	half lazily as they are run, only while the pool is short of work, so the batch size adapts to the load.
+		 *
+		 * \param _ui32Total The size of the range.
+		 * \param _pfProc The function to call on each sub-range.
+		 * \param _pvParm The parameter to pass to _pfProc.
+		 * \param _ui32MinBatch The smallest range that will be split.
+		 */
+		static void LSE_CALL						ParallelFor( uint32_t _ui32Total, LSH_PARALLEL_FOR_PROC _pfProc, void * _pvParm, uint32_t _ui32MinBatch = 1 );
+
+		/**
+		 * Gets the number of threads that run jobs, including the thread that called Init().
+		 *
+		 * \return Returns the number of threads that run jobs, or 1 if the job system is not running.
+		 */
+		static uint32_t LSE_CALL					TotalThreads();
+
+
+	protected :
+		// == Types.
+		/** A job. */
+		typedef struct LSH_JOB {
+			/** The job function, or NULL for a ParallelFor() range. */
+			LSH_JOB_PROC							pfProc;
+
+			/** The ParallelFor() function. */
+			LSH_PARALLEL_FOR_PROC					pfRangeProc;
+
+			/** The parameter to pass to the function. */
+			void *									pvParm;
+
+			/** The counter to decrement when done. */
+			CJobCounter *							pjcCounter;
+
+			/** Start of the ParallelFor() range. */
+			uint32_t								ui32Begin;
+
+			/** End of the ParallelFor() range. */
+			uint32_t								ui32End;
+
+			/** Ranges at or below this size are not split. */
+			uint32_t								ui32Grain;
+		} * LPLSH_JOB, * const LPCLSH_JOB;
+
+		/** Per-thread data. */
+		typedef struct LSH_WORKER {
+			/** The worker's deque. */
+			CWorkStealingDeque<LSH_JOB>				wsdJobs;
+
+			/** The worker thread, or an invalid handle for the thread that called Init(). */
+			LSH_THREAD								tThread;
+
+			/** Seed for picking steal victims. */
+			uint32_t								ui32Seed;
+		} * LPLSH_WORKER, * const LPCLSH_WORKER;
+
+
+		// == Members.
+		/** Per-thread data.  Index 0 belongs to the thread that called Init(). */
+		static LSH_WORKER *							m_pwWorkers;
+
+		/** The allocation holding m_pwWorkers, which is rounded up to a cache line within it. */
+		static void *								m_pvWorkerBuffer;
+
+		/** Number of entries constructed in m_pwWorkers. */
+		static uint32_t								m_ui32Workers;
+
+		/** Number of entries in m_pwWorkers that are ready.  Read by other threads, so only accessed atomically. */
+		static CAtomic::ATOM						m_aTotal;
+
+		/** Jobs submitted by threads that do not belong to the pool. */
+		static LSH_JOB								m_jShared[1024];
+
+		/** Read index into m_jShared. */
+		static uint32_t								m_ui32SharedRead;
+
+		/** Number of jobs in m_jShared.  Written under m_csShared but read without it, so only accessed atomically. */
+		static CAtomic::ATOM						m_aSharedCount;
+
+		/** Guards m_jShared. */
+		static CCriticalSection						m_csShared;
+
+		/** Idle workers sleep on this. */
+		static CEvent								m_eWake;
+
+		/** Number of workers sleeping (or about to sleep) on m_eWake. */
+		static CAtomic::ATOM						m_aSleeping;
+
+		/** Tells the workers to exit. */
+		static CAtomic::ATOM						m_aStop;
+
+		/** 1 + the index of the calling thread's entry in m_pwWorkers, or 0 if the thread does not belong to the pool. */
+		static LSE_THREAD_LOCAL uint32_t			m_ui32ThreadIndex;
+
+
+		// == Functions.
+		/**
+		 * Adds a job to the calling thread's deque or to the shared queue.
+		 *
+		 * \param _jJob The job to add.
+		 * \return Returns false if there was no room for the job.
+		 */
+		static LSBOOL LSE_CALL						Push( const LSH_JOB &_jJob );
+
+		/**
+		 * Finds a job to run, first from the calling thread's deque, then the shared queue, then other threads' deques.
+		 *
+		 * \param _jJob Holds the returned job.
+		 * \return Returns true if a job was found.
+		 */
+		static LSBOOL LSE_CALL						FindJob( LSH_JOB &_jJob );
+
+		/**
+		 * Runs a job and decrements its counter.
+		 *
+		 * \param _jJob The job to run.
+		 */
+		static void LSE_CALL						Run( LSH_JOB &_jJob );
+
+		/**
+		 * Finds and runs one job.
+		 *
+		 * \return Returns true if a job was run.
+		 */
+		static LSBOOL LSE_CALL						RunOne();
+
+		/**
+		 * Wakes a sleeping worker, if any.
+		 */
+		static LSE_INLINE void LSE_CALL				WakeOne();
+
+		/**
+		 * Does any queue appear to have jobs?
+		 *
+		 * \return Returns true if any queue appears to have jobs.
+		 */
+		static LSBOOL LSE_CALL						HasJobs();
+
+		/**
+		 * The worker thread function.
+		 *
+		 * \param _lpParameter The index of the worker in m_pwWorkers.
+		 * \return Returns 0.
+		 */
+		static uint32_t LSH_CALL					WorkerThread( void * _lpParameter );
+	};
+
+
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// DEFINITIONS
+	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+	// == Functions.
+	/**
+	 * Wakes a sleeping worker, if any.
+	 */
+	LSE_INLINE void LSE_CALL CJobSystem::WakeOne() {
+		// The job must be visible before m_aSleeping is read, or a worker that is about to sleep might miss it.
+		CAtomic::ThreadFence();
+		if ( CAtomic::AtomicLoad( m_aSleeping ) ) {
+			m_eWake.Trigger();
+		}
+	}
+
+}	// namespace lsh
+
+#endif	// __LSH_JOBSYSTEM_H__
@@ -0,0 +1,164 @@
+/**
+ * Copyright L. Spiro 2014
+ * All rights reserved.
+ *
+ * Written by:	Shawn (L. Spiro) Wilcoxen
+ *
+ * This code may not be sold or traded for any personal gain without express written consent.  You may use
+ *	this code in your own projects and modify it to suit your needs as long as this disclaimer remains intact.
+ *	You may not take credit for having written this code.
+ *
+ *
+ * Description: A fixed-size Chase-Lev work-stealing deque.  The owning thread pushes and pops at the bottom while any
+ *	other thread can steal from the top.  Items are copied in and out by value, so _tType must be a plain-old-data type.
+ */
+
+
+#ifndef __LSH_WORKSTEALINGDEQUE_H__
+#define __LSH_WORKSTEALINGDEQUE_H__
+
+#include "../LSHThreadLib.h"
+#include "Atomic/LSSTDAtomic.h"
+
+namespace lsh {
+
+	/**
+	 * Class CWorkStealingDeque
+	 * \brief A fixed-size Chase-Lev work-stealing deque.
+	 *
+	 * Description: A fixed-size Chase-Lev work-stealing deque.  The owning thread pushes and pops at the bottom while any
+	 *	other thread can steal from the top.  Items are copied in and out by value, so _tType must be a plain-old-data type.
+	 *	_uSize must be a power of 2.
+	 */
+	template <typename _tType, unsigned _uSize = 4096>
+	class CWorkStealingDeque {
+	public :
+		// == Various constructors.
+		LSE_CALLCTOR								CWorkStealingDeque() {
+			m_aTop = 0;
+			m_aBottom = 0;
+		}
+
+
+		// == Functions.
+		/**
+		 * Pushes an item onto the bottom of the deque.  Must only be called by the owning thread.
+		 *
+		 * \param _tItem The item to push.
+		 * \return Returns false if the deque is full.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Push( const _tType &_tItem ) {
+			CAtomic::ATOM_OP aoBottom = m_aBottom;
+			CAtomic::ATOM_OP aoTop = CAtomic::AtomicLoad( m_aTop );
+			if ( Distance( aoTop, aoBottom ) >= static_cast<int32_t>(_uSize) ) { return false; }
+			m_tItems[aoBottom&(_uSize-1)] = _tItem;
+			CAtomic::AtomicStore( m_aBottom, Next( aoBottom ) );
+			return true;
+		}
+
+		/**
+		 * Pops an item from the bottom of the deque.  Must only be called by the owning thread.
+		 *
+		 * \param _tItem Holds the returned item.
+		 * \return Returns false if the deque was empty or the last item was stolen first.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Pop( _tType &_tItem ) {
+			CAtomic::ATOM_OP aoBottom = Prev( m_aBottom );
+			m_aBottom = aoBottom;
+			// The store to m_aBottom must be visible before m_aTop is read or a thief could take the same item.
+			CAtomic::ThreadFence();
+			CAtomic::ATOM_OP aoTop = m_aTop;
+			int32_t i32Size = Distance( aoTop, aoBottom );
+			if ( i32Size < 0 ) {
+				// Empty.
+				CAtomic::AtomicStore( m_aBottom, aoTop );
+				return false;
+			}
+			_tItem = m_tItems[aoBottom&(_uSize-1)];
+			if ( i32Size > 0 ) { return true; }
+
+			// Last item.  Race any thieves for it.
+			LSBOOL bWon = CAtomic::InterlockedCompareExchange( m_aTop, Next( aoTop ), aoTop ) == aoTop;
+			CAtomic::AtomicStore( m_aBottom, Next( aoTop ) );
+			return bWon;
+		}
+
+		/**
+		 * Steals an item from the top of the deque.  Can be called by any thread.
+		 *
+		 * \param _tItem Holds the returned item.
+		 * \return Returns false if the deque was empty or another thread took the item first.
+		 */
+		LSE_INLINE LSBOOL LSE_CALL					Steal( _tType &_tItem ) {
+			CAtomic::ATOM_OP aoTop = CAtomic::AtomicLoad( m_aTop );
+			CAtomic::ThreadFence();
+			CAtomic::ATOM_OP aoBottom = CAtomic::AtomicLoad( m_aBottom );
+			if ( Distance( aoTop, aoBottom ) <= 0 ) { return false; }
+			// The copy can be torn if the owner wraps around onto this slot, but in that case m_aTop has moved
+			//	and the compare-and-exchange fails, so the copy is discarded.
+			_tItem = m_tItems[aoTop&(_uSize-1)];
+			return CAtomic::InterlockedCompareExchange( m_aTop, Next( aoTop ), aoTop ) == aoTop;
+		}
+
+		/**
+		 * Gets the approximate number of items in the deque.  Exact only when called by the owning thread while no
+		 *	other thread is stealing.
+		 *
+		 * \return Returns the approximate number of items in the deque.
+		 */
+		LSE_INLINE uint32_t LSE_CALL				Size() const {
+			int32_t i32Size = Distance( CAtomic::AtomicLoad( m_aTop ), CAtomic::AtomicLoad( m_aBottom ) );
+			return i32Size > 0 ? static_cast<uint32_t>(i32Size) : 0;
+		}
+
+
+	protected :
+		// == Members.
+		/** The index from which thieves steal.  Kept on its own cache line, away from the owner's m_aBottom. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) CAtomic::ATOM
+													m_aTop LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+		/** The index at which the owner pushes and pops. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) CAtomic::ATOM
+													m_aBottom LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+		/** The items. */
+		LSE_ALIGN( LSE_CACHE_LINE_SIZE ) _tType		m_tItems[_uSize] LSE_POSTALIGN( LSE_CACHE_LINE_SIZE );
+
+
+		// == Functions.
+		/**
+		 * Gets the signed distance from one index to another.  Indices are allowed to wrap.
+		 *
+		 * \param _aoFrom The starting index.
+		 * \param _aoTo The ending index.
+		 * \return Returns _aoTo - _aoFrom.
+		 */
+		static LSE_INLINE int32_t LSE_CALL			Distance( CAtomic::ATOM_OP _aoFrom, CAtomic::ATOM_OP _aoTo ) {
+			return static_cast<int32_t>(static_cast<uint32_t>(_aoTo) - static_cast<uint32_t>(_aoFrom));
+		}
+
+		/**
+		 * Gets the index after the given index, wrapping without signed overflow.
+		 *
+		 * \param _aoIndex The index to increment.
+		 * \return Returns _aoIndex + 1.
+		 */
+		static LSE_INLINE CAtomic::ATOM_OP LSE_CALL	Next( CAtomic::ATOM_OP _aoIndex ) {
+			return static_cast<CAtomic::ATOM_OP>(static_cast<uint32_t>(_aoIndex) + 1U);
+		}
+
+		/**
+		 * Gets the index before the given index, wrapping without signed overflow.
+		 *
+		 * \param _aoIndex The index to decrement.
+		 * \return Returns _aoIndex - 1.
+		 */
+		static LSE_INLINE CAtomic::ATOM_OP LSE_CALL	Prev( CAtomic::ATOM_OP _aoIndex ) {
+			return static_cast<CAtomic::ATOM_OP>(static_cast<uint32_t>(_aoIndex) - 1U);
+		}
+	};
+
+}	// namespace lsh
+
+#endif	// __LSH_WORKSTEALINGDEQUE_H__
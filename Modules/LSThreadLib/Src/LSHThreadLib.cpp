@@ -14,9 +14,42 @@
 
 #include "LSHThreadLib.h"
 
+#if defined( LSE_MAC ) || defined( LSE_LINUX )
+#include <cerrno>
+#include <ctime>
+#include <new>
+#include <sched.h>
+#include <unistd.h>
+#endif	// #if defined( LSE_MAC ) || defined( LSE_LINUX )
+
 
 namespace lsh {
 
+#ifdef LSE_LINUX
+	// == Types.
+	/** Passed to the Linux thread entry point so that thread functions do not need to be cast to the pthread signature. */
+	typedef struct LSH_THREAD_START {
+		/** The thread function. */
+		LSH_THREAD_PROC											pfProc;
+
+		/** The parameter to pass to the thread function. */
+		void *													pvParm;
+	} * LPLSH_THREAD_START, * const LPCLSH_THREAD_START;
+
+	// == Functions.
+	/**
+	 * The entry point for all Linux threads.  Calls the user function and widens its return value to the pthread return type.
+	 *
+	 * \param _pvParm Pointer to a heap-allocated LSH_THREAD_START structure, which is freed here.
+	 * \return Returns the value returned by the user thread function.
+	 */
+	static void * ThreadStart( void * _pvParm ) {
+		LSH_THREAD_START tsStart = (*static_cast<LPLSH_THREAD_START>(_pvParm));
+		delete static_cast<LPLSH_THREAD_START>(_pvParm);
+		return reinterpret_cast<void *>(static_cast<uintptr_t>(tsStart.pfProc( tsStart.pvParm )));
+	}
+#endif	// #ifdef LSE_LINUX
+
 	/**
 	 * Creates a new thread.  _ptReturnHandle can be NULL if the handle for the thread is not needed.
 	 *
@@ -34,6 +67,16 @@ namespace lsh {
 		if ( ::pthread_create( &hRet, NULL, reinterpret_cast<void * (*)( void * )>(_pfProc), _lpParameter ) != 0 ) {
 			return false;
 		}
+#elif defined( LSE_LINUX )
+		LPLSH_THREAD_START ptsStart = new( std::nothrow ) LSH_THREAD_START;
+		if ( !ptsStart ) { return false; }
+		ptsStart->pfProc = _pfProc;
+		ptsStart->pvParm = _lpParameter;
+		LSH_THREAD hRet;
+		if ( ::pthread_create( &hRet, NULL, ThreadStart, ptsStart ) != 0 ) {
+			delete ptsStart;
+			return false;
+		}
 #endif	// #ifdef LSE_WINDOWS
 
 
@@ -61,7 +104,7 @@ namespace lsh {
 			return true;
 		}
 		return false;
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		if ( ::pthread_detach( _tReturnHandle ) == 0 ) {
 			// Handle is no longer in use.  Destroy it so that multiple calls on
 			//	it will result in error.
@@ -96,6 +139,61 @@ namespace lsh {
 			(*_pui32RetVal) = (*reinterpret_cast<uint32_t *>(&pvRetVal));
 		}
 		return true;
+#elif defined( LSE_LINUX )
+		void * pvRetVal;
+		if ( ::pthread_join( _tThread, &pvRetVal ) != 0 ) { return false; }
+		if ( _pui32RetVal ) {
+			(*_pui32RetVal) = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pvRetVal));
+		}
+		return true;
+#endif	// #ifdef LSE_WINDOWS
+	}
+
+	/**
+	 * Waits up to the given number of microseconds for a thread to finish and gets its return value.  If the thread does not finish in
+	 *	time, false is returned and the thread handle remains valid (it must still be waited on or closed later).  Pass LSH_INFINITE
+	 *	to wait without a time limit.  On Macintosh there is no timed join, so the thread is polled at roughly 1-millisecond intervals.
+	 *
+	 * \param _tThread The thread for which to wait.
+	 * \param _ui64Microseconds The maximum number of microseconds to wait.
+	 * \param _pui32RetVal Return value from the thread.
+	 * \return Returns true if the thread finished within the given time.
+	 */
+	LSBOOL LSE_CALL CThreadLib::WaitForThreadTimed( const LSH_THREAD &_tThread, uint64_t _ui64Microseconds, uint32_t * _pui32RetVal ) {
+		if ( _ui64Microseconds == LSH_INFINITE ) { return WaitForThread( _tThread, _pui32RetVal ); }
+#ifdef LSE_WINDOWS
+		// Round up so that a short non-zero wait does not become a poll.
+		uint64_t ui64Millis = (_ui64Microseconds + 999ULL) / 1000ULL;
+		if ( ui64Millis >= INFINITE ) { ui64Millis = INFINITE - 1; }
+		if ( ::WaitForSingleObject( _tThread, static_cast<DWORD>(ui64Millis) ) != WAIT_OBJECT_0 ) { return false; }
+		DWORD dwRet;
+		if ( !::GetExitCodeThread( _tThread, &dwRet ) ) { return false; }
+		if ( _pui32RetVal ) {
+			(*_pui32RetVal) = static_cast<uint32_t>(dwRet);
+		}
+		return true;
+#elif defined( LSE_MAC )
+		// There is no timed join, so poll for the thread to exit (signal 0 only checks that the thread is still running).
+		uint64_t ui64Waited = 0ULL;
+		while ( ::pthread_kill( _tThread, 0 ) == 0 ) {
+			if ( ui64Waited >= _ui64Microseconds ) { return false; }
+			::usleep( 1000 );
+			ui64Waited += 1000ULL;
+		}
+		return WaitForThread( _tThread, _pui32RetVal );
+#elif defined( LSE_LINUX )
+		// pthread_timedjoin_np() takes an absolute CLOCK_REALTIME time.
+		timespec tsTime;
+		::clock_gettime( CLOCK_REALTIME, &tsTime );
+		uint64_t ui64Nano = static_cast<uint64_t>(tsTime.tv_nsec) + (_ui64Microseconds % 1000000ULL) * 1000ULL;
+		tsTime.tv_sec += static_cast<time_t>(_ui64Microseconds / 1000000ULL + ui64Nano / 1000000000ULL);
+		tsTime.tv_nsec = static_cast<long>(ui64Nano % 1000000000ULL);
+		void * pvRetVal;
+		if ( ::pthread_timedjoin_np( _tThread, &pvRetVal, &tsTime ) != 0 ) { return false; }
+		if ( _pui32RetVal ) {
+			(*_pui32RetVal) = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pvRetVal));
+		}
+		return true;
 #endif	// #ifdef LSE_WINDOWS
 	}
 
@@ -107,9 +205,86 @@ namespace lsh {
 	LSH_THREAD LSE_CALL CThreadLib::GetCurThread() {
 #ifdef LSE_WINDOWS
 		return ::GetCurrentThread();
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 		return ::pthread_self();
 #endif	// #ifdef LSE_WINDOWS
 	}
 
+	/**
+	 * Restricts a thread to the logical processors set in the given mask.  Bit 0 corresponds to the first logical processor.
+	 *	Not supported on Macintosh, which only accepts affinity hints.
+	 *
+	 * \param _tThread The thread whose affinity is to be set.
+	 * \param _ui64Mask Mask of logical processors on which the thread is allowed to run.
+	 * \return Returns true if the affinity was set.
+	 */
+	LSBOOL LSE_CALL CThreadLib::SetThreadAffinity( const LSH_THREAD &_tThread, uint64_t _ui64Mask ) {
+		if ( !_ui64Mask ) { return false; }
+#ifdef LSE_WINDOWS
+		return ::SetThreadAffinityMask( _tThread, static_cast<DWORD_PTR>(_ui64Mask) ) != 0;
+#elif defined( LSE_MAC )
+		static_cast<void>(_tThread);
+		return false;
+#elif defined( LSE_LINUX )
+		cpu_set_t csSet;
+		CPU_ZERO( &csSet );
+		for ( uint32_t I = 0; I < 64; ++I ) {
+			if ( _ui64Mask & (1ULL << I) ) { CPU_SET( I, &csSet ); }
+		}
+		return ::pthread_setaffinity_np( _tThread, sizeof( csSet ), &csSet ) == 0;
+#endif	// #ifdef LSE_WINDOWS
+	}
+
+	/**
+	 * Sets the name of a thread as shown in debuggers and profilers.  On Linux names are truncated to 15 characters.  On Macintosh
+	 *	only the calling thread can be named, so _tThread must be the current thread.
+	 *
+	 * \param _tThread The thread to name.
+	 * \param _pcName The UTF-8 name to give to the thread.
+	 * \return Returns true if the name was set.
+	 */
+	LSBOOL LSE_CALL CThreadLib::SetThreadName( const LSH_THREAD &_tThread, const char * _pcName ) {
+		if ( !_pcName ) { return false; }
+#ifdef LSE_WINDOWS
+		// SetThreadDescription() only exists on Windows 10 version 1607 and later, so it must be loaded dynamically.
+		typedef HRESULT (WINAPI * LPFN_SETTHREADDESCRIPTION)( HANDLE, PCWSTR );
+		HMODULE hKernel = ::GetModuleHandleW( L"kernel32.dll" );
+		if ( !hKernel ) { return false; }
+		LPFN_SETTHREADDESCRIPTION pfSet = reinterpret_cast<LPFN_SETTHREADDESCRIPTION>(::GetProcAddress( hKernel, "SetThreadDescription" ));
+		if ( !pfSet ) { return false; }
+		wchar_t wcName[64];
+		int iLen = ::MultiByteToWideChar( CP_UTF8, 0, _pcName, -1, wcName, LSE_ELEMENTS( wcName ) );
+		if ( iLen <= 0 ) { return false; }
+		return SUCCEEDED( pfSet( _tThread, wcName ) );
+#elif defined( LSE_MAC )
+		if ( !::pthread_equal( _tThread, ::pthread_self() ) ) { return false; }
+		return ::pthread_setname_np( _pcName ) == 0;
+#elif defined( LSE_LINUX )
+		// Names longer than 15 characters are rejected rather than truncated, so truncate here.
+		char szName[16];
+		uint32_t I = 0;
+		for ( ; I < LSE_ELEMENTS( szName ) - 1 && _pcName[I]; ++I ) {
+			szName[I] = _pcName[I];
+		}
+		szName[I] = '\0';
+		return ::pthread_setname_np( _tThread, szName ) == 0;
+#endif	// #ifdef LSE_WINDOWS
+	}
+
+	/**
+	 * Gets the number of logical processors in the system.
+	 *
+	 * \return Returns the number of logical processors in the system, which is always at least 1.
+	 */
+	uint32_t LSE_CALL CThreadLib::GetLogicalProcessorCount() {
+#ifdef LSE_WINDOWS
+		SYSTEM_INFO siInfo;
+		::GetSystemInfo( &siInfo );
+		return siInfo.dwNumberOfProcessors ? static_cast<uint32_t>(siInfo.dwNumberOfProcessors) : 1;
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
+		long lCount = ::sysconf( _SC_NPROCESSORS_ONLN );
+		return lCount > 0 ? static_cast<uint32_t>(lCount) : 1;
+#endif	// #ifdef LSE_WINDOWS
+	}
+
 }	// namespace lsh
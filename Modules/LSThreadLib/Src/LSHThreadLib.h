@@ -29,9 +29,12 @@ using namespace ::lsstd;
 #include <pthread.h>
 
 #define LSH_CALL			
-#elif defined( __linux__ )
+#elif defined( LSE_LINUX )
 // Linux.
+#include <pthread.h>
+
 #define LSH_LIN
+#define LSH_CALL			
 #endif	// #if defined( LSE_WINDOWS )
 
 
@@ -40,7 +43,7 @@ namespace lsh {
 	// The handle to a thread.
 #ifdef LSE_WINDOWS
 	typedef HANDLE															LSH_THREAD;
-#elif defined( LSE_MAC )
+#elif defined( LSE_MAC ) || defined( LSE_LINUX )
 	typedef pthread_t														LSH_THREAD;
 #else
 #error "Threading not supported on this platform yet."
@@ -48,6 +51,9 @@ namespace lsh {
 
 	typedef uint32_t (LSH_CALL * LSH_THREAD_PROC)( void * _lpParameter );
 
+	/** Passed to WaitForThreadTimed() to wait without a time limit. */
+#define LSH_INFINITE														LSE_MAXU64
+
 	/**
 	 * Class CThreadLib
 	 * \brief Cross-platform threading.
@@ -85,6 +91,18 @@ namespace lsh {
 		 */
 		static LSBOOL LSE_CALL												WaitForThread( const LSH_THREAD &_tThread, uint32_t * _pui32RetVal );
 
+		/**
+		 * Waits up to the given number of microseconds for a thread to finish and gets its return value.  If the thread does not finish in
+		 *	time, false is returned and the thread handle remains valid (it must still be waited on or closed later).  Pass LSH_INFINITE
+		 *	to wait without a time limit.  On Macintosh there is no timed join, so the thread is polled at roughly 1-millisecond intervals.
+		 *
+		 * \param _tThread The thread for which to wait.
+		 * \param _ui64Microseconds The maximum number of microseconds to wait.
+		 * \param _pui32RetVal Return value from the thread.
+		 * \return Returns true if the thread finished within the given time.
+		 */
+		static LSBOOL LSE_CALL												WaitForThreadTimed( const LSH_THREAD &_tThread, uint64_t _ui64Microseconds, uint32_t * _pui32RetVal );
+
 		/**
 		 * Gets a handle to the current thread.
 		 *
@@ -92,6 +110,33 @@ namespace lsh {
 		 */
 		static LSH_THREAD LSE_CALL											GetCurThread();
 
+		/**
+		 * Restricts a thread to the logical processors set in the given mask.  Bit 0 corresponds to the first logical processor.
+		 *	Not supported on Macintosh, which only accepts affinity hints.
+		 *
+		 * \param _tThread The thread whose affinity is to be set.
+		 * \param _ui64Mask Mask of logical processors on which the thread is allowed to run.
+		 * \return Returns true if the affinity was set.
+		 */
+		static LSBOOL LSE_CALL												SetThreadAffinity( const LSH_THREAD &_tThread, uint64_t _ui64Mask );
+
+		/**
+		 * Sets the name of a thread as shown in debuggers and profilers.  On Linux names are truncated to 15 characters.  On Macintosh
+		 *	only the calling thread can be named, so _tThread must be the current thread.
+		 *
+		 * \param _tThread The thread to name.
+		 * \param _pcName The UTF-8 name to give to the thread.
+		 * \return Returns true if the name was set.
+		 */
+		static LSBOOL LSE_CALL												SetThreadName( const LSH_THREAD &_tThread, const char * _pcName );
+
+		/**
+		 * Gets the number of logical processors in the system.
+		 *
+		 * \return Returns the number of logical processors in the system, which is always at least 1.
+		 */
+		static uint32_t LSE_CALL											GetLogicalProcessorCount();
+
 		/**
 		 * Make a thread handle invalid.
 		 *